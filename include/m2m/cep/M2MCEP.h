@@ -33,16 +33,29 @@
 #define M2M_CEP_M2MCEP_H_
 
 
+#include "m2m/cep/M2MCEPAggregate.h"
+#include "m2m/cep/M2MCEPColumnStore.h"
+#include "m2m/cep/M2MCEPLog.h"
+#include "m2m/cep/M2MCEPPartition.h"
+#include "m2m/cep/M2MCEPPattern.h"
+#include "m2m/cep/M2MCEPResultSet.h"
+#include "m2m/cep/M2MCEPValue.h"
 #include "m2m/cep/M2MDataFrame.h"
 #include "m2m/lib/db/M2MSQLite.h"
+#include "m2m/lib/db/M2MStatementCache.h"
 #include "m2m/lib/db/M2MTableManager.h"
 #include "m2m/lib/io/M2MDirectory.h"
 #include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/lang/M2MStringBuilder.h"
 #include "m2m/lib/log/M2MFileAppender.h"
+#include "m2m/lib/util/list/M2MConcurrentQueue.h"
 #include "m2m/lib/util/list/M2MList.h"
 #include "m2m/lib/util/M2MBase64.h"
+#include <pthread.h>
+#include <limits.h>
 #include <signal.h>
 #include <sqlite3.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 
 
@@ -72,6 +85,233 @@ extern "C"
 #endif /* M2MCEP_DIRECTORY */
 
 
+/**
+ * Extension of the snapshot file of the SQLite3 database in memory (stored <br>
+ * next to the SQLite3 database file, see M2MCEP_checkpoint()).<br>
+ */
+#ifndef M2MCEP_SNAPSHOT_EXTENSION
+#define M2MCEP_SNAPSHOT_EXTENSION (M2MString *)".snapshot"
+#endif /* M2MCEP_SNAPSHOT_EXTENSION */
+
+
+/**
+ * Extension of the directory of the write-ahead log (stored next to the <br>
+ * SQLite3 database file, see M2MCEP_setWriteAheadLog()).<br>
+ */
+#ifndef M2MCEP_LOG_DIRECTORY_EXTENSION
+#define M2MCEP_LOG_DIRECTORY_EXTENSION (M2MString *)".wal"
+#endif /* M2MCEP_LOG_DIRECTORY_EXTENSION */
+
+
+/**
+ * Extension of the directory of the time partitions of the SQLite3 database <br>
+ * on file (stored next to the SQLite3 database file, see M2MCEP_setPartition()).<br>
+ */
+#ifndef M2MCEP_PARTITION_DIRECTORY_EXTENSION
+#define M2MCEP_PARTITION_DIRECTORY_EXTENSION (M2MString *)".partition"
+#endif /* M2MCEP_PARTITION_DIRECTORY_EXTENSION */
+
+
+/**
+ * Extension of the directory of the column store files (stored next to the <br>
+ * SQLite3 database file, see M2MCEP_setColumnStore()).<br>
+ */
+#ifndef M2MCEP_COLUMN_STORE_DIRECTORY_EXTENSION
+#define M2MCEP_COLUMN_STORE_DIRECTORY_EXTENSION (M2MString *)".column"
+#endif /* M2MCEP_COLUMN_STORE_DIRECTORY_EXTENSION */
+
+
+/**
+ * Name of the table recording the sequence number of the last persisted <br>
+ * record of each table (in the SQLite3 database on file and in the snapshot, <br>
+ * see M2MCEP_setWriteAheadLog()).<br>
+ */
+#ifndef M2MCEP_SEQUENCE_TABLE
+#define M2MCEP_SEQUENCE_TABLE (M2MString *)"m2mcep_sequence"
+#endif /* M2MCEP_SEQUENCE_TABLE */
+
+
+/**
+ * Name of the SQL function returning the value of the aggregate declared <br>
+ * with M2MCEP_setAggregate().<br>
+ * e.g. "SELECT cep_aggregate('daily', 'value', 'avg')"<br>
+ */
+#ifndef M2MCEP_AGGREGATE_FUNCTION
+#define M2MCEP_AGGREGATE_FUNCTION (M2MString *)"cep_aggregate"
+#endif /* M2MCEP_AGGREGATE_FUNCTION */
+
+
+/**
+ * Maximum number of prepared SELECT statements cached per connection.<br>
+ * The least recently used statement is finalized beyond this number.<br>
+ */
+#ifndef M2MCEP_SELECT_STATEMENT_CACHE_CAPACITY
+#define M2MCEP_SELECT_STATEMENT_CACHE_CAPACITY (unsigned int)256
+#endif /* M2MCEP_SELECT_STATEMENT_CACHE_CAPACITY */
+
+
+/**
+ * Handler notified of records committed into the SQLite3 database in memory.<br>
+ *
+ * @param numberOfRecord	Number of records committed this time
+ * @param committedRecord	Total number of committed records
+ * @param userData			Pointer set with M2MCEP_setCommitHandler()
+ */
+#ifndef M2MCEPCommitHandler
+typedef void (*M2MCEPCommitHandler) (const unsigned int numberOfRecord, const unsigned long committedRecord, void *userData);
+#endif /* M2MCEPCommitHandler */
+
+
+/**
+ * Callback receiving one row of the result of a registered query.<br>
+ * The strings and binary data of the row are valid only during the call.<br>
+ *
+ * @param queryID			ID of the query returned by M2MCEP_registerQuery()
+ * @param row				Typed values of the row
+ * @param numberOfColumn	Number of values of the row
+ * @param userData			Pointer set with M2MCEP_registerQuery()
+ */
+#ifndef M2MCEPQueryCallback
+typedef void (*M2MCEPQueryCallback) (const unsigned int queryID, const M2MCEPValue *row, const unsigned int numberOfColumn, void *userData);
+#endif /* M2MCEPQueryCallback */
+
+
+/**
+ * Callback receiving one row of the result of M2MCEP_selectEach().<br>
+ * The strings and binary data of the row are valid only during the call.<br>
+ *
+ * @param row				Typed values of the row
+ * @param numberOfColumn	Number of values of the row
+ * @param userData			Pointer passed to M2MCEP_selectEach()
+ * @return					true: continue, false: stop reading the result
+ */
+#ifndef M2MCEPRowCallback
+typedef bool (*M2MCEPRowCallback) (const M2MCEPValue *row, const unsigned int numberOfColumn, void *userData);
+#endif /* M2MCEPRowCallback */
+
+
+/**
+ * Table read by a registered query (a node of a singly linked list).<br>
+ *
+ * @param tableName		String indicating the table name
+ * @param lastRowid		Rowid of the last record of the table when the query was evaluated
+ * @param next			Next table or NULL
+ */
+#ifndef M2MCEPQueryTable
+typedef struct M2MCEPQueryTable
+	{
+	M2MString *tableName;
+	int64_t lastRowid;
+	struct M2MCEPQueryTable *next;
+	} M2MCEPQueryTable;
+#endif /* M2MCEPQueryTable */
+
+
+/**
+ * Continuous query registered into the CEP object (a node of a singly linked <br>
+ * list).<br>
+ *
+ * @param queryID			ID of the query
+ * @param statement			Prepared statement of the query (on SQLite3 database in memory)
+ * @param row				Buffer of the typed values of one row
+ * @param numberOfColumn	Number of columns of the result
+ * @param table				Tables read by the query
+ * @param callback			Callback receiving the rows of the result
+ * @param userData			Pointer passed to the callback
+ * @param next				Next query or NULL
+ */
+#ifndef M2MCEPQuery
+typedef struct M2MCEPQuery
+	{
+	unsigned int queryID;
+	sqlite3_stmt *statement;
+	M2MCEPValue *row;
+	unsigned int numberOfColumn;
+	M2MCEPQueryTable *table;
+	M2MCEPQueryCallback callback;
+	void *userData;
+	struct M2MCEPQuery *next;
+	} M2MCEPQuery;
+#endif /* M2MCEPQuery */
+
+
+/**
+ * Records handed off to the background persistence thread (a node of a <br>
+ * singly linked list).<br>
+ * The records are copied either as CSV strings (shadow record window) or as <br>
+ * SQLite3 values read back from the SQLite3 database in memory.<br>
+ *
+ * @param tableName			String indicating the table name to be inserted records
+ * @param columnNameCSV		CSV format string indicating the column names of the records
+ * @param numberOfColumn	Number of columns of "value" (0 in case of CSV strings)
+ * @param numberOfRecord	Number of records held by the batch
+ * @param sequence			Sequence number of the last record of the batch in the table (-1: not recorded)
+ * @param csv				Array of CSV strings (one record per string) or NULL
+ * @param value				Array of SQLite3 values (numberOfRecord * numberOfColumn) or NULL
+ * @param next				Next batch or NULL
+ */
+#ifndef M2MCEPPersistenceBatch
+typedef struct M2MCEPPersistenceBatch
+	{
+	M2MString *tableName;
+	M2MString *columnNameCSV;
+	unsigned int numberOfColumn;
+	unsigned int numberOfRecord;
+	int64_t sequence;
+	M2MString **csv;
+	sqlite3_value **value;
+	struct M2MCEPPersistenceBatch *next;
+	} M2MCEPPersistenceBatch;
+#endif /* M2MCEPPersistenceBatch */
+
+
+/**
+ * Last rowid of a table when a segment file of the write-ahead log was closed <br>
+ * (a node of a singly linked list in the order of the segments).<br>
+ * The segment file can be removed when the records of every table up to the <br>
+ * rowid have left the SQLite3 database in memory.<br>
+ *
+ * @param segment		Number of the segment file
+ * @param tableName		String indicating the table name
+ * @param lastRowid		Rowid of the last record of the table in the segment file or before
+ * @param next			Next mark or NULL
+ */
+#ifndef M2MCEPLogMark
+typedef struct M2MCEPLogMark
+	{
+	uint32_t segment;
+	M2MString *tableName;
+	int64_t lastRowid;
+	struct M2MCEPLogMark *next;
+	} M2MCEPLogMark;
+#endif /* M2MCEPLogMark */
+
+
+/**
+ * Window definition of a table (a node of a singly linked list).<br>
+ * The records of the table held in the SQLite3 database in memory are limited <br>
+ * by number, by event time or by both (the smaller window wins).<br>
+ *
+ * @param tableName			String indicating the table name
+ * @param maxRecord			Maximum number of records (0: not limited by number)
+ * @param timeColumnName	String indicating the column of event time (NULL: not limited by time)
+ * @param duration			Duration of the window in the unit of the event time column (0: not limited by time)
+ * @param boundarySQL		SELECT statement searching the oldest record within the duration
+ * @param next				Next window definition or NULL
+ */
+#ifndef M2MCEPWindow
+typedef struct M2MCEPWindow
+	{
+	M2MString *tableName;
+	unsigned int maxRecord;
+	M2MString *timeColumnName;
+	int64_t duration;
+	M2MString *boundarySQL;
+	struct M2MCEPWindow *next;
+	} M2MCEPWindow;
+#endif /* M2MCEPWindow */
+
+
 /**
  * CEP (Complex Event Processing) execution structure object.<br>
  *
@@ -79,11 +319,68 @@ extern "C"
  * @param tableManager		Database table manager structure object
  * @param memoryDatabase	SQLite3 database on memory
  * @param fileDatabase		SQLite3 database on file
+ * @param memoryStatementCache	Prepared INSERT statements of SQLite3 database on memory
+ * @param selectStatementCache	Prepared SELECT statements of SQLite3 database on memory (keyed by SQL)
+ * @param fileStatementCache	Prepared INSERT statements of SQLite3 database on file
  * @param dataFrame			DataFrame which is the core data for CEP
  * @param maxRecord			Maximum record number of table in memory
  * @param vacuumRecord		Number of records to execute database vacuum processing (auto vacuum setting in case of 0)
  * @param recordCounter		Record number counter for executing vacuum process of database
  * @param persistence		Flag indicating permanence of SQLite3 database on file
+ * @param shadowRecord		Flag indicating whether the record window is also copied into the DataFrame
+ * @param lock				Mutex serializing the access to SQLite3 databases (caller threads and writer thread)
+ * @param queue				Queue of CSV strings waiting for the writer thread (NULL in case of synchronous mode)
+ * @param queueThread		Writer thread of asynchronous mode
+ * @param queueMutex		Mutex for waking up the writer thread
+ * @param queueCondition	Condition variable for waking up the writer thread
+ * @param queueBlocking		Flag indicating whether M2MCEP_enqueueCSV() waits (true) or drops (false) when the queue is full
+ * @param queueRunning		Flag indicating the writer thread accepts CSV strings
+ * @param queueSleeping		Flag indicating the writer thread is waiting for CSV strings
+ * @param maxQueueLength	High-water mark of the queue length
+ * @param droppedCSV		Number of CSV strings dropped because the queue was full
+ * @param groupCommitMaxRecord	Maximum number of records accumulated for group commit (0: group commit is disabled)
+ * @param groupCommitMaxByte	Maximum size of CSV strings accumulated for group commit[Byte]
+ * @param groupCommitMaxDelay	Maximum delay of group commit[usec]
+ * @param pendingRecord		Number of records accumulated for group commit
+ * @param pendingByte		Size of CSV strings accumulated for group commit[Byte]
+ * @param pendingTime		Time when the first record was accumulated[usec]
+ * @param committedRecord	Total number of records committed into SQLite3 database in memory
+ * @param commitHandler		Handler notified of committed records
+ * @param commitHandlerData	Pointer passed to the commit handler
+ * @param persistenceBatch		First batch waiting for the background persistence thread
+ * @param persistenceBatchTail	Last batch waiting for the background persistence thread
+ * @param persistenceThread		Background persistence thread (owns SQLite3 database on file while running)
+ * @param persistenceMutex		Mutex protecting the batches and the counters of background persistence
+ * @param persistenceCondition	Condition variable for handing off batches and waiting for their persistence
+ * @param persistenceRunning	Flag indicating the background persistence thread accepts batches
+ * @param persistenceVacuum		Flag requesting the background persistence thread to vacuum SQLite3 database on file
+ * @param handedOffRecord		Total number of records handed off to the background persistence thread
+ * @param persistedRecord		Total number of records committed by the background persistence thread
+ * @param maxInFlightRecord		Number of handed off (not yet persisted) records beyond which the caller waits
+ * @param incrementalVacuumPage	Number of free pages starting an incremental vacuum slice (0: incremental vacuum is disabled)
+ * @param incrementalVacuumStep	Number of pages removed by one "PRAGMA incremental_vacuum"
+ * @param incrementalVacuumTime	Time limit of one incremental vacuum slice[usec]
+ * @param vacuumTime			Time spent by the last incremental vacuum slice[usec]
+ * @param vacuumPage			Total number of pages removed by incremental vacuum
+ * @param checkpoint			Flag indicating the window is kept in the snapshot file (M2MCEP_delete() takes the last checkpoint)
+ * @param checkpointThread		Background checkpoint thread
+ * @param checkpointMutex		Mutex serializing checkpoints (also used for waking up the checkpoint thread)
+ * @param checkpointCondition	Condition variable for waking up the checkpoint thread
+ * @param checkpointRunning		Flag indicating the background checkpoint thread is running
+ * @param checkpointInterval	Interval of background checkpoints[usec]
+ * @param checkpointTime		Time spent by the last checkpoint[usec]
+ * @param log					Write-ahead log of the inserted records (NULL: disabled)
+ * @param logMark				Last rowids of the tables per closed segment file of the log
+ * @param logSegment			First segment file of the log not included in the restored snapshot
+ * @param partition				Time partitions of the SQLite3 database on file (NULL: single database file)
+ * @param columnStore			Column stores of the tables persisted in the compressed columnar format (instead of SQLite3 database on file)
+ * @param evictionTime			Time when records last left the record window (UNIX time)[sec]
+ * @param window				Window definitions per table (NULL: all tables use maxRecord)
+ * @param query				Registered continuous queries
+ * @param lastQueryID		ID of the last registered query
+ * @param aggregate			Aggregates maintained incrementally
+ * @param pattern			Registered event patterns
+ * @param lastPatternID		ID of the last registered pattern
  * @param logger			File logging object
  */
 #ifndef M2MCEP
@@ -93,20 +390,142 @@ typedef struct
 	M2MTableManager *tableManager;
 	sqlite3 *memoryDatabase;
 	sqlite3 *fileDatabase;
+	M2MStatementCache *memoryStatementCache;
+	M2MStatementCache *selectStatementCache;
+	M2MStatementCache *fileStatementCache;
 	M2MDataFrame *dataFrame;
 	unsigned int maxRecord;
 	unsigned int vacuumRecord;
 	unsigned int recordCounter;
 	bool persistence;
+	bool shadowRecord;
+	pthread_mutex_t lock;
+	M2MConcurrentQueue *queue;
+	pthread_t queueThread;
+	pthread_mutex_t queueMutex;
+	pthread_cond_t queueCondition;
+	bool queueBlocking;
+	atomic_bool queueRunning;
+	atomic_bool queueSleeping;
+	atomic_size_t maxQueueLength;
+	atomic_ulong droppedCSV;
+	unsigned int groupCommitMaxRecord;
+	size_t groupCommitMaxByte;
+	uint64_t groupCommitMaxDelay;
+	unsigned int pendingRecord;
+	size_t pendingByte;
+	uint64_t pendingTime;
+	atomic_ulong committedRecord;
+	M2MCEPCommitHandler commitHandler;
+	void *commitHandlerData;
+	M2MCEPPersistenceBatch *persistenceBatch;
+	M2MCEPPersistenceBatch *persistenceBatchTail;
+	pthread_t persistenceThread;
+	pthread_mutex_t persistenceMutex;
+	pthread_cond_t persistenceCondition;
+	atomic_bool persistenceRunning;
+	bool persistenceVacuum;
+	unsigned long handedOffRecord;
+	unsigned long persistedRecord;
+	unsigned int maxInFlightRecord;
+	unsigned int incrementalVacuumPage;
+	unsigned int incrementalVacuumStep;
+	uint64_t incrementalVacuumTime;
+	atomic_ulong vacuumTime;
+	atomic_ulong vacuumPage;
+	bool checkpoint;
+	pthread_t checkpointThread;
+	pthread_mutex_t checkpointMutex;
+	pthread_cond_t checkpointCondition;
+	atomic_bool checkpointRunning;
+	uint64_t checkpointInterval;
+	atomic_ulong checkpointTime;
+	M2MCEPLog *log;
+	M2MCEPLogMark *logMark;
+	uint32_t logSegment;
+	M2MCEPPartition *partition;
+	M2MCEPColumnStore *columnStore;
+	time_t evictionTime;
+	M2MCEPWindow *window;
+	M2MCEPQuery *query;
+	unsigned int lastQueryID;
+	M2MCEPAggregate *aggregate;
+	M2MCEPPattern *pattern;
+	unsigned int lastPatternID;
 	M2MFileAppender *logger;
 	} M2MCEP;
 #endif /* M2MCEP */
 
 
+/**
+ * Read handle of the SQLite3 database in memory (see M2MCEP_openReader()).<br>
+ * The reader queries a read-only snapshot of the window held by its own <br>
+ * SQLite3 connection, so that long SELECT statements don't block insertion.<br>
+ *
+ * @param cep				CEP structure object taking the snapshots
+ * @param database			SQLite3 connection holding the snapshot
+ * @param statementCache	Prepared SELECT statements of the snapshot
+ * @param maxAge			Minimum time between two snapshots[usec]
+ * @param snapshotTime		Time when the snapshot was taken[usec]
+ * @param committedRecord	Number of committed records included in the snapshot
+ */
+#ifndef M2MCEPReader
+typedef struct
+	{
+	M2MCEP *cep;
+	sqlite3 *database;
+	M2MStatementCache *statementCache;
+	uint64_t maxAge;
+	uint64_t snapshotTime;
+	unsigned long committedRecord;
+	} M2MCEPReader;
+#endif /* M2MCEPReader */
+
+
 
 /*******************************************************************************
  * Public function
  ******************************************************************************/
+/**
+ * Save a snapshot of the SQLite3 database in memory (the record window) into <br>
+ * the snapshot file ("~/.m2m/cep/databaseName.sqlite.snapshot").<br>
+ * The records accumulated for group commit are committed first, then the <br>
+ * database is copied with sqlite3_serialize() while the CEP object is locked; <br>
+ * the copy is written into a temporary file, synchronized and renamed so that <br>
+ * a crash never leaves a broken snapshot.<br>
+ * When the CEP object opens the SQLite3 database in memory (first access <br>
+ * after M2MCEP_new()), the snapshot is restored with the online backup API <br>
+ * instead of waiting for new records to fill the window again. Once a <br>
+ * snapshot is used, M2MCEP_delete() takes the last checkpoint.<br>
+ * The records evicted between the last checkpoint and a crash can be <br>
+ * inserted into the SQLite3 database on file again after the restart.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_checkpoint (M2MCEP *self);
+
+
+/**
+ * Release the read handle (the snapshot and its prepared statements).<br>
+ *
+ * @param[in,out] reader	Read handle to be freed of memory area
+ */
+void M2MCEP_closeReader (M2MCEPReader **reader);
+
+
+/**
+ * Commit the records accumulated for group commit now (see <br>
+ * M2MCEP_setGroupCommit()).<br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Number of committed records[row] or -1 (in case of error)
+ */
+int M2MCEP_commit (M2MCEP *self);
+
+
 /**
  * Release the heap memory of CEP structure object. <br>
  * Note that after calling this function, caller will not be able to access <br>
@@ -117,6 +536,75 @@ typedef struct
 void M2MCEP_delete (M2MCEP **self);
 
 
+/**
+ * Put the CSV format string into the queue of the asynchronous mode and return <br>
+ * without waiting for the insertion.<br>
+ * The strings are copied, then inserted in order by the asynchronous writer <br>
+ * thread in the same way as M2MCEP_insertCSV().<br>
+ * When the queue is full, the caller waits for a free slot (blocking policy) <br>
+ * or the CSV string is discarded and counted (drop policy).<br>
+ * Any number of threads can call this function at the same time.<br>
+ *
+ * @param[in,out] self	CEP structure object in asynchronous mode
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				1: queued, 0: dropped because the queue is full, -1: error
+ */
+int M2MCEP_enqueueCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv);
+
+
+/**
+ * Wait until all records handed off to the background persistence thread so <br>
+ * far are committed into the SQLite3 database on file (barrier).<br>
+ * Records still held in the SQLite3 database in memory are not concerned; they <br>
+ * are persisted when they leave the record window.<br>
+ * The evicted records waiting for the next block of the column stores <br>
+ * (M2MCEP_setColumnStore()) are also written into the files.<br>
+ * Returns immediately if background persistence is not running and no column <br>
+ * store is set.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_flushPersistence (M2MCEP *self);
+
+
+/**
+ * Returns the value of the aggregate declared with M2MCEP_setAggregate() in <br>
+ * O(1), without scanning the table of SQLite3 database in memory.<br>
+ * The value is also available in SQL through the function <br>
+ * M2MCEP_AGGREGATE_FUNCTION.<br>
+ *
+ * @param[in] self			CEP structure object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @param[in] type			Kind of aggregate value
+ * @return					Aggregate value or NAN (in case of error, undeclared aggregate or empty window)
+ */
+double M2MCEP_getAggregate (M2MCEP *self, const M2MString *tableName, const M2MString *columnName, const M2MCEPAggregateType type);
+
+
+/**
+ * Returns the time spent by the last checkpoint (see M2MCEP_checkpoint()).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Time of the last checkpoint[usec]
+ */
+unsigned long M2MCEP_getCheckpointTime (M2MCEP *self);
+
+
+/**
+ * Returns the total number of records committed into the SQLite3 database in <br>
+ * memory so far.<br>
+ * A caller can compare it with the number of records it has inserted to know <br>
+ * whether its records have been committed (group commit or asynchronous mode).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Total number of committed records[row]
+ */
+unsigned long M2MCEP_getCommittedRecordCount (M2MCEP *self);
+
+
 /**
  * Return string indicating the database name possessed by the CEP object.<br>
  *
@@ -126,6 +614,27 @@ void M2MCEP_delete (M2MCEP **self);
 M2MString *M2MCEP_getDatabaseName (const M2MCEP *self);
 
 
+/**
+ * Returns the number of CSV strings discarded by M2MCEP_enqueueCSV() because <br>
+ * the queue was full (drop policy).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of dropped CSV strings
+ */
+unsigned long M2MCEP_getDroppedCSVCount (M2MCEP *self);
+
+
+/**
+ * Returns the total number of records evicted from the table of the SQLite3 <br>
+ * database in memory (the records left the record window).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Number of evicted records[row] (0 in case of unknown table)
+ */
+unsigned long M2MCEP_getEvictedRecordCount (M2MCEP *self, const M2MString *tableName);
+
+
 /**
  * Get the SQLite3 database object on the file managed by the CEP object. <br>
  * If the CEP object does not hold the SQLite 3 database object on the file <br>
@@ -138,6 +647,36 @@ M2MString *M2MCEP_getDatabaseName (const M2MCEP *self);
 sqlite3 *M2MCEP_getFileDatabase (M2MCEP *self);
 
 
+/**
+ * Returns the number of records handed off to the background persistence <br>
+ * thread and not yet committed into the SQLite3 database on file.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Number of in-flight records[row]
+ */
+unsigned long M2MCEP_getInFlightRecordCount (M2MCEP *self);
+
+
+/**
+ * Return the number of INSERT operations which reused a prepared statement <br>
+ * cached per table and column header (total of memory and file database).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of cache hits
+ */
+uint64_t M2MCEP_getInsertCacheHitCount (const M2MCEP *self);
+
+
+/**
+ * Return the number of INSERT operations which had to compile a new prepared <br>
+ * statement (total of memory and file database).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of cache misses
+ */
+uint64_t M2MCEP_getInsertCacheMissCount (const M2MCEP *self);
+
+
 /**
  * Return the logging object owned by the argument CEP object.<br>
  *
@@ -147,6 +686,15 @@ sqlite3 *M2MCEP_getFileDatabase (M2MCEP *self);
 M2MFileAppender *M2MCEP_getLogger (const M2MCEP *self);
 
 
+/**
+ * Returns the high-water mark of the queue length of the asynchronous mode.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Maximum number of CSV strings waiting in the queue so far
+ */
+size_t M2MCEP_getMaxQueueLength (M2MCEP *self);
+
+
 /**
  * Return the SQLite 3 database object on the memory managed by the CEP object.<br>
  *
@@ -156,6 +704,56 @@ M2MFileAppender *M2MCEP_getLogger (const M2MCEP *self);
 sqlite3 *M2MCEP_getMemoryDatabase (M2MCEP *self);
 
 
+/**
+ * Returns the number of CSV strings currently waiting in the queue of the <br>
+ * asynchronous mode.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of waiting CSV strings (0 in case of synchronous mode)
+ */
+size_t M2MCEP_getQueueLength (M2MCEP *self);
+
+
+/**
+ * Return the number of SELECT operations which reused a prepared statement <br>
+ * cached per SQL string.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of cache hits
+ */
+uint64_t M2MCEP_getSelectCacheHitCount (const M2MCEP *self);
+
+
+/**
+ * Return the number of SELECT operations which had to compile a new prepared <br>
+ * statement (first use, eviction or schema change).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of cache misses
+ */
+uint64_t M2MCEP_getSelectCacheMissCount (const M2MCEP *self);
+
+
+/**
+ * Returns the total number of free pages removed by incremental vacuum (see <br>
+ * M2MCEP_setIncrementalVacuum()).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of removed pages
+ */
+unsigned long M2MCEP_getVacuumPageCount (M2MCEP *self);
+
+
+/**
+ * Returns the time spent by the last incremental vacuum slice (see <br>
+ * M2MCEP_setIncrementalVacuum()).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Time of the last slice[usec]
+ */
+unsigned long M2MCEP_getVacuumTime (M2MCEP *self);
+
+
 /**
  * Return CEP library version number string defined in "M2MCEP.h" file.<br>
  *
@@ -177,6 +775,10 @@ M2MString *M2MCEP_getVersion ();
  *    structure object and insert it into the SQLite3 database file for <br>
  *    persistence. <br>
  * 5) Delete excess from record data of CEPRecord structure object. <br>
+ * In group commit mode, the records are accumulated and committed later (see <br>
+ * M2MCEP_setGroupCommit()).<br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
  *
  * @param[in,out] self	CEP structure object
  * @param[in] tableName	String indicating the table name to be inserted record
@@ -186,6 +788,28 @@ M2MString *M2MCEP_getVersion ();
 int M2MCEP_insertCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv);
 
 
+/**
+ * Insert typed records into the table of SQLite 3 database for CEP. <br>
+ * Unlike M2MCEP_insertCSV(), values are bound to the prepared INSERT statement <br>
+ * as they are (without formatting into or parsing from CSV format string), so <br>
+ * this is suitable for high frequency ingestion. <br>
+ * The inserted records are subject to the same record window, eviction and <br>
+ * persistence as M2MCEP_insertCSV(). Records of the table are kept only in the <br>
+ * SQLite3 database in memory (not copied into the record management object) <br>
+ * until they are evicted. <br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order (values of a row are arranged in the column order of the table definition)
+ * @param[in] rows		Number of records[row]
+ * @param[in] columns	Number of values per record (must match the number of columns of the table)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+int M2MCEP_insertRecords (M2MCEP *self, const M2MString *tableName, const M2MCEPValue *values, const size_t rows, const size_t columns);
+
+
 /**
  * Constructor.<br>
  * Create new CEP structure object and prepare for SQLite3 database processing. <br>
@@ -199,6 +823,96 @@ int M2MCEP_insertCSV (M2MCEP *self, const M2MString *tableName, const M2MString
 M2MCEP *M2MCEP_new (const M2MString *databaseName, const M2MTableManager *tableManager);
 
 
+/**
+ * Open a read handle of the SQLite3 database in memory for the calling <br>
+ * thread.<br>
+ * The reader holds a read-only snapshot of the window (taken with <br>
+ * sqlite3_serialize() while the CEP object is locked for a moment) in its <br>
+ * own SQLite3 connection. M2MCEP_selectReader() runs on the snapshot without <br>
+ * locking the CEP object, so that ingest continues during long queries.<br>
+ * A new snapshot is taken before a query when records were committed and <br>
+ * "maxAge" has elapsed since the last one (copy of the whole window).<br>
+ * The SQL function of M2MCEP_setAggregate() isn't available in a reader.<br>
+ * A reader must be used by one thread at a time and be closed with <br>
+ * M2MCEP_closeReader() before the CEP object is deleted.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] maxAge	Minimum time between two snapshots[usec] (0: every query sees the latest committed records)
+ * @return				Read handle or NULL (in case of error)
+ */
+M2MCEPReader *M2MCEP_openReader (M2MCEP *self, const uint64_t maxAge);
+
+
+/**
+ * Register the event pattern built with M2MCEPPattern_new(), <br>
+ * M2MCEPPattern_followedBy() and M2MCEPPattern_notFollowedBy().<br>
+ * The pattern is compiled into a NFA and the records inserted from now on are <br>
+ * given to it after every committed batch (before the excess records are <br>
+ * evicted), so that a match is found without joining the tables.<br>
+ * The callback is called on the thread committing the records (the <br>
+ * asynchronous writer thread in asynchronous mode) and must not call <br>
+ * functions of the CEP object.<br>
+ * The pattern is owned by the CEP object when it is registered.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] pattern	Event pattern object
+ * @param[in] callback		Callback receiving the matches
+ * @param[in] userData		Pointer passed to the callback as it is
+ * @return					ID of the pattern (>0) or -1 (in case of error)
+ */
+int M2MCEP_registerPattern (M2MCEP *self, M2MCEPPattern *pattern, const M2MCEPPatternCallback callback, void *userData);
+
+
+/**
+ * Register the SELECT statement as a continuous query.<br>
+ * The statement stays prepared on the SQLite3 database in memory and is <br>
+ * evaluated after every committed batch of records (after the window is <br>
+ * updated), only when a table read by the statement has received records. <br>
+ * Each row of the result is delivered to the callback as typed values.<br>
+ * The callback is called on the thread committing the records (the <br>
+ * asynchronous writer thread in asynchronous mode) and must not call <br>
+ * functions of the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[in] callback	Callback receiving the rows of the result
+ * @param[in] userData	Pointer passed to the callback as it is
+ * @return				ID of the query (>0) or -1 (in case of error)
+ */
+int M2MCEP_registerQuery (M2MCEP *self, const M2MString *sql, const M2MCEPQueryCallback callback, void *userData);
+
+
+/**
+ * Replace the snapshot of the read handle with the current window.<br>
+ *
+ * @param[in,out] reader	Read handle
+ * @return					Read handle or NULL (in case of error)
+ */
+M2MCEPReader *M2MCEP_refreshReader (M2MCEPReader *reader);
+
+
+/**
+ * Hands the records of the column store of the table (M2MCEP_setColumnStore()) <br>
+ * whose time is within the range to the callback as typed values, in the <br>
+ * order of eviction.<br>
+ * Only the blocks whose minimum and maximum time overlap the range are read <br>
+ * from the file and only the indicated columns are decompressed. The records <br>
+ * still in the SQLite3 database in memory aren't included.<br>
+ * The callback is called with the CEP object locked and must not call <br>
+ * functions of the CEP object.<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in] tableName			String indicating the table name
+ * @param[in] from				Start of the range of the time column
+ * @param[in] to				End of the range of the time column (inclusive)
+ * @param[in] columnNameCSV		Column names separated by commas (NULL: all columns in the order of the table)
+ * @param[in] callback			Callback receiving the records
+ * @param[in] userData			Pointer passed to the callback as it is
+ * @return						Number of records handed to the callback or -1 (in case of error)
+ */
+int M2MCEP_scanColumnStore (M2MCEP *self, const M2MString *tableName, const int64_t from, const int64_t to, const M2MString *columnNameCSV, const M2MCEPRowCallback callback, void *userData);
+
+
 /**
  * Executes the SQL statement specified by the argument on the SQLite 3 database <br>
  * in memory and returns the result as a CSV format string.<br>
@@ -214,6 +928,8 @@ M2MCEP *M2MCEP_new (const M2MString *databaseName, const M2MTableManager *tableM
  * result.<br>
  * If "SQLITE_ENABLE_COLUMN_METADATA" is not valid, keep in mind that this <br>
  * function will cause a compile error (because undefined functions are called).<br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
  *
  * @param[in] self		CEP structure object (used for database management)
  * @param[in] sql		String indicating SQL statement
@@ -223,6 +939,228 @@ M2MCEP *M2MCEP_new (const M2MString *databaseName, const M2MTableManager *tableM
 unsigned char *M2MCEP_select (M2MCEP *self, const M2MString *sql, M2MString **result);
 
 
+/**
+ * Executes the SELECT statement on the SQLite3 database in memory and hands <br>
+ * each row of the result to the callback as typed values read directly from <br>
+ * the prepared statement (no CSV string is built and no value is converted).<br>
+ * The callback is called with the CEP object locked and must not call <br>
+ * functions of the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[in] callback	Callback receiving the rows of the result
+ * @param[in] userData	Pointer passed to the callback as it is
+ * @return				Number of rows handed to the callback or -1 (in case of error)
+ */
+int M2MCEP_selectEach (M2MCEP *self, const M2MString *sql, const M2MCEPRowCallback callback, void *userData);
+
+
+/**
+ * Executes the SELECT statement on the history persisted into the SQLite3 <br>
+ * database on file and returns the result as a CSV format string (same <br>
+ * format as M2MCEP_select()).<br>
+ * With time partitions (M2MCEP_setPartition()), only the partition files <br>
+ * overlapping the time range are attached (read-only) to a dedicated SQLite3 <br>
+ * connection and each table is a view joining them with UNION ALL, so the <br>
+ * SQL statement uses the table names as they are. Records belong to the <br>
+ * partition of the time they were persisted. The range can overlap at most <br>
+ * as many partitions as SQLite3 can attach (SQLITE_LIMIT_ATTACHED, 10 by <br>
+ * default). Without time partitions, the whole database file is queried.<br>
+ * The CEP object is locked only while the partition files are attached.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] from		Start of the time range (UNIX time)[sec]
+ * @param[in] to		End of the time range (inclusive, UNIX time)[sec]
+ * @param[in] sql		String indicating SELECT statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return				CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEP_selectHistory (M2MCEP *self, const time_t from, const time_t to, const M2MString *sql, M2MString **result);
+
+
+/**
+ * Executes the SELECT statement (with parameters like <br>
+ * M2MCEP_selectWithParams()) on the snapshot of the read handle and returns <br>
+ * the result as a CSV format string (same format as M2MCEP_select()).<br>
+ * The CEP object isn't locked except while a new snapshot is taken.<br>
+ *
+ * @param[in,out] reader	Read handle
+ * @param[in] sql			String indicating SELECT statement
+ * @param[in] params		Array of typed values bound into the parameters or NULL
+ * @param[in] numberOfParam	Number of typed values
+ * @param[out] result		CSV character string of execution result or NULL (in case of error)
+ * @return					CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEP_selectReader (M2MCEPReader *reader, const M2MString *sql, const M2MCEPValue *params, const size_t numberOfParam, M2MString **result);
+
+
+/**
+ * Executes the SELECT statement on the SQLite3 database in memory and returns <br>
+ * the result as a columnar result set: integer and real columns are <br>
+ * contiguous typed arrays, text and binary columns are offsets into a byte <br>
+ * heap (no base64) and NULL values are held in bitmaps.<br>
+ * The result set can be read without copying or serialized for IPC with <br>
+ * M2MCEPResultSet_serialize(). Caller must release it with <br>
+ * M2MCEPResultSet_delete().<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @return				Result set (possibly with 0 rows) or NULL (in case of error)
+ */
+M2MCEPResultSet *M2MCEP_selectResultSet (M2MCEP *self, const M2MString *sql);
+
+
+/**
+ * Executes the SELECT statement on the record window of SQLite3 database in <br>
+ * memory joined with the history persisted into the SQLite3 database on file <br>
+ * and returns the result as a CSV format string (same format as <br>
+ * M2MCEP_select()), so that the SQL statement compares recent and past <br>
+ * records with the table names as they are.<br>
+ * The history is pruned with the time range as M2MCEP_selectHistory() <br>
+ * (records belong to the time they left the record window). When no record <br>
+ * has left the window since "from", the statement is executed on SQLite3 <br>
+ * database in memory as M2MCEP_select() without touching any file. <br>
+ * Otherwise the window of the tables read by the statement is copied into a <br>
+ * dedicated SQLite3 connection where each table is a view joining it and the <br>
+ * attached partition files (or the single database file) with UNION ALL; the <br>
+ * records handed off to the background persistence thread are committed <br>
+ * before the copy, so that every record appears exactly once. The CEP object <br>
+ * is locked only while copying those tables, not while executing the <br>
+ * statement. The records of the column stores (M2MCEP_setColumnStore()) <br>
+ * aren't included.<br>
+ * Note that the time range is compared with the (wall-clock) time the records <br>
+ * left the record window, not with any time column of the records, and it <br>
+ * only selects the files to be attached. Thus the result contains records <br>
+ * outside [from, to] unless the SQL statement also filters the records by <br>
+ * their own time column.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] from		Start of the time range (UNIX time)[sec]
+ * @param[in] to		End of the time range (inclusive, UNIX time)[sec]
+ * @param[in] sql		String indicating SELECT statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return				CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEP_selectUnified (M2MCEP *self, const time_t from, const time_t to, const M2MString *sql, M2MString **result);
+
+
+/**
+ * Executes the SELECT statement including parameters ("?", "?NNN", ":AAA", <br>
+ * etc.) on the SQLite3 database in memory and returns the result as a CSV <br>
+ * format string (same format as M2MCEP_select()).<br>
+ * The typed values are bound into the parameters with sqlite3_bind_*() in <br>
+ * the order of their index, so one cached prepared statement serves all <br>
+ * values and strings supplied by devices are never parsed as SQL.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] sql			String indicating SELECT statement including parameters
+ * @param[in] params		Array of typed values (the number must equal the number of parameters)
+ * @param[in] numberOfParam	Number of typed values
+ * @param[out] result		CSV character string of execution result or NULL (in case of error)
+ * @return					CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEP_selectWithParams (M2MCEP *self, const M2MString *sql, const M2MCEPValue *params, const size_t numberOfParam, M2MString **result);
+
+
+/**
+ * Declare the aggregate (sum, count, average, minimum and maximum) of the <br>
+ * numeric column of the table held in the SQLite3 database in memory.<br>
+ * The aggregate is updated incrementally with the inserted and evicted <br>
+ * records (NULL values are ignored like SQL) and is read in O(1) with <br>
+ * M2MCEP_getAggregate() or with the SQL function M2MCEP_AGGREGATE_FUNCTION.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @return					CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setAggregate (M2MCEP *self, const M2MString *tableName, const M2MString *columnName);
+
+
+/**
+ * Persist the records evicted from the table into the compressed columnar <br>
+ * file "~/.m2m/cep/databaseName.sqlite.column/tableName.column" instead of <br>
+ * the SQLite3 database on file (M2MCEP_setPersistence() must be enabled).<br>
+ * The records are stored by column in blocks of "blockRecord" records: <br>
+ * timestamps and other INTEGER columns with delta-of-delta encoding, REAL <br>
+ * columns with the XOR of the previous value and TEXT/BLOB columns with a <br>
+ * dictionary per block, so that periodic numeric time-series take a few bits <br>
+ * per value. The minimum and maximum of the time column are indexed per <br>
+ * block for M2MCEP_scanColumnStore().<br>
+ * A block is written when it is full, by M2MCEP_flushPersistence(), before <br>
+ * the segment files of the write-ahead log are removed and by <br>
+ * M2MCEP_delete(); the records of a partial block are lost by a crash of <br>
+ * the process unless the write-ahead log is enabled.<br>
+ * The records are written by the thread evicting them (not by the background <br>
+ * persistence thread) and aren't included in M2MCEP_selectHistory(). The <br>
+ * columns of an existing file must be the same as the table. The table <br>
+ * doesn't keep the copy of M2MCEP_setShadowRecord() while it has the column <br>
+ * store (the evicted records are read back from the SQLite3 database in <br>
+ * memory).<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in] tableName			String indicating the table name
+ * @param[in] timeColumnName	String indicating the INTEGER column indexed per block (e.g. event time)
+ * @param[in] blockRecord		Number of records of one block (0: remove the column store of the table, the file is kept)
+ * @return						CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setColumnStore (M2MCEP *self, const M2MString *tableName, const M2MString *timeColumnName, const unsigned int blockRecord);
+
+
+/**
+ * Set the handler called every time records are committed into the SQLite3 <br>
+ * database in memory.<br>
+ * The handler is called on the thread committing the records (the asynchronous <br>
+ * writer thread in asynchronous mode) and must not call functions of the CEP <br>
+ * object.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] commitHandler	Handler function or NULL (to remove the handler)
+ * @param[in] userData		Pointer passed to the handler as it is
+ * @return					CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setCommitHandler (M2MCEP *self, const M2MCEPCommitHandler commitHandler, void *userData);
+
+
+/**
+ * Set the group commit mode.<br>
+ * Records inserted by M2MCEP_insertCSV() (or M2MCEP_enqueueCSV()) are <br>
+ * accumulated and committed into the SQLite3 databases with one transaction <br>
+ * per database when one of the limits is reached. M2MCEP_select(), <br>
+ * M2MCEP_commit() and M2MCEP_delete() commit the accumulated records at once.<br>
+ * In asynchronous mode, the writer thread also commits when the queue becomes <br>
+ * empty and the delay limit is reached.<br>
+ * A limit of 0 is not used; if "maxRecord" is 0, records are committed for each <br>
+ * call (default).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] maxRecord	Maximum number of accumulated records[row] (0: group commit is disabled)
+ * @param[in] maxByte	Maximum size of accumulated CSV strings[Byte]
+ * @param[in] maxDelay	Maximum delay from the first accumulated record[usec]
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setGroupCommit (M2MCEP *self, const unsigned int maxRecord, const size_t maxByte, const uint64_t maxDelay);
+
+
+/**
+ * Replace the periodic full VACUUM with incremental vacuum.<br>
+ * The SQLite3 databases are switched to "auto_vacuum=INCREMENTAL" and, after <br>
+ * each commit, when the freelist holds more than "freelistPage" pages, free <br>
+ * pages are removed with "PRAGMA incremental_vacuum(stepPage)" until the <br>
+ * freelist is empty or the slice exceeds "sliceTime". The SQLite3 database on <br>
+ * file is maintained by the background persistence thread when it is running <br>
+ * (call this function before M2MCEP_startPersistence()).<br>
+ * The record counter of M2MCEP_setVacuumRecord() is not used in this mode.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] freelistPage	Number of free pages starting a slice (0: disable incremental vacuum)
+ * @param[in] stepPage		Number of pages removed by one step
+ * @param[in] sliceTime		Time limit of one slice[usec]
+ * @return					CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setIncrementalVacuum (M2MCEP *self, const unsigned int freelistPage, const unsigned int stepPage, const uint64_t sliceTime);
+
+
 /**
  * Set logging structure object in column information object.<br>
  *
@@ -237,8 +1175,8 @@ M2MCEP *M2MCEP_setLogger (M2MCEP *self, const M2MFileAppender *logger);
  * Change the maximum number of records that can be stored in each table in the <br>
  * SQLite 3 database existing in memory to the integer value specified by the <br>
  * argument.<br>
- * Note that it is not possible to set an integer number of 500 or more to the <br>
- * record number upper limit value.<br>
+ * Note that it is not possible to set an integer number of 10000000 or more to <br>
+ * the record number upper limit value.<br>
  *
  * @param[in,out] self		Maximum number of records CEP execution object to be changed
  * @param[in] maxRecord		Integer indicating the maximum number of records in one table or 0 (in case of error)
@@ -247,6 +1185,24 @@ M2MCEP *M2MCEP_setLogger (M2MCEP *self, const M2MFileAppender *logger);
 M2MCEP *M2MCEP_setMaxRecord (M2MCEP *self, const unsigned int maxRecord);
 
 
+/**
+ * Divide the SQLite3 database on file into time partitions.<br>
+ * The evicted records are inserted into the partition file of the current <br>
+ * time ("~/.m2m/cep/databaseName.sqlite.partition/YYYYMMDDhhmmss.sqlite", <br>
+ * UTC) and a new file is started at the next transaction once the interval <br>
+ * has elapsed. When a partition file is started, the files older than <br>
+ * "retention" partitions are removed as a whole, so that the disk usage stays <br>
+ * bounded without DELETE and vacuum.<br>
+ * Call this function before starting background persistence.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] interval		Time range of one partition[sec] (e.g. M2MCEPPartition_HOUR, 0: single database file)
+ * @param[in] retention		Number of partitions kept including the current one (0: all)
+ * @return					CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setPartition (M2MCEP *self, const unsigned int interval, const unsigned int retention);
+
+
 /**
  * Set a flag indicating permanence (recording in the SQLite 3 database on the <br>
  * file) to the CEP structure object specified by the argument.<br>
@@ -261,6 +1217,21 @@ M2MCEP *M2MCEP_setMaxRecord (M2MCEP *self, const unsigned int maxRecord);
 M2MCEP *M2MCEP_setPersistence (M2MCEP *self, const bool persistence);
 
 
+/**
+ * Set a flag indicating whether the records held in the SQLite 3 database in <br>
+ * memory are also copied into the record management object.<br>
+ * When set to "false", the SQLite 3 database in memory is the only holder of <br>
+ * the record window and the records exceeding the maximum number of records <br>
+ * are read back from it by rowid range for persistence.<br>
+ * This flag can't be changed after records have been inserted.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] shadowRecord	true: keep a copy of the record window (default), false: don't copy
+ * @return					CEP structure object with the flag or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setShadowRecord (M2MCEP *self, const bool shadowRecord);
+
+
 /**
  * When forcibly terminating when using the shared library (libcep.so), set the <br>
  * event handler to acquire the signal and perform the termination processing.<br>
@@ -282,6 +1253,158 @@ void M2MCEP_setSignalHandler (const M2MCEP *self);
 M2MCEP *M2MCEP_setVacuumRecord (M2MCEP *self, const unsigned int vacuumRecord);
 
 
+/**
+ * Define the window of the table held in the SQLite3 database in memory, in <br>
+ * place of the maximum number of records shared by all tables <br>
+ * (M2MCEP_setMaxRecord()).<br>
+ * The window is limited by number of records, by event time ("duration" back <br>
+ * from the latest value of the integer column "timeColumnName", e.g. DATETIME) <br>
+ * or by both. An index is created on the event time column so that eviction <br>
+ * and SELECT over the window only touch the current range.<br>
+ * Records are evicted in insertion order, so event time is expected to <br>
+ * increase with insertion.<br>
+ * Specify 0 for both "maxRecord" and "duration" to remove the definition.<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in] tableName			String indicating the table name
+ * @param[in] maxRecord			Maximum number of records (0: not limited by number)
+ * @param[in] timeColumnName	String indicating the column of event time (ignored when duration is 0)
+ * @param[in] duration			Duration of the window in the unit of the event time column (0: not limited by time)
+ * @return						CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setWindow (M2MCEP *self, const M2MString *tableName, const unsigned int maxRecord, const M2MString *timeColumnName, const int64_t duration);
+
+
+/**
+ * Enable the write-ahead log of the records inserted into the SQLite3 <br>
+ * database in memory, so that the window survives a crash.<br>
+ * Every M2MCEP_insertCSV() and M2MCEP_insertRecords() is appended to the <br>
+ * segment files under "~/.m2m/cep/databaseName.sqlite.wal/" as one entry <br>
+ * protected by CRC-32 (one sequential write instead of a transaction of the <br>
+ * SQLite3 database on file). The entries survive a crash of the process; <br>
+ * a crash of the OS can lose the entries written after the last fsync() <br>
+ * (every "syncRecord" entries and at the end of each segment file).<br>
+ * When enabled, the segment files left by the previous process are replayed <br>
+ * into the SQLite3 database in memory (after the snapshot of <br>
+ * M2MCEP_checkpoint(), which removes the segment files it includes). A <br>
+ * segment file is removed once all of its records have left the window <br>
+ * (inserted into the SQLite3 database on file in case of persistence). <br>
+ * The records of each table are numbered in the order of insertion and the <br>
+ * number of the last persisted record is recorded in the table <br>
+ * "m2mcep_sequence" of the SQLite3 database on file, in the transaction of <br>
+ * the evicted records (and in the snapshot). Replaying skips the records <br>
+ * already persisted, so they aren't inserted into the file twice. <br>
+ * Call this function before inserting records and with the same setting on <br>
+ * every start.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] segmentSize	Size of one segment file[Byte] (0: disable the log and remove its segment files)
+ * @param[in] syncRecord	Number of entries between two fsync() (1: every entry, 0: at the end of each segment file only)
+ * @return					CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setWriteAheadLog (M2MCEP *self, const size_t segmentSize, const unsigned int syncRecord);
+
+
+/**
+ * Start the asynchronous mode.<br>
+ * A writer thread is created, which owns the insertion into the SQLite3 <br>
+ * databases (memory and file); records are put by M2MCEP_enqueueCSV() into a <br>
+ * bounded lock-free queue. Other functions touching the databases (e.g. <br>
+ * M2MCEP_select()) are serialized with the writer thread.<br>
+ * Configure the CEP object (M2MCEP_setMaxRecord() etc.) before starting.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] capacity	Number of CSV strings the queue can hold (rounded up to a power of 2)
+ * @param[in] blocking	true: M2MCEP_enqueueCSV() waits when the queue is full, false: the CSV string is dropped
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_startAsync (M2MCEP *self, const unsigned int capacity, const bool blocking);
+
+
+/**
+ * Start background checkpoints.<br>
+ * A dedicated thread calls M2MCEP_checkpoint() every "interval" (the CEP <br>
+ * object is locked only while the database in memory is copied).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] interval	Interval of checkpoints[usec]
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_startCheckpoint (M2MCEP *self, const uint64_t interval);
+
+
+/**
+ * Start background persistence.<br>
+ * The records leaving the record window are copied and handed off to a <br>
+ * dedicated thread which owns the SQLite3 database on file and inserts all <br>
+ * the batches handed off since its last run in one transaction. The caller <br>
+ * waits (backpressure) only while more than "maxInFlightRecord" records are <br>
+ * not yet persisted.<br>
+ * Do not access the SQLite3 database on file directly while background <br>
+ * persistence is running.<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in] maxInFlightRecord		Maximum number of handed off records not yet persisted
+ * @return							CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_startPersistence (M2MCEP *self, const unsigned int maxInFlightRecord);
+
+
+/**
+ * Stop the asynchronous mode.<br>
+ * The CSV strings remaining in the queue are all inserted (drained) before the <br>
+ * writer thread finishes. Do not call M2MCEP_enqueueCSV() at the same time.<br>
+ * This function is also called by M2MCEP_delete().<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_stopAsync (M2MCEP *self);
+
+
+/**
+ * Stop background checkpoints.<br>
+ * This function is also called by M2MCEP_delete().<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_stopCheckpoint (M2MCEP *self);
+
+
+/**
+ * Stop background persistence.<br>
+ * The batches remaining in the queue are all committed into the SQLite3 <br>
+ * database on file before the thread finishes.<br>
+ * This function is also called by M2MCEP_delete().<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_stopPersistence (M2MCEP *self);
+
+
+/**
+ * Remove the event pattern registered with M2MCEP_registerPattern() (and <br>
+ * release it).<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] patternID		ID of the pattern
+ * @return					CEP structure object or NULL (in case of error or unknown ID)
+ */
+M2MCEP *M2MCEP_unregisterPattern (M2MCEP *self, const unsigned int patternID);
+
+
+/**
+ * Remove the continuous query registered with M2MCEP_registerQuery().<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] queryID	ID of the query
+ * @return				CEP structure object or NULL (in case of error or unknown ID)
+ */
+M2MCEP *M2MCEP_unregisterQuery (M2MCEP *self, const unsigned int queryID);
+
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * M2MCEPAggregate.h : Incrementally maintained aggregate of a window column
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPAGGREGATE_H_
+#define M2M_CEP_M2MCEPAGGREGATE_H_
+
+
+
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Enumerated object indicating the kind of aggregate value.<br>
+ */
+#ifndef M2MCEPAggregateType
+typedef enum
+	{
+	M2MCEPAggregateType_SUM,
+	M2MCEPAggregateType_COUNT,
+	M2MCEPAggregateType_AVG,
+	M2MCEPAggregateType_MIN,
+	M2MCEPAggregateType_MAX
+	} M2MCEPAggregateType;
+#endif /* M2MCEPAggregateType */
+
+
+/**
+ * Value of one record held by the aggregate.<br>
+ *
+ * @param rowid		Rowid of the record in SQLite3 database in memory
+ * @param value		Value of the aggregated column
+ */
+#ifndef M2MCEPAggregateEntry
+typedef struct
+	{
+	int64_t rowid;
+	double value;
+	} M2MCEPAggregateEntry;
+#endif /* M2MCEPAggregateEntry */
+
+
+/**
+ * Double ended queue of record values (circular array).<br>
+ *
+ * @param entry		Array of entries
+ * @param capacity	Number of slots of the array (power of 2)
+ * @param head		Index of the first entry
+ * @param length	Number of entries
+ */
+#ifndef M2MCEPAggregateDeque
+typedef struct
+	{
+	M2MCEPAggregateEntry *entry;
+	size_t capacity;
+	size_t head;
+	size_t length;
+	} M2MCEPAggregateDeque;
+#endif /* M2MCEPAggregateDeque */
+
+
+/**
+ * Aggregate of a numeric column over the records of a table held in the <br>
+ * SQLite3 database in memory (a node of a singly linked list).<br>
+ * Sum and count are updated in O(1) per record; minimum and maximum are kept <br>
+ * by monotonic deques (amortized O(1) per record).<br>
+ *
+ * @param tableName		String indicating the table name
+ * @param columnName	String indicating the column name
+ * @param selectSQL		SELECT statement reading the records inserted after a rowid
+ * @param lastRowid		Rowid of the last record added to the aggregate
+ * @param window		Values of all records in the window (in rowid order)
+ * @param minimum		Monotonic deque (increasing values) giving the minimum
+ * @param maximum		Monotonic deque (decreasing values) giving the maximum
+ * @param sum			Sum of the values in the window
+ * @param next			Next aggregate or NULL
+ */
+#ifndef M2MCEPAggregate
+typedef struct M2MCEPAggregate
+	{
+	M2MString *tableName;
+	M2MString *columnName;
+	M2MString *selectSQL;
+	int64_t lastRowid;
+	M2MCEPAggregateDeque window;
+	M2MCEPAggregateDeque minimum;
+	M2MCEPAggregateDeque maximum;
+	long double sum;
+	struct M2MCEPAggregate *next;
+	} M2MCEPAggregate;
+#endif /* M2MCEPAggregate */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Add the value of the record inserted into the window.<br>
+ * Records must be added in rowid order.<br>
+ *
+ * @param[in,out] self	Aggregate object
+ * @param[in] rowid		Rowid of the record
+ * @param[in] value		Value of the aggregated column
+ * @return				Aggregate object or NULL (in case of error)
+ */
+M2MCEPAggregate *M2MCEPAggregate_add (M2MCEPAggregate *self, const int64_t rowid, const double value);
+
+
+/**
+ * Release the heap memory of the aggregate object.<br>
+ *
+ * @param[in,out] self	Aggregate object to be freed of memory area
+ */
+void M2MCEPAggregate_delete (M2MCEPAggregate **self);
+
+
+/**
+ * Remove the values of the records below the rowid watermark (the records <br>
+ * evicted from the window).<br>
+ *
+ * @param[in,out] self		Aggregate object
+ * @param[in] watermark		Rowid of the oldest record remaining in the window
+ * @return					Number of removed values
+ */
+size_t M2MCEPAggregate_evict (M2MCEPAggregate *self, const int64_t watermark);
+
+
+/**
+ * Returns the kind of aggregate value indicated by the string ("sum", <br>
+ * "count", "avg", "min" or "max", case insensitive).<br>
+ *
+ * @param[in] string	String indicating the kind of aggregate value
+ * @param[out] type		Buffer to store the kind of aggregate value
+ * @return				true: known kind, false: unknown kind
+ */
+bool M2MCEPAggregate_getType (const M2MString *string, M2MCEPAggregateType *type);
+
+
+/**
+ * Returns the aggregate value in O(1).<br>
+ * The sum and the count of an empty window are 0; the average, the minimum <br>
+ * and the maximum of an empty window are NAN.<br>
+ *
+ * @param[in] self	Aggregate object
+ * @param[in] type	Kind of aggregate value
+ * @return			Aggregate value or NAN (in case of error or empty window)
+ */
+double M2MCEPAggregate_getValue (const M2MCEPAggregate *self, const M2MCEPAggregateType type);
+
+
+/**
+ * Create a new aggregate object of the column of the table.<br>
+ *
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @return					Created aggregate object or NULL (in case of error)
+ */
+M2MCEPAggregate *M2MCEPAggregate_new (const M2MString *tableName, const M2MString *columnName);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPAGGREGATE_H_ */
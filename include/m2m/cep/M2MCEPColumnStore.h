@@ -0,0 +1,320 @@
+/*******************************************************************************
+ * M2MCEPColumnStore.h : Compressed columnar store of CEP history
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPCOLUMNSTORE_H_
+#define M2M_CEP_M2MCEPCOLUMNSTORE_H_
+
+
+
+#include "m2m/cep/M2MCEPValue.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include "m2m/lib/security/M2MCRC32.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Extension of the column store files.<br>
+ */
+#ifndef M2MCEPColumnStore_FILE_EXTENSION
+#define M2MCEPColumnStore_FILE_EXTENSION (M2MString *)".column"
+#endif /* M2MCEPColumnStore_FILE_EXTENSION */
+
+
+/**
+ * Magic number at the head of the column store file ("M2MCOLS1").<br>
+ */
+#ifndef M2MCEPColumnStore_FILE_MAGIC
+#define M2MCEPColumnStore_FILE_MAGIC (M2MString *)"M2MCOLS1"
+#endif /* M2MCEPColumnStore_FILE_MAGIC */
+
+
+/**
+ * Magic number at the head of every block ("M2MB" in little endian).<br>
+ */
+#ifndef M2MCEPColumnStore_BLOCK_MAGIC
+#define M2MCEPColumnStore_BLOCK_MAGIC (uint32_t)0x424D324D
+#endif /* M2MCEPColumnStore_BLOCK_MAGIC */
+
+
+/**
+ * Size of the header of one block <br>
+ * (magic(u32) | length(u32) | CRC-32(u32) | records(u32) | min time(i64) | max time(i64))[Byte].<br>
+ */
+#ifndef M2MCEPColumnStore_BLOCK_HEADER_LENGTH
+#define M2MCEPColumnStore_BLOCK_HEADER_LENGTH (size_t)32
+#endif /* M2MCEPColumnStore_BLOCK_HEADER_LENGTH */
+
+
+/**
+ * Callback receiving one record of M2MCEPColumnStore_scan().<br>
+ * The strings and binary data are valid only during the call.<br>
+ *
+ * @param row				Array of the values of the scanned columns
+ * @param numberOfColumn	Number of the values
+ * @param userData			Pointer passed to M2MCEPColumnStore_scan()
+ * @return					true: continue the scan, false: stop the scan
+ */
+#ifndef M2MCEPColumnStoreCallback
+typedef bool (*M2MCEPColumnStoreCallback) (const M2MCEPValue *row, const unsigned int numberOfColumn, void *userData);
+#endif /* M2MCEPColumnStoreCallback */
+
+
+/**
+ * Entry of the block index (kept in memory, rebuilt from the block headers <br>
+ * when the file is opened).<br>
+ *
+ * @param offset			Position of the block header in the file[Byte]
+ * @param length			Size of the block following the header[Byte]
+ * @param numberOfRecord	Number of records in the block
+ * @param minTime			Minimum value of the time column in the block
+ * @param maxTime			Maximum value of the time column in the block
+ * @param next				Next block in the file
+ */
+#ifndef M2MCEPColumnBlock
+typedef struct M2MCEPColumnBlock
+	{
+	off_t offset;
+	uint32_t length;
+	uint32_t numberOfRecord;
+	int64_t minTime;
+	int64_t maxTime;
+	struct M2MCEPColumnBlock *next;
+	} M2MCEPColumnBlock;
+#endif /* M2MCEPColumnBlock */
+
+
+/**
+ * Growable bit stream encoding one block (bits are written from the most <br>
+ * significant bit of every byte).<br>
+ *
+ * @param data		Encoded bytes
+ * @param capacity	Allocated size of "data"[Byte]
+ * @param length	Number of used bytes (the last one can be partially used)[Byte]
+ * @param bit		Number of used bits in the last byte (0: the last byte is full)
+ */
+#ifndef M2MCEPColumnBuffer
+typedef struct
+	{
+	unsigned char *data;
+	size_t capacity;
+	size_t length;
+	unsigned int bit;
+	} M2MCEPColumnBuffer;
+#endif /* M2MCEPColumnBuffer */
+
+
+/**
+ * Append-only file storing the history of one table by column, in blocks <br>
+ * of "blockRecord" records compressed like Gorilla (the in-memory time <br>
+ * series database of Facebook):<br>
+ * <br>
+ * file: "M2MCOLS1" | columns(u32) | time column(u32) | columns x (type(u8) | name length(u32) | name) | blocks<br>
+ * block: magic(u32) | length(u32) | CRC-32 of body(u32) | records(u32) | min time(i64) | max time(i64) | columns x chunk<br>
+ * chunk: length(u32) | bit stream(null flag(1) [| null bitmap] | non-null values)<br>
+ * <br>
+ * INTEGER columns are encoded with delta-of-delta in variable bit lengths <br>
+ * (1 bit for a regular interval), REAL columns with the XOR of the previous <br>
+ * value (1 bit for an unchanged value, the meaningful bits otherwise) and <br>
+ * TEXT/BLOB columns with a dictionary per block and fixed width codes.<br>
+ * The minimum and maximum of the integer time column are kept per block in <br>
+ * the block index, so that a scan by time range reads only the overlapping <br>
+ * blocks and decodes only the requested columns.<br>
+ * Records are kept in memory until a block is full (or <br>
+ * M2MCEPColumnStore_flush() is called) and every block is written with one <br>
+ * write() call and fsync().<br>
+ *
+ * @param tableName			String indicating the table name
+ * @param filePath			Pathname of the column store file
+ * @param fileDescriptor	File descriptor of the column store file
+ * @param fileLength		Size of the valid part of the file[Byte]
+ * @param numberOfColumn	Number of columns
+ * @param columnName		Array of the column names
+ * @param columnType		Array of the column types (INTEGER, REAL, TEXT or BLOB)
+ * @param timeColumn		Index of the INTEGER column indicating the time of records
+ * @param blockRecord		Number of records of one block
+ * @param record			Records waiting for the next block ("blockRecord" x "numberOfColumn" values owning their strings)
+ * @param numberOfRecord	Number of records waiting for the next block
+ * @param block				First entry of the block index
+ * @param lastBlock			Last entry of the block index
+ * @param buffer			Bit stream encoding and decoding blocks
+ * @param next				Column store of the next table
+ */
+#ifndef M2MCEPColumnStore
+typedef struct M2MCEPColumnStore
+	{
+	M2MString *tableName;
+	M2MString *filePath;
+	int fileDescriptor;
+	off_t fileLength;
+	unsigned int numberOfColumn;
+	M2MString **columnName;
+	M2MCEPValueType *columnType;
+	unsigned int timeColumn;
+	unsigned int blockRecord;
+	M2MCEPValue *record;
+	unsigned int numberOfRecord;
+	M2MCEPColumnBlock *block;
+	M2MCEPColumnBlock *lastBlock;
+	M2MCEPColumnBuffer buffer;
+	struct M2MCEPColumnStore *next;
+	} M2MCEPColumnStore;
+#endif /* M2MCEPColumnStore */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append one record to the column store (values are converted into the <br>
+ * types of the columns and copied). When "blockRecord" records are waiting, <br>
+ * they are written into the file as one block.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @param[in] record	Array of "numberOfColumn" values in the order of the columns
+ * @return				Column store object or NULL (in case of error)
+ */
+M2MCEPColumnStore *M2MCEPColumnStore_append (M2MCEPColumnStore *self, const M2MCEPValue *record);
+
+
+/**
+ * Write the waiting records, close the file and release the heap memory of <br>
+ * the column store object (the file is kept).<br>
+ *
+ * @param[in,out] self	Column store object
+ */
+void M2MCEPColumnStore_delete (M2MCEPColumnStore **self);
+
+
+/**
+ * Write the records waiting for the next block into the file as a (smaller) <br>
+ * block.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @return				Column store object or NULL (in case of error)
+ */
+M2MCEPColumnStore *M2MCEPColumnStore_flush (M2MCEPColumnStore *self);
+
+
+/**
+ * Returns the number of blocks written into the file.<br>
+ *
+ * @param[in] self	Column store object
+ * @return			Number of blocks
+ */
+unsigned int M2MCEPColumnStore_getBlockCount (const M2MCEPColumnStore *self);
+
+
+/**
+ * Returns the index of the column.<br>
+ *
+ * @param[in] self			Column store object
+ * @param[in] columnName	String indicating the column name
+ * @return					Index of the column or -1 (in case of unknown column)
+ */
+int M2MCEPColumnStore_getColumnIndex (const M2MCEPColumnStore *self, const M2MString *columnName);
+
+
+/**
+ * Returns the size of the column store file.<br>
+ *
+ * @param[in] self	Column store object
+ * @return			Size of the file[Byte]
+ */
+uint64_t M2MCEPColumnStore_getFileLength (const M2MCEPColumnStore *self);
+
+
+/**
+ * Open the column store file of the table (created if it doesn't exist).<br>
+ * The columns of an existing file must match the indicated columns. A block <br>
+ * broken by a crash at the end of the file is cut off.<br>
+ *
+ * @param[in] filePath			Pathname of the column store file
+ * @param[in] tableName			String indicating the table name
+ * @param[in] columnName		Array of the column names
+ * @param[in] columnType		Array of the column types (INTEGER, REAL, TEXT or BLOB)
+ * @param[in] numberOfColumn	Number of columns
+ * @param[in] timeColumn		Index of the INTEGER column indicating the time of records
+ * @param[in] blockRecord		Number of records of one block (>0)
+ * @return						Created column store object or NULL (in case of error)
+ */
+M2MCEPColumnStore *M2MCEPColumnStore_new (const M2MString *filePath, const M2MString *tableName, M2MString *const *columnName, const M2MCEPValueType *columnType, const unsigned int numberOfColumn, const unsigned int timeColumn, const unsigned int blockRecord);
+
+
+/**
+ * Give the records whose time is within the range to the callback in the <br>
+ * order of insertion (the records waiting for the next block included).<br>
+ * Only the blocks overlapping the range are read and only the indicated <br>
+ * columns are decoded (the chunks of the others are skipped).<br>
+ *
+ * @param[in,out] self			Column store object
+ * @param[in] from				Start of the time range
+ * @param[in] to				End of the time range (inclusive)
+ * @param[in] columnIndex		Array of the indexes of the columns given to the callback
+ * @param[in] numberOfIndex		Number of the indexes
+ * @param[in] callback			Callback receiving the records
+ * @param[in] userData			Pointer passed to the callback
+ * @return						Number of records given to the callback or -1 (in case of error)
+ */
+int M2MCEPColumnStore_scan (M2MCEPColumnStore *self, const int64_t from, const int64_t to, const unsigned int *columnIndex, const unsigned int numberOfIndex, const M2MCEPColumnStoreCallback callback, void *userData);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPCOLUMNSTORE_H_ */
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * M2MCEPLog.h : Segmented write-ahead log of records inserted into CEP
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPLOG_H_
+#define M2M_CEP_M2MCEPLOG_H_
+
+
+
+#include "m2m/cep/M2MCEPValue.h"
+#include "m2m/lib/db/M2MSQLite.h"
+#include "m2m/lib/io/M2MDirectory.h"
+#include "m2m/lib/io/M2MFile.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include "m2m/lib/security/M2MCRC32.h"
+#include "m2m/lib/util/list/M2MList.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Extension of the segment files of the log.<br>
+ */
+#ifndef M2MCEPLog_FILE_EXTENSION
+#define M2MCEPLog_FILE_EXTENSION (M2MString *)".log"
+#endif /* M2MCEPLog_FILE_EXTENSION */
+
+
+/**
+ * Size of the header of one entry (length(u32) | CRC-32(u32))[Byte].<br>
+ */
+#ifndef M2MCEPLog_HEADER_LENGTH
+#define M2MCEPLog_HEADER_LENGTH (size_t)8
+#endif /* M2MCEPLog_HEADER_LENGTH */
+
+
+/**
+ * Handler receiving one entry of the log replayed by M2MCEPLog_replay().<br>
+ * Either "csv" (entry of M2MCEPLog_appendCSV()) or "values" (entry of <br>
+ * M2MCEPLog_appendRecords()) is set. The strings and binary data are valid <br>
+ * only during the call.<br>
+ *
+ * @param tableName		String indicating the table name
+ * @param sequence		Sequence number of the first record of the entry in the table
+ * @param csv			String in CSV format or NULL
+ * @param values		Array of typed values of "rows" * "columns" in row-major order or NULL
+ * @param rows			Number of records of "values"
+ * @param columns		Number of values per record of "values"
+ * @param userData		Pointer passed to M2MCEPLog_replay()
+ */
+#ifndef M2MCEPLogHandler
+typedef void (*M2MCEPLogHandler) (const M2MString *tableName, const int64_t sequence, const M2MString *csv, const M2MCEPValue *values, const size_t rows, const size_t columns, void *userData);
+#endif /* M2MCEPLogHandler */
+
+
+/**
+ * Append-only log of the inserted records divided into segment files <br>
+ * ("directoryPath/%010u.log", numbered in ascending order).<br>
+ * Each entry is protected by its length and CRC-32 (little endian):<br>
+ * <br>
+ * length(u32) | CRC-32 of payload(u32) | payload<br>
+ * payload: 'C' | table name | '\0' | sequence(i64) | CSV | '\0'<br>
+ *          'R' | table name | '\0' | sequence(i64) | rows(u32) | columns(u32) | <br>
+ *          rows x columns x (type(u8) | i64, f64 or length(u32) + bytes)<br>
+ * <br>
+ * Entries are written with one write() call (they survive a crash of the <br>
+ * process) and synchronized with fsync() every "syncRecord" entries (the <br>
+ * entries written since the last fsync() can be lost by a crash of the OS).<br>
+ * A new segment file is started when the current one exceeds "segmentSize".<br>
+ *
+ * @param directoryPath		Directory of the segment files
+ * @param file				Current segment file (NULL until the first entry is appended)
+ * @param firstSegment		Number of the oldest segment file
+ * @param segment			Number of the current segment file
+ * @param segmentSize		Size of one segment file[Byte]
+ * @param segmentLength		Size written into the current segment file[Byte]
+ * @param syncRecord		Number of entries between two fsync() (0: at rotation only)
+ * @param unsyncedRecord	Number of entries written since the last fsync()
+ * @param buffer			Buffer encoding one entry
+ * @param bufferCapacity	Allocated size of the buffer[Byte]
+ */
+#ifndef M2MCEPLog
+typedef struct
+	{
+	M2MString *directoryPath;
+	M2MFile *file;
+	uint32_t firstSegment;
+	uint32_t segment;
+	size_t segmentSize;
+	size_t segmentLength;
+	unsigned int syncRecord;
+	unsigned int unsyncedRecord;
+	unsigned char *buffer;
+	size_t bufferCapacity;
+	} M2MCEPLog;
+#endif /* M2MCEPLog */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append the CSV format string inserted into the table to the current <br>
+ * segment file.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] sequence	Sequence number of the first record in the table
+ * @param[in] csv		String in CSV format (the first line specifies the column name as a header)
+ * @return				Size of the written entry[Byte] or 0 (in case of error)
+ */
+size_t M2MCEPLog_appendCSV (M2MCEPLog *self, const M2MString *tableName, const int64_t sequence, const M2MString *csv);
+
+
+/**
+ * Append the typed values of the records inserted into the table to the <br>
+ * current segment file.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] sequence	Sequence number of the first record in the table
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order
+ * @param[in] rows		Number of records
+ * @param[in] columns	Number of values per record
+ * @return				Size of the written entry[Byte] or 0 (in case of error)
+ */
+size_t M2MCEPLog_appendRecords (M2MCEPLog *self, const M2MString *tableName, const int64_t sequence, const M2MCEPValue *values, const size_t rows, const size_t columns);
+
+
+/**
+ * Synchronize and close the current segment file and release the heap memory <br>
+ * of the log object (the segment files are kept).<br>
+ *
+ * @param[in,out] self	Log object
+ */
+void M2MCEPLog_delete (M2MCEPLog **self);
+
+
+/**
+ * Returns the number of the oldest segment file.<br>
+ *
+ * @param[in] self	Log object
+ * @return			Number of the oldest segment file (equal to the current one if no older file exists)
+ */
+uint32_t M2MCEPLog_getFirstSegment (const M2MCEPLog *self);
+
+
+/**
+ * Returns the number of the current segment file (the file entries are <br>
+ * appended to).<br>
+ *
+ * @param[in] self	Log object
+ * @return			Number of the current segment file or 0 (in case of error)
+ */
+uint32_t M2MCEPLog_getSegment (const M2MCEPLog *self);
+
+
+/**
+ * Returns the size written into the current segment file.<br>
+ *
+ * @param[in] self	Log object
+ * @return			Size written into the current segment file[Byte]
+ */
+size_t M2MCEPLog_getSegmentLength (const M2MCEPLog *self);
+
+
+/**
+ * Returns whether the current segment file reached the segment size.<br>
+ *
+ * @param[in] self	Log object
+ * @return			true: the log should be rotated, false: not yet
+ */
+bool M2MCEPLog_isFull (const M2MCEPLog *self);
+
+
+/**
+ * Create a new log object on the directory.<br>
+ * Existing segment files are kept for M2MCEPLog_replay() and the entries are <br>
+ * appended to a new segment file following the last one.<br>
+ *
+ * @param[in] directoryPath	Directory of the segment files (created if it doesn't exist)
+ * @param[in] segmentSize	Size of one segment file[Byte] (>0)
+ * @param[in] syncRecord	Number of entries between two fsync() (1: every entry, 0: at rotation only)
+ * @return					Created log object or NULL (in case of error)
+ */
+M2MCEPLog *M2MCEPLog_new (const M2MString *directoryPath, const size_t segmentSize, const unsigned int syncRecord);
+
+
+/**
+ * Remove the segment files older than the indicated number (the current <br>
+ * segment file is never removed).<br>
+ * If no entry was appended to the current segment file yet, the following <br>
+ * entries are appended to the indicated segment at least.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] segment	Number of the oldest segment file to be kept
+ * @return				Number of removed segment files or -1 (in case of error)
+ */
+int M2MCEPLog_remove (M2MCEPLog *self, const uint32_t segment);
+
+
+/**
+ * Read the entries of the segment file and give them to the handler in order.<br>
+ * Reading stops at the first entry which is truncated or doesn't match its <br>
+ * CRC-32 (torn write by a crash).<br>
+ *
+ * @param[in] self		Log object
+ * @param[in] segment	Number of the segment file (older than the current one)
+ * @param[in] handler	Handler receiving the entries
+ * @param[in] userData	Pointer passed to the handler
+ * @return				Number of replayed entries or -1 (in case of error)
+ */
+int M2MCEPLog_replay (const M2MCEPLog *self, const uint32_t segment, const M2MCEPLogHandler handler, void *userData);
+
+
+/**
+ * Synchronize and close the current segment file; the following entries are <br>
+ * appended to the next segment file.<br>
+ * Nothing is done if no entry was appended to the current segment file.<br>
+ *
+ * @param[in,out] self	Log object
+ * @return				Log object or NULL (in case of error)
+ */
+M2MCEPLog *M2MCEPLog_rotate (M2MCEPLog *self);
+
+
+/**
+ * Synchronize the entries written into the current segment file with the <br>
+ * storage device (fsync()).<br>
+ *
+ * @param[in,out] self	Log object
+ * @return				Log object or NULL (in case of error)
+ */
+M2MCEPLog *M2MCEPLog_sync (M2MCEPLog *self);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPLOG_H_ */
@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * M2MCEPPartition.h : Time-partitioned SQLite3 database files of CEP history
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPPARTITION_H_
+#define M2M_CEP_M2MCEPPARTITION_H_
+
+
+
+#include "m2m/lib/db/M2MSQLite.h"
+#include "m2m/lib/io/M2MDirectory.h"
+#include "m2m/lib/io/M2MFile.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include "m2m/lib/util/list/M2MList.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Extension of the partition files.<br>
+ */
+#ifndef M2MCEPPartition_FILE_EXTENSION
+#define M2MCEPPartition_FILE_EXTENSION (M2MString *)".sqlite"
+#endif /* M2MCEPPartition_FILE_EXTENSION */
+
+
+/**
+ * Format of the start time (UTC) in the name of the partition files.<br>
+ */
+#ifndef M2MCEPPartition_TIME_FORMAT
+#define M2MCEPPartition_TIME_FORMAT (M2MString *)"%Y%m%d%H%M%S"
+#endif /* M2MCEPPartition_TIME_FORMAT */
+
+
+/**
+ * Interval of hourly partitions[sec].<br>
+ */
+#ifndef M2MCEPPartition_HOUR
+#define M2MCEPPartition_HOUR (unsigned int)3600
+#endif /* M2MCEPPartition_HOUR */
+
+
+/**
+ * Interval of daily partitions[sec].<br>
+ */
+#ifndef M2MCEPPartition_DAY
+#define M2MCEPPartition_DAY (unsigned int)86400
+#endif /* M2MCEPPartition_DAY */
+
+
+/**
+ * SQLite3 database files dividing the history of records by time <br>
+ * ("directoryPath/YYYYMMDDhhmmss.sqlite", named after the start time in UTC).<br>
+ * The records are written into the partition including the current time; <br>
+ * the partitions are aligned on multiples of "interval" from the epoch (e.g. <br>
+ * hourly partitions start at every hour, daily partitions at 00:00 UTC).<br>
+ * The retention drops whole files instead of deleting records, so that the <br>
+ * disk usage stays bounded without vacuum.<br>
+ *
+ * @param directoryPath		Directory of the partition files
+ * @param interval			Time range of one partition[sec]
+ * @param retention			Number of partitions kept including the current one (0: all)
+ * @param startTime			Start time of the current partition[sec] (0: not opened yet)
+ */
+#ifndef M2MCEPPartition
+typedef struct
+	{
+	M2MString *directoryPath;
+	unsigned int interval;
+	unsigned int retention;
+	time_t startTime;
+	} M2MCEPPartition;
+#endif /* M2MCEPPartition */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Create the pathname string of the partition file starting at the time.<br>
+ * Caller must release the string with M2MHeap_free().<br>
+ *
+ * @param[in] self			Partition object
+ * @param[in] startTime		Start time of the partition[sec]
+ * @param[out] filePath		Buffer to store the created pathname string
+ * @return					Pathname string of the partition file or NULL (in case of error)
+ */
+M2MString *M2MCEPPartition_createFilePath (const M2MCEPPartition *self, const time_t startTime, M2MString **filePath);
+
+
+/**
+ * Release the heap memory of the partition object (the partition files are <br>
+ * kept).<br>
+ *
+ * @param[in,out] self	Partition object
+ */
+void M2MCEPPartition_delete (M2MCEPPartition **self);
+
+
+/**
+ * Returns the start time of the partition including the time.<br>
+ *
+ * @param[in] self	Partition object
+ * @param[in] time	Time[sec]
+ * @return			Start time of the partition[sec] or 0 (in case of error)
+ */
+time_t M2MCEPPartition_getStartTime (const M2MCEPPartition *self, const time_t time);
+
+
+/**
+ * Check whether the time is out of the current partition (a new partition <br>
+ * must be opened).<br>
+ *
+ * @param[in] self	Partition object
+ * @param[in] time	Time[sec]
+ * @return			true: the time is out of the current partition (or no partition is opened), false: the time is included
+ */
+bool M2MCEPPartition_isExpired (const M2MCEPPartition *self, const time_t time);
+
+
+/**
+ * Get the start times of the existing partitions overlapping the time range <br>
+ * in ascending order.<br>
+ * Caller must release the array with M2MHeap_free().<br>
+ *
+ * @param[in] self				Partition object
+ * @param[in] from				Start of the time range[sec]
+ * @param[in] to				End of the time range (inclusive)[sec]
+ * @param[out] startTimeArray	Buffer to store the array of start times (NULL if no partition overlaps)
+ * @return						Number of overlapping partitions or -1 (in case of error)
+ */
+int M2MCEPPartition_list (const M2MCEPPartition *self, const time_t from, const time_t to, time_t **startTimeArray);
+
+
+/**
+ * Create a new partition object on the directory.<br>
+ *
+ * @param[in] directoryPath	Directory of the partition files (created if it doesn't exist)
+ * @param[in] interval		Time range of one partition[sec] (>0, e.g. M2MCEPPartition_HOUR)
+ * @param[in] retention		Number of partitions kept including the current one (0: all)
+ * @return					Created partition object or NULL (in case of error)
+ */
+M2MCEPPartition *M2MCEPPartition_new (const M2MString *directoryPath, const unsigned int interval, const unsigned int retention);
+
+
+/**
+ * Make the partition including the time current and remove the partitions <br>
+ * beyond the retention.<br>
+ * Caller must release the pathname string with M2MHeap_free().<br>
+ *
+ * @param[in,out] self		Partition object
+ * @param[in] time			Time[sec]
+ * @param[out] filePath		Buffer to store the pathname string of the current partition file
+ * @return					Pathname string of the current partition file or NULL (in case of error)
+ */
+M2MString *M2MCEPPartition_open (M2MCEPPartition *self, const time_t time, M2MString **filePath);
+
+
+/**
+ * Remove the partition files older than the retention (counted back from <br>
+ * the current partition).<br>
+ *
+ * @param[in] self	Partition object
+ * @return			Number of removed partition files or -1 (in case of error)
+ */
+int M2MCEPPartition_remove (const M2MCEPPartition *self);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPPARTITION_H_ */
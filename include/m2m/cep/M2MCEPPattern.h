@@ -0,0 +1,328 @@
+/*******************************************************************************
+ * M2MCEPPattern.h : Event pattern compiled into a NFA over ingested records
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPPATTERN_H_
+#define M2M_CEP_M2MCEPPATTERN_H_
+
+
+
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include "m2m/lib/security/M2MCRC32.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sqlite3.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Default maximum number of partitions (keys) holding partial matches.<br>
+ */
+#ifndef M2MCEPPattern_DEFAULT_MAX_PARTITION
+#define M2MCEPPattern_DEFAULT_MAX_PARTITION (unsigned int)1024
+#endif /* M2MCEPPattern_DEFAULT_MAX_PARTITION */
+
+
+/**
+ * Default maximum number of partial matches per partition.<br>
+ */
+#ifndef M2MCEPPattern_DEFAULT_MAX_RUN
+#define M2MCEPPattern_DEFAULT_MAX_RUN (unsigned int)16
+#endif /* M2MCEPPattern_DEFAULT_MAX_RUN */
+
+
+/**
+ * Record matched by a step of the pattern.<br>
+ *
+ * @param tableName	String indicating the table name of the record
+ * @param rowid		Rowid of the record in SQLite3 database in memory
+ * @param time		Event time of the record (0 in case of no event time column)
+ */
+#ifndef M2MCEPPatternEvent
+typedef struct
+	{
+	const M2MString *tableName;
+	int64_t rowid;
+	int64_t time;
+	} M2MCEPPatternEvent;
+#endif /* M2MCEPPatternEvent */
+
+
+/**
+ * Callback receiving one match of a registered pattern.<br>
+ * The records are passed in the order of the steps (negated steps are not <br>
+ * included) and are valid only during the call.<br>
+ *
+ * @param patternID			ID of the pattern returned by M2MCEP_registerPattern()
+ * @param key				String indicating the value of the key column ("" in case of no key column)
+ * @param event				Records matched by the steps
+ * @param numberOfEvent		Number of records
+ * @param userData			Pointer set with M2MCEP_registerPattern()
+ */
+#ifndef M2MCEPPatternCallback
+typedef void (*M2MCEPPatternCallback) (const unsigned int patternID, const M2MString *key, const M2MCEPPatternEvent *event, const unsigned int numberOfEvent, void *userData);
+#endif /* M2MCEPPatternCallback */
+
+
+/**
+ * Step of the pattern (a node of a singly linked list).<br>
+ * A positive step moves the partial matches from the state "number of <br>
+ * positive steps before it" to the next state; a negated step discards the <br>
+ * partial matches waiting in that state.<br>
+ *
+ * @param tableName		String indicating the table name
+ * @param condition		String indicating the condition of the record (SQL expression)
+ * @param negation		Flag indicating the step must not occur
+ * @param state			State of the NFA the step applies to
+ * @param tableIndex	Index of the table (parameter number of the rowid - 1)
+ * @param next			Next step or NULL
+ */
+#ifndef M2MCEPPatternStep
+typedef struct M2MCEPPatternStep
+	{
+	M2MString *tableName;
+	M2MString *condition;
+	bool negation;
+	unsigned int state;
+	unsigned int tableIndex;
+	struct M2MCEPPatternStep *next;
+	} M2MCEPPatternStep;
+#endif /* M2MCEPPatternStep */
+
+
+/**
+ * Table read by the pattern (a node of a singly linked list).<br>
+ *
+ * @param tableName		String indicating the table name
+ * @param lastRowid		Rowid of the last record of the table given to the pattern
+ * @param next			Next table or NULL
+ */
+#ifndef M2MCEPPatternTable
+typedef struct M2MCEPPatternTable
+	{
+	M2MString *tableName;
+	int64_t lastRowid;
+	struct M2MCEPPatternTable *next;
+	} M2MCEPPatternTable;
+#endif /* M2MCEPPatternTable */
+
+
+/**
+ * Partial matches of one key (node of bidirectional list).<br>
+ * The list is kept in the order of use, the head is the most recently used.<br>
+ * The partial matches are kept from the oldest, each one holds the records <br>
+ * of "numberOfState - 1" positive steps.<br>
+ *
+ * @param previous		Partition located before (NULL in the case of the head)
+ * @param next			Partition located behind (NULL in the case of the end)
+ * @param hash			CRC-32 value of the key string
+ * @param key			String indicating the value of the key column
+ * @param state			States of the partial matches
+ * @param event			Records of the partial matches (maxRun * number of positive steps)
+ * @param numberOfRun	Number of partial matches
+ */
+#ifndef M2MCEPPatternPartition
+typedef struct M2MCEPPatternPartition
+	{
+	struct M2MCEPPatternPartition *previous;
+	struct M2MCEPPatternPartition *next;
+	uint32_t hash;
+	M2MString *key;
+	unsigned int *state;
+	M2MCEPPatternEvent *event;
+	unsigned int numberOfRun;
+	} M2MCEPPatternPartition;
+#endif /* M2MCEPPatternPartition */
+
+
+/**
+ * Event pattern: a sequence of conditions on records of the same key which <br>
+ * occur in the order of event time within the duration (a node of a singly <br>
+ * linked list of the CEP object).<br>
+ * The pattern is compiled into a NFA whose state is the number of matched <br>
+ * positive steps and is evaluated incrementally with the inserted records. <br>
+ * Every record matching the first step starts a partial match, and every <br>
+ * partial match advances with the next record matching its waiting step <br>
+ * (skip till next match).<br>
+ * The state is bounded by the number of partitions (least recently used key <br>
+ * is discarded) and by the number of partial matches per partition (oldest <br>
+ * partial match is discarded).<br>
+ *
+ * @param patternID			ID of the pattern
+ * @param keyColumnName		String indicating the column partitioning the records (NULL: no partition)
+ * @param timeColumnName	String indicating the column of event time (NULL: order of insertion)
+ * @param duration			Maximum duration from the first to the last record of a match (0: not limited)
+ * @param step				Steps of the pattern
+ * @param table				Tables read by the pattern
+ * @param numberOfState		Number of states of the NFA (number of positive steps + 1)
+ * @param selectSQL			SELECT statement reading the new records matching any step
+ * @param statement			Prepared statement of "selectSQL" (on SQLite3 database in memory)
+ * @param head				Most recently used partition
+ * @param tail				Least recently used partition
+ * @param numberOfPartition	Number of partitions
+ * @param maxPartition		Maximum number of partitions
+ * @param maxRun			Maximum number of partial matches per partition
+ * @param callback			Callback receiving the matches
+ * @param userData			Pointer passed to the callback
+ * @param next				Next pattern or NULL
+ */
+#ifndef M2MCEPPattern
+typedef struct M2MCEPPattern
+	{
+	unsigned int patternID;
+	M2MString *keyColumnName;
+	M2MString *timeColumnName;
+	int64_t duration;
+	M2MCEPPatternStep *step;
+	M2MCEPPatternTable *table;
+	unsigned int numberOfState;
+	M2MString *selectSQL;
+	sqlite3_stmt *statement;
+	M2MCEPPatternPartition *head;
+	M2MCEPPatternPartition *tail;
+	unsigned int numberOfPartition;
+	unsigned int maxPartition;
+	unsigned int maxRun;
+	M2MCEPPatternCallback callback;
+	void *userData;
+	struct M2MCEPPattern *next;
+	} M2MCEPPattern;
+#endif /* M2MCEPPattern */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Build the SELECT statement reading the new records of the tables matching <br>
+ * any step (in the order of event time) and fix the states of the steps.<br>
+ * The columns of the result are the index of the step, the key, the event <br>
+ * time and the rowid; the parameter "?N" is the last rowid of the N-th <br>
+ * table.<br>
+ * A pattern must start and end with a positive step.<br>
+ *
+ * @param[in,out] self	Pattern object
+ * @return				Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_compile (M2MCEPPattern *self);
+
+
+/**
+ * Release the heap memory of the pattern object (and finalize its prepared <br>
+ * statement).<br>
+ *
+ * @param[in,out] self	Pattern object to be freed of memory area
+ */
+void M2MCEPPattern_delete (M2MCEPPattern **self);
+
+
+/**
+ * Append the step which must occur after the previous steps.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] condition		String indicating the condition of the record (SQL expression) or NULL (any record)
+ * @return					Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_followedBy (M2MCEPPattern *self, const M2MString *tableName, const M2MString *condition);
+
+
+/**
+ * Create a new event pattern without step.<br>
+ *
+ * @param[in] keyColumnName		String indicating the column partitioning the records or NULL (no partition)
+ * @param[in] timeColumnName	String indicating the column of event time (integer) or NULL (order of insertion)
+ * @param[in] duration			Maximum duration from the first to the last record of a match in the unit of the event time column (0: not limited)
+ * @return						Created pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_new (const M2MString *keyColumnName, const M2MString *timeColumnName, const int64_t duration);
+
+
+/**
+ * Append the step which must not occur between the previous and the next <br>
+ * positive steps.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] condition		String indicating the condition of the record (SQL expression) or NULL (any record)
+ * @return					Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_notFollowedBy (M2MCEPPattern *self, const M2MString *tableName, const M2MString *condition);
+
+
+/**
+ * Give one record read with the compiled SELECT statement to the NFA and <br>
+ * call the callback for each completed match.<br>
+ * Records must be given in the order of event time.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] stepIndex		Index of the step matched by the record
+ * @param[in] key			String indicating the value of the key column
+ * @param[in] rowid			Rowid of the record
+ * @param[in] time			Event time of the record
+ * @return					Number of completed matches
+ */
+unsigned int M2MCEPPattern_process (M2MCEPPattern *self, const unsigned int stepIndex, const M2MString *key, const int64_t rowid, const int64_t time);
+
+
+/**
+ * Set the upper limits of the state held by the pattern.<br>
+ *
+ * @param[in,out] self		Pattern object (without partial match)
+ * @param[in] maxPartition	Maximum number of partitions (>0)
+ * @param[in] maxRun		Maximum number of partial matches per partition (>0)
+ * @return					Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_setLimit (M2MCEPPattern *self, const unsigned int maxPartition, const unsigned int maxRun);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPPATTERN_H_ */
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * M2MCEPResultSet.h : Columnar result set of SELECT statement
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPRESULTSET_H_
+#define M2M_CEP_M2MCEPRESULTSET_H_
+
+
+
+#include "m2m/cep/M2MCEPValue.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sqlite3.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Magic number at the head of the serialized result set (="M2MR").<br>
+ */
+#ifndef M2MCEPResultSet_MAGIC
+#define M2MCEPResultSet_MAGIC (M2MString *)"M2MR"
+#endif /* M2MCEPResultSet_MAGIC */
+
+
+/**
+ * Version number of the serialized result set format.<br>
+ */
+#ifndef M2MCEPResultSet_VERSION
+#define M2MCEPResultSet_VERSION (uint32_t)1
+#endif /* M2MCEPResultSet_VERSION */
+
+
+/**
+ * One column of the result set.<br>
+ * The type of the column is decided by the first value which isn't NULL <br>
+ * (M2MCEPValueType_NULL while all values are NULL). An integer column is <br>
+ * promoted to a real column when a real value appears; values of other <br>
+ * storage classes are converted by SQLite into the type of the column.<br>
+ * Integer and real values are held in contiguous arrays (one element per <br>
+ * row, 0 for NULL). Text and binary values are held in the byte heap and <br>
+ * delimited by "offset" (row i occupies heap[offset[i]] ~ heap[offset[i+1]]); <br>
+ * text values are stored with the terminating '\0' so that they can be read <br>
+ * as C strings without copying.<br>
+ *
+ * @param name			Column name
+ * @param type			Type of the column
+ * @param value			Array of integers or reals (in case of numeric column)
+ * @param offset		Array of offsets into the heap (number of rows + 1 elements)
+ * @param heap			Byte heap of text or binary values
+ * @param heapLength	Used size of the heap[Byte]
+ * @param heapCapacity	Allocated size of the heap[Byte]
+ * @param nullBitmap	Bitmap of NULL values (bit (i % 8) of byte (i / 8) is set if row i is NULL)
+ */
+#ifndef M2MCEPResultColumn
+typedef struct
+	{
+	M2MString *name;
+	M2MCEPValueType type;
+	union
+		{
+		int64_t *integer;
+		double *real;
+		} value;
+	uint32_t *offset;
+	unsigned char *heap;
+	size_t heapLength;
+	size_t heapCapacity;
+	uint8_t *nullBitmap;
+	} M2MCEPResultColumn;
+#endif /* M2MCEPResultColumn */
+
+
+/**
+ * Columnar result set of SELECT statement.<br>
+ * The arrays of the columns can be read directly (zero-copy) by C callers <br>
+ * and the whole result set can be serialized into a compact binary buffer <br>
+ * (little endian) for inter process communication:<br>
+ * <br>
+ * "M2MR" | version(u32) | number of columns(u32) | number of rows(u64) | <br>
+ * columns: type(u32) | name length(u32) | name | NULL bitmap | <br>
+ *          rows x i64 or f64 (numeric) or (rows + 1) x u32 offsets + heap (text, binary)<br>
+ *
+ * @param column			Array of columns
+ * @param numberOfColumn	Number of columns
+ * @param numberOfRow		Number of rows
+ * @param rowCapacity		Number of rows the arrays of the columns can hold
+ */
+#ifndef M2MCEPResultSet
+typedef struct
+	{
+	M2MCEPResultColumn *column;
+	unsigned int numberOfColumn;
+	size_t numberOfRow;
+	size_t rowCapacity;
+	} M2MCEPResultSet;
+#endif /* M2MCEPResultSet */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append the current row of the SQLite3 prepared statement to the result <br>
+ * set (the values are copied).<br>
+ *
+ * @param[in,out] self		Result set object
+ * @param[in] statement		SQLite3 prepared statement object (after SQLITE_ROW)
+ * @return					Result set object or NULL (in case of error)
+ */
+M2MCEPResultSet *M2MCEPResultSet_addRow (M2MCEPResultSet *self, sqlite3_stmt *statement);
+
+
+/**
+ * Release the heap memory of the result set object.<br>
+ *
+ * @param[in,out] self	Result set object to be freed of memory area
+ */
+void M2MCEPResultSet_delete (M2MCEPResultSet **self);
+
+
+/**
+ * Returns the text or binary value of the row of the column (without copying).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @param[in] row		Index number of the row (>=0)
+ * @param[out] length	Buffer to store the size of the value[Byte] (without '\0' in case of text)
+ * @return				Pointer into the heap of the column or NULL (in case of NULL value, numeric column or error)
+ */
+const void *M2MCEPResultSet_getBytes (const M2MCEPResultSet *self, const unsigned int column, const size_t row, size_t *length);
+
+
+/**
+ * Returns the name of the column.<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Column name or NULL (in case of error)
+ */
+const M2MString *M2MCEPResultSet_getColumnName (const M2MCEPResultSet *self, const unsigned int column);
+
+
+/**
+ * Returns the type of the column.<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Type of the column (M2MCEPValueType_NULL in case of all NULL values or error)
+ */
+M2MCEPValueType M2MCEPResultSet_getColumnType (const M2MCEPResultSet *self, const unsigned int column);
+
+
+/**
+ * Returns the contiguous array of the integer column (without copying).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Array of number of rows integers or NULL (in case of other type or error)
+ */
+const int64_t *M2MCEPResultSet_getIntegerArray (const M2MCEPResultSet *self, const unsigned int column);
+
+
+/**
+ * Returns the number of columns of the result set.<br>
+ *
+ * @param[in] self	Result set object
+ * @return			Number of columns
+ */
+unsigned int M2MCEPResultSet_getNumberOfColumn (const M2MCEPResultSet *self);
+
+
+/**
+ * Returns the number of rows of the result set.<br>
+ *
+ * @param[in] self	Result set object
+ * @return			Number of rows
+ */
+size_t M2MCEPResultSet_getNumberOfRow (const M2MCEPResultSet *self);
+
+
+/**
+ * Returns the contiguous array of the real column (without copying).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Array of number of rows reals or NULL (in case of other type or error)
+ */
+const double *M2MCEPResultSet_getRealArray (const M2MCEPResultSet *self, const unsigned int column);
+
+
+/**
+ * Set the value of the row of the column into the typed value (text and <br>
+ * binary values point into the heap of the result set).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @param[in] row		Index number of the row (>=0)
+ * @param[out] value	Typed value
+ * @return				Typed value or NULL (in case of error)
+ */
+M2MCEPValue *M2MCEPResultSet_getValue (const M2MCEPResultSet *self, const unsigned int column, const size_t row, M2MCEPValue *value);
+
+
+/**
+ * Returns whether the value of the row of the column is NULL or not.<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @param[in] row		Index number of the row (>=0)
+ * @return				true: NULL (or error), false: not NULL
+ */
+bool M2MCEPResultSet_isNull (const M2MCEPResultSet *self, const unsigned int column, const size_t row);
+
+
+/**
+ * Create a new empty result set object having the columns of the SQLite3 <br>
+ * prepared statement.<br>
+ *
+ * @param[in] statement		SQLite3 prepared statement object
+ * @return					Created result set object or NULL (in case of error)
+ */
+M2MCEPResultSet *M2MCEPResultSet_new (sqlite3_stmt *statement);
+
+
+/**
+ * Create a new result set object from the binary buffer created by <br>
+ * M2MCEPResultSet_serialize().<br>
+ *
+ * @param[in] buffer	Serialized result set
+ * @param[in] length	Size of the buffer[Byte]
+ * @return				Created result set object or NULL (in case of broken buffer or error)
+ */
+M2MCEPResultSet *M2MCEPResultSet_parse (const unsigned char *buffer, const size_t length);
+
+
+/**
+ * Serialize the result set into a compact binary buffer (little endian).<br>
+ * Caller must release the buffer with M2MHeap_free().<br>
+ *
+ * @param[in] self		Result set object
+ * @param[out] buffer	Buffer to store the allocated binary data
+ * @return				Size of the binary data[Byte] or 0 (in case of error)
+ */
+size_t M2MCEPResultSet_serialize (const M2MCEPResultSet *self, unsigned char **buffer);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPRESULTSET_H_ */
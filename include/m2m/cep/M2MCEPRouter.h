@@ -0,0 +1,261 @@
+/*******************************************************************************
+ * M2MCEPRouter.h : Sharded CEP front-end routing tables and keys to shards
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPROUTER_H_
+#define M2M_CEP_M2MCEPROUTER_H_
+
+
+
+#include "m2m/cep/M2MCEP.h"
+#include "m2m/lib/db/M2MTableManager.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/lang/M2MStringBuilder.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include "m2m/lib/security/M2MCRC32.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Maximum number of shards of one router.<br>
+ */
+#ifndef M2MCEPRouter_MAX_SHARD
+#define M2MCEPRouter_MAX_SHARD (unsigned int)64
+#endif /* M2MCEPRouter_MAX_SHARD */
+
+
+/**
+ * Column whose value decides the shard of each record of the table (node <br>
+ * of unidirectional list).<br>
+ *
+ * @param next			Next shard key
+ * @param tableName		String indicating the table name
+ * @param columnName	String indicating the column name of the key
+ */
+#ifndef M2MCEPRouterKey
+typedef struct M2MCEPRouterKey
+	{
+	struct M2MCEPRouterKey *next;
+	M2MString *tableName;
+	M2MString *columnName;
+	} M2MCEPRouterKey;
+#endif /* M2MCEPRouterKey */
+
+
+/**
+ * Sharded CEP front-end.<br>
+ * Each shard is an independent CEP object with its own SQLite3 database in <br>
+ * memory, prepared statements, writer thread and persister, so that the <br>
+ * shards ingest on separate cores.<br>
+ * A table is routed to one shard by the hash of its name, or each record is <br>
+ * routed by the hash of the value of its shard key column.<br>
+ *
+ * @param shard			Array of CEP objects (one per shard)
+ * @param numberOfShard	Number of shards
+ * @param key			Shard keys per table (NULL: all tables are routed by name)
+ * @param async			Flag indicating the shards are in asynchronous mode
+ */
+#ifndef M2MCEPRouter
+typedef struct
+	{
+	M2MCEP **shard;
+	unsigned int numberOfShard;
+	M2MCEPRouterKey *key;
+	bool async;
+	} M2MCEPRouter;
+#endif /* M2MCEPRouter */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Release the shards (the queued and pending records are inserted and <br>
+ * persisted first) and the heap memory of the router.<br>
+ *
+ * @param[in,out] self	Router object to be freed of memory area
+ */
+void M2MCEPRouter_delete (M2MCEPRouter **self);
+
+
+/**
+ * Returns the number of shards.<br>
+ *
+ * @param[in] self	Router object
+ * @return			Number of shards (0 in case of error)
+ */
+unsigned int M2MCEPRouter_getNumberOfShard (const M2MCEPRouter *self);
+
+
+/**
+ * Returns the CEP object of the shard (e.g. to configure it or to run a <br>
+ * query on the shard returned by M2MCEPRouter_route()).<br>
+ *
+ * @param[in] self	Router object
+ * @param[in] index	Index number of the shard (>=0)
+ * @return			CEP object of the shard or NULL (in case of error)
+ */
+M2MCEP *M2MCEPRouter_getShard (const M2MCEPRouter *self, const unsigned int index);
+
+
+/**
+ * Route the CSV format string to the shards.<br>
+ * When a shard key is set for the table, the records are split by the hash <br>
+ * of the key value (the header line is copied for each shard); otherwise the <br>
+ * whole string goes to the shard of the table.<br>
+ * In asynchronous mode the strings are put into the queues of the shards <br>
+ * (M2MCEP_enqueueCSV()), otherwise they are inserted (M2MCEP_insertCSV()).<br>
+ * Any number of threads can call this function at the same time; the <br>
+ * shards are locked independently.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				Number of records inserted or queued[row] or -1 (in case of error)
+ */
+int M2MCEPRouter_insertCSV (M2MCEPRouter *self, const M2MString *tableName, const M2MString *csv);
+
+
+/**
+ * Constructor.<br>
+ * Create the shards named "<databaseName>_<index>" with the table managers <br>
+ * (one per shard, having the same tables).<br>
+ * The table managers are owned by the shards. In case of error, the table <br>
+ * managers which were not handed to a shard remain owned by the caller.<br>
+ *
+ * @param[in] databaseName		String indicating the base name of the databases of the shards
+ * @param[in] tableManager		Array of table managers (one per shard)
+ * @param[in] numberOfShard		Number of shards (1 to M2MCEPRouter_MAX_SHARD, e.g. number of cores)
+ * @return						Created router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_new (const M2MString *databaseName, M2MTableManager *tableManager[], const unsigned int numberOfShard);
+
+
+/**
+ * Returns the index number of the shard holding the table (key is NULL) or <br>
+ * the records of the key value.<br>
+ *
+ * @param[in] self		Router object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] key		String indicating the value of the shard key column or NULL
+ * @return				Index number of the shard or -1 (in case of error)
+ */
+int M2MCEPRouter_route (const M2MCEPRouter *self, const M2MString *tableName, const M2MString *key);
+
+
+/**
+ * Executes the SQL statement on all shards and merges the CSV results (the <br>
+ * header line of the first result, then the records of all shards in the <br>
+ * order of the shards).<br>
+ * The records are concatenated: ORDER BY, LIMIT and aggregate functions are <br>
+ * applied per shard. Run such a query on one shard (M2MCEPRouter_route()) <br>
+ * or combine the per shard results.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return				CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEPRouter_select (M2MCEPRouter *self, const M2MString *sql, M2MString **result);
+
+
+/**
+ * Executes the SELECT statement on all shards and hands each row of the <br>
+ * results to the callback (see M2MCEP_selectEach()).<br>
+ * When the callback returns false, the remaining shards are skipped.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[in] callback	Callback receiving the rows of the results
+ * @param[in] userData	Pointer passed to the callback as it is
+ * @return				Number of rows handed to the callback or -1 (in case of error)
+ */
+int M2MCEPRouter_selectEach (M2MCEPRouter *self, const M2MString *sql, const M2MCEPRowCallback callback, void *userData);
+
+
+/**
+ * Set the column whose value decides the shard of each record of the table.<br>
+ * Set the shard keys before inserting records into the table.<br>
+ *
+ * @param[in,out] self		Router object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name of the key
+ * @return					Router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_setShardKey (M2MCEPRouter *self, const M2MString *tableName, const M2MString *columnName);
+
+
+/**
+ * Start the asynchronous mode of all shards (one writer thread per shard, <br>
+ * see M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] capacity	Number of CSV strings the queue of each shard can hold
+ * @param[in] blocking	true: the caller waits when the queue is full, false: the CSV string is dropped
+ * @return				Router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_startAsync (M2MCEPRouter *self, const unsigned int capacity, const bool blocking);
+
+
+/**
+ * Stop the asynchronous mode of all shards after inserting all queued CSV <br>
+ * strings.<br>
+ *
+ * @param[in,out] self	Router object
+ * @return				Router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_stopAsync (M2MCEPRouter *self);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPROUTER_H_ */
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * M2MCEPValue.h : Typed value of a record field for CEP
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_CEP_M2MCEPVALUE_H_
+#define M2M_CEP_M2MCEPVALUE_H_
+
+
+
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sqlite3.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Enumerated object indicating the type of value held by M2MCEPValue.<br>
+ */
+#ifndef M2MCEPValueType
+typedef enum
+	{
+	M2MCEPValueType_NULL,
+	M2MCEPValueType_INTEGER,
+	M2MCEPValueType_REAL,
+	M2MCEPValueType_TEXT,
+	M2MCEPValueType_BLOB
+	} M2MCEPValueType;
+#endif /* M2MCEPValueType */
+
+
+/**
+ * Typed value of one record field.<br>
+ * The memory pointed by "text" and "blob" is owned by the caller.<br>
+ *
+ * @param type		Type of the value
+ * @param integer	64 bit integer (in case of M2MCEPValueType_INTEGER)
+ * @param real		Double precision number (in case of M2MCEPValueType_REAL)
+ * @param text		UTF-8 string (in case of M2MCEPValueType_TEXT)
+ * @param blob		Binary data (in case of M2MCEPValueType_BLOB)
+ * @param length	Size of "text" or "blob"[Byte] (in case of "text", -1 means null terminated)
+ */
+#ifndef M2MCEPValue
+typedef struct
+	{
+	M2MCEPValueType type;
+	union
+		{
+		int64_t integer;
+		double real;
+		const M2MString *text;
+		const void *blob;
+		} value;
+	int length;
+	} M2MCEPValue;
+#endif /* M2MCEPValue */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Bind the value into the parameter of SQLite3 prepared statement without <br>
+ * converting it to a string.<br>
+ * Strings and binary data are copied by SQLite (SQLITE_TRANSIENT).<br>
+ *
+ * @param[in] self			Typed value
+ * @param[in] index			Index number of the parameter (>=1)
+ * @param[in,out] statement	SQLite3 prepared statement object
+ * @return					true: Succeed to bind, false: Failed to bind
+ */
+bool M2MCEPValue_bind (const M2MCEPValue *self, const unsigned int index, sqlite3_stmt *statement);
+
+
+/**
+ * Set the value of the column of the current row of SQLite3 prepared <br>
+ * statement without converting it to a string.<br>
+ * Strings and binary data point to the memory of SQLite, which is valid <br>
+ * until the statement is stepped, reset or finalized.<br>
+ *
+ * @param[out] self			Typed value
+ * @param[in] statement		SQLite3 prepared statement object (after SQLITE_ROW)
+ * @param[in] index			Index number of the column (>=0)
+ * @return					Typed value or NULL (in case of error)
+ */
+M2MCEPValue *M2MCEPValue_setColumn (M2MCEPValue *self, sqlite3_stmt *statement, const int index);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_CEP_M2MCEPVALUE_H_ */
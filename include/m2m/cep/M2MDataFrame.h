@@ -36,6 +36,8 @@
 #include "m2m/lib/lang/M2MString.h"
 #include "m2m/lib/log/M2MFileAppender.h"
 #include "m2m/lib/util/list/M2MList.h"
+#include "m2m/lib/util/list/M2MRingBuffer.h"
+#include <stdint.h>
 
 
 
@@ -61,7 +63,14 @@ extern "C"
  * @param tableName			String indicating table name
  * @param columnName		CSV format string (= [field name, field name, field name ···]) indicating the field name of the table
  * @param newRecordList 	A structure object (= [CSV 1 line -> CSV 1 line -> CSV 1 line ····)] indicating newly inserted record information (character string))
- * @param newRecordList 	A structure object (= [CSV 1 line -> CSV 1 line -> CSV 1 line ...)] indicating the record information (character string) inserted in the past. Ascending order from past data
+ * @param oldRecordList 	A ring buffer object (= [CSV 1 line, CSV 1 line, CSV 1 line ...)] indicating the record information (character string) inserted in the past. Ascending order from past data
+ * @param windowLength		Number of records of the table held in the SQLite 3 database in memory
+ * @param lastRowid			Rowid of the last record inserted into the table of the SQLite 3 database in memory
+ * @param evictedRecord		Total number of records evicted from the table of the SQLite 3 database in memory
+ * @param persistedRowid	Rowid up to which the records held in the SQLite 3 database in memory are already in the SQLite 3 database on file (restored snapshot)
+ * @param sequence			Sequence number of the last record inserted into the table of the SQLite 3 database in memory (write-ahead log)
+ * @param persistedSequence	Sequence number of the last record of the table persisted into the SQLite 3 database on file (-1 until loaded)
+ * @param evictSQL			DELETE statement evicting the records below a rowid watermark (created on demand)
  */
 #ifndef M2MDataFrame
 typedef struct M2MDataFrame
@@ -71,11 +80,28 @@ typedef struct M2MDataFrame
 	M2MString *tableName;
 	M2MString *columnName;
 	M2MList *newRecordList;
-	M2MList *oldRecordList;
+	M2MRingBuffer *oldRecordList;
+	unsigned int windowLength;
+	int64_t lastRowid;
+	unsigned long evictedRecord;
+	int64_t persistedRowid;
+	int64_t sequence;
+	int64_t persistedSequence;
+	M2MString *evictSQL;
 	} M2MDataFrame;
 #endif /* M2MDataFrame */
 
 
+/**
+ * Initial number of slots of the ring buffer holding records inserted in the past.<br>
+ * The ring buffer is extended by the CEP object according to the maximum number <br>
+ * of records.<br>
+ */
+#ifndef M2MDataFrame_OLD_RECORD_CAPACITY
+#define M2MDataFrame_OLD_RECORD_CAPACITY (64)
+#endif /* M2MDataFrame_OLD_RECORD_CAPACITY */
+
+
 
 /*******************************************************************************
  * Public function
@@ -92,6 +118,15 @@ typedef struct M2MDataFrame
 M2MDataFrame *M2MDataFrame_begin (M2MDataFrame *self);
 
 
+/**
+ * Release all records of the newly inserted record list held by the argument <br>
+ * and replace it with an empty list.<br>
+ *
+ * @param[in,out] self	Record management object
+ */
+void M2MDataFrame_clearNewRecordList (M2MDataFrame *self);
+
+
 /**
  * Free all memory area of record management object specified by argument.<br>
  * <br>
@@ -117,6 +152,37 @@ void M2MDataFrame_delete (M2MDataFrame **self);
 M2MString *M2MDataFrame_getColumnName (const M2MDataFrame *self);
 
 
+/**
+ * Returns the total number of records evicted from the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Number of evicted records
+ */
+unsigned long M2MDataFrame_getEvictedRecordCount (const M2MDataFrame *self);
+
+
+/**
+ * Returns the DELETE statement ("DELETE FROM table WHERE rowid < ?") evicting <br>
+ * the records of the table below a rowid watermark.<br>
+ * The string is created on the first call and kept by the object.<br>
+ *
+ * @param[in,out] self	Record management object
+ * @return				String indicating the DELETE statement or NULL (in case of error)
+ */
+M2MString *M2MDataFrame_getEvictSQL (M2MDataFrame *self);
+
+
+/**
+ * Returns the rowid of the last record inserted into the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Rowid of the last inserted record (0 if none)
+ */
+int64_t M2MDataFrame_getLastRowid (const M2MDataFrame *self);
+
+
 /**
  * Returns a newly inserted record list that the argument holds as a member variable.<br>
  *
@@ -132,7 +198,40 @@ M2MList *M2MDataFrame_getNewRecordList (const M2MDataFrame *self);
  * @param[in] self		Record management object
  * @return				Record list (inserted in the memory DB) inserted in the past that is held by the record management object specified by the argument
  */
-M2MList *M2MDataFrame_getOldRecordList (const M2MDataFrame *self);
+M2MRingBuffer *M2MDataFrame_getOldRecordList (const M2MDataFrame *self);
+
+
+/**
+ * Returns the rowid up to which the records held in the SQLite 3 database in <br>
+ * memory are already in the SQLite 3 database on file. Such records are not <br>
+ * inserted into the SQLite 3 database on file again when they are evicted.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Rowid of the last persisted record (0 if none)
+ */
+int64_t M2MDataFrame_getPersistedRowid (const M2MDataFrame *self);
+
+
+/**
+ * Returns the sequence number of the last record of the table persisted <br>
+ * into the SQLite 3 database on file. The records of the write-ahead log up <br>
+ * to this number aren't replayed after a crash.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Sequence number of the last persisted record (-1 until loaded)
+ */
+int64_t M2MDataFrame_getPersistedSequence (const M2MDataFrame *self);
+
+
+/**
+ * Returns the sequence number of the last record inserted into the table of <br>
+ * the SQLite 3 database in memory. Each record of the table is numbered in <br>
+ * the order of insertion for the write-ahead log.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Sequence number of the last inserted record (0 if none)
+ */
+int64_t M2MDataFrame_getSequence (const M2MDataFrame *self);
 
 
 /**
@@ -144,6 +243,16 @@ M2MList *M2MDataFrame_getOldRecordList (const M2MDataFrame *self);
 M2MString *M2MDataFrame_getTableName (const M2MDataFrame *self);
 
 
+/**
+ * Returns the number of records of the table held in the SQLite 3 database in <br>
+ * memory.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Number of records held in the SQLite 3 database in memory
+ */
+unsigned int M2MDataFrame_getWindowLength (const M2MDataFrame *self);
+
+
 /**
  * Copy the record information of the "newly inserted record information" structure <br>
  * object of the record management object designated by the argument to the "record <br>
@@ -223,6 +332,26 @@ void M2MDataFrame_remove (M2MDataFrame *self, const M2MString *tableName);
 int M2MDataFrame_setCSV (M2MDataFrame *self, const M2MString *tableName, const M2MString *csv);
 
 
+/**
+ * Set the total number of records evicted from the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in,out] self			Record management object
+ * @param[in] evictedRecord		Number of evicted records
+ */
+void M2MDataFrame_setEvictedRecordCount (M2MDataFrame *self, const unsigned long evictedRecord);
+
+
+/**
+ * Set the rowid of the last record inserted into the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] lastRowid		Rowid of the last inserted record
+ */
+void M2MDataFrame_setLastRowid (M2MDataFrame *self, const int64_t lastRowid);
+
+
 /**
  * Set the record management object one record behind the argument.<br>
  *
@@ -232,6 +361,26 @@ int M2MDataFrame_setCSV (M2MDataFrame *self, const M2MString *tableName, const M
 void M2MDataFrame_setNextRecord (M2MDataFrame *self, M2MDataFrame *nextRecord);
 
 
+/**
+ * Set the rowid up to which the records held in the SQLite 3 database in <br>
+ * memory are already in the SQLite 3 database on file.<br>
+ *
+ * @param[in,out] self			Record management object
+ * @param[in] persistedRowid	Rowid of the last persisted record
+ */
+void M2MDataFrame_setPersistedRowid (M2MDataFrame *self, const int64_t persistedRowid);
+
+
+/**
+ * Set the sequence number of the last record of the table persisted into <br>
+ * the SQLite 3 database on file.<br>
+ *
+ * @param[in,out] self				Record management object
+ * @param[in] persistedSequence		Sequence number of the last persisted record
+ */
+void M2MDataFrame_setPersistedSequence (M2MDataFrame *self, const int64_t persistedSequence);
+
+
 /**
  * Set the record management object one before the argument.<br>
  *
@@ -241,6 +390,41 @@ void M2MDataFrame_setNextRecord (M2MDataFrame *self, M2MDataFrame *nextRecord);
 void M2MDataFrame_setPreviousRecord (M2MDataFrame *self, M2MDataFrame *previousRecord);
 
 
+/**
+ * Set the sequence number of the last record inserted into the table of the <br>
+ * SQLite 3 database in memory.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] sequence		Sequence number of the last inserted record
+ */
+void M2MDataFrame_setSequence (M2MDataFrame *self, const int64_t sequence);
+
+
+/**
+ * Returns the record management object having the table name specified by the <br>
+ * argument.<br>
+ * If no record management object has the table name, a record management object <br>
+ * is newly generated with the table name and the CSV format column name and <br>
+ * added to the record management object specified by the argument.<br>
+ * This is used to insert records without CSV format string.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] tableName		String indicating table name
+ * @param[in] columnName	CSV format string indicating the column names of records
+ * @return					Record management object of the table or NULL (in case of error)
+ */
+M2MDataFrame *M2MDataFrame_setTable (M2MDataFrame *self, const M2MString *tableName, const M2MString *columnName);
+
+
+/**
+ * Set the number of records of the table held in the SQLite 3 database in memory.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] windowLength	Number of records held in the SQLite 3 database in memory
+ */
+void M2MDataFrame_setWindowLength (M2MDataFrame *self, const unsigned int windowLength);
+
+
 /**
  * Returns the number of elements of record management object specified by argument.<br>
  *
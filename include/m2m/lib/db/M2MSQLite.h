@@ -144,6 +144,15 @@ bool M2MSQLite_executeUpdate (sqlite3 *database, const M2MString *sql);
 M2MString *M2MSQLite_getErrorMessage (sqlite3 *database);
 
 
+/**
+ * Returns the number of unused pages (freelist) of the SQLite3 database.<br>
+ *
+ * @param[in] database	SQLite3 database manager object
+ * @return				Number of free pages or -1 (in case of error)
+ */
+int64_t M2MSQLite_getFreelistCount (sqlite3 *database);
+
+
 /**
  * SQLite 3 Returns the maximum number of columns allowed in the table.<br>
  *
@@ -173,6 +182,17 @@ sqlite3_stmt *M2MSQLite_getPreparedStatement (sqlite3 *database, const M2MString
 M2MString *M2MSQLite_getTableInfoSQL (const M2MString *tableName, M2MString **sql);
 
 
+/**
+ * Remove up to the indicated number of pages from the freelist of the SQLite3 <br>
+ * database and truncate the database (auto_vacuum must be INCREMENTAL).<br>
+ *
+ * @param[in] database		SQLite3 database manager object
+ * @param[in] numberOfPage	Number of pages to be removed from the freelist
+ * @return					true: success, false: failure
+ */
+bool M2MSQLite_incrementalVacuum (sqlite3 *database, const uint32_t numberOfPage);
+
+
 /**
  * Check the existence of indicated table and return the result.<br>
  *
@@ -233,6 +253,17 @@ bool M2MSQLite_setAutoVacuum (sqlite3 *database, const bool flag);
 bool M2MSQLite_setCacheSize (sqlite3 *database, const uint32_t cacheSize);
 
 
+/**
+ * Set the auto-vacuum status of the SQLite3 database to INCREMENTAL.<br>
+ * Since an existing database can not change the auto-vacuum status without <br>
+ * rebuilding, VACUUM is executed once in that case.<br>
+ *
+ * @param[in] database	SQLite3 database object to set incremental vacuum
+ * @return				true: success, false: failure
+ */
+bool M2MSQLite_setIncrementalVacuum (sqlite3 *database);
+
+
 /**
  * Set the synchronous mode of the SQLite 3 database.<br>
  *
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * M2MStatementCache.h
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_LIB_DB_M2MSTATEMENTCACHE_H_
+#define M2M_LIB_DB_M2MSTATEMENTCACHE_H_
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+#include "m2m/lib/db/M2MSQLite.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MLogger.h"
+#include "m2m/lib/security/M2MCRC32.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sqlite3.h>
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Cached prepared statement (node of bidirectional list).<br>
+ * The list is kept in the order of use, the head is the most recently used.<br>
+ *
+ * @param previous	Entry located before (NULL in the case of the head)
+ * @param next		Entry located behind (NULL in the case of the end)
+ * @param hash		CRC-32 value of the key string
+ * @param key		String identifying the statement (table name or SQL statement)
+ * @param signature	String which must also match to reuse the statement (e.g. column name CSV) or NULL
+ * @param statement	Prepared statement owned by the cache
+ */
+#ifndef M2MStatementCacheEntry
+typedef struct M2MStatementCacheEntry
+	{
+	struct M2MStatementCacheEntry *previous;
+	struct M2MStatementCacheEntry *next;
+	uint32_t hash;
+	M2MString *key;
+	M2MString *signature;
+	sqlite3_stmt *statement;
+	} M2MStatementCacheEntry;
+#endif /* M2MStatementCacheEntry */
+
+
+/**
+ * Cache of prepared statements bound to one SQLite3 database connection.<br>
+ * The least recently used statement is finalized when the number of cached <br>
+ * statements exceeds the capacity.<br>
+ *
+ * @param database	SQLite3 database connection which prepares the statements
+ * @param head		Most recently used entry
+ * @param tail		Least recently used entry
+ * @param length	Number of cached statements
+ * @param capacity	Maximum number of cached statements (unlimited in case of 0)
+ * @param hit		Number of lookups which reused a cached statement
+ * @param miss		Number of lookups which needed a new statement
+ */
+#ifndef M2MStatementCache
+typedef struct
+	{
+	sqlite3 *database;
+	M2MStatementCacheEntry *head;
+	M2MStatementCacheEntry *tail;
+	unsigned int length;
+	unsigned int capacity;
+	uint64_t hit;
+	uint64_t miss;
+	} M2MStatementCache;
+#endif /* M2MStatementCache */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Finalize all cached prepared statements.<br>
+ * This function must be called when the database schema has been changed.<br>
+ *
+ * @param[in,out] self	Statement cache object
+ */
+void M2MStatementCache_clear (M2MStatementCache *self);
+
+
+/**
+ * Finalize all cached prepared statements and release the heap memory of <br>
+ * the statement cache object.<br>
+ * Call this function before closing the SQLite3 database connection.<br>
+ *
+ * @param[in,out] self	Statement cache object to be freed of memory area
+ */
+void M2MStatementCache_delete (M2MStatementCache **self);
+
+
+/**
+ * Return the SQLite3 database connection bound to the statement cache.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			SQLite3 database object or NULL (in case of error)
+ */
+sqlite3 *M2MStatementCache_getDatabase (const M2MStatementCache *self);
+
+
+/**
+ * Return the number of lookups which reused a cached prepared statement.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			Number of cache hits
+ */
+uint64_t M2MStatementCache_getHitCount (const M2MStatementCache *self);
+
+
+/**
+ * Return the number of prepared statements held by the cache.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			Number of cached statements
+ */
+unsigned int M2MStatementCache_getLength (const M2MStatementCache *self);
+
+
+/**
+ * Return the number of lookups which couldn't reuse a cached statement.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			Number of cache misses
+ */
+uint64_t M2MStatementCache_getMissCount (const M2MStatementCache *self);
+
+
+/**
+ * Constructor.<br>
+ * Create new statement cache object bound to the SQLite3 database connection.<br>
+ *
+ * @param[in] database	SQLite3 database object
+ * @param[in] capacity	Maximum number of cached statements (unlimited in case of 0)
+ * @return				Created statement cache object or NULL (in case of error)
+ */
+M2MStatementCache *M2MStatementCache_new (sqlite3 *database, const unsigned int capacity);
+
+
+/**
+ * Prepare the SQL statement and store it into the cache with the key and <br>
+ * signature.<br>
+ * The returned statement is owned by the cache, so caller must not finalize <br>
+ * it with "M2MSQLite_closeStatement()".<br>
+ *
+ * @param[in,out] self		Statement cache object
+ * @param[in] key			String identifying the statement
+ * @param[in] signature		String which must also match to reuse the statement or NULL
+ * @param[in] sql			SQL statement to be prepared
+ * @return					Prepared statement or NULL (in case of error)
+ */
+sqlite3_stmt *M2MStatementCache_put (M2MStatementCache *self, const M2MString *key, const M2MString *signature, const M2MString *sql);
+
+
+/**
+ * Search the cached prepared statement matching the key and signature.<br>
+ * When found, the statement is reset, its bindings are cleared and it becomes <br>
+ * the most recently used one.<br>
+ * When an entry with the same key but a different signature exists, it is <br>
+ * regarded as stale and finalized.<br>
+ *
+ * @param[in,out] self		Statement cache object
+ * @param[in] key			String identifying the statement
+ * @param[in] signature		String which must also match to reuse the statement or NULL
+ * @return					Cached prepared statement or NULL (in case of cache miss)
+ */
+sqlite3_stmt *M2MStatementCache_search (M2MStatementCache *self, const M2MString *key, const M2MString *signature);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_LIB_DB_M2MSTATEMENTCACHE_H_ */
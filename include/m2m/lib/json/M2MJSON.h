@@ -47,6 +47,7 @@ extern "C"
 #include "m2m/lib/log/M2MLogLevel.h"
 #include "m2m/lib/json/M2MJSONType.h"
 #include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/lang/M2MStringBuilder.h"
 #include "m2m/lib/security/M2MCRC32.h"
 
 #include <stdbool.h>
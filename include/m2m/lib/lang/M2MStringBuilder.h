@@ -0,0 +1,263 @@
+/*******************************************************************************
+ * M2MStringBuilder.h : Growable string buffer for amortized O(1) concatenation
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_LIB_LANG_M2MSTRINGBUILDER_H_
+#define M2M_LIB_LANG_M2MSTRINGBUILDER_H_
+
+
+
+#include "m2m/M2MSystem.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Default capacity of the buffer allocated at the first append[Byte].<br>
+ */
+#ifndef M2MStringBuilder_DEFAULT_CAPACITY
+#define M2MStringBuilder_DEFAULT_CAPACITY (size_t)64
+#endif /* M2MStringBuilder_DEFAULT_CAPACITY */
+
+
+/**
+ * Growable string buffer.<br>
+ * The capacity is doubled when the appended string doesn't fit, so that <br>
+ * concatenation costs amortized O(1) per byte. The buffer is always <br>
+ * terminated by '\0'.<br>
+ * The structure can be placed on the stack (initialized by <br>
+ * "M2MStringBuilder_init()") or allocated by "M2MStringBuilder_new()".<br>
+ *
+ * @param buffer	String buffer or NULL (before the first append)
+ * @param length	Length of the string held in the buffer[Byte]
+ * @param capacity	Size of the buffer (including '\0')[Byte]
+ */
+#ifndef M2MStringBuilder
+typedef struct
+	{
+	M2MString *buffer;
+	size_t length;
+	size_t capacity;
+	} M2MStringBuilder;
+#endif /* M2MStringBuilder */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append the string at the end of the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] string	String to be appended
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_append (M2MStringBuilder *self, const M2MString *string);
+
+
+/**
+ * Append one character at the end of the buffer.<br>
+ *
+ * @param[in,out] self		String builder object
+ * @param[in] character		Character to be appended
+ * @return					String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendCharacter (M2MStringBuilder *self, const M2MString character);
+
+
+/**
+ * Append the double number converted into string (same format as <br>
+ * "M2MString_convertFromDoubleToString()") at the end of the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] number	Double number
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendDouble (M2MStringBuilder *self, const double number);
+
+
+/**
+ * Append the string formatted like "printf()" at the end of the buffer.<br>
+ * The string is formatted directly into the buffer (no temporary copy).<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] format	Format string
+ * @param[in] ...		Arguments of the format
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendFormat (M2MStringBuilder *self, const M2MString *format, ...);
+
+
+/**
+ * Append the string of indicated length at the end of the buffer.<br>
+ * The string needn't be terminated by '\0'.<br>
+ *
+ * @param[in,out] self		String builder object
+ * @param[in] string		String to be appended
+ * @param[in] stringLength	Length of the string to be appended[Byte]
+ * @return					String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendLength (M2MStringBuilder *self, const M2MString *string, const size_t stringLength);
+
+
+/**
+ * Append the signed integer converted into decimal string at the end of <br>
+ * the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] number	Signed integer
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendSignedLong (M2MStringBuilder *self, const int64_t number);
+
+
+/**
+ * Append the unsigned integer converted into decimal string at the end of <br>
+ * the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] number	Unsigned integer
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendUnsignedLong (M2MStringBuilder *self, const uint64_t number);
+
+
+/**
+ * Empty the string for reuse of the builder.<br>
+ * The allocated buffer is kept.<br>
+ *
+ * @param[in,out] self	String builder object
+ */
+void M2MStringBuilder_clear (M2MStringBuilder *self);
+
+
+/**
+ * Release the heap memory of the string builder allocated by <br>
+ * "M2MStringBuilder_new()".<br>
+ *
+ * @param[in,out] self	String builder object
+ */
+void M2MStringBuilder_delete (M2MStringBuilder **self);
+
+
+/**
+ * Hand over the string of the builder to the caller. <br>
+ * The builder becomes empty (without buffer) and can be reused.<br>
+ * Caller must release the returned string with "M2MHeap_free()".<br>
+ *
+ * @param[in,out] self	String builder object
+ * @return				String (caller owns it) or NULL (in case of empty builder)
+ */
+M2MString *M2MStringBuilder_detach (M2MStringBuilder *self);
+
+
+/**
+ * Return the length of the string held in the builder.<br>
+ *
+ * @param[in] self	String builder object
+ * @return			Length of the string[Byte]
+ */
+size_t M2MStringBuilder_getLength (const M2MStringBuilder *self);
+
+
+/**
+ * Return the string held in the builder (owned by the builder).<br>
+ *
+ * @param[in] self	String builder object
+ * @return			String or NULL (in case of empty builder)
+ */
+M2MString *M2MStringBuilder_getString (const M2MStringBuilder *self);
+
+
+/**
+ * Initialize the string builder placed on the stack or in other structure.<br>
+ * The buffer is allocated at the first append.<br>
+ *
+ * @param[out] self	String builder object
+ * @return			String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_init (M2MStringBuilder *self);
+
+
+/**
+ * Allocate new string builder object on heap memory.<br>
+ *
+ * @param[in] capacity	Initial capacity of the buffer (0 means allocation at the first append)[Byte]
+ * @return				Created string builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_new (const size_t capacity);
+
+
+/**
+ * Release the buffer of the string builder initialized by <br>
+ * "M2MStringBuilder_init()". The builder becomes empty.<br>
+ *
+ * @param[in,out] self	String builder object
+ */
+void M2MStringBuilder_release (M2MStringBuilder *self);
+
+
+/**
+ * Make sure the buffer can hold the string of indicated length without <br>
+ * reallocation (the capacity is doubled until it fits).<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] length	Length of the string to be held[Byte]
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_reserve (M2MStringBuilder *self, const size_t length);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_LIB_LANG_M2MSTRINGBUILDER_H_ */
@@ -44,6 +44,7 @@ extern "C"
 #include "m2m/M2MSystem.h"
 #include "m2m/lib/io/M2MHeap.h"
 #include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/lang/M2MStringBuilder.h"
 #include "m2m/lib/log/M2MLogLevel.h"
 #include "m2m/lib/time/M2MDate.h"
 #include <errno.h>
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * M2MConcurrentQueue.h : Bounded lock-free multi-producer queue of pointers
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_LIB_UTIL_LIST_M2MCONCURRENTQUEUE_H_
+#define M2M_LIB_UTIL_LIST_M2MCONCURRENTQUEUE_H_
+
+
+
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Slot of concurrent queue.<br>
+ *
+ * @param sequence	Sequence number indicating whether the slot is writable or readable
+ * @param value		Pointer stored in the slot
+ */
+#ifndef M2MConcurrentQueueElement
+typedef struct
+	{
+	atomic_size_t sequence;
+	void *value;
+	} M2MConcurrentQueueElement;
+#endif /* M2MConcurrentQueueElement */
+
+
+/**
+ * Bounded lock-free FIFO queue of pointers.<br>
+ * Any number of threads can offer and poll at the same time without mutex <br>
+ * (each slot carries a sequence number and the positions are claimed with <br>
+ * compare-and-swap). Offer fails immediately when the queue is full.<br>
+ * The number of slots is rounded up to a power of 2.<br>
+ *
+ * @param element		Array of slots
+ * @param mask			Number of slots - 1
+ * @param enqueueIndex	Position of the next offer
+ * @param dequeueIndex	Position of the next poll
+ */
+#ifndef M2MConcurrentQueue
+typedef struct
+	{
+	M2MConcurrentQueueElement *element;
+	size_t mask;
+	atomic_size_t enqueueIndex;
+	atomic_size_t dequeueIndex;
+	} M2MConcurrentQueue;
+#endif /* M2MConcurrentQueue */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Release the heap memory of the queue.<br>
+ * Pointers remaining in the queue are released with M2MHeap_free().<br>
+ * Must not be called while other threads still access the queue.<br>
+ *
+ * @param[in,out] self	Concurrent queue structure object to be released
+ */
+void M2MConcurrentQueue_delete (M2MConcurrentQueue **self);
+
+
+/**
+ * Returns the number of slots of the queue.<br>
+ *
+ * @param[in] self	Concurrent queue structure object
+ * @return			Number of slots or 0 (in case of error)
+ */
+size_t M2MConcurrentQueue_getCapacity (const M2MConcurrentQueue *self);
+
+
+/**
+ * Check whether the queue has no pointer.<br>
+ *
+ * @param[in] self	Concurrent queue structure object
+ * @return			true: empty (or error), false: at least one pointer is stored
+ */
+bool M2MConcurrentQueue_isEmpty (M2MConcurrentQueue *self);
+
+
+/**
+ * Returns the number of stored pointers.<br>
+ * While other threads offer or poll, the value is a snapshot.<br>
+ *
+ * @param[in] self	Concurrent queue structure object
+ * @return			Number of stored pointers
+ */
+size_t M2MConcurrentQueue_length (M2MConcurrentQueue *self);
+
+
+/**
+ * Constructor.<br>
+ * Create new concurrent queue with the indicated number of slots.<br>
+ *
+ * @param[in] capacity	Number of slots (rounded up to a power of 2)
+ * @return				Created concurrent queue structure object or NULL (in case of error)
+ */
+M2MConcurrentQueue *M2MConcurrentQueue_new (const size_t capacity);
+
+
+/**
+ * Add the pointer to the end of the queue (without copy).<br>
+ * The ownership of the pointed memory moves to the queue on success.<br>
+ *
+ * @param[in,out] self	Concurrent queue structure object
+ * @param[in] value		Pointer to be added (not NULL)
+ * @return				true: added, false: the queue is full (or error)
+ */
+bool M2MConcurrentQueue_offer (M2MConcurrentQueue *self, void *value);
+
+
+/**
+ * Remove the oldest pointer from the queue and return it.<br>
+ *
+ * @param[in,out] self	Concurrent queue structure object
+ * @return				Oldest pointer or NULL (in case of empty or error)
+ */
+void *M2MConcurrentQueue_poll (M2MConcurrentQueue *self);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_LIB_UTIL_LIST_M2MCONCURRENTQUEUE_H_ */
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * M2MRingBuffer.h : Fixed-capacity circular buffer of values
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#ifndef M2M_LIB_UTIL_LIST_M2MRINGBUFFER_H_
+#define M2M_LIB_UTIL_LIST_M2MRINGBUFFER_H_
+
+
+
+#include "m2m/lib/io/M2MHeap.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/log/M2MFileAppender.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Element of ring buffer.<br>
+ *
+ * @param value			Pointer to "value" copied into the ring buffer
+ * @param valueLength	Integer indicating the size of "value"[Byte]
+ */
+#ifndef M2MRingBufferElement
+typedef struct
+	{
+	void *value;
+	size_t valueLength;
+	} M2MRingBufferElement;
+#endif /* M2MRingBufferElement */
+
+
+/**
+ * Ring buffer structure object (FIFO with preallocated slots).<br>
+ * Pushing to the end, popping from the head, random access and length are <br>
+ * all O(1). When pushing into a full buffer, the slot array is doubled <br>
+ * (amortized O(1)) so that no value is lost.<br>
+ *
+ * @param element	Array of elements (slots)
+ * @param capacity	Number of slots of the array
+ * @param head		Slot index of the oldest element
+ * @param length	Number of stored elements
+ */
+#ifndef M2MRingBuffer
+typedef struct
+	{
+	M2MRingBufferElement *element;
+	size_t capacity;
+	size_t head;
+	size_t length;
+	} M2MRingBuffer;
+#endif /* M2MRingBuffer */
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Release the values of all elements (the slot array is kept).<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ */
+void M2MRingBuffer_clear (M2MRingBuffer *self);
+
+
+/**
+ * Release the heap memory of the ring buffer and all values.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object to be released
+ */
+void M2MRingBuffer_delete (M2MRingBuffer **self);
+
+
+/**
+ * Returns the number of slots currently allocated.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @return			Number of slots or 0 (in case of error)
+ */
+size_t M2MRingBuffer_getCapacity (const M2MRingBuffer *self);
+
+
+/**
+ * Returns the value located at the index counted from the oldest element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @param[in] index	Index from the oldest element (0 is the oldest)
+ * @return			Value or NULL (in case of error)
+ */
+void *M2MRingBuffer_getValue (const M2MRingBuffer *self, const size_t index);
+
+
+/**
+ * Returns the size of the value located at the index counted from the oldest <br>
+ * element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @param[in] index	Index from the oldest element (0 is the oldest)
+ * @return			Size of value[Byte] or 0 (in case of error)
+ */
+size_t M2MRingBuffer_getValueLength (const M2MRingBuffer *self, const size_t index);
+
+
+/**
+ * Returns true if the ring buffer holds no element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @return			true: empty, false: holds element(s)
+ */
+bool M2MRingBuffer_isEmpty (const M2MRingBuffer *self);
+
+
+/**
+ * Returns the number of stored elements.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @return			Number of stored elements
+ */
+size_t M2MRingBuffer_length (const M2MRingBuffer *self);
+
+
+/**
+ * Create a new ring buffer with preallocated slots.<br>
+ *
+ * @param[in] capacity	Number of slots to preallocate (1 or more)
+ * @return				Created ring buffer structure object or NULL (in case of error)
+ */
+M2MRingBuffer *M2MRingBuffer_new (const size_t capacity);
+
+
+/**
+ * Release the value of the oldest element and remove it from the ring buffer.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ * @return				Ring buffer structure object or NULL (in case of empty or error)
+ */
+M2MRingBuffer *M2MRingBuffer_pop (M2MRingBuffer *self);
+
+
+/**
+ * Copy the value into the newest slot of the ring buffer.<br>
+ *
+ * @param[in,out] self		Ring buffer structure object
+ * @param[in] value			Value to be copied
+ * @param[in] valueLength	Size of value[Byte]
+ * @return					Ring buffer structure object or NULL (in case of error)
+ */
+M2MRingBuffer *M2MRingBuffer_push (M2MRingBuffer *self, const void *value, const size_t valueLength);
+
+
+/**
+ * Make the slot array hold at least the indicated number of elements.<br>
+ * Stored elements are kept. The array is never shrunk.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ * @param[in] capacity	Number of slots required
+ * @return				Ring buffer structure object or NULL (in case of error)
+ */
+M2MRingBuffer *M2MRingBuffer_reserve (M2MRingBuffer *self, const size_t capacity);
+
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+
+
+#endif /* M2M_LIB_UTIL_LIST_M2MRINGBUFFER_H_ */
@@ -33,6 +33,37 @@
 /*******************************************************************************
  * Declaration of private function
  ******************************************************************************/
+/**
+ * Check whether the two names (of table or column) are equal.<br>
+ * M2MString_compareTo() compares the length of the second string only, so <br>
+ * the lengths are compared first not to match a name beginning with the other.<br>
+ *
+ * @param[in] one		String indicating a name
+ * @param[in] another	String indicating another name
+ * @return				true: the names are equal, false: the names are different (or NULL)
+ */
+static bool this_equalsName (const M2MString *one, const M2MString *another);
+
+
+/**
+ * Get the column store of the table.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Column store or NULL (in case of no column store)
+ */
+static M2MCEPColumnStore *this_getColumnStore (const M2MCEP *self, const M2MString *tableName);
+
+
+/**
+ * Copy SQLite3 database working directory pathname (="~/.m2m/cep").<br>
+ *
+ * @param[out] directoryPath	Pointer for storing string indicating the directory SQLite 3 database file is set
+ * @return						SQLite3 working directory pathname or NULL (in case of error)
+ */
+static M2MString *this_getDatabaseDirectoryPath (M2MString **directoryPath);
+
+
 /**
  * Create string indicating the database file path and copy it to the buffer. <br>
  * If processing fails, NULL is returned as a return value.<br>
@@ -81,344 +112,1832 @@ static unsigned int this_getVacuumRecord (const M2MCEP *self);
 
 
 /**
- * Get a flag indicating persistence availability from the argument CEP object.<br>
+ * Get the window definition of the table specified by the argument.<br>
  *
- * @param[in,out] self		CEP structure object
- * @return					Flag indicating permanence
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Window definition or NULL (in case of no definition)
  */
-static bool this_getPersistence (const M2MCEP *self);
+static M2MCEPWindow *this_getWindow (const M2MCEP *self, const M2MString *tableName);
 
 
 /**
- * Get the table construction object held by the CEP object as a member variable.<br>
+ * Get the number of records to keep in the table of the SQLite3 database in <br>
+ * memory, from the window definition of the table (number of records and/or <br>
+ * duration of event time) or the maximum number of records of the CEP object.<br>
+ * The duration is converted into a number of records with the index of the <br>
+ * event time column (O(log n)), assuming event time increases with insertion.<br>
  *
- * @param[in] self	CEP structure object
- * @return			Table construction object or NULL (in case of error)
+ * @param[in,out] self		CEP structure object
+ * @param[in] record		Record management object of the table
+ * @return					Number of records to keep (UINT_MAX: not limited)
  */
-static M2MTableManager *this_getTableManager (const M2MCEP *self);
+static unsigned int this_getWindowLimit (M2MCEP *self, const M2MDataFrame *record);
 
 
 /**
- * Bulk insert records into SQLite 3 database specified by argument.<br>
+ * Get the maximum number of records of the table, which is the one of the <br>
+ * window definition or (without definition) the one of the CEP object.<br>
  *
- * @param[in] database		SQLite3 database management object
- * @param[in] record		Record management object
- * @param[in] tableManager	Table construction object
- * @param[in] recordList	Record information object
- * @return					Number of inserted records or -1 (in case of error)
+ * @param[in] self		CEP structure object
+ * @param[in] record	Record management object of the table
+ * @return				Maximum number of records (0: not limited by number)
  */
-static int this_insertRecordList (sqlite3 *database, const M2MDataFrame *record, M2MTableManager *tableManager, M2MList *recordList);
+static unsigned int this_getWindowMaxRecord (const M2MCEP *self, const M2MDataFrame *record);
 
 
 /**
- * If the specified maximum number of records is exceeded for the record of <br>
- * "already inserted in SQLite3 database in memory" of the CEP record management <br>
- * object held by the CEP execution object specified by the argument, the record <br>
- * of excess Into the SQLite 3 database on the file and make it persistent.<br>
+ * Release the heap memory of the window definitions held by the CEP object.<br>
  *
  * @param[in,out] self	CEP structure object
- * @return				Successful CEP execution object or NULL (in case of insertion error)
  */
-static M2MCEP *this_insertRecordListToFileDatabase (M2MCEP *self);
+static void this_deleteWindow (M2MCEP *self);
 
 
 /**
- * Insert all records (= CEPRecord-> newRecordList) held by CEP object variables <br>
- * into SQLite3 database in memory.<br>
+ * Authorizer of SQLite3 collecting the tables read by the continuous query <br>
+ * while its SELECT statement is prepared.<br>
  *
- * @param[in] self	CEP structure object
- * @return			Number of records where insert processing or -1 (in case of error)
+ * @param[in,out] userData		Continuous query
+ * @param[in] action			Action code of SQLite3
+ * @param[in] tableName			String indicating the table name (in case of SQLITE_READ)
+ * @param[in] columnName		String indicating the column name (in case of SQLITE_READ)
+ * @param[in] databaseName		String indicating the database name
+ * @param[in] triggerName		String indicating the trigger or view name
+ * @return						SQLITE_OK (the statement is always allowed)
  */
-static int this_insertRecordListToMemoryDatabase (M2MCEP *self);
+static int this_authorizeQuery (void *userData, int action, const char *tableName, const char *columnName, const char *databaseName, const char *triggerName);
 
 
 /**
- * Create a SQLite 3 database file under the specified directory.<br>
- * If creation fails, NULL is returned.<br>
+ * Finalize the prepared statement of the continuous query and release the <br>
+ * heap memory of it.<br>
  *
- * @param[in] databaseName	String indicating database name
- * @param[in] tableManager	Table information management object
- * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
- * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
- * @return					SQLite3 database file object or NULL (in case of error)
+ * @param[in,out] query	Continuous query to be freed of memory area
  */
-static sqlite3 *this_openFileDatabase (const M2MString *databaseName, const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord);
+static void this_deleteQuery (M2MCEPQuery **query);
 
 
 /**
- * Create a SQLite3 database on memory.<br>
- * If creation fails, NULL is returned.<br>
+ * Give the records inserted into the tables read by the event patterns since <br>
+ * their last evaluation to the NFA of the patterns (in the order of event <br>
+ * time).<br>
+ * Only the new records matching a step are read (rowid range search).<br>
  *
- * @param[in] tableManager	Table information management object
- * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
- * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
- * @return					SQLite3 database object or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
  */
-static sqlite3 *this_openMemoryDatabase (const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord);
+static void this_evaluatePattern (M2MCEP *self);
 
 
 /**
- * Set SQLite3 database file name of member of the CEP structure object.<br>
+ * Evaluate the continuous queries reading a table which has received records <br>
+ * since their last evaluation and deliver the rows of the result to their <br>
+ * callback.<br>
  *
- * @param[in,out] self		CEP structure object to be set SQLite3 database file name
- * @param[in] databaseName	String indicating SQLite3 database file name
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
  */
-static M2MCEP *this_setDatabaseName (M2MCEP *self, const M2MString *databaseName);
+static void this_evaluateQuery (M2MCEP *self);
 
 
 /**
- * Set indicated M2MDataFrame object into CEP structure object.<br>
+ * Get the rowid of the last record inserted into the table of SQLite3 <br>
+ * database in memory.<br>
  *
- * @param[in,out] self		CEP structure object to be set M2MDataFrame object
- * @param[in] dataFrame		M2MDataFrame object
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Rowid of the last record (0 in case of no record)
  */
-static M2MCEP *this_setDataFrame (M2MCEP *self, M2MDataFrame *dataFrame);
+static int64_t this_getTableLastRowid (const M2MCEP *self, const M2MString *tableName);
 
 
 /**
- * Set the SQLite3 file database management object as the member variable held <br>
- * by the CEP execution object specified by the argument.<br>
+ * SQL function returning the value of the aggregate declared with <br>
+ * M2MCEP_setAggregate() (table name, column name and kind of value as <br>
+ * arguments).<br>
+ *
+ * @param[in,out] context	Context of SQLite3 function (user data is the CEP object)
+ * @param[in] argc			Number of arguments (3)
+ * @param[in] argv			Arguments
+ */
+static void this_callAggregateFunction (sqlite3_context *context, int argc, sqlite3_value **argv);
+
+
+/**
+ * Remove the values of the records evicted from the table from the aggregates <br>
+ * of the table.<br>
  *
  * @param[in,out] self		CEP structure object
- * @param[in] fileDatabase	SQLite3 file database management object
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in] tableName		String indicating the table name
+ * @param[in] watermark		Rowid of the oldest record remaining in the table
  */
-static M2MCEP *this_setFileDatabase (M2MCEP *self, sqlite3 *fileDatabase);
+static void this_evictAggregate (M2MCEP *self, const M2MString *tableName, const int64_t watermark);
 
 
 /**
- * Set the SQLite 3 database management object in memory as the member variable <br>
- * possessed by the CEP execution object specified by the argument.<br>
+ * Get the aggregate of the column of the table.<br>
  *
- * @param[in,out] self			CEP structure object
- * @param[in] memoryDatabase	SQLite 3 database management object on memory
- * @return						CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in] self			CEP structure object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @return					Aggregate or NULL (in case of undeclared aggregate)
  */
-static M2MCEP *this_setMemoryDatabase (M2MCEP *self, sqlite3 *memoryDatabase);
+static M2MCEPAggregate *this_getAggregate (const M2MCEP *self, const M2MString *tableName, const M2MString *columnName);
 
 
 /**
- * Set a table construction object as a member variable for the argument CEP object.<br>
+ * Add the values of the records inserted into the tables of SQLite3 database <br>
+ * in memory since the last update to the aggregates.<br>
+ * Only the new records are read (rowid range search).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_updateAggregate (M2MCEP *self);
+
+
+/**
+ * Get a flag indicating whether the record window is copied into the record <br>
+ * management object besides the SQLite3 database in memory.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			true: copy is kept, false: SQLite3 database in memory is the only holder
+ */
+static bool this_getShadowRecord (const M2MCEP *self);
+
+
+/**
+ * Get a flag indicating persistence availability from the argument CEP object.<br>
  *
  * @param[in,out] self		CEP structure object
- * @param[in] tableManager	Table construction object
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @return					Flag indicating permanence
  */
-static M2MCEP *this_setTableManager (M2MCEP *self, const M2MTableManager *tableManager);
+static bool this_getPersistence (const M2MCEP *self);
 
 
 /**
- * Update the number of records for executing the vacuum on the SQLite 3 database.<br>
+ * Get the table construction object held by the CEP object as a member variable.<br>
  *
- * @param[in] self		CEP structure object
- * @param[in] count		Number of records added to the counter (> 0) or 0 (for initializing the counters)
+ * @param[in] self	CEP structure object
+ * @return			Table construction object or NULL (in case of error)
  */
-static void this_updateRecordCounter (M2MCEP *self, const unsigned int count);
+static M2MTableManager *this_getTableManager (const M2MCEP *self);
 
 
+/**
+ * Get the prepared statement cache of SQLite3 database on file.<br>
+ * If the database on file hasn't been opened yet, it is opened.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Prepared statement cache or NULL (in case of non-persistence or error)
+ */
+static M2MStatementCache *this_getFileStatementCache (M2MCEP *self);
+
 
-/*******************************************************************************
- * Private function
- ******************************************************************************/
 /**
- * For the SQLite 3 database in memory, check that the number of records in the <br>
- * table specified by the argument does not exceed the upper limit value.<br>
- * If it exceeds the upper limit value, records are deleted in the order of the <br>
- * inserted records until the number of records matches the upper limit value.<br>
+ * Get the prepared statement cache of SQLite3 database on memory.<br>
+ * If the database on memory hasn't been opened yet, it is opened.<br>
  *
- * @param[in] self		CEP structure object
- * @param[in] tableName	String indicating table name
+ * @param[in,out] self	CEP structure object
+ * @return				Prepared statement cache or NULL (in case of error)
+ */
+static M2MStatementCache *this_getMemoryStatementCache (M2MCEP *self);
+
+
+/**
+ * Get the prepared statement of the SELECT statement from the LRU cache of <br>
+ * SQLite3 database on memory, or compile and cache it (key is the SQL string).<br>
+ * Reused statements are reset and their bindings are cleared.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @return				Prepared statement owned by the SELECT statement cache or NULL (in case of error)
+ */
+static sqlite3_stmt *this_getSelectStatement (M2MCEP *self, const M2MString *sql);
+
+
+/**
+ * Bind the typed values into the parameters ("?", "?NNN", ":AAA", etc.) of <br>
+ * the prepared SELECT statement in the order of their index.<br>
+ * The number of values must equal the number of parameters of the statement.<br>
+ *
+ * @param[in] self				CEP structure object
+ * @param[in,out] statement		Prepared SELECT statement
+ * @param[in] params			Array of typed values or NULL (in case of no parameter)
+ * @param[in] numberOfParam		Number of typed values
+ * @return						true: all parameters were bound, false: failed to bind
+ */
+static bool this_bindSelectParameter (const M2MCEP *self, sqlite3_stmt *statement, const M2MCEPValue *params, const size_t numberOfParam);
+
+
+/**
+ * Give back the prepared statement got with this_getSelectStatement().<br>
+ * A read-only statement is reset and stays cached. Any other statement may <br>
+ * have changed the schema, so all cached SELECT and INSERT statements <br>
+ * (including this one) are finalized.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] statement	Prepared statement got with this_getSelectStatement()
+ */
+static void this_releaseSelectStatement (M2MCEP *self, sqlite3_stmt *statement);
+
+
+/**
+ * Release the heap memory of the window definitions held by the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
  */
-static void this_adjustMemoryDatabaseRecord (M2MCEP *self, const M2MString *tableName)
+static void this_deleteWindow (M2MCEP *self)
 	{
 	//========== Variable ==========
-	int excess = 0;
-	M2MString *sql = NULL;
-	M2MString MESSAGE[256];
-	const unsigned int MAX_RECORD = this_getMaxRecord(self);
-	const M2MDataFrame *RECORD = M2MDataFrame_begin(this_getDataFrame(self));
-	const M2MList *OLD_RECORD_LIST = M2MList_begin(M2MDataFrame_getOldRecordList(RECORD));
-	const unsigned int OLD_RECORD_LIST_LENGTH = M2MList_length((M2MList *)OLD_RECORD_LIST);
-	const M2MString *DELETE_SQL = (M2MString *)"DELETE FROM %s WHERE rowid IN (SELECT rowid FROM %s ORDER BY rowid LIMIT %u) ";
-	const size_t TABLE_NAME_LENGTH = M2MString_length(tableName);
-	const size_t DELETE_SQL_LENGTH = M2MString_length(DELETE_SQL) + TABLE_NAME_LENGTH + TABLE_NAME_LENGTH + 64;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_adjustMemoryDatabaseRecord()";
+	M2MCEPWindow *window = NULL;
+	M2MCEPWindow *next = NULL;
 
 	//===== Check argument =====
-	if (self!=NULL && tableName!=NULL && TABLE_NAME_LENGTH>0)
+	if (self!=NULL)
 		{
-		//===== Get record information =====
-		if (MAX_RECORD>0 && OLD_RECORD_LIST!=NULL && OLD_RECORD_LIST_LENGTH>0)
-			{
-			//===== When the number of records exceeds the upper limit =====
-			if ((excess=OLD_RECORD_LIST_LENGTH-MAX_RECORD)>0)
-				{
-				memset(MESSAGE, 0, sizeof(MESSAGE));
-				snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"The number of records in the \"%s\" table of the SQLite 3 database in memory exceeds the upper limit by \"%d\"", tableName, excess);
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
-				//===== Get SQLite 3 database on memory =====
-				if ((sql=(M2MString *)M2MHeap_malloc(DELETE_SQL_LENGTH+1))!=NULL)
-					{
-					//===== Create a DELETE statement =====
-					snprintf(sql, DELETE_SQL_LENGTH, DELETE_SQL, tableName, tableName, excess);
-					//===== Execute DELETE statement =====
-					if (M2MSQLite_executeUpdate(M2MCEP_getMemoryDatabase(self), sql)==true)
-						{
-						memset(MESSAGE, 0, sizeof(MESSAGE));
-						snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Deleted \"%s\" of records in \"%d\" table of SQLite3 database in memory", tableName, excess);
-						M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
-						//===== Release heap memory area of SQL string =====
-						M2MHeap_free(sql);
-						return;
-						}
-					//===== Error handling =====
-					else
-						{
-						M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to delete excess records of SQLite 3 database in memory");
-						//===== Release heap memory area of SQL string =====
-						M2MHeap_free(sql);
-						return;
-						}
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get the heap memory area for creating the DELETE statement for deleting the excess record");
-					return;
-					}
-				}
-			//===== When the number of records is within the upper limit value =====
-			else
-				{
-				memset(MESSAGE, 0, sizeof(MESSAGE));
-				snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"The current number of records in the \"%s\" table of the SQLite 3 database in memory is \"%u\"", tableName, OLD_RECORD_LIST_LENGTH);
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
-				return;
-				}
-			}
-		//===== Error handling =====
-		else if (MAX_RECORD<=0)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The upper limit value of the number of records in the SQLite 3 database on the memory set by the CEP execution object specified by the argument is 0");
-			return;
-			}
-		else if (OLD_RECORD_LIST==NULL)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The past record information object possessed by the CEP execution object specified by the argument is NULL");
-			return;
-			}
-		else
+		window = self->window;
+		//===== Repeat with window definitions =====
+		while (window!=NULL)
 			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The number of past record information objects possessed by the CEP execution object specified by the argument is 0");
-			return;
+			next = window->next;
+			M2MHeap_free(window->tableName);
+			M2MHeap_free(window->timeColumnName);
+			M2MHeap_free(window->boundarySQL);
+			M2MHeap_free(window);
+			window = next;
 			}
+		self->window = NULL;
 		}
 	//===== Argument error =====
-	else if (self==NULL)
-		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The CEP execution object specified by argument is NULL");
-		return;
-		}
-	else if (tableName==NULL)
-		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
-		return;
-		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The number of character strings in the character string indicating the table name specified by the argument is 0");
-		return;
+		// do nothing
 		}
+	return;
 	}
 
 
 /**
- * The number of inserted records is checked, and when the default value is <br>
- * reached, the vacuum process is executed.<br>
- * For the vacuum process, execute for both SQLite 3 database on memory and <br>
- * SQLite 3 database on file.<br>
+ * Give the records inserted into the tables read by the event patterns since <br>
+ * their last evaluation to the NFA of the patterns (in the order of event <br>
+ * time).<br>
+ * Only the new records matching a step are read (rowid range search).<br>
  *
  * @param[in,out] self	CEP structure object
  */
-static void this_checkRecordCounterForVacuum (M2MCEP *self)
+static void this_evaluatePattern (M2MCEP *self)
 	{
 	//========== Variable ==========
-	unsigned int vacuumRecord = 0;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_checkRecordCounterForVacuum()";
+	M2MCEPPattern *pattern = NULL;
+	M2MCEPPatternTable *table = NULL;
+	const M2MString *key = NULL;
+	int64_t lastRowid = 0;
+	bool changed = false;
+	int index = 0;
+	int result = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_evaluatePattern()";
 
-	//===== Check argument =====
-	if (self!=NULL)
+	//===== Repeat with event patterns =====
+	for (pattern=self->pattern; pattern!=NULL; pattern=pattern->next)
 		{
-		//===== Confirm the number of records to execute vacuum processing =====
-		if ((vacuumRecord=this_getVacuumRecord(self))>0)
+		//===== Bind the last rowid given to the pattern for every table =====
+		changed = false;
+		for (table=pattern->table, index=1; table!=NULL; table=table->next, index++)
 			{
-			//===== Vacuum processing is performed, when the number of records of regulations is reached =====
-			if (vacuumRecord<this_getRecordCounter(self))
+			sqlite3_bind_int64(pattern->statement, index, (sqlite3_int64)table->lastRowid);
+			if ((lastRowid=this_getTableLastRowid(self, table->tableName))!=table->lastRowid)
 				{
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start to vacuum processing on the SQLite3 database in memory");
-				//===== Vacuum the SQLite 3 database on memory =====
-				M2MSQLite_vacuum(M2MCEP_getMemoryDatabase(self));
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing was executed on the SQLite3 database in memory");
-				//===== In the case of record persistence =====
-				if (this_getPersistence(self)==true)
+				table->lastRowid = lastRowid;
+				changed = true;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		//===== Give the new records to the NFA =====
+		if (changed==true)
+			{
+			while ((result=M2MSQLite_next(pattern->statement))==SQLITE_ROW)
+				{
+				if ((key=(const M2MString *)sqlite3_column_text(pattern->statement, 1))==NULL)
 					{
-					M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start to vacuum processing on the SQLite3 database file");
-					//===== Vacuum the SQLite3 database on the file =====
-					M2MSQLite_vacuum(M2MCEP_getFileDatabase(self));
-					M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing was executed on the SQLite3 database file");
+					key = (M2MString *)"";
 					}
-				//===== In case of record non-persistence =====
 				else
 					{
 					// do nothing
 					}
-				//===== Initialize counter =====
-				this_updateRecordCounter(self, 0);
+				M2MCEPPattern_process(pattern, (unsigned int)sqlite3_column_int(pattern->statement, 0), key, (int64_t)sqlite3_column_int64(pattern->statement, 3), (int64_t)sqlite3_column_int64(pattern->statement, 2));
+				}
+			//===== Error handling =====
+			if (result!=SQLITE_DONE)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MCEP_getMemoryDatabase(self)));
 				}
-			//===== When the record number of the regulations has not been reached =====
 			else
 				{
 				// do nothing
 				}
-			return;
+			sqlite3_reset(pattern->statement);
 			}
-		//===== When vacuum processing is not executed (automatic vacuum) setting =====
+		//===== No record is inserted into the tables =====
 		else
 			{
-			return;
+			// do nothing
 			}
 		}
-	//===== Argument error =====
-	else
-		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return;
-		}
+	return;
 	}
 
 
 /**
- * Close the SQLite3 file database managed by the CEP execution object specified <br>
- * by the argument and release the heap memory area.<br>
+ * Evaluate the continuous queries reading a table which has received records <br>
+ * since their last evaluation and deliver the rows of the result to their <br>
+ * callback.<br>
  *
  * @param[in,out] self	CEP structure object
  */
-static void this_closeFileDatabase (M2MCEP *self)
+static void this_evaluateQuery (M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_closeFileDatabase()";
+	M2MCEPQuery *query = NULL;
+	M2MCEPQueryTable *table = NULL;
+	int64_t lastRowid = 0;
+	bool changed = false;
+	unsigned int i = 0;
+	int result = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_evaluateQuery()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		M2MSQLite_closeDatabase(M2MCEP_getFileDatabase(self));
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Closed SQLite3 file database");
-		}
-	//===== Argument error =====
-	else
-		{
+		//===== Repeat with continuous queries =====
+		for (query=self->query; query!=NULL; query=query->next)
+			{
+			//===== Check the tables read by the query =====
+			changed = false;
+			for (table=query->table; table!=NULL; table=table->next)
+				{
+				if ((lastRowid=this_getTableLastRowid(self, table->tableName))!=table->lastRowid)
+					{
+					table->lastRowid = lastRowid;
+					changed = true;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== Deliver the rows of the result =====
+			if (changed==true)
+				{
+				while ((result=M2MSQLite_next(query->statement))==SQLITE_ROW)
+					{
+					for (i=0; i<query->numberOfColumn; i++)
+						{
+						M2MCEPValue_setColumn(&(query->row[i]), query->statement, (int)i);
+						}
+					query->callback(query->queryID, query->row, query->numberOfColumn, query->userData);
+					}
+				//===== Error handling =====
+				if (result!=SQLITE_DONE)
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MCEP_getMemoryDatabase(self)));
+					}
+				else
+					{
+					// do nothing
+					}
+				sqlite3_reset(query->statement);
+				}
+			//===== No record is inserted into the tables =====
+			else
+				{
+				// do nothing
+				}
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Remove the values of the records evicted from the table from the aggregates <br>
+ * of the table.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] watermark		Rowid of the oldest record remaining in the table
+ */
+static void this_evictAggregate (M2MCEP *self, const M2MString *tableName, const int64_t watermark)
+	{
+	//========== Variable ==========
+	M2MCEPAggregate *aggregate = NULL;
+
+	//===== Repeat with aggregates of the table =====
+	for (aggregate=self->aggregate; aggregate!=NULL; aggregate=aggregate->next)
+		{
+		if (this_equalsName(aggregate->tableName, tableName)==true)
+			{
+			M2MCEPAggregate_evict(aggregate, watermark);
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	return;
+	}
+
+
+/**
+ * Move the records exceeding the maximum number of records of the table from <br>
+ * the SQLite3 database in memory to the SQLite3 database on file.<br>
+ * The evicted records are read back from the table in memory in rowid order, <br>
+ * inserted into the file database (in case of persistence) and then deleted <br>
+ * below the rowid watermark. Without persistence, the records are deleted <br>
+ * without being read back.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ * @param[in] maxRecord		Maximum number of records to keep in SQLite3 database table in memory
+ * @return					Number of evicted records or -1 (in case of error)
+ */
+static int this_evictMemoryDatabaseRecord (M2MCEP *self, M2MDataFrame *record, const unsigned int maxRecord);
+
+
+/**
+ * Delete the records of the table below the rowid watermark from the SQLite3 <br>
+ * database in memory with the cached DELETE statement, and add the number of <br>
+ * deleted records to the evicted record counter of the table.<br>
+ * The rowids of a table are consecutive since records are only deleted from <br>
+ * the oldest.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ * @param[in] watermark		Rowid of the oldest record to keep
+ * @return					Number of deleted records or -1 (in case of error)
+ */
+static int this_deleteMemoryDatabaseRecord (M2MCEP *self, M2MDataFrame *record, const int64_t watermark);
+
+
+/**
+ * Pop the records exceeding the maximum number of records from the oldest of <br>
+ * the record window held by the table record management object and (in case <br>
+ * of persistence) insert them into the SQLite3 database on file.<br>
+ * In case of background persistence, the popped records are handed off to the <br>
+ * persistence thread instead.<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in,out] tableRecord	Table record management object
+ * @param[in] maxRecord			Maximum number of records to keep in SQLite3 database table in memory (Execution of persistence when it becomes larger)
+ */
+static void this_insertOldRecordList (M2MCEP *self, M2MDataFrame *tableRecord, const unsigned int maxRecord);
+
+
+/**
+ * Bulk insert records into SQLite 3 database specified by argument.<br>
+ *
+ * @param[in,out] statementCache	Prepared statement cache of SQLite3 database
+ * @param[in] record				Record management object
+ * @param[in] tableManager			Table construction object
+ * @param[in] recordList			Record information object
+ * @return							Number of inserted records or -1 (in case of error)
+ */
+static int this_insertRecordList (M2MStatementCache *statementCache, const M2MDataFrame *record, M2MTableManager *tableManager, M2MList *recordList);
+
+
+/**
+ * If the specified maximum number of records is exceeded for the record of <br>
+ * "already inserted in SQLite3 database in memory" of the CEP record management <br>
+ * object held by the CEP execution object specified by the argument, the record <br>
+ * of excess Into the SQLite 3 database on the file and make it persistent.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Successful CEP execution object or NULL (in case of insertion error)
+ */
+static M2MCEP *this_insertRecordListToFileDatabase (M2MCEP *self);
+
+
+/**
+ * Insert all records (= CEPRecord-> newRecordList) held by CEP object variables <br>
+ * into SQLite3 database in memory.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of records where insert processing or -1 (in case of error)
+ */
+static int this_insertRecordListToMemoryDatabase (M2MCEP *self);
+
+
+/**
+ * Check whether the record window of the table is copied into the record <br>
+ * management object besides the SQLite3 database in memory.<br>
+ * Even if the copy is enabled, it is not available while the table holds <br>
+ * records inserted without CSV format string (the records exist only in the <br>
+ * SQLite3 database in memory) nor for the table with the column store (the <br>
+ * typed values of the evicted records are read back from the SQLite3 <br>
+ * database in memory).<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] record	Record management object of the table
+ * @return				true: copy is available, false: SQLite3 database in memory is the only holder
+ */
+static bool this_isShadowRecord (const M2MCEP *self, const M2MDataFrame *record);
+
+
+/**
+ * Insert string in CSV format into the table of SQLite 3 database for CEP. <br>
+ * The internal processing procedure is as follows.<br>
+ * <br>
+ * 1) Parse CSV string and import into a CEPRecord structure object. <br>
+ * 2) Insert record data into the table of SQLite3 memory database. <br>
+ * 3) Check the current record number of the table of SQLite3 memory database, <br>
+ *    and delete it in the oldest order if it exceeds the specified <br>
+ *    maximum value. <br>
+ * 4) Fetch the same data as the deleted record from the CEPRecord <br>
+ *    structure object and insert it into the SQLite3 database file for <br>
+ *    persistence. <br>
+ * 5) Delete excess from record data of CEPRecord structure object. <br>
+ * In group commit mode, the records are accumulated and committed later (see <br>
+ * M2MCEP_setGroupCommit()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+static int this_insertCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv);
+
+
+/**
+ * Insert typed records into the table of SQLite 3 database for CEP. <br>
+ * Unlike M2MCEP_insertCSV(), values are bound to the prepared INSERT statement <br>
+ * as they are (without formatting into or parsing from CSV format string), so <br>
+ * this is suitable for high frequency ingestion. <br>
+ * The inserted records are subject to the same record window, eviction and <br>
+ * persistence as M2MCEP_insertCSV(). Records of the table are kept only in the <br>
+ * SQLite3 database in memory (not copied into the record management object) <br>
+ * until they are evicted. <br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order (values of a row are arranged in the column order of the table definition)
+ * @param[in] rows		Number of records[row]
+ * @param[in] columns	Number of values per record (must match the number of columns of the table)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+static int this_insertRecords (M2MCEP *self, const M2MString *tableName, const M2MCEPValue *values, const size_t rows, const size_t columns);
+
+
+/**
+ * Create a SQLite 3 database file under the specified directory.<br>
+ * If creation fails, NULL is returned.<br>
+ *
+ * @param[in] databaseName	String indicating database name
+ * @param[in,out] partition	Time partitions of the history (NULL: single database file)
+ * @param[in] tableManager	Table information management object
+ * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
+ * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
+ * @param[in] incrementalVacuum	true: set incremental vacuum (vacuumRecord is ignored)
+ * @return					SQLite3 database file object or NULL (in case of error)
+ */
+static sqlite3 *this_openFileDatabase (const M2MString *databaseName, M2MCEPPartition *partition, const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord, const bool incrementalVacuum);
+
+
+/**
+ * Create a SQLite3 database on memory.<br>
+ * If creation fails, NULL is returned.<br>
+ *
+ * @param[in] tableManager	Table information management object
+ * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
+ * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
+ * @param[in] incrementalVacuum	true: set incremental vacuum (vacuumRecord is ignored)
+ * @return					SQLite3 database object or NULL (in case of error)
+ */
+static sqlite3 *this_openMemoryDatabase (const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord, const bool incrementalVacuum);
+
+
+/**
+ * Thread function of the asynchronous writer.<br>
+ * Takes CSV strings out of the queue and inserts them into the SQLite3 <br>
+ * databases until the asynchronous mode is stopped and the queue is drained.<br>
+ * While the queue is empty, the thread sleeps until a producer wakes it up.<br>
+ *
+ * @param[in,out] argument	CEP structure object
+ * @return					NULL
+ */
+static void *this_runAsyncWriter (void *argument);
+
+
+/**
+ * Execute the prepared SELECT statement and convert the result into a CSV <br>
+ * format string (the column names in the first line, the records after the <br>
+ * second line). The statement isn't reset.<br>
+ *
+ * @param[in] self			CEP structure object (used for logging)
+ * @param[in,out] statement	Prepared SELECT statement (parameters are bound)
+ * @param[out] result		CSV character string of execution result (appended in case of not NULL)
+ * @return					CSV character string of execution result or NULL (in case of no data)
+ */
+static M2MString *this_createResultCSV (const M2MCEP *self, sqlite3_stmt *statement, M2MString **result);
+
+
+/**
+ * Check whether the CSV format string includes a record line besides the <br>
+ * header line.<br>
+ *
+ * @param[in] csv	CSV format string of the SELECT result
+ * @return			true: records are included, false: only the header line or NULL
+ */
+static bool this_includesData (const M2MString *csv);
+
+
+/**
+ * Executes the SQL statement specified by the argument on the SQLite 3 database <br>
+ * in memory and returns the result as a CSV format string.<br>
+ * For the character string of the CSV format as the execution result, the <br>
+ * column name character string is the first line, and the data after the second <br>
+ * line is the data.<br>
+ * <br>
+ * [Attention!]<br>
+ * In order to execute this function, "SQLITE_ENABLE_COLUMN_METADATA" must be <br>
+ * enabled as option setting at compile time of SQLite 3.<br>
+ * This is because this function can not create a character string of CSV format <br>
+ * to be output as a result unless table information is acquired from the SELECT <br>
+ * result.<br>
+ * If "SQLITE_ENABLE_COLUMN_METADATA" is not valid, keep in mind that this <br>
+ * function will cause a compile error (because undefined functions are called).<br>
+ *
+ * @param[in] self			CEP structure object (used for database management)
+ * @param[in] sql			String indicating SQL statement
+ * @param[in] params		Array of typed values bound into the parameters of the SQL statement or NULL
+ * @param[in] numberOfParam	Number of typed values
+ * @param[out] result		CSV character string of execution result or NULL (in case of error)
+ * @return
+ */
+static M2MString *this_select (M2MCEP *self, const M2MString *sql, const M2MCEPValue *params, const size_t numberOfParam, M2MString **result);
+
+
+/**
+ * Set SQLite3 database file name of member of the CEP structure object.<br>
+ *
+ * @param[in,out] self		CEP structure object to be set SQLite3 database file name
+ * @param[in] databaseName	String indicating SQLite3 database file name
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setDatabaseName (M2MCEP *self, const M2MString *databaseName);
+
+
+/**
+ * Set indicated M2MDataFrame object into CEP structure object.<br>
+ *
+ * @param[in,out] self		CEP structure object to be set M2MDataFrame object
+ * @param[in] dataFrame		M2MDataFrame object
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setDataFrame (M2MCEP *self, M2MDataFrame *dataFrame);
+
+
+/**
+ * Set the SQLite3 file database management object as the member variable held <br>
+ * by the CEP execution object specified by the argument.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] fileDatabase	SQLite3 file database management object
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setFileDatabase (M2MCEP *self, sqlite3 *fileDatabase);
+
+
+/**
+ * Set the SQLite 3 database management object in memory as the member variable <br>
+ * possessed by the CEP execution object specified by the argument.<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in] memoryDatabase	SQLite 3 database management object on memory
+ * @return						CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setMemoryDatabase (M2MCEP *self, sqlite3 *memoryDatabase);
+
+
+/**
+ * Set a table construction object as a member variable for the argument CEP object.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] tableManager	Table construction object
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setTableManager (M2MCEP *self, const M2MTableManager *tableManager);
+
+
+/**
+ * Update the number of records for executing the vacuum on the SQLite 3 database.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] count		Number of records added to the counter (> 0) or 0 (for initializing the counters)
+ */
+static void this_updateRecordCounter (M2MCEP *self, const unsigned int count);
+
+
+/**
+ * Update the high-water mark of the queue length with the current length.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_updateMaxQueueLength (M2MCEP *self);
+
+
+/**
+ * Take a snapshot of the SQLite3 database in memory (the records accumulated <br>
+ * for group commit are committed first) and load it into the connection of <br>
+ * the read handle as a read-only database.<br>
+ *
+ * @param[in,out] reader	Read handle
+ * @return					true: the snapshot was replaced, false: failed (the previous snapshot is kept)
+ */
+static bool this_updateReaderSnapshot (M2MCEPReader *reader);
+
+
+/**
+ * Wake up the asynchronous writer thread if it is waiting for CSV strings.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_wakeUpAsyncWriter (M2MCEP *self);
+
+
+/**
+ * Insert the records accumulated in the record management object into the <br>
+ * SQLite3 database in memory (one transaction), and move the excess records <br>
+ * into the SQLite3 database on file (one transaction).<br>
+ * In group commit mode, this is called when one of the limits is reached.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Number of committed records[row] or -1 (in case of error)
+ */
+static int this_commitRecord (M2MCEP *self);
+
+
+/**
+ * Returns the time until the accumulated records must be committed.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] waitTime	Time to return when no record is accumulated[usec]
+ * @return				Time to wait[usec] (0 means the records must be committed now)
+ */
+static uint64_t this_getGroupCommitWaitTime (const M2MCEP *self, const uint64_t waitTime);
+
+
+/**
+ * Write the evicted records waiting for the next block of every column store <br>
+ * into the files.<br>
+ * Caller must hold the lock of the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_flushColumnStore (M2MCEP *self);
+
+
+/**
+ * Returns the time the asynchronous writer thread can wait for the next CSV <br>
+ * string before committing the records accumulated for group commit.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] waitTime	Maximum time to wait[usec]
+ * @return				Time to wait[usec] (0 means the records must be committed now)
+ */
+static uint64_t this_getAsyncWaitTime (M2MCEP *self, const uint64_t waitTime);
+
+
+/**
+ * Returns the time of the monotonic clock.<br>
+ *
+ * @return	Time of monotonic clock[usec]
+ */
+static uint64_t this_getMonotonicTime ();
+
+
+/**
+ * Check whether the records accumulated for group commit reach one of the <br>
+ * limits (number of records, size of CSV strings or delay).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			true: commit now, false: keep accumulating
+ */
+static bool this_isGroupCommitDue (const M2MCEP *self);
+
+
+/**
+ * Add the number of committed records to the counter and notify the commit <br>
+ * handler (if set).<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in] numberOfRecord		Number of records committed this time
+ */
+static void this_notifyCommit (M2MCEP *self, const unsigned int numberOfRecord);
+
+
+/**
+ * Create a batch of records to be handed off to the background persistence <br>
+ * thread.<br>
+ *
+ * @param[in] tableName			String indicating the table name to be inserted records
+ * @param[in] columnNameCSV		CSV format string indicating the column names of the records
+ * @param[in] numberOfColumn	Number of columns of SQLite3 values (0 in case of CSV strings)
+ * @param[in] capacity			Maximum number of records held by the batch
+ * @return						Created batch or NULL (in case of error)
+ */
+static M2MCEPPersistenceBatch *this_createPersistenceBatch (const M2MString *tableName, const M2MString *columnNameCSV, const unsigned int numberOfColumn, const unsigned int capacity);
+
+
+/**
+ * Release the heap memory of the batch (and the records held by it).<br>
+ *
+ * @param[in,out] batch	Batch to be freed of memory area
+ */
+static void this_deletePersistenceBatch (M2MCEPPersistenceBatch **batch);
+
+
+/**
+ * Hand off the batch to the background persistence thread.<br>
+ * The caller waits only while the number of in-flight records would exceed <br>
+ * the limit (backpressure). The batch is released by the persistence thread.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in,out] batch	Batch of records
+ */
+static void this_handOffPersistenceBatch (M2MCEP *self, M2MCEPPersistenceBatch *batch);
+
+
+/**
+ * Check whether background persistence is running.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				true: records are handed off to the persistence thread, false: records are inserted by the caller
+ */
+static bool this_isBackgroundPersistence (M2MCEP *self);
+
+
+/**
+ * Insert the records of the batch into the SQLite3 database on file (called <br>
+ * by the background persistence thread inside a transaction).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] batch		Batch of records
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+static int this_persistBatch (M2MCEP *self, const M2MCEPPersistenceBatch *batch);
+
+
+/**
+ * Background persistence thread which takes all handed off batches at once <br>
+ * and commits them into the SQLite3 database on file in one transaction, <br>
+ * until background persistence is stopped and the batches are drained.<br>
+ *
+ * @param[in,out] argument	CEP structure object
+ * @return					NULL
+ */
+static void *this_runPersister (void *argument);
+
+
+/**
+ * Bind the fields of the CSV format record into the prepared INSERT statement.<br>
+ *
+ * @param[in] record				CSV format string indicating one record
+ * @param[in] dataTypeArray			Array of data types of the columns
+ * @param[in] dataTypeArrayLength	Number of columns
+ * @param[in,out] statement			Prepared INSERT statement
+ * @return							true: all columns were bound, false: the number of fields does not match
+ */
+static bool this_setCSVIntoPreparedStatement (const M2MString *record, const M2MSQLiteDataType dataTypeArray[], const unsigned int dataTypeArrayLength, sqlite3_stmt *statement);
+
+
+/**
+ * Run one incremental vacuum slice on the SQLite3 database when its freelist <br>
+ * exceeds the threshold: free pages are removed step by step until the <br>
+ * freelist is empty or the time limit of the slice is exceeded.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] database	SQLite3 database in incremental vacuum mode
+ * @return					Number of removed pages
+ */
+static unsigned int this_vacuumIncrementally (M2MCEP *self, sqlite3 *database);
+
+
+/**
+ * Save a snapshot of the SQLite3 database in memory into the snapshot file.<br>
+ * The database is copied while the CEP object is locked, then the copy is <br>
+ * written into a temporary file, synchronized and renamed to the snapshot <br>
+ * file. "persisted" is recorded in the snapshot (PRAGMA user_version) so <br>
+ * that the restored records aren't inserted into the SQLite3 database on file <br>
+ * again.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] persisted		true: all records of the window are inserted into the SQLite3 database on file after this checkpoint (M2MCEP_delete())
+ * @return					true: success, false: failure (the previous snapshot is kept)
+ */
+static bool this_checkpoint (M2MCEP *self, const bool persisted);
+
+
+/**
+ * Restore the snapshot file saved by M2MCEP_checkpoint() into the SQLite3 <br>
+ * database in memory just opened, with the online backup API (one bulk copy <br>
+ * of the database pages), and set the number of records and the last rowid <br>
+ * of each restored table into the record management object.<br>
+ * If the snapshot file doesn't exist or is broken, the database stays empty.<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in,out] memoryDatabase	SQLite3 database in memory just opened
+ * @return							Number of restored records or -1 (in case of error)
+ */
+static int this_restoreMemoryDatabase (M2MCEP *self, sqlite3 *memoryDatabase);
+
+
+/**
+ * Background checkpoint thread which saves a snapshot of the SQLite3 database <br>
+ * in memory every interval until background checkpoints are stopped.<br>
+ *
+ * @param[in,out] argument	CEP structure object
+ * @return					NULL
+ */
+static void *this_runCheckpointer (void *argument);
+
+/**
+ * Record the last rowid of every table when the segment file of the <br>
+ * write-ahead log is closed.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] segment	Number of the closed segment file
+ */
+static void this_addLogMark (M2MCEP *self, const uint32_t segment);
+
+/**
+ * Close the write-ahead log at the end of the CEP object. The segment files <br>
+ * whose records have left the SQLite3 database in memory are removed and the <br>
+ * others are kept for the next start.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_closeLog (M2MCEP *self);
+
+/**
+ * Release the marks of the segment files of the write-ahead log older than <br>
+ * the indicated number.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] segment	Number of the oldest segment file whose marks are kept
+ */
+static void this_deleteLogMark (M2MCEP *self, const uint32_t segment);
+
+/**
+ * Get the record management object of the table.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Record management object of the table or NULL (in case of no record)
+ */
+static M2MDataFrame *this_getTableDataFrame (const M2MCEP *self, const M2MString *tableName);
+
+/**
+ * Check whether all records written into the segment file of the write-ahead <br>
+ * log (or before) have left the SQLite3 database in memory, that is the oldest <br>
+ * record held in memory of every table is newer than the mark.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] segment	Number of the closed segment file
+ * @return				true: the segment file can be removed, false: not yet
+ */
+static bool this_isLogSegmentRemovable (M2MCEP *self, const uint32_t segment);
+
+/**
+ * Load the sequence number of the last persisted record of the table (once) <br>
+ * and continue the numbering of the records for the write-ahead log after it.<br>
+ * The records of the window restored from the snapshot are numbered with the <br>
+ * sequence number recorded in the snapshot; those persisted after the <br>
+ * snapshot (before a crash) aren't persisted again.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ */
+static void this_loadSequence (M2MCEP *self, M2MDataFrame *record);
+
+/**
+ * Read the sequence number of the last persisted record of the table from <br>
+ * the SQLite3 database file (the newest partition file recording it in case <br>
+ * of time partitions). The files are read with a dedicated read-only <br>
+ * connection, so the thread owning the SQLite3 database on file isn't <br>
+ * disturbed.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Sequence number of the last persisted record (0 if none)
+ */
+static int64_t this_readPersistedSequence (M2MCEP *self, const M2MString *tableName);
+
+/**
+ * Handler of M2MCEPLog_replay() inserting one entry of the write-ahead log <br>
+ * into the SQLite3 database in memory (the log is detached while replaying, <br>
+ * so the entry isn't written again).<br>
+ * The records already persisted into the SQLite3 database on file before <br>
+ * the crash (numbered up to the recorded sequence number of the table) have <br>
+ * left the window then, so they are skipped.<br>
+ *
+ * @param[in] tableName		String indicating the table name
+ * @param[in] sequence		Sequence number of the first record of the entry in the table
+ * @param[in] csv			String in CSV format or NULL
+ * @param[in] values		Array of typed values or NULL
+ * @param[in] rows			Number of records of "values"
+ * @param[in] columns		Number of values per record of "values"
+ * @param[in,out] userData	CEP structure object
+ */
+static void this_replayLog (const M2MString *tableName, const int64_t sequence, const M2MString *csv, const M2MCEPValue *values, const size_t rows, const size_t columns, void *userData);
+
+/**
+ * Set the sequence numbers recorded in the snapshot into the record <br>
+ * management objects of the restored tables and drop the table of the <br>
+ * sequence numbers from the SQLite3 database in memory.<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in,out] memoryDatabase	SQLite3 database in memory just restored
+ */
+static void this_restoreSequence (M2MCEP *self, sqlite3 *memoryDatabase);
+
+/**
+ * Close the current segment file of the write-ahead log and remove the <br>
+ * segment files which are no longer needed.<br>
+ * The records accumulated for group commit are committed first so that the <br>
+ * marks of the closed segment file cover all of its records.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_rotateLog (M2MCEP *self);
+
+/**
+ * Record the sequence numbers of the tables numbered for the write-ahead log <br>
+ * into the SQLite3 database in memory to be copied into the snapshot (drop <br>
+ * the table with "drop" after the copy).<br>
+ *
+ * @param[in] self				CEP structure object
+ * @param[in,out] memoryDatabase	SQLite3 database in memory
+ * @param[in] drop				true: drop the table, false: create and fill the table
+ */
+static void this_saveSequence (M2MCEP *self, sqlite3 *memoryDatabase, const bool drop);
+
+/**
+ * Record the sequence number of the last persisted record of the table into <br>
+ * the SQLite3 database on file (call this function in the transaction <br>
+ * inserting the records, so that both are committed together).<br>
+ * The table of the sequence numbers is created on demand.<br>
+ *
+ * @param[in] self					CEP structure object
+ * @param[in,out] fileStatementCache	Prepared statement cache of SQLite3 database on file
+ * @param[in] tableName				String indicating the table name
+ * @param[in] sequence				Sequence number of the last persisted record
+ * @return							true: success, false: failure
+ */
+static bool this_setPersistedSequence (M2MCEP *self, M2MStatementCache *fileStatementCache, const M2MString *tableName, const int64_t sequence);
+
+/**
+ * Copy the CSV format string without its first records (the header line is <br>
+ * kept). Empty lines aren't counted as records.<br>
+ *
+ * @param[in] csv				String in CSV format (the first line specifies the column name as a header)
+ * @param[in] numberOfRecord	Number of records to be skipped
+ * @param[out] buffer			Buffer to store the copied string
+ * @return						Copied string or NULL (in case of no rest record)
+ */
+static M2MString *this_skipCSVRecord (const M2MString *csv, const size_t numberOfRecord, M2MString **buffer);
+
+/**
+ * Remove the segment files of the write-ahead log whose records have left the <br>
+ * SQLite3 database in memory, in the oldest order.<br>
+ * Nothing is removed while records handed off to the background persistence <br>
+ * thread aren't committed into the SQLite3 database on file.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_truncateLog (M2MCEP *self);
+
+/**
+ * Record the sequence number of the last record evicted from the table of <br>
+ * the SQLite3 database in memory as persisted, into the SQLite3 database on <br>
+ * file (in the transaction of the evicted records) or into the batch handed <br>
+ * off to the background persistence thread.<br>
+ * Nothing is recorded unless the table is numbered for the write-ahead log.<br>
+ *
+ * @param[in] self					CEP structure object
+ * @param[in,out] record			Record management object of the table (after eviction)
+ * @param[in,out] batch				Batch of the evicted records or NULL (in case of persistence by this thread)
+ * @param[in,out] fileStatementCache	Prepared statement cache of SQLite3 database on file or NULL (in case of batch)
+ */
+static void this_updatePersistedSequence (M2MCEP *self, M2MDataFrame *record, M2MCEPPersistenceBatch *batch, M2MStatementCache *fileStatementCache);
+
+/**
+ * Append the inserted records to the write-ahead log (if enabled), after <br>
+ * closing the current segment file when it's full.<br>
+ * A failure is logged and the records are inserted anyway.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] csv		String in CSV format or NULL (in case of typed values)
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order
+ * @param[in] rows		Number of records of "csv" or "values"
+ * @param[in] columns	Number of values per record of "values"
+ */
+static void this_writeLog (M2MCEP *self, const M2MString *tableName, const M2MString *csv, const M2MCEPValue *values, const size_t rows, const size_t columns);
+
+/**
+ * Open a dedicated SQLite3 connection on the history of records and attach <br>
+ * the partition files overlapping the time range (or the single SQLite3 <br>
+ * database file) read-only. Every table is a temporary view joining the <br>
+ * attached files with UNION ALL, which takes precedence over the empty table <br>
+ * created in the connection itself (answering when no file is attached).<br>
+ * With "sql", the record window of the tables read by the SELECT statement <br>
+ * (collected by preparing it before locking) is copied from SQLite3 database <br>
+ * in memory into the connection (after the records handed off to the <br>
+ * background persistence thread are committed) and joined to the views as <br>
+ * well. The CEP object is locked only while those records are copied and the <br>
+ * files are attached.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] from		Start of the time range (UNIX time)[sec]
+ * @param[in] to		End of the time range (inclusive, UNIX time)[sec]
+ * @param[in] sql		String indicating SELECT statement joining the record window or NULL (the history only)
+ * @return				SQLite3 connection on the history or NULL (in case of error)
+ */
+static sqlite3 *this_openHistoryDatabase (M2MCEP *self, const time_t from, const time_t to, const M2MString *sql);
+
+/**
+ * Copy the records of the table in SQLite3 database in memory into the table <br>
+ * with the same columns of another SQLite3 connection.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] database	SQLite3 connection to receive the records
+ * @param[in] tableName		String indicating the table name
+ * @return					Number of copied records or -1 (in case of error)
+ */
+static int this_copyTable (M2MCEP *self, sqlite3 *database, const M2MString *tableName);
+
+/**
+ * Close the SQLite3 database on file when the interval of its time partition <br>
+ * has elapsed, so that the next access opens the partition file of the <br>
+ * current time (and removes the files beyond the retention).<br>
+ * Call this function between transactions on the thread owning the SQLite3 <br>
+ * database on file.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_rotatePartition (M2MCEP *self);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Record the last rowid of every table when the segment file of the <br>
+ * write-ahead log is closed.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] segment	Number of the closed segment file
+ */
+static void this_addLogMark (M2MCEP *self, const uint32_t segment)
+	{
+	//========== Variable ==========
+	M2MDataFrame *record = NULL;
+	M2MCEPLogMark *mark = NULL;
+	M2MCEPLogMark **tail = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_addLogMark()";
+
+	//===== Move to the end of the marks =====
+	for (tail=&(self->logMark); (*tail)!=NULL; tail=&((*tail)->next))
+		{
+		}
+	//===== Repeat as many tables =====
+	for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+		{
+		//===== In case of no inserted record =====
+		if (M2MDataFrame_getTableName(record)==NULL || M2MDataFrame_getLastRowid(record)<=0)
+			{
+			// do nothing
+			}
+		else if ((mark=(M2MCEPLogMark *)M2MHeap_malloc(sizeof(M2MCEPLogMark)))!=NULL
+				&& M2MString_append(&(mark->tableName), M2MDataFrame_getTableName(record))!=NULL)
+			{
+			mark->segment = segment;
+			mark->lastRowid = M2MDataFrame_getLastRowid(record);
+			(*tail) = mark;
+			tail = &(mark->next);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MHeap_free(mark);
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the mark of the write-ahead log");
+			}
+		}
+	return;
+	}
+
+
+/**
+ * For the SQLite 3 database in memory, check that the number of records in the <br>
+ * table of the record management object does not exceed the upper limit value.<br>
+ * If it exceeds the upper limit value, the records below the rowid watermark <br>
+ * (rowid of the last inserted record - upper limit + 1) are deleted.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ * @return					Number of deleted records or -1 (in case of error)
+ */
+static int this_adjustMemoryDatabaseRecord (M2MCEP *self, M2MDataFrame *record)
+	{
+	//========== Variable ==========
+	unsigned int maxRecord = 0;
+	unsigned int windowLength = 0;
+	M2MString MESSAGE[256];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_adjustMemoryDatabaseRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL)
+		{
+		//===== Get record information =====
+		if ((maxRecord=this_getWindowLimit(self, record))>0)
+			{
+			//===== When the number of records exceeds the upper limit =====
+			if ((windowLength=M2MDataFrame_getWindowLength(record))>maxRecord)
+				{
+				memset(MESSAGE, 0, sizeof(MESSAGE));
+				snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"The number of records in the \"%s\" table of the SQLite 3 database in memory exceeds the upper limit by \"%u\"", M2MDataFrame_getTableName(record), windowLength-maxRecord);
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+				return this_deleteMemoryDatabaseRecord(self, record, M2MDataFrame_getLastRowid(record)-(int64_t)maxRecord+1);
+				}
+			//===== When the number of records is within the upper limit value =====
+			else
+				{
+				return 0;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The upper limit value of the number of records in the SQLite 3 database on the memory set by the CEP execution object specified by the argument is 0");
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The CEP execution object specified by argument is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame\" structure object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Authorizer of SQLite3 collecting the tables read by the continuous query <br>
+ * while its SELECT statement is prepared.<br>
+ *
+ * @param[in,out] userData		Continuous query
+ * @param[in] action			Action code of SQLite3
+ * @param[in] tableName			String indicating the table name (in case of SQLITE_READ)
+ * @param[in] columnName		String indicating the column name (in case of SQLITE_READ)
+ * @param[in] databaseName		String indicating the database name
+ * @param[in] triggerName		String indicating the trigger or view name
+ * @return						SQLITE_OK (the statement is always allowed)
+ */
+static int this_authorizeQuery (void *userData, int action, const char *tableName, const char *columnName, const char *databaseName, const char *triggerName)
+	{
+	//========== Variable ==========
+	M2MCEPQuery *query = NULL;
+	M2MCEPQueryTable *table = NULL;
+
+	//===== Collect the table read by the query =====
+	if (action==SQLITE_READ && tableName!=NULL && (query=(M2MCEPQuery *)userData)!=NULL)
+		{
+		//===== Search the table already collected =====
+		table = query->table;
+		while (table!=NULL && this_equalsName(table->tableName, (M2MString *)tableName)==false)
+			{
+			table = table->next;
+			}
+		//===== Add the table =====
+		if (table==NULL
+				&& (table=(M2MCEPQueryTable *)M2MHeap_malloc(sizeof(M2MCEPQueryTable)))!=NULL)
+			{
+			if (M2MString_append(&(table->tableName), (M2MString *)tableName)!=NULL)
+				{
+				table->next = query->table;
+				query->table = table;
+				}
+			else
+				{
+				M2MHeap_free(table);
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	return SQLITE_OK;
+	}
+
+
+/**
+ * Bind the typed values into the parameters ("?", "?NNN", ":AAA", etc.) of <br>
+ * the prepared SELECT statement in the order of their index.<br>
+ * The number of values must equal the number of parameters of the statement.<br>
+ *
+ * @param[in] self				CEP structure object
+ * @param[in,out] statement		Prepared SELECT statement
+ * @param[in] params			Array of typed values or NULL (in case of no parameter)
+ * @param[in] numberOfParam		Number of typed values
+ * @return						true: all parameters were bound, false: failed to bind
+ */
+static bool this_bindSelectParameter (const M2MCEP *self, sqlite3_stmt *statement, const M2MCEPValue *params, const size_t numberOfParam)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_bindSelectParameter()";
+
+	//===== Check argument =====
+	if (statement!=NULL
+			&& (params!=NULL || numberOfParam==0)
+			&& numberOfParam==(size_t)sqlite3_bind_parameter_count(statement))
+		{
+		//===== Bind the values without converting them to strings =====
+		for (i=0; i<numberOfParam; i++)
+			{
+			if (M2MCEPValue_bind(&(params[i]), (unsigned int)(i+1), statement)==false)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to bind the parameter into the prepared SELECT statement");
+				return false;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		return true;
+		}
+	//===== Argument error =====
+	else if (statement==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated prepared statement is NULL");
+		return false;
+		}
+	else if (params==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated parameter array is NULL");
+		return false;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The number of parameters doesn't match the SQL statement");
+		return false;
+		}
+	}
+
+
+/**
+ * SQL function returning the value of the aggregate declared with <br>
+ * M2MCEP_setAggregate() (table name, column name and kind of value as <br>
+ * arguments).<br>
+ *
+ * @param[in,out] context	Context of SQLite3 function (user data is the CEP object)
+ * @param[in] argc			Number of arguments (3)
+ * @param[in] argv			Arguments
+ */
+static void this_callAggregateFunction (sqlite3_context *context, int argc, sqlite3_value **argv)
+	{
+	//========== Variable ==========
+	M2MCEP *self = NULL;
+	M2MCEPAggregate *aggregate = NULL;
+	M2MCEPAggregateType type = M2MCEPAggregateType_SUM;
+	double value = 0;
+
+	//===== Search the aggregate =====
+	if (argc==3
+			&& (self=(M2MCEP *)sqlite3_user_data(context))!=NULL
+			&& (aggregate=this_getAggregate(self, (const M2MString *)sqlite3_value_text(argv[0]), (const M2MString *)sqlite3_value_text(argv[1])))!=NULL
+			&& M2MCEPAggregate_getType((const M2MString *)sqlite3_value_text(argv[2]), &type)==true)
+		{
+		//===== The undefined value of an empty window is NULL =====
+		if (isnan((value=M2MCEPAggregate_getValue(aggregate, type)))!=0)
+			{
+			sqlite3_result_null(context);
+			}
+		else if (type==M2MCEPAggregateType_COUNT)
+			{
+			sqlite3_result_int64(context, (sqlite3_int64)value);
+			}
+		else
+			{
+			sqlite3_result_double(context, value);
+			}
+		}
+	//===== Error handling =====
+	else
+		{
+		sqlite3_result_error(context, "Undeclared aggregate or unknown kind of value (use \"sum\", \"count\", \"avg\", \"min\" or \"max\")", -1);
+		}
+	return;
+	}
+
+
+/**
+ * Save a snapshot of the SQLite3 database in memory into the snapshot file.<br>
+ * The database is copied while the CEP object is locked, then the copy is <br>
+ * written into a temporary file, synchronized and renamed to the snapshot <br>
+ * file. "persisted" is recorded in the snapshot (PRAGMA user_version) so <br>
+ * that the restored records aren't inserted into the SQLite3 database on file <br>
+ * again.<br>
+ * The write-ahead log is rotated with the copy and the number of the first <br>
+ * segment file not included in the snapshot is recorded (PRAGMA <br>
+ * application_id); the older segment files are removed once the snapshot <br>
+ * file is replaced.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] persisted		true: all records of the window are inserted into the SQLite3 database on file after this checkpoint (M2MCEP_delete())
+ * @return					true: success, false: failure (the previous snapshot is kept)
+ */
+static bool this_checkpoint (M2MCEP *self, const bool persisted)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	unsigned char *snapshot = NULL;
+	sqlite3_int64 snapshotSize = 0;
+	M2MString *directoryPath = NULL;
+	M2MString *snapshotFilePath = NULL;
+	M2MString *temporaryFilePath = NULL;
+	M2MFile *file = NULL;
+	int directory = -1;
+	uint32_t logSegment = 0;
+	uint64_t startTime = 0;
+	bool result = false;
+	M2MString MESSAGE[256];
+	M2MString SQL[64];
+	const M2MString *TEMPORARY_EXTENSION = (M2MString *)".tmp";
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_checkpoint()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Only one checkpoint at a time =====
+		pthread_mutex_lock(&(self->checkpointMutex));
+		startTime = this_getMonotonicTime();
+		//===== Copy the database in memory (the CEP object is locked only while copying) =====
+		pthread_mutex_lock(&(self->lock));
+		this_commitRecord(self);
+		//===== The snapshot includes the segment files of the write-ahead log before the current one =====
+		if (self->log!=NULL)
+			{
+			this_rotateLog(self);
+			self->logSegment = M2MCEPLog_getSegment(self->log);
+			}
+		else
+			{
+			// do nothing
+			}
+		logSegment = self->logSegment;
+		memset(SQL, 0, sizeof(SQL));
+		snprintf(SQL, sizeof(SQL)-1, (M2MString *)"PRAGMA application_id = %d", (int)(int32_t)logSegment);
+		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& M2MSQLite_executeUpdate(memoryDatabase, (persisted==true) ? (M2MString *)"PRAGMA user_version = 1" : (M2MString *)"PRAGMA user_version = 0")==true
+				&& M2MSQLite_executeUpdate(memoryDatabase, SQL)==true)
+			{
+			//===== Copy the sequence numbers of the tables for the write-ahead log with the records =====
+			if (self->log!=NULL)
+				{
+				this_saveSequence(self, memoryDatabase, false);
+				snapshot = sqlite3_serialize(memoryDatabase, "main", &snapshotSize, 0);
+				this_saveSequence(self, memoryDatabase, true);
+				}
+			else
+				{
+				snapshot = sqlite3_serialize(memoryDatabase, "main", &snapshotSize, 0);
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		pthread_mutex_unlock(&(self->lock));
+		//===== Write the copy into the temporary file =====
+		if (snapshot!=NULL
+				&& this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &snapshotFilePath)!=NULL
+				&& M2MString_append(&snapshotFilePath, M2MCEP_SNAPSHOT_EXTENSION)!=NULL
+				&& M2MString_append(&temporaryFilePath, snapshotFilePath)!=NULL
+				&& M2MString_append(&temporaryFilePath, TEMPORARY_EXTENSION)!=NULL
+				&& (file=M2MFile_new(temporaryFilePath))!=NULL)
+			{
+			//===== Remove the temporary file left by a crash (the file is opened in append mode) =====
+			M2MFile_remove(file);
+			if (M2MFile_open(file)!=NULL
+					&& M2MFile_write(file, snapshot, (size_t)snapshotSize)==(size_t)snapshotSize
+					&& fsync(M2MFile_getFileDescriptor(file))==0)
+				{
+				M2MFile_close(file);
+				//===== Replace the snapshot file =====
+				if (rename(temporaryFilePath, snapshotFilePath)==0)
+					{
+					//===== Make the rename durable =====
+					if (this_getDatabaseDirectoryPath(&directoryPath)!=NULL
+							&& (directory=open(directoryPath, O_RDONLY))>=0)
+						{
+						fsync(directory);
+						close(directory);
+						}
+					else
+						{
+						// do nothing
+						}
+					//===== Remove the segment files of the write-ahead log included in the snapshot =====
+					pthread_mutex_lock(&(self->lock));
+					if (self->log!=NULL)
+						{
+						M2MCEPLog_remove(self->log, logSegment);
+						this_deleteLogMark(self, logSegment);
+						}
+					else
+						{
+						// do nothing
+						}
+					pthread_mutex_unlock(&(self->lock));
+					self->checkpoint = true;
+					atomic_store(&(self->checkpointTime), (unsigned long)(this_getMonotonicTime()-startTime));
+					memset(MESSAGE, 0, sizeof(MESSAGE));
+					snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Saved the snapshot of SQLite3 database in memory (\"%lld\" bytes) in \"%lu\" usec", (long long)snapshotSize, atomic_load(&(self->checkpointTime)));
+					M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+					result = true;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to rename the temporary file to the snapshot file");
+					}
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to write the snapshot into the temporary file");
+				M2MFile_close(file);
+				M2MFile_remove(file);
+				}
+			}
+		//===== Error handling =====
+		else if (snapshot==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to take a snapshot of SQLite3 database in memory");
+			}
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to create the temporary file of the snapshot");
+			}
+		pthread_mutex_unlock(&(self->checkpointMutex));
+		//===== Release the copy and the strings =====
+		if (file!=NULL)
+			{
+			M2MFile_delete(&file);
+			}
+		else
+			{
+			// do nothing
+			}
+		sqlite3_free(snapshot);
+		M2MHeap_free(directoryPath);
+		M2MHeap_free(temporaryFilePath);
+		M2MHeap_free(snapshotFilePath);
+		return result;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return false;
+		}
+	}
+
+
+/**
+ * The number of inserted records is checked, and when the default value is <br>
+ * reached, the vacuum process is executed.<br>
+ * For the vacuum process, execute for both SQLite 3 database on memory and <br>
+ * SQLite 3 database on file.<br>
+ * In incremental vacuum mode, the freelist is checked instead and one time <br>
+ * bounded slice is executed.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_checkRecordCounterForVacuum (M2MCEP *self)
+	{
+	//========== Variable ==========
+	unsigned int vacuumRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_checkRecordCounterForVacuum()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== In case of incremental vacuum (driven by the freelist) =====
+		if (self->incrementalVacuumPage>0)
+			{
+			this_vacuumIncrementally(self, M2MCEP_getMemoryDatabase(self));
+			//===== The persistence thread maintains the file in background persistence =====
+			if (this_getPersistence(self)==true && this_isBackgroundPersistence(self)==false)
+				{
+				this_vacuumIncrementally(self, M2MCEP_getFileDatabase(self));
+				}
+			else
+				{
+				// do nothing
+				}
+			return;
+			}
+		//===== Confirm the number of records to execute vacuum processing =====
+		else if ((vacuumRecord=this_getVacuumRecord(self))>0)
+			{
+			//===== Vacuum processing is performed, when the number of records of regulations is reached =====
+			if (vacuumRecord<this_getRecordCounter(self))
+				{
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start to vacuum processing on the SQLite3 database in memory");
+				//===== Vacuum the SQLite 3 database on memory =====
+				M2MSQLite_vacuum(M2MCEP_getMemoryDatabase(self));
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing was executed on the SQLite3 database in memory");
+				//===== In the case of record persistence =====
+				if (this_getPersistence(self)==true && this_isBackgroundPersistence(self)==true)
+					{
+					//===== Request the persistence thread owning the file =====
+					pthread_mutex_lock(&(self->persistenceMutex));
+					self->persistenceVacuum = true;
+					pthread_cond_broadcast(&(self->persistenceCondition));
+					pthread_mutex_unlock(&(self->persistenceMutex));
+					}
+				else if (this_getPersistence(self)==true)
+					{
+					M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start to vacuum processing on the SQLite3 database file");
+					//===== Vacuum the SQLite3 database on the file =====
+					M2MSQLite_vacuum(M2MCEP_getFileDatabase(self));
+					M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing was executed on the SQLite3 database file");
+					}
+				//===== In case of record non-persistence =====
+				else
+					{
+					// do nothing
+					}
+				//===== Initialize counter =====
+				this_updateRecordCounter(self, 0);
+				}
+			//===== When the record number of the regulations has not been reached =====
+			else
+				{
+				// do nothing
+				}
+			return;
+			}
+		//===== When vacuum processing is not executed (automatic vacuum) setting =====
+		else
+			{
+			return;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return;
+		}
+	}
+
+
+/**
+ * Close the SQLite3 file database managed by the CEP execution object specified <br>
+ * by the argument and release the heap memory area.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_closeFileDatabase (M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_closeFileDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Finalize cached prepared statements before closing =====
+		if (self->fileStatementCache!=NULL)
+			{
+			M2MStatementCache_delete(&(self->fileStatementCache));
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== In the case of opened file database =====
+		if (self->fileDatabase!=NULL)
+			{
+			M2MSQLite_closeDatabase(self->fileDatabase);
+			self->fileDatabase = NULL;
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Closed SQLite3 file database");
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Close the write-ahead log at the end of the CEP object. The segment files <br>
+ * whose records have left the SQLite3 database in memory are removed and the <br>
+ * others are kept for the next start.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_closeLog (M2MCEP *self)
+	{
+	//===== Check the log =====
+	if (self->log!=NULL)
+		{
+		this_rotateLog(self);
+		M2MCEPLog_delete(&(self->log));
+		this_deleteLogMark(self, UINT32_MAX);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Exit the SQLite 3 memory database managed by the CEP execution object <br>
+ * specified by the argument and release the heap memory area.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_closeMemoryDatabase (M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_closeMemoryDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Finalize cached prepared statements before closing =====
+		if (self->memoryStatementCache!=NULL)
+			{
+			M2MStatementCache_delete(&(self->memoryStatementCache));
+			}
+		else
+			{
+			// do nothing
+			}
+		if (self->selectStatementCache!=NULL)
+			{
+			M2MStatementCache_delete(&(self->selectStatementCache));
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== In the case of opened memory database =====
+		if (self->memoryDatabase!=NULL)
+			{
+			M2MSQLite_closeDatabase(self->memoryDatabase);
+			self->memoryDatabase = NULL;
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Closed SQLite3 memory database");
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== Argument error =====
+	else
+		{
 		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" object is NULL");
 		}
 	return;
@@ -426,2257 +1945,8762 @@ static void this_closeFileDatabase (M2MCEP *self)
 
 
 /**
- * Exit the SQLite 3 memory database managed by the CEP execution object <br>
- * specified by the argument and release the heap memory area.<br>
+ * Insert the records accumulated in the record management object into the <br>
+ * SQLite3 database in memory (one transaction), and move the excess records <br>
+ * into the SQLite3 database on file (one transaction).<br>
+ * In group commit mode, this is called when one of the limits is reached.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Number of committed records[row] or -1 (in case of error)
+ */
+static int this_commitRecord (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MDataFrame *record = NULL;
+	int numberOfRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_commitRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== In case of no accumulated record =====
+		if (self->pendingRecord==0)
+			{
+			return 0;
+			}
+		//===== In case of accumulated records =====
+		else
+			{
+			self->pendingRecord = 0;
+			self->pendingByte = 0;
+			}
+		//===== Insert record into SQLite3 memory database =====
+		if ((numberOfRecord=this_insertRecordListToMemoryDatabase(self))>=0)
+			{
+			//===== Update record counters for vacuum processing =====
+			this_updateRecordCounter(self, numberOfRecord);
+			//===== Add the inserted records to the aggregates =====
+			this_updateAggregate(self);
+			//===== Give the inserted records to the event patterns before eviction =====
+			this_evaluatePattern(self);
+			//===== Adjust the number of records of every table in SQLite3 database in memory =====
+			for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+				{
+				if (this_isShadowRecord(self, record)==true)
+					{
+					this_adjustMemoryDatabaseRecord(self, record);
+					}
+				//===== Excess records are read back from SQLite3 database in memory later =====
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== Notify the committed records =====
+			this_notifyCommit(self, numberOfRecord);
+			//===== Insert record into SQLite3 database file for persistence =====
+			if (this_insertRecordListToFileDatabase(self)!=NULL)
+				{
+				//===== Evaluate continuous queries over the updated window =====
+				this_evaluateQuery(self);
+				//===== Execute vacuum processing to SQLite3 databases =====
+				this_checkRecordCounterForVacuum(self);
+				//===== Return number of records =====
+				return numberOfRecord;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite3 database on file");
+				return -1;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite 3 database in memory");
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Create a CSV format string of all column names of the table.<br>
+ * The caller must release the heap memory of the created string.<br>
+ *
+ * @param[in] columnList		Column structure object of the table
+ * @param[out] columnNameCSV	Buffer to copy the created CSV string
+ * @return						CSV format string indicating all column names or NULL (in case of error)
+ */
+static M2MString *this_createColumnNameCSV (M2MColumnList *columnList, M2MString **columnNameCSV)
+	{
+	//========== Variable ==========
+	M2MColumn *column = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_createColumnNameCSV()";
+
+	//===== Check argument =====
+	if ((columnList=M2MColumnList_begin(columnList))!=NULL && columnNameCSV!=NULL)
+		{
+		//===== Repeat until reaching the end node =====
+		while (columnList!=NULL)
+			{
+			//===== Add column name =====
+			if ((column=M2MColumnList_getColumn(columnList))!=NULL)
+				{
+				//===== Add "," character except for the first column =====
+				if ((*columnNameCSV)!=NULL)
+					{
+					M2MString_append(columnNameCSV, (M2MString *)M2MString_COMMA);
+					}
+				//===== In case of the first column =====
+				else
+					{
+					// do nothing
+					}
+				M2MString_append(columnNameCSV, M2MColumn_getName(column));
+				}
+			//===== When column is not set yet =====
+			else
+				{
+				// do nothing
+				}
+			columnList = M2MColumnList_next(columnList);
+			}
+		return (*columnNameCSV);
+		}
+	//===== Argument error =====
+	else if (columnList==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MColumnList\" object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated buffer for CSV string is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Create a new INSERT statement for the prepared statement.<br>
+ *
+ * @param[in] tableName			String indicating table name
+ * @param[in] columnNameCSV		CSV format string indicating column name
+ * @param[in] columnListLength	An integer indicating the number of columns
+ * @param[out] sql				Pointer to copy the newly created INSERT statement (buffering is executed inside the function)
+ * @return						Pointer of newly created INSERT statement or NULL (in case of error)
+ */
+static M2MString *this_createInsertSQL (const M2MString *tableName, const M2MString *columnNameCSV, unsigned int columnListLength, M2MString **sql)
+	{
+	//========== Variable ==========
+	unsigned int i = 0;
+	unsigned int index = 0;
+	size_t sqlLength = 0;
+	const M2MString *INSERT_SQL = (M2MString *)"INSERT INTO %s (%s) VALUES (%s) ";
+	const size_t QUESTION_MARK_LENGTH = M2MString_length((M2MString *)M2MString_QUESTION_MARK);
+	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
+	const size_t PARAMETER_LENGTH = columnListLength * (QUESTION_MARK_LENGTH + COMMA_LENGTH);
+	M2MString PARAMETER[PARAMETER_LENGTH];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_createInsertSQL()";
+
+	//===== Check argument =====
+	if (tableName!=NULL && columnNameCSV!=NULL && columnListLength>0 && sql!=NULL)
+		{
+		//===== Initialize array =====
+		memset(PARAMETER, 0, PARAMETER_LENGTH);
+		//===== Repeat as many columns =====
+		for (i=0; i<columnListLength; i++)
+			{
+			//===== In the first case =====
+			if (i==0)
+				{
+				//===== Add "?" character =====
+				memcpy(&(PARAMETER[index]), (M2MString *)M2MString_QUESTION_MARK, QUESTION_MARK_LENGTH);
+				index++;
+				}
+			//===== In the case of 2nd and subsequent cases =====
+			else
+				{
+				//===== Add "," character =====
+				memcpy(&(PARAMETER[index]), (M2MString *)M2MString_COMMA, COMMA_LENGTH);
+				index++;
+				//===== Add "?" character =====
+				memcpy(&(PARAMETER[index]), (M2MString *)M2MString_QUESTION_MARK, QUESTION_MARK_LENGTH);
+				index++;
+				}
+			}
+		//===== Get a heap memory area for creating a new INSERT statement =====
+		if ((sqlLength=M2MString_length(INSERT_SQL)+M2MString_length(tableName)+M2MString_length(columnNameCSV)+M2MString_length(PARAMETER))>0
+				&& ((*sql)=(M2MString *)M2MHeap_malloc(sqlLength+1))!=NULL)
+			{
+			//===== Create a new INSERT statement =====
+			if (snprintf((*sql), sqlLength, INSERT_SQL, tableName, columnNameCSV, PARAMETER)>0)
+				{
+				//===== Return INSERT string =====
+				return (*sql);
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to create new INSERT statement");
+				//===== When the heap memory area of the INSERT statement still remains =====
+				if ((*sql)!=NULL)
+					{
+					//===== Release heap memory area =====
+					M2MHeap_free((*sql));
+					}
+				//===== When the heap memory area of the INSERT statement does not exist =====
+				else
+					{
+					// do nothing
+					}
+				return NULL;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to get heap memory area to create new INSERT statement");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (tableName==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
+		return NULL;
+		}
+	else if (columnNameCSV==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The CSV format string indicating the column name specified by the argument is NULL");
+		return NULL;
+		}
+	else if (columnListLength<=0)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! An integer indicating the number of columns specified by the argument is 0 or less");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The pointer to copy the INSERT statement specified by the argument is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Copy the records of the table in SQLite3 database in memory into the table <br>
+ * with the same columns of another SQLite3 connection.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] database	SQLite3 connection to receive the records
+ * @param[in] tableName		String indicating the table name
+ * @return					Number of copied records or -1 (in case of error)
+ */
+static int this_copyTable (M2MCEP *self, sqlite3 *database, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	sqlite3_stmt *selectStatement = NULL;
+	sqlite3_stmt *insertStatement = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MString *columnNameCSV = NULL;
+	M2MString *selectSQL = NULL;
+	M2MString *insertSQL = NULL;
+	int numberOfRecord = 0;
+	int columnCount = 0;
+	int i = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_copyTable()";
+
+	//===== Check argument =====
+	if (self!=NULL && database!=NULL && tableName!=NULL)
+		{
+		//===== Prepare SELECT statement of the window and INSERT statement of the connection =====
+		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), tableName)))!=NULL
+				&& this_createColumnNameCSV(columnList, &columnNameCSV)!=NULL
+				&& M2MString_append(&selectSQL, (M2MString *)"SELECT ")!=NULL
+				&& M2MString_append(&selectSQL, columnNameCSV)!=NULL
+				&& M2MString_append(&selectSQL, (M2MString *)" FROM ")!=NULL
+				&& M2MString_append(&selectSQL, tableName)!=NULL
+				&& (selectStatement=M2MSQLite_getPreparedStatement(memoryDatabase, selectSQL))!=NULL
+				&& this_createInsertSQL(tableName, columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
+				&& (insertStatement=M2MSQLite_getPreparedStatement(database, insertSQL))!=NULL)
+			{
+			//===== Copy the records =====
+			columnCount = sqlite3_column_count(selectStatement);
+			while (M2MSQLite_next(selectStatement)==SQLITE_ROW)
+				{
+				for (i=0; i<columnCount; i++)
+					{
+					sqlite3_bind_value(insertStatement, i+1, sqlite3_column_value(selectStatement, i));
+					}
+				if (M2MSQLite_next(insertStatement)==SQLITE_DONE)
+					{
+					numberOfRecord++;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(database));
+					}
+				sqlite3_reset(insertStatement);
+				}
+			M2MSQLite_closeStatement(insertStatement);
+			M2MSQLite_closeStatement(selectStatement);
+			M2MHeap_free(insertSQL);
+			M2MHeap_free(selectSQL);
+			M2MHeap_free(columnNameCSV);
+			return numberOfRecord;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare the statements for copying the records of the table");
+			M2MSQLite_closeStatement(selectStatement);
+			M2MHeap_free(insertSQL);
+			M2MHeap_free(selectSQL);
+			M2MHeap_free(columnNameCSV);
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object, SQLite3 connection or table name is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Create a batch of records to be handed off to the background persistence <br>
+ * thread.<br>
+ *
+ * @param[in] tableName			String indicating the table name to be inserted records
+ * @param[in] columnNameCSV		CSV format string indicating the column names of the records
+ * @param[in] numberOfColumn	Number of columns of SQLite3 values (0 in case of CSV strings)
+ * @param[in] capacity			Maximum number of records held by the batch
+ * @return						Created batch or NULL (in case of error)
+ */
+static M2MCEPPersistenceBatch *this_createPersistenceBatch (const M2MString *tableName, const M2MString *columnNameCSV, const unsigned int numberOfColumn, const unsigned int capacity)
+	{
+	//========== Variable ==========
+	M2MCEPPersistenceBatch *batch = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_createPersistenceBatch()";
+
+	//===== Check argument =====
+	if (tableName!=NULL && columnNameCSV!=NULL && capacity>0)
+		{
+		//===== Get heap memory of the batch =====
+		if ((batch=(M2MCEPPersistenceBatch *)M2MHeap_malloc(sizeof(M2MCEPPersistenceBatch)))!=NULL
+				&& M2MString_append(&(batch->tableName), tableName)!=NULL
+				&& M2MString_append(&(batch->columnNameCSV), columnNameCSV)!=NULL
+				&& ((numberOfColumn==0 && (batch->csv=(M2MString **)M2MHeap_malloc(sizeof(M2MString *) * capacity))!=NULL)
+					|| (numberOfColumn>0 && (batch->value=(sqlite3_value **)M2MHeap_malloc(sizeof(sqlite3_value *) * capacity * numberOfColumn))!=NULL)))
+			{
+			batch->numberOfColumn = numberOfColumn;
+			batch->sequence = -1;
+			return batch;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to get heap memory for the batch of background persistence");
+			this_deletePersistenceBatch(&batch);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (tableName==NULL || columnNameCSV==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name or column names string is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated capacity of the batch is 0");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Execute the prepared SELECT statement and convert the result into a CSV <br>
+ * format string (the column names in the first line, the records after the <br>
+ * second line). The statement isn't reset.<br>
+ *
+ * @param[in] self			CEP structure object (used for logging)
+ * @param[in,out] statement	Prepared SELECT statement (parameters are bound)
+ * @param[out] result		CSV character string of execution result (appended in case of not NULL)
+ * @return					CSV character string of execution result or NULL (in case of no data)
+ */
+static M2MString *this_createResultCSV (const M2MCEP *self, sqlite3_stmt *statement, M2MString **result)
+	{
+	//========== Variable ==========
+	int resultCode = 0;
+	int columnLength = -1;
+	int i = 0;
+	bool thisIsHeader = true;
+	M2MString *columnName = NULL;
+	size_t columnNameLength = 0;
+	M2MString *data = NULL;
+	size_t dataLength = 0;
+	int sqliteColumnType = 0;
+	M2MStringBuilder builder;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_createResultCSV()";
+
+	//===== Initialize buffer of the result (amortized O(1) per byte) =====
+	M2MStringBuilder_init(&builder);
+	//===== Execute SQL (repeat until the result row reaches the end) =====
+	while ((resultCode=sqlite3_step(statement))==SQLITE_ROW)
+		{
+		//===== When the number of columns of the SELECT result has not been acquired yet =====
+		if (columnLength<0)
+			{
+			//===== Get number of columns of SELECT result =====
+			columnLength = sqlite3_column_count(statement);
+			}
+		//===== When acquiring the number of columns of the SELECT result =====
+		else
+			{
+			// do nothing
+			}
+		//===== When header line is not output =====
+		if (thisIsHeader==true)
+			{
+			//===== Repeat by number of columns =====
+			for (i=0; i<columnLength; i++)
+				{
+				//===== (Reference code :) Get the original table name (UTF-8) which is not an alias =====
+//						sqlite3_column_table_name(statement, 1);
+				//===== Get the original column name (UTF-8) which is not an alias =====
+				if ((columnName=(M2MString *)sqlite3_column_origin_name(statement, i))!=NULL
+						&& (columnNameLength=M2MString_length(columnName))>0)
+					{
+					//===== In case of 1st time =====
+					if (i==0)
+						{
+						// do nothing
+						}
+					//===== In case of the 2nd and subsequent times =====
+					else
+						{
+						//===== Add comma character =====
+						M2MStringBuilder_appendCharacter(&builder, (M2MString)',');
+						}
+					//===== Add column name =====
+					M2MStringBuilder_appendLength(&builder, columnName, columnNameLength);
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get character string indicating column name from SELECT result");
+					}
+				}
+			//===== Add line feed code =====
+			M2MStringBuilder_appendLength(&builder, M2MString_CRLF, 2);
+			//===== Reduce header line output flag =====
+			thisIsHeader = false;
+			}
+		//===== When header line has already been output =====
+		else
+			{
+			// do nothing
+			}
+		//===== Repeat the output of SELECT result data by the number of columns =====
+		for (i=0; i<columnLength; i++)
+			{
+			//===== In case of 1st time =====
+			if (i==0)
+				{
+				// do nothing
+				}
+			//===== In case of the 2nd and subsequent times =====
+			else
+				{
+				//===== Add comma character =====
+				M2MStringBuilder_appendCharacter(&builder, (M2MString)',');
+				}
+			//===== When the data type of the SELECT result column is an integer =====
+			if ((sqliteColumnType=sqlite3_column_type(statement, i))==SQLITE_INTEGER)
+				{
+				//===== Append integer data string (without temporary string) =====
+				if (M2MStringBuilder_appendSignedLong(&builder, (int64_t)sqlite3_column_int64(statement, i))!=NULL)
+					{
+					// do nothing
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to convert Integer data of SELECT result to character string");
+					}
+				}
+			//===== When the data type of the SELECT result column is a floating point number =====
+			else if (sqliteColumnType==SQLITE_FLOAT)
+				{
+				//===== Append real number data string (without temporary string) =====
+				if (M2MStringBuilder_appendDouble(&builder, sqlite3_column_double(statement, i))!=NULL)
+					{
+					// do nothing
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to convert Floating point number data of SELECT result to character string");
+					}
+				}
+			//===== When the data type of the SELECT result column is a character string =====
+			else if (sqliteColumnType==SQLITE_TEXT)
+				{
+				if ((data=(M2MString *)sqlite3_column_text(statement, i))!=NULL)
+					{
+					//===== Add character string =====
+					M2MStringBuilder_appendLength(&builder, data, (size_t)sqlite3_column_bytes(statement, i));
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get character string data of SELECT result");
+					}
+				}
+			//===== When the data type of the SELECT result column is byte data =====
+			else if (sqliteColumnType==SQLITE_BLOB)
+				{
+				if ((dataLength=(size_t)sqlite3_column_bytes(statement, i))>0
+						&& M2MBase64_encode(sqlite3_column_blob(statement, i), dataLength, &data, false)!=NULL)
+					{
+					//===== Added character string obtained by converting byte data to base64 =====
+					M2MStringBuilder_append(&builder, data);
+					//===== Release heap memory area of data string =====
+					M2MHeap_free(data);
+					}
+				//===== Error handling =====
+				else if (dataLength<=0)
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(sqlite3_db_handle(statement)));
+					}
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(sqlite3_db_handle(statement)));
+					}
+				}
+			//===== When the data type of the SELECT result column is NULL =====
+			else if (sqliteColumnType==SQLITE_NULL)
+				{
+				M2MStringBuilder_appendLength(&builder, (M2MString *)"NULL", 4);
+				}
+			//===== In other cases =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite internal error! (The data type of the SELECT result differs from the value of the rule)");
+				}
+			}
+		//===== Add line feed code =====
+		M2MStringBuilder_appendLength(&builder, M2MString_CRLF, 2);
+		}
+	//===== Hand over the buffer of the result =====
+	if ((*result)==NULL)
+		{
+		(*result) = M2MStringBuilder_detach(&builder);
+		}
+	else if (M2MStringBuilder_getLength(&builder)>0)
+		{
+		M2MString_appendLength(result, M2MStringBuilder_getString(&builder), M2MStringBuilder_getLength(&builder));
+		}
+	else
+		{
+		// do nothing
+		}
+	M2MStringBuilder_release(&builder);
+	//===== When data is included in the execution result =====
+	if (this_includesData((*result))==true)
+		{
+		//===== Return the execution result as it is =====
+		return (*result);
+		}
+	//===== When data is not included in the execution result =====
+	else
+		{
+		//===== Release heap memory area of result =====
+		M2MHeap_free((*result));
+		return NULL;
+		}
+	}
+
+
+/**
+ * Releases the heap memory of the database name possessed by the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_deleteDatabaseName (M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_deleteDatabaseName()";
+
+	//===== Check argument =====
+	if (self!=NULL && M2MCEP_getDatabaseName(self)!=NULL)
+		{
+		M2MHeap_free(self->databaseName);
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Deleted string indicating SQLite3 database file name");
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		}
+	else
+		{
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite3 database file name hasn't been set yet");
+		}
+	return;
+	}
+
+
+/**
+ * Releases the heap memory area of the logging object held by the argument CEP.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_deleteLogger (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MFileAppender *logger = NULL;
+
+	//===== Check argument =====
+	if (self!=NULL && (logger=M2MCEP_getLogger(self))!=NULL)
+		{
+		M2MFileAppender_delete(&logger);
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		}
+	else
+		{
+		}
+	return;
+	}
+
+
+/**
+ * Release the marks of the segment files of the write-ahead log older than <br>
+ * the indicated number.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] segment	Number of the oldest segment file whose marks are kept
+ */
+static void this_deleteLogMark (M2MCEP *self, const uint32_t segment)
+	{
+	//========== Variable ==========
+	M2MCEPLogMark *mark = NULL;
+
+	//===== The marks are arranged in the order of the segments =====
+	while (self->logMark!=NULL && self->logMark->segment<segment)
+		{
+		mark = self->logMark;
+		self->logMark = mark->next;
+		M2MHeap_free(mark->tableName);
+		M2MHeap_free(mark);
+		}
+	return;
+	}
+
+
+/**
+ * Delete the records of the table below the rowid watermark from the SQLite3 <br>
+ * database in memory with the cached DELETE statement, and add the number of <br>
+ * deleted records to the evicted record counter of the table.<br>
+ * The rowids of a table are consecutive since records are only deleted from <br>
+ * the oldest.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ * @param[in] watermark		Rowid of the oldest record to keep
+ * @return					Number of deleted records or -1 (in case of error)
+ */
+static int this_deleteMemoryDatabaseRecord (M2MCEP *self, M2MDataFrame *record, const int64_t watermark)
+	{
+	//========== Variable ==========
+	M2MStatementCache *memoryStatementCache = NULL;
+	sqlite3_stmt *statement = NULL;
+	M2MString *evictSQL = NULL;
+	int numberOfRecord = 0;
+	M2MString MESSAGE[256];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_deleteMemoryDatabaseRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL)
+		{
+		//===== Get the cached DELETE statement =====
+		if ((memoryStatementCache=this_getMemoryStatementCache(self))!=NULL
+				&& (evictSQL=M2MDataFrame_getEvictSQL(record))!=NULL
+				&& ((statement=M2MStatementCache_search(memoryStatementCache, evictSQL, NULL))!=NULL
+					|| (statement=M2MStatementCache_put(memoryStatementCache, evictSQL, NULL, evictSQL))!=NULL))
+			{
+			//===== Delete the records below the watermark =====
+			sqlite3_bind_int64(statement, 1, (sqlite3_int64)watermark);
+			if (M2MSQLite_next(statement)==SQLITE_DONE)
+				{
+				numberOfRecord = sqlite3_changes(M2MStatementCache_getDatabase(memoryStatementCache));
+				M2MDataFrame_setEvictedRecordCount(record, M2MDataFrame_getEvictedRecordCount(record)+numberOfRecord);
+				this_evictAggregate(self, M2MDataFrame_getTableName(record), watermark);
+				memset(MESSAGE, 0, sizeof(MESSAGE));
+				snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Evicted \"%d\" records of \"%s\" table from SQLite3 database in memory", numberOfRecord, M2MDataFrame_getTableName(record));
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(memoryStatementCache)));
+				numberOfRecord = -1;
+				}
+			sqlite3_reset(statement);
+			return numberOfRecord;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare DELETE statement for evicting records from SQLite 3 database in memory");
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame\" structure object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Release the heap memory of the batch (and the records held by it).<br>
+ *
+ * @param[in,out] batch	Batch to be freed of memory area
+ */
+static void this_deletePersistenceBatch (M2MCEPPersistenceBatch **batch)
+	{
+	//========== Variable ==========
+	unsigned int i = 0;
+
+	//===== Check argument =====
+	if (batch!=NULL && (*batch)!=NULL)
+		{
+		//===== Release CSV strings =====
+		if ((*batch)->csv!=NULL)
+			{
+			for (i=0; i<(*batch)->numberOfRecord; i++)
+				{
+				M2MHeap_free((*batch)->csv[i]);
+				}
+			M2MHeap_free((*batch)->csv);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Release SQLite3 values =====
+		if ((*batch)->value!=NULL)
+			{
+			for (i=0; i<(*batch)->numberOfRecord*(*batch)->numberOfColumn; i++)
+				{
+				sqlite3_value_free((*batch)->value[i]);
+				}
+			M2MHeap_free((*batch)->value);
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MHeap_free((*batch)->columnNameCSV);
+		M2MHeap_free((*batch)->tableName);
+		M2MHeap_free((*batch));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Finalize the prepared statement of the continuous query and release the <br>
+ * heap memory of it.<br>
+ *
+ * @param[in,out] query	Continuous query to be freed of memory area
+ */
+static void this_deleteQuery (M2MCEPQuery **query)
+	{
+	//========== Variable ==========
+	M2MCEPQueryTable *table = NULL;
+	M2MCEPQueryTable *next = NULL;
+
+	//===== Check argument =====
+	if (query!=NULL && (*query)!=NULL)
+		{
+		//===== Finalize prepared statement =====
+		if ((*query)->statement!=NULL)
+			{
+			sqlite3_finalize((*query)->statement);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Release the tables read by the query =====
+		table = (*query)->table;
+		while (table!=NULL)
+			{
+			next = table->next;
+			M2MHeap_free(table->tableName);
+			M2MHeap_free(table);
+			table = next;
+			}
+		M2MHeap_free((*query)->row);
+		M2MHeap_free((*query));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Releases the heap memory area of the table building object held by the CEP <br>
+ * execution object specified by the argument as a member variable.<br>
+ * Be aware that after invoking the method, you can not access the table <br>
+ * building object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_deleteTableManager (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MTableManager *tableManager = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_deleteTableManager()";
+
+	//===== Check argument =====
+	if (self!=NULL && (tableManager=this_getTableManager(self))!=NULL)
+		{
+		M2MTableManager_delete(&tableManager);
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		}
+	else
+		{
+		}
+	return;
+	}
+
+
+/**
+ * Check whether the two names (of table or column) are equal.<br>
+ * M2MString_compareTo() compares the length of the second string only, so <br>
+ * the lengths are compared first not to match a name beginning with the other.<br>
+ *
+ * @param[in] one		String indicating a name
+ * @param[in] another	String indicating another name
+ * @return				true: the names are equal, false: the names are different (or NULL)
+ */
+static bool this_equalsName (const M2MString *one, const M2MString *another)
+	{
+	//===== Check argument =====
+	if (one!=NULL && another!=NULL)
+		{
+		//===== Compare the lengths before the characters =====
+		if (M2MString_length(one)==M2MString_length(another)
+				&& M2MString_compareTo(one, another)==0)
+			{
+			return true;
+			}
+		else
+			{
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Move the records exceeding the maximum number of records of the table from <br>
+ * the SQLite3 database in memory to the SQLite3 database on file.<br>
+ * The evicted records are read back from the table in memory in rowid order, <br>
+ * inserted into the file database (in case of persistence) and then deleted <br>
+ * below the rowid watermark. Without persistence, the records are deleted <br>
+ * without being read back.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ * @param[in] maxRecord		Maximum number of records to keep in SQLite3 database table in memory
+ * @return					Number of evicted records or -1 (in case of error)
+ */
+static int this_evictMemoryDatabaseRecord (M2MCEP *self, M2MDataFrame *record, const unsigned int maxRecord)
+	{
+	//========== Variable ==========
+	M2MStatementCache *memoryStatementCache = NULL;
+	M2MStatementCache *fileStatementCache = NULL;
+	sqlite3_stmt *selectStatement = NULL;
+	sqlite3_stmt *insertStatement = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MCEPPersistenceBatch *batch = NULL;
+	M2MCEPColumnStore *columnStore = NULL;
+	M2MCEPValue *values = NULL;
+	M2MString *tableName = NULL;
+	M2MString *columnNameCSV = NULL;
+	M2MString *selectSQL = NULL;
+	M2MString *insertSQL = NULL;
+	sqlite3_int64 rowid = 0;
+	unsigned int windowLength = 0;
+	int numberOfRecord = 0;
+	int columnCount = 0;
+	int i = 0;
+	bool persistence = false;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_evictMemoryDatabaseRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL && (tableName=M2MDataFrame_getTableName(record))!=NULL)
+		{
+		//===== When the number of records is within the upper limit value =====
+		if ((windowLength=M2MDataFrame_getWindowLength(record))<=maxRecord)
+			{
+			return 0;
+			}
+		//===== In case of record non-persistence (delete below the watermark without reading back) =====
+		else if ((persistence=this_getPersistence(self))==false)
+			{
+			if ((numberOfRecord=this_deleteMemoryDatabaseRecord(self, record, M2MDataFrame_getLastRowid(record)-(int64_t)maxRecord+1))>0)
+				{
+				M2MDataFrame_setWindowLength(record, windowLength-numberOfRecord);
+				}
+			else
+				{
+				// do nothing
+				}
+			return numberOfRecord;
+			}
+		//===== When the number of records exceeds the upper limit =====
+		else
+			{
+			self->evictionTime = time(NULL);
+			}
+		//===== Create SELECT statement for the oldest records =====
+		if ((memoryStatementCache=this_getMemoryStatementCache(self))!=NULL
+				&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), tableName)))!=NULL
+				&& this_createColumnNameCSV(columnList, &columnNameCSV)!=NULL
+				&& M2MString_append(&selectSQL, (M2MString *)"SELECT rowid, ")!=NULL
+				&& M2MString_append(&selectSQL, columnNameCSV)!=NULL
+				&& M2MString_append(&selectSQL, (M2MString *)" FROM ")!=NULL
+				&& M2MString_append(&selectSQL, tableName)!=NULL
+				&& M2MString_append(&selectSQL, (M2MString *)" ORDER BY rowid LIMIT ? ")!=NULL
+				&& ((selectStatement=M2MStatementCache_search(memoryStatementCache, selectSQL, NULL))!=NULL
+					|| (selectStatement=M2MStatementCache_put(memoryStatementCache, selectSQL, NULL, selectSQL))!=NULL))
+			{
+			//===== In case of the column store (written by this thread) =====
+			if ((columnStore=this_getColumnStore(self, tableName))!=NULL)
+				{
+				//===== Prepare the typed values of one record =====
+				if ((values=(M2MCEPValue *)M2MHeap_calloc(M2MColumnList_length(columnList), sizeof(M2MCEPValue)))!=NULL)
+					{
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the evicted records of the column store");
+					M2MHeap_free(selectSQL);
+					M2MHeap_free(columnNameCSV);
+					return -1;
+					}
+				}
+			//===== In case of background persistence =====
+			else if (this_isBackgroundPersistence(self)==true)
+				{
+				//===== Prepare a batch for copies of the records =====
+				if ((batch=this_createPersistenceBatch(tableName, columnNameCSV, M2MColumnList_length(columnList), windowLength-maxRecord))!=NULL)
+					{
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to create a batch of evicted records for background persistence");
+					M2MHeap_free(selectSQL);
+					M2MHeap_free(columnNameCSV);
+					return -1;
+					}
+				}
+			//===== In the case of record persistence =====
+			else
+				{
+				//===== Get INSERT statement of SQLite3 database on file =====
+				if ((fileStatementCache=this_getFileStatementCache(self))!=NULL
+						&& ((insertStatement=M2MStatementCache_search(fileStatementCache, tableName, columnNameCSV))!=NULL
+							|| (this_createInsertSQL(tableName, columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
+								&& (insertStatement=M2MStatementCache_put(fileStatementCache, tableName, columnNameCSV, insertSQL))!=NULL)))
+					{
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare INSERT statement for inserting evicted records into SQLite 3 database on file");
+					M2MHeap_free(insertSQL);
+					M2MHeap_free(selectSQL);
+					M2MHeap_free(columnNameCSV);
+					return -1;
+					}
+				}
+			//===== Read the oldest records back from SQLite3 database in memory =====
+			sqlite3_bind_int64(selectStatement, 1, (sqlite3_int64)(windowLength-maxRecord));
+			columnCount = sqlite3_column_count(selectStatement);
+			while (M2MSQLite_next(selectStatement)==SQLITE_ROW)
+				{
+				rowid = sqlite3_column_int64(selectStatement, 0);
+				//===== Skip the record already in SQLite3 database on file (restored snapshot) =====
+				if (rowid<=M2MDataFrame_getPersistedRowid(record))
+					{
+					// do nothing
+					}
+				//===== Append the record to the column store =====
+				else if (columnStore!=NULL)
+					{
+					for (i=1; i<columnCount && i<=(int)columnStore->numberOfColumn; i++)
+						{
+						M2MCEPValue_setColumn(&(values[i-1]), selectStatement, i);
+						}
+					if (M2MCEPColumnStore_append(columnStore, values)==NULL)
+						{
+						M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to append the evicted record to the column store");
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				//===== Copy the record for the persistence thread =====
+				else if (batch!=NULL)
+					{
+					for (i=1; i<columnCount && i<=batch->numberOfColumn; i++)
+						{
+						batch->value[batch->numberOfRecord*batch->numberOfColumn+(i-1)] = sqlite3_value_dup(sqlite3_column_value(selectStatement, i));
+						}
+					batch->numberOfRecord++;
+					}
+				//===== Insert the record into SQLite3 database on file =====
+				else
+					{
+					for (i=1; i<columnCount; i++)
+						{
+						sqlite3_bind_value(insertStatement, i, sqlite3_column_value(selectStatement, i));
+						}
+					if (M2MSQLite_next(insertStatement)!=SQLITE_DONE)
+						{
+						M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(fileStatementCache)));
+						}
+					//===== In case of success =====
+					else
+						{
+						// do nothing
+						}
+					sqlite3_reset(insertStatement);
+					}
+				numberOfRecord++;
+				}
+			sqlite3_reset(selectStatement);
+			//===== Delete the evicted records below the watermark =====
+			if (numberOfRecord>0)
+				{
+				if ((numberOfRecord=this_deleteMemoryDatabaseRecord(self, record, (int64_t)rowid+1))>=0)
+					{
+					M2MDataFrame_setWindowLength(record, windowLength-numberOfRecord);
+					//===== Record the last persisted record for the write-ahead log (not in case of the column store) =====
+					if (columnStore==NULL)
+						{
+						this_updatePersistedSequence(self, record, batch, fileStatementCache);
+						}
+					else
+						{
+						// do nothing
+						}
+					//===== Hand off the copies to the persistence thread =====
+					if (batch!=NULL)
+						{
+						this_handOffPersistenceBatch(self, batch);
+						batch = NULL;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to delete evicted records from SQLite 3 database in memory");
+					}
+				}
+			//===== When no record was read =====
+			else
+				{
+				// do nothing
+				}
+			//===== Release heap memory of SQL strings (the statements are kept in the cache) =====
+			this_deletePersistenceBatch(&batch);
+			M2MHeap_free(values);
+			M2MHeap_free(insertSQL);
+			M2MHeap_free(selectSQL);
+			M2MHeap_free(columnNameCSV);
+			return numberOfRecord;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare SELECT statement for evicting records from SQLite 3 database in memory");
+			M2MHeap_free(selectSQL);
+			M2MHeap_free(columnNameCSV);
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (record==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame\" structure object is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"String indicating table name obtained from record management object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Store all persistent unprocessed records in the SQLite 3 database on the file.<br>
+ *
+ * @param[in] self	CEP structure object
+ */
+static void this_flushCEPRecord (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MStatementCache *fileStatementCache = NULL;
+	M2MTableManager *tableManager = NULL;
+	M2MDataFrame *dataFrame = NULL;
+	bool persistence = false;
+	bool background = false;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_flushCEPRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Retrieve (the first node of) the record management object =====
+		if ((tableManager=this_getTableManager(self))!=NULL
+				&& (dataFrame=M2MDataFrame_begin(this_getDataFrame(self)))!=NULL)
+			{
+			//===== In the case of record persistence (the persistence thread owns the file in background persistence) =====
+			if ((persistence=this_getPersistence(self))==true
+					&& ((background=this_isBackgroundPersistence(self))==true
+						|| (fileStatementCache=this_getFileStatementCache(self))!=NULL))
+				{
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Initiates transaction processing to bulk insert record information into SQLite database on file");
+				//===== Start Transaction =====
+				if (background==false)
+					{
+					M2MSQLite_beginTransaction(M2MStatementCache_getDatabase(fileStatementCache));
+					}
+				else
+					{
+					// do nothing
+					}
+				//===== Repeat until record management object reaches the end =====
+				while (dataFrame!=NULL)
+					{
+					//===== Insert / delete all records held by record management object =====
+					if (M2MDataFrame_getWindowLength(dataFrame)>0
+							&& this_isShadowRecord(self, dataFrame)==true)
+						{
+						this_insertOldRecordList(self, dataFrame, 0);
+						}
+					//===== Move all records from SQLite3 database in memory =====
+					else if (M2MDataFrame_getWindowLength(dataFrame)>0)
+						{
+						this_evictMemoryDatabaseRecord(self, dataFrame, 0);
+						}
+					//===== In case of no record =====
+					else
+						{
+						// do nothing
+						}
+					//===== Move to the next record management object =====
+					dataFrame = M2MDataFrame_next(dataFrame);
+					}
+				//===== End Transaction =====
+				if (background==false)
+					{
+					M2MSQLite_commitTransaction(M2MStatementCache_getDatabase(fileStatementCache));
+					}
+				else
+					{
+					// do nothing
+					}
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished transaction processing to bulk insert records not inserted into SQLite database on file");
+				}
+			//===== In case of record non-persistence =====
+			else
+				{
+				}
+			//===== Successful completion =====
+			return;
+			}
+		//===== Error handling =====
+		else if (tableManager==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object obtained from the CEP execution object specified by the argument is NULL");
+			return;
+			}
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The record management object obtained from the CEP execution object specified by the argument is NULL");
+			return;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return;
+		}
+	}
+
+
+/**
+ * Write the evicted records waiting for the next block of every column store <br>
+ * into the files.<br>
+ * Caller must hold the lock of the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_flushColumnStore (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MCEPColumnStore *columnStore = NULL;
+
+	for (columnStore=self->columnStore; columnStore!=NULL; columnStore=columnStore->next)
+		{
+		if (M2MCEPColumnStore_flush(columnStore)==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), (M2MString *)"M2MCEP.this_flushColumnStore()", __LINE__, (M2MString *)"Failed to write the evicted records into the column store file");
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	return;
+	}
+
+
+/**
+ * Returns the time the asynchronous writer thread can wait for the next CSV <br>
+ * string before committing the records accumulated for group commit.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] waitTime	Maximum time to wait[usec]
+ * @return				Time to wait[usec] (0 means the records must be committed now)
+ */
+static uint64_t this_getAsyncWaitTime (M2MCEP *self, const uint64_t waitTime)
+	{
+	//========== Variable ==========
+	uint64_t asyncWaitTime = 0;
+
+	//===== Exclusive access to the accumulated records =====
+	pthread_mutex_lock(&(self->lock));
+	asyncWaitTime = this_getGroupCommitWaitTime(self, waitTime);
+	pthread_mutex_unlock(&(self->lock));
+	return asyncWaitTime;
+	}
+
+
+/**
+ * Get the CEP record information object managed by the argument CEP object.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			CEP record information object
+ */
+static M2MDataFrame *this_getDataFrame (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getDataFrame()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->dataFrame;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the column store of the table.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Column store or NULL (in case of no column store)
+ */
+static M2MCEPColumnStore *this_getColumnStore (const M2MCEP *self, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	M2MCEPColumnStore *columnStore = NULL;
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL)
+		{
+		//===== Search the column store of the table =====
+		columnStore = self->columnStore;
+		while (columnStore!=NULL && this_equalsName(columnStore->tableName, tableName)==false)
+			{
+			columnStore = columnStore->next;
+			}
+		return columnStore;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Copy SQLite3 database working directory pathname (="~/.m2m/cep").<br>
+ * Because the heap memory allocation process is executed inside this function, <br>
+ * caller must release the memory to prevent memory leak.<br>
+ *
+ * @param[out] directoryPath	Pointer for storing string indicating the directory SQLite 3 database file is set
+ * @return						SQLite3 working directory pathname or NULL (in case of error)
+ */
+static M2MString *this_getDatabaseDirectoryPath (M2MString **directoryPath)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getDatabaseDirectoryPath()";
+
+	//===== Check argument =====
+	if (directoryPath!=NULL)
+		{
+		//===== Get CEP working directory pathname =====
+		if (M2MString_append(directoryPath, M2MDirectory_getHomeDirectoryPath())!=NULL
+				&& M2MString_append(directoryPath, M2MDirectory_SEPARATOR)!=NULL
+				&& M2MString_append(directoryPath, M2MCEP_DIRECTORY)!=NULL)
+			{
+			return (*directoryPath);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MHeap_free((*directoryPath))
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to copy the string indicating the home directory path");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"directoryPath\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Create string indicating the database file path and copy it to the buffer. <br>
+ * If processing fails, NULL is returned as a return value.<br>
+ *
+ * @param[in] databaseName			String indicating SQLite3 database file name
+ * @param[out] databaseFilePath		Pointer for storing string indicating the database file path
+ * @return							Pointer of string indicating database file path or NULL (in case of error)
+ */
+static M2MString *this_getDatabaseFilePath (const M2MString *databaseName, M2MString **databaseFilePath)
+	{
+	//========== Variable ==========
+	M2MString *directoryPath = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getDatabaseFilePath()";
+
+	//===== Check argument =====
+	if (databaseName!=NULL && M2MString_length(databaseName)>0
+			&& databaseFilePath!=NULL)
+		{
+		//===== Copy database file installation directory pathname =====
+		if (this_getDatabaseDirectoryPath(&directoryPath)!=NULL
+				&& M2MDirectory_mkdirs(directoryPath, M2MSQLite_DATABASE_DIRECTORY_PERMISSION)==true
+				&& M2MString_append(databaseFilePath, directoryPath)!=NULL
+				&& M2MString_append(databaseFilePath, M2MDirectory_SEPARATOR)!=NULL
+				&& M2MString_append(databaseFilePath, databaseName)!=NULL)
+			{
+			//===== Release heap memory of directory path string =====
+			M2MHeap_free(directoryPath);
+			//=====  =====
+			return (*databaseFilePath);
+			}
+		//===== Error handling =====
+		else
+			{
+			//===== In the case of directory path string exists =====
+			if (directoryPath!=NULL)
+				{
+				//===== Release heap memory of directory path string =====
+				M2MHeap_free(directoryPath);
+				}
+			else
+				{
+				}
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (databaseName==NULL || M2MString_length(databaseName)<=0)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseFilePath\" is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * @param columnList
+ * @param columnNameCSV
+ * @param dataTypeArray
+ * @param dataTypeArrayLength
+ * @return
+ */
+static unsigned int this_getDataTypeArray (M2MColumnList *columnList, const M2MString *columnNameCSV, M2MSQLiteDataType dataTypeArray[], const size_t dataTypeArrayLength)
+	{
+	//========== Variable ==========
+	M2MString *columnName = NULL;
+	M2MString *index = NULL;
+	unsigned int dataTypeIndex = 0;
+	M2MColumn *column = NULL;
+	M2MSQLiteDataType dataType;
+	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
+
+	//===== Check argument =====
+	if (columnList!=NULL
+			&& columnNameCSV!=NULL && M2MString_length(columnNameCSV)>0
+			&& dataTypeArray!=NULL
+			&& dataTypeArrayLength>0)
+		{
+		//===== Get head pointer of column name in CSV format =====
+		columnName = (M2MString *)columnNameCSV;
+		//===== Create a column data type storage array =====
+		memset(dataTypeArray, 0, dataTypeArrayLength);
+		dataTypeIndex = 0;
+		//===== Separate column names in CSV format with commas =====
+		while (columnName!=NULL
+				&& (index=M2MString_indexOf(columnName, (M2MString *)M2MString_COMMA))!=NULL)
+			{
+			//===== Search objects with the same column name =====
+			if ((column=M2MColumnList_search(columnList, columnName, M2MString_length(columnName) - M2MString_length(index)))!=NULL)
+				{
+				//===== Get column data type =====
+				dataType = M2MColumn_getDataType(column);
+				//===== Store column data type in array =====
+				dataTypeArray[dataTypeIndex] = dataType;
+				}
+			//===== Error handling =====
+			else
+				{
+				dataTypeArray[dataTypeIndex] = M2MSQLiteDataType_ERROR;
+				}
+			dataTypeIndex++;
+			//===== Move the pointer by comma =====
+			index += COMMA_LENGTH;
+			//===== Move the start pointer to the next column name =====
+			columnName = index;
+			}
+		//===== Search objects with the same column name =====
+		if ((column=M2MColumnList_search(columnList, columnName, M2MString_length(columnName)))!=NULL)
+			{
+			//===== Get column data type =====
+			dataType = M2MColumn_getDataType(column);
+			//===== Store column data type in array =====
+			dataTypeArray[dataTypeIndex] = dataType;
+			dataTypeIndex++;
+			}
+		//===== Error handling =====
+		else
+			{
+			dataTypeArray[dataTypeIndex] = M2MSQLiteDataType_ERROR;
+			}
+		return dataTypeIndex;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Get the prepared statement cache of SQLite3 database on file.<br>
+ * If the database on file hasn't been opened yet, it is opened.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Prepared statement cache or NULL (in case of non-persistence or error)
+ */
+static M2MStatementCache *this_getFileStatementCache (M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getFileStatementCache()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Open SQLite3 database on file (the cache is created at the same time) =====
+		if (M2MCEP_getFileDatabase(self)!=NULL)
+			{
+			return self->fileStatementCache;
+			}
+		//===== In case of non-persistence or error =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the aggregate of the column of the table.<br>
+ *
+ * @param[in] self			CEP structure object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @return					Aggregate or NULL (in case of undeclared aggregate)
+ */
+static M2MCEPAggregate *this_getAggregate (const M2MCEP *self, const M2MString *tableName, const M2MString *columnName)
+	{
+	//========== Variable ==========
+	M2MCEPAggregate *aggregate = NULL;
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && columnName!=NULL)
+		{
+		//===== Search the aggregate =====
+		for (aggregate=self->aggregate; aggregate!=NULL; aggregate=aggregate->next)
+			{
+			if (this_equalsName(aggregate->tableName, tableName)==true
+					&& this_equalsName(aggregate->columnName, columnName)==true)
+				{
+				return aggregate;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		return NULL;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the upper limit of the number of CEP records held by the argument CEP object.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			The upper limit of the number of CEP records
+ */
+static unsigned int this_getMaxRecord (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const unsigned int DEFAULT_MAX_RECORD = 50;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getMaxRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->maxRecord;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return DEFAULT_MAX_RECORD;
+		}
+	}
+
+
+/**
+ * Returns the time until the accumulated records must be committed.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] waitTime	Time to return when no record is accumulated[usec]
+ * @return				Time to wait[usec] (0 means the records must be committed now)
+ */
+static uint64_t this_getGroupCommitWaitTime (const M2MCEP *self, const uint64_t waitTime)
+	{
+	//========== Variable ==========
+	uint64_t elapsedTime = 0;
+
+	//===== In case of no accumulated record =====
+	if (self->pendingRecord==0)
+		{
+		return waitTime;
+		}
+	//===== In case of no delay limit (commit as soon as the queue becomes empty) =====
+	else if (self->groupCommitMaxDelay==0)
+		{
+		return 0;
+		}
+	//===== When the delay limit is reached =====
+	else if ((elapsedTime=this_getMonotonicTime()-self->pendingTime)>=self->groupCommitMaxDelay)
+		{
+		return 0;
+		}
+	//===== Wait for the rest of the delay limit =====
+	else if (self->groupCommitMaxDelay-elapsedTime<waitTime)
+		{
+		return self->groupCommitMaxDelay - elapsedTime;
+		}
+	else
+		{
+		return waitTime;
+		}
+	}
+
+
+/**
+ * Get the prepared statement cache of SQLite3 database on memory.<br>
+ * If the database on memory hasn't been opened yet, it is opened.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Prepared statement cache or NULL (in case of error)
+ */
+static M2MStatementCache *this_getMemoryStatementCache (M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getMemoryStatementCache()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Open SQLite3 database on memory (the cache is created at the same time) =====
+		if (M2MCEP_getMemoryDatabase(self)!=NULL)
+			{
+			return self->memoryStatementCache;
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the time of the monotonic clock.<br>
+ *
+ * @return	Time of monotonic clock[usec]
+ */
+static uint64_t this_getMonotonicTime ()
+	{
+	//========== Variable ==========
+	struct timespec now;
+
+	//===== Get time =====
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000ULL;
+	}
+
+
+/**
+ * Get a flag indicating persistence availability from the argument CEP object.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @return					Flag indicating permanence
+ */
+static bool this_getPersistence (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const bool PERSISTENCE = true;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getPersistence()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->persistence;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return PERSISTENCE;
+		}
+	}
+
+
+/**
+ * Get the number of inserted records held by the argument CEP object.<br>
+ *
+ * @param self	CEP structure object
+ * @return		Number of inserted records
+ */
+static unsigned int this_getRecordCounter (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getRecordCounter()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->recordCounter;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Get the prepared statement of the SELECT statement from the LRU cache of <br>
+ * SQLite3 database on memory, or compile and cache it (key is the SQL string).<br>
+ * Reused statements are reset and their bindings are cleared.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @return				Prepared statement owned by the SELECT statement cache or NULL (in case of error)
+ */
+static sqlite3_stmt *this_getSelectStatement (M2MCEP *self, const M2MString *sql)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getSelectStatement()";
+
+	//===== Check argument =====
+	if (self!=NULL && sql!=NULL)
+		{
+		//===== Open SQLite3 database on memory (the cache is created at the same time) =====
+		if (M2MCEP_getMemoryDatabase(self)!=NULL
+				&& ((statement=M2MStatementCache_search(self->selectStatementCache, sql, NULL))!=NULL
+					|| (statement=M2MStatementCache_put(self->selectStatementCache, sql, NULL, sql))!=NULL))
+			{
+			return statement;
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQL string is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get a flag indicating whether the record window is copied into the record <br>
+ * management object besides the SQLite3 database in memory.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			true: copy is kept, false: SQLite3 database in memory is the only holder
+ */
+static bool this_getShadowRecord (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const bool SHADOW_RECORD = true;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getShadowRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->shadowRecord;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return SHADOW_RECORD;
+		}
+	}
+
+
+/**
+ * Get the record management object of the table.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Record management object of the table or NULL (in case of no record)
+ */
+static M2MDataFrame *this_getTableDataFrame (const M2MCEP *self, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	M2MDataFrame *record = NULL;
+
+	//===== Search the record management object of the table =====
+	for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+		{
+		if (this_equalsName(M2MDataFrame_getTableName(record), tableName)==true)
+			{
+			return record;
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	return NULL;
+	}
+
+
+/**
+ * Get the rowid of the last record inserted into the table of SQLite3 <br>
+ * database in memory.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Rowid of the last record (0 in case of no record)
+ */
+static int64_t this_getTableLastRowid (const M2MCEP *self, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	M2MDataFrame *record = NULL;
+
+	//===== Search the record management object of the table =====
+	for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+		{
+		if (this_equalsName(M2MDataFrame_getTableName(record), tableName)==true)
+			{
+			return M2MDataFrame_getLastRowid(record);
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	return 0;
+	}
+
+
+/**
+ * Get the table construction object held by the CEP object as a member variable.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Table construction object or NULL (in case of error)
+ */
+static M2MTableManager *this_getTableManager (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getTableManager()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->tableManager;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the number of records for which SQLite3 database performs vacuum processing.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of records for which SQLite 3 database performs vacuum processing
+ */
+static unsigned int this_getVacuumRecord (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getVacuumRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->vacuumRecord;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Get the window definition of the table specified by the argument.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Window definition or NULL (in case of no definition)
+ */
+static M2MCEPWindow *this_getWindow (const M2MCEP *self, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	M2MCEPWindow *window = NULL;
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL)
+		{
+		//===== Search the window definition of the table =====
+		window = self->window;
+		while (window!=NULL && this_equalsName(window->tableName, tableName)==false)
+			{
+			window = window->next;
+			}
+		return window;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the number of records to keep in the table of the SQLite3 database in <br>
+ * memory, from the window definition of the table (number of records and/or <br>
+ * duration of event time) or the maximum number of records of the CEP object.<br>
+ * The duration is converted into a number of records with the index of the <br>
+ * event time column (O(log n)), assuming event time increases with insertion.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] record		Record management object of the table
+ * @return					Number of records to keep (UINT_MAX: not limited)
+ */
+static unsigned int this_getWindowLimit (M2MCEP *self, const M2MDataFrame *record)
+	{
+	//========== Variable ==========
+	M2MCEPWindow *window = NULL;
+	M2MStatementCache *memoryStatementCache = NULL;
+	sqlite3_stmt *statement = NULL;
+	unsigned int limit = 0;
+	int64_t keepRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getWindowLimit()";
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL)
+		{
+		//===== Get the limit by number of records =====
+		if ((limit=this_getWindowMaxRecord(self, record))==0)
+			{
+			limit = UINT_MAX;
+			}
+		//===== Limit by number of records only =====
+		if ((window=this_getWindow(self, M2MDataFrame_getTableName(record)))==NULL
+				|| window->duration<=0)
+			{
+			return limit;
+			}
+		//===== Search the oldest record within the duration from the latest event time =====
+		else if ((memoryStatementCache=this_getMemoryStatementCache(self))!=NULL
+				&& ((statement=M2MStatementCache_search(memoryStatementCache, window->boundarySQL, NULL))!=NULL
+					|| (statement=M2MStatementCache_put(memoryStatementCache, window->boundarySQL, NULL, window->boundarySQL))!=NULL))
+			{
+			sqlite3_bind_int64(statement, 1, (sqlite3_int64)window->duration);
+			if (M2MSQLite_next(statement)==SQLITE_ROW
+					&& (keepRecord=M2MDataFrame_getLastRowid(record)-(int64_t)sqlite3_column_int64(statement, 0)+1)>0
+					&& keepRecord<(int64_t)limit)
+				{
+				limit = (unsigned int)keepRecord;
+				}
+			else
+				{
+				// do nothing
+				}
+			sqlite3_reset(statement);
+			return limit;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare SELECT statement for searching the window boundary of SQLite 3 database in memory");
+			return limit;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" or \"M2MDataFrame\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Get the maximum number of records of the table, which is the one of the <br>
+ * window definition or (without definition) the one of the CEP object.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] record	Record management object of the table
+ * @return				Maximum number of records (0: not limited by number)
+ */
+static unsigned int this_getWindowMaxRecord (const M2MCEP *self, const M2MDataFrame *record)
+	{
+	//========== Variable ==========
+	M2MCEPWindow *window = NULL;
+
+	//===== Window definition of the table =====
+	if ((window=this_getWindow(self, M2MDataFrame_getTableName(record)))!=NULL)
+		{
+		return window->maxRecord;
+		}
+	//===== Maximum number of records of the CEP object =====
+	else
+		{
+		return this_getMaxRecord(self);
+		}
+	}
+
+
+/**
+ * Hand off the batch to the background persistence thread.<br>
+ * The caller waits only while the number of in-flight records would exceed <br>
+ * the limit (backpressure). The batch is released by the persistence thread.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in,out] batch	Batch of records
+ */
+static void this_handOffPersistenceBatch (M2MCEP *self, M2MCEPPersistenceBatch *batch)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_handOffPersistenceBatch()";
+
+	//===== Check argument =====
+	if (self!=NULL && batch!=NULL && batch->numberOfRecord>0)
+		{
+		pthread_mutex_lock(&(self->persistenceMutex));
+		//===== Backpressure (a batch is always accepted when nothing is in flight) =====
+		while (atomic_load(&(self->persistenceRunning))==true
+				&& self->handedOffRecord>self->persistedRecord
+				&& (self->handedOffRecord-self->persistedRecord)+batch->numberOfRecord>self->maxInFlightRecord)
+			{
+			pthread_cond_wait(&(self->persistenceCondition), &(self->persistenceMutex));
+			}
+		//===== Append the batch to the queue =====
+		if (self->persistenceBatchTail!=NULL)
+			{
+			self->persistenceBatchTail->next = batch;
+			}
+		else
+			{
+			self->persistenceBatch = batch;
+			}
+		self->persistenceBatchTail = batch;
+		self->handedOffRecord += batch->numberOfRecord;
+		pthread_cond_broadcast(&(self->persistenceCondition));
+		pthread_mutex_unlock(&(self->persistenceMutex));
+		return;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		this_deletePersistenceBatch(&batch);
+		return;
+		}
+	//===== Empty batch =====
+	else
+		{
+		this_deletePersistenceBatch(&batch);
+		return;
+		}
+	}
+
+
+/**
+ * @param[in] csv
+ * @return				true : , false :
+ */
+static bool this_includesData (const M2MString *csv)
+	{
+	//========== Variable ==========
+	M2MString *index = NULL;
+	const size_t CRLF_LENGTH = M2MString_length((M2MString *)M2MString_CRLF);
+
+	//===== Check argument =====
+	if (csv!=NULL)
+		{
+		//===== Confirm header line feed code =====
+		if ((index=M2MString_indexOf(csv, (M2MString *)M2MString_CRLF))!=NULL)
+			{
+			//===== Advance the pointer by the number of line feed code characters =====
+			index += CRLF_LENGTH;
+			//===== Confirm existence of data =====
+			if (M2MString_length(index)>0)
+				{
+				return true;
+				}
+			//===== When data was not included =====
+			else
+				{
+				return false;
+				}
+			}
+		//===== When the header is not included =====
+		else
+			{
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Initializes the CEP object specified by the argument.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] databaseName	SQLite3 database name on file
+ * @param[in] tableManager	Object for building SQLite3 database table
+ * @return					CEP structure object or NULL (in case of error)
+ */
+static M2MCEP *this_init (M2MCEP *self, const M2MString *databaseName, const M2MTableManager *tableManager)
+	{
+	//========== Variable ==========
+	M2MFileAppender *logger = NULL;
+	const unsigned int MAX_RECORD = 50;
+	const bool PERSISTENCE = true;
+	const bool SHADOW_RECORD = true;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_init()";
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& databaseName!=NULL && M2MString_length(databaseName)>0
+			&& tableManager!=NULL)
+		{
+		//===== Initialize synchronization objects for asynchronous mode =====
+		pthread_mutex_init(&(self->lock), NULL);
+		pthread_mutex_init(&(self->queueMutex), NULL);
+		pthread_cond_init(&(self->queueCondition), NULL);
+		pthread_mutex_init(&(self->persistenceMutex), NULL);
+		pthread_cond_init(&(self->persistenceCondition), NULL);
+		pthread_mutex_init(&(self->checkpointMutex), NULL);
+		pthread_cond_init(&(self->checkpointCondition), NULL);
+		//===== The records of the history left the window before this object =====
+		self->evictionTime = time(NULL);
+		//===== Initialize CEP object =====
+		if (this_setDatabaseName(self, databaseName)!=NULL
+				&& M2MCEP_setMaxRecord(self, MAX_RECORD)!=NULL
+				&& this_setDataFrame(self, M2MDataFrame_new())!=NULL
+				&& this_setTableManager(self, tableManager)!=NULL
+				&& M2MCEP_setPersistence(self, PERSISTENCE)!=NULL
+				&& M2MCEP_setShadowRecord(self, SHADOW_RECORD)!=NULL
+				&& (logger=M2MFileAppender_new())!=NULL
+				&& M2MCEP_setLogger(self, logger)!=NULL
+				)
+			{
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MCEP_delete(&self);
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to initialize \"M2MCEP\" object");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (databaseName==NULL || M2MString_length(databaseName)<=0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MTableManager\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Insert string in CSV format into the table of SQLite 3 database for CEP. <br>
+ * The internal processing procedure is as follows.<br>
+ * <br>
+ * 1) Parse CSV string and import into a CEPRecord structure object. <br>
+ * 2) Insert record data into the table of SQLite3 memory database. <br>
+ * 3) Check the current record number of the table of SQLite3 memory database, <br>
+ *    and delete it in the oldest order if it exceeds the specified <br>
+ *    maximum value. <br>
+ * 4) Fetch the same data as the deleted record from the CEPRecord <br>
+ *    structure object and insert it into the SQLite3 database file for <br>
+ *    persistence. <br>
+ * 5) Delete excess from record data of CEPRecord structure object. <br>
+ * In group commit mode, the records are accumulated and committed later (see <br>
+ * M2MCEP_setGroupCommit()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+static int this_insertCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv)
+	{
+	//========== Variable ==========
+	int numberOfRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertCSV()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && csv!=NULL)
+		{
+		//===== Set CSV string to M2MDataFrame object =====
+		if ((numberOfRecord=M2MDataFrame_setCSV(this_getDataFrame(self), tableName, csv))>0)
+			{
+			//===== Accumulate records for group commit =====
+			if (self->pendingRecord==0)
+				{
+				self->pendingTime = this_getMonotonicTime();
+				}
+			else
+				{
+				// do nothing
+				}
+			self->pendingRecord += numberOfRecord;
+			self->pendingByte += M2MString_length(csv);
+			//===== Append the records to the write-ahead log =====
+			this_writeLog(self, tableName, csv, NULL, (size_t)numberOfRecord, 0);
+			//===== Commit records when one of the limits is reached =====
+			if (this_isGroupCommitDue(self)==false)
+				{
+				return numberOfRecord;
+				}
+			else if (this_commitRecord(self)>=0)
+				{
+				return numberOfRecord;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to commit records into SQLite3 databases");
+				return -1;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to set CSV format string to record management object");
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (tableName==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the CSV format record specified by the argument is NULL");
+		return -1;
+		}
+	}
+
+
+
+/**
+ * Pop the records exceeding the maximum number of records from the oldest of <br>
+ * the record window held by the table record management object and (in case <br>
+ * of persistence) insert them into the SQLite3 database on file.<br>
+ * In case of background persistence, the popped records are handed off to the <br>
+ * persistence thread instead.<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in,out] tableRecord	Table record management object
+ * @param[in] maxRecord			Maximum number of records to keep in SQLite3 database table in memory (Execution of persistence when it becomes larger)
+ */
+static void this_insertOldRecordList (M2MCEP *self, M2MDataFrame *tableRecord, const unsigned int maxRecord)
+	{
+	//========== Variable ==========
+	M2MStatementCache *fileStatementCache = NULL;
+	sqlite3_stmt* statement = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MRingBuffer *oldRecordList = NULL;
+	M2MCEPPersistenceBatch *batch = NULL;
+	unsigned int oldRecordListLength = 0;
+	M2MSQLiteDataType DATA_TYPE_ARRAY[M2MSQLite_getMaxColumnLength(M2MCEP_getMemoryDatabase(self))];
+	M2MString *value = NULL;
+	M2MString *insertSQL = NULL;
+	M2MString *tableName = NULL;
+	M2MString *columnNameCSV = NULL;
+	unsigned int dataTypeArrayLength = 0;
+	int rest = 0;
+	unsigned int i = 0;
+	const bool PERSISTENCE = this_getPersistence(self);
+	const bool BACKGROUND = this_isBackgroundPersistence(self);
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP.this_insertOldRecordList()";
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& tableRecord!=NULL
+			&& (tableName=M2MDataFrame_getTableName(tableRecord))!=NULL
+			&& (oldRecordList=M2MDataFrame_getOldRecordList(tableRecord))!=NULL
+			&& (oldRecordListLength=M2MRingBuffer_length(oldRecordList))>0)
+		{
+		//===== When the number of records in which SQLite 3 database has been inserted in memory exceeds the specified maximum number of records =====
+		if ((rest=oldRecordListLength-maxRecord)>0)
+			{
+			self->evictionTime = time(NULL);
+			//===== In case of background persistence =====
+			if (PERSISTENCE==true && BACKGROUND==true)
+				{
+				//===== Prepare a batch for copies of the records =====
+				if ((columnNameCSV=M2MDataFrame_getColumnName(tableRecord))!=NULL
+						&& (batch=this_createPersistenceBatch(tableName, columnNameCSV, 0, rest))!=NULL)
+					{
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create a batch of records for background persistence");
+					return;
+					}
+				}
+			//===== In case of past insert record persistence =====
+			else if (PERSISTENCE==true)
+				{
+				//===== Preparation for past record insertion into SQLite 3 database on file =====
+				if ((columnNameCSV=M2MDataFrame_getColumnName(tableRecord))!=NULL
+						&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), tableName)))!=NULL
+						&& (dataTypeArrayLength=this_getDataTypeArray(columnList, columnNameCSV, DATA_TYPE_ARRAY, sizeof(DATA_TYPE_ARRAY)))>0
+						&& (fileStatementCache=this_getFileStatementCache(self))!=NULL
+						&& ((statement=M2MStatementCache_search(fileStatementCache, tableName, columnNameCSV))!=NULL
+							|| (this_createInsertSQL(tableName, columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
+								&& (statement=M2MStatementCache_put(fileStatementCache, tableName, columnNameCSV, insertSQL))!=NULL)))
+					{
+					}
+				//===== Error handling =====
+				else if (columnNameCSV==NULL)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The CSV format string indicating the column name obtained from the table record management object is NULL");
+					return;
+					}
+				else if (columnList==NULL)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The column structure object of the table obtained from the table building object is NULL");
+					return;
+					}
+				else if (dataTypeArrayLength<=0)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Column data type array obtained from table building object is NULL");
+					return;
+					}
+				else if (fileStatementCache==NULL)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The prepared statement cache of SQLite3 database on file is NULL");
+					return;
+					}
+				else if (insertSQL==NULL)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"An attempt to create an INSERT statement to insert a record into the SQLite 3 database on the file failed");
+					return;
+					}
+				else
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(fileStatementCache)));
+					M2MHeap_free(insertSQL);
+					return;
+					}
+				}
+			//===== In case of past insertion record non-persistence =====
+			else
+				{
+				// do nothing
+				}
+			//===== Repeat as many records as the excess =====
+			for (i=0; i<rest; i++)
+				{
+				//===== When to hand off the copy to the persistence thread =====
+				if (batch!=NULL)
+					{
+					//===== Copy the record =====
+					if ((value=(M2MString *)M2MHeap_malloc(M2MRingBuffer_getValueLength(oldRecordList, 0)+1))!=NULL)
+						{
+						memcpy(value, M2MRingBuffer_getValue(oldRecordList, 0), M2MRingBuffer_getValueLength(oldRecordList, 0));
+						batch->csv[batch->numberOfRecord] = value;
+						batch->numberOfRecord++;
+						}
+					//===== Error handling =====
+					else
+						{
+						M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for copying record for background persistence");
+						}
+					}
+				//===== When to make it persistent =====
+				else if (statement!=NULL)
+					{
+					//===== Bind the record into the INSERT statement =====
+					if ((value=(M2MString *)M2MRingBuffer_getValue(oldRecordList, 0))!=NULL
+							&& this_setCSVIntoPreparedStatement(value, DATA_TYPE_ARRAY, dataTypeArrayLength, statement)==true)
+						{
+						//===== Execute INSERT =====
+						if (M2MSQLite_next(statement)==SQLITE_DONE)
+							{
+							}
+						//===== Error handling =====
+						else
+							{
+							M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(fileStatementCache)));
+							}
+						}
+					//===== Error creating INSERT statement =====
+					else
+						{
+						M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed in preparing INSERT statement for inserting record into SQLite 3 database on file");
+						}
+					//===== Reset parameters of INSERT statement =====
+					sqlite3_reset(statement);
+					}
+				//===== When not to perpetuate =====
+				else
+					{
+					// do nothing
+					}
+				//===== Delete the oldest record inserted in the database =====
+				M2MRingBuffer_pop(oldRecordList);
+				}
+			//===== Update the number of records held in SQLite3 database in memory =====
+			M2MDataFrame_setWindowLength(tableRecord, M2MRingBuffer_length(oldRecordList));
+			//===== Record the last persisted record for the write-ahead log =====
+			if (PERSISTENCE==true)
+				{
+				this_updatePersistedSequence(self, tableRecord, batch, fileStatementCache);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Hand off the copies to the persistence thread =====
+			if (batch!=NULL)
+				{
+				this_handOffPersistenceBatch(self, batch);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Release heap memory area of INSERT statement =====
+			M2MHeap_free(insertSQL);
+			return;
+			}
+		//===== When the number of records in which SQLite 3 database has been inserted in memory is within the specified maximum number of records =====
+		else
+			{
+			return;
+			}
+		}
+	//===== Error handling =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return;
+		}
+	else if (tableRecord==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The record management object specified by the argument is NULL");
+		return;
+		}
+	else if (tableName==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"String indicating table name obtained from table record management object is NULL");
+		return;
+		}
+	else if (oldRecordList==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Inserted record information object obtained from table record management object is NULL");
+		return;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Number of non-inserted records acquired from table record management object is 0 or less");
+		return;
+		}
+	}
+
+
+/**
+ * Bulk insert records into SQLite 3 database specified by argument.<br>
+ * The INSERT statement is compiled only when the prepared statement cache <br>
+ * doesn't hold one for the table and column header.<br>
+ *
+ * @param[in,out] statementCache	Prepared statement cache of SQLite3 database
+ * @param[in] record				Record management object
+ * @param[in] tableManager			Table construction object
+ * @param[in] recordList			Record information object
+ * @return							Number of inserted records or -1 (in case of error)
+ */
+static int this_insertRecordList (M2MStatementCache *statementCache, const M2MDataFrame *record, M2MTableManager *tableManager, M2MList *recordList)
+	{
+	//========== Variable ==========
+	sqlite3 *database = M2MStatementCache_getDatabase(statementCache);
+	sqlite3_stmt* statement = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MSQLiteDataType DATA_TYPE_ARRAY[M2MSQLite_getMaxColumnLength(database)];
+	M2MString *value = NULL;
+	M2MString *valueIndex = NULL;
+	M2MString *insertSQL = NULL;
+	M2MString *tableName = NULL;
+	M2MString *columnNameCSV = NULL;
+	int numberOfRecord = 0;
+	unsigned int columnIndex = 0;
+	unsigned int dataTypeArrayLength = 0;
+	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecordList()";
+
+	//===== Check argument =====
+	if (statementCache!=NULL && tableManager!=NULL && record!=NULL && (recordList=M2MList_begin(recordList))!=NULL)
+		{
+		//===== Get table name, column name CSV and new record information object to be inserted =====
+		if ((tableName=M2MDataFrame_getTableName(record))!=NULL
+				&& (columnNameCSV=M2MDataFrame_getColumnName(record))!=NULL
+				&& (columnList=M2MTableManager_getColumnList(tableManager, tableName))!=NULL
+				&& (columnList=M2MColumnList_begin(columnList))!=NULL
+				&& ((statement=M2MStatementCache_search(statementCache, tableName, columnNameCSV))!=NULL
+					|| (this_createInsertSQL(tableName, columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
+						&& (statement=M2MStatementCache_put(statementCache, tableName, columnNameCSV, insertSQL))!=NULL))
+				&& (dataTypeArrayLength=this_getDataTypeArray(columnList, columnNameCSV, DATA_TYPE_ARRAY, sizeof(DATA_TYPE_ARRAY)))>0)
+			{
+			//===== Reset parameters of SQL statement =====
+			sqlite3_reset(statement);
+			//===== Repeat with uninserted record information object =====
+			while (recordList->next!=NULL)
+				{
+				//===== Create an INSERT statement =====
+				if ((value=(M2MString *)M2MList_getValue(recordList))!=NULL)
+					{
+					//===== Initialize field position =====
+					columnIndex = 0;
+					//===== Repeat with column name in CSV format =====
+					while (columnIndex<(dataTypeArrayLength-1)
+							&& value!=NULL
+							&& (valueIndex=M2MString_indexOf(value, (M2MString *)M2MString_COMMA))!=NULL)
+						{
+						//===== Set value to INSERT statement =====
+						M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value)-M2MString_length(valueIndex), statement);
+						//===== Move the field position to the next =====
+						columnIndex++;
+						//===== Move the position of the value to the next =====
+						valueIndex += COMMA_LENGTH;
+						value = valueIndex;
+						}
+					//===== Check the consistency of the number of columns and the number of inserted data =====
+					if (columnIndex==(dataTypeArrayLength-1))
+						{
+						//===== Set the last data to INSERT statement =====
+						M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value), statement);
+						//===== Execute INSERT statement =====
+						if (M2MSQLite_next(statement)==SQLITE_DONE)
+							{
+							}
+						//===== Error handling =====
+						else
+							{
+							M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"An error occurred in INSERT processing of SQLite3 database");
+							}
+						}
+					//===== Reset parameters of INSERT statement =====
+					sqlite3_reset(statement);
+					//===== Count the number of inserted records =====
+					numberOfRecord++;
+					}
+				//===== Error creating INSERT statement =====
+				else
+					{
+					M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed in preparing INSERT statement for inserting records into SQLite 3 database");
+					}
+				//===== Proceed to next uninserted record =====
+				recordList = M2MList_next(recordList);
+				}
+			//===== Create an INSERT statement from the (last) uninserted record =====
+			if ((value=(M2MString *)M2MList_getValue(recordList))!=NULL)
+				{
+				columnIndex = 0;
+				//===== Repeat with column name in CSV format =====
+				while (columnIndex<dataTypeArrayLength
+						&& value!=NULL
+						&& (valueIndex=M2MString_indexOf(value, (M2MString *)M2MString_COMMA))!=NULL)
+					{
+					//===== Set value to INSERT statement =====
+					M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value)-M2MString_length(valueIndex), statement);
+					//===== Move the field position to the next =====
+					columnIndex++;
+					//===== Move the position of the value to the next =====
+					valueIndex += COMMA_LENGTH;
+					value = valueIndex;
+					}
+				//===== Set the last data to INSERT statement =====
+				M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value), statement);
+				//===== Execute INSERT statement =====
+				if (M2MSQLite_next(statement)==SQLITE_DONE)
+					{
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"An error occurred in INSERT processing of SQLite3 database");
+					}
+				//===== Reset parameters of INSERT statement =====
+				sqlite3_reset(statement);
+				//===== Count the number of inserted records =====
+				numberOfRecord++;
+				}
+			//===== Error creating INSERT statement =====
+			else
+				{
+				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed in preparing INSERT statement for inserting records into SQLite 3 database");
+				}
+			//===== Release heap memory area of INSERT statement (the statement itself is kept in the cache) =====
+			M2MHeap_free(insertSQL);
+			//===== Returns the number of inserted records =====
+			return numberOfRecord;
+			}
+		//===== Error handling =====
+		else if (tableName==NULL)
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"String indicating table name obtained from record management object is NULL");
+			return -1;
+			}
+		else if (columnNameCSV==NULL)
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The CSV format string indicating the column name obtained from the record management object is NULL");
+			return -1;
+			}
+		else if (columnList==NULL)
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The column structure object of the table obtained from the table building object is NULL");
+			return -1;
+			}
+		else if (statement==NULL)
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The prepared statement object obtained from the SQLite3 database management object specified by the argument is NULL");
+			M2MHeap_free(insertSQL);
+			return -1;
+			}
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Column data type array obtained from table building object is NULL");
+			M2MHeap_free(insertSQL);
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (statementCache==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The prepared statement cache specified by the argument is NULL");
+		return -1;
+		}
+	else if (tableManager==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The table construction object specified by the argument is NULL");
+		return -1;
+		}
+	else if (record==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The record management object specified by the argument is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The uninserted record information object obtained from the record management object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * If the specified maximum number of records is exceeded for the record of <br>
+ * "already inserted in SQLite3 database in memory" of the CEP record management <br>
+ * object held by the CEP execution object specified by the argument, the record <br>
+ * of excess Into the SQLite 3 database on the file and make it persistent.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Successful CEP execution object or NULL (in case of insertion error)
+ */
+static M2MCEP *this_insertRecordListToFileDatabase (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MTableManager *tableManager = NULL;
+	M2MDataFrame *tableRecord = NULL;
+	unsigned int maxRecord = 0;
+	bool persistence = false;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecordListToFileDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Get table record management object =====
+		if ((tableManager=this_getTableManager(self))!=NULL
+				&& (tableRecord=M2MDataFrame_begin(this_getDataFrame(self)))!=NULL
+				&& this_getMaxRecord(self)>0)
+			{
+			//===== In the case of record persistence (the persistence thread owns the file in background persistence) =====
+			if ((persistence=(this_getPersistence(self)==true && this_isBackgroundPersistence(self)==false))==true)
+				{
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start transaction processing to insert records into SQLite database on file");
+				//===== Move to the partition file of the current time =====
+				this_rotatePartition(self);
+				//===== Start Transaction =====
+				M2MSQLite_beginTransaction(M2MCEP_getFileDatabase(self));
+				}
+			//===== In case of record non-persistence =====
+			else
+				{
+				// do nothing
+				}
+			//===== Repeat with record management object =====
+			while (tableRecord!=NULL)
+				{
+				//===== When the number of records is within the window of the table =====
+				if (M2MDataFrame_getWindowLength(tableRecord)<=(maxRecord=this_getWindowLimit(self, tableRecord)))
+					{
+					// do nothing
+					}
+				//===== Execute past record processing held by record management object =====
+				else if (this_isShadowRecord(self, tableRecord)==true)
+					{
+					this_insertOldRecordList(self, tableRecord, maxRecord);
+					}
+				//===== Move excess records from SQLite3 database in memory =====
+				else
+					{
+					this_evictMemoryDatabaseRecord(self, tableRecord, maxRecord);
+					}
+				//===== Move to the next table record management object =====
+				tableRecord = M2MDataFrame_next(tableRecord);
+				}
+			//===== In the case of record persistence =====
+			if (persistence==true)
+				{
+				//===== End transaction =====
+				M2MSQLite_commitTransaction(M2MCEP_getFileDatabase(self));
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Transaction processing for inserting records into SQLite database on file has ended");
+				}
+			//===== In case of record non-persistence =====
+			else
+				{
+				// do nothing
+				}
+			//===== Successful completion =====
+			return self;
+			}
+		//===== Error handling =====
+		else if (tableManager==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table building object obtained from argument \"CEP\" object is NULL");
+			return NULL;
+			}
+		else if (tableRecord==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Table record management object obtained from argument \"CEP\" object is NULL");
+			return NULL;
+			}
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The upper limit of the number of CEP records per table obtained from argument \"CEP\" object is less than or equal to 0");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Insert all records (= CEPRecord-> newRecordList) held by CEP object variables <br>
+ * into SQLite3 database in memory.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of records where insert processing or -1 (in case of error)
+ */
+static int this_insertRecordListToMemoryDatabase (M2MCEP *self)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	M2MStatementCache *memoryStatementCache = NULL;
+	M2MTableManager *tableManager = NULL;
+	M2MDataFrame *record = NULL;
+	int numberOfRecord = 0;
+	int result = 0;
+	unsigned int maxRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecordListToMemoryDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Get database and record management object =====
+		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (memoryStatementCache=this_getMemoryStatementCache(self))!=NULL
+				&& (tableManager=this_getTableManager(self))!=NULL
+				&& (record=M2MDataFrame_begin(this_getDataFrame(self)))!=NULL)
+			{
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Insert records into SQLite database in memory");
+			//===== Start Transaction =====
+			M2MSQLite_beginTransaction(memoryDatabase);
+			//===== Repeat until record management object reaches the end =====
+			while (record!=NULL)
+				{
+				//===== Skip the table without new record =====
+				if (M2MList_isEmpty(M2MDataFrame_getNewRecordList(record))==true)
+					{
+					// do nothing
+					}
+				//===== Batch insertion of records in the same table =====
+				else if ((result=this_insertRecordList(memoryStatementCache, record, tableManager, M2MDataFrame_getNewRecordList(record)))>0)
+					{
+					//===== Keep a copy of the records in the record window =====
+					if (this_isShadowRecord(self, record)==true)
+						{
+						//===== Secure slots of the record window for the maximum number of records (the current records in case of time window) and this batch =====
+						M2MRingBuffer_reserve(M2MDataFrame_getOldRecordList(record), ((maxRecord=this_getWindowMaxRecord(self, record))>0 ? maxRecord : M2MDataFrame_getWindowLength(record))+result);
+						//===== Move new inserted record to past record =====
+						M2MDataFrame_moveFromNewRecordListToOldRecordList(record);
+						}
+					//===== SQLite3 database in memory is the only holder of the records =====
+					else
+						{
+						M2MDataFrame_clearNewRecordList(record);
+						}
+					//===== Update the number of records and the last rowid held in SQLite3 database in memory =====
+					M2MDataFrame_setWindowLength(record, M2MDataFrame_getWindowLength(record)+result);
+					M2MDataFrame_setLastRowid(record, (int64_t)sqlite3_last_insert_rowid(memoryDatabase));
+					//===== Number the inserted records for the write-ahead log =====
+					if (M2MDataFrame_getPersistedSequence(record)>=0)
+						{
+						M2MDataFrame_setSequence(record, M2MDataFrame_getSequence(record)+result);
+						}
+					else
+						{
+						// do nothing
+						}
+					//===== Count the number of inserted records =====
+					numberOfRecord += result;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite database in memory");
+					}
+				//===== Proceed to the next record information object =====
+				record = M2MDataFrame_next(record);
+				}
+			//===== Commit =====
+			M2MSQLite_commitTransaction(memoryDatabase);
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished inserting records into SQLite database in memory");
+			//===== Returns the number of inserted records =====
+			return numberOfRecord;
+			}
+		//===== Error handling =====
+		else if (memoryDatabase==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The SQLite3 memory object obtained from the argument CEP object is NULL");
+			return -1;
+			}
+		else if (memoryStatementCache==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The prepared statement cache obtained from the argument CEP object is NULL");
+			return -1;
+			}
+		else if (tableManager==NULL)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object obtained from the argument CEP object is NULL");
+			return -1;
+			}
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The record management object obtained from the argument CEP object is NULL");
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Insert typed records into the table of SQLite 3 database for CEP. <br>
+ * Unlike M2MCEP_insertCSV(), values are bound to the prepared INSERT statement <br>
+ * as they are (without formatting into or parsing from CSV format string), so <br>
+ * this is suitable for high frequency ingestion. <br>
+ * The inserted records are subject to the same record window, eviction and <br>
+ * persistence as M2MCEP_insertCSV(). Records of the table are kept only in the <br>
+ * SQLite3 database in memory (not copied into the record management object) <br>
+ * until they are evicted. <br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order (values of a row are arranged in the column order of the table definition)
+ * @param[in] rows		Number of records[row]
+ * @param[in] columns	Number of values per record (must match the number of columns of the table)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+static int this_insertRecords (M2MCEP *self, const M2MString *tableName, const M2MCEPValue *values, const size_t rows, const size_t columns)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	M2MStatementCache *memoryStatementCache = NULL;
+	sqlite3_stmt *statement = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MDataFrame *record = NULL;
+	M2MString *columnNameCSV = NULL;
+	M2MString *insertSQL = NULL;
+	const M2MCEPValue *value = NULL;
+	size_t i = 0;
+	size_t j = 0;
+	int numberOfRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecords()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && values!=NULL && rows>0 && columns>0)
+		{
+		//===== Get INSERT statement of SQLite3 database in memory =====
+		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (memoryStatementCache=this_getMemoryStatementCache(self))!=NULL
+				&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), tableName)))!=NULL
+				&& M2MColumnList_length(columnList)==columns
+				&& this_createColumnNameCSV(columnList, &columnNameCSV)!=NULL
+				&& (record=M2MDataFrame_setTable(this_getDataFrame(self), tableName, columnNameCSV))!=NULL
+				&& ((statement=M2MStatementCache_search(memoryStatementCache, tableName, columnNameCSV))!=NULL
+					|| (this_createInsertSQL(tableName, columnNameCSV, columns, &insertSQL)!=NULL
+						&& (statement=M2MStatementCache_put(memoryStatementCache, tableName, columnNameCSV, insertSQL))!=NULL)))
+			{
+			//===== Keep the order with the records accumulated for group commit =====
+			this_commitRecord(self);
+			//===== Append the records to the write-ahead log =====
+			this_writeLog(self, tableName, NULL, values, rows, columns);
+			//===== Start Transaction =====
+			M2MSQLite_beginTransaction(memoryDatabase);
+			//===== Repeat as many records =====
+			for (i=0; i<rows; i++)
+				{
+				//===== Bind values of the record =====
+				for (j=0, value=&(values[i*columns]); j<columns; j++)
+					{
+					if (M2MCEPValue_bind(&(value[j]), (unsigned int)(j+1), statement)==false)
+						{
+						break;
+						}
+					//===== In case of success =====
+					else
+						{
+						// do nothing
+						}
+					}
+				//===== Execute INSERT statement =====
+				if (j==columns && M2MSQLite_next(statement)==SQLITE_DONE)
+					{
+					numberOfRecord++;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)sqlite3_errmsg(memoryDatabase));
+					}
+				//===== Prepare the statement for the next record =====
+				sqlite3_reset(statement);
+				}
+			//===== Commit =====
+			M2MSQLite_commitTransaction(memoryDatabase);
+			//===== Release heap memory area =====
+			M2MHeap_free(insertSQL);
+			M2MHeap_free(columnNameCSV);
+			//===== The copy of the record window no longer covers the table =====
+			M2MRingBuffer_clear(M2MDataFrame_getOldRecordList(record));
+			//===== Update the number of records and the last rowid held in SQLite3 database in memory =====
+			M2MDataFrame_setWindowLength(record, M2MDataFrame_getWindowLength(record)+numberOfRecord);
+			if (numberOfRecord>0)
+				{
+				M2MDataFrame_setLastRowid(record, (int64_t)sqlite3_last_insert_rowid(memoryDatabase));
+				//===== Number the inserted records for the write-ahead log =====
+				if (M2MDataFrame_getPersistedSequence(record)>=0)
+					{
+					M2MDataFrame_setSequence(record, M2MDataFrame_getSequence(record)+numberOfRecord);
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Update record counters for vacuum processing =====
+			this_updateRecordCounter(self, numberOfRecord);
+			//===== Add the inserted records to the aggregates =====
+			this_updateAggregate(self);
+			//===== Give the inserted records to the event patterns before eviction =====
+			this_evaluatePattern(self);
+			//===== Notify the committed records =====
+			this_notifyCommit(self, numberOfRecord);
+			//===== Move excess records into SQLite3 database file for persistence =====
+			if (this_insertRecordListToFileDatabase(self)!=NULL)
+				{
+				//===== Evaluate continuous queries over the updated window =====
+				this_evaluateQuery(self);
+				//===== Execute vacuum processing to SQLite3 databases =====
+				this_checkRecordCounterForVacuum(self);
+				//===== Return number of records =====
+				return numberOfRecord;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite3 database on file");
+				return -1;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			//===== Release heap memory area =====
+			M2MHeap_free(insertSQL);
+			M2MHeap_free(columnNameCSV);
+			//===== Output error message =====
+			if (memoryDatabase==NULL)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The SQLite3 memory object obtained from the argument CEP object is NULL");
+				}
+			else if (memoryStatementCache==NULL)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The prepared statement cache obtained from the argument CEP object is NULL");
+				}
+			else if (columnList==NULL)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The column structure object of the table specified by the argument is NULL");
+				}
+			else if (M2MColumnList_length(columnList)!=columns)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The number of values per record specified by the argument doesn't match the number of columns of the table");
+				}
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get the INSERT statement of SQLite3 database in memory");
+				}
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (tableName==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
+		return -1;
+		}
+	else if (values==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The array of typed values specified by the argument is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The number of records or values specified by the argument is 0");
+		return -1;
+		}
+	}
+
+
+
+/**
+ * Check whether background persistence is running.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				true: records are handed off to the persistence thread, false: records are inserted by the caller
+ */
+static bool this_isBackgroundPersistence (M2MCEP *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return atomic_load(&(self->persistenceRunning));
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Check whether the records accumulated for group commit reach one of the <br>
+ * limits (number of records, size of CSV strings or delay).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			true: commit now, false: keep accumulating
+ */
+static bool this_isGroupCommitDue (const M2MCEP *self)
+	{
+	//===== In case of commit per call =====
+	if (self->groupCommitMaxRecord==0)
+		{
+		return true;
+		}
+	//===== When the number of records is reached =====
+	else if (self->pendingRecord>=self->groupCommitMaxRecord)
+		{
+		return true;
+		}
+	//===== When the size of CSV strings is reached =====
+	else if (self->groupCommitMaxByte>0 && self->pendingByte>=self->groupCommitMaxByte)
+		{
+		return true;
+		}
+	//===== When the delay is reached =====
+	else if (self->groupCommitMaxDelay>0 && this_getMonotonicTime()-self->pendingTime>=self->groupCommitMaxDelay)
+		{
+		return true;
+		}
+	//===== Keep accumulating =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Check whether all records written into the segment file of the write-ahead <br>
+ * log (or before) have left the SQLite3 database in memory, that is the oldest <br>
+ * record held in memory of every table is newer than the mark.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] segment	Number of the closed segment file
+ * @return				true: the segment file can be removed, false: not yet
+ */
+static bool this_isLogSegmentRemovable (M2MCEP *self, const uint32_t segment)
+	{
+	//========== Variable ==========
+	M2MCEPLogMark *mark = NULL;
+	M2MDataFrame *record = NULL;
+
+	//===== Repeat as many marks of the segment =====
+	for (mark=self->logMark; mark!=NULL && mark->segment<=segment; mark=mark->next)
+		{
+		if (mark->segment==segment)
+			{
+			//===== Search the table =====
+			for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+				{
+				if (this_equalsName(M2MDataFrame_getTableName(record), mark->tableName)==true)
+					{
+					break;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== Records up to the mark are still held in memory =====
+			if (record!=NULL
+					&& M2MDataFrame_getLastRowid(record)-(int64_t)M2MDataFrame_getWindowLength(record)<mark->lastRowid)
+				{
+				return false;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	return true;
+	}
+
+
+/**
+ * Check whether the record window of the table is copied into the record <br>
+ * management object besides the SQLite3 database in memory.<br>
+ * Even if the copy is enabled, it is not available while the table holds <br>
+ * records inserted without CSV format string (the records exist only in the <br>
+ * SQLite3 database in memory) nor for the table with the column store (the <br>
+ * typed values of the evicted records are read back from the SQLite3 <br>
+ * database in memory).<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] record	Record management object of the table
+ * @return				true: copy is available, false: SQLite3 database in memory is the only holder
+ */
+static bool this_isShadowRecord (const M2MCEP *self, const M2MDataFrame *record)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_isShadowRecord()";
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL)
+		{
+		//===== Copy is available only when it covers all records in memory =====
+		if (this_getShadowRecord(self)==true
+				&& M2MRingBuffer_length(M2MDataFrame_getOldRecordList(record))==M2MDataFrame_getWindowLength(record)
+				&& this_getColumnStore(self, M2MDataFrame_getTableName(record))==NULL)
+			{
+			return true;
+			}
+		//===== In case of no copy =====
+		else
+			{
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return false;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame\" structure object is NULL");
+		return false;
+		}
+	}
+
+
+/**
+ * Load the sequence number of the last persisted record of the table (once) <br>
+ * and continue the numbering of the records for the write-ahead log after it.<br>
+ * The records of the window restored from the snapshot are numbered with the <br>
+ * sequence number recorded in the snapshot; those persisted after the <br>
+ * snapshot (before a crash) aren't persisted again.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] record	Record management object of the table
+ */
+static void this_loadSequence (M2MCEP *self, M2MDataFrame *record)
+	{
+	//========== Variable ==========
+	int64_t persistedSequence = 0;
+	int64_t sequence = 0;
+	int64_t lastRowid = 0;
+	int64_t oldestRowid = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL && M2MDataFrame_getPersistedSequence(record)<0)
+		{
+		persistedSequence = this_readPersistedSequence(self, M2MDataFrame_getTableName(record));
+		lastRowid = M2MDataFrame_getLastRowid(record);
+		oldestRowid = lastRowid - (int64_t)M2MDataFrame_getWindowLength(record);
+		//===== Number the records of the window not yet persisted after the persisted ones =====
+		if ((sequence=M2MDataFrame_getSequence(record))<=0)
+			{
+			sequence = persistedSequence + lastRowid - ((M2MDataFrame_getPersistedRowid(record)>oldestRowid) ? M2MDataFrame_getPersistedRowid(record) : oldestRowid);
+			}
+		//===== Skip the restored records persisted after the snapshot =====
+		else if (persistedSequence>sequence-(int64_t)M2MDataFrame_getWindowLength(record)
+				&& lastRowid-(sequence-((persistedSequence<sequence) ? persistedSequence : sequence))>M2MDataFrame_getPersistedRowid(record))
+			{
+			M2MDataFrame_setPersistedRowid(record, lastRowid-(sequence-((persistedSequence<sequence) ? persistedSequence : sequence)));
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MDataFrame_setSequence(record, (sequence>persistedSequence) ? sequence : persistedSequence);
+		M2MDataFrame_setPersistedSequence(record, persistedSequence);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Add the number of committed records to the counter and notify the commit <br>
+ * handler (if set).<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in] numberOfRecord		Number of records committed this time
+ */
+static void this_notifyCommit (M2MCEP *self, const unsigned int numberOfRecord)
+	{
+	//========== Variable ==========
+	unsigned long committedRecord = 0;
+
+	//===== In case of committed records =====
+	if (numberOfRecord>0)
+		{
+		committedRecord = atomic_fetch_add(&(self->committedRecord), numberOfRecord) + numberOfRecord;
+		//===== Notify the handler =====
+		if (self->commitHandler!=NULL)
+			{
+			self->commitHandler(numberOfRecord, committedRecord, self->commitHandlerData);
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== In case of no record =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Create a SQLite 3 database file under the specified directory.<br>
+ * If creation fails, NULL is returned.<br>
+ *
+ * @param[in] databaseName	String indicating database name
+ * @param[in,out] partition	Time partitions of the history (NULL: single database file)
+ * @param[in] tableManager	Table information management object
+ * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
+ * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
+ * @param[in] incrementalVacuum	true: set incremental vacuum (vacuumRecord is ignored)
+ * @return					SQLite3 database file object or NULL (in case of error)
+ */
+static sqlite3 *this_openFileDatabase (const M2MString *databaseName, M2MCEPPartition *partition, const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord, const bool incrementalVacuum)
+	{
+	//========== Variable ==========
+	sqlite3 *fileDatabase = NULL;
+	M2MString *databaseFilePath = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_openFileDatabase()";
+
+	//===== Check argument =====
+	if (databaseName!=NULL && tableManager!=NULL)
+		{
+		//===== Get database file path string (the current partition in case of partitioned history) =====
+		if ((partition!=NULL && M2MCEPPartition_open(partition, time(NULL), &databaseFilePath)!=NULL)
+				|| (partition==NULL && this_getDatabaseFilePath(databaseName, &databaseFilePath)!=NULL))
+			{
+			//===== Open SQLite3 file database =====
+			if ((fileDatabase=M2MSQLite_openDatabase(databaseFilePath))!=NULL)
+				{
+				//===== Release memory space of database file path string =====
+				M2MHeap_free(databaseFilePath);
+				//===== Set character code to UTF-8 =====
+				M2MSQLite_setUTF8(fileDatabase);
+				//===== When incremental vacuum =====
+				if (incrementalVacuum==true)
+					{
+					M2MSQLite_setIncrementalVacuum(fileDatabase);
+					}
+				//===== When automatic vacuum OFF =====
+				else if (vacuumRecord>0)
+					{
+					M2MSQLite_setAutoVacuum(fileDatabase, false);
+					}
+				//===== When automatic vacuum ON =====
+				else
+					{
+					M2MSQLite_setAutoVacuum(fileDatabase, true);
+					}
+				//===== Set synchronous mode =====
+				M2MSQLite_setSynchronous (fileDatabase, synchronous);
+				//===== Construct a table =====
+				M2MTableManager_createTable((M2MTableManager *)tableManager, fileDatabase);
+				//===== Return SQLite3 database object =====
+				return fileDatabase;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to open SQLite3 file database");
+				//===== Release memory space of database file path string =====
+				M2MHeap_free(databaseFilePath);
+				return NULL;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to get string indicating the file path of the SQLite database");
+			return NULL;
+			}
+		}
+	//===== Error handling =====
+	else if (databaseName==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The string indicating the SQLite database name on the file is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The table construction object specified by the argument is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Open a dedicated SQLite3 connection on the history of records and attach <br>
+ * the partition files overlapping the time range (or the single SQLite3 <br>
+ * database file) read-only. Every table is a temporary view joining the <br>
+ * attached files with UNION ALL, which takes precedence over the empty table <br>
+ * created in the connection itself (answering when no file is attached).<br>
+ * With "sql", the record window of the tables read by the SELECT statement <br>
+ * (collected by preparing it before locking) is copied from SQLite3 database <br>
+ * in memory into the connection (after the records handed off to the <br>
+ * background persistence thread are committed) and joined to the views as <br>
+ * well. The CEP object is locked only while those records are copied and the <br>
+ * files are attached.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] from		Start of the time range (UNIX time)[sec]
+ * @param[in] to		End of the time range (inclusive, UNIX time)[sec]
+ * @param[in] sql		String indicating SELECT statement joining the record window or NULL (the history only)
+ * @return				SQLite3 connection on the history or NULL (in case of error)
+ */
+static sqlite3 *this_openHistoryDatabase (M2MCEP *self, const time_t from, const time_t to, const M2MString *sql)
+	{
+	//========== Variable ==========
+	sqlite3 *database = NULL;
+	sqlite3_stmt *attachStatement = NULL;
+	sqlite3_stmt *tableStatement = NULL;
+	time_t *startTimeArray = NULL;
+	M2MString *filePath = NULL;
+	M2MString *viewSQL = NULL;
+	M2MString *tableName = NULL;
+	M2MFile *file = NULL;
+	M2MCEPQuery *query = NULL;
+	M2MCEPQueryTable *table = NULL;
+	int numberOfPartition = 0;
+	int numberOfSchema = 0;
+	int i = 0;
+	M2MString SCHEMA[64];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_openHistoryDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Open the connection with the empty tables =====
+		if ((database=M2MSQLite_openDatabase(M2MSQLite_MEMORY_DATABASE))!=NULL
+				&& (attachStatement=M2MSQLite_getPreparedStatement(database, (M2MString *)"ATTACH DATABASE ? AS ?"))!=NULL)
+			{
+			M2MTableManager_createTable(this_getTableManager(self), database);
+			//===== Collect the tables read by the SQL statement (on the empty tables) =====
+			if (sql!=NULL
+					&& (query=(M2MCEPQuery *)M2MHeap_malloc(sizeof(M2MCEPQuery)))!=NULL)
+				{
+				sqlite3_set_authorizer(database, this_authorizeQuery, query);
+				sqlite3_prepare_v2(database, (const char *)sql, -1, &(query->statement), NULL);
+				sqlite3_set_authorizer(database, NULL, NULL);
+				sqlite3_finalize(query->statement);
+				query->statement = NULL;
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Exclusive access to the record window and the partitions =====
+			pthread_mutex_lock(&(self->lock));
+			//===== In case of joining the record window =====
+			if (query!=NULL)
+				{
+				//===== Make the records accumulated for group commit visible =====
+				this_commitRecord(self);
+				//===== Wait for the records having left the window into the background persistence thread =====
+				pthread_mutex_lock(&(self->persistenceMutex));
+				while (atomic_load(&(self->persistenceRunning))==true
+						&& self->persistedRecord<self->handedOffRecord)
+					{
+					pthread_cond_wait(&(self->persistenceCondition), &(self->persistenceMutex));
+					}
+				pthread_mutex_unlock(&(self->persistenceMutex));
+				//===== Copy the record window of the tables read by the SQL statement into the connection =====
+				M2MSQLite_beginTransaction(database);
+				for (table=query->table; table!=NULL; table=table->next)
+					{
+					if (this_getTableDataFrame(self, table->tableName)!=NULL
+							&& this_copyTable(self, database, table->tableName)<0)
+						{
+						M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to copy the record window into the SQLite3 connection on the history");
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				M2MSQLite_commitTransaction(database);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Search the partition files overlapping the time range =====
+			if (self->partition!=NULL)
+				{
+				if ((numberOfPartition=M2MCEPPartition_list(self->partition, from, to, &startTimeArray))>sqlite3_limit(database, SQLITE_LIMIT_ATTACHED, -1))
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The time range overlaps more partition files than SQLite3 can attach");
+					numberOfPartition = -1;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== The single SQLite3 database file =====
+			else if (this_getPersistence(self)==true
+					&& this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &filePath)!=NULL
+					&& (file=M2MFile_new(filePath))!=NULL)
+				{
+				numberOfPartition = (M2MFile_exists(file)==true) ? 1 : 0;
+				M2MFile_delete(&file);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Attach the files =====
+			for (i=0; i<numberOfPartition; i++)
+				{
+				//===== Pathname of the partition file =====
+				if (self->partition!=NULL)
+					{
+					M2MHeap_free(filePath);
+					M2MCEPPartition_createFilePath(self->partition, startTimeArray[i], &filePath);
+					}
+				else
+					{
+					// do nothing
+					}
+				memset(SCHEMA, 0, sizeof(SCHEMA));
+				snprintf(SCHEMA, sizeof(SCHEMA)-1, (M2MString *)"h%d", i);
+				if (filePath!=NULL
+						&& sqlite3_bind_text(attachStatement, 1, filePath, -1, SQLITE_TRANSIENT)==SQLITE_OK
+						&& sqlite3_bind_text(attachStatement, 2, SCHEMA, -1, SQLITE_TRANSIENT)==SQLITE_OK
+						&& M2MSQLite_next(attachStatement)==SQLITE_DONE)
+					{
+					numberOfSchema++;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(database));
+					}
+				sqlite3_reset(attachStatement);
+				}
+			pthread_mutex_unlock(&(self->lock));
+			this_deleteQuery(&query);
+			M2MHeap_free(startTimeArray);
+			M2MHeap_free(filePath);
+			M2MSQLite_closeStatement(attachStatement);
+			//===== Create the views joining the attached files =====
+			if (numberOfSchema>0
+					&& (tableStatement=M2MSQLite_getPreparedStatement(database, (M2MString *)"SELECT name FROM main.sqlite_master WHERE type = 'table' "))!=NULL)
+				{
+				while (M2MSQLite_next(tableStatement)==SQLITE_ROW)
+					{
+					tableName = (M2MString *)sqlite3_column_text(tableStatement, 0);
+					M2MString_append(&viewSQL, (M2MString *)"CREATE TEMP VIEW ");
+					M2MString_append(&viewSQL, tableName);
+					M2MString_append(&viewSQL, (M2MString *)" AS ");
+					//===== The record window copied into the connection =====
+					if (sql!=NULL)
+						{
+						M2MString_append(&viewSQL, (M2MString *)"SELECT * FROM main.");
+						M2MString_append(&viewSQL, tableName);
+						M2MString_append(&viewSQL, (M2MString *)" ");
+						}
+					else
+						{
+						// do nothing
+						}
+					for (i=0; i<numberOfSchema; i++)
+						{
+						memset(SCHEMA, 0, sizeof(SCHEMA));
+						snprintf(SCHEMA, sizeof(SCHEMA)-1, (M2MString *)"%sSELECT * FROM h%d.", (i==0 && sql==NULL) ? "" : "UNION ALL ", i);
+						M2MString_append(&viewSQL, SCHEMA);
+						M2MString_append(&viewSQL, tableName);
+						M2MString_append(&viewSQL, (M2MString *)" ");
+						}
+					if (viewSQL==NULL || M2MSQLite_executeUpdate(database, viewSQL)==false)
+						{
+						M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to create the view joining the attached files");
+						}
+					else
+						{
+						// do nothing
+						}
+					M2MHeap_free(viewSQL);
+					}
+				M2MSQLite_closeStatement(tableStatement);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== The history is only read =====
+			M2MSQLite_executeUpdate(database, (M2MString *)"PRAGMA query_only = ON");
+			return database;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to open the SQLite3 connection on the history");
+			M2MSQLite_closeDatabase(database);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Create a SQLite3 database on memory.<br>
+ * If creation fails, NULL is returned.<br>
+ *
+ * @param[in] tableManager	Table information management object
+ * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
+ * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
+ * @param[in] incrementalVacuum	true: set incremental vacuum (vacuumRecord is ignored)
+ * @return					SQLite3 database object or NULL (in case of error)
+ */
+static sqlite3 *this_openMemoryDatabase (const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord, const bool incrementalVacuum)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	const M2MString *MEMORY_DATABASE = (M2MString *)":memory:";
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_openMemoryDatabase()";
+
+	//===== Open SQLite3 memory database =====
+	if ((memoryDatabase=M2MSQLite_openDatabase(MEMORY_DATABASE))!=NULL)
+		{
+		//===== Set character code to UTF-8 =====
+		M2MSQLite_setUTF8(memoryDatabase);
+		//===== When incremental vacuum =====
+		if (incrementalVacuum==true)
+			{
+			M2MSQLite_setIncrementalVacuum(memoryDatabase);
+			}
+		//===== When automatic vacuum OFF =====
+		else if (vacuumRecord>0)
+			{
+			//===== Set the vacuum setting =====
+			M2MSQLite_setAutoVacuum(memoryDatabase, false);
+			}
+		//===== When automatic vacuum ON =====
+		else
+			{
+			//===== Set the vacuum setting =====
+			M2MSQLite_setAutoVacuum(memoryDatabase, true);
+			}
+		//===== Set synchronous mode =====
+		M2MSQLite_setSynchronous (memoryDatabase, synchronous);
+		//===== Construct a table =====
+		M2MTableManager_createTable((M2MTableManager *)tableManager, memoryDatabase);
+		//===== Return SQLite3 database object in memory =====
+		return memoryDatabase;
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to open SQLite database on memory");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Insert the records of the batch into the SQLite3 database on file (called <br>
+ * by the background persistence thread inside a transaction).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] batch		Batch of records
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+static int this_persistBatch (M2MCEP *self, const M2MCEPPersistenceBatch *batch)
+	{
+	//========== Variable ==========
+	M2MStatementCache *fileStatementCache = NULL;
+	M2MColumnList *columnList = NULL;
+	sqlite3_stmt *statement = NULL;
+	M2MString *insertSQL = NULL;
+	M2MSQLiteDataType DATA_TYPE_ARRAY[M2MSQLite_getMaxColumnLength(M2MCEP_getFileDatabase(self))];
+	unsigned int dataTypeArrayLength = 0;
+	unsigned int numberOfRecord = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_persistBatch()";
+
+	//===== Check argument =====
+	if (self!=NULL && batch!=NULL)
+		{
+		//===== Get INSERT statement of SQLite3 database on file =====
+		if ((fileStatementCache=this_getFileStatementCache(self))!=NULL
+				&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), batch->tableName)))!=NULL
+				&& (batch->csv==NULL
+					|| (dataTypeArrayLength=this_getDataTypeArray(columnList, batch->columnNameCSV, DATA_TYPE_ARRAY, sizeof(DATA_TYPE_ARRAY)))>0)
+				&& ((statement=M2MStatementCache_search(fileStatementCache, batch->tableName, batch->columnNameCSV))!=NULL
+					|| (this_createInsertSQL(batch->tableName, batch->columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
+						&& (statement=M2MStatementCache_put(fileStatementCache, batch->tableName, batch->columnNameCSV, insertSQL))!=NULL)))
+			{
+			//===== Repeat with records =====
+			for (i=0; i<batch->numberOfRecord; i++)
+				{
+				//===== Bind CSV string =====
+				if (batch->csv!=NULL)
+					{
+					if (this_setCSVIntoPreparedStatement(batch->csv[i], DATA_TYPE_ARRAY, dataTypeArrayLength, statement)==false)
+						{
+						M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The number of fields of the record does not match the number of columns");
+						sqlite3_reset(statement);
+						continue;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				//===== Bind SQLite3 values =====
+				else
+					{
+					for (j=0; j<batch->numberOfColumn; j++)
+						{
+						sqlite3_bind_value(statement, j+1, batch->value[i*batch->numberOfColumn+j]);
+						}
+					}
+				//===== Execute INSERT =====
+				if (M2MSQLite_next(statement)==SQLITE_DONE)
+					{
+					numberOfRecord++;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(fileStatementCache)));
+					}
+				sqlite3_reset(statement);
+				}
+			//===== Record the last persisted record for the write-ahead log =====
+			if (batch->sequence>=0)
+				{
+				this_setPersistedSequence(self, fileStatementCache, batch->tableName, batch->sequence);
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MHeap_free(insertSQL);
+			return numberOfRecord;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare INSERT statement for inserting handed off records into SQLite 3 database on file");
+			M2MHeap_free(insertSQL);
+			return -1;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated batch is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Read the sequence number of the last persisted record of the table from <br>
+ * the SQLite3 database file (the newest partition file recording it in case <br>
+ * of time partitions). The files are read with a dedicated read-only <br>
+ * connection, so the thread owning the SQLite3 database on file isn't <br>
+ * disturbed.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Sequence number of the last persisted record (0 if none)
+ */
+static int64_t this_readPersistedSequence (M2MCEP *self, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	sqlite3 *database = NULL;
+	sqlite3_stmt *statement = NULL;
+	M2MFile *file = NULL;
+	M2MString *filePath = NULL;
+	time_t *startTimeArray = NULL;
+	int64_t persistedSequence = 0;
+	int numberOfFile = 0;
+	int i = 0;
+	M2MString SQL[128];
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && this_getPersistence(self)==true)
+		{
+		memset(SQL, 0, sizeof(SQL));
+		snprintf(SQL, sizeof(SQL)-1, (M2MString *)"SELECT sequence FROM %s WHERE tableName = ? ", M2MCEP_SEQUENCE_TABLE);
+		//===== Search the partition files =====
+		if (self->partition!=NULL)
+			{
+			numberOfFile = M2MCEPPartition_list(self->partition, 0, time(NULL), &startTimeArray);
+			}
+		//===== The single SQLite3 database file =====
+		else if (this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &filePath)!=NULL
+				&& (file=M2MFile_new(filePath))!=NULL)
+			{
+			numberOfFile = (M2MFile_exists(file)==true) ? 1 : 0;
+			M2MFile_delete(&file);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Read the files from the newest (the table is missing until the first record) =====
+		for (i=numberOfFile-1; i>=0 && persistedSequence==0; i--)
+			{
+			if (self->partition!=NULL)
+				{
+				M2MHeap_free(filePath);
+				M2MCEPPartition_createFilePath(self->partition, startTimeArray[i], &filePath);
+				}
+			else
+				{
+				// do nothing
+				}
+			if (filePath!=NULL
+					&& sqlite3_open_v2(filePath, &database, SQLITE_OPEN_READONLY, NULL)==SQLITE_OK
+					&& sqlite3_prepare_v2(database, SQL, -1, &statement, NULL)==SQLITE_OK
+					&& sqlite3_bind_text(statement, 1, tableName, -1, SQLITE_STATIC)==SQLITE_OK
+					&& M2MSQLite_next(statement)==SQLITE_ROW)
+				{
+				persistedSequence = (int64_t)sqlite3_column_int64(statement, 0);
+				}
+			else
+				{
+				// do nothing
+				}
+			sqlite3_finalize(statement);
+			statement = NULL;
+			sqlite3_close(database);
+			database = NULL;
+			}
+		M2MHeap_free(startTimeArray);
+		M2MHeap_free(filePath);
+		}
+	else
+		{
+		// do nothing
+		}
+	return persistedSequence;
+	}
+
+
+/**
+ * Give back the prepared statement got with this_getSelectStatement().<br>
+ * A read-only statement is reset and stays cached. Any other statement may <br>
+ * have changed the schema, so all cached SELECT and INSERT statements <br>
+ * (including this one) are finalized.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] statement	Prepared statement got with this_getSelectStatement()
+ */
+static void this_releaseSelectStatement (M2MCEP *self, sqlite3_stmt *statement)
+	{
+	//===== Check argument =====
+	if (self!=NULL && statement!=NULL)
+		{
+		//===== Keep the read-only statement for reuse =====
+		if (sqlite3_stmt_readonly(statement)!=0)
+			{
+			sqlite3_reset(statement);
+			}
+		//===== The schema may have been changed =====
+		else
+			{
+			M2MStatementCache_clear(self->selectStatementCache);
+			M2MStatementCache_clear(self->memoryStatementCache);
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Handler of M2MCEPLog_replay() inserting one entry of the write-ahead log <br>
+ * into the SQLite3 database in memory (the log is detached while replaying, <br>
+ * so the entry isn't written again).<br>
+ * The records already persisted into the SQLite3 database on file before <br>
+ * the crash (numbered up to the recorded sequence number of the table) have <br>
+ * left the window then, so they are skipped.<br>
+ *
+ * @param[in] tableName		String indicating the table name
+ * @param[in] sequence		Sequence number of the first record of the entry in the table
+ * @param[in] csv			String in CSV format or NULL
+ * @param[in] values		Array of typed values or NULL
+ * @param[in] rows			Number of records of "values"
+ * @param[in] columns		Number of values per record of "values"
+ * @param[in,out] userData	CEP structure object
+ */
+static void this_replayLog (const M2MString *tableName, const int64_t sequence, const M2MString *csv, const M2MCEPValue *values, const size_t rows, const size_t columns, void *userData)
+	{
+	//========== Variable ==========
+	M2MCEP *self = (M2MCEP *)userData;
+	M2MDataFrame *record = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MString *columnNameCSV = NULL;
+	M2MString *restCSV = NULL;
+	M2MString *lineEnd = NULL;
+	int64_t skippedRecord = 0;
+
+	//===== Commit the previous entries so that the records are numbered in order =====
+	this_commitRecord(self);
+	//===== Get the record management object of the table (created before the eviction of the entry) =====
+	if ((record=this_getTableDataFrame(self, tableName))!=NULL)
+		{
+		}
+	else if (csv!=NULL
+			&& (lineEnd=M2MString_indexOf(csv, M2MString_CRLF))!=NULL
+			&& M2MString_appendLength(&columnNameCSV, csv, M2MString_length(csv)-M2MString_length(lineEnd))!=NULL)
+		{
+		record = M2MDataFrame_setTable(this_getDataFrame(self), tableName, columnNameCSV);
+		}
+	else if (csv==NULL
+			&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), tableName)))!=NULL
+			&& this_createColumnNameCSV(columnList, &columnNameCSV)!=NULL)
+		{
+		record = M2MDataFrame_setTable(this_getDataFrame(self), tableName, columnNameCSV);
+		}
+	else
+		{
+		// do nothing
+		}
+	M2MHeap_free(columnNameCSV);
+	//===== Number of the records already persisted =====
+	if (record!=NULL)
+		{
+		this_loadSequence(self, record);
+		skippedRecord = (M2MDataFrame_getPersistedSequence(record)>=sequence) ? M2MDataFrame_getPersistedSequence(record)-sequence+1 : 0;
+		}
+	else
+		{
+		// do nothing
+		}
+	//===== In case of CSV string =====
+	if (csv!=NULL)
+		{
+		if (skippedRecord==0)
+			{
+			M2MDataFrame_setSequence(record, sequence-1);
+			this_insertCSV(self, tableName, csv);
+			}
+		else if (this_skipCSVRecord(csv, (size_t)skippedRecord, &restCSV)!=NULL)
+			{
+			M2MDataFrame_setSequence(record, sequence+skippedRecord-1);
+			this_insertCSV(self, tableName, restCSV);
+			M2MHeap_free(restCSV);
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== In case of typed values =====
+	else if ((size_t)skippedRecord<rows)
+		{
+		M2MDataFrame_setSequence(record, sequence+skippedRecord-1);
+		this_insertRecords(self, tableName, &(values[(size_t)skippedRecord*columns]), rows-(size_t)skippedRecord, columns);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Restore the snapshot file saved by M2MCEP_checkpoint() into the SQLite3 <br>
+ * database in memory just opened, with the online backup API (one bulk copy <br>
+ * of the database pages), and set the number of records and the last rowid <br>
+ * of each restored table into the record management object.<br>
+ * If the snapshot file doesn't exist or is broken, the database stays empty.<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in,out] memoryDatabase	SQLite3 database in memory just opened
+ * @return							Number of restored records or -1 (in case of error)
+ */
+static int this_restoreMemoryDatabase (M2MCEP *self, sqlite3 *memoryDatabase)
+	{
+	//========== Variable ==========
+	sqlite3 *snapshotDatabase = NULL;
+	sqlite3_backup *backup = NULL;
+	sqlite3_stmt *tableStatement = NULL;
+	sqlite3_stmt *countStatement = NULL;
+	M2MTableManager *tableManager = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MDataFrame *record = NULL;
+	M2MFile *file = NULL;
+	M2MString *snapshotFilePath = NULL;
+	M2MString *columnNameCSV = NULL;
+	M2MString *countSQL = NULL;
+	const M2MString *tableName = NULL;
+	unsigned int windowLength = 0;
+	int64_t lastRowid = 0;
+	int numberOfRecord = 0;
+	bool exists = false;
+	bool persisted = false;
+	M2MString MESSAGE[256];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_restoreMemoryDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL && memoryDatabase!=NULL && (tableManager=this_getTableManager(self))!=NULL)
+		{
+		//===== Confirm the snapshot file =====
+		if (this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &snapshotFilePath)!=NULL
+				&& M2MString_append(&snapshotFilePath, M2MCEP_SNAPSHOT_EXTENSION)!=NULL
+				&& (file=M2MFile_new(snapshotFilePath))!=NULL)
+			{
+			exists = M2MFile_exists(file);
+			M2MFile_delete(&file);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== In case of no snapshot =====
+		if (exists==false)
+			{
+			M2MHeap_free(snapshotFilePath);
+			return 0;
+			}
+		//===== Copy all pages of the snapshot into the database in memory =====
+		else if (sqlite3_open_v2(snapshotFilePath, &snapshotDatabase, SQLITE_OPEN_READONLY, NULL)==SQLITE_OK
+				&& (backup=sqlite3_backup_init(memoryDatabase, "main", snapshotDatabase, "main"))!=NULL
+				&& sqlite3_backup_step(backup, -1)==SQLITE_DONE
+				&& sqlite3_backup_finish(backup)==SQLITE_OK)
+			{
+			sqlite3_close(snapshotDatabase);
+			M2MHeap_free(snapshotFilePath);
+			self->checkpoint = true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (backup!=NULL) ? M2MSQLite_getErrorMessage(memoryDatabase) : M2MSQLite_getErrorMessage(snapshotDatabase));
+			if (backup!=NULL)
+				{
+				sqlite3_backup_finish(backup);
+				}
+			else
+				{
+				// do nothing
+				}
+			sqlite3_close(snapshotDatabase);
+			M2MHeap_free(snapshotFilePath);
+			//===== Start with the empty window =====
+			M2MTableManager_createTable(tableManager, memoryDatabase);
+			return -1;
+			}
+		//===== Construct the tables added after the snapshot =====
+		M2MTableManager_createTable(tableManager, memoryDatabase);
+		//===== Whether the records were inserted into SQLite3 database on file after the snapshot =====
+		if (sqlite3_prepare_v2(memoryDatabase, (M2MString *)"PRAGMA user_version", -1, &countStatement, NULL)==SQLITE_OK
+				&& M2MSQLite_next(countStatement)==SQLITE_ROW)
+			{
+			persisted = (sqlite3_column_int(countStatement, 0)==1);
+			}
+		else
+			{
+			// do nothing
+			}
+		sqlite3_finalize(countStatement);
+		countStatement = NULL;
+		M2MSQLite_executeUpdate(memoryDatabase, (M2MString *)"PRAGMA user_version = 0");
+		//===== First segment file of the write-ahead log not included in the snapshot =====
+		if (sqlite3_prepare_v2(memoryDatabase, (M2MString *)"PRAGMA application_id", -1, &countStatement, NULL)==SQLITE_OK
+				&& M2MSQLite_next(countStatement)==SQLITE_ROW)
+			{
+			self->logSegment = (uint32_t)sqlite3_column_int(countStatement, 0);
+			}
+		else
+			{
+			// do nothing
+			}
+		sqlite3_finalize(countStatement);
+		countStatement = NULL;
+		//===== Set the restored window of each table into the record management object =====
+		if (sqlite3_prepare_v2(memoryDatabase, (M2MString *)"SELECT name FROM sqlite_master WHERE type = 'table' AND name <> ?", -1, &tableStatement, NULL)==SQLITE_OK
+				&& sqlite3_bind_text(tableStatement, 1, M2MCEP_SEQUENCE_TABLE, -1, SQLITE_STATIC)==SQLITE_OK)
+			{
+			while (M2MSQLite_next(tableStatement)==SQLITE_ROW)
+				{
+				//===== Skip the table unknown to the table manager =====
+				if ((tableName=(const M2MString *)sqlite3_column_text(tableStatement, 0))==NULL
+						|| (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(tableManager, tableName)))==NULL)
+					{
+					continue;
+					}
+				//===== Count the records of the table =====
+				else if (this_createColumnNameCSV(columnList, &columnNameCSV)!=NULL
+						&& M2MString_append(&countSQL, (M2MString *)"SELECT COUNT(*), MAX(rowid) FROM '")!=NULL
+						&& M2MString_append(&countSQL, tableName)!=NULL
+						&& M2MString_append(&countSQL, (M2MString *)"'")!=NULL
+						&& sqlite3_prepare_v2(memoryDatabase, countSQL, -1, &countStatement, NULL)==SQLITE_OK
+						&& M2MSQLite_next(countStatement)==SQLITE_ROW
+						&& (windowLength=(unsigned int)sqlite3_column_int64(countStatement, 0))>0
+						&& (record=M2MDataFrame_setTable(this_getDataFrame(self), tableName, columnNameCSV))!=NULL)
+					{
+					lastRowid = (int64_t)sqlite3_column_int64(countStatement, 1);
+					M2MDataFrame_setWindowLength(record, windowLength);
+					M2MDataFrame_setLastRowid(record, lastRowid);
+					M2MDataFrame_setPersistedRowid(record, (persisted==true) ? lastRowid : 0);
+					numberOfRecord += windowLength;
+					}
+				//===== In case of empty table =====
+				else
+					{
+					// do nothing
+					}
+				sqlite3_finalize(countStatement);
+				countStatement = NULL;
+				M2MHeap_free(countSQL);
+				M2MHeap_free(columnNameCSV);
+				}
+			sqlite3_finalize(tableStatement);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+			sqlite3_finalize(tableStatement);
+			}
+		//===== Sequence numbers of the restored tables for the write-ahead log =====
+		this_restoreSequence(self, memoryDatabase);
+		memset(MESSAGE, 0, sizeof(MESSAGE));
+		snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Restored \"%d\" records from the snapshot of SQLite3 database in memory", numberOfRecord);
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+		return numberOfRecord;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (memoryDatabase==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQLite3 database in memory is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object obtained from the CEP execution object specified by the argument is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Set the sequence numbers recorded in the snapshot into the record <br>
+ * management objects of the restored tables and drop the table of the <br>
+ * sequence numbers from the SQLite3 database in memory.<br>
+ *
+ * @param[in,out] self				CEP structure object
+ * @param[in,out] memoryDatabase	SQLite3 database in memory just restored
+ */
+static void this_restoreSequence (M2MCEP *self, sqlite3 *memoryDatabase)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	M2MDataFrame *record = NULL;
+	M2MString SQL[128];
+
+	//===== Check argument =====
+	if (self!=NULL && memoryDatabase!=NULL)
+		{
+		memset(SQL, 0, sizeof(SQL));
+		snprintf(SQL, sizeof(SQL)-1, (M2MString *)"SELECT tableName, sequence FROM %s ", M2MCEP_SEQUENCE_TABLE);
+		//===== In case of the snapshot recording the sequence numbers =====
+		if (sqlite3_prepare_v2(memoryDatabase, SQL, -1, &statement, NULL)==SQLITE_OK)
+			{
+			while (M2MSQLite_next(statement)==SQLITE_ROW)
+				{
+				if ((record=this_getTableDataFrame(self, (const M2MString *)sqlite3_column_text(statement, 0)))!=NULL)
+					{
+					M2MDataFrame_setSequence(record, (int64_t)sqlite3_column_int64(statement, 1));
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			sqlite3_finalize(statement);
+			memset(SQL, 0, sizeof(SQL));
+			snprintf(SQL, sizeof(SQL)-1, (M2MString *)"DROP TABLE %s ", M2MCEP_SEQUENCE_TABLE);
+			M2MSQLite_executeUpdate(memoryDatabase, SQL);
+			}
+		else
+			{
+			sqlite3_finalize(statement);
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Close the current segment file of the write-ahead log and remove the <br>
+ * segment files which are no longer needed.<br>
+ * The records accumulated for group commit are committed first so that the <br>
+ * marks of the closed segment file cover all of its records.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_rotateLog (M2MCEP *self)
+	{
+	//========== Variable ==========
+	uint32_t segment = 0;
+
+	//===== Check the log =====
+	if (self->log!=NULL)
+		{
+		//===== In case of entries in the current segment file =====
+		if (M2MCEPLog_getSegmentLength(self->log)>0)
+			{
+			this_commitRecord(self);
+			segment = M2MCEPLog_getSegment(self->log);
+			M2MCEPLog_rotate(self->log);
+			this_addLogMark(self, segment);
+			}
+		else
+			{
+			// do nothing
+			}
+		this_truncateLog(self);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Close the SQLite3 database on file when the interval of its time partition <br>
+ * has elapsed, so that the next access opens the partition file of the <br>
+ * current time (and removes the files beyond the retention).<br>
+ * Call this function between transactions on the thread owning the SQLite3 <br>
+ * database on file.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_rotatePartition (M2MCEP *self)
+	{
+	//===== In case the interval of the current partition has elapsed =====
+	if (self!=NULL && self->partition!=NULL && self->fileDatabase!=NULL
+			&& M2MCEPPartition_isExpired(self->partition, time(NULL))==true)
+		{
+		M2MLogger_debug(M2MCEP_getLogger(self), (M2MString *)"M2MCEP.this_rotatePartition()", __LINE__, (M2MString *)"Start a new time partition of SQLite3 database on file");
+		this_closeFileDatabase(self);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Thread function of the asynchronous writer.<br>
+ * Takes CSV strings out of the queue and inserts them into the SQLite3 <br>
+ * databases until the asynchronous mode is stopped and the queue is drained.<br>
+ * While the queue is empty, the thread sleeps until a producer wakes it up.<br>
+ *
+ * @param[in,out] argument	CEP structure object
+ * @return					NULL
+ */
+static void *this_runAsyncWriter (void *argument)
+	{
+	//========== Variable ==========
+	M2MCEP *self = (M2MCEP *)argument;
+	M2MString *item = NULL;
+	bool running = false;
+	uint64_t waitTime = 0;
+	struct timespec timeout;
+	const uint64_t WAIT_TIME = 10000ULL;
+	const long NANOSECOND = 1000000000L;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_runAsyncWriter()";
+
+	//===== Check argument =====
+	if (self!=NULL && self->queue!=NULL)
+		{
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start asynchronous writer thread");
+		//===== Repeat until stopped and drained =====
+		while (true)
+			{
+			//===== Read the flag before polling so that no CSV string is left =====
+			running = atomic_load(&(self->queueRunning));
+			//===== Insert CSV string ("tableName" and "csv" are stored continuously) =====
+			if ((item=(M2MString *)M2MConcurrentQueue_poll(self->queue))!=NULL)
+				{
+				M2MCEP_insertCSV(self, item, &(item[M2MString_length(item)+1]));
+				M2MHeap_free(item);
+				}
+			//===== Stopped and drained =====
+			else if (running==false)
+				{
+				break;
+				}
+			//===== Commit the accumulated records when the delay limit is reached =====
+			else if ((waitTime=this_getAsyncWaitTime(self, WAIT_TIME))==0)
+				{
+				M2MCEP_commit(self);
+				}
+			//===== Wait for CSV string =====
+			else
+				{
+				pthread_mutex_lock(&(self->queueMutex));
+				atomic_store(&(self->queueSleeping), true);
+				//===== Check again after publishing the flag to producers =====
+				if (M2MConcurrentQueue_isEmpty(self->queue)==true
+						&& atomic_load(&(self->queueRunning))==true)
+					{
+					clock_gettime(CLOCK_REALTIME, &timeout);
+					timeout.tv_sec += (time_t)(waitTime / 1000000ULL);
+					timeout.tv_nsec += (long)(waitTime % 1000000ULL) * 1000L;
+					if (timeout.tv_nsec>=NANOSECOND)
+						{
+						timeout.tv_sec++;
+						timeout.tv_nsec -= NANOSECOND;
+						}
+					else
+						{
+						// do nothing
+						}
+					pthread_cond_timedwait(&(self->queueCondition), &(self->queueMutex), &timeout);
+					}
+				//===== CSV string arrived during preparation =====
+				else
+					{
+					// do nothing
+					}
+				atomic_store(&(self->queueSleeping), false);
+				pthread_mutex_unlock(&(self->queueMutex));
+				}
+			}
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished asynchronous writer thread");
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object or its queue is NULL");
+		}
+	return NULL;
+	}
+
+
+/**
+ * Background checkpoint thread which saves a snapshot of the SQLite3 database <br>
+ * in memory every interval until background checkpoints are stopped.<br>
+ *
+ * @param[in,out] argument	CEP structure object
+ * @return					NULL
+ */
+static void *this_runCheckpointer (void *argument)
+	{
+	//========== Variable ==========
+	M2MCEP *self = (M2MCEP *)argument;
+	struct timespec timeout;
+	const long NANOSECOND = 1000000000L;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_runCheckpointer()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start background checkpoint thread");
+		//===== Repeat until stopped =====
+		while (atomic_load(&(self->checkpointRunning))==true)
+			{
+			//===== Wait for the interval (woken up when stopped) =====
+			pthread_mutex_lock(&(self->checkpointMutex));
+			clock_gettime(CLOCK_REALTIME, &timeout);
+			timeout.tv_sec += (time_t)(self->checkpointInterval / 1000000ULL);
+			timeout.tv_nsec += (long)(self->checkpointInterval % 1000000ULL) * 1000L;
+			if (timeout.tv_nsec>=NANOSECOND)
+				{
+				timeout.tv_sec++;
+				timeout.tv_nsec -= NANOSECOND;
+				}
+			else
+				{
+				// do nothing
+				}
+			while (atomic_load(&(self->checkpointRunning))==true
+					&& pthread_cond_timedwait(&(self->checkpointCondition), &(self->checkpointMutex), &timeout)!=ETIMEDOUT)
+				{
+				}
+			pthread_mutex_unlock(&(self->checkpointMutex));
+			//===== Save a snapshot =====
+			if (atomic_load(&(self->checkpointRunning))==true)
+				{
+				this_checkpoint(self, false);
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished background checkpoint thread");
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		}
+	return NULL;
+	}
+
+
+/**
+ * Background persistence thread which takes all handed off batches at once <br>
+ * and commits them into the SQLite3 database on file in one transaction, <br>
+ * until background persistence is stopped and the batches are drained.<br>
+ *
+ * @param[in,out] argument	CEP structure object
+ * @return					NULL
+ */
+static void *this_runPersister (void *argument)
+	{
+	//========== Variable ==========
+	M2MCEP *self = (M2MCEP *)argument;
+	M2MCEPPersistenceBatch *batch = NULL;
+	M2MCEPPersistenceBatch *next = NULL;
+	sqlite3 *fileDatabase = NULL;
+	unsigned long numberOfRecord = 0;
+	bool vacuum = false;
+	M2MString MESSAGE[256];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_runPersister()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start background persistence thread");
+		//===== Repeat until stopped and drained =====
+		while (true)
+			{
+			//===== Take all handed off batches =====
+			pthread_mutex_lock(&(self->persistenceMutex));
+			while (self->persistenceBatch==NULL
+					&& self->persistenceVacuum==false
+					&& atomic_load(&(self->persistenceRunning))==true)
+				{
+				pthread_cond_wait(&(self->persistenceCondition), &(self->persistenceMutex));
+				}
+			batch = self->persistenceBatch;
+			self->persistenceBatch = NULL;
+			self->persistenceBatchTail = NULL;
+			vacuum = self->persistenceVacuum;
+			self->persistenceVacuum = false;
+			pthread_mutex_unlock(&(self->persistenceMutex));
+			//===== Move to the partition file of the current time =====
+			this_rotatePartition(self);
+			//===== Stopped and drained =====
+			if (batch==NULL && vacuum==false)
+				{
+				break;
+				}
+			//===== Get SQLite3 database on file =====
+			else if ((fileDatabase=M2MCEP_getFileDatabase(self))==NULL)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get SQLite3 database on file");
+				}
+			//===== Insert the batches in one transaction =====
+			else if (batch!=NULL)
+				{
+				M2MSQLite_beginTransaction(fileDatabase);
+				for (next=batch; next!=NULL; next=next->next)
+					{
+					this_persistBatch(self, next);
+					}
+				M2MSQLite_commitTransaction(fileDatabase);
+				//===== Incremental vacuum between transactions =====
+				if (self->incrementalVacuumPage>0)
+					{
+					this_vacuumIncrementally(self, fileDatabase);
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Vacuum requested by the caller thread =====
+			if (vacuum==true && fileDatabase!=NULL)
+				{
+				M2MSQLite_vacuum(fileDatabase);
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing was executed on the SQLite3 database file");
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Release the batches =====
+			numberOfRecord = 0;
+			while (batch!=NULL)
+				{
+				next = batch->next;
+				numberOfRecord += batch->numberOfRecord;
+				this_deletePersistenceBatch(&batch);
+				batch = next;
+				}
+			//===== Wake up the callers waiting for persistence =====
+			pthread_mutex_lock(&(self->persistenceMutex));
+			self->persistedRecord += numberOfRecord;
+			pthread_cond_broadcast(&(self->persistenceCondition));
+			pthread_mutex_unlock(&(self->persistenceMutex));
+			memset(MESSAGE, 0, sizeof(MESSAGE));
+			snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Persisted \"%lu\" records into SQLite3 database on file", numberOfRecord);
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+			}
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished background persistence thread");
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		}
+	return NULL;
+	}
+
+
+/**
+ * Record the sequence numbers of the tables numbered for the write-ahead log <br>
+ * into the SQLite3 database in memory to be copied into the snapshot (drop <br>
+ * the table with "drop" after the copy).<br>
+ *
+ * @param[in] self				CEP structure object
+ * @param[in,out] memoryDatabase	SQLite3 database in memory
+ * @param[in] drop				true: drop the table, false: create and fill the table
+ */
+static void this_saveSequence (M2MCEP *self, sqlite3 *memoryDatabase, const bool drop)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	M2MDataFrame *record = NULL;
+	M2MString SQL[128];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_saveSequence()";
+
+	//===== Check argument =====
+	if (self!=NULL && memoryDatabase!=NULL)
+		{
+		memset(SQL, 0, sizeof(SQL));
+		snprintf(SQL, sizeof(SQL)-1, (drop==true) ? (M2MString *)"DROP TABLE IF EXISTS %s " : (M2MString *)"CREATE TABLE IF NOT EXISTS %s (tableName TEXT PRIMARY KEY, sequence INTEGER) ", M2MCEP_SEQUENCE_TABLE);
+		//===== Error handling =====
+		if (M2MSQLite_executeUpdate(memoryDatabase, SQL)==false)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+			}
+		//===== In case of dropping the table =====
+		else if (drop==true)
+			{
+			// do nothing
+			}
+		//===== Insert the sequence number of each numbered table =====
+		else
+			{
+			memset(SQL, 0, sizeof(SQL));
+			snprintf(SQL, sizeof(SQL)-1, (M2MString *)"INSERT OR REPLACE INTO %s (tableName, sequence) VALUES (?, ?) ", M2MCEP_SEQUENCE_TABLE);
+			if (sqlite3_prepare_v2(memoryDatabase, SQL, -1, &statement, NULL)==SQLITE_OK)
+				{
+				for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+					{
+					if (M2MDataFrame_getTableName(record)!=NULL
+							&& M2MDataFrame_getPersistedSequence(record)>=0)
+						{
+						sqlite3_bind_text(statement, 1, M2MDataFrame_getTableName(record), -1, SQLITE_STATIC);
+						sqlite3_bind_int64(statement, 2, (sqlite3_int64)M2MDataFrame_getSequence(record));
+						M2MSQLite_next(statement);
+						sqlite3_reset(statement);
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+				}
+			sqlite3_finalize(statement);
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Executes the SQL statement specified by the argument on the SQLite 3 database <br>
+ * in memory and returns the result as a CSV format string.<br>
+ * For the character string of the CSV format as the execution result, the <br>
+ * column name character string is the first line, and the data after the second <br>
+ * line is the data.<br>
+ * <br>
+ * [Attention!]<br>
+ * In order to execute this function, "SQLITE_ENABLE_COLUMN_METADATA" must be <br>
+ * enabled as option setting at compile time of SQLite 3.<br>
+ * This is because this function can not create a character string of CSV format <br>
+ * to be output as a result unless table information is acquired from the SELECT <br>
+ * result.<br>
+ * If "SQLITE_ENABLE_COLUMN_METADATA" is not valid, keep in mind that this <br>
+ * function will cause a compile error (because undefined functions are called).<br>
+ *
+ * @param[in] self			CEP structure object (used for database management)
+ * @param[in] sql			String indicating SQL statement
+ * @param[in] params		Array of typed values bound into the parameters of the SQL statement or NULL
+ * @param[in] numberOfParam	Number of typed values
+ * @param[out] result		CSV character string of execution result or NULL (in case of error)
+ * @return
+ */
+static M2MString *this_select (M2MCEP *self, const M2MString *sql, const M2MCEPValue *params, const size_t numberOfParam, M2MString **result)
+	{
+	//========== Variable ==========
+	sqlite3_stmt* statement = NULL;
+	M2MString *selectResult = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_select()";
+
+	//===== Check argument =====
+	if (self!=NULL && sql!=NULL && result!=NULL)
+		{
+		//===== Make the records accumulated for group commit visible =====
+		this_commitRecord(self);
+		//===== Get VDBE (SQLite internal execution format) of SQL statement from the cache =====
+		if ((statement=this_getSelectStatement(self, sql))!=NULL
+				&& this_bindSelectParameter(self, statement, params, numberOfParam)==true)
+			{
+			//===== Execute SQL and convert the result into CSV =====
+			selectResult = this_createResultCSV(self, statement, result);
+			//===== Give back SQLite3 statement object to the cache =====
+			this_releaseSelectStatement(self, statement);
+			return selectResult;
+			}
+		//===== Error handling =====
+		else if (statement!=NULL)
+			{
+			this_releaseSelectStatement(self, statement);
+			return NULL;
+			}
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MCEP_getMemoryDatabase(self)));
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (sql==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"result\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/**
+ * Bind the fields of the CSV format record into the prepared INSERT statement.<br>
+ *
+ * @param[in] record				CSV format string indicating one record
+ * @param[in] dataTypeArray			Array of data types of the columns
+ * @param[in] dataTypeArrayLength	Number of columns
+ * @param[in,out] statement			Prepared INSERT statement
+ * @return							true: all columns were bound, false: the number of fields does not match
+ */
+static bool this_setCSVIntoPreparedStatement (const M2MString *record, const M2MSQLiteDataType dataTypeArray[], const unsigned int dataTypeArrayLength, sqlite3_stmt *statement)
+	{
+	//========== Variable ==========
+	M2MString *value = (M2MString *)record;
+	M2MString *valueIndex = NULL;
+	unsigned int columnIndex = 0;
+	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
+
+	//===== Check argument =====
+	if (record!=NULL && dataTypeArray!=NULL && dataTypeArrayLength>0 && statement!=NULL)
+		{
+		//===== Repeat with column name in CSV format =====
+		while (columnIndex<(dataTypeArrayLength-1)
+				&& value!=NULL
+				&& (valueIndex=M2MString_indexOf(value, (M2MString *)M2MString_COMMA))!=NULL)
+			{
+			//===== Set value =====
+			M2MSQLite_setValueIntoPreparedStatement(dataTypeArray[columnIndex], columnIndex+1, value, M2MString_length(value)-M2MString_length(valueIndex), statement);
+			//===== Move the field position to the next =====
+			columnIndex++;
+			//===== Move the position of the value to the next =====
+			valueIndex += COMMA_LENGTH;
+			value = valueIndex;
+			}
+		//===== Check the consistency of the number of columns and the number of inserted data =====
+		if (columnIndex==(dataTypeArrayLength-1))
+			{
+			//===== Set the last insert data =====
+			M2MSQLite_setValueIntoPreparedStatement(dataTypeArray[columnIndex], columnIndex+1, value, M2MString_length(value), statement);
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Set SQLite3 database file name of member of the CEP structure object.<br>
+ *
+ * @param[in,out] self		CEP structure object to be set SQLite3 database file name
+ * @param[in] databaseName	String indicating SQLite3 database file name
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setDatabaseName (M2MCEP *self, const M2MString *databaseName)
+	{
+	//========== Variable ==========
+	M2MString MESSAGE[256];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setDatabaseName()";
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& databaseName!=NULL && M2MString_length(databaseName)>0)
+		{
+		//===== Initialize SQLite3 fiel database name =====
+		this_deleteDatabaseName(self);
+		//===== Copy SQLite3 database file name =====
+		if (M2MString_append(&(self->databaseName), databaseName)!=NULL)
+			{
+			//===== In the case of extension isn't given in name =====
+			if (M2MString_lastIndexOf(databaseName, M2MSQLite_FILE_EXTENSION)==NULL)
+				{
+				//===== Copy SQLite3 file extension =====
+				if (M2MString_append(&(self->databaseName), M2MSQLite_FILE_EXTENSION)!=NULL)
+					{
+					// do nothing
+					}
+				//===== Error handling =====
+				else
+					{
+					this_deleteDatabaseName(self);
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to set the SQLite3 database name in the CEP structure object");
+					return NULL;
+					}
+				}
+			//===== In the case of extension is given in name =====
+			else
+				{
+				// do nothing
+				}
+			memset(MESSAGE, 0, sizeof(MESSAGE));
+			snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Set the SQLite3 database file name (=\"%s\") in the CEP structure object", M2MCEP_getDatabaseName(self));
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get heap memory for copying SQLite3 database name");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (databaseName==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is vacant");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Set indicated M2MDataFrame object into CEP structure object.<br>
+ *
+ * @param[in,out] self		CEP structure object to be set M2MDataFrame object
+ * @param[in] dataFrame		M2MDataFrame object
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setDataFrame (M2MCEP *self, M2MDataFrame *dataFrame)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MDataFrame.this_setDataFrame()";
+
+	//===== Check argument =====
+	if (self!=NULL && dataFrame!=NULL)
+		{
+		self->dataFrame = dataFrame;
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set M2MDataFrame object into CEP object");
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Set the SQLite3 file database management object as the member variable held <br>
+ * by the CEP execution object specified by the argument.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] fileDatabase	SQLite3 file database management object
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setFileDatabase (M2MCEP *self, sqlite3 *fileDatabase)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setFileDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL && fileDatabase!=NULL
+			&& (self->fileStatementCache=M2MStatementCache_new(fileDatabase, 0))!=NULL)
+		{
+		self->fileDatabase=fileDatabase;
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set SQLite3 database management object on file to CEP execution object");
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (fileDatabase==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite3 execution object specified by argument is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to create prepared statement cache of SQLite3 database on file");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Set the SQLite 3 database management object in memory as the member variable <br>
+ * possessed by the CEP execution object specified by the argument.<br>
+ *
+ * @param[in,out] self			CEP structure object
+ * @param[in] memoryDatabase	SQLite 3 database management object on memory
+ * @return						CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setMemoryDatabase (M2MCEP *self, sqlite3 *memoryDatabase)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setMemoryDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL && memoryDatabase!=NULL
+			&& (self->memoryStatementCache=M2MStatementCache_new(memoryDatabase, 0))!=NULL
+			&& (self->selectStatementCache=M2MStatementCache_new(memoryDatabase, M2MCEP_SELECT_STATEMENT_CACHE_CAPACITY))!=NULL)
+		{
+		self->memoryDatabase = memoryDatabase;
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set SQLite3 database management object on memory in CEP object");
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (memoryDatabase==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite3 execution object specified by argument is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to create prepared statement cache of SQLite3 database on memory");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Record the sequence number of the last persisted record of the table into <br>
+ * the SQLite3 database on file (call this function in the transaction <br>
+ * inserting the records, so that both are committed together).<br>
+ * The table of the sequence numbers is created on demand.<br>
+ *
+ * @param[in] self					CEP structure object
+ * @param[in,out] fileStatementCache	Prepared statement cache of SQLite3 database on file
+ * @param[in] tableName				String indicating the table name
+ * @param[in] sequence				Sequence number of the last persisted record
+ * @return							true: success, false: failure
+ */
+static bool this_setPersistedSequence (M2MCEP *self, M2MStatementCache *fileStatementCache, const M2MString *tableName, const int64_t sequence)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	M2MString CREATE_SQL[128];
+	M2MString INSERT_SQL[128];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setPersistedSequence()";
+
+	//===== Check argument =====
+	if (self!=NULL && fileStatementCache!=NULL && tableName!=NULL)
+		{
+		memset(CREATE_SQL, 0, sizeof(CREATE_SQL));
+		snprintf(CREATE_SQL, sizeof(CREATE_SQL)-1, (M2MString *)"CREATE TABLE IF NOT EXISTS %s (tableName TEXT PRIMARY KEY, sequence INTEGER) ", M2MCEP_SEQUENCE_TABLE);
+		memset(INSERT_SQL, 0, sizeof(INSERT_SQL));
+		snprintf(INSERT_SQL, sizeof(INSERT_SQL)-1, (M2MString *)"INSERT OR REPLACE INTO %s (tableName, sequence) VALUES (?, ?) ", M2MCEP_SEQUENCE_TABLE);
+		//===== Get the prepared statement (create the table at first) =====
+		if ((statement=M2MStatementCache_search(fileStatementCache, INSERT_SQL, NULL))!=NULL
+				|| (M2MSQLite_executeUpdate(M2MStatementCache_getDatabase(fileStatementCache), CREATE_SQL)==true
+					&& (statement=M2MStatementCache_put(fileStatementCache, INSERT_SQL, NULL, INSERT_SQL))!=NULL))
+			{
+			sqlite3_bind_text(statement, 1, tableName, -1, SQLITE_STATIC);
+			sqlite3_bind_int64(statement, 2, (sqlite3_int64)sequence);
+			if (M2MSQLite_next(statement)==SQLITE_DONE)
+				{
+				sqlite3_reset(statement);
+				return true;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(fileStatementCache)));
+				sqlite3_reset(statement);
+				return false;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(fileStatementCache)));
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Set a table construction object as a member variable for the argument CEP object.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] tableManager	Table construction object
+ * @return					CEP structure object with member variable updated or NULL (in case of error)
+ */
+static M2MCEP *this_setTableManager (M2MCEP *self, const M2MTableManager *tableManager)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setTableManager()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableManager!=NULL)
+		{
+		//===== Delete an existing table building object =====
+		this_deleteTableManager(self);
+		//===== Set table construction object =====
+		self->tableManager = (M2MTableManager *)tableManager;
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set a table construction object in the CEP object");
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object specified by the argument is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Copy the CSV format string without its first records (the header line is <br>
+ * kept). Empty lines aren't counted as records.<br>
+ *
+ * @param[in] csv				String in CSV format (the first line specifies the column name as a header)
+ * @param[in] numberOfRecord	Number of records to be skipped
+ * @param[out] buffer			Buffer to store the copied string
+ * @return						Copied string or NULL (in case of no rest record)
+ */
+static M2MString *this_skipCSVRecord (const M2MString *csv, const size_t numberOfRecord, M2MString **buffer)
+	{
+	//========== Variable ==========
+	M2MString *lineHead = NULL;
+	M2MString *lineEnd = NULL;
+	size_t headerLength = 0;
+	size_t i = 0;
+	const size_t CRLF_LENGTH = M2MString_length(M2MString_CRLF);
+
+	//===== Check argument =====
+	if (csv!=NULL && buffer!=NULL
+			&& (lineEnd=M2MString_indexOf(csv, M2MString_CRLF))!=NULL)
+		{
+		headerLength = M2MString_length(csv) - M2MString_length(lineEnd) + CRLF_LENGTH;
+		//===== Skip the records =====
+		for (lineHead=lineEnd+CRLF_LENGTH; i<numberOfRecord && lineHead!=NULL; )
+			{
+			if ((lineEnd=M2MString_indexOf(lineHead, M2MString_CRLF))!=NULL)
+				{
+				i += (lineEnd!=lineHead) ? 1 : 0;
+				lineHead = lineEnd + CRLF_LENGTH;
+				}
+			else
+				{
+				i += (M2MString_length(lineHead)>0) ? 1 : 0;
+				lineHead = NULL;
+				}
+			}
+		//===== Copy the header line and the rest of records =====
+		if (lineHead!=NULL && M2MString_length(lineHead)>0
+				&& M2MString_appendLength(buffer, csv, headerLength)!=NULL
+				&& M2MString_append(buffer, lineHead)!=NULL)
+			{
+			return (*buffer);
+			}
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Remove the segment files of the write-ahead log whose records have left the <br>
+ * SQLite3 database in memory, in the oldest order.<br>
+ * Nothing is removed while records handed off to the background persistence <br>
+ * thread aren't committed into the SQLite3 database on file.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_truncateLog (M2MCEP *self)
+	{
+	//========== Variable ==========
+	uint32_t segment = 0;
+	bool inFlight = false;
+
+	//===== Check the log =====
+	if (self->log!=NULL)
+		{
+		//===== Records handed off are persisted later =====
+		pthread_mutex_lock(&(self->persistenceMutex));
+		inFlight = (self->persistedRecord<self->handedOffRecord);
+		pthread_mutex_unlock(&(self->persistenceMutex));
+		if (inFlight==false)
+			{
+			//===== Search the first segment file to be kept =====
+			for (segment=M2MCEPLog_getFirstSegment(self->log);
+					segment<M2MCEPLog_getSegment(self->log) && this_isLogSegmentRemovable(self, segment)==true;
+					segment++)
+				{
+				}
+			//===== Remove the older segment files (after writing the partial blocks of the column stores) =====
+			if (segment>M2MCEPLog_getFirstSegment(self->log))
+				{
+				this_flushColumnStore(self);
+				M2MCEPLog_remove(self->log, segment);
+				this_deleteLogMark(self, segment);
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Add the values of the records inserted into the tables of SQLite3 database <br>
+ * in memory since the last update to the aggregates.<br>
+ * Only the new records are read (rowid range search).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_updateAggregate (M2MCEP *self)
+	{
+	//========== Variable ==========
+	M2MStatementCache *memoryStatementCache = NULL;
+	M2MCEPAggregate *aggregate = NULL;
+	sqlite3_stmt *statement = NULL;
+	int64_t lastRowid = 0;
+	int result = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_updateAggregate()";
+
+	//===== Repeat with aggregates =====
+	for (aggregate=self->aggregate; aggregate!=NULL; aggregate=aggregate->next)
+		{
+		//===== In case of new records =====
+		if ((lastRowid=this_getTableLastRowid(self, aggregate->tableName))>aggregate->lastRowid)
+			{
+			//===== Read the values of the new records =====
+			if ((memoryStatementCache=this_getMemoryStatementCache(self))!=NULL
+					&& ((statement=M2MStatementCache_search(memoryStatementCache, aggregate->selectSQL, NULL))!=NULL
+						|| (statement=M2MStatementCache_put(memoryStatementCache, aggregate->selectSQL, NULL, aggregate->selectSQL))!=NULL))
+				{
+				sqlite3_bind_int64(statement, 1, (sqlite3_int64)aggregate->lastRowid);
+				while ((result=M2MSQLite_next(statement))==SQLITE_ROW)
+					{
+					M2MCEPAggregate_add(aggregate, (int64_t)sqlite3_column_int64(statement, 0), sqlite3_column_double(statement, 1));
+					}
+				//===== Error handling =====
+				if (result!=SQLITE_DONE)
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MStatementCache_getDatabase(memoryStatementCache)));
+					}
+				else
+					{
+					// do nothing
+					}
+				sqlite3_reset(statement);
+				//===== The records with NULL value are skipped =====
+				aggregate->lastRowid = lastRowid;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to prepare SELECT statement for updating the aggregate");
+				}
+			}
+		//===== In case of no new record =====
+		else
+			{
+			// do nothing
+			}
+		}
+	return;
+	}
+
+
+/**
+ * Update the high-water mark of the queue length with the current length.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_updateMaxQueueLength (M2MCEP *self)
+	{
+	//========== Variable ==========
+	size_t length = M2MConcurrentQueue_length(self->queue);
+	size_t maxQueueLength = atomic_load(&(self->maxQueueLength));
+
+	//===== Repeat until the high-water mark is larger than the current length =====
+	while (length>maxQueueLength
+			&& atomic_compare_exchange_weak(&(self->maxQueueLength), &maxQueueLength, length)==false)
+		{
+		// do nothing ("maxQueueLength" is reloaded)
+		}
+	return;
+	}
+
+
+/**
+ * Record the sequence number of the last record evicted from the table of <br>
+ * the SQLite3 database in memory as persisted, into the SQLite3 database on <br>
+ * file (in the transaction of the evicted records) or into the batch handed <br>
+ * off to the background persistence thread.<br>
+ * Nothing is recorded unless the table is numbered for the write-ahead log.<br>
+ *
+ * @param[in] self					CEP structure object
+ * @param[in,out] record			Record management object of the table (after eviction)
+ * @param[in,out] batch				Batch of the evicted records or NULL (in case of persistence by this thread)
+ * @param[in,out] fileStatementCache	Prepared statement cache of SQLite3 database on file or NULL (in case of batch)
+ */
+static void this_updatePersistedSequence (M2MCEP *self, M2MDataFrame *record, M2MCEPPersistenceBatch *batch, M2MStatementCache *fileStatementCache)
+	{
+	//========== Variable ==========
+	int64_t sequence = 0;
+
+	//===== In case of the table not numbered or no record newly evicted =====
+	if (record==NULL || M2MDataFrame_getPersistedSequence(record)<0
+			|| (sequence=M2MDataFrame_getSequence(record)-(int64_t)M2MDataFrame_getWindowLength(record))<=M2MDataFrame_getPersistedSequence(record))
+		{
+		// do nothing
+		}
+	//===== Recorded by the persistence thread =====
+	else if (batch!=NULL)
+		{
+		batch->sequence = sequence;
+		M2MDataFrame_setPersistedSequence(record, sequence);
+		}
+	//===== Recorded with the evicted records =====
+	else if (this_setPersistedSequence(self, fileStatementCache, M2MDataFrame_getTableName(record), sequence)==true)
+		{
+		M2MDataFrame_setPersistedSequence(record, sequence);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Take a snapshot of the SQLite3 database in memory (the records accumulated <br>
+ * for group commit are committed first) and load it into the connection of <br>
+ * the read handle as a read-only database.<br>
+ *
+ * @param[in,out] reader	Read handle
+ * @return					true: the snapshot was replaced, false: failed (the previous snapshot is kept)
+ */
+static bool this_updateReaderSnapshot (M2MCEPReader *reader)
+	{
+	//========== Variable ==========
+	M2MCEP *self = reader->cep;
+	sqlite3 *memoryDatabase = NULL;
+	unsigned char *snapshot = NULL;
+	sqlite3_int64 snapshotSize = 0;
+	unsigned long committedRecord = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_updateReaderSnapshot()";
+
+	//===== Copy the database in memory (the CEP object is locked only while copying) =====
+	pthread_mutex_lock(&(self->lock));
+	this_commitRecord(self);
+	if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+			&& (snapshot=sqlite3_serialize(memoryDatabase, "main", &snapshotSize, 0))!=NULL)
+		{
+		committedRecord = atomic_load(&(self->committedRecord));
+		}
+	else
+		{
+		// do nothing
+		}
+	pthread_mutex_unlock(&(self->lock));
+	//===== Load the snapshot into the connection of the reader =====
+	if (snapshot!=NULL)
+		{
+		//===== The snapshot is released by SQLite (even in case of error) =====
+		if (sqlite3_deserialize(reader->database, "main", snapshot, snapshotSize, snapshotSize, SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_READONLY)==SQLITE_OK)
+			{
+			reader->committedRecord = committedRecord;
+			reader->snapshotTime = this_getMonotonicTime();
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, M2MSQLite_getErrorMessage(reader->database));
+			return false;
+			}
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to take a snapshot of SQLite3 database in memory");
+		return false;
+		}
+	}
+
+
+/**
+ * Update the number of records for executing the vacuum on the SQLite 3 database.<br>
+ *
+ * @param[in] self		CEP structure object
+ * @param[in] count		Number of records added to the counter (> 0) or 0 (for initializing the counters)
+ */
+static void this_updateRecordCounter (M2MCEP *self, const unsigned int count)
+	{
+	//========== Variable ==========
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_updateRecordCounter()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== When the automatic vacuum setting is ON =====
+		if (this_getVacuumRecord(self)==0)
+			{
+			return;
+			}
+		//===== When automatic vacuum setting is OFF =====
+		else
+			{
+			//===== When the counter is an integer of 1 or more =====
+			if (count>=1)
+				{
+				//===== Add counter =====
+				self->recordCounter = self->recordCounter + count;
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Update record counters for vacuum processing");
+				return;
+				}
+			//===== When the counter is 0 =====
+			else
+				{
+				//===== Initialize counter =====
+				self->recordCounter = 0;
+				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing record counter has been initialized");
+				return;
+				}
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return;
+		}
+	}
+
+
+/**
+ * Run one incremental vacuum slice on the SQLite3 database when its freelist <br>
+ * exceeds the threshold: free pages are removed step by step until the <br>
+ * freelist is empty or the time limit of the slice is exceeded.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] database	SQLite3 database in incremental vacuum mode
+ * @return					Number of removed pages
+ */
+static unsigned int this_vacuumIncrementally (M2MCEP *self, sqlite3 *database)
+	{
+	//========== Variable ==========
+	int64_t freelist = 0;
+	int64_t rest = 0;
+	unsigned int numberOfPage = 0;
+	uint64_t start = 0;
+	uint64_t elapsedTime = 0;
+	M2MString MESSAGE[256];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_vacuumIncrementally()";
+
+	//===== Check argument =====
+	if (self!=NULL && database!=NULL)
+		{
+		//===== When the freelist is within the threshold =====
+		if ((freelist=M2MSQLite_getFreelistCount(database))<=(int64_t)self->incrementalVacuumPage)
+			{
+			return 0;
+			}
+		//===== When the freelist exceeds the threshold =====
+		else
+			{
+			// do nothing
+			}
+		//===== Remove free pages step by step within the time limit =====
+		start = this_getMonotonicTime();
+		while (freelist>0
+				&& elapsedTime<self->incrementalVacuumTime
+				&& M2MSQLite_incrementalVacuum(database, self->incrementalVacuumStep)==true
+				&& (rest=M2MSQLite_getFreelistCount(database))>=0
+				&& rest<freelist)
+			{
+			numberOfPage += (unsigned int)(freelist-rest);
+			freelist = rest;
+			elapsedTime = this_getMonotonicTime() - start;
+			}
+		elapsedTime = this_getMonotonicTime() - start;
+		//===== Report the slice =====
+		atomic_store(&(self->vacuumTime), (unsigned long)elapsedTime);
+		atomic_fetch_add(&(self->vacuumPage), (unsigned long)numberOfPage);
+		memset(MESSAGE, 0, sizeof(MESSAGE));
+		snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Incremental vacuum removed \"%u\" pages in \"%" PRIu64 "\"usec (\"%" PRId64 "\" free pages left)", numberOfPage, elapsedTime, freelist);
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+		return numberOfPage;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sqlite3\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Wake up the asynchronous writer thread if it is waiting for CSV strings.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ */
+static void this_wakeUpAsyncWriter (M2MCEP *self)
+	{
+	//===== When the writer thread is waiting =====
+	if (atomic_load(&(self->queueSleeping))==true)
+		{
+		pthread_mutex_lock(&(self->queueMutex));
+		pthread_cond_signal(&(self->queueCondition));
+		pthread_mutex_unlock(&(self->queueMutex));
+		}
+	//===== When the writer thread is working =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Append the inserted records to the write-ahead log (if enabled), after <br>
+ * closing the current segment file when it's full.<br>
+ * A failure is logged and the records are inserted anyway.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] csv		String in CSV format or NULL (in case of typed values)
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order
+ * @param[in] rows		Number of records of "csv" or "values"
+ * @param[in] columns	Number of values per record of "values"
+ */
+static void this_writeLog (M2MCEP *self, const M2MString *tableName, const M2MString *csv, const M2MCEPValue *values, const size_t rows, const size_t columns)
+	{
+	//========== Variable ==========
+	M2MDataFrame *record = NULL;
+	int64_t sequence = 1;
+	size_t entryLength = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_writeLog()";
+
+	//===== Check the log =====
+	if (self->log!=NULL)
+		{
+		//===== Number the records after those accumulated for group commit =====
+		if ((record=this_getTableDataFrame(self, tableName))!=NULL)
+			{
+			this_loadSequence(self, record);
+			sequence = M2MDataFrame_getSequence(record) + 1;
+			if (csv!=NULL)
+				{
+				sequence += (int64_t)M2MList_length(M2MDataFrame_getNewRecordList(record)) - (int64_t)rows;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Start the next segment file =====
+		if (M2MCEPLog_isFull(self->log)==true)
+			{
+			this_rotateLog(self);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Append the entry =====
+		if (csv!=NULL)
+			{
+			entryLength = M2MCEPLog_appendCSV(self->log, tableName, sequence, csv);
+			}
+		else
+			{
+			entryLength = M2MCEPLog_appendRecords(self->log, tableName, sequence, values, rows, columns);
+			}
+		//===== Error handling =====
+		if (entryLength==0)
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to append the records to the write-ahead log");
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Save a snapshot of the SQLite3 database in memory (the record window) into <br>
+ * the snapshot file ("~/.m2m/cep/databaseName.sqlite.snapshot").<br>
+ * The records accumulated for group commit are committed first, then the <br>
+ * database is copied with sqlite3_serialize() while the CEP object is locked; <br>
+ * the copy is written into a temporary file, synchronized and renamed so that <br>
+ * a crash never leaves a broken snapshot.<br>
+ * When the CEP object opens the SQLite3 database in memory (first access <br>
+ * after M2MCEP_new()), the snapshot is restored with the online backup API <br>
+ * instead of waiting for new records to fill the window again. Once a <br>
+ * snapshot is used, M2MCEP_delete() takes the last checkpoint.<br>
+ * The records evicted between the last checkpoint and a crash can be <br>
+ * inserted into the SQLite3 database on file again after the restart.<br>
  *
  * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
  */
-static void this_closeMemoryDatabase (M2MCEP *self)
+M2MCEP *M2MCEP_checkpoint (M2MCEP *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Save a snapshot =====
+		if (this_checkpoint(self, false)==true)
+			{
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_checkpoint()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the read handle (the snapshot and its prepared statements).<br>
+ *
+ * @param[in,out] reader	Read handle to be freed of memory area
+ */
+void M2MCEP_closeReader (M2MCEPReader **reader)
+	{
+	//===== Check argument =====
+	if (reader!=NULL && (*reader)!=NULL)
+		{
+		//===== Finalize cached prepared statements before closing =====
+		if ((*reader)->statementCache!=NULL)
+			{
+			M2MStatementCache_delete(&((*reader)->statementCache));
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Close the connection (the snapshot is released) =====
+		if ((*reader)->database!=NULL)
+			{
+			M2MSQLite_closeDatabase((*reader)->database);
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MHeap_free((*reader));
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_closeReader()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPReader\" object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Commit the records accumulated for group commit now (see <br>
+ * M2MCEP_setGroupCommit()).<br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				Number of committed records[row] or -1 (in case of error)
+ */
+int M2MCEP_commit (M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_closeMemoryDatabase()";
+	int numberOfRecord = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_commit()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		M2MSQLite_closeDatabase(M2MCEP_getMemoryDatabase(self));
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Closed SQLite3 memory database");
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		numberOfRecord = this_commitRecord(self);
+		pthread_mutex_unlock(&(self->lock));
+		return numberOfRecord;
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
 		}
-	return;
 	}
 
 
 /**
- * Create a new INSERT statement for the prepared statement.<br>
+ * Release the heap memory of CEP structure object. <br>
+ * Note that after calling this function, caller will not be able to access <br>
+ * the CEP structure object appointed by argument.<br>
  *
- * @param[in] tableName			String indicating table name
- * @param[in] columnNameCSV		CSV format string indicating column name
- * @param[in] columnListLength	An integer indicating the number of columns
- * @param[out] sql				Pointer to copy the newly created INSERT statement (buffering is executed inside the function)
- * @return						Pointer of newly created INSERT statement or NULL (in case of error)
+ * @param[in,out] self	CEP structure object to be freed of memory area
  */
-static M2MString *this_createInsertSQL (const M2MString *tableName, const M2MString *columnNameCSV, unsigned int columnListLength, M2MString **sql)
+void M2MCEP_delete (M2MCEP **self)
 	{
 	//========== Variable ==========
-	unsigned int i = 0;
-	unsigned int index = 0;
-	size_t sqlLength = 0;
-	const M2MString *INSERT_SQL = (M2MString *)"INSERT INTO %s (%s) VALUES (%s) ";
-	const size_t QUESTION_MARK_LENGTH = M2MString_length((M2MString *)M2MString_QUESTION_MARK);
-	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
-	const size_t PARAMETER_LENGTH = columnListLength * (QUESTION_MARK_LENGTH + COMMA_LENGTH);
-	M2MString PARAMETER[PARAMETER_LENGTH];
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_createInsertSQL()";
+	M2MDataFrame *record = NULL;
+	M2MCEPQuery *query = NULL;
+	M2MCEPAggregate *aggregate = NULL;
+	M2MCEPPattern *pattern = NULL;
+	M2MCEPColumnStore *columnStore = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_delete()";
 
 	//===== Check argument =====
-	if (tableName!=NULL && columnNameCSV!=NULL && columnListLength>0 && sql!=NULL)
+	if (self!=NULL && (*self)!=NULL)
 		{
-		//===== Initialize array =====
-		memset(PARAMETER, 0, PARAMETER_LENGTH);
-		//===== Repeat as many columns =====
-		for (i=0; i<columnListLength; i++)
+		//===== Insert all queued CSV strings and stop writer thread =====
+		M2MCEP_stopAsync((*self));
+		//===== Commit the records accumulated for group commit =====
+		this_commitRecord((*self));
+		//===== Stop checkpoint thread and save the window which is flushed below =====
+		M2MCEP_stopCheckpoint((*self));
+		if ((*self)->checkpoint==true)
 			{
-			//===== In the first case =====
-			if (i==0)
-				{
-				//===== Add "?" character =====
-				memcpy(&(PARAMETER[index]), (M2MString *)M2MString_QUESTION_MARK, QUESTION_MARK_LENGTH);
-				index++;
-				}
-			//===== In the case of 2nd and subsequent cases =====
-			else
-				{
-				//===== Add "," character =====
-				memcpy(&(PARAMETER[index]), (M2MString *)M2MString_COMMA, COMMA_LENGTH);
-				index++;
-				//===== Add "?" character =====
-				memcpy(&(PARAMETER[index]), (M2MString *)M2MString_QUESTION_MARK, QUESTION_MARK_LENGTH);
-				index++;
-				}
+			this_checkpoint((*self), this_getPersistence((*self)));
 			}
-		//===== Get a heap memory area for creating a new INSERT statement =====
-		if ((sqlLength=M2MString_length(INSERT_SQL)+M2MString_length(tableName)+M2MString_length(columnNameCSV)+M2MString_length(PARAMETER))>0
-				&& ((*sql)=(M2MString *)M2MHeap_malloc(sqlLength+1))!=NULL)
+		else
 			{
-			//===== Create a new INSERT statement =====
-			if (snprintf((*sql), sqlLength, INSERT_SQL, tableName, columnNameCSV, PARAMETER)>0)
-				{
-				//===== Return INSERT string =====
-				return (*sql);
-				}
-			//===== Error handling =====
-			else
+			// do nothing
+			}
+		//===== Insert CEP record information object (not inserted) into file database =====
+		this_flushCEPRecord((*self));
+		//===== Persist all handed off records and stop persistence thread =====
+		M2MCEP_stopPersistence((*self));
+		//===== Close the column stores (the partial blocks are written) =====
+		while ((*self)->columnStore!=NULL)
+			{
+			columnStore = (*self)->columnStore;
+			(*self)->columnStore = columnStore->next;
+			M2MCEPColumnStore_delete(&columnStore);
+			}
+		//===== Remove the segment files of the write-ahead log whose records are flushed =====
+		this_closeLog((*self));
+		//===== Release heap memory for database name string =====
+		this_deleteDatabaseName((*self));
+		//===== Release aggregates =====
+		while ((*self)->aggregate!=NULL)
+			{
+			aggregate = (*self)->aggregate;
+			(*self)->aggregate = aggregate->next;
+			M2MCEPAggregate_delete(&aggregate);
+			}
+		//===== Finalize continuous queries before closing memory database =====
+		while ((*self)->query!=NULL)
+			{
+			query = (*self)->query;
+			(*self)->query = query->next;
+			this_deleteQuery(&query);
+			}
+		//===== Finalize event patterns before closing memory database =====
+		while ((*self)->pattern!=NULL)
+			{
+			pattern = (*self)->pattern;
+			(*self)->pattern = pattern->next;
+			M2MCEPPattern_delete(&pattern);
+			}
+		//===== Close memory database =====
+		this_closeMemoryDatabase((*self));
+		//===== Close file database =====
+		this_closeFileDatabase((*self));
+		//===== Release time partitions (the partition files are kept) =====
+		M2MCEPPartition_delete(&((*self)->partition));
+		//=====  =====
+		this_deleteLogger((*self));
+		//===== Release the heap memory area of the CEP record information object =====
+		if ((record=this_getDataFrame((*self)))!=NULL)
+			{
+			M2MDataFrame_delete(&record);
+			}
+		else
+			{
+			}
+		//===== Release heap memory area of table construction object =====
+		this_deleteTableManager((*self));
+		//===== Release heap memory area of window definitions =====
+		this_deleteWindow((*self));
+		//===== Release synchronization objects =====
+		pthread_cond_destroy(&((*self)->checkpointCondition));
+		pthread_mutex_destroy(&((*self)->checkpointMutex));
+		pthread_cond_destroy(&((*self)->persistenceCondition));
+		pthread_mutex_destroy(&((*self)->persistenceMutex));
+		pthread_cond_destroy(&((*self)->queueCondition));
+		pthread_mutex_destroy(&((*self)->queueMutex));
+		pthread_mutex_destroy(&((*self)->lock));
+		//===== Release CEP object's heap memory area =====
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Put the CSV format string into the queue of the asynchronous mode and return <br>
+ * without waiting for the insertion.<br>
+ * The strings are copied, then inserted in order by the asynchronous writer <br>
+ * thread in the same way as M2MCEP_insertCSV().<br>
+ * When the queue is full, the caller waits for a free slot (blocking policy) <br>
+ * or the CSV string is discarded and counted (drop policy).<br>
+ * Any number of threads can call this function at the same time.<br>
+ *
+ * @param[in,out] self	CEP structure object in asynchronous mode
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				1: queued, 0: dropped because the queue is full, -1: error
+ */
+int M2MCEP_enqueueCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv)
+	{
+	//========== Variable ==========
+	M2MString *item = NULL;
+	size_t tableNameLength = 0;
+	size_t csvLength = 0;
+	const struct timespec WAIT_TIME = {0, 50000L};
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_enqueueCSV()";
+
+	//===== Check argument =====
+	if (self!=NULL && self->queue!=NULL && atomic_load(&(self->queueRunning))==true
+			&& tableName!=NULL && (tableNameLength=M2MString_length(tableName))>0
+			&& csv!=NULL && (csvLength=M2MString_length(csv))>0)
+		{
+		//===== Copy table name and CSV string into one heap memory area =====
+		if ((item=(M2MString *)M2MHeap_malloc(tableNameLength+csvLength+2))!=NULL)
+			{
+			memcpy(item, tableName, tableNameLength);
+			memcpy(&(item[tableNameLength+1]), csv, csvLength);
+			//===== Repeat until the queue accepts the item =====
+			while (M2MConcurrentQueue_offer(self->queue, item)==false)
 				{
-				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to create new INSERT statement");
-				//===== When the heap memory area of the INSERT statement still remains =====
-				if ((*sql)!=NULL)
+				//===== Blocking policy: wait for the writer thread to take items =====
+				if (self->queueBlocking==true && atomic_load(&(self->queueRunning))==true)
 					{
-					//===== Release heap memory area =====
-					M2MHeap_free((*sql));
+					this_wakeUpAsyncWriter(self);
+					nanosleep(&WAIT_TIME, NULL);
 					}
-				//===== When the heap memory area of the INSERT statement does not exist =====
+				//===== Drop policy =====
 				else
 					{
-					// do nothing
+					M2MHeap_free(item);
+					atomic_fetch_add(&(self->droppedCSV), 1);
+					return 0;
 					}
-				return NULL;
 				}
+			//===== Update metrics and wake up the writer thread =====
+			this_updateMaxQueueLength(self);
+			this_wakeUpAsyncWriter(self);
+			return 1;
 			}
 		//===== Error handling =====
 		else
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to get heap memory area to create new INSERT statement");
-			return NULL;
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for copying CSV string");
+			return -1;
 			}
 		}
 	//===== Argument error =====
-	else if (tableName==NULL)
+	else if (self==NULL)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
-		return NULL;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
 		}
-	else if (columnNameCSV==NULL)
+	else if (self->queue==NULL || atomic_load(&(self->queueRunning))==false)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The CSV format string indicating the column name specified by the argument is NULL");
-		return NULL;
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object isn't in asynchronous mode");
+		return -1;
 		}
-	else if (columnListLength<=0)
+	else if (tableName==NULL || tableNameLength<=0)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! An integer indicating the number of columns specified by the argument is 0 or less");
-		return NULL;
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
+		return -1;
 		}
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! The pointer to copy the INSERT statement specified by the argument is NULL");
-		return NULL;
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the CSV format record specified by the argument is NULL");
+		return -1;
 		}
 	}
 
 
 /**
- * Releases the heap memory of the database name possessed by the CEP object.<br>
+ * Wait until all records handed off to the background persistence thread so <br>
+ * far are committed into the SQLite3 database on file (barrier).<br>
+ * Records still held in the SQLite3 database in memory are not concerned; they <br>
+ * are persisted when they leave the record window.<br>
+ * Returns immediately if background persistence is not running.<br>
  *
  * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
  */
-static void this_deleteDatabaseName (M2MCEP *self)
+M2MCEP *M2MCEP_flushPersistence (M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_deleteDatabaseName()";
+	unsigned long handedOffRecord = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_flushPersistence()";
 
 	//===== Check argument =====
-	if (self!=NULL && M2MCEP_getDatabaseName(self)!=NULL)
+	if (self!=NULL)
 		{
-		M2MHeap_free(self->databaseName);
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Deleted string indicating SQLite3 database file name");
+		//===== Wait for the records handed off before this call only =====
+		pthread_mutex_lock(&(self->persistenceMutex));
+		handedOffRecord = self->handedOffRecord;
+		while (atomic_load(&(self->persistenceRunning))==true
+				&& self->persistedRecord<handedOffRecord)
+			{
+			pthread_cond_wait(&(self->persistenceCondition), &(self->persistenceMutex));
+			}
+		pthread_mutex_unlock(&(self->persistenceMutex));
+		//===== Write the partial blocks of the column stores =====
+		if (self->columnStore!=NULL)
+			{
+			pthread_mutex_lock(&(self->lock));
+			this_flushColumnStore(self);
+			pthread_mutex_unlock(&(self->lock));
+			}
+		else
+			{
+			// do nothing
+			}
+		return self;
 		}
 	//===== Argument error =====
-	else if (self==NULL)
-		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		}
 	else
 		{
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite3 database file name hasn't been set yet");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
-	return;
 	}
 
 
 /**
- * Releases the heap memory area of the logging object held by the argument CEP.<br>
+ * Returns the value of the aggregate declared with M2MCEP_setAggregate() in <br>
+ * O(1), without scanning the table of SQLite3 database in memory.<br>
+ * The value is also available in SQL through the function <br>
+ * M2MCEP_AGGREGATE_FUNCTION.<br>
  *
- * @param[in,out] self	CEP structure object
+ * @param[in] self			CEP structure object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @param[in] type			Kind of aggregate value
+ * @return					Aggregate value or NAN (in case of error, undeclared aggregate or empty window)
  */
-static void this_deleteLogger (M2MCEP *self)
+double M2MCEP_getAggregate (M2MCEP *self, const M2MString *tableName, const M2MString *columnName, const M2MCEPAggregateType type)
 	{
 	//========== Variable ==========
-	M2MFileAppender *logger = NULL;
+	M2MCEPAggregate *aggregate = NULL;
+	double value = NAN;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getAggregate()";
 
 	//===== Check argument =====
-	if (self!=NULL && (logger=M2MCEP_getLogger(self))!=NULL)
+	if (self!=NULL && tableName!=NULL && columnName!=NULL)
 		{
-		M2MFileAppender_delete(&logger);
+		//===== Exclusive access to the aggregates =====
+		pthread_mutex_lock(&(self->lock));
+		if ((aggregate=this_getAggregate(self, tableName, columnName))!=NULL)
+			{
+			value = M2MCEPAggregate_getValue(aggregate, type);
+			}
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Indicated aggregate isn't declared");
+			}
+		pthread_mutex_unlock(&(self->lock));
+		return value;
 		}
 	//===== Argument error =====
 	else if (self==NULL)
 		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NAN;
 		}
 	else
 		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name or column name string is NULL");
+		return NAN;
 		}
-	return;
 	}
 
 
 /**
- * Releases the heap memory area of the table building object held by the CEP <br>
- * execution object specified by the argument as a member variable.<br>
- * Be aware that after invoking the method, you can not access the table <br>
- * building object.<br>
+ * Returns the time spent by the last checkpoint (see M2MCEP_checkpoint()).<br>
  *
- * @param[in,out] self	CEP structure object
+ * @param[in] self	CEP structure object
+ * @return			Time of the last checkpoint[usec]
  */
-static void this_deleteTableManager (M2MCEP *self)
+unsigned long M2MCEP_getCheckpointTime (M2MCEP *self)
 	{
-	//========== Variable ==========
-	M2MTableManager *tableManager = NULL;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_deleteTableManager()";
-
 	//===== Check argument =====
-	if (self!=NULL && (tableManager=this_getTableManager(self))!=NULL)
+	if (self!=NULL)
 		{
-		M2MTableManager_delete(&tableManager);
+		return atomic_load(&(self->checkpointTime));
 		}
 	//===== Argument error =====
-	else if (self==NULL)
-		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		}
 	else
 		{
+		return 0;
 		}
-	return;
 	}
 
 
 /**
- * Store all persistent unprocessed records in the SQLite 3 database on the file.<br>
+ * Returns the total number of records committed into the SQLite3 database in <br>
+ * memory so far.<br>
+ * A caller can compare it with the number of records it has inserted to know <br>
+ * whether its records have been committed (group commit or asynchronous mode).<br>
  *
  * @param[in] self	CEP structure object
+ * @return			Total number of committed records[row]
  */
-static void this_flushCEPRecord (M2MCEP *self)
+unsigned long M2MCEP_getCommittedRecordCount (M2MCEP *self)
 	{
-	//========== Variable ==========
-	sqlite3 *fileDatabase = NULL;
-	M2MTableManager *tableManager = NULL;
-	M2MDataFrame *dataFrame = NULL;
-	bool persistence = false;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_flushCEPRecord()";
-
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		//===== Retrieve (the first node of) the record management object =====
-		if ((tableManager=this_getTableManager(self))!=NULL
-				&& (dataFrame=M2MDataFrame_begin(this_getDataFrame(self)))!=NULL)
-			{
-			//===== In the case of record persistence =====
-			if ((persistence=this_getPersistence(self))==true
-					&& (fileDatabase=M2MCEP_getFileDatabase(self))!=NULL)
-				{
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Initiates transaction processing to bulk insert record information into SQLite database on file");
-				//===== Start Transaction =====
-				M2MSQLite_beginTransaction(fileDatabase);
-				//===== Repeat until record management object reaches the end =====
-				while (M2MDataFrame_next(dataFrame)!=NULL)
-					{
-					//===== Insert / delete record management object =====
-					this_insertRecordList(fileDatabase, dataFrame, tableManager, M2MDataFrame_getOldRecordList(dataFrame));
-					//===== Move to the next record management object =====
-					dataFrame = M2MDataFrame_next(dataFrame);
-					}
-				//===== Insert / delete end record management object =====
-				this_insertRecordList(fileDatabase, dataFrame, tableManager, M2MDataFrame_getOldRecordList(dataFrame));
-				//===== End Transaction =====
-				M2MSQLite_commitTransaction(M2MCEP_getFileDatabase(self));
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished transaction processing to bulk insert records not inserted into SQLite database on file");
-				}
-			//===== In case of record non-persistence =====
-			else
-				{
-				}
-			//===== Successful completion =====
-			return;
-			}
-		//===== Error handling =====
-		else if (tableManager==NULL)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object obtained from the CEP execution object specified by the argument is NULL");
-			return;
-			}
-		else
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The record management object obtained from the CEP execution object specified by the argument is NULL");
-			return;
-			}
+		return atomic_load(&(self->committedRecord));
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return;
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_getCommittedRecordCount()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
 		}
 	}
 
 
 /**
- * Get the CEP record information object managed by the argument CEP object.<br>
+ * Return string indicating the database name possessed by the CEP object.<br>
  *
  * @param[in] self	CEP structure object
- * @return			CEP record information object
+ * @return			String indicating database file name or NULL (in case of error)
  */
-static M2MDataFrame *this_getDataFrame (const M2MCEP *self)
+M2MString *M2MCEP_getDatabaseName (const M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getDataFrame()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getDatabaseName()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->dataFrame;
+		return self->databaseName;
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Copy SQLite3 database working directory pathname (="~/.m2m/cep").<br>
- * Because the heap memory allocation process is executed inside this function, <br>
- * caller must release the memory to prevent memory leak.<br>
+ * Returns the number of CSV strings discarded by M2MCEP_enqueueCSV() because <br>
+ * the queue was full (drop policy).<br>
  *
- * @param[out] directoryPath	Pointer for storing string indicating the directory SQLite 3 database file is set
- * @return						SQLite3 working directory pathname or NULL (in case of error)
+ * @param[in] self	CEP structure object
+ * @return			Number of dropped CSV strings
  */
-static M2MString *this_getDatabaseDirectoryPath (M2MString **directoryPath)
+unsigned long M2MCEP_getDroppedCSVCount (M2MCEP *self)
 	{
-	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getDatabaseDirectoryPath()";
-
 	//===== Check argument =====
-	if (directoryPath!=NULL)
+	if (self!=NULL)
 		{
-		//===== Get CEP working directory pathname =====
-		if (M2MString_append(directoryPath, M2MDirectory_getHomeDirectoryPath())!=NULL
-				&& M2MString_append(directoryPath, M2MDirectory_SEPARATOR)!=NULL
-				&& M2MString_append(directoryPath, M2MCEP_DIRECTORY)!=NULL)
-			{
-			return (*directoryPath);
-			}
-		//===== Error handling =====
-		else
-			{
-			M2MHeap_free((*directoryPath))
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to copy the string indicating the home directory path");
-			return NULL;
-			}
+		return atomic_load(&(self->droppedCSV));
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"directoryPath\" pointer is NULL");
-		return NULL;
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_getDroppedCSVCount()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
 		}
 	}
 
 
 /**
- * Create string indicating the database file path and copy it to the buffer. <br>
- * If processing fails, NULL is returned as a return value.<br>
+ * Returns the total number of records evicted from the table of the SQLite3 <br>
+ * database in memory (the records left the record window).<br>
  *
- * @param[in] databaseName			String indicating SQLite3 database file name
- * @param[out] databaseFilePath		Pointer for storing string indicating the database file path
- * @return							Pointer of string indicating database file path or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name
+ * @return				Number of evicted records[row] (0 in case of unknown table)
  */
-static M2MString *this_getDatabaseFilePath (const M2MString *databaseName, M2MString **databaseFilePath)
+unsigned long M2MCEP_getEvictedRecordCount (M2MCEP *self, const M2MString *tableName)
 	{
 	//========== Variable ==========
-	M2MString *directoryPath = NULL;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getDatabaseFilePath()";
+	M2MDataFrame *record = NULL;
+	unsigned long evictedRecord = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getEvictedRecordCount()";
 
 	//===== Check argument =====
-	if (databaseName!=NULL && M2MString_length(databaseName)>0
-			&& databaseFilePath!=NULL)
+	if (self!=NULL && tableName!=NULL)
 		{
-		//===== Copy database file installation directory pathname =====
-		if (this_getDatabaseDirectoryPath(&directoryPath)!=NULL
-				&& M2MDirectory_mkdirs(directoryPath, M2MSQLite_DATABASE_DIRECTORY_PERMISSION)==true
-				&& M2MString_append(databaseFilePath, directoryPath)!=NULL
-				&& M2MString_append(databaseFilePath, M2MDirectory_SEPARATOR)!=NULL
-				&& M2MString_append(databaseFilePath, databaseName)!=NULL)
-			{
-			//===== Release heap memory of directory path string =====
-			M2MHeap_free(directoryPath);
-			//=====  =====
-			return (*databaseFilePath);
-			}
-		//===== Error handling =====
-		else
+		pthread_mutex_lock(&(self->lock));
+		//===== Search the record management object of the table =====
+		for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
 			{
-			//===== In the case of directory path string exists =====
-			if (directoryPath!=NULL)
+			if (this_equalsName(M2MDataFrame_getTableName(record), tableName)==true)
 				{
-				//===== Release heap memory of directory path string =====
-				M2MHeap_free(directoryPath);
+				evictedRecord = M2MDataFrame_getEvictedRecordCount(record);
+				break;
 				}
 			else
 				{
+				// do nothing
 				}
-			return NULL;
 			}
+		pthread_mutex_unlock(&(self->lock));
+		return evictedRecord;
 		}
 	//===== Argument error =====
-	else if (databaseName==NULL || M2MString_length(databaseName)<=0)
+	else if (self==NULL)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL or vacant");
-		return NULL;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
 		}
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseFilePath\" is NULL");
-		return NULL;
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL");
+		return 0;
 		}
 	}
 
 
 /**
- * @param columnList
- * @param columnNameCSV
- * @param dataTypeArray
- * @param dataTypeArrayLength
- * @return
+ * Get the SQLite3 database object on the file managed by the CEP object. <br>
+ * If the CEP object does not hold the SQLite 3 database object on the file <br>
+ * and the record persistence flag is set up, it will acquire and return <br>
+ * the SQLite 3 database object newly created.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			SQLite3 database object on file or NULL (in case of error)
  */
-static unsigned int this_getDataTypeArray (M2MColumnList *columnList, const M2MString *columnNameCSV, M2MSQLiteDataType dataTypeArray[], const size_t dataTypeArrayLength)
+sqlite3 *M2MCEP_getFileDatabase (M2MCEP *self)
 	{
 	//========== Variable ==========
-	M2MString *columnName = NULL;
-	M2MString *index = NULL;
-	unsigned int dataTypeIndex = 0;
-	M2MColumn *column = NULL;
-	M2MSQLiteDataType dataType;
-	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
+	M2MString *databaseName = NULL;
+	M2MTableManager *tableManager = NULL;
+	sqlite3 *fileDatabase = NULL;
+	const bool SYNCHRONOUS_MODE = false;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getFileDatabase()";
 
 	//===== Check argument =====
-	if (columnList!=NULL
-			&& columnNameCSV!=NULL && M2MString_length(columnNameCSV)>0
-			&& dataTypeArray!=NULL
-			&& dataTypeArrayLength>0)
+	if (self!=NULL)
 		{
-		//===== Get head pointer of column name in CSV format =====
-		columnName = (M2MString *)columnNameCSV;
-		//===== Create a column data type storage array =====
-		memset(dataTypeArray, 0, dataTypeArrayLength);
-		dataTypeIndex = 0;
-		//===== Separate column names in CSV format with commas =====
-		while (columnName!=NULL
-				&& (index=M2MString_indexOf(columnName, (M2MString *)M2MString_COMMA))!=NULL)
+		//===== Confirm the flag for record persistence =====
+		if (this_getPersistence(self)==true)
 			{
-			//===== Search objects with the same column name =====
-			if ((column=M2MColumnList_search(columnList, columnName, M2MString_length(columnName) - M2MString_length(index)))!=NULL)
+			//===== Confirm SQLite 3 database management object on file =====
+			if (self->fileDatabase!=NULL)
 				{
-				//===== Get column data type =====
-				dataType = M2MColumn_getDataType(column);
-				//===== Store column data type in array =====
-				dataTypeArray[dataTypeIndex] = dataType;
+				return self->fileDatabase;
 				}
-			//===== Error handling =====
+			//===== When not owning the SQLite 3 database management object on the file =====
 			else
 				{
-				dataTypeArray[dataTypeIndex] = M2MSQLiteDataType_ERROR;
+				//===== Get SQLite3 database management object on file =====
+				if ((databaseName=M2MCEP_getDatabaseName(self))!=NULL
+						&& (tableManager=this_getTableManager(self))!=NULL
+						&& (fileDatabase=this_openFileDatabase(databaseName, self->partition, tableManager, SYNCHRONOUS_MODE, this_getVacuumRecord(self), self->incrementalVacuumPage>0))!=NULL)
+					{
+					//===== Set SQLite3 database management object on file =====
+					this_setFileDatabase(self, fileDatabase);
+					//===== Return SQLite3 database management object on file =====
+					return fileDatabase;
+					}
+				//===== Error handling =====
+				else if (databaseName==NULL)
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get database file name necessary for creating SQLite 3 database management object on file");
+					return NULL;
+					}
+				//===== Error handling =====
+				else if (tableManager==NULL)
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get the table construction object necessary for creating the SQLite 3 database management object on the file");
+					return NULL;
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create SQLite3 database management object on file");
+					return NULL;
+					}
 				}
-			dataTypeIndex++;
-			//===== Move the pointer by comma =====
-			index += COMMA_LENGTH;
-			//===== Move the start pointer to the next column name =====
-			columnName = index;
-			}
-		//===== Search objects with the same column name =====
-		if ((column=M2MColumnList_search(columnList, columnName, M2MString_length(columnName)))!=NULL)
-			{
-			//===== Get column data type =====
-			dataType = M2MColumn_getDataType(column);
-			//===== Store column data type in array =====
-			dataTypeArray[dataTypeIndex] = dataType;
-			dataTypeIndex++;
 			}
-		//===== Error handling =====
+		//===== When the record persistence flag is not set =====
 		else
 			{
-			dataTypeArray[dataTypeIndex] = M2MSQLiteDataType_ERROR;
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Because record persistence is invalid, we don't get the SQLite3 database object on the file");
+			return NULL;
 			}
-		return dataTypeIndex;
 		}
 	//===== Argument error =====
 	else
 		{
-		return 0;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
 	}
 
 
 /**
- * Get the upper limit of the number of CEP records held by the argument CEP object.<br>
+ * Returns the number of records handed off to the background persistence <br>
+ * thread and not yet committed into the SQLite3 database on file.<br>
  *
- * @param[in] self	CEP structure object
- * @return			The upper limit of the number of CEP records
+ * @param[in,out] self	CEP structure object
+ * @return				Number of in-flight records[row]
  */
-static unsigned int this_getMaxRecord (const M2MCEP *self)
+unsigned long M2MCEP_getInFlightRecordCount (M2MCEP *self)
 	{
 	//========== Variable ==========
-	const unsigned int DEFAULT_MAX_RECORD = 50;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getMaxRecord()";
+	unsigned long inFlightRecord = 0;
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->maxRecord;
+		pthread_mutex_lock(&(self->persistenceMutex));
+		inFlightRecord = self->handedOffRecord - self->persistedRecord;
+		pthread_mutex_unlock(&(self->persistenceMutex));
+		return inFlightRecord;
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return DEFAULT_MAX_RECORD;
+		return 0;
 		}
 	}
 
 
 /**
- * Get a flag indicating persistence availability from the argument CEP object.<br>
+ * Return the number of INSERT operations which reused a prepared statement <br>
+ * cached per table and column header (total of memory and file database).<br>
  *
- * @param[in,out] self		CEP structure object
- * @return					Flag indicating permanence
+ * @param[in] self	CEP structure object
+ * @return			Number of cache hits
  */
-static bool this_getPersistence (const M2MCEP *self)
+uint64_t M2MCEP_getInsertCacheHitCount (const M2MCEP *self)
 	{
 	//========== Variable ==========
-	const bool PERSISTENCE = true;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getPersistence()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getInsertCacheHitCount()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->persistence;
+		return M2MStatementCache_getHitCount(self->memoryStatementCache) + M2MStatementCache_getHitCount(self->fileStatementCache);
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return PERSISTENCE;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
 		}
 	}
 
 
 /**
- * Get the number of inserted records held by the argument CEP object.<br>
+ * Return the number of INSERT operations which had to compile a new prepared <br>
+ * statement (total of memory and file database).<br>
  *
- * @param self	CEP structure object
- * @return		Number of inserted records
+ * @param[in] self	CEP structure object
+ * @return			Number of cache misses
  */
-static unsigned int this_getRecordCounter (const M2MCEP *self)
+uint64_t M2MCEP_getInsertCacheMissCount (const M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getRecordCounter()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getInsertCacheMissCount()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->recordCounter;
+		return M2MStatementCache_getMissCount(self->memoryStatementCache) + M2MStatementCache_getMissCount(self->fileStatementCache);
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return 0;
 		}
 	}
 
 
 /**
- * Get the table construction object held by the CEP object as a member variable.<br>
+ * Returns the high-water mark of the queue length of the asynchronous mode.<br>
  *
  * @param[in] self	CEP structure object
- * @return			Table construction object or NULL (in case of error)
+ * @return			Maximum number of CSV strings waiting in the queue so far
  */
-static M2MTableManager *this_getTableManager (const M2MCEP *self)
+size_t M2MCEP_getMaxQueueLength (M2MCEP *self)
 	{
-	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getTableManager()";
-
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->tableManager;
+		return atomic_load(&(self->maxQueueLength));
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return NULL;
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_getMaxQueueLength()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
 		}
 	}
 
 
 /**
- * Get the number of records for which SQLite3 database performs vacuum processing.<br>
+ * Return the logging object owned by the argument CEP object.<br>
  *
  * @param[in] self	CEP structure object
- * @return			Number of records for which SQLite 3 database performs vacuum processing
+ * @return			Logging object
  */
-static unsigned int this_getVacuumRecord (const M2MCEP *self)
+M2MFileAppender *M2MCEP_getLogger (const M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_getVacuumRecord()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getLogger()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->vacuumRecord;
+		return self->logger;
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return 0;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
 	}
 
 
 /**
- * @param[in] csv
- * @return				true : , false :
+ * Return the SQLite 3 database object on the memory managed by the CEP object.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			SQLite3 database object on memory or NULL (in case of error)
  */
-static bool this_includesData (const M2MString *csv)
+sqlite3 *M2MCEP_getMemoryDatabase (M2MCEP *self)
 	{
 	//========== Variable ==========
-	M2MString *index = NULL;
-	const size_t CRLF_LENGTH = M2MString_length((M2MString *)M2MString_CRLF);
+	sqlite3 *memoryDatabase = NULL;
+	const bool SYNCHRONOUS_MODE = false;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getMemoryDatabase()";
 
 	//===== Check argument =====
-	if (csv!=NULL)
+	if (self!=NULL)
 		{
-		//===== Confirm header line feed code =====
-		if ((index=M2MString_indexOf(csv, (M2MString *)M2MString_CRLF))!=NULL)
+		//===== Confirm SQLite 3 database management object in memory =====
+		if (self->memoryDatabase!=NULL)
 			{
-			//===== Advance the pointer by the number of line feed code characters =====
-			index += CRLF_LENGTH;
-			//===== Confirm existence of data =====
-			if (M2MString_length(index)>0)
+			return self->memoryDatabase;
+			}
+		//===== When the SQLite 3 database management object in the memory doesn't exist =====
+		else
+			{
+			//===== Open SQLite 3 database management object in memory =====
+			if ((memoryDatabase=this_openMemoryDatabase(this_getTableManager(self), SYNCHRONOUS_MODE, this_getVacuumRecord(self), self->incrementalVacuumPage>0))!=NULL)
 				{
-				return true;
+				//===== Restore the window saved by M2MCEP_checkpoint() =====
+				this_restoreMemoryDatabase(self, memoryDatabase);
+				//===== Set SQLite3 database management object on memory =====
+				this_setMemoryDatabase(self, memoryDatabase);
+				//===== Return SQLite3 database management object in memory =====
+				return memoryDatabase;
 				}
-			//===== When data was not included =====
+			//===== Error handling =====
 			else
 				{
-				return false;
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create SQLite3 database object in memory");
+				return NULL;
 				}
 			}
-		//===== When the header is not included =====
-		else
-			{
-			return false;
-			}
 		}
 	//===== Argument error =====
 	else
 		{
-		return false;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
 	}
 
 
 /**
- * Initializes the CEP object specified by the argument.<br>
+ * Returns the number of CSV strings currently waiting in the queue of the <br>
+ * asynchronous mode.<br>
  *
- * @param[in,out] self		CEP structure object
- * @param[in] databaseName	SQLite3 database name on file
- * @param[in] tableManager	Object for building SQLite3 database table
- * @return					CEP structure object or NULL (in case of error)
+ * @param[in] self	CEP structure object
+ * @return			Number of waiting CSV strings (0 in case of synchronous mode)
  */
-static M2MCEP *this_init (M2MCEP *self, const M2MString *databaseName, const M2MTableManager *tableManager)
+size_t M2MCEP_getQueueLength (M2MCEP *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return M2MConcurrentQueue_length(self->queue);
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_getQueueLength()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Return the number of SELECT operations which reused a prepared statement <br>
+ * cached per SQL string.<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of cache hits
+ */
+uint64_t M2MCEP_getSelectCacheHitCount (const M2MCEP *self)
 	{
 	//========== Variable ==========
-	M2MFileAppender *logger = NULL;
-	const unsigned int MAX_RECORD = 50;
-	const bool PERSISTENCE = true;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_init()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getSelectCacheHitCount()";
 
 	//===== Check argument =====
-	if (self!=NULL
-			&& databaseName!=NULL && M2MString_length(databaseName)>0
-			&& tableManager!=NULL)
+	if (self!=NULL)
 		{
-		//===== Initialize CEP object =====
-		if (this_setDatabaseName(self, databaseName)!=NULL
-				&& M2MCEP_setMaxRecord(self, MAX_RECORD)!=NULL
-				&& this_setDataFrame(self, M2MDataFrame_new())!=NULL
-				&& this_setTableManager(self, tableManager)!=NULL
-				&& M2MCEP_setPersistence(self, PERSISTENCE)!=NULL
-				&& (logger=M2MFileAppender_new())!=NULL
-				&& M2MCEP_setLogger(self, logger)!=NULL
-				)
-			{
-			return self;
-			}
-		//===== Error handling =====
-		else
-			{
-			M2MCEP_delete(&self);
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to initialize \"M2MCEP\" object");
-			return NULL;
-			}
+		return M2MStatementCache_getHitCount(self->selectStatementCache);
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Return the number of SELECT operations which had to compile a new prepared <br>
+ * statement (first use, eviction or schema change).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of cache misses
+ */
+uint64_t M2MCEP_getSelectCacheMissCount (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getSelectCacheMissCount()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return M2MStatementCache_getMissCount(self->selectStatementCache);
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the total number of free pages removed by incremental vacuum (see <br>
+ * M2MCEP_setIncrementalVacuum()).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Number of removed pages
+ */
+unsigned long M2MCEP_getVacuumPageCount (M2MCEP *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return atomic_load(&(self->vacuumPage));
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the time spent by the last incremental vacuum slice (see <br>
+ * M2MCEP_setIncrementalVacuum()).<br>
+ *
+ * @param[in] self	CEP structure object
+ * @return			Time of the last slice[usec]
+ */
+unsigned long M2MCEP_getVacuumTime (M2MCEP *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return atomic_load(&(self->vacuumTime));
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Return CEP library version number string defined in "M2MCEP.h" file.
+ *
+ * @return	CEP library version number string
+ */
+M2MString *M2MCEP_getVersion ()
+	{
+	return M2MCEP_VERSION;
+	}
+
+
+/**
+ * Insert string in CSV format into the table of SQLite 3 database for CEP. <br>
+ * The internal processing procedure is as follows.<br>
+ * <br>
+ * 1) Parse CSV string and import into a CEPRecord structure object. <br>
+ * 2) Insert record data into the table of SQLite3 memory database. <br>
+ * 3) Check the current record number of the table of SQLite3 memory database, <br>
+ *    and delete it in the oldest order if it exceeds the specified <br>
+ *    maximum value. <br>
+ * 4) Fetch the same data as the deleted record from the CEPRecord <br>
+ *    structure object and insert it into the SQLite3 database file for <br>
+ *    persistence. <br>
+ * 5) Delete excess from record data of CEPRecord structure object. <br>
+ * In group commit mode, the records are accumulated and committed later (see <br>
+ * M2MCEP_setGroupCommit()).<br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+int M2MCEP_insertCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv)
+	{
+	//========== Variable ==========
+	int numberOfRecord = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_insertCSV()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		numberOfRecord = this_insertCSV(self, tableName, csv);
+		pthread_mutex_unlock(&(self->lock));
+		return numberOfRecord;
 		}
 	//===== Argument error =====
-	else if (self==NULL)
+	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return NULL;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
 		}
-	else if (databaseName==NULL || M2MString_length(databaseName)<=0)
+	}
+
+
+/**
+ * Insert typed records into the table of SQLite 3 database for CEP. <br>
+ * Unlike M2MCEP_insertCSV(), values are bound to the prepared INSERT statement <br>
+ * as they are (without formatting into or parsing from CSV format string), so <br>
+ * this is suitable for high frequency ingestion. <br>
+ * The inserted records are subject to the same record window, eviction and <br>
+ * persistence as M2MCEP_insertCSV(). Records of the table are kept only in the <br>
+ * SQLite3 database in memory (not copied into the record management object) <br>
+ * until they are evicted. <br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order (values of a row are arranged in the column order of the table definition)
+ * @param[in] rows		Number of records[row]
+ * @param[in] columns	Number of values per record (must match the number of columns of the table)
+ * @return				Number of inserted records[row] or -1 (in case of error)
+ */
+int M2MCEP_insertRecords (M2MCEP *self, const M2MString *tableName, const M2MCEPValue *values, const size_t rows, const size_t columns)
+	{
+	//========== Variable ==========
+	int numberOfRecord = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_insertRecords()";
+
+	//===== Check argument =====
+	if (self!=NULL)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL or vacant");
-		return NULL;
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		numberOfRecord = this_insertRecords(self, tableName, values, rows, columns);
+		pthread_mutex_unlock(&(self->lock));
+		return numberOfRecord;
 		}
+	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MTableManager\" structure object is NULL");
-		return NULL;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
 		}
 	}
 
 
 /**
- * @param[in] fileDatabase	SQLite3 managed object on file
- * @param[in] tableManager	Table construction object
- * @param[in] tableRecord	Table record management object
- * @param[in] maxRecord		Maximum number of records to keep in SQLite3 database table in memory (Execution of persistence when it becomes larger)
- * @param[in] persistence	Flag indicating whether to perform persistence
- * @return
+ * Constructor.<br>
+ * Create new CEP structure object and prepare for SQLite3 database processing. <br>
+ * For the table, be sure to specify the SQLite3 database on memory as it <br>
+ * needs to be built every time "M2MCEP" object is created. <br>
+ *
+ * @param[in] databaseName	String indicating SQLite3 database name
+ * @param[in] tableBuilder	Structure object for building SQLite3 database table
+ * @return					Created CEP structure object or NULL (in case of error)
  */
-static void this_insertOldRecordList (sqlite3 *fileDatabase, M2MDataFrame *tableRecord, M2MTableManager *tableManager, const unsigned int maxRecord, const bool persistence)
+M2MCEP *M2MCEP_new (const M2MString *databaseName, const M2MTableManager *tableManager)
 	{
 	//========== Variable ==========
-	sqlite3_stmt* statement = NULL;
-	M2MColumnList *columnList = NULL;
-	M2MList *oldRecordList = NULL;
-	unsigned int oldRecordListLength = 0;
-	M2MSQLiteDataType DATA_TYPE_ARRAY[M2MSQLite_getMaxColumnLength(fileDatabase)];
-	M2MString *value = NULL;
-	M2MString *valueIndex = NULL;
-	M2MString *insertSQL = NULL;
-	M2MString *tableName = NULL;
-	M2MString *columnNameCSV = NULL;
-	unsigned int columnIndex = 0;
-	unsigned int dataTypeArrayLength = 0;
-	int rest = 0;
-	unsigned int i = 0;
-	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP.this_insertOldRecordList()";
+	M2MCEP *self = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_new()";
 
 	//===== Check argument =====
-	if (tableRecord!=NULL
-			&& (tableName=M2MDataFrame_getTableName(tableRecord))!=NULL
-			&& (oldRecordList=M2MList_begin(M2MDataFrame_getOldRecordList(tableRecord)))!=NULL
-			&& (oldRecordListLength=M2MList_length(oldRecordList))>0)
+	if (databaseName!=NULL && tableManager!=NULL)
 		{
-		//===== When the number of records in which SQLite 3 database has been inserted in memory exceeds the specified maximum number of records =====
-		if ((rest=oldRecordListLength-maxRecord)>0)
+		//===== Get heap memory of CEP execution object =====
+		if ((self=(M2MCEP *)M2MHeap_malloc(sizeof(M2MCEP)))!=NULL)
 			{
-			//===== In case of past insert record persistence =====
-			if (persistence==true)
-				{
-				//===== Preparation for past record insertion into SQLite 3 database on file =====
-				if ((columnNameCSV=M2MDataFrame_getColumnName(tableRecord))!=NULL
-						&& (columnList=M2MColumnList_begin(M2MTableManager_getColumnList(tableManager, tableName)))!=NULL
-						&& (dataTypeArrayLength=this_getDataTypeArray(columnList, columnNameCSV, DATA_TYPE_ARRAY, sizeof(DATA_TYPE_ARRAY)))>0
-						&& this_createInsertSQL(tableName, columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
-						&& (statement=M2MSQLite_getPreparedStatement(fileDatabase, insertSQL))!=NULL)
-					{
-					}
-				//===== Error handling =====
-				else if (columnNameCSV==NULL)
-					{
-					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The CSV format string indicating the column name obtained from the table record management object is NULL");
-					return;
-					}
-				else if (columnList==NULL)
-					{
-					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The column structure object of the table obtained from the table building object is NULL");
-					return;
-					}
-				else if (dataTypeArrayLength<=0)
-					{
-					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Column data type array obtained from table building object is NULL");
-					return;
-					}
-				else if (insertSQL==NULL)
-					{
-					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"An attempt to create an INSERT statement to insert a record into the SQLite 3 database on the file failed");
-					return;
-					}
-				else
-					{
-					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(fileDatabase));
-					return;
-					}
-				}
-			//===== In case of past insertion record non-persistence =====
-			else
-				{
-				// do nothing
-				}
-			//===== Repeat as many records as the excess =====
-			for (i=0; i<rest; i++)
-				{
-				//===== When to make it persistent =====
-				if (persistence==true)
-					{
-					//===== Create an INSERT statement =====
-					if ((value=(M2MString *)M2MList_getValue(oldRecordList))!=NULL)
-						{
-						//===== Initialize field position =====
-						columnIndex = 0;
-						//===== Repeat with column name in CSV format =====
-						while (columnIndex<(dataTypeArrayLength-1)
-								&& value!=NULL
-								&& (valueIndex=M2MString_indexOf(value, (M2MString *)M2MString_COMMA))!=NULL)
-							{
-							//===== Set value =====
-							M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value)-M2MString_length(valueIndex), statement);
-							//===== Move the field position to the next =====
-							columnIndex++;
-							//===== Move the position of the value to the next =====
-							valueIndex += COMMA_LENGTH;
-							value = valueIndex;
-							}
-						//===== Check the consistency of the number of columns and the number of inserted data =====
-						if (columnIndex==(dataTypeArrayLength-1))
-							{
-							//===== Set the last insert data =====
-							M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value), statement);
-							//===== Execute INSERT =====
-							if (M2MSQLite_next(statement)==SQLITE_DONE)
-								{
-								}
-							//===== Error handling =====
-							else
-								{
-								M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(fileDatabase));
-								}
-							}
-						//===== Reset parameters of INSERT statement =====
-						sqlite3_reset(statement);
-						}
-					//===== Error creating INSERT statement =====
-					else
-						{
-						M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed in preparing INSERT statement for inserting record into SQLite 3 database on file");
-						}
-					}
-				//===== When not to perpetuate =====
-				else
-					{
-					// do nothing
-					}
-				//===== Delete the record inserted in the database and move to the next record information object =====
-				oldRecordList = M2MList_remove(oldRecordList);
-				}
-			//===== When to make it persistent =====
-			if (persistence==true)
+			//===== Initialize member variable of CEP object =====
+			if (this_init(self, databaseName, tableManager)!=NULL)
 				{
-				//===== Execution of SQL execution object (releasing heap memory area) =====
-				M2MSQLite_closeStatement(statement);
+				//===== Return new created CEP object =====
+				return self;
 				}
-			//===== When not to perpetuate =====
+			//===== Error handling =====
 			else
 				{
-				// do nothing
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to initialize CEP object");
+				//===== Release heap memory area for CEP object =====
+				M2MCEP_delete(&self);
+				return NULL;
 				}
-			//===== Update record information object =====
-			tableRecord->oldRecordList = oldRecordList;
-			//===== Release heap memory area of INSERT statement =====
-			M2MHeap_free(insertSQL);
-			return;
 			}
-		//===== When the number of records in which SQLite 3 database has been inserted in memory is within the specified maximum number of records =====
+		//===== Error handling =====
 		else
 			{
-			return;
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get the heap memory area for creating a new CEP object");
+			return NULL;
 			}
 		}
-	//===== Error handling =====
-	else if (tableRecord==NULL)
-		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The record management object specified by the argument is NULL");
-		return;
-		}
-	else if (tableName==NULL)
-		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"String indicating table name obtained from table record management object is NULL");
-		return;
-		}
-	else if (oldRecordList==NULL)
+	//===== Argument error =====
+	else if (databaseName==NULL)
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Inserted record information object obtained from table record management object is NULL");
-		return;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL");
+		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Number of non-inserted records acquired from table record management object is 0 or less");
-		return;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"tableManager\" object is NULL");
+		return NULL;
 		}
 	}
 
 
 /**
- * Bulk insert records into SQLite 3 database specified by argument.<br>
+ * Open a read handle of the SQLite3 database in memory for the calling <br>
+ * thread.<br>
+ * The reader holds a read-only snapshot of the window (taken with <br>
+ * sqlite3_serialize() while the CEP object is locked for a moment) in its <br>
+ * own SQLite3 connection. M2MCEP_selectReader() runs on the snapshot without <br>
+ * locking the CEP object, so that ingest continues during long queries.<br>
+ * A new snapshot is taken before a query when records were committed and <br>
+ * "maxAge" has elapsed since the last one (copy of the whole window).<br>
+ * The SQL function of M2MCEP_setAggregate() isn't available in a reader.<br>
+ * A reader must be used by one thread at a time and be closed with <br>
+ * M2MCEP_closeReader() before the CEP object is deleted.<br>
  *
- * @param[in] database		SQLite3 database management object
- * @param[in] record		Record management object
- * @param[in] tableManager	Table construction object
- * @param[in] recordList	Record information object
- * @return					Number of inserted records or -1 (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] maxAge	Minimum time between two snapshots[usec] (0: every query sees the latest committed records)
+ * @return				Read handle or NULL (in case of error)
  */
-static int this_insertRecordList (sqlite3 *database, const M2MDataFrame *record, M2MTableManager *tableManager, M2MList *recordList)
+M2MCEPReader *M2MCEP_openReader (M2MCEP *self, const uint64_t maxAge)
 	{
 	//========== Variable ==========
-	sqlite3_stmt* statement = NULL;
-	M2MColumnList *columnList = NULL;
-	M2MSQLiteDataType DATA_TYPE_ARRAY[M2MSQLite_getMaxColumnLength(database)];
-	M2MString *value = NULL;
-	M2MString *valueIndex = NULL;
-	M2MString *insertSQL = NULL;
-	M2MString *tableName = NULL;
-	M2MString *columnNameCSV = NULL;
-	int numberOfRecord = 0;
-	unsigned int columnIndex = 0;
-	unsigned int dataTypeArrayLength = 0;
-	const size_t COMMA_LENGTH = M2MString_length((M2MString *)M2MString_COMMA);
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecordList()";
+	M2MCEPReader *reader = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_openReader()";
 
 	//===== Check argument =====
-	if (database!=NULL && tableManager!=NULL && record!=NULL && (recordList=M2MList_begin(recordList))!=NULL)
+	if (self!=NULL)
 		{
-		//===== Get table name, column name CSV and new record information object to be inserted =====
-		if ((tableName=M2MDataFrame_getTableName(record))!=NULL
-				&& (columnNameCSV=M2MDataFrame_getColumnName(record))!=NULL
-				&& (columnList=M2MTableManager_getColumnList(tableManager, tableName))!=NULL
-				&& (columnList=M2MColumnList_begin(columnList))!=NULL
-				&& this_createInsertSQL(tableName, columnNameCSV, M2MColumnList_length(columnList), &insertSQL)!=NULL
-				&& (statement=M2MSQLite_getPreparedStatement(database, insertSQL))!=NULL
-				&& (dataTypeArrayLength=this_getDataTypeArray(columnList, columnNameCSV, DATA_TYPE_ARRAY, sizeof(DATA_TYPE_ARRAY)))>0)
+		//===== Open the connection of the reader and take the first snapshot =====
+		if ((reader=(M2MCEPReader *)M2MHeap_malloc(sizeof(M2MCEPReader)))!=NULL
+				&& (reader->database=M2MSQLite_openDatabase(M2MSQLite_MEMORY_DATABASE))!=NULL
+				&& (reader->statementCache=M2MStatementCache_new(reader->database, M2MCEP_SELECT_STATEMENT_CACHE_CAPACITY))!=NULL)
 			{
-			//===== Reset parameters of SQL statement =====
-			sqlite3_reset(statement);
-			//===== Repeat with uninserted record information object =====
-			while (recordList->next!=NULL)
+			reader->cep = self;
+			reader->maxAge = maxAge;
+			if (this_updateReaderSnapshot(reader)==true)
 				{
-				//===== Create an INSERT statement =====
-				if ((value=(M2MString *)M2MList_getValue(recordList))!=NULL)
-					{
-					//===== Initialize field position =====
-					columnIndex = 0;
-					//===== Repeat with column name in CSV format =====
-					while (columnIndex<(dataTypeArrayLength-1)
-							&& value!=NULL
-							&& (valueIndex=M2MString_indexOf(value, (M2MString *)M2MString_COMMA))!=NULL)
-						{
-						//===== Set value to INSERT statement =====
-						M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value)-M2MString_length(valueIndex), statement);
-						//===== Move the field position to the next =====
-						columnIndex++;
-						//===== Move the position of the value to the next =====
-						valueIndex += COMMA_LENGTH;
-						value = valueIndex;
-						}
-					//===== Check the consistency of the number of columns and the number of inserted data =====
-					if (columnIndex==(dataTypeArrayLength-1))
-						{
-						//===== Set the last data to INSERT statement =====
-						M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value), statement);
-						//===== Execute INSERT statement =====
-						if (M2MSQLite_next(statement)==SQLITE_DONE)
-							{
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"An error occurred in INSERT processing of SQLite3 database");
-							}
-						}
-					//===== Reset parameters of INSERT statement =====
-					sqlite3_reset(statement);
-					//===== Count the number of inserted records =====
-					numberOfRecord++;
-					}
-				//===== Error creating INSERT statement =====
-				else
-					{
-					M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed in preparing INSERT statement for inserting records into SQLite 3 database");
-					}
-				//===== Proceed to next uninserted record =====
-				recordList = M2MList_next(recordList);
+				return reader;
 				}
-			//===== Create an INSERT statement from the (last) uninserted record =====
-			if ((value=(M2MString *)M2MList_getValue(recordList))!=NULL)
+			//===== Error handling =====
+			else
+				{
+				M2MCEP_closeReader(&reader);
+				return NULL;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to open the SQLite3 connection of the reader");
+			if (reader!=NULL)
 				{
-				columnIndex = 0;
-				//===== Repeat with column name in CSV format =====
-				while (columnIndex<dataTypeArrayLength
-						&& value!=NULL
-						&& (valueIndex=M2MString_indexOf(value, (M2MString *)M2MString_COMMA))!=NULL)
-					{
-					//===== Set value to INSERT statement =====
-					M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value)-M2MString_length(valueIndex), statement);
-					//===== Move the field position to the next =====
-					columnIndex++;
-					//===== Move the position of the value to the next =====
-					valueIndex += COMMA_LENGTH;
-					value = valueIndex;
-					}
-				//===== Set the last data to INSERT statement =====
-				M2MSQLite_setValueIntoPreparedStatement(DATA_TYPE_ARRAY[columnIndex], columnIndex+1, value, M2MString_length(value), statement);
-				//===== Execute INSERT statement =====
-				if (M2MSQLite_next(statement)==SQLITE_DONE)
-					{
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"An error occurred in INSERT processing of SQLite3 database");
-					}
-				//===== Reset parameters of INSERT statement =====
-				sqlite3_reset(statement);
-				//===== Count the number of inserted records =====
-				numberOfRecord++;
+				M2MCEP_closeReader(&reader);
 				}
-			//===== Error creating INSERT statement =====
 			else
 				{
-				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed in preparing INSERT statement for inserting records into SQLite 3 database");
+				// do nothing
 				}
-			//===== Finalize SQL execution (releasing heap memory area) =====
-			M2MSQLite_closeStatement(statement);
-			//===== Release heap memory area of INSERT statement =====
-			M2MHeap_free(insertSQL);
-			//===== Returns the number of inserted records =====
-			return numberOfRecord;
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Register the event pattern built with M2MCEPPattern_new(), <br>
+ * M2MCEPPattern_followedBy() and M2MCEPPattern_notFollowedBy().<br>
+ * The pattern is compiled into a NFA and the records inserted from now on are <br>
+ * given to it after every committed batch (before the excess records are <br>
+ * evicted), so that a match is found without joining the tables.<br>
+ * The callback is called on the thread committing the records (the <br>
+ * asynchronous writer thread in asynchronous mode) and must not call <br>
+ * functions of the CEP object.<br>
+ * The pattern is owned by the CEP object when it is registered.<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in,out] pattern	Event pattern object
+ * @param[in] callback		Callback receiving the matches
+ * @param[in] userData		Pointer passed to the callback as it is
+ * @return					ID of the pattern (>0) or -1 (in case of error)
+ */
+int M2MCEP_registerPattern (M2MCEP *self, M2MCEPPattern *pattern, const M2MCEPPatternCallback callback, void *userData)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	M2MCEPPatternTable *table = NULL;
+	int patternID = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_registerPattern()";
+
+	//===== Check argument =====
+	if (self!=NULL && pattern!=NULL && pattern->statement==NULL && callback!=NULL)
+		{
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Compile the pattern and prepare its statement =====
+		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& M2MCEPPattern_compile(pattern)!=NULL
+				&& sqlite3_prepare_v2(memoryDatabase, (const char *)pattern->selectSQL, -1, &(pattern->statement), NULL)==SQLITE_OK
+				&& pattern->statement!=NULL)
+			{
+			//===== Only the records inserted from now on are given to the pattern =====
+			for (table=pattern->table; table!=NULL; table=table->next)
+				{
+				table->lastRowid = this_getTableLastRowid(self, table->tableName);
+				}
+			pattern->patternID = ++(self->lastPatternID);
+			pattern->callback = callback;
+			pattern->userData = userData;
+			pattern->next = self->pattern;
+			self->pattern = pattern;
+			patternID = (int)pattern->patternID;
+			pthread_mutex_unlock(&(self->lock));
+			return patternID;
 			}
 		//===== Error handling =====
-		else if (tableName==NULL)
+		else
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"String indicating table name obtained from record management object is NULL");
+			if (memoryDatabase!=NULL && pattern->selectSQL!=NULL)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+				}
+			else
+				{
+				// do nothing
+				}
+			if (pattern->statement!=NULL)
+				{
+				sqlite3_finalize(pattern->statement);
+				pattern->statement = NULL;
+				}
+			else
+				{
+				// do nothing
+				}
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to compile the event pattern");
 			return -1;
 			}
-		else if (columnNameCSV==NULL)
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (pattern==NULL || pattern->statement!=NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPattern\" structure object is NULL or already registered");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated callback function is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Register the SELECT statement as a continuous query.<br>
+ * The statement stays prepared on the SQLite3 database in memory and is <br>
+ * evaluated after every committed batch of records (after the window is <br>
+ * updated), only when a table read by the statement has received records. <br>
+ * Each row of the result is delivered to the callback as typed values.<br>
+ * The callback is called on the thread committing the records (the <br>
+ * asynchronous writer thread in asynchronous mode) and must not call <br>
+ * functions of the CEP object.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[in] callback	Callback receiving the rows of the result
+ * @param[in] userData	Pointer passed to the callback as it is
+ * @return				ID of the query (>0) or -1 (in case of error)
+ */
+int M2MCEP_registerQuery (M2MCEP *self, const M2MString *sql, const M2MCEPQueryCallback callback, void *userData)
+	{
+	//========== Variable ==========
+	sqlite3 *memoryDatabase = NULL;
+	M2MCEPQuery *query = NULL;
+	M2MCEPQueryTable *table = NULL;
+	int queryID = 0;
+	int result = SQLITE_ERROR;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_registerQuery()";
+
+	//===== Check argument =====
+	if (self!=NULL && sql!=NULL && callback!=NULL)
+		{
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Prepare the statement while collecting the tables read by it =====
+		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (query=(M2MCEPQuery *)M2MHeap_malloc(sizeof(M2MCEPQuery)))!=NULL)
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The CSV format string indicating the column name obtained from the record management object is NULL");
-			return -1;
+			sqlite3_set_authorizer(memoryDatabase, this_authorizeQuery, query);
+			result = sqlite3_prepare_v2(memoryDatabase, (const char *)sql, -1, &(query->statement), NULL);
+			sqlite3_set_authorizer(memoryDatabase, NULL, NULL);
 			}
-		else if (columnList==NULL)
+		else
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The column structure object of the table obtained from the table building object is NULL");
-			return -1;
+			// do nothing
 			}
-		else if (statement==NULL)
+		//===== Register the read-only statement =====
+		if (result==SQLITE_OK
+				&& query->statement!=NULL
+				&& sqlite3_stmt_readonly(query->statement)!=0
+				&& (query->numberOfColumn=(unsigned int)sqlite3_column_count(query->statement))>0
+				&& (query->row=(M2MCEPValue *)M2MHeap_malloc(sizeof(M2MCEPValue)*query->numberOfColumn))!=NULL)
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The prepared statement object obtained from the SQLite3 database management object specified by the argument is NULL");
-			return -1;
+			//===== Only the records inserted from now on trigger the evaluation =====
+			for (table=query->table; table!=NULL; table=table->next)
+				{
+				table->lastRowid = this_getTableLastRowid(self, table->tableName);
+				}
+			query->queryID = ++(self->lastQueryID);
+			query->callback = callback;
+			query->userData = userData;
+			query->next = self->query;
+			self->query = query;
+			queryID = (int)query->queryID;
+			pthread_mutex_unlock(&(self->lock));
+			return queryID;
 			}
+		//===== Error handling =====
 		else
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Column data type array obtained from table building object is NULL");
+			if (memoryDatabase!=NULL)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+				}
+			else
+				{
+				// do nothing
+				}
+			this_deleteQuery(&query);
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to prepare the SELECT statement of the continuous query");
 			return -1;
 			}
 		}
 	//===== Argument error =====
-	else if (database==NULL)
+	else if (self==NULL)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The SQLite3 database management object specified by the argument is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return -1;
 		}
-	else if (tableManager==NULL)
+	else if (sql==NULL)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The table construction object specified by the argument is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQL string is NULL");
 		return -1;
 		}
-	else if (record==NULL)
+	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The record management object specified by the argument is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated callback function is NULL");
 		return -1;
 		}
+	}
+
+
+/**
+ * Replace the snapshot of the read handle with the current window.<br>
+ *
+ * @param[in,out] reader	Read handle
+ * @return					Read handle or NULL (in case of error)
+ */
+M2MCEPReader *M2MCEP_refreshReader (M2MCEPReader *reader)
+	{
+	//===== Check argument =====
+	if (reader!=NULL)
+		{
+		//===== Take a new snapshot =====
+		if (this_updateReaderSnapshot(reader)==true)
+			{
+			return reader;
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The uninserted record information object obtained from the record management object is NULL");
-		return -1;
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_refreshReader()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPReader\" object is NULL");
+		return NULL;
 		}
 	}
 
 
 /**
- * If the specified maximum number of records is exceeded for the record of <br>
- * "already inserted in SQLite3 database in memory" of the CEP record management <br>
- * object held by the CEP execution object specified by the argument, the record <br>
- * of excess Into the SQLite 3 database on the file and make it persistent.<br>
+ * Hands the records of the column store of the table (M2MCEP_setColumnStore()) <br>
+ * whose time is within the range to the callback as typed values, in the <br>
+ * order of eviction.<br>
+ * Only the blocks whose minimum and maximum time overlap the range are read <br>
+ * from the file and only the indicated columns are decompressed. The records <br>
+ * still in the SQLite3 database in memory aren't included.<br>
+ * The callback is called with the CEP object locked and must not call <br>
+ * functions of the CEP object.<br>
  *
- * @param[in,out] self	CEP structure object
- * @return				Successful CEP execution object or NULL (in case of insertion error)
+ * @param[in,out] self			CEP structure object
+ * @param[in] tableName			String indicating the table name
+ * @param[in] from				Start of the range of the time column
+ * @param[in] to				End of the range of the time column (inclusive)
+ * @param[in] columnNameCSV		Column names separated by commas (NULL: all columns in the order of the table)
+ * @param[in] callback			Callback receiving the records
+ * @param[in] userData			Pointer passed to the callback as it is
+ * @return						Number of records handed to the callback or -1 (in case of error)
  */
-static M2MCEP *this_insertRecordListToFileDatabase (M2MCEP *self)
+int M2MCEP_scanColumnStore (M2MCEP *self, const M2MString *tableName, const int64_t from, const int64_t to, const M2MString *columnNameCSV, const M2MCEPRowCallback callback, void *userData)
 	{
 	//========== Variable ==========
-	M2MTableManager *tableManager = NULL;
-	M2MDataFrame *tableRecord = NULL;
-	unsigned int maxRecord = 0;
-	bool persistence = false;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecordListToFileDatabase()";
+	M2MCEPColumnStore *columnStore = NULL;
+	M2MString *columnNames = NULL;
+	M2MString *columnName = NULL;
+	M2MString *savePoint = NULL;
+	unsigned int *columnIndex = NULL;
+	unsigned int numberOfIndex = 0;
+	unsigned int capacity = 1;
+	int index = 0;
+	int numberOfRecord = -1;
+	size_t i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_scanColumnStore()";
 
 	//===== Check argument =====
-	if (self!=NULL)
+	if (self!=NULL && tableName!=NULL && callback!=NULL)
 		{
-		//===== Get table record management object =====
-		if ((tableManager=this_getTableManager(self))!=NULL
-				&& (tableRecord=M2MDataFrame_begin(this_getDataFrame(self)))!=NULL
-				&& (maxRecord=this_getMaxRecord(self))>0)
+		//===== Exclusive access to the column stores =====
+		pthread_mutex_lock(&(self->lock));
+		if ((columnStore=this_getColumnStore(self, tableName))==NULL)
 			{
-			//===== In the case of record persistence =====
-			if ((persistence=this_getPersistence(self))==true)
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"The column store of the indicated table isn't set");
+			return -1;
+			}
+		//===== Count the indicated columns =====
+		else if (columnNameCSV!=NULL)
+			{
+			for (i=0; columnNameCSV[i]!='\0'; i++)
 				{
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Start transaction processing to insert records into SQLite database on file");
-				//===== Start Transaction =====
-				M2MSQLite_beginTransaction(M2MCEP_getFileDatabase(self));
+				capacity += (columnNameCSV[i]==',') ? 1 : 0;
 				}
-			//===== In case of record non-persistence =====
-			else
+			}
+		else
+			{
+			capacity = columnStore->numberOfColumn;
+			}
+		//===== Convert the column names into the indexes =====
+		if ((columnIndex=(unsigned int *)M2MHeap_calloc(capacity, sizeof(unsigned int)))!=NULL)
+			{
+			if (columnNameCSV==NULL)
 				{
-				// do nothing
+				for (numberOfIndex=0; numberOfIndex<capacity; numberOfIndex++)
+					{
+					columnIndex[numberOfIndex] = numberOfIndex;
+					}
 				}
-			//===== Repeat with record management object =====
-			while (M2MDataFrame_next(tableRecord)!=NULL)
+			else if (M2MString_append(&columnNames, columnNameCSV)!=NULL)
 				{
-				//===== Execute past record processing held by record management object =====
-				this_insertOldRecordList(M2MCEP_getFileDatabase(self), tableRecord, tableManager, maxRecord, persistence);
-				//===== Move to the next table record management object =====
-				tableRecord = M2MDataFrame_next(tableRecord);
+				for (columnName=M2MString_split(columnNames, (M2MString *)M2MString_COMMA, &savePoint);
+						columnName!=NULL && numberOfIndex<capacity;
+						columnName=M2MString_split(NULL, (M2MString *)M2MString_COMMA, &savePoint))
+					{
+					if ((index=M2MCEPColumnStore_getColumnIndex(columnStore, columnName))>=0)
+						{
+						columnIndex[numberOfIndex++] = (unsigned int)index;
+						}
+					else
+						{
+						M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"The indicated column doesn't exist in the column store");
+						numberOfIndex = 0;
+						break;
+						}
+					}
+				M2MHeap_free(columnNames);
 				}
-			//===== Execute past record processing held by the last record management object =====
-			this_insertOldRecordList(M2MCEP_getFileDatabase(self), tableRecord, tableManager, maxRecord, persistence);
-			//===== In the case of record persistence =====
-			if (this_getPersistence(self)==true)
+			else
 				{
-				//===== End transaction =====
-				M2MSQLite_commitTransaction(M2MCEP_getFileDatabase(self));
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Transaction processing for inserting records into SQLite database on file has ended");
+				// do nothing
+				}
+			//===== Scan the blocks overlapping the time range =====
+			if (numberOfIndex>0)
+				{
+				numberOfRecord = M2MCEPColumnStore_scan(columnStore, from, to, columnIndex, numberOfIndex, callback, userData);
 				}
-			//===== In case of record non-persistence =====
 			else
 				{
 				// do nothing
 				}
-			//===== Successful completion =====
-			return self;
-			}
-		//===== Error handling =====
-		else if (tableManager==NULL)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table building object obtained from argument \"CEP\" object is NULL");
-			return NULL;
-			}
-		else if (tableRecord==NULL)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Table record management object obtained from argument \"CEP\" object is NULL");
-			return NULL;
+			M2MHeap_free(columnIndex);
 			}
 		else
 			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The upper limit of the number of CEP records per table obtained from argument \"CEP\" object is less than or equal to 0");
-			return NULL;
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the indexes of the columns");
 			}
+		pthread_mutex_unlock(&(self->lock));
+		return numberOfRecord;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (tableName==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated callback is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Executes the SQL statement specified by the argument on the SQLite 3 database <br>
+ * in memory and returns the result as a CSV format string.<br>
+ * For the character string of the CSV format as the execution result, the <br>
+ * column name character string is the first line, and the data after the second <br>
+ * line is the data.<br>
+ * <br>
+ * [Attention!]<br>
+ * In order to execute this function, "SQLITE_ENABLE_COLUMN_METADATA" must be <br>
+ * enabled as option setting at compile time of SQLite 3.<br>
+ * This is because this function can not create a character string of CSV format <br>
+ * to be output as a result unless table information is acquired from the SELECT <br>
+ * result.<br>
+ * If "SQLITE_ENABLE_COLUMN_METADATA" is not valid, keep in mind that this <br>
+ * function will cause a compile error (because undefined functions are called).<br>
+ * This function is serialized with the asynchronous writer thread (see <br>
+ * M2MCEP_startAsync()).<br>
+ *
+ * @param[in] self		CEP structure object (used for database management)
+ * @param[in] sql		String indicating SQL statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return
+ */
+M2MString *M2MCEP_select (M2MCEP *self, const M2MString *sql, M2MString **result)
+	{
+	//========== Variable ==========
+	M2MString *selectResult = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_select()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		selectResult = this_select(self, sql, NULL, 0, result);
+		pthread_mutex_unlock(&(self->lock));
+		return selectResult;
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Insert all records (= CEPRecord-> newRecordList) held by CEP object variables <br>
- * into SQLite3 database in memory.<br>
+ * Executes the SELECT statement on the SQLite3 database in memory and hands <br>
+ * each row of the result to the callback as typed values read directly from <br>
+ * the prepared statement (no CSV string is built and no value is converted).<br>
+ * The callback is called with the CEP object locked and must not call <br>
+ * functions of the CEP object.<br>
  *
- * @param[in] self	CEP structure object
- * @return			Number of records where insert processing or -1 (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[in] callback	Callback receiving the rows of the result
+ * @param[in] userData	Pointer passed to the callback as it is
+ * @return				Number of rows handed to the callback or -1 (in case of error)
  */
-static int this_insertRecordListToMemoryDatabase (M2MCEP *self)
+int M2MCEP_selectEach (M2MCEP *self, const M2MString *sql, const M2MCEPRowCallback callback, void *userData)
 	{
 	//========== Variable ==========
 	sqlite3 *memoryDatabase = NULL;
-	M2MTableManager *tableManager = NULL;
-	M2MDataFrame *record = NULL;
-	int numberOfRecord = 0;
+	sqlite3_stmt *statement = NULL;
+	M2MCEPValue *row = NULL;
+	unsigned int numberOfColumn = 0;
+	unsigned int i = 0;
+	int numberOfRow = 0;
 	int result = 0;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_insertRecordListToMemoryDatabase()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_selectEach()";
 
 	//===== Check argument =====
-	if (self!=NULL)
+	if (self!=NULL && sql!=NULL && callback!=NULL)
 		{
-		//===== Get database and record management object =====
-		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
-				&& (tableManager=this_getTableManager(self))!=NULL
-				&& (record=M2MDataFrame_begin(this_getDataFrame(self)))!=NULL)
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Make the records accumulated for group commit visible =====
+		this_commitRecord(self);
+		//===== Prepare the statement and the buffer of one row =====
+		if ((statement=this_getSelectStatement(self, sql))!=NULL
+				&& (memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (numberOfColumn=(unsigned int)sqlite3_column_count(statement))>0
+				&& (row=(M2MCEPValue *)M2MHeap_malloc(sizeof(M2MCEPValue)*numberOfColumn))!=NULL)
 			{
-			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Insert records into SQLite database in memory");
-			//===== Start Transaction =====
-			M2MSQLite_beginTransaction(memoryDatabase);
-			//===== Repeat until record management object reaches the end =====
-			while (M2MDataFrame_next(record)!=NULL)
+			//===== Hand the rows to the callback =====
+			while ((result=M2MSQLite_next(statement))==SQLITE_ROW)
 				{
-				//===== Batch insertion of records in the same table =====
-				if ((result=this_insertRecordList(memoryDatabase, record, tableManager, M2MDataFrame_getNewRecordList(record)))>0)
+				for (i=0; i<numberOfColumn; i++)
 					{
-					//===== Move new inserted record to past record =====
-					M2MDataFrame_moveFromNewRecordListToOldRecordList(record);
-					//===== Count the number of inserted records =====
-					numberOfRecord += result;
+					M2MCEPValue_setColumn(&(row[i]), statement, (int)i);
+					}
+				numberOfRow++;
+				if (callback(row, numberOfColumn, userData)==false)
+					{
+					result = SQLITE_DONE;
+					break;
 					}
-				//===== Error handling =====
 				else
 					{
-					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite database in memory");
+					// do nothing
 					}
-				//===== Proceed to the next record information object =====
-				record = M2MDataFrame_next(record);
 				}
-			//===== Batch insertion of (final) table into table =====
-			if ((result=this_insertRecordList(memoryDatabase, record, tableManager, M2MDataFrame_getNewRecordList(record)))>0)
+			//===== Error handling =====
+			if (result!=SQLITE_DONE)
 				{
-				//===== Move new inserted record to past record =====
-				M2MDataFrame_moveFromNewRecordListToOldRecordList(record);
-				//===== Count the number of inserted records =====
-				numberOfRecord += result;
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+				numberOfRow = -1;
 				}
-			//===== Error handling =====
 			else
 				{
-				M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite database in memory");
+				// do nothing
 				}
-			//===== Commit =====
-			M2MSQLite_commitTransaction(memoryDatabase);
-			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Finished inserting records into SQLite database in memory");
-			//===== Returns the number of inserted records =====
-			return numberOfRecord;
+			M2MHeap_free(row);
+			this_releaseSelectStatement(self, statement);
+			pthread_mutex_unlock(&(self->lock));
+			return numberOfRow;
 			}
 		//===== Error handling =====
-		else if (memoryDatabase==NULL)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The SQLite3 memory object obtained from the argument CEP object is NULL");
-			return -1;
-			}
-		else if (tableManager==NULL)
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object obtained from the argument CEP object is NULL");
-			return -1;
-			}
 		else
 			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The record management object obtained from the argument CEP object is NULL");
+			if (statement!=NULL)
+				{
+				this_releaseSelectStatement(self, statement);
+				}
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MCEP_getMemoryDatabase(self)));
+				}
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to prepare the SELECT statement");
 			return -1;
 			}
 		}
 	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return -1;
+		}
+	else if (sql==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQL string is NULL");
+		return -1;
+		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated callback function is NULL");
 		return -1;
 		}
 	}
 
 
 /**
- * Create a SQLite 3 database file under the specified directory.<br>
- * If creation fails, NULL is returned.<br>
+ * Executes the SELECT statement on the history persisted into the SQLite3 <br>
+ * database on file and returns the result as a CSV format string (same <br>
+ * format as M2MCEP_select()).<br>
+ * With time partitions (M2MCEP_setPartition()), only the partition files <br>
+ * overlapping the time range are attached (read-only) to a dedicated SQLite3 <br>
+ * connection and each table is a view joining them with UNION ALL, so the <br>
+ * SQL statement uses the table names as they are. Records belong to the <br>
+ * partition of the time they were persisted. The range can overlap at most <br>
+ * as many partitions as SQLite3 can attach (SQLITE_LIMIT_ATTACHED, 10 by <br>
+ * default). Without time partitions, the whole database file is queried.<br>
+ * The CEP object is locked only while the partition files are attached.<br>
  *
- * @param[in] databaseName	String indicating database name
- * @param[in] tableManager	Table information management object
- * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
- * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
- * @return					SQLite3 database file object or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] from		Start of the time range (UNIX time)[sec]
+ * @param[in] to		End of the time range (inclusive, UNIX time)[sec]
+ * @param[in] sql		String indicating SELECT statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return				CSV character string of execution result or NULL (in case of no data or error)
  */
-static sqlite3 *this_openFileDatabase (const M2MString *databaseName, const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord)
+M2MString *M2MCEP_selectHistory (M2MCEP *self, const time_t from, const time_t to, const M2MString *sql, M2MString **result)
 	{
 	//========== Variable ==========
-	sqlite3 *fileDatabase = NULL;
-	M2MString *databaseFilePath = NULL;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_openFileDatabase()";
+	sqlite3 *database = NULL;
+	sqlite3_stmt *statement = NULL;
+	M2MString *selectResult = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_selectHistory()";
 
 	//===== Check argument =====
-	if (databaseName!=NULL && tableManager!=NULL)
+	if (self!=NULL && from<=to && sql!=NULL && M2MString_length(sql)>0 && result!=NULL)
 		{
-		//===== Get database file path stringl =====
-		if (this_getDatabaseFilePath(databaseName, &databaseFilePath)!=NULL)
+		//===== Execute SQL on the attached history =====
+		if ((database=this_openHistoryDatabase(self, from, to, NULL))!=NULL
+				&& (statement=M2MSQLite_getPreparedStatement(database, sql))!=NULL)
 			{
-			//===== Open SQLite3 file database =====
-			if ((fileDatabase=M2MSQLite_openDatabase(databaseFilePath))!=NULL)
+			selectResult = this_createResultCSV(self, statement, result);
+			M2MSQLite_closeStatement(statement);
+			M2MSQLite_closeDatabase(database);
+			return selectResult;
+			}
+		//===== Error handling =====
+		else
+			{
+			if (database!=NULL)
 				{
-				//===== Release memory space of database file path string =====
-				M2MHeap_free(databaseFilePath);
-				//===== Set character code to UTF-8 =====
-				M2MSQLite_setUTF8(fileDatabase);
-				//===== When automatic vacuum OFF =====
-				if (vacuumRecord>0)
-					{
-					M2MSQLite_setAutoVacuum(fileDatabase, false);
-					}
-				//===== When automatic vacuum ON =====
-				else
-					{
-					M2MSQLite_setAutoVacuum(fileDatabase, true);
-					}
-				//===== Set synchronous mode =====
-				M2MSQLite_setSynchronous (fileDatabase, synchronous);
-				//===== Construct a table =====
-				M2MTableManager_createTable((M2MTableManager *)tableManager, fileDatabase);
-				//===== Return SQLite3 database object =====
-				return fileDatabase;
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(database));
+				M2MSQLite_closeDatabase(database);
 				}
-			//===== Error handling =====
 			else
 				{
-				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to open SQLite3 file database");
-				//===== Release memory space of database file path string =====
-				M2MHeap_free(databaseFilePath);
-				return NULL;
+				// do nothing
 				}
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (from>to)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated time range is reversed");
+		return NULL;
+		}
+	else if (sql==NULL || M2MString_length(sql)<=0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"result\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Executes the SELECT statement (with parameters like <br>
+ * M2MCEP_selectWithParams()) on the snapshot of the read handle and returns <br>
+ * the result as a CSV format string (same format as M2MCEP_select()).<br>
+ * The CEP object isn't locked except while a new snapshot is taken.<br>
+ *
+ * @param[in,out] reader	Read handle
+ * @param[in] sql			String indicating SELECT statement
+ * @param[in] params		Array of typed values bound into the parameters or NULL
+ * @param[in] numberOfParam	Number of typed values
+ * @param[out] result		CSV character string of execution result or NULL (in case of error)
+ * @return					CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEP_selectReader (M2MCEPReader *reader, const M2MString *sql, const M2MCEPValue *params, const size_t numberOfParam, M2MString **result)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	M2MString *selectResult = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_selectReader()";
+
+	//===== Check argument =====
+	if (reader!=NULL && sql!=NULL && result!=NULL)
+		{
+		//===== Take a new snapshot if records were committed and the snapshot is old enough =====
+		if (reader->committedRecord!=atomic_load(&(reader->cep->committedRecord))
+				&& this_getMonotonicTime()-reader->snapshotTime>=reader->maxAge)
+			{
+			this_updateReaderSnapshot(reader);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Execute SQL on the snapshot =====
+		if (((statement=M2MStatementCache_search(reader->statementCache, sql, NULL))!=NULL
+					|| (statement=M2MStatementCache_put(reader->statementCache, sql, NULL, sql))!=NULL)
+				&& this_bindSelectParameter(reader->cep, statement, params, numberOfParam)==true)
+			{
+			selectResult = this_createResultCSV(reader->cep, statement, result);
+			sqlite3_reset(statement);
+			return selectResult;
 			}
 		//===== Error handling =====
+		else if (statement!=NULL)
+			{
+			sqlite3_reset(statement);
+			return NULL;
+			}
 		else
 			{
-			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to get string indicating the file path of the SQLite database");
+			M2MLogger_error(M2MCEP_getLogger(reader->cep), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(reader->database));
 			return NULL;
 			}
 		}
-	//===== Error handling =====
-	else if (databaseName==NULL)
+	//===== Argument error =====
+	else if (reader==NULL)
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The string indicating the SQLite database name on the file is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPReader\" object is NULL");
+		return NULL;
+		}
+	else if (sql==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(reader->cep), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The table construction object specified by the argument is NULL");
+		M2MLogger_error(M2MCEP_getLogger(reader->cep), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"result\" pointer is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Create a SQLite3 database on memory.<br>
- * If creation fails, NULL is returned.<br>
+ * Executes the SELECT statement on the SQLite3 database in memory and returns <br>
+ * the result as a columnar result set: integer and real columns are <br>
+ * contiguous typed arrays, text and binary columns are offsets into a byte <br>
+ * heap (no base64) and NULL values are held in bitmaps.<br>
+ * The result set can be read without copying or serialized for IPC with <br>
+ * M2MCEPResultSet_serialize(). Caller must release it with <br>
+ * M2MCEPResultSet_delete().<br>
  *
- * @param[in] tableManager	Table information management object
- * @param[in] synchronous	true: Synchronous mode = NORMAL, false: Synchronous mode = OFF
- * @param[in] vacuumRecord	Number of records vacuum processing is to be executed (if this is 0, set automatic vacuum)
- * @return					SQLite3 database object or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] sql		String indicating SELECT statement
+ * @return				Result set (possibly with 0 rows) or NULL (in case of error)
  */
-static sqlite3 *this_openMemoryDatabase (const M2MTableManager *tableManager, const bool synchronous, const unsigned int vacuumRecord)
+M2MCEPResultSet *M2MCEP_selectResultSet (M2MCEP *self, const M2MString *sql)
 	{
 	//========== Variable ==========
 	sqlite3 *memoryDatabase = NULL;
-	const M2MString *MEMORY_DATABASE = (M2MString *)":memory:";
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_openMemoryDatabase()";
+	sqlite3_stmt *statement = NULL;
+	M2MCEPResultSet *resultSet = NULL;
+	int result = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_selectResultSet()";
 
-	//===== Open SQLite3 memory database =====
-	if ((memoryDatabase=M2MSQLite_openDatabase(MEMORY_DATABASE))!=NULL)
+	//===== Check argument =====
+	if (self!=NULL && sql!=NULL)
 		{
-		//===== Set character code to UTF-8 =====
-		M2MSQLite_setUTF8(memoryDatabase);
-		//===== When automatic vacuum OFF =====
-		if (vacuumRecord>0)
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Make the records accumulated for group commit visible =====
+		this_commitRecord(self);
+		//===== Prepare the statement and the result set =====
+		if ((statement=this_getSelectStatement(self, sql))!=NULL
+				&& (memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (resultSet=M2MCEPResultSet_new(statement))!=NULL)
 			{
-			//===== Set the vacuum setting =====
-			M2MSQLite_setAutoVacuum(memoryDatabase, false);
+			//===== Copy the rows into the columns =====
+			while ((result=M2MSQLite_next(statement))==SQLITE_ROW)
+				{
+				if (M2MCEPResultSet_addRow(resultSet, statement)==NULL)
+					{
+					break;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== Error handling =====
+			if (result!=SQLITE_DONE)
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+				M2MCEPResultSet_delete(&resultSet);
+				}
+			else
+				{
+				// do nothing
+				}
+			this_releaseSelectStatement(self, statement);
+			pthread_mutex_unlock(&(self->lock));
+			return resultSet;
 			}
-		//===== When automatic vacuum ON =====
+		//===== Error handling =====
 		else
 			{
-			//===== Set the vacuum setting =====
-			M2MSQLite_setAutoVacuum(memoryDatabase, true);
+			if (statement!=NULL)
+				{
+				this_releaseSelectStatement(self, statement);
+				}
+			else
+				{
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(M2MCEP_getMemoryDatabase(self)));
+				}
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to prepare the SELECT statement");
+			return NULL;
 			}
-		//===== Set synchronous mode =====
-		M2MSQLite_setSynchronous (memoryDatabase, synchronous);
-		//===== Construct a table =====
-		M2MTableManager_createTable((M2MTableManager *)tableManager, memoryDatabase);
-		//===== Return SQLite3 database object in memory =====
-		return memoryDatabase;
 		}
-	//===== Error handling =====
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
 	else
 		{
-		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to open SQLite database on memory");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQL string is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set SQLite3 database file name of member of the CEP structure object.<br>
+ * Executes the SELECT statement on the record window of SQLite3 database in <br>
+ * memory joined with the history persisted into the SQLite3 database on file <br>
+ * and returns the result as a CSV format string (same format as <br>
+ * M2MCEP_select()), so that the SQL statement compares recent and past <br>
+ * records with the table names as they are.<br>
+ * The history is pruned with the time range as M2MCEP_selectHistory() <br>
+ * (records belong to the time they left the record window). When no record <br>
+ * has left the window since "from", the statement is executed on SQLite3 <br>
+ * database in memory as M2MCEP_select() without touching any file. <br>
+ * Otherwise the window of the tables read by the statement is copied into a <br>
+ * dedicated SQLite3 connection where each table is a view joining it and the <br>
+ * attached partition files (or the single database file) with UNION ALL; the <br>
+ * records handed off to the background persistence thread are committed <br>
+ * before the copy, so that every record appears exactly once. The CEP object <br>
+ * is locked only while copying those tables, not while executing the <br>
+ * statement. The records of the column stores (M2MCEP_setColumnStore()) <br>
+ * aren't included.<br>
+ * Note that the time range is compared with the (wall-clock) time the records <br>
+ * left the record window, not with any time column of the records, and it <br>
+ * only selects the files to be attached. Thus the result contains records <br>
+ * outside [from, to] unless the SQL statement also filters the records by <br>
+ * their own time column.<br>
  *
- * @param[in,out] self		CEP structure object to be set SQLite3 database file name
- * @param[in] databaseName	String indicating SQLite3 database file name
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] from		Start of the time range (UNIX time)[sec]
+ * @param[in] to		End of the time range (inclusive, UNIX time)[sec]
+ * @param[in] sql		String indicating SELECT statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return				CSV character string of execution result or NULL (in case of no data or error)
  */
-static M2MCEP *this_setDatabaseName (M2MCEP *self, const M2MString *databaseName)
+M2MString *M2MCEP_selectUnified (M2MCEP *self, const time_t from, const time_t to, const M2MString *sql, M2MString **result)
 	{
 	//========== Variable ==========
-	M2MString MESSAGE[256];
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setDatabaseName()";
+	sqlite3 *database = NULL;
+	sqlite3_stmt *statement = NULL;
+	M2MString *selectResult = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_selectUnified()";
 
 	//===== Check argument =====
-	if (self!=NULL
-			&& databaseName!=NULL && M2MString_length(databaseName)>0)
-		{
-		//===== Initialize SQLite3 fiel database name =====
-		this_deleteDatabaseName(self);
-		//===== Copy SQLite3 database file name =====
-		if (M2MString_append(&(self->databaseName), databaseName)!=NULL)
+	if (self!=NULL && from<=to && sql!=NULL && M2MString_length(sql)>0 && result!=NULL)
+		{
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== In case of no record having left the window within the time range =====
+		if (from>self->evictionTime)
 			{
-			//===== In the case of extension isn't given in name =====
-			if (M2MString_lastIndexOf(databaseName, M2MSQLite_FILE_EXTENSION)==NULL)
+			selectResult = this_select(self, sql, NULL, 0, result);
+			pthread_mutex_unlock(&(self->lock));
+			return selectResult;
+			}
+		else
+			{
+			pthread_mutex_unlock(&(self->lock));
+			}
+		//===== Execute SQL on the window and the attached history =====
+		if ((database=this_openHistoryDatabase(self, from, to, sql))!=NULL
+				&& (statement=M2MSQLite_getPreparedStatement(database, sql))!=NULL)
+			{
+			selectResult = this_createResultCSV(self, statement, result);
+			M2MSQLite_closeStatement(statement);
+			M2MSQLite_closeDatabase(database);
+			return selectResult;
+			}
+		//===== Error handling =====
+		else
+			{
+			if (database!=NULL)
 				{
-				//===== Copy SQLite3 file extension =====
-				if (M2MString_append(&(self->databaseName), M2MSQLite_FILE_EXTENSION)!=NULL)
-					{
-					// do nothing
-					}
-				//===== Error handling =====
-				else
-					{
-					this_deleteDatabaseName(self);
-					M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to set the SQLite3 database name in the CEP structure object");
-					return NULL;
-					}
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(database));
+				M2MSQLite_closeDatabase(database);
 				}
-			//===== In the case of extension is given in name =====
 			else
 				{
 				// do nothing
 				}
-			memset(MESSAGE, 0, sizeof(MESSAGE));
-			snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Set the SQLite3 database file name (=\"%s\") in the CEP structure object", M2MCEP_getDatabaseName(self));
-			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
-			return self;
-			}
-		//===== Error handling =====
-		else
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Failed to get heap memory for copying SQLite3 database name");
 			return NULL;
 			}
 		}
 	//===== Argument error =====
 	else if (self==NULL)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
-	else if (databaseName==NULL)
+	else if (from>to)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated time range is reversed");
+		return NULL;
+		}
+	else if (sql==NULL || M2MString_length(sql)<=0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL or vacant");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is vacant");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"result\" pointer is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set indicated M2MDataFrame object into CEP structure object.<br>
+ * Executes the SELECT statement including parameters ("?", "?NNN", ":AAA", <br>
+ * etc.) on the SQLite3 database in memory and returns the result as a CSV <br>
+ * format string (same format as M2MCEP_select()).<br>
+ * The typed values are bound into the parameters with sqlite3_bind_*() in <br>
+ * the order of their index, so one cached prepared statement serves all <br>
+ * values and strings supplied by devices are never parsed as SQL.<br>
  *
- * @param[in,out] self		CEP structure object to be set M2MDataFrame object
- * @param[in] dataFrame		M2MDataFrame object
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in,out] self		CEP structure object
+ * @param[in] sql			String indicating SELECT statement including parameters
+ * @param[in] params		Array of typed values (the number must equal the number of parameters)
+ * @param[in] numberOfParam	Number of typed values
+ * @param[out] result		CSV character string of execution result or NULL (in case of error)
+ * @return					CSV character string of execution result or NULL (in case of no data or error)
  */
-static M2MCEP *this_setDataFrame (M2MCEP *self, M2MDataFrame *dataFrame)
+M2MString *M2MCEP_selectWithParams (M2MCEP *self, const M2MString *sql, const M2MCEPValue *params, const size_t numberOfParam, M2MString **result)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MDataFrame.this_setDataFrame()";
+	M2MString *selectResult = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_selectWithParams()";
 
 	//===== Check argument =====
-	if (self!=NULL && dataFrame!=NULL)
+	if (self!=NULL)
 		{
-		self->dataFrame = dataFrame;
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set M2MDataFrame object into CEP object");
-		return self;
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		selectResult = this_select(self, sql, params, numberOfParam, result);
+		pthread_mutex_unlock(&(self->lock));
+		return selectResult;
 		}
 	//===== Argument error =====
-	else if (self==NULL)
-		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return NULL;
-		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set the SQLite3 file database management object as the member variable held <br>
- * by the CEP execution object specified by the argument.<br>
+ * Declare the aggregate (sum, count, average, minimum and maximum) of the <br>
+ * numeric column of the table held in the SQLite3 database in memory.<br>
+ * The aggregate is updated incrementally with the inserted and evicted <br>
+ * records (NULL values are ignored like SQL) and is read in O(1) with <br>
+ * M2MCEP_getAggregate() or with the SQL function M2MCEP_AGGREGATE_FUNCTION.<br>
  *
  * @param[in,out] self		CEP structure object
- * @param[in] fileDatabase	SQLite3 file database management object
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @return					CEP structure object or NULL (in case of error)
  */
-static M2MCEP *this_setFileDatabase (M2MCEP *self, sqlite3 *fileDatabase)
+M2MCEP *M2MCEP_setAggregate (M2MCEP *self, const M2MString *tableName, const M2MString *columnName)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setFileDatabase()";
+	sqlite3 *memoryDatabase = NULL;
+	M2MCEPAggregate *aggregate = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setAggregate()";
 
 	//===== Check argument =====
-	if (self!=NULL && fileDatabase!=NULL)
+	if (self!=NULL && tableName!=NULL && columnName!=NULL)
 		{
-		self->fileDatabase=fileDatabase;
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set SQLite3 database management object on file to CEP execution object");
-		return self;
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== In case of declared aggregate =====
+		if (this_getAggregate(self, tableName, columnName)!=NULL)
+			{
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Create the aggregate and register the SQL function =====
+		else if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
+				&& (aggregate=M2MCEPAggregate_new(tableName, columnName))!=NULL
+				&& this_getMemoryStatementCache(self)!=NULL
+				&& M2MStatementCache_put(this_getMemoryStatementCache(self), aggregate->selectSQL, NULL, aggregate->selectSQL)!=NULL
+				&& sqlite3_create_function(memoryDatabase, (const char *)M2MCEP_AGGREGATE_FUNCTION, 3, SQLITE_UTF8, self, this_callAggregateFunction, NULL, NULL)==SQLITE_OK)
+			{
+			//===== Aggregate the records already in the window =====
+			aggregate->next = self->aggregate;
+			self->aggregate = aggregate;
+			this_updateAggregate(self);
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MCEPAggregate_delete(&aggregate);
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to declare the aggregate");
+			return NULL;
+			}
 		}
 	//===== Argument error =====
 	else if (self==NULL)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite3 execution object specified by argument is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name or column name string is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set the SQLite 3 database management object in memory as the member variable <br>
- * possessed by the CEP execution object specified by the argument.<br>
+ * Persist the records evicted from the table into the compressed columnar <br>
+ * file "~/.m2m/cep/databaseName.sqlite.column/tableName.column" instead of <br>
+ * the SQLite3 database on file (M2MCEP_setPersistence() must be enabled).<br>
+ * The records are stored by column in blocks of "blockRecord" records: <br>
+ * timestamps and other INTEGER columns with delta-of-delta encoding, REAL <br>
+ * columns with the XOR of the previous value and TEXT/BLOB columns with a <br>
+ * dictionary per block, so that periodic numeric time-series take a few bits <br>
+ * per value. The minimum and maximum of the time column are indexed per <br>
+ * block for M2MCEP_scanColumnStore().<br>
+ * A block is written when it is full, by M2MCEP_flushPersistence(), before <br>
+ * the segment files of the write-ahead log are removed and by <br>
+ * M2MCEP_delete(); the records of a partial block are lost by a crash of <br>
+ * the process unless the write-ahead log is enabled.<br>
+ * The records are written by the thread evicting them (not by the background <br>
+ * persistence thread) and aren't included in M2MCEP_selectHistory(). The <br>
+ * columns of an existing file must be the same as the table. The table <br>
+ * doesn't keep the copy of M2MCEP_setShadowRecord() while it has the column <br>
+ * store (the evicted records are read back from the SQLite3 database in <br>
+ * memory).<br>
  *
  * @param[in,out] self			CEP structure object
- * @param[in] memoryDatabase	SQLite 3 database management object on memory
- * @return						CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in] tableName			String indicating the table name
+ * @param[in] timeColumnName	String indicating the INTEGER column indexed per block (e.g. event time)
+ * @param[in] blockRecord		Number of records of one block (0: remove the column store of the table, the file is kept)
+ * @return						CEP structure object or NULL (in case of error)
  */
-static M2MCEP *this_setMemoryDatabase (M2MCEP *self, sqlite3 *memoryDatabase)
+M2MCEP *M2MCEP_setColumnStore (M2MCEP *self, const M2MString *tableName, const M2MString *timeColumnName, const unsigned int blockRecord)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setMemoryDatabase()";
+	M2MCEPColumnStore *columnStore = NULL;
+	M2MCEPColumnStore **link = NULL;
+	M2MDataFrame *record = NULL;
+	M2MColumnList *columnList = NULL;
+	M2MColumn *column = NULL;
+	M2MString **columnName = NULL;
+	M2MCEPValueType *columnType = NULL;
+	M2MString *filePath = NULL;
+	M2MSQLiteDataType dataType;
+	unsigned int numberOfColumn = 0;
+	unsigned int timeColumn = UINT_MAX;
+	unsigned int i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setColumnStore()";
 
 	//===== Check argument =====
-	if (self!=NULL && memoryDatabase!=NULL)
+	if (self!=NULL && tableName!=NULL && M2MString_length(tableName)>0
+			&& (blockRecord==0 || (timeColumnName!=NULL && M2MString_length(timeColumnName)>0)))
 		{
-		self->memoryDatabase = memoryDatabase;
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set SQLite3 database management object on memory in CEP object");
-		return self;
+		//===== Exclusive access to the column stores =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Close the existing column store of the table =====
+		link = &(self->columnStore);
+		while ((*link)!=NULL && this_equalsName((*link)->tableName, tableName)==false)
+			{
+			link = &((*link)->next);
+			}
+		if ((columnStore=(*link))!=NULL)
+			{
+			(*link) = columnStore->next;
+			M2MCEPColumnStore_delete(&columnStore);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Remove the column store =====
+		if (blockRecord==0)
+			{
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Get the columns of the table =====
+		else if ((columnList=M2MColumnList_begin(M2MTableManager_getColumnList(this_getTableManager(self), tableName)))!=NULL
+				&& (numberOfColumn=M2MColumnList_length(columnList))>0
+				&& (columnName=(M2MString **)M2MHeap_calloc(numberOfColumn, sizeof(M2MString *)))!=NULL
+				&& (columnType=(M2MCEPValueType *)M2MHeap_calloc(numberOfColumn, sizeof(M2MCEPValueType)))!=NULL)
+			{
+			for (i=0; columnList!=NULL && i<numberOfColumn; columnList=M2MColumnList_next(columnList), i++)
+				{
+				column = M2MColumnList_getColumn(columnList);
+				columnName[i] = M2MColumn_getName(column);
+				dataType = M2MColumn_getDataType(column);
+				//===== Type of the values in SQLite3 database (see M2MSQLite_bindValue()) =====
+				if (dataType==M2MSQLiteDataType_REAL || dataType==M2MSQLiteDataType_FLOAT || dataType==M2MSQLiteDataType_DOUBLE)
+					{
+					columnType[i] = M2MCEPValueType_REAL;
+					}
+				else if (dataType==M2MSQLiteDataType_TEXT || dataType==M2MSQLiteDataType_CHAR || dataType==M2MSQLiteDataType_VARCHAR)
+					{
+					columnType[i] = M2MCEPValueType_TEXT;
+					}
+				else if (dataType==M2MSQLiteDataType_BLOB)
+					{
+					columnType[i] = M2MCEPValueType_BLOB;
+					}
+				else
+					{
+					columnType[i] = M2MCEPValueType_INTEGER;
+					}
+				if (this_equalsName(columnName[i], timeColumnName)==true)
+					{
+					timeColumn = i;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== Open the column store file =====
+			if (timeColumn<numberOfColumn
+					&& this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &filePath)!=NULL
+					&& M2MString_append(&filePath, M2MCEP_COLUMN_STORE_DIRECTORY_EXTENSION)!=NULL
+					&& M2MDirectory_mkdirs(filePath, M2MSQLite_DATABASE_DIRECTORY_PERMISSION)==true
+					&& M2MString_append(&filePath, M2MDirectory_SEPARATOR)!=NULL
+					&& M2MString_append(&filePath, tableName)!=NULL
+					&& M2MString_append(&filePath, M2MCEPColumnStore_FILE_EXTENSION)!=NULL
+					&& (columnStore=M2MCEPColumnStore_new(filePath, tableName, columnName, columnType, numberOfColumn, timeColumn, blockRecord))!=NULL)
+				{
+				columnStore->next = self->columnStore;
+				self->columnStore = columnStore;
+				//===== Release the copy of the record window (the records are evicted from SQLite3 database in memory) =====
+				if ((record=this_getTableDataFrame(self, tableName))!=NULL)
+					{
+					M2MRingBuffer_clear(M2MDataFrame_getOldRecordList(record));
+					}
+				else
+					{
+					// do nothing
+					}
+				pthread_mutex_unlock(&(self->lock));
+				M2MHeap_free(filePath);
+				M2MHeap_free(columnName);
+				M2MHeap_free(columnType);
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				pthread_mutex_unlock(&(self->lock));
+				M2MHeap_free(filePath);
+				M2MHeap_free(columnName);
+				M2MHeap_free(columnType);
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to open the column store file (the time column must be an INTEGER column of the table)");
+				return NULL;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			pthread_mutex_unlock(&(self->lock));
+			M2MHeap_free(columnName);
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get the columns of the indicated table");
+			return NULL;
+			}
 		}
 	//===== Argument error =====
 	else if (self==NULL)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (tableName==NULL || M2MString_length(tableName)<=0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"SQLite3 execution object specified by argument is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated time column name string is NULL or vacant");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set a table construction object as a member variable for the argument CEP object.<br>
+ * Set the handler called every time records are committed into the SQLite3 <br>
+ * database in memory.<br>
+ * The handler is called on the thread committing the records (the asynchronous <br>
+ * writer thread in asynchronous mode) and must not call functions of the CEP <br>
+ * object.<br>
  *
  * @param[in,out] self		CEP structure object
- * @param[in] tableManager	Table construction object
- * @return					CEP structure object with member variable updated or NULL (in case of error)
+ * @param[in] commitHandler	Handler function or NULL (to remove the handler)
+ * @param[in] userData		Pointer passed to the handler as it is
+ * @return					CEP structure object or NULL (in case of error)
  */
-static M2MCEP *this_setTableManager (M2MCEP *self, const M2MTableManager *tableManager)
+M2MCEP *M2MCEP_setCommitHandler (M2MCEP *self, const M2MCEPCommitHandler commitHandler, void *userData)
 	{
-	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_setTableManager()";
-
 	//===== Check argument =====
-	if (self!=NULL && tableManager!=NULL)
+	if (self!=NULL)
 		{
-		//===== Delete an existing table building object =====
-		this_deleteTableManager(self);
-		//===== Set table construction object =====
-		self->tableManager = (M2MTableManager *)tableManager;
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set a table construction object in the CEP object");
+		self->commitHandler = commitHandler;
+		self->commitHandlerData = userData;
 		return self;
 		}
 	//===== Argument error =====
-	else if (self==NULL)
+	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, (M2MString *)"M2MCEP_setCommitHandler()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
+	}
+
+
+/**
+ * Set the group commit mode.<br>
+ * Records inserted by M2MCEP_insertCSV() (or M2MCEP_enqueueCSV()) are <br>
+ * accumulated and committed into the SQLite3 databases with one transaction <br>
+ * per database when one of the limits is reached. M2MCEP_select(), <br>
+ * M2MCEP_commit() and M2MCEP_delete() commit the accumulated records at once.<br>
+ * In asynchronous mode, the writer thread also commits when the queue becomes <br>
+ * empty and the delay limit is reached.<br>
+ * A limit of 0 is not used; if "maxRecord" is 0, records are committed for each <br>
+ * call (default).<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] maxRecord	Maximum number of accumulated records[row] (0: group commit is disabled)
+ * @param[in] maxByte	Maximum size of accumulated CSV strings[Byte]
+ * @param[in] maxDelay	Maximum delay from the first accumulated record[usec]
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_setGroupCommit (M2MCEP *self, const unsigned int maxRecord, const size_t maxByte, const uint64_t maxDelay)
+	{
+	//========== Variable ==========
+	M2MString MESSAGE[256];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setGroupCommit()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Commit the records accumulated with the previous limits =====
+		if (M2MCEP_commit(self)>=0)
+			{
+			pthread_mutex_lock(&(self->lock));
+			self->groupCommitMaxRecord = maxRecord;
+			self->groupCommitMaxByte = maxByte;
+			self->groupCommitMaxDelay = maxDelay;
+			pthread_mutex_unlock(&(self->lock));
+			memset(MESSAGE, 0, sizeof(MESSAGE));
+			snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Set group commit (maximum records = \"%u\", maximum bytes = \"%zu\", maximum delay = \"%" PRIu64 "\"usec)", maxRecord, maxByte, maxDelay);
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, MESSAGE);
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to commit the accumulated records");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The table construction object specified by the argument is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Update the number of records for executing the vacuum on the SQLite 3 database.<br>
+ * Replace the periodic full VACUUM with incremental vacuum.<br>
+ * The SQLite3 databases are switched to "auto_vacuum=INCREMENTAL" and, after <br>
+ * each commit, when the freelist holds more than "freelistPage" pages, free <br>
+ * pages are removed with "PRAGMA incremental_vacuum(stepPage)" until the <br>
+ * freelist is empty or the slice exceeds "sliceTime". The SQLite3 database on <br>
+ * file is maintained by the background persistence thread when it is running <br>
+ * (call this function before M2MCEP_startPersistence()).<br>
+ * The record counter of M2MCEP_setVacuumRecord() is not used in this mode.<br>
  *
- * @param[in] self		CEP structure object
- * @param[in] count		Number of records added to the counter (> 0) or 0 (for initializing the counters)
+ * @param[in,out] self		CEP structure object
+ * @param[in] freelistPage	Number of free pages starting a slice (0: disable incremental vacuum)
+ * @param[in] stepPage		Number of pages removed by one step
+ * @param[in] sliceTime		Time limit of one slice[usec]
+ * @return					CEP structure object or NULL (in case of error)
  */
-static void this_updateRecordCounter (M2MCEP *self, const unsigned int count)
+M2MCEP *M2MCEP_setIncrementalVacuum (M2MCEP *self, const unsigned int freelistPage, const unsigned int stepPage, const uint64_t sliceTime)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP.this_updateRecordCounter()";
+	M2MString MESSAGE[256];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setIncrementalVacuum()";
 
 	//===== Check argument =====
-	if (self!=NULL)
+	if (self!=NULL && (freelistPage==0 || (stepPage>0 && sliceTime>0)))
 		{
-		//===== When the automatic vacuum setting is ON =====
-		if (this_getVacuumRecord(self)==0)
+		pthread_mutex_lock(&(self->lock));
+		self->incrementalVacuumPage = freelistPage;
+		self->incrementalVacuumStep = stepPage;
+		self->incrementalVacuumTime = sliceTime;
+		//===== Switch the databases already opened =====
+		if (freelistPage>0 && self->memoryDatabase!=NULL)
 			{
-			return;
+			M2MSQLite_setIncrementalVacuum(self->memoryDatabase);
 			}
-		//===== When automatic vacuum setting is OFF =====
 		else
 			{
-			//===== When the counter is an integer of 1 or more =====
-			if (count>=1)
-				{
-				//===== Add counter =====
-				self->recordCounter = self->recordCounter + count;
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Update record counters for vacuum processing");
-				return;
-				}
-			//===== When the counter is 0 =====
-			else
-				{
-				//===== Initialize counter =====
-				self->recordCounter = 0;
-				M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Vacuum processing record counter has been initialized");
-				return;
-				}
+			// do nothing
 			}
+		if (freelistPage>0 && self->fileDatabase!=NULL && this_isBackgroundPersistence(self)==false)
+			{
+			M2MSQLite_setIncrementalVacuum(self->fileDatabase);
+			}
+		else
+			{
+			// do nothing
+			}
+		pthread_mutex_unlock(&(self->lock));
+		memset(MESSAGE, 0, sizeof(MESSAGE));
+		snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Set incremental vacuum (free pages = \"%u\", pages per step = \"%u\", time per slice = \"%" PRIu64 "\"usec)", freelistPage, stepPage, sliceTime);
+		M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, MESSAGE);
+		return self;
 		}
 	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return;
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated number of pages per step or time per slice is 0");
+		return NULL;
 		}
 	}
 
 
-/*******************************************************************************
- * Public function
- ******************************************************************************/
 /**
- * Release the heap memory of CEP structure object. <br>
- * Note that after calling this function, caller will not be able to access <br>
- * the CEP structure object appointed by argument.<br>
+ * Set logging structure object in column information object.<br>
  *
- * @param[in,out] self	CEP structure object to be freed of memory area
+ * @param[in,out] self	Column information object
+ * @param[in] logger	Logging structure object
+ * @return				Column information object with logger set or NULL (in case of error)
  */
-void M2MCEP_delete (M2MCEP **self)
+M2MCEP *M2MCEP_setLogger (M2MCEP *self, const M2MFileAppender *logger)
 	{
 	//========== Variable ==========
-	M2MDataFrame *record = NULL;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_delete()";
+	M2MFileAppender *oldLogger = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setLogger()";
 
 	//===== Check argument =====
-	if (self!=NULL && (*self)!=NULL)
+	if (self!=NULL && logger!=NULL)
 		{
-		//===== Release heap memory for database name string =====
-		this_deleteDatabaseName((*self));
-		//===== Close memory database =====
-		this_closeMemoryDatabase((*self));
-		//===== Insert CEP record information object (not inserted) into file database =====
-		this_flushCEPRecord((*self));
-		//===== Close file database =====
-		this_closeFileDatabase((*self));
-		//=====  =====
-		this_deleteLogger((*self));
-		//===== Release the heap memory area of the CEP record information object =====
-		if ((record=this_getDataFrame((*self)))!=NULL)
+		//===== In case of existing logger object yet =====
+		if ((oldLogger=self->logger)!=NULL)
 			{
-			M2MDataFrame_delete(&record);
+			//===== Release allocated memory =====
+			M2MFileAppender_delete(&oldLogger);
 			}
+		//===== In case of no existing logger object =====
 		else
 			{
 			}
-		//===== Release heap memory area of table construction object =====
-		this_deleteTableManager((*self));
-		//===== Release CEP object's heap memory area =====
-		M2MHeap_free((*self));
+		//===== Set logger object =====
+		self->logger = (M2MFileAppender *)logger;
+		//=====  =====
+		return self;
 		}
 	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MColumn\" object is NULL");
+		return NULL;
+		}
 	else
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" object is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MFileAppender\" object is NULL");
+		return NULL;
 		}
-	return;
 	}
 
 
 /**
- * Return string indicating the database name possessed by the CEP object.<br>
+ * Change the maximum number of records that can be stored in each table in the <br>
+ * SQLite 3 database existing in memory to the integer value specified by the <br>
+ * argument.<br>
+ * Note that it is not possible to set an integer number of 10000000 or more to <br>
+ * the record number upper limit value.<br>
  *
- * @param[in] self	CEP structure object
- * @return			String indicating database file name or NULL (in case of error)
+ * @param[in,out] self		Maximum number of records CEP execution object to be changed
+ * @param[in] maxRecord		Integer indicating the maximum number of records in one table or 0 (in case of error)
+ * @return					CEP execution object or 0 (maximum number of records set)
  */
-M2MString *M2MCEP_getDatabaseName (const M2MCEP *self)
+M2MCEP *M2MCEP_setMaxRecord (M2MCEP *self, const unsigned int maxRecord)
 	{
 	//========== Variable ==========
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getDatabaseName()";
+	M2MString MESSAGE[256];
+	const unsigned int MAX_RECORD_MAX = 10000000;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP_setMaxRecord()";
 
 	//===== Check argument =====
-	if (self!=NULL)
+	if (self!=NULL && 0<maxRecord && maxRecord<MAX_RECORD_MAX)
 		{
-		return self->databaseName;
+		//===== Set number of records upper limit =====
+		self->maxRecord = maxRecord;
+		memset(MESSAGE, 0, sizeof(MESSAGE));
+		snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"The upper limit number of records (=\"%u\") in the SQLite database in memory has been set in the CEP object", self->maxRecord);
+		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
+		return self;
 		}
 	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (maxRecord<=0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The upper limit of the number of records specified by argument is an integer less than or equal to 0 which is the minimum setting value.");
+		return NULL;
+		}
 	else
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The number of records specified by the argument The upper limit value is an integer of 10000000 or more which is the maximum setting value.");
 		return NULL;
 		}
 	}
 
 
 /**
- * Get the SQLite3 database object on the file managed by the CEP object. <br>
- * If the CEP object does not hold the SQLite 3 database object on the file <br>
- * and the record persistence flag is set up, it will acquire and return <br>
- * the SQLite 3 database object newly created.<br>
+ * Divide the SQLite3 database on file into time partitions.<br>
+ * The evicted records are inserted into the partition file of the current <br>
+ * time ("~/.m2m/cep/databaseName.sqlite.partition/YYYYMMDDhhmmss.sqlite", <br>
+ * UTC) and a new file is started at the next transaction once the interval <br>
+ * has elapsed. When a partition file is started, the files older than <br>
+ * "retention" partitions are removed as a whole, so that the disk usage stays <br>
+ * bounded without DELETE and vacuum.<br>
+ * Call this function before starting background persistence.<br>
  *
- * @param[in] self	CEP structure object
- * @return			SQLite3 database object on file or NULL (in case of error)
+ * @param[in,out] self		CEP structure object
+ * @param[in] interval		Time range of one partition[sec] (e.g. M2MCEPPartition_HOUR, 0: single database file)
+ * @param[in] retention		Number of partitions kept including the current one (0: all)
+ * @return					CEP structure object or NULL (in case of error)
  */
-sqlite3 *M2MCEP_getFileDatabase (M2MCEP *self)
+M2MCEP *M2MCEP_setPartition (M2MCEP *self, const unsigned int interval, const unsigned int retention)
 	{
 	//========== Variable ==========
-	M2MString *databaseName = NULL;
-	M2MTableManager *tableManager = NULL;
-	sqlite3 *fileDatabase = NULL;
-	const bool SYNCHRONOUS_MODE = false;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getFileDatabase()";
+	M2MCEPPartition *partition = NULL;
+	M2MString *directoryPath = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setPartition()";
 
 	//===== Check argument =====
-	if (self!=NULL)
+	if (self!=NULL && this_isBackgroundPersistence(self)==false)
 		{
-		//===== Confirm the flag for record persistence =====
-		if (this_getPersistence(self)==true)
+		pthread_mutex_lock(&(self->lock));
+		//===== Back to the single database file =====
+		if (interval==0)
 			{
-			//===== Confirm SQLite 3 database management object on file =====
-			if (self->fileDatabase!=NULL)
+			if (self->partition!=NULL)
 				{
-				return self->fileDatabase;
+				this_closeFileDatabase(self);
+				M2MCEPPartition_delete(&(self->partition));
 				}
-			//===== When not owning the SQLite 3 database management object on the file =====
 			else
 				{
-				//===== Get SQLite3 database management object on file =====
-				if ((databaseName=M2MCEP_getDatabaseName(self))!=NULL
-						&& (tableManager=this_getTableManager(self))!=NULL
-						&& (fileDatabase=this_openFileDatabase(databaseName, tableManager, SYNCHRONOUS_MODE, this_getVacuumRecord(self)))!=NULL)
-					{
-					//===== Set SQLite3 database management object on file =====
-					this_setFileDatabase(self, fileDatabase);
-					//===== Return SQLite3 database management object on file =====
-					return fileDatabase;
-					}
-				//===== Error handling =====
-				else if (databaseName==NULL)
-					{
-					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get database file name necessary for creating SQLite 3 database management object on file");
-					return NULL;
-					}
-				//===== Error handling =====
-				else if (tableManager==NULL)
-					{
-					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get the table construction object necessary for creating the SQLite 3 database management object on the file");
-					return NULL;
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create SQLite3 database management object on file");
-					return NULL;
-					}
+				// do nothing
 				}
+			pthread_mutex_unlock(&(self->lock));
+			return self;
 			}
-		//===== When the record persistence flag is not set =====
+		//===== Change the retention of the current partitions =====
+		else if (self->partition!=NULL && self->partition->interval==interval)
+			{
+			self->partition->retention = retention;
+			M2MCEPPartition_remove(self->partition);
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== The next access opens the partition file of the current time =====
+		else if (this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &directoryPath)!=NULL
+				&& M2MString_append(&directoryPath, M2MCEP_PARTITION_DIRECTORY_EXTENSION)!=NULL
+				&& (partition=M2MCEPPartition_new(directoryPath, interval, retention))!=NULL)
+			{
+			M2MHeap_free(directoryPath);
+			this_closeFileDatabase(self);
+			M2MCEPPartition_delete(&(self->partition));
+			self->partition = partition;
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Error handling =====
 		else
 			{
-			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Because record persistence is invalid, we don't get the SQLite3 database object on the file");
+			pthread_mutex_unlock(&(self->lock));
+			M2MHeap_free(directoryPath);
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create the time partitions of SQLite3 database on file");
 			return NULL;
 			}
 		}
 	//===== Argument error =====
-	else
+	else if (self==NULL)
 		{
 		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Time partitions can't be changed while background persistence is running");
+		return NULL;
+		}
 	}
 
 
 /**
- * Return the logging object owned by the argument CEP object.<br>
+ * Set a flag indicating permanence (recording in the SQLite 3 database on the <br>
+ * file) to the CEP structure object specified by the argument.<br>
+ * When set to true, all records inserted by M2MCEP_insertCSV () are recorded in <br>
+ * the SQLite 3 database on the file.<br>
+ * If set to "false", do not record to the SQLite 3 database on the file.<br>
  *
- * @param[in] self	CEP structure object
- * @return			Logging object
+ * @param[in,out] self		CEP structure object
+ * @param[in] persistence	Flag indicating permanence (record in SQLite 3 database on file)
+ * @return					CEP execution object with a flag indicating permanence availability or NULL (in case of error)
  */
-M2MFileAppender *M2MCEP_getLogger (const M2MCEP *self)
+M2MCEP *M2MCEP_setPersistence (M2MCEP *self, const bool persistence)
 	{
 	//========== Variable ==========
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getLogger()";
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP_setPersistence()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		return self->logger;
+		//===== In the case of persistence =====
+		if (persistence==true)
+			{
+			self->persistence = true;
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set flag for insert record persistence to \"ON\"");
+			return self;
+			}
+		//===== In case of non-persistence =====
+		else if (persistence==false)
+			{
+			self->persistence = false;
+			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set flag for insert record persistence to \"OFF\"");
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The permanence flag indicated by argument is neither \"true\" nor \"false\"");
+			return NULL;
+			}
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * Return the SQLite 3 database object on the memory managed by the CEP object.<br>
+ * Set a flag indicating whether the records held in the SQLite 3 database in <br>
+ * memory are also copied into the record management object.<br>
+ * When set to "false", the SQLite 3 database in memory is the only holder of <br>
+ * the record window and the records exceeding the maximum number of records <br>
+ * are read back from it by rowid range for persistence.<br>
+ * This flag can't be changed after records have been inserted.<br>
  *
- * @param[in] self	CEP structure object
- * @return			SQLite3 database object on memory or NULL (in case of error)
+ * @param[in,out] self		CEP structure object
+ * @param[in] shadowRecord	true: keep a copy of the record window (default), false: don't copy
+ * @return					CEP structure object with the flag or NULL (in case of error)
  */
-sqlite3 *M2MCEP_getMemoryDatabase (M2MCEP *self)
+M2MCEP *M2MCEP_setShadowRecord (M2MCEP *self, const bool shadowRecord)
 	{
 	//========== Variable ==========
-	sqlite3 *memoryDatabase = NULL;
-	const bool SYNCHRONOUS_MODE = false;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_getMemoryDatabase()";
+	M2MDataFrame *record = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setShadowRecord()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		//===== Confirm SQLite 3 database management object in memory =====
-		if (self->memoryDatabase!=NULL)
+		//===== Confirm that no record is held =====
+		record = M2MDataFrame_begin(this_getDataFrame(self));
+		while (record!=NULL && M2MDataFrame_getWindowLength(record)==0)
 			{
-			return self->memoryDatabase;
+			record = M2MDataFrame_next(record);
 			}
-		//===== When the SQLite 3 database management object in the memory doesn't exist =====
+		//===== Set flag =====
+		if (record==NULL)
+			{
+			self->shadowRecord = shadowRecord;
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (shadowRecord==true) ? (M2MString *)"Set flag for copying record window to \"ON\"" : (M2MString *)"Set flag for copying record window to \"OFF\"");
+			return self;
+			}
+		//===== Error handling =====
 		else
 			{
-			//===== Open SQLite 3 database management object in memory =====
-			if ((memoryDatabase=this_openMemoryDatabase(this_getTableManager(self), SYNCHRONOUS_MODE, this_getVacuumRecord(self)))!=NULL)
-				{
-				//===== Set SQLite3 database management object on memory =====
-				this_setMemoryDatabase(self, memoryDatabase);
-				//===== Return SQLite3 database management object in memory =====
-				return memoryDatabase;
-				}
-			//===== Error handling =====
-			else
-				{
-				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create SQLite3 database object in memory");
-				return NULL;
-				}
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"The flag for copying record window can't be changed after records have been inserted");
+			return NULL;
 			}
 		}
-	//===== Argument error =====
-	else
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * When forcibly terminating when using the shared library (libcep.so), set the <br>
+ * event handler to acquire the signal and perform the termination processing.<br>
+ *
+ * @param[in] self	CEP structure object
+ */
+void M2MCEP_setSignalHandler (const M2MCEP *self)
+	{
+	//========== Variable ==========
+	struct sigaction newAction;
+	struct sigaction oldAction;
+
+	//=====  =====
+//	newAction.sa_handler = termination_handler;
+	//=====  =====
+	sigemptyset(&newAction.sa_mask);
+	//=====  =====
+	newAction.sa_flags = 0;
+	//=====  =====
+	sigaction(SIGINT, NULL, &oldAction);
+	//=====  =====
+	if (oldAction.sa_handler!=SIG_IGN)
+		{
+		sigaction (SIGINT, &newAction, NULL);
+		}
+	//=====  =====
+	sigaction(SIGHUP, NULL, &oldAction);
+	//=====  =====
+	if (oldAction.sa_handler!=SIG_IGN)
+		{
+		sigaction(SIGHUP, &newAction, NULL);
+		}
+	//=====  =====
+	sigaction(SIGTERM, NULL, &oldAction);
+	//=====  =====
+	if (oldAction.sa_handler!=SIG_IGN)
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return NULL;
+		sigaction(SIGTERM, &newAction, NULL);
 		}
+	//=====  =====
+	sigaction(SIGKILL, NULL, &oldAction);
+	//=====  =====
+	if (oldAction.sa_handler!=SIG_IGN)
+		{
+		sigaction(SIGKILL, &newAction, NULL);
+		}
+	return;
 	}
 
 
 /**
- * Return CEP library version number string defined in "M2MCEP.h" file.
- *
- * @return	CEP library version number string
- */
-M2MString *M2MCEP_getVersion ()
-	{
-	return M2MCEP_VERSION;
-	}
-
-
-/**
- * Insert string in CSV format into the table of SQLite 3 database for CEP. <br>
- * The internal processing procedure is as follows.<br>
- * <br>
- * 1) Parse CSV string and import into a CEPRecord structure object. <br>
- * 2) Insert record data into the table of SQLite3 memory database. <br>
- * 3) Check the current record number of the table of SQLite3 memory database, <br>
- *    and delete it in the oldest order if it exceeds the specified <br>
- *    maximum value. <br>
- * 4) Fetch the same data as the deleted record from the CEPRecord <br>
- *    structure object and insert it into the SQLite3 database file for <br>
- *    persistence. <br>
- * 5) Delete excess from record data of CEPRecord structure object. <br>
+ * SQLite 3 Sets the number of records for vacuuming the database.<br>
+ * For this vacuum processing setting, it is a setting of sharing SQLite 3 <br>
+ * database on memory and SQLite 3 database on file.<br>
  *
- * @param[in,out] self	CEP structure object
- * @param[in] tableName	String indicating the table name to be inserted record
- * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
- * @return				Number of inserted records[row] or -1 (in case of error)
+ * @param self			Number of records for vacuum processing CEP execution object to be set
+ * @param vacuumRecord	An integer value indicating the number of records of vacuum processing (automatic vacuum setting when 0 is specified)
+ * @return				CEP execution object or number of records to be vacuum processed or NULL (in case of error)
  */
-int M2MCEP_insertCSV (M2MCEP *self, const M2MString *tableName, const M2MString *csv)
+M2MCEP *M2MCEP_setVacuumRecord (M2MCEP *self, const unsigned int vacuumRecord)
 	{
 	//========== Variable ==========
-	int numberOfRecord = 0;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_insertCSV()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setVacuumRecord()";
 
 	//===== Check argument =====
-	if (self!=NULL && tableName!=NULL && csv!=NULL)
+	if (self!=NULL)
 		{
-		//===== Set CSV string to M2MDataFrame object =====
-		if (M2MDataFrame_setCSV(this_getDataFrame(self), tableName, csv)>0)
-			{
-			//===== Insert record into SQLite3 memory database =====
-			if ((numberOfRecord=this_insertRecordListToMemoryDatabase(self))>=0)
-				{
-				//===== Update record counters for vacuum processing =====
-				this_updateRecordCounter(self, numberOfRecord);
-				//===== Adjust the number of records in SQLite3 database in memory =====
-				this_adjustMemoryDatabaseRecord(self, tableName);
-				//===== Insert record into SQLite3 database file for persistence =====
-				if (this_insertRecordListToFileDatabase(self)!=NULL)
-					{
-					//===== Execute vacuum processing to SQLite3 databases =====
-					this_checkRecordCounterForVacuum(self);
-					//===== Return number of records =====
-					return numberOfRecord;
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite3 database on file");
-					return -1;
-					}
-				}
-			//===== Error handling =====
-			else
-				{
-				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to insert record into SQLite 3 database in memory");
-				return -1;
-				}
-			}
-		//===== Error handling =====
-		else
-			{
-			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to set CSV format string to record management object");
-			return -1;
-			}
+		self->vacuumRecord = vacuumRecord;
+		return self;
 		}
 	//===== Argument error =====
-	else if (self==NULL)
-		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
-		return -1;
-		}
-	else if (tableName==NULL)
-		{
-		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the table name specified by the argument is NULL");
-		return -1;
-		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! The string indicating the CSV format record specified by the argument is NULL");
-		return -1;
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
 	}
 
 
 /**
- * Constructor.<br>
- * Create new CEP structure object and prepare for SQLite3 database processing. <br>
- * For the table, be sure to specify the SQLite3 database on memory as it <br>
- * needs to be built every time "M2MCEP" object is created. <br>
+ * Define the window of the table held in the SQLite3 database in memory, in <br>
+ * place of the maximum number of records shared by all tables <br>
+ * (M2MCEP_setMaxRecord()).<br>
+ * The window is limited by number of records, by event time ("duration" back <br>
+ * from the latest value of the integer column "timeColumnName", e.g. DATETIME) <br>
+ * or by both. An index is created on the event time column so that eviction <br>
+ * and SELECT over the window only touch the current range.<br>
+ * Records are evicted in insertion order, so event time is expected to <br>
+ * increase with insertion.<br>
+ * Specify 0 for both "maxRecord" and "duration" to remove the definition.<br>
  *
- * @param[in] databaseName	String indicating SQLite3 database name
- * @param[in] tableBuilder	Structure object for building SQLite3 database table
- * @return					Created CEP structure object or NULL (in case of error)
+ * @param[in,out] self			CEP structure object
+ * @param[in] tableName			String indicating the table name
+ * @param[in] maxRecord			Maximum number of records (0: not limited by number)
+ * @param[in] timeColumnName	String indicating the column of event time (ignored when duration is 0)
+ * @param[in] duration			Duration of the window in the unit of the event time column (0: not limited by time)
+ * @return						CEP structure object or NULL (in case of error)
  */
-M2MCEP *M2MCEP_new (const M2MString *databaseName, const M2MTableManager *tableManager)
+M2MCEP *M2MCEP_setWindow (M2MCEP *self, const M2MString *tableName, const unsigned int maxRecord, const M2MString *timeColumnName, const int64_t duration)
 	{
 	//========== Variable ==========
-	M2MCEP *self = NULL;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_new()";
+	M2MCEPWindow *window = NULL;
+	M2MCEPWindow **link = NULL;
+	M2MString *indexSQL = NULL;
+	M2MString MESSAGE[256];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setWindow()";
 
 	//===== Check argument =====
-	if (databaseName!=NULL && tableManager!=NULL)
+	if (self!=NULL && tableName!=NULL && M2MString_length(tableName)>0
+			&& duration>=0 && (duration==0 || (timeColumnName!=NULL && M2MString_length(timeColumnName)>0)))
 		{
-		//===== Get heap memory of CEP execution object =====
-		if ((self=(M2MCEP *)M2MHeap_malloc(sizeof(M2MCEP)))!=NULL)
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Remove the existing window definition of the table =====
+		link = &(self->window);
+		while ((*link)!=NULL && this_equalsName((*link)->tableName, tableName)==false)
 			{
-			//===== Initialize member variable of CEP object =====
-			if (this_init(self, databaseName, tableManager)!=NULL)
+			link = &((*link)->next);
+			}
+		if ((window=(*link))!=NULL)
+			{
+			(*link) = window->next;
+			M2MHeap_free(window->tableName);
+			M2MHeap_free(window->timeColumnName);
+			M2MHeap_free(window->boundarySQL);
+			M2MHeap_free(window);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Remove the window definition =====
+		if (maxRecord==0 && duration==0)
+			{
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Create the window definition =====
+		else if ((window=(M2MCEPWindow *)M2MHeap_malloc(sizeof(M2MCEPWindow)))!=NULL
+				&& M2MString_append(&(window->tableName), tableName)!=NULL)
+			{
+			window->maxRecord = maxRecord;
+			window->duration = duration;
+			//===== Index the event time column and prepare the window boundary search =====
+			if (duration==0
+					|| (M2MString_append(&(window->timeColumnName), timeColumnName)!=NULL
+						&& M2MString_append(&indexSQL, (M2MString *)"CREATE INDEX IF NOT EXISTS ")!=NULL
+						&& M2MString_append(&indexSQL, tableName)!=NULL
+						&& M2MString_append(&indexSQL, (M2MString *)"_")!=NULL
+						&& M2MString_append(&indexSQL, timeColumnName)!=NULL
+						&& M2MString_append(&indexSQL, (M2MString *)"_window ON ")!=NULL
+						&& M2MString_append(&indexSQL, tableName)!=NULL
+						&& M2MString_append(&indexSQL, (M2MString *)"(")!=NULL
+						&& M2MString_append(&indexSQL, timeColumnName)!=NULL
+						&& M2MString_append(&indexSQL, (M2MString *)") ")!=NULL
+						&& M2MSQLite_executeUpdate(M2MCEP_getMemoryDatabase(self), indexSQL)==true
+						&& M2MString_append(&(window->boundarySQL), (M2MString *)"SELECT rowid FROM ")!=NULL
+						&& M2MString_append(&(window->boundarySQL), tableName)!=NULL
+						&& M2MString_append(&(window->boundarySQL), (M2MString *)" WHERE ")!=NULL
+						&& M2MString_append(&(window->boundarySQL), timeColumnName)!=NULL
+						&& M2MString_append(&(window->boundarySQL), (M2MString *)" >= (SELECT MAX(")!=NULL
+						&& M2MString_append(&(window->boundarySQL), timeColumnName)!=NULL
+						&& M2MString_append(&(window->boundarySQL), (M2MString *)") FROM ")!=NULL
+						&& M2MString_append(&(window->boundarySQL), tableName)!=NULL
+						&& M2MString_append(&(window->boundarySQL), (M2MString *)") - ? ORDER BY ")!=NULL
+						&& M2MString_append(&(window->boundarySQL), timeColumnName)!=NULL
+						&& M2MString_append(&(window->boundarySQL), (M2MString *)" LIMIT 1 ")!=NULL))
 				{
-				//===== Return new created CEP object =====
+				M2MHeap_free(indexSQL);
+				window->next = self->window;
+				self->window = window;
+				pthread_mutex_unlock(&(self->lock));
+				memset(MESSAGE, 0, sizeof(MESSAGE));
+				snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"The window (=\"%u\" records, \"%lld\" of event time) of \"%s\" table has been set in the CEP object", maxRecord, (long long)duration, tableName);
+				M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, MESSAGE);
 				return self;
 				}
 			//===== Error handling =====
 			else
 				{
-				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to initialize CEP object");
-				//===== Release heap memory area for CEP object =====
-				M2MCEP_delete(&self);
+				pthread_mutex_unlock(&(self->lock));
+				M2MHeap_free(indexSQL);
+				M2MHeap_free(window->tableName);
+				M2MHeap_free(window->timeColumnName);
+				M2MHeap_free(window->boundarySQL);
+				M2MHeap_free(window);
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create the index of the event time column in SQLite 3 database in memory");
 				return NULL;
 				}
 			}
 		//===== Error handling =====
 		else
 			{
-			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get the heap memory area for creating a new CEP object");
+			pthread_mutex_unlock(&(self->lock));
+			M2MHeap_free(window);
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the window definition");
 			return NULL;
 			}
 		}
 	//===== Argument error =====
-	else if (databaseName==NULL)
+	else if (self==NULL)
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (tableName==NULL || M2MString_length(tableName)<=0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return NULL;
+		}
+	else if (duration<0)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated duration is a negative value");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"tableManager\" object is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated event time column name string is NULL or vacant");
 		return NULL;
 		}
 	}
 
 
 /**
- * Executes the SQL statement specified by the argument on the SQLite 3 database <br>
- * in memory and returns the result as a CSV format string.<br>
- * For the character string of the CSV format as the execution result, the <br>
- * column name character string is the first line, and the data after the second <br>
- * line is the data.<br>
- * <br>
- * [Attention!]<br>
- * In order to execute this function, "SQLITE_ENABLE_COLUMN_METADATA" must be <br>
- * enabled as option setting at compile time of SQLite 3.<br>
- * This is because this function can not create a character string of CSV format <br>
- * to be output as a result unless table information is acquired from the SELECT <br>
- * result.<br>
- * If "SQLITE_ENABLE_COLUMN_METADATA" is not valid, keep in mind that this <br>
- * function will cause a compile error (because undefined functions are called).<br>
+ * Enable the write-ahead log of the records inserted into the SQLite3 <br>
+ * database in memory, so that the window survives a crash.<br>
+ * Every M2MCEP_insertCSV() and M2MCEP_insertRecords() is appended to the <br>
+ * segment files under "~/.m2m/cep/databaseName.sqlite.wal/" as one entry <br>
+ * protected by CRC-32 (one sequential write instead of a transaction of the <br>
+ * SQLite3 database on file). The entries survive a crash of the process; <br>
+ * a crash of the OS can lose the entries written after the last fsync() <br>
+ * (every "syncRecord" entries and at the end of each segment file).<br>
+ * When enabled, the segment files left by the previous process are replayed <br>
+ * into the SQLite3 database in memory (after the snapshot of <br>
+ * M2MCEP_checkpoint(), which removes the segment files it includes). A <br>
+ * segment file is removed once all of its records have left the window <br>
+ * (inserted into the SQLite3 database on file in case of persistence). <br>
+ * The records of each table are numbered in the order of insertion and the <br>
+ * number of the last persisted record is recorded in the table <br>
+ * "m2mcep_sequence" of the SQLite3 database on file, in the transaction of <br>
+ * the evicted records (and in the snapshot). Replaying skips the records <br>
+ * already persisted, so they aren't inserted into the file twice. <br>
+ * Call this function before inserting records and with the same setting on <br>
+ * every start.<br>
  *
- * @param[in] self		CEP structure object (used for database management)
- * @param[in] sql		String indicating SQL statement
- * @param[out] result	CSV character string of execution result or NULL (in case of error)
- * @return
+ * @param[in,out] self		CEP structure object
+ * @param[in] segmentSize	Size of one segment file[Byte] (0: disable the log and remove its segment files)
+ * @param[in] syncRecord	Number of entries between two fsync() (1: every entry, 0: at the end of each segment file only)
+ * @return					CEP structure object or NULL (in case of error)
  */
-M2MString *M2MCEP_select (M2MCEP *self, const M2MString *sql, M2MString **result)
+M2MCEP *M2MCEP_setWriteAheadLog (M2MCEP *self, const size_t segmentSize, const unsigned int syncRecord)
 	{
 	//========== Variable ==========
-	sqlite3 *memoryDatabase = NULL;
-	sqlite3_stmt* statement = NULL;
-	int resultCode = 0;
-	int columnLength = -1;
-	int i = 0;
-	bool thisIsHeader = true;
-	M2MString *columnName = NULL;
-	size_t columnNameLength = 0;
-	M2MString *data = NULL;
-	size_t dataLength = 0;
-	int sqliteColumnType = 0;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_select()";
+	M2MCEPLog *log = NULL;
+	M2MDataFrame *record = NULL;
+	M2MString *directoryPath = NULL;
+	uint32_t segment = 0;
+	int numberOfEntry = 0;
+	int replayedEntry = 0;
+	M2MString MESSAGE[256];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setWriteAheadLog()";
 
 	//===== Check argument =====
-	if (self!=NULL && sql!=NULL && result!=NULL)
+	if (self!=NULL)
 		{
-		//===== Convert SQL statement to VDBE (SQLite internal execution format) =====
-		if ((memoryDatabase=M2MCEP_getMemoryDatabase(self))!=NULL
-				&& (statement=M2MSQLite_getPreparedStatement(memoryDatabase, sql))!=NULL
-				)
+		pthread_mutex_lock(&(self->lock));
+		//===== Disable the log =====
+		if (segmentSize==0)
 			{
-			//===== Execute SQL (repeat until the result row reaches the end) =====
-			while ((resultCode=sqlite3_step(statement))==SQLITE_ROW)
+			if (self->log!=NULL)
 				{
-				//===== When the number of columns of the SELECT result has not been acquired yet =====
-				if (columnLength<0)
-					{
-					//===== Get number of columns of SELECT result =====
-					columnLength = sqlite3_column_count(statement);
-					}
-				//===== When acquiring the number of columns of the SELECT result =====
-				else
-					{
-					// do nothing
-					}
-				//===== When header line is not output =====
-				if (thisIsHeader==true)
-					{
-					//===== Repeat by number of columns =====
-					for (i=0; i<columnLength; i++)
-						{
-						//===== (Reference code :) Get the original table name (UTF-8) which is not an alias =====
-//						sqlite3_column_table_name(statement, 1);
-						//===== Get the original column name (UTF-8) which is not an alias =====
-						if ((columnName=(M2MString *)sqlite3_column_origin_name(statement, i))!=NULL
-								&& (columnNameLength=M2MString_length(columnName))>0)
-							{
-							//===== In case of 1st time =====
-							if (i==0)
-								{
-								// do nothing
-								}
-							//===== In case of the 2nd and subsequent times =====
-							else
-								{
-								//===== Add comma character =====
-								M2MString_append(result, M2MString_COMMA);
-								}
-							//===== Add column name =====
-							M2MString_append(result, columnName);
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get character string indicating column name from SELECT result");
-							}
-						}
-					//===== Add line feed code =====
-					M2MString_append(result, M2MString_CRLF);
-					//===== Reduce header line output flag =====
-					thisIsHeader = false;
-					}
-				//===== When header line has already been output =====
-				else
+				M2MCEPLog_rotate(self->log);
+				M2MCEPLog_remove(self->log, M2MCEPLog_getSegment(self->log));
+				M2MCEPLog_delete(&(self->log));
+				this_deleteLogMark(self, UINT32_MAX);
+				//===== Stop numbering the records =====
+				for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
 					{
-					// do nothing
+					M2MDataFrame_setSequence(record, 0);
+					M2MDataFrame_setPersistedSequence(record, -1);
 					}
-				//===== Repeat the output of SELECT result data by the number of columns =====
-				for (i=0; i<columnLength; i++)
-					{
-					//===== In case of 1st time =====
-					if (i==0)
-						{
-						// do nothing
-						}
-					//===== In case of the 2nd and subsequent times =====
-					else
-						{
-						//===== Add comma character =====
-						M2MString_append(result, M2MString_COMMA);
-						}
-					//===== When the data type of the SELECT result column is an integer =====
-					if ((sqliteColumnType=sqlite3_column_type(statement, i))==SQLITE_INTEGER)
-						{
-						if (M2MString_convertFromSignedIntegerToString(sqlite3_column_int(statement, i), &data)!=NULL)
-							{
-							//===== Append integer data string =====
-							M2MString_append(result, data);
-							//===== Release heap memory area of data string =====
-							M2MHeap_free(data);
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to convert Integer data of SELECT result to character string");
-							}
-						}
-					//===== When the data type of the SELECT result column is a floating point number =====
-					else if (sqliteColumnType==SQLITE_FLOAT)
-						{
-						if (M2MString_convertFromDoubleToString(sqlite3_column_double(statement, i), &data)!=NULL)
-							{
-							//===== Append real number data string =====
-							M2MString_append(result, data);
-							//===== Release heap memory area of data string =====
-							M2MHeap_free(data);
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to convert Floating point number data of SELECT result to character string");
-							}
-						}
-					//===== When the data type of the SELECT result column is a character string =====
-					else if (sqliteColumnType==SQLITE_TEXT)
-						{
-						if ((data=(M2MString *)sqlite3_column_text(statement, i))!=NULL)
-							{
-							//===== Add character string =====
-							M2MString_append(result, data);
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get character string data of SELECT result");
-							}
-						}
-					//===== When the data type of the SELECT result column is byte data =====
-					else if (sqliteColumnType==SQLITE_BLOB)
-						{
-						if ((dataLength=(size_t)sqlite3_column_bytes(statement, i))>0
-								&& M2MBase64_encode(sqlite3_column_blob(statement, i), dataLength, &data, false)!=NULL)
-							{
-							//===== Added character string obtained by converting byte data to base64 =====
-							M2MString_append(result, data);
-							//===== Release heap memory area of data string =====
-							M2MHeap_free(data);
-							}
-						//===== Error handling =====
-						else if (dataLength<=0)
-							{
-							M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
-							}
-						else
-							{
-							M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
-							}
-						}
-					//===== When the data type of the SELECT result column is NULL =====
-					else if (sqliteColumnType==SQLITE_NULL)
-						{
-						M2MString_append(result, (M2MString *)"NULL");
-						}
-					//===== In other cases =====
-					else
-						{
-						M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"SQLite internal error! (The data type of the SELECT result differs from the value of the rule)");
-						}
+				}
+			else
+				{
+				// do nothing
+				}
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Change the setting of the enabled log =====
+		else if (self->log!=NULL)
+			{
+			self->log->segmentSize = segmentSize;
+			self->log->syncRecord = syncRecord;
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Open the log after restoring the snapshot =====
+		else if (M2MCEP_getMemoryDatabase(self)!=NULL
+				&& this_getDatabaseFilePath(M2MCEP_getDatabaseName(self), &directoryPath)!=NULL
+				&& M2MString_append(&directoryPath, M2MCEP_LOG_DIRECTORY_EXTENSION)!=NULL
+				&& (log=M2MCEPLog_new(directoryPath, segmentSize, syncRecord))!=NULL)
+			{
+			M2MHeap_free(directoryPath);
+			//===== The segment files included in the snapshot are no longer needed =====
+			M2MCEPLog_remove(log, self->logSegment);
+			//===== Number the records of the restored tables after the persisted ones =====
+			for (record=M2MDataFrame_begin(this_getDataFrame(self)); record!=NULL; record=M2MDataFrame_next(record))
+				{
+				if (M2MDataFrame_getTableName(record)!=NULL)
+					{
+					this_loadSequence(self, record);
+					}
+				else
+					{
+					// do nothing
 					}
-				//===== Add line feed code =====
-				M2MString_append(result, M2MString_CRLF);
 				}
-			//===== Close SQLite3 statement object =====
-			M2MSQLite_closeStatement(statement);
-			//===== When data is included in the execution result =====
-			if (this_includesData((*result))==true)
+			//===== Replay the other segment files in order (the log is detached while replaying) =====
+			for (segment=M2MCEPLog_getFirstSegment(log); segment<M2MCEPLog_getSegment(log); segment++)
+				{
+				if ((numberOfEntry=M2MCEPLog_replay(log, segment, this_replayLog, self))>0)
+					{
+					replayedEntry += numberOfEntry;
+					}
+				else
+					{
+					// do nothing
+					}
+				this_commitRecord(self);
+				this_addLogMark(self, segment);
+				}
+			//===== Attach the log and remove the segment files already evicted =====
+			self->log = log;
+			this_truncateLog(self);
+			pthread_mutex_unlock(&(self->lock));
+			memset(MESSAGE, 0, sizeof(MESSAGE));
+			snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Replayed \"%d\" entries of the write-ahead log", replayedEntry);
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, MESSAGE);
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			pthread_mutex_unlock(&(self->lock));
+			M2MHeap_free(directoryPath);
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to open the write-ahead log");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Start the asynchronous mode.<br>
+ * A writer thread is created, which owns the insertion into the SQLite3 <br>
+ * databases (memory and file); records are put by M2MCEP_enqueueCSV() into a <br>
+ * bounded lock-free queue. Other functions touching the databases (e.g. <br>
+ * M2MCEP_select()) are serialized with the writer thread.<br>
+ * Configure the CEP object (M2MCEP_setMaxRecord() etc.) before starting.<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @param[in] capacity	Number of CSV strings the queue can hold (rounded up to a power of 2)
+ * @param[in] blocking	true: M2MCEP_enqueueCSV() waits when the queue is full, false: the CSV string is dropped
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_startAsync (M2MCEP *self, const unsigned int capacity, const bool blocking)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_startAsync()";
+
+	//===== Check argument =====
+	if (self!=NULL && self->queue==NULL && capacity>0)
+		{
+		//===== Create queue and writer thread =====
+		if ((self->queue=M2MConcurrentQueue_new(capacity))!=NULL)
+			{
+			self->queueBlocking = blocking;
+			atomic_store(&(self->queueRunning), true);
+			if (pthread_create(&(self->queueThread), NULL, this_runAsyncWriter, self)==0)
 				{
-				//===== Return the execution result as it is =====
-				return (*result);
+				M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Started asynchronous mode");
+				return self;
 				}
-			//===== When data is not included in the execution result =====
+			//===== Error handling =====
 			else
 				{
-				//===== Release heap memory area of result =====
-				M2MHeap_free((*result));
+				M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create asynchronous writer thread");
+				atomic_store(&(self->queueRunning), false);
+				M2MConcurrentQueue_delete(&(self->queue));
 				return NULL;
 				}
 			}
 		//===== Error handling =====
 		else
 			{
-			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(memoryDatabase));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create queue of asynchronous mode");
 			return NULL;
 			}
 		}
@@ -2686,229 +10710,365 @@ M2MString *M2MCEP_select (M2MCEP *self, const M2MString *sql, M2MString **result
 		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
-	else if (sql==NULL)
+	else if (self->queue!=NULL)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is already in asynchronous mode");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"result\" pointer is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated capacity of the queue is 0");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set logging structure object in column information object.<br>
+ * Start background checkpoints.<br>
+ * A dedicated thread calls M2MCEP_checkpoint() every "interval" (the CEP <br>
+ * object is locked only while the database in memory is copied).<br>
  *
- * @param[in,out] self	Column information object
- * @param[in] logger	Logging structure object
- * @return				Column information object with logger set or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] interval	Interval of checkpoints[usec]
+ * @return				CEP structure object or NULL (in case of error)
  */
-M2MCEP *M2MCEP_setLogger (M2MCEP *self, const M2MFileAppender *logger)
+M2MCEP *M2MCEP_startCheckpoint (M2MCEP *self, const uint64_t interval)
 	{
 	//========== Variable ==========
-	M2MFileAppender *oldLogger = NULL;
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setLogger()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_startCheckpoint()";
 
 	//===== Check argument =====
-	if (self!=NULL && logger!=NULL)
+	if (self!=NULL && atomic_load(&(self->checkpointRunning))==false && interval>0)
 		{
-		//===== In case of existing logger object yet =====
-		if ((oldLogger=self->logger)!=NULL)
+		//===== Start checkpoint thread =====
+		self->checkpointInterval = interval;
+		atomic_store(&(self->checkpointRunning), true);
+		if (pthread_create(&(self->checkpointThread), NULL, this_runCheckpointer, self)==0)
 			{
-			//===== Release allocated memory =====
-			M2MFileAppender_delete(&oldLogger);
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Started background checkpoints");
+			return self;
 			}
-		//===== In case of no existing logger object =====
+		//===== Error handling =====
 		else
 			{
+			atomic_store(&(self->checkpointRunning), false);
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create background checkpoint thread");
+			return NULL;
 			}
-		//===== Set logger object =====
-		self->logger = (M2MFileAppender *)logger;
-		//=====  =====
-		return self;
 		}
 	//===== Argument error =====
 	else if (self==NULL)
 		{
-		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MColumn\" object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	else if (atomic_load(&(self->checkpointRunning))==true)
+		{
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Background checkpoints of indicated \"M2MCEP\" structure object are already running");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MFileAppender\" object is NULL");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated interval of checkpoints is 0");
 		return NULL;
 		}
 	}
 
 
 /**
- * Change the maximum number of records that can be stored in each table in the <br>
- * SQLite 3 database existing in memory to the integer value specified by the <br>
- * argument.<br>
- * Note that it is not possible to set an integer number of 500 or more to the <br>
- * record number upper limit value.<br>
+ * Start background persistence.<br>
+ * The records leaving the record window are copied and handed off to a <br>
+ * dedicated thread which owns the SQLite3 database on file and inserts all <br>
+ * the batches handed off since its last run in one transaction. The caller <br>
+ * waits (backpressure) only while more than "maxInFlightRecord" records are <br>
+ * not yet persisted.<br>
+ * Do not access the SQLite3 database on file directly while background <br>
+ * persistence is running.<br>
  *
- * @param[in,out] self		Maximum number of records CEP execution object to be changed
- * @param[in] maxRecord		Integer indicating the maximum number of records in one table or 0 (in case of error)
- * @return					CEP execution object or 0 (maximum number of records set)
+ * @param[in,out] self				CEP structure object
+ * @param[in] maxInFlightRecord		Maximum number of handed off records not yet persisted
+ * @return							CEP structure object or NULL (in case of error)
  */
-M2MCEP *M2MCEP_setMaxRecord (M2MCEP *self, const unsigned int maxRecord)
+M2MCEP *M2MCEP_startPersistence (M2MCEP *self, const unsigned int maxInFlightRecord)
 	{
 	//========== Variable ==========
-	M2MString MESSAGE[256];
-	const unsigned int MAX_RECORD_MAX = 500;
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP_setMaxRecord()";
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_startPersistence()";
 
 	//===== Check argument =====
-	if (self!=NULL && 0<maxRecord && maxRecord<MAX_RECORD_MAX)
+	if (self!=NULL && atomic_load(&(self->persistenceRunning))==false && maxInFlightRecord>0)
 		{
-		//===== Set number of records upper limit =====
-		self->maxRecord = maxRecord;
-		memset(MESSAGE, 0, sizeof(MESSAGE));
-		snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"The upper limit number of records (=\"%u\") in the SQLite database in memory has been set in the CEP object", self->maxRecord);
-		M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, MESSAGE);
-		return self;
+		//===== Hand over SQLite3 database on file while no insertion is running =====
+		pthread_mutex_lock(&(self->lock));
+		self->maxInFlightRecord = maxInFlightRecord;
+		atomic_store(&(self->persistenceRunning), true);
+		if (pthread_create(&(self->persistenceThread), NULL, this_runPersister, self)==0)
+			{
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Started background persistence");
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			atomic_store(&(self->persistenceRunning), false);
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create background persistence thread");
+			return NULL;
+			}
 		}
 	//===== Argument error =====
 	else if (self==NULL)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
-	else if (maxRecord<=0)
+	else if (atomic_load(&(self->persistenceRunning))==true)
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The upper limit of the number of records specified by argument is an integer less than or equal to 0 which is the minimum setting value.");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Background persistence of indicated \"M2MCEP\" structure object is already running");
 		return NULL;
 		}
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! The number of records specified by the argument The upper limit value is an integer of 500 or more which is the maximum setting value.");
+		M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated maximum number of in-flight records is 0");
 		return NULL;
 		}
 	}
 
 
 /**
- * Set a flag indicating permanence (recording in the SQLite 3 database on the <br>
- * file) to the CEP structure object specified by the argument.<br>
- * When set to true, all records inserted by M2MCEP_insertCSV () are recorded in <br>
- * the SQLite 3 database on the file.<br>
- * If set to "false", do not record to the SQLite 3 database on the file.<br>
+ * Stop the asynchronous mode.<br>
+ * The CSV strings remaining in the queue are all inserted (drained) before the <br>
+ * writer thread finishes. Do not call M2MCEP_enqueueCSV() at the same time.<br>
+ * This function is also called by M2MCEP_delete().<br>
  *
- * @param[in,out] self		CEP structure object
- * @param[in] persistence	Flag indicating permanence (record in SQLite 3 database on file)
- * @return					CEP execution object with a flag indicating permanence availability or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
  */
-M2MCEP *M2MCEP_setPersistence (M2MCEP *self, const bool persistence)
+M2MCEP *M2MCEP_stopAsync (M2MCEP *self)
 	{
 	//========== Variable ==========
-	const M2MString *METHOD_NAME = (M2MString *)"M2MCEP_setPersistence()";
+	M2MString *item = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_stopAsync()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		//===== In the case of persistence =====
-		if (persistence==true)
+		//===== In case of asynchronous mode =====
+		if (self->queue!=NULL)
 			{
-			self->persistence = true;
-			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set flag for insert record persistence to \"ON\"");
-			return self;
+			//===== Let the writer thread drain the queue and finish =====
+			atomic_store(&(self->queueRunning), false);
+			pthread_mutex_lock(&(self->queueMutex));
+			pthread_cond_broadcast(&(self->queueCondition));
+			pthread_mutex_unlock(&(self->queueMutex));
+			pthread_join(self->queueThread, NULL);
+			//===== Insert CSV strings queued while stopping =====
+			while ((item=(M2MString *)M2MConcurrentQueue_poll(self->queue))!=NULL)
+				{
+				M2MCEP_insertCSV(self, item, &(item[M2MString_length(item)+1]));
+				M2MHeap_free(item);
+				}
+			M2MConcurrentQueue_delete(&(self->queue));
+			//===== Commit the records accumulated for group commit =====
+			M2MCEP_commit(self);
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Stopped asynchronous mode");
 			}
-		//===== In case of non-persistence =====
-		else if (persistence==false)
+		//===== In case of synchronous mode =====
+		else
 			{
-			self->persistence = false;
-			M2MLogger_debug(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Set flag for insert record persistence to \"OFF\"");
-			return self;
+			// do nothing
 			}
-		//===== Error handling =====
+		return self;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/**
+ * Stop background checkpoints.<br>
+ * This function is also called by M2MCEP_delete().<br>
+ *
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
+ */
+M2MCEP *M2MCEP_stopCheckpoint (M2MCEP *self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_stopCheckpoint()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== In case of background checkpoints =====
+		if (atomic_load(&(self->checkpointRunning))==true)
+			{
+			//===== Wake up the checkpoint thread and wait for its end =====
+			pthread_mutex_lock(&(self->checkpointMutex));
+			atomic_store(&(self->checkpointRunning), false);
+			pthread_cond_broadcast(&(self->checkpointCondition));
+			pthread_mutex_unlock(&(self->checkpointMutex));
+			pthread_join(self->checkpointThread, NULL);
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Stopped background checkpoints");
+			}
+		//===== In case of no background checkpoints =====
 		else
 			{
-			M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"The permanence flag indicated by argument is neither \"true\" nor \"false\"");
-			return NULL;
+			// do nothing
 			}
+		return self;
 		}
 	//===== Argument error =====
 	else
 		{
-		M2MLogger_error(M2MCEP_getLogger(self), METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * When forcibly terminating when using the shared library (libcep.so), set the <br>
- * event handler to acquire the signal and perform the termination processing.<br>
+ * Stop background persistence.<br>
+ * The batches remaining in the queue are all committed into the SQLite3 <br>
+ * database on file before the thread finishes.<br>
+ * This function is also called by M2MCEP_delete().<br>
  *
- * @param[in] self	CEP structure object
+ * @param[in,out] self	CEP structure object
+ * @return				CEP structure object or NULL (in case of error)
  */
-void M2MCEP_setSignalHandler (const M2MCEP *self)
+M2MCEP *M2MCEP_stopPersistence (M2MCEP *self)
 	{
 	//========== Variable ==========
-	struct sigaction newAction;
-	struct sigaction oldAction;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_stopPersistence()";
 
-	//=====  =====
-//	newAction.sa_handler = termination_handler;
-	//=====  =====
-	sigemptyset(&newAction.sa_mask);
-	//=====  =====
-	newAction.sa_flags = 0;
-	//=====  =====
-	sigaction(SIGINT, NULL, &oldAction);
-	//=====  =====
-	if (oldAction.sa_handler!=SIG_IGN)
+	//===== Check argument =====
+	if (self!=NULL)
 		{
-		sigaction (SIGINT, &newAction, NULL);
+		//===== In case of background persistence =====
+		if (atomic_load(&(self->persistenceRunning))==true)
+			{
+			//===== Let the persistence thread drain the batches and finish =====
+			pthread_mutex_lock(&(self->lock));
+			pthread_mutex_lock(&(self->persistenceMutex));
+			atomic_store(&(self->persistenceRunning), false);
+			pthread_cond_broadcast(&(self->persistenceCondition));
+			pthread_mutex_unlock(&(self->persistenceMutex));
+			pthread_mutex_unlock(&(self->lock));
+			pthread_join(self->persistenceThread, NULL);
+			M2MLogger_debug(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Stopped background persistence");
+			}
+		//===== In case of no background persistence =====
+		else
+			{
+			// do nothing
+			}
+		return self;
 		}
-	//=====  =====
-	sigaction(SIGHUP, NULL, &oldAction);
-	//=====  =====
-	if (oldAction.sa_handler!=SIG_IGN)
+	//===== Argument error =====
+	else
 		{
-		sigaction(SIGHUP, &newAction, NULL);
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
-	//=====  =====
-	sigaction(SIGTERM, NULL, &oldAction);
-	//=====  =====
-	if (oldAction.sa_handler!=SIG_IGN)
+	}
+
+
+/**
+ * Remove the event pattern registered with M2MCEP_registerPattern() (and <br>
+ * release it).<br>
+ *
+ * @param[in,out] self		CEP structure object
+ * @param[in] patternID		ID of the pattern
+ * @return					CEP structure object or NULL (in case of error or unknown ID)
+ */
+M2MCEP *M2MCEP_unregisterPattern (M2MCEP *self, const unsigned int patternID)
+	{
+	//========== Variable ==========
+	M2MCEPPattern **link = NULL;
+	M2MCEPPattern *pattern = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_unregisterPattern()";
+
+	//===== Check argument =====
+	if (self!=NULL)
 		{
-		sigaction(SIGTERM, &newAction, NULL);
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Search the pattern =====
+		link = &(self->pattern);
+		while ((*link)!=NULL && (*link)->patternID!=patternID)
+			{
+			link = &((*link)->next);
+			}
+		//===== Remove the pattern =====
+		if ((pattern=(*link))!=NULL)
+			{
+			(*link) = pattern->next;
+			M2MCEPPattern_delete(&pattern);
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Indicated pattern ID isn't registered");
+			return NULL;
+			}
 		}
-	//=====  =====
-	sigaction(SIGKILL, NULL, &oldAction);
-	//=====  =====
-	if (oldAction.sa_handler!=SIG_IGN)
+	//===== Argument error =====
+	else
 		{
-		sigaction(SIGKILL, &newAction, NULL);
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEP\" structure object is NULL");
+		return NULL;
 		}
-	return;
 	}
 
 
 /**
- * SQLite 3 Sets the number of records for vacuuming the database.<br>
- * For this vacuum processing setting, it is a setting of sharing SQLite 3 <br>
- * database on memory and SQLite 3 database on file.<br>
+ * Remove the continuous query registered with M2MCEP_registerQuery().<br>
  *
- * @param self			Number of records for vacuum processing CEP execution object to be set
- * @param vacuumRecord	An integer value indicating the number of records of vacuum processing (automatic vacuum setting when 0 is specified)
- * @return				CEP execution object or number of records to be vacuum processed or NULL (in case of error)
+ * @param[in,out] self	CEP structure object
+ * @param[in] queryID	ID of the query
+ * @return				CEP structure object or NULL (in case of error or unknown ID)
  */
-M2MCEP *M2MCEP_setVacuumRecord (M2MCEP *self, const unsigned int vacuumRecord)
+M2MCEP *M2MCEP_unregisterQuery (M2MCEP *self, const unsigned int queryID)
 	{
 	//========== Variable ==========
-	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_setVacuumRecord()";
+	M2MCEPQuery **link = NULL;
+	M2MCEPQuery *query = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEP_unregisterQuery()";
 
 	//===== Check argument =====
 	if (self!=NULL)
 		{
-		self->vacuumRecord = vacuumRecord;
-		return self;
+		//===== Exclusive access to SQLite3 databases =====
+		pthread_mutex_lock(&(self->lock));
+		//===== Search the query =====
+		link = &(self->query);
+		while ((*link)!=NULL && (*link)->queryID!=queryID)
+			{
+			link = &((*link)->next);
+			}
+		//===== Remove the query =====
+		if ((query=(*link))!=NULL)
+			{
+			(*link) = query->next;
+			this_deleteQuery(&query);
+			pthread_mutex_unlock(&(self->lock));
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			pthread_mutex_unlock(&(self->lock));
+			M2MLogger_error(M2MCEP_getLogger(self), FUNCTION_NAME, __LINE__, (M2MString *)"Indicated query ID isn't registered");
+			return NULL;
+			}
 		}
 	//===== Argument error =====
 	else
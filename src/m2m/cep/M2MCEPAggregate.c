@@ -0,0 +1,488 @@
+/*******************************************************************************
+ * M2MCEPAggregate.c : Incrementally maintained aggregate of a window column
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPAggregate.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Release the slots of the double ended queue.<br>
+ *
+ * @param[in,out] deque	Double ended queue
+ */
+static void this_clear (M2MCEPAggregateDeque *deque);
+
+
+/**
+ * Returns the entry of the double ended queue.<br>
+ *
+ * @param[in] deque		Double ended queue (not empty)
+ * @param[in] index		Index from the first entry (0: first, length-1: last)
+ * @return				Entry
+ */
+static M2MCEPAggregateEntry *this_get (const M2MCEPAggregateDeque *deque, const size_t index);
+
+
+/**
+ * Remove the last entry of the double ended queue.<br>
+ *
+ * @param[in,out] deque	Double ended queue (not empty)
+ */
+static void this_popBack (M2MCEPAggregateDeque *deque);
+
+
+/**
+ * Remove the first entry of the double ended queue.<br>
+ *
+ * @param[in,out] deque	Double ended queue (not empty)
+ */
+static void this_popFront (M2MCEPAggregateDeque *deque);
+
+
+/**
+ * Append the entry to the end of the double ended queue.<br>
+ * The slots are doubled when the queue is full.<br>
+ *
+ * @param[in,out] deque	Double ended queue
+ * @param[in] rowid		Rowid of the record
+ * @param[in] value		Value of the record
+ * @return				true: Succeed to append, false: Failed to allocate slots
+ */
+static bool this_pushBack (M2MCEPAggregateDeque *deque, const int64_t rowid, const double value);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Release the slots of the double ended queue.<br>
+ *
+ * @param[in,out] deque	Double ended queue
+ */
+static void this_clear (M2MCEPAggregateDeque *deque)
+	{
+	M2MHeap_free(deque->entry);
+	deque->capacity = 0;
+	deque->head = 0;
+	deque->length = 0;
+	return;
+	}
+
+
+/**
+ * Returns the entry of the double ended queue.<br>
+ *
+ * @param[in] deque		Double ended queue (not empty)
+ * @param[in] index		Index from the first entry (0: first, length-1: last)
+ * @return				Entry
+ */
+static M2MCEPAggregateEntry *this_get (const M2MCEPAggregateDeque *deque, const size_t index)
+	{
+	return &(deque->entry[(deque->head+index) & (deque->capacity-1)]);
+	}
+
+
+/**
+ * Remove the last entry of the double ended queue.<br>
+ *
+ * @param[in,out] deque	Double ended queue (not empty)
+ */
+static void this_popBack (M2MCEPAggregateDeque *deque)
+	{
+	deque->length--;
+	return;
+	}
+
+
+/**
+ * Remove the first entry of the double ended queue.<br>
+ *
+ * @param[in,out] deque	Double ended queue (not empty)
+ */
+static void this_popFront (M2MCEPAggregateDeque *deque)
+	{
+	deque->head = (deque->head+1) & (deque->capacity-1);
+	deque->length--;
+	return;
+	}
+
+
+/**
+ * Append the entry to the end of the double ended queue.<br>
+ * The slots are doubled when the queue is full.<br>
+ *
+ * @param[in,out] deque	Double ended queue
+ * @param[in] rowid		Rowid of the record
+ * @param[in] value		Value of the record
+ * @return				true: Succeed to append, false: Failed to allocate slots
+ */
+static bool this_pushBack (M2MCEPAggregateDeque *deque, const int64_t rowid, const double value)
+	{
+	//========== Variable ==========
+	M2MCEPAggregateEntry *entry = NULL;
+	M2MCEPAggregateEntry *slot = NULL;
+	size_t capacity = 0;
+	size_t i = 0;
+
+	//===== Double the slots in case of full queue =====
+	if (deque->length==deque->capacity)
+		{
+		capacity = (deque->capacity>0) ? deque->capacity*2 : 16;
+		if ((entry=(M2MCEPAggregateEntry *)M2MHeap_malloc(sizeof(M2MCEPAggregateEntry)*capacity))!=NULL)
+			{
+			//===== Copy the entries in order =====
+			for (i=0; i<deque->length; i++)
+				{
+				entry[i] = *this_get(deque, i);
+				}
+			M2MHeap_free(deque->entry);
+			deque->entry = entry;
+			deque->capacity = capacity;
+			deque->head = 0;
+			}
+		//===== Error handling =====
+		else
+			{
+			return false;
+			}
+		}
+	//===== In case of free slot =====
+	else
+		{
+		// do nothing
+		}
+	//===== Append the entry =====
+	slot = &(deque->entry[(deque->head+deque->length) & (deque->capacity-1)]);
+	slot->rowid = rowid;
+	slot->value = value;
+	deque->length++;
+	return true;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Add the value of the record inserted into the window.<br>
+ * Records must be added in rowid order.<br>
+ *
+ * @param[in,out] self	Aggregate object
+ * @param[in] rowid		Rowid of the record
+ * @param[in] value		Value of the aggregated column
+ * @return				Aggregate object or NULL (in case of error)
+ */
+M2MCEPAggregate *M2MCEPAggregate_add (M2MCEPAggregate *self, const int64_t rowid, const double value)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPAggregate_add()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Keep the monotonic deques (the dominated values never become the minimum or maximum) =====
+		while (self->minimum.length>0 && this_get(&(self->minimum), self->minimum.length-1)->value>=value)
+			{
+			this_popBack(&(self->minimum));
+			}
+		while (self->maximum.length>0 && this_get(&(self->maximum), self->maximum.length-1)->value<=value)
+			{
+			this_popBack(&(self->maximum));
+			}
+		//===== Append the value =====
+		if (this_pushBack(&(self->window), rowid, value)==true
+				&& this_pushBack(&(self->minimum), rowid, value)==true
+				&& this_pushBack(&(self->maximum), rowid, value)==true)
+			{
+			self->sum += value;
+			self->lastRowid = rowid;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the values of the aggregate");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPAggregate\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the heap memory of the aggregate object.<br>
+ *
+ * @param[in,out] self	Aggregate object to be freed of memory area
+ */
+void M2MCEPAggregate_delete (M2MCEPAggregate **self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		M2MHeap_free((*self)->tableName);
+		M2MHeap_free((*self)->columnName);
+		M2MHeap_free((*self)->selectSQL);
+		this_clear(&((*self)->window));
+		this_clear(&((*self)->minimum));
+		this_clear(&((*self)->maximum));
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Remove the values of the records below the rowid watermark (the records <br>
+ * evicted from the window).<br>
+ *
+ * @param[in,out] self		Aggregate object
+ * @param[in] watermark		Rowid of the oldest record remaining in the window
+ * @return					Number of removed values
+ */
+size_t M2MCEPAggregate_evict (M2MCEPAggregate *self, const int64_t watermark)
+	{
+	//========== Variable ==========
+	M2MCEPAggregateEntry *entry = NULL;
+	size_t numberOfValue = 0;
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Remove the evicted values from the sum =====
+		while (self->window.length>0 && (entry=this_get(&(self->window), 0))->rowid<watermark)
+			{
+			self->sum -= entry->value;
+			this_popFront(&(self->window));
+			numberOfValue++;
+			}
+		//===== Remove the evicted values from the monotonic deques =====
+		while (self->minimum.length>0 && this_get(&(self->minimum), 0)->rowid<watermark)
+			{
+			this_popFront(&(self->minimum));
+			}
+		while (self->maximum.length>0 && this_get(&(self->maximum), 0)->rowid<watermark)
+			{
+			this_popFront(&(self->maximum));
+			}
+		//===== Reset the accumulated rounding error of the sum =====
+		if (self->window.length==0)
+			{
+			self->sum = 0;
+			}
+		else
+			{
+			// do nothing
+			}
+		return numberOfValue;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPAggregate_evict()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPAggregate\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the kind of aggregate value indicated by the string ("sum", <br>
+ * "count", "avg", "min" or "max", case insensitive).<br>
+ *
+ * @param[in] string	String indicating the kind of aggregate value
+ * @param[out] type		Buffer to store the kind of aggregate value
+ * @return				true: known kind, false: unknown kind
+ */
+bool M2MCEPAggregate_getType (const M2MString *string, M2MCEPAggregateType *type)
+	{
+	//========== Variable ==========
+	M2MString buffer[8];
+
+	//===== Initialize buffer =====
+	memset(buffer, 0, sizeof(buffer));
+	//===== Check argument =====
+	if (string!=NULL && type!=NULL
+			&& M2MString_toLowerCase(string, buffer, sizeof(buffer))!=NULL)
+		{
+		if (strcmp((const char *)buffer, "sum")==0)
+			{
+			(*type) = M2MCEPAggregateType_SUM;
+			return true;
+			}
+		else if (strcmp((const char *)buffer, "count")==0)
+			{
+			(*type) = M2MCEPAggregateType_COUNT;
+			return true;
+			}
+		else if (strcmp((const char *)buffer, "avg")==0)
+			{
+			(*type) = M2MCEPAggregateType_AVG;
+			return true;
+			}
+		else if (strcmp((const char *)buffer, "min")==0)
+			{
+			(*type) = M2MCEPAggregateType_MIN;
+			return true;
+			}
+		else if (strcmp((const char *)buffer, "max")==0)
+			{
+			(*type) = M2MCEPAggregateType_MAX;
+			return true;
+			}
+		else
+			{
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Returns the aggregate value in O(1).<br>
+ * The sum and the count of an empty window are 0; the average, the minimum <br>
+ * and the maximum of an empty window are NAN.<br>
+ *
+ * @param[in] self	Aggregate object
+ * @param[in] type	Kind of aggregate value
+ * @return			Aggregate value or NAN (in case of error or empty window)
+ */
+double M2MCEPAggregate_getValue (const M2MCEPAggregate *self, const M2MCEPAggregateType type)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		if (type==M2MCEPAggregateType_SUM)
+			{
+			return (double)self->sum;
+			}
+		else if (type==M2MCEPAggregateType_COUNT)
+			{
+			return (double)self->window.length;
+			}
+		//===== The other values are undefined for an empty window =====
+		else if (self->window.length==0)
+			{
+			return NAN;
+			}
+		else if (type==M2MCEPAggregateType_AVG)
+			{
+			return (double)(self->sum/(long double)self->window.length);
+			}
+		else if (type==M2MCEPAggregateType_MIN)
+			{
+			return this_get(&(self->minimum), 0)->value;
+			}
+		else if (type==M2MCEPAggregateType_MAX)
+			{
+			return this_get(&(self->maximum), 0)->value;
+			}
+		else
+			{
+			return NAN;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPAggregate_getValue()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPAggregate\" structure object is NULL");
+		return NAN;
+		}
+	}
+
+
+/**
+ * Create a new aggregate object of the column of the table.<br>
+ *
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name
+ * @return					Created aggregate object or NULL (in case of error)
+ */
+M2MCEPAggregate *M2MCEPAggregate_new (const M2MString *tableName, const M2MString *columnName)
+	{
+	//========== Variable ==========
+	M2MCEPAggregate *self = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPAggregate_new()";
+
+	//===== Check argument =====
+	if (tableName!=NULL && columnName!=NULL)
+		{
+		//===== Create the aggregate and the SELECT statement of the new records =====
+		if ((self=(M2MCEPAggregate *)M2MHeap_malloc(sizeof(M2MCEPAggregate)))!=NULL
+				&& M2MString_append(&(self->tableName), tableName)!=NULL
+				&& M2MString_append(&(self->columnName), columnName)!=NULL
+				&& M2MString_append(&(self->selectSQL), (M2MString *)"SELECT rowid, ")!=NULL
+				&& M2MString_append(&(self->selectSQL), columnName)!=NULL
+				&& M2MString_append(&(self->selectSQL), (M2MString *)" FROM ")!=NULL
+				&& M2MString_append(&(self->selectSQL), tableName)!=NULL
+				&& M2MString_append(&(self->selectSQL), (M2MString *)" WHERE rowid > ? AND ")!=NULL
+				&& M2MString_append(&(self->selectSQL), columnName)!=NULL
+				&& M2MString_append(&(self->selectSQL), (M2MString *)" IS NOT NULL ORDER BY rowid ")!=NULL)
+			{
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the aggregate");
+			M2MCEPAggregate_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name or column name string is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
@@ -0,0 +1,1842 @@
+/*******************************************************************************
+ * M2MCEPColumnStore.c : Compressed columnar store of CEP history
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+#include "m2m/cep/M2MCEPColumnStore.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Add the entry of the block to the end of the block index.<br>
+ *
+ * @param[in,out] self			Column store object
+ * @param[in] offset			Position of the block header in the file[Byte]
+ * @param[in] length			Size of the block following the header[Byte]
+ * @param[in] numberOfRecord	Number of records in the block
+ * @param[in] minTime			Minimum value of the time column in the block
+ * @param[in] maxTime			Maximum value of the time column in the block
+ * @return						true: Succeed to add, false: Failed to allocate
+ */
+static bool this_addBlock (M2MCEPColumnStore *self, const off_t offset, const uint32_t length, const uint32_t numberOfRecord, const int64_t minTime, const int64_t maxTime);
+
+
+/**
+ * Release the strings of the records waiting for the next block.<br>
+ *
+ * @param[in,out] self	Column store object
+ */
+static void this_clearRecord (M2MCEPColumnStore *self);
+
+
+/**
+ * Decode the chunk of one column of a block.<br>
+ * Strings and binary data point into the chunk.<br>
+ *
+ * @param[in] data				Chunk of the column
+ * @param[in] length			Size of the chunk[Byte]
+ * @param[in] type				Type of the column
+ * @param[in] numberOfRecord	Number of records in the block
+ * @param[out] values			Array of "numberOfRecord" values to store the decoded column
+ * @return						true: Succeed to decode, false: Broken chunk or error
+ */
+static bool this_decodeColumn (const unsigned char *data, const size_t length, const M2MCEPValueType type, const unsigned int numberOfRecord, M2MCEPValue *values);
+
+
+/**
+ * Encode the column of the records waiting for the next block into the <br>
+ * bit stream.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @param[in] column	Index of the column
+ * @return				true: Succeed to encode, false: Failed to allocate
+ */
+static bool this_encodeColumn (M2MCEPColumnStore *self, const unsigned int column);
+
+
+/**
+ * Encode the file header (magic number and columns) into the bit stream.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @return				true: Succeed to encode, false: Failed to allocate
+ */
+static bool this_encodeHeader (M2MCEPColumnStore *self);
+
+
+/**
+ * Returns the number of bits required for the unsigned integer.<br>
+ *
+ * @param[in] number	Unsigned integer
+ * @return				Number of bits (0 in case of 0)
+ */
+static unsigned int this_getBitLength (uint64_t number);
+
+
+/**
+ * Returns the FNV-1a hash value of the data (for the dictionary).<br>
+ *
+ * @param[in] data		Data
+ * @param[in] length	Size of the data[Byte]
+ * @return				Hash value
+ */
+static uint32_t this_getHash (const unsigned char *data, const size_t length);
+
+
+/**
+ * Read the unsigned integer of "count" bits from the bit stream.<br>
+ *
+ * @param[in] data			Bit stream
+ * @param[in] length		Size of the bit stream[Byte]
+ * @param[in,out] position	Read position[bit] (advanced by "count")
+ * @param[in] count			Number of bits (<=64)
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the bit stream
+ */
+static bool this_readBits (const unsigned char *data, const size_t length, size_t *position, const unsigned int count, uint64_t *number);
+
+
+/**
+ * Read the block into the bit stream and verify its CRC-32.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @param[in] block		Entry of the block index
+ * @return				true: Succeed to read, false: Failed to read or broken block
+ */
+static bool this_readBlock (M2MCEPColumnStore *self, const M2MCEPColumnBlock *block);
+
+
+/**
+ * Build the block index from the block headers following the file header <br>
+ * and cut off the broken block at the end of the file.<br>
+ *
+ * @param[in,out] self		Column store object
+ * @param[in] position		Position of the first block[Byte]
+ * @param[in] fileLength	Size of the file[Byte]
+ * @return					true: Succeed to read, false: Error
+ */
+static bool this_readIndex (M2MCEPColumnStore *self, off_t position, const off_t fileLength);
+
+
+/**
+ * Read the little endian unsigned integer from the buffer.<br>
+ *
+ * @param[in] buffer		Buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readUnsigned (const unsigned char *buffer, const size_t length, size_t *position, const size_t size, uint64_t *number);
+
+
+/**
+ * Enlarge the bit stream so that "length" more bytes can be appended.<br>
+ *
+ * @param[in,out] buffer	Bit stream
+ * @param[in] length		Size to be appended[Byte]
+ * @return					true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_reserve (M2MCEPColumnBuffer *buffer, const size_t length);
+
+
+/**
+ * Copy the value into the record waiting for the next block with converting <br>
+ * it into the type of the column.<br>
+ *
+ * @param[in] self			Column store object
+ * @param[in] column		Index of the column
+ * @param[in] value			Value of the inserted record
+ * @param[out] destination	Value of the waiting record (owns its string)
+ * @return					true: Succeed to copy, false: Failed to allocate
+ */
+static bool this_setValue (const M2MCEPColumnStore *self, const unsigned int column, const M2MCEPValue *value, M2MCEPValue *destination);
+
+
+/**
+ * Append the lower "count" bits of the unsigned integer to the bit stream.<br>
+ *
+ * @param[in,out] buffer	Bit stream
+ * @param[in] number		Unsigned integer
+ * @param[in] count			Number of bits (<=64)
+ * @return					true: Succeed to write, false: Failed to allocate
+ */
+static bool this_writeBits (M2MCEPColumnBuffer *buffer, const uint64_t number, const unsigned int count);
+
+
+/**
+ * Encode the records waiting for the next block and write them into the <br>
+ * file as one block with one write() call and fsync().<br>
+ *
+ * @param[in,out] self	Column store object
+ * @return				true: Succeed to write, false: Error (the records are kept)
+ */
+static bool this_writeBlock (M2MCEPColumnStore *self);
+
+
+/**
+ * Append the bytes to the bit stream from the next byte boundary.<br>
+ *
+ * @param[in,out] buffer	Bit stream
+ * @param[in] data			Bytes
+ * @param[in] length		Size of the bytes[Byte]
+ * @return					true: Succeed to write, false: Failed to allocate
+ */
+static bool this_writeBytes (M2MCEPColumnBuffer *buffer, const void *data, const size_t length);
+
+
+/**
+ * Write the unsigned integer in little endian into the buffer.<br>
+ *
+ * @param[out] buffer		Buffer (must have enough space)
+ * @param[in,out] position	Write position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[in] number		Integer
+ */
+static void this_writeUnsigned (unsigned char *buffer, size_t *position, const size_t size, const uint64_t number);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Add the entry of the block to the end of the block index.<br>
+ *
+ * @param[in,out] self			Column store object
+ * @param[in] offset			Position of the block header in the file[Byte]
+ * @param[in] length			Size of the block following the header[Byte]
+ * @param[in] numberOfRecord	Number of records in the block
+ * @param[in] minTime			Minimum value of the time column in the block
+ * @param[in] maxTime			Maximum value of the time column in the block
+ * @return						true: Succeed to add, false: Failed to allocate
+ */
+static bool this_addBlock (M2MCEPColumnStore *self, const off_t offset, const uint32_t length, const uint32_t numberOfRecord, const int64_t minTime, const int64_t maxTime)
+	{
+	//========== Variable ==========
+	M2MCEPColumnBlock *block = NULL;
+
+	if ((block=(M2MCEPColumnBlock *)M2MHeap_malloc(sizeof(M2MCEPColumnBlock)))!=NULL)
+		{
+		block->offset = offset;
+		block->length = length;
+		block->numberOfRecord = numberOfRecord;
+		block->minTime = minTime;
+		block->maxTime = maxTime;
+		if (self->lastBlock!=NULL)
+			{
+			self->lastBlock->next = block;
+			}
+		else
+			{
+			self->block = block;
+			}
+		self->lastBlock = block;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore.this_addBlock()", __LINE__, (M2MString *)"Failed to allocate new memory for the block index");
+		return false;
+		}
+	}
+
+
+/**
+ * Release the strings of the records waiting for the next block.<br>
+ *
+ * @param[in,out] self	Column store object
+ */
+static void this_clearRecord (M2MCEPColumnStore *self)
+	{
+	//========== Variable ==========
+	void *data = NULL;
+	size_t i = 0;
+
+	for (i=0; i<(size_t)self->numberOfRecord*self->numberOfColumn; i++)
+		{
+		if (self->record[i].type==M2MCEPValueType_TEXT || self->record[i].type==M2MCEPValueType_BLOB)
+			{
+			data = (void *)self->record[i].value.blob;
+			M2MHeap_free(data);
+			}
+		else
+			{
+			// do nothing
+			}
+		memset(&(self->record[i]), 0, sizeof(M2MCEPValue));
+		}
+	self->numberOfRecord = 0;
+	return;
+	}
+
+
+/**
+ * Decode the chunk of one column of a block.<br>
+ * Strings and binary data point into the chunk.<br>
+ *
+ * @param[in] data				Chunk of the column
+ * @param[in] length			Size of the chunk[Byte]
+ * @param[in] type				Type of the column
+ * @param[in] numberOfRecord	Number of records in the block
+ * @param[out] values			Array of "numberOfRecord" values to store the decoded column
+ * @return						true: Succeed to decode, false: Broken chunk or error
+ */
+static bool this_decodeColumn (const unsigned char *data, const size_t length, const M2MCEPValueType type, const unsigned int numberOfRecord, M2MCEPValue *values)
+	{
+	//========== Variable ==========
+	M2MCEPValue *dictionary = NULL;
+	size_t position = 0;
+	uint64_t number = 0;
+	uint64_t bit = 0;
+	uint64_t previous = 0;
+	uint64_t previousDelta = 0;
+	uint64_t count = 0;
+	unsigned int width = 0;
+	unsigned int leading = 0;
+	unsigned int meaningful = 0;
+	unsigned int i = 0;
+	bool first = true;
+	bool result = true;
+
+	//===== Null bitmap =====
+	if ((result=this_readBits(data, length, &position, 1, &bit))==true)
+		{
+		for (i=0; i<numberOfRecord; i++)
+			{
+			if (bit==1 && (result=this_readBits(data, length, &position, 1, &number))==false)
+				{
+				break;
+				}
+			else
+				{
+				values[i].type = (bit==1 && number==1) ? M2MCEPValueType_NULL : type;
+				}
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	//===== Delta-of-delta =====
+	if (result==true && type==M2MCEPValueType_INTEGER)
+		{
+		for (i=0; i<numberOfRecord && result==true; i++)
+			{
+			if (values[i].type==M2MCEPValueType_NULL)
+				{
+				continue;
+				}
+			else if (first==true)
+				{
+				result = this_readBits(data, length, &position, 64, &previous);
+				first = false;
+				}
+			else
+				{
+				//===== Prefix ('0', '10', '110', '1110' or '1111') =====
+				for (width=0; width<4 && (result=this_readBits(data, length, &position, 1, &bit))==true && bit==1; width++)
+					{
+					}
+				width = (width==0) ? 0 : (width==1) ? 7 : (width==2) ? 9 : (width==3) ? 12 : 64;
+				if (result==true && width>0 && (result=this_readBits(data, length, &position, width, &number))==true)
+					{
+					//===== Sign extension =====
+					if (width<64 && ((number >> (width-1)) & 1)==1)
+						{
+						number |= (~(uint64_t)0) << width;
+						}
+					else
+						{
+						// do nothing
+						}
+					previousDelta += number;
+					}
+				else
+					{
+					// do nothing
+					}
+				previous += previousDelta;
+				}
+			values[i].value.integer = (int64_t)previous;
+			}
+		}
+	//===== XOR with the previous value =====
+	else if (result==true && type==M2MCEPValueType_REAL)
+		{
+		for (i=0; i<numberOfRecord && result==true; i++)
+			{
+			if (values[i].type==M2MCEPValueType_NULL)
+				{
+				continue;
+				}
+			else if (first==true)
+				{
+				result = this_readBits(data, length, &position, 64, &previous);
+				first = false;
+				}
+			else if ((result=this_readBits(data, length, &position, 1, &bit))==true && bit==1
+					&& (result=this_readBits(data, length, &position, 1, &bit))==true)
+				{
+				//===== New window of the meaningful bits =====
+				if (bit==1
+						&& (result=this_readBits(data, length, &position, 5, &number))==true)
+					{
+					leading = (unsigned int)number;
+					if ((result=this_readBits(data, length, &position, 6, &number))==true)
+						{
+						meaningful = (unsigned int)number + 1;
+						result = (leading+meaningful<=64);
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				else
+					{
+					result = (result==true && meaningful>0);
+					}
+				if (result==true && (result=this_readBits(data, length, &position, meaningful, &number))==true)
+					{
+					previous ^= number << (64-leading-meaningful);
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			memcpy(&(values[i].value.real), &previous, sizeof(double));
+			}
+		}
+	//===== Dictionary =====
+	else if (result==true && (type==M2MCEPValueType_TEXT || type==M2MCEPValueType_BLOB))
+		{
+		position = (position+7) & ~((size_t)7);
+		if ((result=this_readBits(data, length, &position, 32, &count))==true
+				&& (result=(count<=numberOfRecord))==true
+				&& (count==0 || (dictionary=(M2MCEPValue *)M2MHeap_calloc((size_t)count, sizeof(M2MCEPValue)))!=NULL))
+			{
+			for (i=0; i<count && result==true; i++)
+				{
+				if ((result=this_readBits(data, length, &position, 32, &number))==true
+						&& (result=(number+((type==M2MCEPValueType_TEXT) ? 1 : 0)<=(uint64_t)(length-position/8) && number<=INT_MAX))==true)
+					{
+					dictionary[i].type = type;
+					dictionary[i].value.blob = &(data[position/8]);
+					dictionary[i].length = (int)number;
+					position += ((size_t)number + ((type==M2MCEPValueType_TEXT) ? 1 : 0)) * 8;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			width = (count>0) ? this_getBitLength(count-1) : 0;
+			for (i=0; i<numberOfRecord && result==true; i++)
+				{
+				if (values[i].type==M2MCEPValueType_NULL)
+					{
+					continue;
+					}
+				else if ((result=this_readBits(data, length, &position, width, &number))==true
+						&& (result=(number<count))==true)
+					{
+					values[i] = dictionary[number];
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			M2MHeap_free(dictionary);
+			}
+		else
+			{
+			result = false;
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	return result;
+	}
+
+
+/**
+ * Encode the column of the records waiting for the next block into the <br>
+ * bit stream.<br>
+ * INTEGER: the first value in 64 bits and then the delta-of-delta of each <br>
+ * value in '0' (same interval), '10'+7, '110'+9, '1110'+12 or '1111'+64 bits.<br>
+ * REAL: the first value in 64 bits and then the XOR with the previous value <br>
+ * in '0' (same value), '10'+meaningful bits (within the previous window) or <br>
+ * '11'+leading zeros(5)+length-1(6)+meaningful bits.<br>
+ * TEXT/BLOB: number of entries(32), entries (length(32) | bytes [| '\0']) <br>
+ * from a byte boundary, and then the code of each value in the minimum bits.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @param[in] column	Index of the column
+ * @return				true: Succeed to encode, false: Failed to allocate
+ */
+static bool this_encodeColumn (M2MCEPColumnStore *self, const unsigned int column)
+	{
+	//========== Variable ==========
+	const M2MCEPValue *value = NULL;
+	const M2MCEPValue *entry = NULL;
+	unsigned int *table = NULL;
+	unsigned int *dictionary = NULL;
+	unsigned int *code = NULL;
+	unsigned int capacity = 16;
+	unsigned int count = 0;
+	unsigned int width = 0;
+	unsigned int leading = 0;
+	unsigned int trailing = 0;
+	unsigned int previousLeading = 65;
+	unsigned int previousTrailing = 0;
+	unsigned int hash = 0;
+	unsigned int i = 0;
+	uint64_t number = 0;
+	uint64_t previous = 0;
+	uint64_t delta = 0;
+	uint64_t previousDelta = 0;
+	int64_t deltaOfDelta = 0;
+	bool nullable = false;
+	bool first = true;
+	bool result = true;
+	const M2MCEPValueType TYPE = self->columnType[column];
+
+	//===== Null bitmap (only if the column includes NULL) =====
+	for (i=0; i<self->numberOfRecord && nullable==false; i++)
+		{
+		nullable = (self->record[i*self->numberOfColumn+column].type==M2MCEPValueType_NULL);
+		}
+	result = this_writeBits(&(self->buffer), (nullable==true) ? 1 : 0, 1);
+	for (i=0; i<self->numberOfRecord && nullable==true && result==true; i++)
+		{
+		result = this_writeBits(&(self->buffer), (self->record[i*self->numberOfColumn+column].type==M2MCEPValueType_NULL) ? 1 : 0, 1);
+		}
+	//===== Delta-of-delta =====
+	if (TYPE==M2MCEPValueType_INTEGER)
+		{
+		for (i=0; i<self->numberOfRecord && result==true; i++)
+			{
+			value = &(self->record[i*self->numberOfColumn+column]);
+			if (value->type==M2MCEPValueType_NULL)
+				{
+				continue;
+				}
+			number = (uint64_t)value->value.integer;
+			if (first==true)
+				{
+				result = this_writeBits(&(self->buffer), number, 64);
+				first = false;
+				}
+			else
+				{
+				delta = number - previous;
+				deltaOfDelta = (int64_t)(delta - previousDelta);
+				if (deltaOfDelta==0)
+					{
+					result = this_writeBits(&(self->buffer), 0, 1);
+					}
+				else if (-64<=deltaOfDelta && deltaOfDelta<=63)
+					{
+					result = this_writeBits(&(self->buffer), 0x2, 2) && this_writeBits(&(self->buffer), (uint64_t)deltaOfDelta, 7);
+					}
+				else if (-256<=deltaOfDelta && deltaOfDelta<=255)
+					{
+					result = this_writeBits(&(self->buffer), 0x6, 3) && this_writeBits(&(self->buffer), (uint64_t)deltaOfDelta, 9);
+					}
+				else if (-2048<=deltaOfDelta && deltaOfDelta<=2047)
+					{
+					result = this_writeBits(&(self->buffer), 0xE, 4) && this_writeBits(&(self->buffer), (uint64_t)deltaOfDelta, 12);
+					}
+				else
+					{
+					result = this_writeBits(&(self->buffer), 0xF, 4) && this_writeBits(&(self->buffer), (uint64_t)deltaOfDelta, 64);
+					}
+				previousDelta = delta;
+				}
+			previous = number;
+			}
+		}
+	//===== XOR with the previous value =====
+	else if (TYPE==M2MCEPValueType_REAL)
+		{
+		for (i=0; i<self->numberOfRecord && result==true; i++)
+			{
+			value = &(self->record[i*self->numberOfColumn+column]);
+			if (value->type==M2MCEPValueType_NULL)
+				{
+				continue;
+				}
+			memcpy(&number, &(value->value.real), sizeof(double));
+			if (first==true)
+				{
+				result = this_writeBits(&(self->buffer), number, 64);
+				first = false;
+				}
+			else if ((delta=number^previous)==0)
+				{
+				result = this_writeBits(&(self->buffer), 0, 1);
+				}
+			else
+				{
+				for (leading=0; leading<31 && ((delta >> (63-leading)) & 1)==0; leading++)
+					{
+					}
+				for (trailing=0; ((delta >> trailing) & 1)==0; trailing++)
+					{
+					}
+				//===== Within the window of the previous value =====
+				if (previousLeading<=leading && previousTrailing<=trailing)
+					{
+					result = this_writeBits(&(self->buffer), 0x2, 2) && this_writeBits(&(self->buffer), delta >> previousTrailing, 64-previousLeading-previousTrailing);
+					}
+				else
+					{
+					result = this_writeBits(&(self->buffer), 0x3, 2)
+							&& this_writeBits(&(self->buffer), leading, 5)
+							&& this_writeBits(&(self->buffer), 64-leading-trailing-1, 6)
+							&& this_writeBits(&(self->buffer), delta >> trailing, 64-leading-trailing);
+					previousLeading = leading;
+					previousTrailing = trailing;
+					}
+				}
+			previous = number;
+			}
+		}
+	//===== Dictionary =====
+	else if (TYPE==M2MCEPValueType_TEXT || TYPE==M2MCEPValueType_BLOB)
+		{
+		for (capacity=16; capacity<self->numberOfRecord*2; capacity*=2)
+			{
+			}
+		if ((table=(unsigned int *)M2MHeap_calloc(capacity, sizeof(unsigned int)))!=NULL
+				&& (dictionary=(unsigned int *)M2MHeap_calloc(self->numberOfRecord, sizeof(unsigned int)))!=NULL
+				&& (code=(unsigned int *)M2MHeap_calloc(self->numberOfRecord, sizeof(unsigned int)))!=NULL)
+			{
+			//===== Build the dictionary with the hash table =====
+			for (i=0; i<self->numberOfRecord; i++)
+				{
+				value = &(self->record[i*self->numberOfColumn+column]);
+				if (value->type==M2MCEPValueType_NULL)
+					{
+					continue;
+					}
+				for (hash=this_getHash(value->value.blob, (size_t)value->length)&(capacity-1); table[hash]!=0; hash=(hash+1)&(capacity-1))
+					{
+					entry = &(self->record[dictionary[table[hash]-1]*self->numberOfColumn+column]);
+					if (entry->length==value->length && memcmp(entry->value.blob, value->value.blob, (size_t)value->length)==0)
+						{
+						break;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				if (table[hash]==0)
+					{
+					dictionary[count] = i;
+					table[hash] = ++count;
+					}
+				else
+					{
+					// do nothing
+					}
+				code[i] = table[hash] - 1;
+				}
+			//===== Entries from a byte boundary =====
+			self->buffer.bit = 0;
+			result = this_writeBits(&(self->buffer), count, 32);
+			for (i=0; i<count && result==true; i++)
+				{
+				entry = &(self->record[dictionary[i]*self->numberOfColumn+column]);
+				result = this_writeBits(&(self->buffer), (uint64_t)entry->length, 32)
+						&& this_writeBytes(&(self->buffer), entry->value.blob, (size_t)entry->length + ((TYPE==M2MCEPValueType_TEXT) ? 1 : 0));
+				}
+			//===== Codes =====
+			width = (count>0) ? this_getBitLength(count-1) : 0;
+			for (i=0; i<self->numberOfRecord && result==true; i++)
+				{
+				if (self->record[i*self->numberOfColumn+column].type!=M2MCEPValueType_NULL)
+					{
+					result = this_writeBits(&(self->buffer), code[i], width);
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			}
+		else
+			{
+			M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore.this_encodeColumn()", __LINE__, (M2MString *)"Failed to allocate new memory for the dictionary");
+			result = false;
+			}
+		M2MHeap_free(table);
+		M2MHeap_free(dictionary);
+		M2MHeap_free(code);
+		}
+	else
+		{
+		// do nothing
+		}
+	return result;
+	}
+
+
+/**
+ * Encode the file header (magic number and columns) into the bit stream.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @return				true: Succeed to encode, false: Failed to allocate
+ */
+static bool this_encodeHeader (M2MCEPColumnStore *self)
+	{
+	//========== Variable ==========
+	size_t length = 0;
+	size_t position = 0;
+	unsigned int i = 0;
+	const size_t MAGIC_LENGTH = M2MString_length(M2MCEPColumnStore_FILE_MAGIC);
+
+	for (i=0, length=MAGIC_LENGTH+8; i<self->numberOfColumn; i++)
+		{
+		length += 5 + M2MString_length(self->columnName[i]);
+		}
+	self->buffer.length = 0;
+	self->buffer.bit = 0;
+	if (this_reserve(&(self->buffer), length)==true)
+		{
+		memcpy(self->buffer.data, M2MCEPColumnStore_FILE_MAGIC, MAGIC_LENGTH);
+		position = MAGIC_LENGTH;
+		this_writeUnsigned(self->buffer.data, &position, 4, self->numberOfColumn);
+		this_writeUnsigned(self->buffer.data, &position, 4, self->timeColumn);
+		for (i=0; i<self->numberOfColumn; i++)
+			{
+			this_writeUnsigned(self->buffer.data, &position, 1, (uint64_t)self->columnType[i]);
+			this_writeUnsigned(self->buffer.data, &position, 4, M2MString_length(self->columnName[i]));
+			memcpy(&(self->buffer.data[position]), self->columnName[i], M2MString_length(self->columnName[i]));
+			position += M2MString_length(self->columnName[i]);
+			}
+		self->buffer.length = position;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Returns the number of bits required for the unsigned integer.<br>
+ *
+ * @param[in] number	Unsigned integer
+ * @return				Number of bits (0 in case of 0)
+ */
+static unsigned int this_getBitLength (uint64_t number)
+	{
+	//========== Variable ==========
+	unsigned int length = 0;
+
+	for (length=0; number>0; length++)
+		{
+		number >>= 1;
+		}
+	return length;
+	}
+
+
+/**
+ * Returns the FNV-1a hash value of the data (for the dictionary).<br>
+ *
+ * @param[in] data		Data
+ * @param[in] length	Size of the data[Byte]
+ * @return				Hash value
+ */
+static uint32_t this_getHash (const unsigned char *data, const size_t length)
+	{
+	//========== Variable ==========
+	uint32_t hash = 2166136261U;
+	size_t i = 0;
+
+	for (i=0; i<length; i++)
+		{
+		hash = (hash ^ data[i]) * 16777619U;
+		}
+	return hash;
+	}
+
+
+/**
+ * Read the unsigned integer of "count" bits from the bit stream.<br>
+ *
+ * @param[in] data			Bit stream
+ * @param[in] length		Size of the bit stream[Byte]
+ * @param[in,out] position	Read position[bit] (advanced by "count")
+ * @param[in] count			Number of bits (<=64)
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the bit stream
+ */
+static bool this_readBits (const unsigned char *data, const size_t length, size_t *position, const unsigned int count, uint64_t *number)
+	{
+	//========== Variable ==========
+	unsigned int rest = count;
+	unsigned int available = 0;
+	unsigned int size = 0;
+
+	//===== Check the rest of the bit stream =====
+	if (count<=64 && (*position)<=length*8 && count<=length*8-(*position))
+		{
+		for ((*number)=0; rest>0; rest-=size)
+			{
+			available = 8 - ((*position) & 7);
+			size = (rest<available) ? rest : available;
+			(*number) = ((*number) << size) | ((data[(*position) >> 3] >> (available-size)) & ((1U << size) - 1));
+			(*position) += size;
+			}
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Read the block into the bit stream and verify its CRC-32.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @param[in] block		Entry of the block index
+ * @return				true: Succeed to read, false: Failed to read or broken block
+ */
+static bool this_readBlock (M2MCEPColumnStore *self, const M2MCEPColumnBlock *block)
+	{
+	//========== Variable ==========
+	size_t position = 8;
+	uint64_t crc = 0;
+	const size_t LENGTH = M2MCEPColumnStore_BLOCK_HEADER_LENGTH + (size_t)block->length;
+
+	self->buffer.length = 0;
+	self->buffer.bit = 0;
+	if (this_reserve(&(self->buffer), LENGTH)==true
+			&& pread(self->fileDescriptor, self->buffer.data, LENGTH, block->offset)==(ssize_t)LENGTH
+			&& this_readUnsigned(self->buffer.data, LENGTH, &position, 4, &crc)==true
+			&& (uint32_t)crc==M2MCRC32_getValue(&(self->buffer.data[M2MCEPColumnStore_BLOCK_HEADER_LENGTH]), (size_t)block->length))
+		{
+		self->buffer.length = LENGTH;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore.this_readBlock()", __LINE__, (M2MString *)"Failed to read the block of the column store file or the block is broken");
+		return false;
+		}
+	}
+
+
+/**
+ * Build the block index from the block headers following the file header <br>
+ * and cut off the broken block at the end of the file.<br>
+ *
+ * @param[in,out] self		Column store object
+ * @param[in] position		Position of the first block[Byte]
+ * @param[in] fileLength	Size of the file[Byte]
+ * @return					true: Succeed to read, false: Error
+ */
+static bool this_readIndex (M2MCEPColumnStore *self, off_t position, const off_t fileLength)
+	{
+	//========== Variable ==========
+	unsigned char header[M2MCEPColumnStore_BLOCK_HEADER_LENGTH];
+	size_t index = 0;
+	uint64_t magic = 0;
+	uint64_t length = 0;
+	uint64_t crc = 0;
+	uint64_t numberOfRecord = 0;
+	uint64_t minTime = 0;
+	uint64_t maxTime = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPColumnStore.this_readIndex()";
+
+	while (position+(off_t)M2MCEPColumnStore_BLOCK_HEADER_LENGTH<=fileLength
+			&& pread(self->fileDescriptor, header, sizeof(header), position)==(ssize_t)sizeof(header))
+		{
+		index = 0;
+		this_readUnsigned(header, sizeof(header), &index, 4, &magic);
+		this_readUnsigned(header, sizeof(header), &index, 4, &length);
+		this_readUnsigned(header, sizeof(header), &index, 4, &crc);
+		this_readUnsigned(header, sizeof(header), &index, 4, &numberOfRecord);
+		this_readUnsigned(header, sizeof(header), &index, 8, &minTime);
+		this_readUnsigned(header, sizeof(header), &index, 8, &maxTime);
+		//===== Broken block =====
+		if (magic!=M2MCEPColumnStore_BLOCK_MAGIC
+				|| numberOfRecord==0
+				|| (off_t)length>fileLength-position-(off_t)M2MCEPColumnStore_BLOCK_HEADER_LENGTH)
+			{
+			break;
+			}
+		else if (this_addBlock(self, position, (uint32_t)length, (uint32_t)numberOfRecord, (int64_t)minTime, (int64_t)maxTime)==false)
+			{
+			return false;
+			}
+		else
+			{
+			position += (off_t)M2MCEPColumnStore_BLOCK_HEADER_LENGTH + (off_t)length;
+			}
+		}
+	//===== Cut off the block broken by a crash =====
+	if (position<fileLength)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Cut off the broken block at the end of the column store file");
+		if (ftruncate(self->fileDescriptor, position)!=0)
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to truncate the column store file");
+			return false;
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	self->fileLength = position;
+	return true;
+	}
+
+
+/**
+ * Read the little endian unsigned integer from the buffer.<br>
+ *
+ * @param[in] buffer		Buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readUnsigned (const unsigned char *buffer, const size_t length, size_t *position, const size_t size, uint64_t *number)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+
+	//===== Check the rest of the buffer =====
+	if ((*position)<=length && size<=length-(*position))
+		{
+		(*number) = 0;
+		for (i=0; i<size; i++)
+			{
+			(*number) |= ((uint64_t)buffer[(*position)+i]) << (8*i);
+			}
+		(*position) += size;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Enlarge the bit stream so that "length" more bytes can be appended.<br>
+ *
+ * @param[in,out] buffer	Bit stream
+ * @param[in] length		Size to be appended[Byte]
+ * @return					true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_reserve (M2MCEPColumnBuffer *buffer, const size_t length)
+	{
+	//========== Variable ==========
+	unsigned char *data = NULL;
+	size_t capacity = 0;
+
+	//===== In case of enough space =====
+	if (buffer->length+length<=buffer->capacity)
+		{
+		return true;
+		}
+	//===== Double the buffer =====
+	else
+		{
+		for (capacity=(buffer->capacity>0) ? buffer->capacity : 4096; capacity<buffer->length+length; capacity*=2)
+			{
+			}
+		if ((data=(unsigned char *)M2MHeap_realloc(buffer->data, capacity))!=NULL)
+			{
+			buffer->data = data;
+			buffer->capacity = capacity;
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore.this_reserve()", __LINE__, (M2MString *)"Failed to allocate new memory for the block of the column store");
+			return false;
+			}
+		}
+	}
+
+
+/**
+ * Copy the value into the record waiting for the next block with converting <br>
+ * it into the type of the column.<br>
+ *
+ * @param[in] self			Column store object
+ * @param[in] column		Index of the column
+ * @param[in] value			Value of the inserted record
+ * @param[out] destination	Value of the waiting record (owns its string)
+ * @return					true: Succeed to copy, false: Failed to allocate
+ */
+static bool this_setValue (const M2MCEPColumnStore *self, const unsigned int column, const M2MCEPValue *value, M2MCEPValue *destination)
+	{
+	//========== Variable ==========
+	M2MString number[64];
+	const void *data = NULL;
+	unsigned char *copy = NULL;
+	size_t length = 0;
+	const M2MCEPValueType TYPE = self->columnType[column];
+
+	memset(destination, 0, sizeof(M2MCEPValue));
+	memset(number, 0, sizeof(number));
+	//===== NULL =====
+	if (value->type==M2MCEPValueType_NULL)
+		{
+		return true;
+		}
+	//===== Number converted from a string =====
+	else if ((TYPE==M2MCEPValueType_INTEGER || TYPE==M2MCEPValueType_REAL)
+			&& (value->type==M2MCEPValueType_TEXT || value->type==M2MCEPValueType_BLOB))
+		{
+		length = (value->length>=0) ? (size_t)value->length : M2MString_length(value->value.text);
+		memcpy(number, value->value.blob, (length<sizeof(number)) ? length : sizeof(number)-1);
+		destination->type = TYPE;
+		if (TYPE==M2MCEPValueType_INTEGER)
+			{
+			destination->value.integer = (int64_t)strtoll(number, NULL, 10);
+			}
+		else
+			{
+			destination->value.real = strtod(number, NULL);
+			}
+		return true;
+		}
+	//===== Number =====
+	else if (TYPE==M2MCEPValueType_INTEGER)
+		{
+		destination->type = TYPE;
+		destination->value.integer = (value->type==M2MCEPValueType_REAL) ? (int64_t)value->value.real : value->value.integer;
+		return true;
+		}
+	else if (TYPE==M2MCEPValueType_REAL)
+		{
+		destination->type = TYPE;
+		destination->value.real = (value->type==M2MCEPValueType_INTEGER) ? (double)value->value.integer : value->value.real;
+		return true;
+		}
+	//===== String or binary data (copied with '\0') =====
+	else
+		{
+		if (value->type==M2MCEPValueType_INTEGER)
+			{
+			snprintf(number, sizeof(number), "%lld", (long long)value->value.integer);
+			data = number;
+			length = M2MString_length(number);
+			}
+		else if (value->type==M2MCEPValueType_REAL)
+			{
+			snprintf(number, sizeof(number), "%.17g", value->value.real);
+			data = number;
+			length = M2MString_length(number);
+			}
+		else
+			{
+			data = value->value.blob;
+			length = (value->length>=0) ? (size_t)value->length : M2MString_length(value->value.text);
+			}
+		if (length<=INT_MAX && (copy=(unsigned char *)M2MHeap_malloc(length+1))!=NULL)
+			{
+			memcpy(copy, data, length);
+			destination->type = TYPE;
+			destination->value.blob = copy;
+			destination->length = (int)length;
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore.this_setValue()", __LINE__, (M2MString *)"Failed to allocate new memory for the value of the column store");
+			return false;
+			}
+		}
+	}
+
+
+/**
+ * Append the lower "count" bits of the unsigned integer to the bit stream.<br>
+ *
+ * @param[in,out] buffer	Bit stream
+ * @param[in] number		Unsigned integer
+ * @param[in] count			Number of bits (<=64)
+ * @return					true: Succeed to write, false: Failed to allocate
+ */
+static bool this_writeBits (M2MCEPColumnBuffer *buffer, const uint64_t number, const unsigned int count)
+	{
+	//========== Variable ==========
+	unsigned int rest = count;
+	unsigned int available = 0;
+	unsigned int size = 0;
+
+	if (this_reserve(buffer, (count+7)/8+1)==true)
+		{
+		for (; rest>0; rest-=size)
+			{
+			//===== Start a new byte =====
+			if (buffer->bit==0)
+				{
+				buffer->data[buffer->length++] = 0;
+				}
+			else
+				{
+				// do nothing
+				}
+			available = 8 - buffer->bit;
+			size = (rest<available) ? rest : available;
+			buffer->data[buffer->length-1] |= (unsigned char)(((number >> (rest-size)) & ((1U << size) - 1)) << (available-size));
+			buffer->bit = (buffer->bit + size) & 7;
+			}
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Encode the records waiting for the next block and write them into the <br>
+ * file as one block with one write() call and fsync().<br>
+ *
+ * @param[in,out] self	Column store object
+ * @return				true: Succeed to write, false: Error (the records are kept)
+ */
+static bool this_writeBlock (M2MCEPColumnStore *self)
+	{
+	//========== Variable ==========
+	const M2MCEPValue *time = NULL;
+	size_t position = 0;
+	size_t start = 0;
+	int64_t minTime = INT64_MAX;
+	int64_t maxTime = INT64_MIN;
+	unsigned int i = 0;
+	bool result = true;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPColumnStore.this_writeBlock()";
+
+	//===== Header is set after the chunks =====
+	self->buffer.length = 0;
+	self->buffer.bit = 0;
+	if ((result=this_reserve(&(self->buffer), M2MCEPColumnStore_BLOCK_HEADER_LENGTH))==true)
+		{
+		self->buffer.length = M2MCEPColumnStore_BLOCK_HEADER_LENGTH;
+		}
+	else
+		{
+		// do nothing
+		}
+	//===== Chunk of each column (length(u32) | bit stream) =====
+	for (i=0; i<self->numberOfColumn && result==true; i++)
+		{
+		start = self->buffer.length;
+		if ((result=this_reserve(&(self->buffer), 4))==true)
+			{
+			self->buffer.length += 4;
+			self->buffer.bit = 0;
+			result = this_encodeColumn(self, i);
+			self->buffer.bit = 0;
+			position = start;
+			this_writeUnsigned(self->buffer.data, &position, 4, (uint64_t)(self->buffer.length-start-4));
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== Minimum and maximum of the time column =====
+	for (i=0; i<self->numberOfRecord; i++)
+		{
+		time = &(self->record[i*self->numberOfColumn+self->timeColumn]);
+		if (time->type==M2MCEPValueType_INTEGER)
+			{
+			minTime = (time->value.integer<minTime) ? time->value.integer : minTime;
+			maxTime = (time->value.integer>maxTime) ? time->value.integer : maxTime;
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== Write the block =====
+	if (result==true && self->buffer.length-M2MCEPColumnStore_BLOCK_HEADER_LENGTH<=UINT32_MAX)
+		{
+		position = 0;
+		this_writeUnsigned(self->buffer.data, &position, 4, M2MCEPColumnStore_BLOCK_MAGIC);
+		this_writeUnsigned(self->buffer.data, &position, 4, (uint64_t)(self->buffer.length-M2MCEPColumnStore_BLOCK_HEADER_LENGTH));
+		this_writeUnsigned(self->buffer.data, &position, 4, (uint64_t)M2MCRC32_getValue(&(self->buffer.data[M2MCEPColumnStore_BLOCK_HEADER_LENGTH]), self->buffer.length-M2MCEPColumnStore_BLOCK_HEADER_LENGTH));
+		this_writeUnsigned(self->buffer.data, &position, 4, self->numberOfRecord);
+		this_writeUnsigned(self->buffer.data, &position, 8, (uint64_t)minTime);
+		this_writeUnsigned(self->buffer.data, &position, 8, (uint64_t)maxTime);
+		if (write(self->fileDescriptor, self->buffer.data, self->buffer.length)==(ssize_t)self->buffer.length
+				&& fsync(self->fileDescriptor)==0
+				&& this_addBlock(self, self->fileLength, (uint32_t)(self->buffer.length-M2MCEPColumnStore_BLOCK_HEADER_LENGTH), self->numberOfRecord, minTime, maxTime)==true)
+			{
+			self->fileLength += (off_t)self->buffer.length;
+			this_clearRecord(self);
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to write the block into the column store file");
+			if (ftruncate(self->fileDescriptor, self->fileLength)!=0)
+				{
+				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to truncate the column store file");
+				}
+			else
+				{
+				// do nothing
+				}
+			return false;
+			}
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to encode the block of the column store");
+		return false;
+		}
+	}
+
+
+/**
+ * Append the bytes to the bit stream from the next byte boundary.<br>
+ *
+ * @param[in,out] buffer	Bit stream
+ * @param[in] data			Bytes
+ * @param[in] length		Size of the bytes[Byte]
+ * @return					true: Succeed to write, false: Failed to allocate
+ */
+static bool this_writeBytes (M2MCEPColumnBuffer *buffer, const void *data, const size_t length)
+	{
+	if (this_reserve(buffer, length)==true)
+		{
+		memcpy(&(buffer->data[buffer->length]), data, length);
+		buffer->length += length;
+		buffer->bit = 0;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Write the unsigned integer in little endian into the buffer.<br>
+ *
+ * @param[out] buffer		Buffer (must have enough space)
+ * @param[in,out] position	Write position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[in] number		Integer
+ */
+static void this_writeUnsigned (unsigned char *buffer, size_t *position, const size_t size, const uint64_t number)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+
+	for (i=0; i<size; i++)
+		{
+		buffer[(*position)+i] = (unsigned char)((number >> (8*i)) & 0xFF);
+		}
+	(*position) += size;
+	return;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append one record to the column store (values are converted into the <br>
+ * types of the columns and copied). When "blockRecord" records are waiting, <br>
+ * they are written into the file as one block.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @param[in] record	Array of "numberOfColumn" values in the order of the columns
+ * @return				Column store object or NULL (in case of error)
+ */
+M2MCEPColumnStore *M2MCEPColumnStore_append (M2MCEPColumnStore *self, const M2MCEPValue *record)
+	{
+	//========== Variable ==========
+	M2MCEPValue *destination = NULL;
+	unsigned int i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPColumnStore_append()";
+
+	//===== Check argument =====
+	if (self!=NULL && record!=NULL)
+		{
+		//===== Retry the block which failed to be written =====
+		if (self->numberOfRecord>=self->blockRecord && this_writeBlock(self)==false)
+			{
+			return NULL;
+			}
+		else
+			{
+			destination = &(self->record[self->numberOfRecord*self->numberOfColumn]);
+			}
+		for (i=0; i<self->numberOfColumn; i++)
+			{
+			if (this_setValue(self, i, &(record[i]), &(destination[i]))==false)
+				{
+				//===== Release the copied values of the record =====
+				self->numberOfRecord++;
+				for (; i<self->numberOfColumn; i++)
+					{
+					destination[i].type = M2MCEPValueType_NULL;
+					}
+				this_clearRecord(self);
+				return NULL;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		self->numberOfRecord++;
+		//===== Write the full block =====
+		if (self->numberOfRecord>=self->blockRecord)
+			{
+			this_writeBlock(self);
+			}
+		else
+			{
+			// do nothing
+			}
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPColumnStore\" object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated record is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Write the waiting records, close the file and release the heap memory of <br>
+ * the column store object (the file is kept).<br>
+ *
+ * @param[in,out] self	Column store object
+ */
+void M2MCEPColumnStore_delete (M2MCEPColumnStore **self)
+	{
+	//========== Variable ==========
+	M2MCEPColumnBlock *block = NULL;
+	unsigned int i = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		if ((*self)->fileDescriptor>=0)
+			{
+			M2MCEPColumnStore_flush((*self));
+			close((*self)->fileDescriptor);
+			}
+		else
+			{
+			// do nothing
+			}
+		if ((*self)->record!=NULL)
+			{
+			this_clearRecord((*self));
+			M2MHeap_free((*self)->record);
+			}
+		else
+			{
+			// do nothing
+			}
+		while ((block=(*self)->block)!=NULL)
+			{
+			(*self)->block = block->next;
+			M2MHeap_free(block);
+			}
+		for (i=0; (*self)->columnName!=NULL && i<(*self)->numberOfColumn; i++)
+			{
+			M2MHeap_free((*self)->columnName[i]);
+			}
+		M2MHeap_free((*self)->columnName);
+		M2MHeap_free((*self)->columnType);
+		M2MHeap_free((*self)->buffer.data);
+		M2MHeap_free((*self)->filePath);
+		M2MHeap_free((*self)->tableName);
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Write the records waiting for the next block into the file as a (smaller) <br>
+ * block.<br>
+ *
+ * @param[in,out] self	Column store object
+ * @return				Column store object or NULL (in case of error)
+ */
+M2MCEPColumnStore *M2MCEPColumnStore_flush (M2MCEPColumnStore *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		if (self->numberOfRecord==0 || this_writeBlock(self)==true)
+			{
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore_flush()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPColumnStore\" object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the number of blocks written into the file.<br>
+ *
+ * @param[in] self	Column store object
+ * @return			Number of blocks
+ */
+unsigned int M2MCEPColumnStore_getBlockCount (const M2MCEPColumnStore *self)
+	{
+	//========== Variable ==========
+	const M2MCEPColumnBlock *block = NULL;
+	unsigned int count = 0;
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		for (block=self->block; block!=NULL; block=block->next)
+			{
+			count++;
+			}
+		return count;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore_getBlockCount()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPColumnStore\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the index of the column.<br>
+ *
+ * @param[in] self			Column store object
+ * @param[in] columnName	String indicating the column name
+ * @return					Index of the column or -1 (in case of unknown column)
+ */
+int M2MCEPColumnStore_getColumnIndex (const M2MCEPColumnStore *self, const M2MString *columnName)
+	{
+	//========== Variable ==========
+	unsigned int i = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && columnName!=NULL)
+		{
+		for (i=0; i<self->numberOfColumn; i++)
+			{
+			if (M2MString_length(self->columnName[i])==M2MString_length(columnName)
+					&& M2MString_compareTo(self->columnName[i], columnName)==0)
+				{
+				return (int)i;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		return -1;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore_getColumnIndex()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPColumnStore\" object or column name is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Returns the size of the column store file.<br>
+ *
+ * @param[in] self	Column store object
+ * @return			Size of the file[Byte]
+ */
+uint64_t M2MCEPColumnStore_getFileLength (const M2MCEPColumnStore *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return (uint64_t)self->fileLength;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPColumnStore_getFileLength()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPColumnStore\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Open the column store file of the table (created if it doesn't exist).<br>
+ * The columns of an existing file must match the indicated columns. A block <br>
+ * broken by a crash at the end of the file is cut off.<br>
+ *
+ * @param[in] filePath			Pathname of the column store file
+ * @param[in] tableName			String indicating the table name
+ * @param[in] columnName		Array of the column names
+ * @param[in] columnType		Array of the column types (INTEGER, REAL, TEXT or BLOB)
+ * @param[in] numberOfColumn	Number of columns
+ * @param[in] timeColumn		Index of the INTEGER column indicating the time of records
+ * @param[in] blockRecord		Number of records of one block (>0)
+ * @return						Created column store object or NULL (in case of error)
+ */
+M2MCEPColumnStore *M2MCEPColumnStore_new (const M2MString *filePath, const M2MString *tableName, M2MString *const *columnName, const M2MCEPValueType *columnType, const unsigned int numberOfColumn, const unsigned int timeColumn, const unsigned int blockRecord)
+	{
+	//========== Variable ==========
+	M2MCEPColumnStore *self = NULL;
+	unsigned char *header = NULL;
+	struct stat fileStatus;
+	unsigned int i = 0;
+	bool result = false;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPColumnStore_new()";
+
+	//===== Check argument =====
+	if (filePath!=NULL && M2MString_length(filePath)>0
+			&& tableName!=NULL && M2MString_length(tableName)>0
+			&& columnName!=NULL && columnType!=NULL && numberOfColumn>0
+			&& timeColumn<numberOfColumn && columnType[timeColumn]==M2MCEPValueType_INTEGER
+			&& blockRecord>0 && blockRecord<=UINT_MAX/numberOfColumn)
+		{
+		if ((self=(M2MCEPColumnStore *)M2MHeap_malloc(sizeof(M2MCEPColumnStore)))!=NULL
+				&& M2MString_append(&(self->filePath), filePath)!=NULL
+				&& M2MString_append(&(self->tableName), tableName)!=NULL
+				&& (self->columnName=(M2MString **)M2MHeap_calloc(numberOfColumn, sizeof(M2MString *)))!=NULL
+				&& (self->columnType=(M2MCEPValueType *)M2MHeap_calloc(numberOfColumn, sizeof(M2MCEPValueType)))!=NULL
+				&& (self->record=(M2MCEPValue *)M2MHeap_calloc((size_t)blockRecord*numberOfColumn, sizeof(M2MCEPValue)))!=NULL)
+			{
+			self->fileDescriptor = -1;
+			self->numberOfColumn = numberOfColumn;
+			self->timeColumn = timeColumn;
+			self->blockRecord = blockRecord;
+			for (i=0, result=true; i<numberOfColumn && result==true; i++)
+				{
+				self->columnType[i] = columnType[i];
+				result = (columnName[i]!=NULL && M2MString_append(&(self->columnName[i]), columnName[i])!=NULL
+						&& columnType[i]!=M2MCEPValueType_NULL && columnType[i]<=M2MCEPValueType_BLOB);
+				}
+			//===== Open the file and compare the header with the columns =====
+			if (result==true
+					&& this_encodeHeader(self)==true
+					&& (self->fileDescriptor=open(filePath, O_RDWR | O_CREAT | O_APPEND, 0644))>=0
+					&& fstat(self->fileDescriptor, &fileStatus)==0)
+				{
+				//===== New file =====
+				if (fileStatus.st_size==0)
+					{
+					result = (write(self->fileDescriptor, self->buffer.data, self->buffer.length)==(ssize_t)self->buffer.length
+							&& fsync(self->fileDescriptor)==0);
+					self->fileLength = (off_t)self->buffer.length;
+					}
+				//===== Existing file =====
+				else if ((off_t)self->buffer.length<=fileStatus.st_size
+						&& (header=(unsigned char *)M2MHeap_malloc(self->buffer.length))!=NULL
+						&& pread(self->fileDescriptor, header, self->buffer.length, 0)==(ssize_t)self->buffer.length
+						&& memcmp(header, self->buffer.data, self->buffer.length)==0)
+					{
+					result = this_readIndex(self, (off_t)self->buffer.length, fileStatus.st_size);
+					}
+				else
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The columns of the column store file don't match the table");
+					result = false;
+					}
+				M2MHeap_free(header);
+				}
+			else
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to open the column store file");
+				result = false;
+				}
+			}
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the column store");
+			result = false;
+			}
+		//===== Error handling =====
+		if (result==false)
+			{
+			M2MCEPColumnStore_delete(&self);
+			return NULL;
+			}
+		else
+			{
+			return self;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated file path, table name, columns, time column (must be INTEGER) or block record is invalid");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Give the records whose time is within the range to the callback in the <br>
+ * order of insertion (the records waiting for the next block included).<br>
+ * Only the blocks overlapping the range are read and only the indicated <br>
+ * columns are decoded (the chunks of the others are skipped).<br>
+ *
+ * @param[in,out] self			Column store object
+ * @param[in] from				Start of the time range
+ * @param[in] to				End of the time range (inclusive)
+ * @param[in] columnIndex		Array of the indexes of the columns given to the callback
+ * @param[in] numberOfIndex		Number of the indexes
+ * @param[in] callback			Callback receiving the records
+ * @param[in] userData			Pointer passed to the callback
+ * @return						Number of records given to the callback or -1 (in case of error)
+ */
+int M2MCEPColumnStore_scan (M2MCEPColumnStore *self, const int64_t from, const int64_t to, const unsigned int *columnIndex, const unsigned int numberOfIndex, const M2MCEPColumnStoreCallback callback, void *userData)
+	{
+	//========== Variable ==========
+	const M2MCEPColumnBlock *block = NULL;
+	const M2MCEPValue *time = NULL;
+	M2MCEPValue *row = NULL;
+	M2MCEPValue *values = NULL;
+	bool *required = NULL;
+	size_t capacity = 0;
+	size_t position = 0;
+	uint64_t number = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+	int count = 0;
+	bool result = true;
+	bool next = true;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPColumnStore_scan()";
+
+	//===== Check argument =====
+	if (self!=NULL && columnIndex!=NULL && numberOfIndex>0 && callback!=NULL)
+		{
+		if ((row=(M2MCEPValue *)M2MHeap_calloc(numberOfIndex, sizeof(M2MCEPValue)))!=NULL
+				&& (required=(bool *)M2MHeap_calloc(self->numberOfColumn, sizeof(bool)))!=NULL)
+			{
+			//===== Columns to be decoded =====
+			required[self->timeColumn] = true;
+			for (i=0; i<numberOfIndex && result==true; i++)
+				{
+				if ((result=(columnIndex[i]<self->numberOfColumn))==true)
+					{
+					required[columnIndex[i]] = true;
+					}
+				else
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated column index is out of the columns");
+					}
+				}
+			//===== Blocks overlapping the time range =====
+			for (block=self->block; block!=NULL && result==true && next==true; block=block->next)
+				{
+				if (block->maxTime<from || to<block->minTime)
+					{
+					continue;
+					}
+				//===== Read the block =====
+				else if (this_readBlock(self, block)==false)
+					{
+					continue;
+					}
+				//===== Enlarge the decoded columns =====
+				else if ((size_t)block->numberOfRecord*self->numberOfColumn>capacity)
+					{
+					M2MHeap_free(values);
+					capacity = (size_t)block->numberOfRecord * self->numberOfColumn;
+					if ((values=(M2MCEPValue *)M2MHeap_calloc(capacity, sizeof(M2MCEPValue)))==NULL)
+						{
+						M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the decoded columns");
+						result = false;
+						break;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				else
+					{
+					// do nothing
+					}
+				//===== Decode the required chunks and skip the others =====
+				for (i=0, position=M2MCEPColumnStore_BLOCK_HEADER_LENGTH; i<self->numberOfColumn && result==true; i++)
+					{
+					if ((result=this_readUnsigned(self->buffer.data, self->buffer.length, &position, 4, &number))==true
+							&& (result=(number<=(uint64_t)(self->buffer.length-position)))==true
+							&& required[i]==true)
+						{
+						result = this_decodeColumn(&(self->buffer.data[position]), (size_t)number, self->columnType[i], block->numberOfRecord, &(values[(size_t)i*block->numberOfRecord]));
+						}
+					else
+						{
+						// do nothing
+						}
+					position += (size_t)number;
+					}
+				if (result==false)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The block of the column store file is broken (skipped)");
+					result = true;
+					continue;
+					}
+				else
+					{
+					// do nothing
+					}
+				//===== Records within the time range =====
+				for (j=0; j<block->numberOfRecord && next==true; j++)
+					{
+					time = &(values[(size_t)self->timeColumn*block->numberOfRecord+j]);
+					if (time->type==M2MCEPValueType_INTEGER && from<=time->value.integer && time->value.integer<=to)
+						{
+						for (i=0; i<numberOfIndex; i++)
+							{
+							row[i] = values[(size_t)columnIndex[i]*block->numberOfRecord+j];
+							}
+						count++;
+						next = callback(row, numberOfIndex, userData);
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				}
+			//===== Records waiting for the next block =====
+			for (j=0; j<self->numberOfRecord && result==true && next==true; j++)
+				{
+				time = &(self->record[(size_t)j*self->numberOfColumn+self->timeColumn]);
+				if (time->type==M2MCEPValueType_INTEGER && from<=time->value.integer && time->value.integer<=to)
+					{
+					for (i=0; i<numberOfIndex; i++)
+						{
+						row[i] = self->record[(size_t)j*self->numberOfColumn+columnIndex[i]];
+						}
+					count++;
+					next = callback(row, numberOfIndex, userData);
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			}
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the scan");
+			result = false;
+			}
+		M2MHeap_free(row);
+		M2MHeap_free(required);
+		M2MHeap_free(values);
+		return (result==true) ? count : -1;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPColumnStore\" object, column indexes or callback is NULL");
+		return -1;
+		}
+	}
+
+
+
+/* End Of File */
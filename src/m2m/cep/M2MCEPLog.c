@@ -0,0 +1,1197 @@
+/*******************************************************************************
+ * M2MCEPLog.c : Segmented write-ahead log of records inserted into CEP
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPLog.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Create the pathname string of the segment file.<br>
+ * Caller must release the string with M2MHeap_free().<br>
+ *
+ * @param[in] self			Log object
+ * @param[in] segment		Number of the segment file
+ * @param[out] filePath		Buffer to store the created pathname string
+ * @return					Pathname string of the segment file or NULL (in case of error)
+ */
+static M2MString *this_createFilePath (const M2MCEPLog *self, const uint32_t segment, M2MString **filePath);
+
+
+/**
+ * Get the number of the segment file from the file name ("%010u.log").<br>
+ *
+ * @param[in] fileName	String indicating the file name
+ * @param[out] segment	Buffer to store the number of the segment file
+ * @return				true: the file is a segment file, false: other file
+ */
+static bool this_getSegmentNumber (const M2MString *fileName, uint32_t *segment);
+
+
+/**
+ * Open the current segment file (it's created with the first entry).<br>
+ *
+ * @param[in,out] self	Log object
+ * @return				Log object or NULL (in case of error)
+ */
+static M2MCEPLog *this_open (M2MCEPLog *self);
+
+
+/**
+ * Read the little endian unsigned integer from the buffer.<br>
+ *
+ * @param[in] buffer		Buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readUnsigned (const unsigned char *buffer, const size_t length, size_t *position, const size_t size, uint64_t *number);
+
+
+/**
+ * Decode the payload of one entry and give it to the handler.<br>
+ *
+ * @param[in] payload	Payload of the entry
+ * @param[in] length	Size of the payload[Byte]
+ * @param[in] handler	Handler receiving the entry
+ * @param[in] userData	Pointer passed to the handler
+ * @return				true: Succeed to decode, false: Broken payload or error
+ */
+static bool this_replayEntry (const unsigned char *payload, const size_t length, const M2MCEPLogHandler handler, void *userData);
+
+
+/**
+ * Enlarge the buffer encoding one entry.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] length	Size of the entry[Byte]
+ * @return				true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_reserve (M2MCEPLog *self, const size_t length);
+
+
+/**
+ * Synchronize the directory of the segment files so that a created or <br>
+ * removed segment file survives a crash of the OS.<br>
+ *
+ * @param[in] self	Log object
+ */
+static void this_syncDirectory (const M2MCEPLog *self);
+
+
+/**
+ * Set the header (length and CRC-32) of the payload encoded in the buffer and <br>
+ * write the entry into the current segment file with one write() call.<br>
+ * If the entry can't be written entirely, the following entries are written <br>
+ * into the next segment file so that they aren't hidden by the broken entry.<br>
+ *
+ * @param[in,out] self			Log object
+ * @param[in] payloadLength		Size of the payload following the header in the buffer[Byte]
+ * @return						Size of the written entry[Byte] or 0 (in case of error)
+ */
+static size_t this_write (M2MCEPLog *self, const size_t payloadLength);
+
+
+/**
+ * Write the unsigned integer in little endian into the buffer.<br>
+ *
+ * @param[out] buffer		Buffer (must have enough space)
+ * @param[in,out] position	Write position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[in] number		Integer
+ */
+static void this_writeUnsigned (unsigned char *buffer, size_t *position, const size_t size, const uint64_t number);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Create the pathname string of the segment file.<br>
+ * Caller must release the string with M2MHeap_free().<br>
+ *
+ * @param[in] self			Log object
+ * @param[in] segment		Number of the segment file
+ * @param[out] filePath		Buffer to store the created pathname string
+ * @return					Pathname string of the segment file or NULL (in case of error)
+ */
+static M2MString *this_createFilePath (const M2MCEPLog *self, const uint32_t segment, M2MString **filePath)
+	{
+	//========== Variable ==========
+	M2MString FILE_NAME[32];
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPLog.this_createFilePath()";
+
+	//===== Check argument =====
+	if (self!=NULL && filePath!=NULL)
+		{
+		memset(FILE_NAME, 0, sizeof(FILE_NAME));
+		snprintf(FILE_NAME, sizeof(FILE_NAME)-1, (M2MString *)"%010u%s", (unsigned int)segment, M2MCEPLog_FILE_EXTENSION);
+		//===== Join the directory and the file name =====
+		if (M2MString_append(filePath, self->directoryPath)!=NULL
+				&& M2MString_append(filePath, M2MDirectory_SEPARATOR)!=NULL
+				&& M2MString_append(filePath, FILE_NAME)!=NULL)
+			{
+			return (*filePath);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MHeap_free((*filePath));
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the pathname of the segment file");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object or \"filePath\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the number of the segment file from the file name ("%010u.log").<br>
+ *
+ * @param[in] fileName	String indicating the file name
+ * @param[out] segment	Buffer to store the number of the segment file
+ * @return				true: the file is a segment file, false: other file
+ */
+static bool this_getSegmentNumber (const M2MString *fileName, uint32_t *segment)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+	uint64_t number = 0;
+	const size_t DIGIT = 10;
+
+	//===== Check the length and the extension of the file name =====
+	if (fileName!=NULL && segment!=NULL
+			&& M2MString_length(fileName)==DIGIT+M2MString_length(M2MCEPLog_FILE_EXTENSION)
+			&& M2MString_compareTo(&(fileName[DIGIT]), M2MCEPLog_FILE_EXTENSION)==0)
+		{
+		for (i=0; i<DIGIT; i++)
+			{
+			if (fileName[i]>='0' && fileName[i]<='9')
+				{
+				number = number * 10 + (uint64_t)(fileName[i] - '0');
+				}
+			else
+				{
+				return false;
+				}
+			}
+		//===== Segment files are numbered from 1 =====
+		if (number>0 && number<=UINT32_MAX)
+			{
+			(*segment) = (uint32_t)number;
+			return true;
+			}
+		else
+			{
+			return false;
+			}
+		}
+	//===== Other file =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Open the current segment file (it's created with the first entry).<br>
+ *
+ * @param[in,out] self	Log object
+ * @return				Log object or NULL (in case of error)
+ */
+static M2MCEPLog *this_open (M2MCEPLog *self)
+	{
+	//========== Variable ==========
+	M2MString *filePath = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPLog.this_open()";
+
+	//===== In case of the open segment file =====
+	if (self->file!=NULL)
+		{
+		return self;
+		}
+	//===== Create the segment file =====
+	else if (this_createFilePath(self, self->segment, &filePath)!=NULL
+			&& (self->file=M2MFile_new(filePath))!=NULL
+			&& M2MFile_open(self->file)!=NULL)
+		{
+		M2MHeap_free(filePath);
+		self->segmentLength = (size_t)M2MFile_length(self->file);
+		self->unsyncedRecord = 0;
+		this_syncDirectory(self);
+		return self;
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to open the segment file of the log");
+		if (self->file!=NULL)
+			{
+			M2MFile_delete(&(self->file));
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MHeap_free(filePath);
+		return NULL;
+		}
+	}
+
+
+/**
+ * Read the little endian unsigned integer from the buffer.<br>
+ *
+ * @param[in] buffer		Buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readUnsigned (const unsigned char *buffer, const size_t length, size_t *position, const size_t size, uint64_t *number)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+
+	//===== Check the rest of the buffer =====
+	if ((*position)<=length && size<=length-(*position))
+		{
+		(*number) = 0;
+		for (i=0; i<size; i++)
+			{
+			(*number) |= ((uint64_t)buffer[(*position)+i]) << (8*i);
+			}
+		(*position) += size;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Decode the payload of one entry and give it to the handler.<br>
+ *
+ * @param[in] payload	Payload of the entry
+ * @param[in] length	Size of the payload[Byte]
+ * @param[in] handler	Handler receiving the entry
+ * @param[in] userData	Pointer passed to the handler
+ * @return				true: Succeed to decode, false: Broken payload or error
+ */
+static bool this_replayEntry (const unsigned char *payload, const size_t length, const M2MCEPLogHandler handler, void *userData)
+	{
+	//========== Variable ==========
+	const unsigned char *tableNameEnd = NULL;
+	M2MCEPValue *values = NULL;
+	uint64_t sequence = 0;
+	uint64_t rows = 0;
+	uint64_t columns = 0;
+	uint64_t number = 0;
+	size_t position = 0;
+	size_t i = 0;
+	bool result = true;
+
+	//===== Get the table name terminated by '\0' =====
+	if (length<3 || (tableNameEnd=(const unsigned char *)memchr(&(payload[1]), '\0', length-1))==NULL
+			|| tableNameEnd==&(payload[1]))
+		{
+		return false;
+		}
+	else
+		{
+		position = (size_t)(tableNameEnd - payload) + 1;
+		}
+	//===== Get the sequence number of the first record =====
+	if (this_readUnsigned(payload, length, &position, 8, &sequence)==false)
+		{
+		return false;
+		}
+	//===== In case of CSV string =====
+	else if (payload[0]==(unsigned char)'C' && position<length && payload[length-1]=='\0')
+		{
+		handler((const M2MString *)&(payload[1]), (int64_t)sequence, (const M2MString *)&(payload[position]), NULL, 0, 0, userData);
+		return true;
+		}
+	//===== In case of typed values (each value takes 1 byte at least) =====
+	else if (payload[0]==(unsigned char)'R'
+			&& this_readUnsigned(payload, length, &position, 4, &rows)==true
+			&& this_readUnsigned(payload, length, &position, 4, &columns)==true
+			&& rows>0 && columns>0 && rows*columns<=(uint64_t)(length-position)
+			&& (values=(M2MCEPValue *)M2MHeap_calloc((size_t)(rows*columns), sizeof(M2MCEPValue)))!=NULL)
+		{
+		for (i=0; i<rows*columns && result==true; i++)
+			{
+			if ((result=this_readUnsigned(payload, length, &position, 1, &number))==false)
+				{
+				break;
+				}
+			else
+				{
+				values[i].type = (M2MCEPValueType)number;
+				}
+			//===== Read the value of the type =====
+			if (values[i].type==M2MCEPValueType_INTEGER)
+				{
+				result = this_readUnsigned(payload, length, &position, 8, &number);
+				values[i].value.integer = (int64_t)number;
+				}
+			else if (values[i].type==M2MCEPValueType_REAL)
+				{
+				result = this_readUnsigned(payload, length, &position, 8, &number);
+				memcpy(&(values[i].value.real), &number, sizeof(double));
+				}
+			else if (values[i].type==M2MCEPValueType_TEXT || values[i].type==M2MCEPValueType_BLOB)
+				{
+				if ((result=this_readUnsigned(payload, length, &position, 4, &number))==true
+						&& (result=(number<=(uint64_t)(length-position) && number<=INT_MAX))==true)
+					{
+					values[i].value.blob = &(payload[position]);
+					values[i].length = (int)number;
+					position += (size_t)number;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			else if (values[i].type!=M2MCEPValueType_NULL)
+				{
+				result = false;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		//===== Give the records to the handler =====
+		if (result==true && position==length)
+			{
+			handler((const M2MString *)&(payload[1]), (int64_t)sequence, NULL, values, (size_t)rows, (size_t)columns, userData);
+			}
+		else
+			{
+			result = false;
+			}
+		M2MHeap_free(values);
+		return result;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Enlarge the buffer encoding one entry.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] length	Size of the entry[Byte]
+ * @return				true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_reserve (M2MCEPLog *self, const size_t length)
+	{
+	//========== Variable ==========
+	unsigned char *buffer = NULL;
+	size_t capacity = 0;
+
+	//===== In case of enough space =====
+	if (length<=self->bufferCapacity)
+		{
+		return true;
+		}
+	//===== Double the buffer =====
+	else
+		{
+		for (capacity=(self->bufferCapacity>0) ? self->bufferCapacity : 256; capacity<length; capacity*=2)
+			{
+			}
+		if ((buffer=(unsigned char *)M2MHeap_realloc(self->buffer, capacity))!=NULL)
+			{
+			self->buffer = buffer;
+			self->bufferCapacity = capacity;
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, (M2MString *)"M2MCEPLog.this_reserve()", __LINE__, (M2MString *)"Failed to allocate new memory for the entry of the log");
+			return false;
+			}
+		}
+	}
+
+
+/**
+ * Synchronize the directory of the segment files so that a created or <br>
+ * removed segment file survives a crash of the OS.<br>
+ *
+ * @param[in] self	Log object
+ */
+static void this_syncDirectory (const M2MCEPLog *self)
+	{
+	//========== Variable ==========
+	int directory = -1;
+
+	if ((directory=open(self->directoryPath, O_RDONLY))>=0)
+		{
+		fsync(directory);
+		close(directory);
+		}
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Set the header (length and CRC-32) of the payload encoded in the buffer and <br>
+ * write the entry into the current segment file with one write() call.<br>
+ * If the entry can't be written entirely, the following entries are written <br>
+ * into the next segment file so that they aren't hidden by the broken entry.<br>
+ *
+ * @param[in,out] self			Log object
+ * @param[in] payloadLength		Size of the payload following the header in the buffer[Byte]
+ * @return						Size of the written entry[Byte] or 0 (in case of error)
+ */
+static size_t this_write (M2MCEPLog *self, const size_t payloadLength)
+	{
+	//========== Variable ==========
+	size_t position = 0;
+	const size_t ENTRY_LENGTH = M2MCEPLog_HEADER_LENGTH + payloadLength;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPLog.this_write()";
+
+	//===== Check the size of the payload =====
+	if (payloadLength<=UINT32_MAX)
+		{
+		this_writeUnsigned(self->buffer, &position, 4, (uint64_t)payloadLength);
+		this_writeUnsigned(self->buffer, &position, 4, (uint64_t)M2MCRC32_getValue(&(self->buffer[M2MCEPLog_HEADER_LENGTH]), payloadLength));
+		//===== Write the entry =====
+		if (this_open(self)!=NULL
+				&& M2MFile_write(self->file, self->buffer, ENTRY_LENGTH)==ENTRY_LENGTH)
+			{
+			self->segmentLength += ENTRY_LENGTH;
+			self->unsyncedRecord++;
+			//===== Batched fsync() =====
+			if (self->syncRecord>0 && self->unsyncedRecord>=self->syncRecord)
+				{
+				M2MCEPLog_sync(self);
+				}
+			else
+				{
+				// do nothing
+				}
+			return ENTRY_LENGTH;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to write the entry into the segment file of the log");
+			M2MCEPLog_rotate(self);
+			return 0;
+			}
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The entry is too large for the log");
+		return 0;
+		}
+	}
+
+
+/**
+ * Write the unsigned integer in little endian into the buffer.<br>
+ *
+ * @param[out] buffer		Buffer (must have enough space)
+ * @param[in,out] position	Write position (advanced by "size")
+ * @param[in] size			Size of the integer (1, 4 or 8)[Byte]
+ * @param[in] number		Integer
+ */
+static void this_writeUnsigned (unsigned char *buffer, size_t *position, const size_t size, const uint64_t number)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+
+	for (i=0; i<size; i++)
+		{
+		buffer[(*position)+i] = (unsigned char)((number >> (8*i)) & 0xFF);
+		}
+	(*position) += size;
+	return;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append the CSV format string inserted into the table to the current <br>
+ * segment file.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] sequence	Sequence number of the first record in the table
+ * @param[in] csv		String in CSV format (the first line specifies the column name as a header)
+ * @return				Size of the written entry[Byte] or 0 (in case of error)
+ */
+size_t M2MCEPLog_appendCSV (M2MCEPLog *self, const M2MString *tableName, const int64_t sequence, const M2MString *csv)
+	{
+	//========== Variable ==========
+	size_t tableNameLength = 0;
+	size_t csvLength = 0;
+	size_t position = M2MCEPLog_HEADER_LENGTH;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPLog_appendCSV()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && (tableNameLength=M2MString_length(tableName))>0
+			&& csv!=NULL && (csvLength=M2MString_length(csv))>0)
+		{
+		//===== Encode the payload ('C' | table name | '\0' | sequence | CSV | '\0') =====
+		if (this_reserve(self, position+tableNameLength+csvLength+3+8)==true)
+			{
+			self->buffer[position++] = (unsigned char)'C';
+			memcpy(&(self->buffer[position]), tableName, tableNameLength);
+			position += tableNameLength;
+			self->buffer[position++] = '\0';
+			this_writeUnsigned(self->buffer, &position, 8, (uint64_t)sequence);
+			memcpy(&(self->buffer[position]), csv, csvLength);
+			position += csvLength;
+			self->buffer[position++] = '\0';
+			return this_write(self, position-M2MCEPLog_HEADER_LENGTH);
+			}
+		//===== Error handling =====
+		else
+			{
+			return 0;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return 0;
+		}
+	else if (tableName==NULL || tableNameLength==0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return 0;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated CSV string is NULL or vacant");
+		return 0;
+		}
+	}
+
+
+/**
+ * Append the typed values of the records inserted into the table to the <br>
+ * current segment file.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] sequence	Sequence number of the first record in the table
+ * @param[in] values	Array of typed values of "rows" * "columns" in row-major order
+ * @param[in] rows		Number of records
+ * @param[in] columns	Number of values per record
+ * @return				Size of the written entry[Byte] or 0 (in case of error)
+ */
+size_t M2MCEPLog_appendRecords (M2MCEPLog *self, const M2MString *tableName, const int64_t sequence, const M2MCEPValue *values, const size_t rows, const size_t columns)
+	{
+	//========== Variable ==========
+	size_t tableNameLength = 0;
+	size_t length = 0;
+	size_t position = M2MCEPLog_HEADER_LENGTH;
+	size_t i = 0;
+	uint64_t number = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPLog_appendRecords()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && (tableNameLength=M2MString_length(tableName))>0
+			&& values!=NULL && rows>0 && rows<=UINT32_MAX && columns>0 && columns<=UINT32_MAX)
+		{
+		//===== Measure the payload =====
+		length = position + 1 + tableNameLength + 1 + 8 + 8;
+		for (i=0; i<rows*columns; i++)
+			{
+			if (values[i].type==M2MCEPValueType_INTEGER || values[i].type==M2MCEPValueType_REAL)
+				{
+				length += 1 + 8;
+				}
+			else if (values[i].type==M2MCEPValueType_TEXT && values[i].value.text!=NULL)
+				{
+				length += 1 + 4 + ((values[i].length<0) ? M2MString_length(values[i].value.text) : (size_t)values[i].length);
+				}
+			else if (values[i].type==M2MCEPValueType_BLOB && values[i].value.blob!=NULL && values[i].length>=0)
+				{
+				length += 1 + 4 + (size_t)values[i].length;
+				}
+			else
+				{
+				length += 1;
+				}
+			}
+		//===== Encode the payload ('R' | table name | '\0' | sequence | rows | columns | values) =====
+		if (this_reserve(self, length)==true)
+			{
+			self->buffer[position++] = (unsigned char)'R';
+			memcpy(&(self->buffer[position]), tableName, tableNameLength);
+			position += tableNameLength;
+			self->buffer[position++] = '\0';
+			this_writeUnsigned(self->buffer, &position, 8, (uint64_t)sequence);
+			this_writeUnsigned(self->buffer, &position, 4, (uint64_t)rows);
+			this_writeUnsigned(self->buffer, &position, 4, (uint64_t)columns);
+			for (i=0; i<rows*columns; i++)
+				{
+				if (values[i].type==M2MCEPValueType_INTEGER)
+					{
+					this_writeUnsigned(self->buffer, &position, 1, (uint64_t)M2MCEPValueType_INTEGER);
+					this_writeUnsigned(self->buffer, &position, 8, (uint64_t)values[i].value.integer);
+					}
+				else if (values[i].type==M2MCEPValueType_REAL)
+					{
+					memcpy(&number, &(values[i].value.real), sizeof(double));
+					this_writeUnsigned(self->buffer, &position, 1, (uint64_t)M2MCEPValueType_REAL);
+					this_writeUnsigned(self->buffer, &position, 8, number);
+					}
+				else if ((values[i].type==M2MCEPValueType_TEXT && values[i].value.text!=NULL)
+						|| (values[i].type==M2MCEPValueType_BLOB && values[i].value.blob!=NULL && values[i].length>=0))
+					{
+					length = (values[i].length<0) ? M2MString_length(values[i].value.text) : (size_t)values[i].length;
+					this_writeUnsigned(self->buffer, &position, 1, (uint64_t)values[i].type);
+					this_writeUnsigned(self->buffer, &position, 4, (uint64_t)length);
+					memcpy(&(self->buffer[position]), values[i].value.blob, length);
+					position += length;
+					}
+				//===== NULL (also in place of a value which can't be bound) =====
+				else
+					{
+					this_writeUnsigned(self->buffer, &position, 1, (uint64_t)M2MCEPValueType_NULL);
+					}
+				}
+			return this_write(self, position-M2MCEPLog_HEADER_LENGTH);
+			}
+		//===== Error handling =====
+		else
+			{
+			return 0;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return 0;
+		}
+	else if (tableName==NULL || tableNameLength==0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return 0;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated typed values are NULL or the number of records or values is out of range");
+		return 0;
+		}
+	}
+
+
+/**
+ * Synchronize and close the current segment file and release the heap memory <br>
+ * of the log object (the segment files are kept).<br>
+ *
+ * @param[in,out] self	Log object
+ */
+void M2MCEPLog_delete (M2MCEPLog **self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		if ((*self)->file!=NULL)
+			{
+			M2MCEPLog_sync((*self));
+			M2MFile_delete(&((*self)->file));
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MHeap_free((*self)->buffer);
+		M2MHeap_free((*self)->directoryPath);
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Returns the number of the oldest segment file.<br>
+ *
+ * @param[in] self	Log object
+ * @return			Number of the oldest segment file (equal to the current one if no older file exists)
+ */
+uint32_t M2MCEPLog_getFirstSegment (const M2MCEPLog *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->firstSegment;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPLog_getFirstSegment()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the number of the current segment file (the file entries are <br>
+ * appended to).<br>
+ *
+ * @param[in] self	Log object
+ * @return			Number of the current segment file or 0 (in case of error)
+ */
+uint32_t M2MCEPLog_getSegment (const M2MCEPLog *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->segment;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPLog_getSegment()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the size written into the current segment file.<br>
+ *
+ * @param[in] self	Log object
+ * @return			Size written into the current segment file[Byte]
+ */
+size_t M2MCEPLog_getSegmentLength (const M2MCEPLog *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->segmentLength;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPLog_getSegmentLength()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns whether the current segment file reached the segment size.<br>
+ *
+ * @param[in] self	Log object
+ * @return			true: the log should be rotated, false: not yet
+ */
+bool M2MCEPLog_isFull (const M2MCEPLog *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return (self->file!=NULL && self->segmentLength>=self->segmentSize);
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPLog_isFull()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return false;
+		}
+	}
+
+
+/**
+ * Create a new log object on the directory.<br>
+ * Existing segment files are kept for M2MCEPLog_replay() and the entries are <br>
+ * appended to a new segment file following the last one.<br>
+ *
+ * @param[in] directoryPath	Directory of the segment files (created if it doesn't exist)
+ * @param[in] segmentSize	Size of one segment file[Byte] (>0)
+ * @param[in] syncRecord	Number of entries between two fsync() (1: every entry, 0: at rotation only)
+ * @return					Created log object or NULL (in case of error)
+ */
+M2MCEPLog *M2MCEPLog_new (const M2MString *directoryPath, const size_t segmentSize, const unsigned int syncRecord)
+	{
+	//========== Variable ==========
+	M2MCEPLog *self = NULL;
+	M2MList *fileNameList = NULL;
+	M2MList *node = NULL;
+	uint32_t segment = 0;
+	uint32_t firstSegment = UINT32_MAX;
+	uint32_t lastSegment = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPLog_new()";
+
+	//===== Check argument =====
+	if (directoryPath!=NULL && M2MString_length(directoryPath)>0 && segmentSize>0)
+		{
+		//===== Create the directory of the segment files =====
+		if (M2MDirectory_mkdirs(directoryPath, M2MSQLite_DATABASE_DIRECTORY_PERMISSION)==true
+				&& (self=(M2MCEPLog *)M2MHeap_malloc(sizeof(M2MCEPLog)))!=NULL
+				&& M2MString_append(&(self->directoryPath), directoryPath)!=NULL)
+			{
+			//===== Search the existing segment files =====
+			if ((fileNameList=M2MDirectory_listFiles(directoryPath))!=NULL)
+				{
+				for (node=M2MList_begin(fileNameList); node!=NULL; node=node->next)
+					{
+					if (this_getSegmentNumber((M2MString *)M2MList_getValue(node), &segment)==true)
+						{
+						firstSegment = (segment<firstSegment) ? segment : firstSegment;
+						lastSegment = (segment>lastSegment) ? segment : lastSegment;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				M2MList_delete(fileNameList);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Entries are appended after the existing segment files =====
+			self->segment = lastSegment + 1;
+			self->firstSegment = (firstSegment<=lastSegment) ? firstSegment : self->segment;
+			self->segmentSize = segmentSize;
+			self->syncRecord = syncRecord;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create the directory of the segment files");
+			M2MCEPLog_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (directoryPath==NULL || M2MString_length(directoryPath)<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated directory path string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated segment size is 0");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Remove the segment files older than the indicated number (the current <br>
+ * segment file is never removed).<br>
+ * If no entry was appended to the current segment file yet, the following <br>
+ * entries are appended to the indicated segment at least.<br>
+ *
+ * @param[in,out] self	Log object
+ * @param[in] segment	Number of the oldest segment file to be kept
+ * @return				Number of removed segment files or -1 (in case of error)
+ */
+int M2MCEPLog_remove (M2MCEPLog *self, const uint32_t segment)
+	{
+	//========== Variable ==========
+	M2MString *filePath = NULL;
+	M2MFile *file = NULL;
+	int numberOfFile = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPLog_remove()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Remove the segment files in the oldest order =====
+		while (self->firstSegment<segment && self->firstSegment<self->segment)
+			{
+			if (this_createFilePath(self, self->firstSegment, &filePath)!=NULL
+					&& (file=M2MFile_new(filePath))!=NULL)
+				{
+				if (M2MFile_exists(file)==true)
+					{
+					M2MFile_remove(file);
+					numberOfFile++;
+					}
+				else
+					{
+					// do nothing
+					}
+				M2MFile_delete(&file);
+				M2MHeap_free(filePath);
+				self->firstSegment++;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MHeap_free(filePath);
+				return -1;
+				}
+			}
+		//===== Skip the numbers of the removed segment files =====
+		if (self->file==NULL && self->segment<segment)
+			{
+			self->segment = segment;
+			self->firstSegment = segment;
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Make the removal durable =====
+		if (numberOfFile>0)
+			{
+			this_syncDirectory(self);
+			}
+		else
+			{
+			// do nothing
+			}
+		return numberOfFile;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Read the entries of the segment file and give them to the handler in order.<br>
+ * Reading stops at the first entry which is truncated or doesn't match its <br>
+ * CRC-32 (torn write by a crash).<br>
+ *
+ * @param[in] self		Log object
+ * @param[in] segment	Number of the segment file (older than the current one)
+ * @param[in] handler	Handler receiving the entries
+ * @param[in] userData	Pointer passed to the handler
+ * @return				Number of replayed entries or -1 (in case of error)
+ */
+int M2MCEPLog_replay (const M2MCEPLog *self, const uint32_t segment, const M2MCEPLogHandler handler, void *userData)
+	{
+	//========== Variable ==========
+	M2MString *filePath = NULL;
+	M2MFile *file = NULL;
+	unsigned char *data = NULL;
+	size_t length = 0;
+	size_t position = 0;
+	uint64_t payloadLength = 0;
+	uint64_t crc = 0;
+	int numberOfEntry = 0;
+	M2MString MESSAGE[256];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPLog_replay()";
+
+	//===== Check argument =====
+	if (self!=NULL && handler!=NULL && segment<self->segment)
+		{
+		//===== Read the whole segment file =====
+		if (this_createFilePath(self, segment, &filePath)!=NULL
+				&& (file=M2MFile_new(filePath))!=NULL)
+			{
+			if (M2MFile_exists(file)==true)
+				{
+				length = (size_t)M2MFile_read(file, &data);
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MFile_delete(&file);
+			M2MHeap_free(filePath);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MHeap_free(filePath);
+			return -1;
+			}
+		//===== Repeat while the entries are whole =====
+		while (this_readUnsigned(data, length, &position, 4, &payloadLength)==true
+				&& this_readUnsigned(data, length, &position, 4, &crc)==true
+				&& payloadLength<=(uint64_t)(length-position)
+				&& (uint64_t)M2MCRC32_getValue(&(data[position]), (size_t)payloadLength)==crc
+				&& this_replayEntry(&(data[position]), (size_t)payloadLength, handler, userData)==true)
+			{
+			position += (size_t)payloadLength;
+			numberOfEntry++;
+			}
+		//===== In case of a torn entry =====
+		if (position<length)
+			{
+			memset(MESSAGE, 0, sizeof(MESSAGE));
+			snprintf(MESSAGE, sizeof(MESSAGE)-1, (M2MString *)"Replay of the segment file \"%u\" stopped at a broken entry (\"%zu\" bytes are ignored)", (unsigned int)segment, length-position);
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, MESSAGE);
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MHeap_free(data);
+		return numberOfEntry;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return -1;
+		}
+	else if (handler==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated handler is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated segment isn't older than the current one");
+		return -1;
+		}
+	}
+
+
+/**
+ * Synchronize and close the current segment file; the following entries are <br>
+ * appended to the next segment file.<br>
+ * Nothing is done if no entry was appended to the current segment file.<br>
+ *
+ * @param[in,out] self	Log object
+ * @return				Log object or NULL (in case of error)
+ */
+M2MCEPLog *M2MCEPLog_rotate (M2MCEPLog *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		if (self->file!=NULL)
+			{
+			M2MCEPLog_sync(self);
+			M2MFile_delete(&(self->file));
+			self->segment++;
+			self->segmentLength = 0;
+			}
+		else
+			{
+			// do nothing
+			}
+		return self;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPLog_rotate()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Synchronize the entries written into the current segment file with the <br>
+ * storage device (fsync()).<br>
+ *
+ * @param[in,out] self	Log object
+ * @return				Log object or NULL (in case of error)
+ */
+M2MCEPLog *M2MCEPLog_sync (M2MCEPLog *self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPLog_sync()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== In case of entries not synchronized =====
+		if (self->file!=NULL && self->unsyncedRecord>0)
+			{
+			if (fsync(M2MFile_getFileDescriptor(self->file))==0)
+				{
+				self->unsyncedRecord = 0;
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to synchronize the segment file of the log");
+				return NULL;
+				}
+			}
+		else
+			{
+			return self;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPLog\" object is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
@@ -0,0 +1,569 @@
+/*******************************************************************************
+ * M2MCEPPartition.c : Time-partitioned SQLite3 database files of CEP history
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPPartition.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Compare the start times of two partitions (for qsort()).<br>
+ *
+ * @param[in] one		Pointer of the start time
+ * @param[in] another	Pointer of the other start time
+ * @return				Negative, 0 or positive number in ascending order
+ */
+static int this_compareStartTime (const void *one, const void *another);
+
+
+/**
+ * Get the start time of the partition from the file name <br>
+ * ("YYYYMMDDhhmmss.sqlite").<br>
+ *
+ * @param[in] fileName		String indicating the file name
+ * @param[out] startTime	Buffer to store the start time of the partition[sec]
+ * @return					true: the file is a partition file, false: other file
+ */
+static bool this_getFileStartTime (const M2MString *fileName, time_t *startTime);
+
+
+/**
+ * Remove the partition file (and the journal file left by a crash).<br>
+ *
+ * @param[in] self			Partition object
+ * @param[in] startTime		Start time of the partition[sec]
+ * @return					true: the partition file was removed, false: the file doesn't exist or error
+ */
+static bool this_removeFile (const M2MCEPPartition *self, const time_t startTime);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Compare the start times of two partitions (for qsort()).<br>
+ *
+ * @param[in] one		Pointer of the start time
+ * @param[in] another	Pointer of the other start time
+ * @return				Negative, 0 or positive number in ascending order
+ */
+static int this_compareStartTime (const void *one, const void *another)
+	{
+	//===== Compare without overflow =====
+	if ((*(const time_t *)one)<(*(const time_t *)another))
+		{
+		return -1;
+		}
+	else if ((*(const time_t *)one)>(*(const time_t *)another))
+		{
+		return 1;
+		}
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Get the start time of the partition from the file name <br>
+ * ("YYYYMMDDhhmmss.sqlite").<br>
+ *
+ * @param[in] fileName		String indicating the file name
+ * @param[out] startTime	Buffer to store the start time of the partition[sec]
+ * @return					true: the file is a partition file, false: other file
+ */
+static bool this_getFileStartTime (const M2MString *fileName, time_t *startTime)
+	{
+	//========== Variable ==========
+	struct tm date;
+	size_t i = 0;
+	size_t index = 0;
+	int field[6];
+	const size_t DIGIT = 14;
+
+	//===== Check the length and the extension of the file name =====
+	if (fileName!=NULL && startTime!=NULL
+			&& M2MString_length(fileName)==DIGIT+M2MString_length(M2MCEPPartition_FILE_EXTENSION)
+			&& M2MString_compareTo(&(fileName[DIGIT]), M2MCEPPartition_FILE_EXTENSION)==0)
+		{
+		//===== Parse "YYYYMMDDhhmmss" =====
+		memset(field, 0, sizeof(field));
+		for (i=0; i<DIGIT; i++)
+			{
+			if (fileName[i]>='0' && fileName[i]<='9')
+				{
+				index = (i<4) ? 0 : (i-2)/2;
+				field[index] = field[index] * 10 + (fileName[i] - '0');
+				}
+			else
+				{
+				return false;
+				}
+			}
+		//===== Convert the UTC time =====
+		memset(&date, 0, sizeof(date));
+		date.tm_year = field[0] - 1900;
+		date.tm_mon = field[1] - 1;
+		date.tm_mday = field[2];
+		date.tm_hour = field[3];
+		date.tm_min = field[4];
+		date.tm_sec = field[5];
+		(*startTime) = timegm(&date);
+		return (*startTime)>0;
+		}
+	//===== Other file =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Remove the partition file (and the journal file left by a crash).<br>
+ *
+ * @param[in] self			Partition object
+ * @param[in] startTime		Start time of the partition[sec]
+ * @return					true: the partition file was removed, false: the file doesn't exist or error
+ */
+static bool this_removeFile (const M2MCEPPartition *self, const time_t startTime)
+	{
+	//========== Variable ==========
+	M2MString *filePath = NULL;
+	M2MFile *file = NULL;
+	bool removed = false;
+
+	//===== Remove the partition file =====
+	if (M2MCEPPartition_createFilePath(self, startTime, &filePath)!=NULL
+			&& (file=M2MFile_new(filePath))!=NULL)
+		{
+		if (M2MFile_exists(file)==true)
+			{
+			M2MFile_remove(file);
+			removed = true;
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MFile_delete(&file);
+		//===== Remove the rollback journal =====
+		if (M2MString_append(&filePath, (M2MString *)"-journal")!=NULL
+				&& (file=M2MFile_new(filePath))!=NULL)
+			{
+			if (M2MFile_exists(file)==true)
+				{
+				M2MFile_remove(file);
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MFile_delete(&file);
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPPartition.this_removeFile()", __LINE__, (M2MString *)"Failed to get the pathname of the partition file");
+		}
+	M2MHeap_free(filePath);
+	return removed;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Create the pathname string of the partition file starting at the time.<br>
+ * Caller must release the string with M2MHeap_free().<br>
+ *
+ * @param[in] self			Partition object
+ * @param[in] startTime		Start time of the partition[sec]
+ * @param[out] filePath		Buffer to store the created pathname string
+ * @return					Pathname string of the partition file or NULL (in case of error)
+ */
+M2MString *M2MCEPPartition_createFilePath (const M2MCEPPartition *self, const time_t startTime, M2MString **filePath)
+	{
+	//========== Variable ==========
+	struct tm date;
+	M2MString FILE_NAME[32];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPartition_createFilePath()";
+
+	//===== Check argument =====
+	if (self!=NULL && filePath!=NULL)
+		{
+		memset(FILE_NAME, 0, sizeof(FILE_NAME));
+		//===== Name the file after the start time in UTC =====
+		if (gmtime_r(&startTime, &date)!=NULL
+				&& strftime((char *)FILE_NAME, sizeof(FILE_NAME)-1, (const char *)M2MCEPPartition_TIME_FORMAT, &date)>0
+				&& M2MString_append(filePath, self->directoryPath)!=NULL
+				&& M2MString_append(filePath, M2MDirectory_SEPARATOR)!=NULL
+				&& M2MString_append(filePath, FILE_NAME)!=NULL
+				&& M2MString_append(filePath, M2MCEPPartition_FILE_EXTENSION)!=NULL)
+			{
+			return (*filePath);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MHeap_free((*filePath));
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create the pathname of the partition file");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPartition\" object or \"filePath\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the heap memory of the partition object (the partition files are <br>
+ * kept).<br>
+ *
+ * @param[in,out] self	Partition object
+ */
+void M2MCEPPartition_delete (M2MCEPPartition **self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		M2MHeap_free((*self)->directoryPath);
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Returns the start time of the partition including the time.<br>
+ *
+ * @param[in] self	Partition object
+ * @param[in] time	Time[sec]
+ * @return			Start time of the partition[sec] or 0 (in case of error)
+ */
+time_t M2MCEPPartition_getStartTime (const M2MCEPPartition *self, const time_t time)
+	{
+	//===== Check argument =====
+	if (self!=NULL && self->interval>0 && time>=0)
+		{
+		return time - time % (time_t)self->interval;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPPartition_getStartTime()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPartition\" object is NULL or time is negative");
+		return 0;
+		}
+	}
+
+
+/**
+ * Check whether the time is out of the current partition (a new partition <br>
+ * must be opened).<br>
+ *
+ * @param[in] self	Partition object
+ * @param[in] time	Time[sec]
+ * @return			true: the time is out of the current partition (or no partition is opened), false: the time is included
+ */
+bool M2MCEPPartition_isExpired (const M2MCEPPartition *self, const time_t time)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->startTime<=0 || time<self->startTime || time>=self->startTime+(time_t)self->interval;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPPartition_isExpired()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPartition\" object is NULL");
+		return true;
+		}
+	}
+
+
+/**
+ * Get the start times of the existing partitions overlapping the time range <br>
+ * in ascending order.<br>
+ * Caller must release the array with M2MHeap_free().<br>
+ *
+ * @param[in] self				Partition object
+ * @param[in] from				Start of the time range[sec]
+ * @param[in] to				End of the time range (inclusive)[sec]
+ * @param[out] startTimeArray	Buffer to store the array of start times (NULL if no partition overlaps)
+ * @return						Number of overlapping partitions or -1 (in case of error)
+ */
+int M2MCEPPartition_list (const M2MCEPPartition *self, const time_t from, const time_t to, time_t **startTimeArray)
+	{
+	//========== Variable ==========
+	M2MList *fileNameList = NULL;
+	M2MList *node = NULL;
+	time_t startTime = 0;
+	size_t numberOfFile = 0;
+	int numberOfPartition = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPartition_list()";
+
+	//===== Check argument =====
+	if (self!=NULL && from<=to && startTimeArray!=NULL)
+		{
+		(*startTimeArray) = NULL;
+		//===== Search the partition files =====
+		if ((fileNameList=M2MDirectory_listFiles(self->directoryPath))!=NULL)
+			{
+			numberOfFile = M2MList_length(fileNameList);
+			if (numberOfFile>0
+					&& ((*startTimeArray)=(time_t *)M2MHeap_malloc(sizeof(time_t)*numberOfFile))!=NULL)
+				{
+				for (node=M2MList_begin(fileNameList); node!=NULL; node=node->next)
+					{
+					//===== The partition overlaps [from, to] =====
+					if (this_getFileStartTime((M2MString *)M2MList_getValue(node), &startTime)==true
+							&& startTime<=to
+							&& startTime+(time_t)self->interval>from)
+						{
+						(*startTimeArray)[numberOfPartition] = startTime;
+						numberOfPartition++;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MList_delete(fileNameList);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Sort in ascending order of time =====
+		if (numberOfPartition>0)
+			{
+			qsort((*startTimeArray), (size_t)numberOfPartition, sizeof(time_t), this_compareStartTime);
+			}
+		else
+			{
+			M2MHeap_free((*startTimeArray));
+			}
+		return numberOfPartition;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPartition\" object is NULL");
+		return -1;
+		}
+	else if (from>to)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated time range is reversed");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"startTimeArray\" pointer is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Create a new partition object on the directory.<br>
+ *
+ * @param[in] directoryPath	Directory of the partition files (created if it doesn't exist)
+ * @param[in] interval		Time range of one partition[sec] (>0, e.g. M2MCEPPartition_HOUR)
+ * @param[in] retention		Number of partitions kept including the current one (0: all)
+ * @return					Created partition object or NULL (in case of error)
+ */
+M2MCEPPartition *M2MCEPPartition_new (const M2MString *directoryPath, const unsigned int interval, const unsigned int retention)
+	{
+	//========== Variable ==========
+	M2MCEPPartition *self = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPartition_new()";
+
+	//===== Check argument =====
+	if (directoryPath!=NULL && M2MString_length(directoryPath)>0 && interval>0)
+		{
+		//===== Create the directory of the partition files =====
+		if (M2MDirectory_mkdirs(directoryPath, M2MSQLite_DATABASE_DIRECTORY_PERMISSION)==true
+				&& (self=(M2MCEPPartition *)M2MHeap_malloc(sizeof(M2MCEPPartition)))!=NULL
+				&& M2MString_append(&(self->directoryPath), directoryPath)!=NULL)
+			{
+			self->interval = interval;
+			self->retention = retention;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create the directory of the partition files");
+			M2MCEPPartition_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (directoryPath==NULL || M2MString_length(directoryPath)<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated directory path string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated interval is 0");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Make the partition including the time current and remove the partitions <br>
+ * beyond the retention.<br>
+ * Caller must release the pathname string with M2MHeap_free().<br>
+ *
+ * @param[in,out] self		Partition object
+ * @param[in] time			Time[sec]
+ * @param[out] filePath		Buffer to store the pathname string of the current partition file
+ * @return					Pathname string of the current partition file or NULL (in case of error)
+ */
+M2MString *M2MCEPPartition_open (M2MCEPPartition *self, const time_t time, M2MString **filePath)
+	{
+	//========== Variable ==========
+	time_t startTime = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPartition_open()";
+
+	//===== Check argument =====
+	if (self!=NULL && filePath!=NULL)
+		{
+		if ((startTime=M2MCEPPartition_getStartTime(self, time))>0
+				&& M2MCEPPartition_createFilePath(self, startTime, filePath)!=NULL)
+			{
+			self->startTime = startTime;
+			M2MCEPPartition_remove(self);
+			return (*filePath);
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get the current partition file");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPartition\" object or \"filePath\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Remove the partition files older than the retention (counted back from <br>
+ * the current partition).<br>
+ *
+ * @param[in] self	Partition object
+ * @return			Number of removed partition files or -1 (in case of error)
+ */
+int M2MCEPPartition_remove (const M2MCEPPartition *self)
+	{
+	//========== Variable ==========
+	time_t *startTimeArray = NULL;
+	time_t expiredTime = 0;
+	int numberOfPartition = 0;
+	int numberOfFile = 0;
+	int i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPartition_remove()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Keep all partitions =====
+		if (self->retention==0 || self->startTime<=0)
+			{
+			return 0;
+			}
+		//===== Partitions starting before the retention are dropped as whole files =====
+		else if ((expiredTime=self->startTime-(time_t)self->interval*(time_t)(self->retention-1))>0
+				&& (numberOfPartition=M2MCEPPartition_list(self, 0, expiredTime-1, &startTimeArray))>0)
+			{
+			for (i=0; i<numberOfPartition; i++)
+				{
+				if (startTimeArray[i]<expiredTime && this_removeFile(self, startTimeArray[i])==true)
+					{
+					numberOfFile++;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			M2MHeap_free(startTimeArray);
+			return numberOfFile;
+			}
+		//===== No expired partition =====
+		else
+			{
+			return 0;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPartition\" object is NULL");
+		return -1;
+		}
+	}
+
+
+
+/* End Of File */
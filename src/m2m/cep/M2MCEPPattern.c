@@ -0,0 +1,869 @@
+/*******************************************************************************
+ * M2MCEPPattern.c : Event pattern compiled into a NFA over ingested records
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPPattern.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Append the step to the end of the steps of the pattern.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] condition		String indicating the condition of the record or NULL
+ * @param[in] negation		Flag indicating the step must not occur
+ * @return					Pattern object or NULL (in case of error)
+ */
+static M2MCEPPattern *this_appendStep (M2MCEPPattern *self, const M2MString *tableName, const M2MString *condition, const bool negation);
+
+
+/**
+ * Release the partial matches of all partitions.<br>
+ *
+ * @param[in,out] self	Pattern object
+ */
+static void this_clearPartition (M2MCEPPattern *self);
+
+
+/**
+ * Release the heap memory of the partition.<br>
+ *
+ * @param[in,out] partition	Partition to be freed of memory area
+ */
+static void this_deletePartition (M2MCEPPatternPartition **partition);
+
+
+/**
+ * Release the tables read by the pattern.<br>
+ *
+ * @param[in,out] self	Pattern object
+ */
+static void this_deleteTable (M2MCEPPattern *self);
+
+
+/**
+ * Get the partition of the key and move it to the head of the list.<br>
+ * In case of the new partition, the least recently used partition is <br>
+ * discarded when the number of partitions exceeds the limit.<br>
+ *
+ * @param[in,out] self	Pattern object
+ * @param[in] key		String indicating the value of the key column
+ * @param[in] create	Flag indicating the partition is created if it doesn't exist
+ * @return				Partition or NULL (in case of no partition or error)
+ */
+static M2MCEPPatternPartition *this_getPartition (M2MCEPPattern *self, const M2MString *key, const bool create);
+
+
+/**
+ * Get the index of the table read by the pattern (the table is appended in <br>
+ * case of the new one).<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[out] tableIndex	Buffer to store the index of the table
+ * @return					true: Succeed to get, false: Failed to allocate the table
+ */
+static bool this_getTableIndex (M2MCEPPattern *self, const M2MString *tableName, unsigned int *tableIndex);
+
+
+/**
+ * Unlink the partition from the list and release it.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in,out] partition	Partition to be removed
+ */
+static void this_removePartition (M2MCEPPattern *self, M2MCEPPatternPartition *partition);
+
+
+/**
+ * Remove the partial match of the partition (the following ones are moved <br>
+ * forward to keep the order from the oldest).<br>
+ *
+ * @param[in] self			Pattern object
+ * @param[in,out] partition	Partition
+ * @param[in] index			Index of the partial match
+ */
+static void this_removeRun (const M2MCEPPattern *self, M2MCEPPatternPartition *partition, const unsigned int index);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Append the step to the end of the steps of the pattern.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] condition		String indicating the condition of the record or NULL
+ * @param[in] negation		Flag indicating the step must not occur
+ * @return					Pattern object or NULL (in case of error)
+ */
+static M2MCEPPattern *this_appendStep (M2MCEPPattern *self, const M2MString *tableName, const M2MString *condition, const bool negation)
+	{
+	//========== Variable ==========
+	M2MCEPPatternStep *step = NULL;
+	M2MCEPPatternStep **link = NULL;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPPattern.this_appendStep()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && M2MString_length(tableName)>0)
+		{
+		//===== Create the step =====
+		if ((step=(M2MCEPPatternStep *)M2MHeap_malloc(sizeof(M2MCEPPatternStep)))!=NULL
+				&& M2MString_append(&(step->tableName), tableName)!=NULL
+				&& (condition==NULL || M2MString_length(condition)==0 || M2MString_append(&(step->condition), condition)!=NULL))
+			{
+			step->negation = negation;
+			//===== Append the step =====
+			link = &(self->step);
+			while ((*link)!=NULL)
+				{
+				link = &((*link)->next);
+				}
+			(*link) = step;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			if (step!=NULL)
+				{
+				M2MHeap_free(step->tableName);
+				M2MHeap_free(step->condition);
+				M2MHeap_free(step);
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the step of the pattern");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPattern\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the partial matches of all partitions.<br>
+ *
+ * @param[in,out] self	Pattern object
+ */
+static void this_clearPartition (M2MCEPPattern *self)
+	{
+	while (self->head!=NULL)
+		{
+		this_removePartition(self, self->head);
+		}
+	return;
+	}
+
+
+/**
+ * Release the heap memory of the partition.<br>
+ *
+ * @param[in,out] partition	Partition to be freed of memory area
+ */
+static void this_deletePartition (M2MCEPPatternPartition **partition)
+	{
+	//===== Check argument =====
+	if (partition!=NULL && (*partition)!=NULL)
+		{
+		M2MHeap_free((*partition)->key);
+		M2MHeap_free((*partition)->state);
+		M2MHeap_free((*partition)->event);
+		M2MHeap_free((*partition));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Release the tables read by the pattern.<br>
+ *
+ * @param[in,out] self	Pattern object
+ */
+static void this_deleteTable (M2MCEPPattern *self)
+	{
+	//========== Variable ==========
+	M2MCEPPatternTable *table = NULL;
+
+	while ((table=self->table)!=NULL)
+		{
+		self->table = table->next;
+		M2MHeap_free(table->tableName);
+		M2MHeap_free(table);
+		}
+	return;
+	}
+
+
+/**
+ * Get the partition of the key and move it to the head of the list.<br>
+ * In case of the new partition, the least recently used partition is <br>
+ * discarded when the number of partitions exceeds the limit.<br>
+ *
+ * @param[in,out] self	Pattern object
+ * @param[in] key		String indicating the value of the key column
+ * @param[in] create	Flag indicating the partition is created if it doesn't exist
+ * @return				Partition or NULL (in case of no partition or error)
+ */
+static M2MCEPPatternPartition *this_getPartition (M2MCEPPattern *self, const M2MString *key, const bool create)
+	{
+	//========== Variable ==========
+	M2MCEPPatternPartition *partition = NULL;
+	const size_t keyLength = M2MString_length(key);
+	const uint32_t hash = M2MCRC32_getValue(key, keyLength);
+	const unsigned int numberOfPositive = self->numberOfState-1;
+
+	//===== Search the partition =====
+	for (partition=self->head; partition!=NULL; partition=partition->next)
+		{
+		if (partition->hash==hash && strcmp((const char *)partition->key, (const char *)key)==0)
+			{
+			break;
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== In case of the existing partition =====
+	if (partition!=NULL)
+		{
+		//===== Move the partition to the head =====
+		if (partition!=self->head)
+			{
+			partition->previous->next = partition->next;
+			if (partition->next!=NULL)
+				{
+				partition->next->previous = partition->previous;
+				}
+			else
+				{
+				self->tail = partition->previous;
+				}
+			partition->previous = NULL;
+			partition->next = self->head;
+			self->head->previous = partition;
+			self->head = partition;
+			}
+		else
+			{
+			// do nothing
+			}
+		return partition;
+		}
+	//===== In case of no partition =====
+	else if (create==false)
+		{
+		return NULL;
+		}
+	//===== Create the partition =====
+	else if ((partition=(M2MCEPPatternPartition *)M2MHeap_malloc(sizeof(M2MCEPPatternPartition)))!=NULL
+			&& (partition->key=(M2MString *)M2MHeap_malloc(keyLength+1))!=NULL
+			&& (partition->state=(unsigned int *)M2MHeap_malloc(sizeof(unsigned int)*self->maxRun))!=NULL
+			&& (partition->event=(M2MCEPPatternEvent *)M2MHeap_malloc(sizeof(M2MCEPPatternEvent)*self->maxRun*numberOfPositive))!=NULL)
+		{
+		memcpy(partition->key, key, keyLength);
+		partition->hash = hash;
+		//===== Insert the partition at the head =====
+		partition->next = self->head;
+		if (self->head!=NULL)
+			{
+			self->head->previous = partition;
+			}
+		else
+			{
+			self->tail = partition;
+			}
+		self->head = partition;
+		self->numberOfPartition++;
+		//===== Discard the least recently used partition =====
+		if (self->numberOfPartition>self->maxPartition)
+			{
+			this_removePartition(self, self->tail);
+			}
+		else
+			{
+			// do nothing
+			}
+		return partition;
+		}
+	//===== Error handling =====
+	else
+		{
+		this_deletePartition(&partition);
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPPattern.this_getPartition()", __LINE__, (M2MString *)"Failed to allocate new memory for the partition of the pattern");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Get the index of the table read by the pattern (the table is appended in <br>
+ * case of the new one).<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[out] tableIndex	Buffer to store the index of the table
+ * @return					true: Succeed to get, false: Failed to allocate the table
+ */
+static bool this_getTableIndex (M2MCEPPattern *self, const M2MString *tableName, unsigned int *tableIndex)
+	{
+	//========== Variable ==========
+	M2MCEPPatternTable **link = NULL;
+
+	//===== Search the table =====
+	(*tableIndex) = 0;
+	for (link=&(self->table); (*link)!=NULL; link=&((*link)->next))
+		{
+		if (strcmp((const char *)(*link)->tableName, (const char *)tableName)==0)
+			{
+			return true;
+			}
+		else
+			{
+			(*tableIndex)++;
+			}
+		}
+	//===== Append the table =====
+	if (((*link)=(M2MCEPPatternTable *)M2MHeap_malloc(sizeof(M2MCEPPatternTable)))!=NULL
+			&& M2MString_append(&((*link)->tableName), tableName)!=NULL)
+		{
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MHeap_free((*link));
+		return false;
+		}
+	}
+
+
+/**
+ * Unlink the partition from the list and release it.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in,out] partition	Partition to be removed
+ */
+static void this_removePartition (M2MCEPPattern *self, M2MCEPPatternPartition *partition)
+	{
+	if (partition->previous!=NULL)
+		{
+		partition->previous->next = partition->next;
+		}
+	else
+		{
+		self->head = partition->next;
+		}
+	if (partition->next!=NULL)
+		{
+		partition->next->previous = partition->previous;
+		}
+	else
+		{
+		self->tail = partition->previous;
+		}
+	self->numberOfPartition--;
+	this_deletePartition(&partition);
+	return;
+	}
+
+
+/**
+ * Remove the partial match of the partition (the following ones are moved <br>
+ * forward to keep the order from the oldest).<br>
+ *
+ * @param[in] self			Pattern object
+ * @param[in,out] partition	Partition
+ * @param[in] index			Index of the partial match
+ */
+static void this_removeRun (const M2MCEPPattern *self, M2MCEPPatternPartition *partition, const unsigned int index)
+	{
+	//========== Variable ==========
+	const unsigned int numberOfPositive = self->numberOfState-1;
+	const unsigned int numberOfMoved = partition->numberOfRun-index-1;
+
+	memmove(&(partition->state[index]), &(partition->state[index+1]), sizeof(unsigned int)*numberOfMoved);
+	memmove(&(partition->event[index*numberOfPositive]), &(partition->event[(index+1)*numberOfPositive]), sizeof(M2MCEPPatternEvent)*numberOfMoved*numberOfPositive);
+	partition->numberOfRun--;
+	return;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Build the SELECT statement reading the new records of the tables matching <br>
+ * any step (in the order of event time) and fix the states of the steps.<br>
+ * The columns of the result are the index of the step, the key, the event <br>
+ * time and the rowid; the parameter "?N" is the last rowid of the N-th <br>
+ * table.<br>
+ * A pattern must start and end with a positive step.<br>
+ *
+ * @param[in,out] self	Pattern object
+ * @return				Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_compile (M2MCEPPattern *self)
+	{
+	//========== Variable ==========
+	M2MCEPPatternStep *step = NULL;
+	M2MCEPPatternStep *last = NULL;
+	unsigned int numberOfPositive = 0;
+	unsigned int stepIndex = 0;
+	M2MString buffer[16];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPattern_compile()";
+
+	//===== Check argument =====
+	if (self!=NULL && self->step!=NULL)
+		{
+		//===== Check the first and the last steps =====
+		for (last=self->step; last->next!=NULL; last=last->next)
+			{
+			}
+		if (self->step->negation==true || last->negation==true)
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The pattern must start and end with a positive step");
+			return NULL;
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Discard the previous compilation =====
+		this_clearPartition(self);
+		this_deleteTable(self);
+		M2MHeap_free(self->selectSQL);
+		//===== Repeat with steps =====
+		for (step=self->step; step!=NULL; step=step->next, stepIndex++)
+			{
+			//===== Fix the state of the NFA the step applies to =====
+			step->state = numberOfPositive;
+			if (step->negation==false)
+				{
+				numberOfPositive++;
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== "SELECT <step>, <key>, <time>, rowid FROM <table> WHERE rowid > ?<table> AND (<condition>)" =====
+			memset(buffer, 0, sizeof(buffer));
+			if (this_getTableIndex(self, step->tableName, &(step->tableIndex))==true
+					&& (stepIndex==0 || M2MString_append(&(self->selectSQL), (M2MString *)" UNION ALL ")!=NULL)
+					&& M2MString_append(&(self->selectSQL), (M2MString *)"SELECT ")!=NULL
+					&& M2MString_append(&(self->selectSQL), M2MString_convertFromUnsignedIntegerToString(stepIndex, buffer, sizeof(buffer)))!=NULL
+					&& (self->keyColumnName==NULL
+						|| (M2MString_append(&(self->selectSQL), (M2MString *)", CAST(")!=NULL
+							&& M2MString_append(&(self->selectSQL), self->keyColumnName)!=NULL
+							&& M2MString_append(&(self->selectSQL), (M2MString *)" AS TEXT)")!=NULL))
+					&& (self->keyColumnName!=NULL || M2MString_append(&(self->selectSQL), (M2MString *)", ''")!=NULL)
+					&& M2MString_append(&(self->selectSQL), (M2MString *)", ")!=NULL
+					&& M2MString_append(&(self->selectSQL), (self->timeColumnName!=NULL) ? self->timeColumnName : (M2MString *)"0")!=NULL
+					&& M2MString_append(&(self->selectSQL), (M2MString *)", rowid FROM ")!=NULL
+					&& M2MString_append(&(self->selectSQL), step->tableName)!=NULL
+					&& M2MString_append(&(self->selectSQL), (M2MString *)" WHERE rowid > ?")!=NULL
+					&& M2MString_append(&(self->selectSQL), M2MString_convertFromUnsignedIntegerToString(step->tableIndex+1, buffer, sizeof(buffer)))!=NULL
+					&& M2MString_append(&(self->selectSQL), (M2MString *)" AND (")!=NULL
+					&& M2MString_append(&(self->selectSQL), (step->condition!=NULL) ? step->condition : (M2MString *)"1")!=NULL
+					&& M2MString_append(&(self->selectSQL), (M2MString *)")")!=NULL)
+				{
+				// do nothing
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the SELECT statement of the pattern");
+				return NULL;
+				}
+			}
+		//===== Records of the same time: advance partial matches before starting new ones =====
+		if (M2MString_append(&(self->selectSQL), (M2MString *)" ORDER BY 3, 4, 1 DESC")!=NULL)
+			{
+			self->numberOfState = numberOfPositive+1;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the SELECT statement of the pattern");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPattern\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPattern\" structure object has no step");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the heap memory of the pattern object (and finalize its prepared <br>
+ * statement).<br>
+ *
+ * @param[in,out] self	Pattern object to be freed of memory area
+ */
+void M2MCEPPattern_delete (M2MCEPPattern **self)
+	{
+	//========== Variable ==========
+	M2MCEPPatternStep *step = NULL;
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		//===== Finalize prepared statement =====
+		if ((*self)->statement!=NULL)
+			{
+			sqlite3_finalize((*self)->statement);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Release steps, tables and partitions =====
+		while ((step=(*self)->step)!=NULL)
+			{
+			(*self)->step = step->next;
+			M2MHeap_free(step->tableName);
+			M2MHeap_free(step->condition);
+			M2MHeap_free(step);
+			}
+		this_deleteTable((*self));
+		this_clearPartition((*self));
+		M2MHeap_free((*self)->keyColumnName);
+		M2MHeap_free((*self)->timeColumnName);
+		M2MHeap_free((*self)->selectSQL);
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Append the step which must occur after the previous steps.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] condition		String indicating the condition of the record (SQL expression) or NULL (any record)
+ * @return					Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_followedBy (M2MCEPPattern *self, const M2MString *tableName, const M2MString *condition)
+	{
+	return this_appendStep(self, tableName, condition, false);
+	}
+
+
+/**
+ * Create a new event pattern without step.<br>
+ *
+ * @param[in] keyColumnName		String indicating the column partitioning the records or NULL (no partition)
+ * @param[in] timeColumnName	String indicating the column of event time (integer) or NULL (order of insertion)
+ * @param[in] duration			Maximum duration from the first to the last record of a match in the unit of the event time column (0: not limited)
+ * @return						Created pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_new (const M2MString *keyColumnName, const M2MString *timeColumnName, const int64_t duration)
+	{
+	//========== Variable ==========
+	M2MCEPPattern *self = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPPattern_new()";
+
+	//===== Check argument =====
+	if (duration>=0 && (duration==0 || timeColumnName!=NULL))
+		{
+		//===== Create the pattern =====
+		if ((self=(M2MCEPPattern *)M2MHeap_malloc(sizeof(M2MCEPPattern)))!=NULL
+				&& (keyColumnName==NULL || M2MString_append(&(self->keyColumnName), keyColumnName)!=NULL)
+				&& (timeColumnName==NULL || M2MString_append(&(self->timeColumnName), timeColumnName)!=NULL))
+			{
+			self->duration = duration;
+			self->maxPartition = M2MCEPPattern_DEFAULT_MAX_PARTITION;
+			self->maxRun = M2MCEPPattern_DEFAULT_MAX_RUN;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the pattern");
+			M2MCEPPattern_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated duration is negative or indicated without event time column");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Append the step which must not occur between the previous and the next <br>
+ * positive steps.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] condition		String indicating the condition of the record (SQL expression) or NULL (any record)
+ * @return					Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_notFollowedBy (M2MCEPPattern *self, const M2MString *tableName, const M2MString *condition)
+	{
+	return this_appendStep(self, tableName, condition, true);
+	}
+
+
+/**
+ * Give one record read with the compiled SELECT statement to the NFA and <br>
+ * call the callback for each completed match.<br>
+ * Records must be given in the order of event time.<br>
+ *
+ * @param[in,out] self		Pattern object
+ * @param[in] stepIndex		Index of the step matched by the record
+ * @param[in] key			String indicating the value of the key column
+ * @param[in] rowid			Rowid of the record
+ * @param[in] time			Event time of the record
+ * @return					Number of completed matches
+ */
+unsigned int M2MCEPPattern_process (M2MCEPPattern *self, const unsigned int stepIndex, const M2MString *key, const int64_t rowid, const int64_t time)
+	{
+	//========== Variable ==========
+	M2MCEPPatternStep *step = NULL;
+	M2MCEPPatternPartition *partition = NULL;
+	M2MCEPPatternEvent *event = NULL;
+	M2MCEPPatternEvent single;
+	unsigned int numberOfPositive = 0;
+	unsigned int numberOfMatch = 0;
+	unsigned int i = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && self->numberOfState>1 && key!=NULL)
+		{
+		//===== Get the step =====
+		numberOfPositive = self->numberOfState-1;
+		for (step=self->step, i=0; step!=NULL && i<stepIndex; step=step->next, i++)
+			{
+			}
+		if (step==NULL)
+			{
+			return 0;
+			}
+		//===== Pattern of one step matches immediately =====
+		else if (numberOfPositive==1)
+			{
+			if (step->negation==false)
+				{
+				single.tableName = step->tableName;
+				single.rowid = rowid;
+				single.time = time;
+				self->callback(self->patternID, key, &single, 1, self->userData);
+				return 1;
+				}
+			else
+				{
+				return 0;
+				}
+			}
+		//===== Only the first step creates the partition =====
+		else if ((partition=this_getPartition(self, key, (step->negation==false && step->state==0)))==NULL)
+			{
+			return 0;
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Discard the partial matches exceeding the duration =====
+		if (self->duration>0)
+			{
+			i = 0;
+			while (i<partition->numberOfRun)
+				{
+				if (time-partition->event[i*numberOfPositive].time>self->duration)
+					{
+					this_removeRun(self, partition, i);
+					}
+				else
+					{
+					i++;
+					}
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Negated step discards the partial matches waiting in its state =====
+		if (step->negation==true)
+			{
+			i = 0;
+			while (i<partition->numberOfRun)
+				{
+				if (partition->state[i]==step->state)
+					{
+					this_removeRun(self, partition, i);
+					}
+				else
+					{
+					i++;
+					}
+				}
+			}
+		//===== First step starts a new partial match (the oldest is discarded when full) =====
+		else if (step->state==0)
+			{
+			if (partition->numberOfRun>=self->maxRun)
+				{
+				this_removeRun(self, partition, 0);
+				}
+			else
+				{
+				// do nothing
+				}
+			i = partition->numberOfRun++;
+			partition->state[i] = 1;
+			event = &(partition->event[i*numberOfPositive]);
+			event->tableName = step->tableName;
+			event->rowid = rowid;
+			event->time = time;
+			}
+		//===== Following step advances the partial matches waiting in its state =====
+		else
+			{
+			i = 0;
+			while (i<partition->numberOfRun)
+				{
+				if (partition->state[i]==step->state)
+					{
+					event = &(partition->event[i*numberOfPositive+step->state]);
+					event->tableName = step->tableName;
+					event->rowid = rowid;
+					event->time = time;
+					//===== Deliver the completed match =====
+					if (++(partition->state[i])==numberOfPositive)
+						{
+						self->callback(self->patternID, key, &(partition->event[i*numberOfPositive]), numberOfPositive, self->userData);
+						this_removeRun(self, partition, i);
+						numberOfMatch++;
+						}
+					else
+						{
+						i++;
+						}
+					}
+				else
+					{
+					i++;
+					}
+				}
+			}
+		//===== Partition without partial match isn't kept =====
+		if (partition->numberOfRun==0)
+			{
+			this_removePartition(self, partition);
+			}
+		else
+			{
+			// do nothing
+			}
+		return numberOfMatch;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPPattern_process()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPattern\" structure object isn't compiled or key string is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Set the upper limits of the state held by the pattern.<br>
+ *
+ * @param[in,out] self		Pattern object (without partial match)
+ * @param[in] maxPartition	Maximum number of partitions (>0)
+ * @param[in] maxRun		Maximum number of partial matches per partition (>0)
+ * @return					Pattern object or NULL (in case of error)
+ */
+M2MCEPPattern *M2MCEPPattern_setLimit (M2MCEPPattern *self, const unsigned int maxPartition, const unsigned int maxRun)
+	{
+	//===== Check argument =====
+	if (self!=NULL && self->head==NULL && maxPartition>0 && maxRun>0)
+		{
+		self->maxPartition = maxPartition;
+		self->maxRun = maxRun;
+		return self;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPPattern_setLimit()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPPattern\" structure object is NULL or has partial matches, or indicated limit is 0");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
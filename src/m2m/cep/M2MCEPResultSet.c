@@ -0,0 +1,1247 @@
+/*******************************************************************************
+ * M2MCEPResultSet.c : Columnar result set of SELECT statement
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPResultSet.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Allocate the arrays of the column for the type.<br>
+ *
+ * @param[in,out] column	Column of the result set (type is M2MCEPValueType_NULL)
+ * @param[in] type			Type of the column
+ * @param[in] rowCapacity	Number of rows the arrays can hold
+ * @return					true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_allocateColumn (M2MCEPResultColumn *column, const M2MCEPValueType type, const size_t rowCapacity);
+
+
+/**
+ * Append the value of the row to the heap of the text or binary column.<br>
+ *
+ * @param[in,out] column	Column of the result set
+ * @param[in] row			Index number of the row
+ * @param[in] data			Text or binary value (NULL is allowed in case of 0 byte)
+ * @param[in] length		Size of the value[Byte]
+ * @param[in] terminate		true: append '\0' after the value (text), false: not (binary)
+ * @return					true: Succeed to append, false: Failed to allocate or heap overflow
+ */
+static bool this_appendHeap (M2MCEPResultColumn *column, const size_t row, const void *data, const size_t length, const bool terminate);
+
+
+/**
+ * Create a new result set object having the columns (all columns are <br>
+ * M2MCEPValueType_NULL without name).<br>
+ *
+ * @param[in] numberOfColumn	Number of columns (>0)
+ * @return						Created result set object or NULL (in case of error)
+ */
+static M2MCEPResultSet *this_create (const unsigned int numberOfColumn);
+
+
+/**
+ * Returns the type of the column for the SQLite3 storage class.<br>
+ *
+ * @param[in] sqliteType	SQLite3 storage class (SQLITE_INTEGER etc.)
+ * @return					Type of the column
+ */
+static M2MCEPValueType this_getType (const int sqliteType);
+
+
+/**
+ * Double the number of rows the arrays of all columns can hold.<br>
+ *
+ * @param[in,out] self		Result set object
+ * @param[in] rowCapacity	Minimum number of rows to hold
+ * @return					true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_grow (M2MCEPResultSet *self, const size_t rowCapacity);
+
+
+/**
+ * Convert the integer values of the column into real values in place.<br>
+ *
+ * @param[in,out] column	Integer column of the result set
+ * @param[in] numberOfRow	Number of rows
+ */
+static void this_promoteToReal (M2MCEPResultColumn *column, const size_t numberOfRow);
+
+
+/**
+ * Read the bytes from the serialized buffer.<br>
+ *
+ * @param[in] buffer		Serialized buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[out] data			Buffer to copy the bytes (NULL means skip)
+ * @param[in] size			Number of bytes to read
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readBytes (const unsigned char *buffer, const size_t length, size_t *position, void *data, const size_t size);
+
+
+/**
+ * Read the little endian unsigned integer from the serialized buffer.<br>
+ *
+ * @param[in] buffer		Serialized buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[in] size			Size of the integer (4 or 8)[Byte]
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readUnsigned (const unsigned char *buffer, const size_t length, size_t *position, const size_t size, uint64_t *number);
+
+
+/**
+ * Write the unsigned integer in little endian into the serialized buffer.<br>
+ *
+ * @param[out] buffer		Serialized buffer (must have enough space)
+ * @param[in,out] position	Write position (advanced by "size")
+ * @param[in] size			Size of the integer (4 or 8)[Byte]
+ * @param[in] number		Integer
+ */
+static void this_writeUnsigned (unsigned char *buffer, size_t *position, const size_t size, const uint64_t number);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Allocate the arrays of the column for the type.<br>
+ *
+ * @param[in,out] column	Column of the result set (type is M2MCEPValueType_NULL)
+ * @param[in] type			Type of the column
+ * @param[in] rowCapacity	Number of rows the arrays can hold
+ * @return					true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_allocateColumn (M2MCEPResultColumn *column, const M2MCEPValueType type, const size_t rowCapacity)
+	{
+	//===== In case of numeric column =====
+	if (type==M2MCEPValueType_INTEGER || type==M2MCEPValueType_REAL)
+		{
+		if ((column->value.integer=(int64_t *)M2MHeap_calloc(rowCapacity, sizeof(int64_t)))!=NULL)
+			{
+			column->type = type;
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			return false;
+			}
+		}
+	//===== In case of text or binary column =====
+	else if (type==M2MCEPValueType_TEXT || type==M2MCEPValueType_BLOB)
+		{
+		if ((column->offset=(uint32_t *)M2MHeap_calloc(rowCapacity+1, sizeof(uint32_t)))!=NULL)
+			{
+			column->type = type;
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			return false;
+			}
+		}
+	//===== In case of NULL column =====
+	else
+		{
+		return true;
+		}
+	}
+
+
+/**
+ * Append the value of the row to the heap of the text or binary column.<br>
+ *
+ * @param[in,out] column	Column of the result set
+ * @param[in] row			Index number of the row
+ * @param[in] data			Text or binary value (NULL is allowed in case of 0 byte)
+ * @param[in] length		Size of the value[Byte]
+ * @param[in] terminate		true: append '\0' after the value (text), false: not (binary)
+ * @return					true: Succeed to append, false: Failed to allocate or heap overflow
+ */
+static bool this_appendHeap (M2MCEPResultColumn *column, const size_t row, const void *data, const size_t length, const bool terminate)
+	{
+	//========== Variable ==========
+	unsigned char *heap = NULL;
+	size_t heapLength = 0;
+	size_t capacity = 0;
+	const size_t size = length + ((terminate==true) ? 1 : 0);
+
+	//===== Start from the end of the previous row (discards a failed row) =====
+	column->heapLength = (size_t)column->offset[row];
+	heapLength = column->heapLength + size;
+	//===== Check the limit of the offsets =====
+	if (heapLength>(size_t)UINT32_MAX)
+		{
+		return false;
+		}
+	//===== Double the heap in case of lack of space =====
+	else if (heapLength>column->heapCapacity)
+		{
+		capacity = (column->heapCapacity>0) ? column->heapCapacity : 256;
+		while (capacity<heapLength)
+			{
+			capacity *= 2;
+			}
+		if ((heap=(unsigned char *)M2MHeap_realloc(column->heap, capacity))!=NULL)
+			{
+			column->heap = heap;
+			column->heapCapacity = capacity;
+			}
+		//===== Error handling =====
+		else
+			{
+			return false;
+			}
+		}
+	else
+		{
+		// do nothing
+		}
+	//===== Copy the value =====
+	if (length>0)
+		{
+		memcpy(&(column->heap[column->heapLength]), data, length);
+		}
+	else
+		{
+		// do nothing
+		}
+	if (terminate==true)
+		{
+		column->heap[column->heapLength+length] = '\0';
+		}
+	else
+		{
+		// do nothing
+		}
+	column->heapLength = heapLength;
+	column->offset[row+1] = (uint32_t)heapLength;
+	return true;
+	}
+
+
+/**
+ * Create a new result set object having the columns (all columns are <br>
+ * M2MCEPValueType_NULL without name).<br>
+ *
+ * @param[in] numberOfColumn	Number of columns (>0)
+ * @return						Created result set object or NULL (in case of error)
+ */
+static M2MCEPResultSet *this_create (const unsigned int numberOfColumn)
+	{
+	//========== Variable ==========
+	M2MCEPResultSet *self = NULL;
+
+	//===== Allocate the result set and the columns =====
+	if ((self=(M2MCEPResultSet *)M2MHeap_malloc(sizeof(M2MCEPResultSet)))!=NULL
+			&& (self->column=(M2MCEPResultColumn *)M2MHeap_calloc(numberOfColumn, sizeof(M2MCEPResultColumn)))!=NULL)
+		{
+		self->numberOfColumn = numberOfColumn;
+		return self;
+		}
+	//===== Error handling =====
+	else
+		{
+		M2MHeap_free(self);
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the type of the column for the SQLite3 storage class.<br>
+ *
+ * @param[in] sqliteType	SQLite3 storage class (SQLITE_INTEGER etc.)
+ * @return					Type of the column
+ */
+static M2MCEPValueType this_getType (const int sqliteType)
+	{
+	if (sqliteType==SQLITE_INTEGER)
+		{
+		return M2MCEPValueType_INTEGER;
+		}
+	else if (sqliteType==SQLITE_FLOAT)
+		{
+		return M2MCEPValueType_REAL;
+		}
+	else if (sqliteType==SQLITE_TEXT)
+		{
+		return M2MCEPValueType_TEXT;
+		}
+	else if (sqliteType==SQLITE_BLOB)
+		{
+		return M2MCEPValueType_BLOB;
+		}
+	else
+		{
+		return M2MCEPValueType_NULL;
+		}
+	}
+
+
+/**
+ * Double the number of rows the arrays of all columns can hold.<br>
+ *
+ * @param[in,out] self		Result set object
+ * @param[in] rowCapacity	Minimum number of rows to hold
+ * @return					true: Succeed to allocate, false: Failed to allocate
+ */
+static bool this_grow (M2MCEPResultSet *self, const size_t rowCapacity)
+	{
+	//========== Variable ==========
+	M2MCEPResultColumn *column = NULL;
+	size_t capacity = (self->rowCapacity>0) ? self->rowCapacity : 16;
+	void *array = NULL;
+	unsigned int i = 0;
+
+	//===== Decide the new capacity =====
+	while (capacity<rowCapacity)
+		{
+		capacity *= 2;
+		}
+	//===== Enlarge the arrays of all columns =====
+	for (i=0; i<self->numberOfColumn; i++)
+		{
+		column = &(self->column[i]);
+		//===== NULL bitmap (new bits are cleared) =====
+		if ((array=M2MHeap_realloc(column->nullBitmap, (capacity+7)/8))!=NULL)
+			{
+			memset(&(((uint8_t *)array)[(self->rowCapacity+7)/8]), 0, (capacity+7)/8-(self->rowCapacity+7)/8);
+			column->nullBitmap = (uint8_t *)array;
+			}
+		else
+			{
+			return false;
+			}
+		//===== Numeric values =====
+		if (column->value.integer!=NULL)
+			{
+			if ((array=M2MHeap_realloc(column->value.integer, capacity*sizeof(int64_t)))!=NULL)
+				{
+				column->value.integer = (int64_t *)array;
+				}
+			else
+				{
+				return false;
+				}
+			}
+		//===== Offsets into the heap =====
+		else if (column->offset!=NULL)
+			{
+			if ((array=M2MHeap_realloc(column->offset, (capacity+1)*sizeof(uint32_t)))!=NULL)
+				{
+				column->offset = (uint32_t *)array;
+				}
+			else
+				{
+				return false;
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	self->rowCapacity = capacity;
+	return true;
+	}
+
+
+/**
+ * Convert the integer values of the column into real values in place.<br>
+ *
+ * @param[in,out] column	Integer column of the result set
+ * @param[in] numberOfRow	Number of rows
+ */
+static void this_promoteToReal (M2MCEPResultColumn *column, const size_t numberOfRow)
+	{
+	//========== Variable ==========
+	double real = 0.0;
+	size_t i = 0;
+
+	//===== Both arrays share the same 8 byte slots =====
+	for (i=0; i<numberOfRow; i++)
+		{
+		real = (double)column->value.integer[i];
+		memcpy(&(column->value.real[i]), &real, sizeof(double));
+		}
+	column->type = M2MCEPValueType_REAL;
+	return;
+	}
+
+
+/**
+ * Read the bytes from the serialized buffer.<br>
+ *
+ * @param[in] buffer		Serialized buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[out] data			Buffer to copy the bytes (NULL means skip)
+ * @param[in] size			Number of bytes to read
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readBytes (const unsigned char *buffer, const size_t length, size_t *position, void *data, const size_t size)
+	{
+	//===== Check the rest of the buffer =====
+	if ((*position)<=length && size<=length-(*position))
+		{
+		if (data!=NULL && size>0)
+			{
+			memcpy(data, &(buffer[(*position)]), size);
+			}
+		else
+			{
+			// do nothing
+			}
+		(*position) += size;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Read the little endian unsigned integer from the serialized buffer.<br>
+ *
+ * @param[in] buffer		Serialized buffer
+ * @param[in] length		Size of the buffer[Byte]
+ * @param[in,out] position	Read position (advanced by "size")
+ * @param[in] size			Size of the integer (4 or 8)[Byte]
+ * @param[out] number		Buffer to store the integer
+ * @return					true: Succeed to read, false: Out of the buffer
+ */
+static bool this_readUnsigned (const unsigned char *buffer, const size_t length, size_t *position, const size_t size, uint64_t *number)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+
+	//===== Check the rest of the buffer =====
+	if ((*position)<=length && size<=length-(*position))
+		{
+		(*number) = 0;
+		for (i=0; i<size; i++)
+			{
+			(*number) |= ((uint64_t)buffer[(*position)+i]) << (8*i);
+			}
+		(*position) += size;
+		return true;
+		}
+	//===== Error handling =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Write the unsigned integer in little endian into the serialized buffer.<br>
+ *
+ * @param[out] buffer		Serialized buffer (must have enough space)
+ * @param[in,out] position	Write position (advanced by "size")
+ * @param[in] size			Size of the integer (4 or 8)[Byte]
+ * @param[in] number		Integer
+ */
+static void this_writeUnsigned (unsigned char *buffer, size_t *position, const size_t size, const uint64_t number)
+	{
+	//========== Variable ==========
+	size_t i = 0;
+
+	for (i=0; i<size; i++)
+		{
+		buffer[(*position)+i] = (unsigned char)((number >> (8*i)) & 0xFF);
+		}
+	(*position) += size;
+	return;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append the current row of the SQLite3 prepared statement to the result <br>
+ * set (the values are copied).<br>
+ *
+ * @param[in,out] self		Result set object
+ * @param[in] statement		SQLite3 prepared statement object (after SQLITE_ROW)
+ * @return					Result set object or NULL (in case of error)
+ */
+M2MCEPResultSet *M2MCEPResultSet_addRow (M2MCEPResultSet *self, sqlite3_stmt *statement)
+	{
+	//========== Variable ==========
+	M2MCEPResultColumn *column = NULL;
+	size_t row = 0;
+	unsigned int i = 0;
+	int sqliteType = 0;
+	const unsigned char *data = NULL;
+	bool succeeded = true;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPResultSet_addRow()";
+
+	//===== Check argument =====
+	if (self!=NULL && statement!=NULL && (unsigned int)sqlite3_column_count(statement)==self->numberOfColumn)
+		{
+		//===== Make room for the row =====
+		if ((row=self->numberOfRow)>=self->rowCapacity
+				&& this_grow(self, row+1)==false)
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the rows of the result set");
+			return NULL;
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Copy the value of each column =====
+		for (i=0; i<self->numberOfColumn && succeeded==true; i++)
+			{
+			column = &(self->column[i]);
+			//===== In case of NULL value =====
+			if ((sqliteType=sqlite3_column_type(statement, (int)i))==SQLITE_NULL)
+				{
+				column->nullBitmap[row/8] |= (uint8_t)(1 << (row%8));
+				if (column->type==M2MCEPValueType_INTEGER || column->type==M2MCEPValueType_REAL)
+					{
+					column->value.integer[row] = 0;
+					}
+				else if (column->type==M2MCEPValueType_TEXT || column->type==M2MCEPValueType_BLOB)
+					{
+					column->offset[row+1] = column->offset[row];
+					}
+				else
+					{
+					// do nothing
+					}
+				continue;
+				}
+			//===== Decide the type of the column with the first value =====
+			else if (column->type==M2MCEPValueType_NULL)
+				{
+				succeeded = this_allocateColumn(column, this_getType(sqliteType), self->rowCapacity);
+				}
+			//===== Promote the integer column with real value =====
+			else if (column->type==M2MCEPValueType_INTEGER && sqliteType==SQLITE_FLOAT)
+				{
+				this_promoteToReal(column, row);
+				}
+			else
+				{
+				// do nothing
+				}
+			column->nullBitmap[row/8] &= (uint8_t)~(1 << (row%8));
+			//===== Copy the value (SQLite converts other storage class) =====
+			if (succeeded==false)
+				{
+				// do nothing
+				}
+			else if (column->type==M2MCEPValueType_INTEGER)
+				{
+				column->value.integer[row] = (int64_t)sqlite3_column_int64(statement, (int)i);
+				}
+			else if (column->type==M2MCEPValueType_REAL)
+				{
+				column->value.real[row] = sqlite3_column_double(statement, (int)i);
+				}
+			else if (column->type==M2MCEPValueType_TEXT)
+				{
+				data = sqlite3_column_text(statement, (int)i);
+				succeeded = this_appendHeap(column, row, data, (size_t)sqlite3_column_bytes(statement, (int)i), true);
+				}
+			else
+				{
+				data = (const unsigned char *)sqlite3_column_blob(statement, (int)i);
+				succeeded = this_appendHeap(column, row, data, (size_t)sqlite3_column_bytes(statement, (int)i), false);
+				}
+			}
+		//===== Commit the row =====
+		if (succeeded==true)
+			{
+			self->numberOfRow++;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to copy the value into the column of the result set");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPResultSet\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated statement is NULL or has different number of columns");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the heap memory of the result set object.<br>
+ *
+ * @param[in,out] self	Result set object to be freed of memory area
+ */
+void M2MCEPResultSet_delete (M2MCEPResultSet **self)
+	{
+	//========== Variable ==========
+	unsigned int i = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		if ((*self)->column!=NULL)
+			{
+			for (i=0; i<(*self)->numberOfColumn; i++)
+				{
+				M2MHeap_free((*self)->column[i].name);
+				M2MHeap_free((*self)->column[i].value.integer);
+				M2MHeap_free((*self)->column[i].offset);
+				M2MHeap_free((*self)->column[i].heap);
+				M2MHeap_free((*self)->column[i].nullBitmap);
+				}
+			M2MHeap_free((*self)->column);
+			}
+		else
+			{
+			// do nothing
+			}
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Returns the text or binary value of the row of the column (without copying).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @param[in] row		Index number of the row (>=0)
+ * @param[out] length	Buffer to store the size of the value[Byte] (without '\0' in case of text)
+ * @return				Pointer into the heap of the column or NULL (in case of NULL value, numeric column or error)
+ */
+const void *M2MCEPResultSet_getBytes (const M2MCEPResultSet *self, const unsigned int column, const size_t row, size_t *length)
+	{
+	//========== Variable ==========
+	const M2MCEPResultColumn *this = NULL;
+
+	//===== Check argument =====
+	if (length!=NULL
+			&& M2MCEPResultSet_isNull(self, column, row)==false
+			&& ((this=&(self->column[column]))->type==M2MCEPValueType_TEXT || this->type==M2MCEPValueType_BLOB))
+		{
+		(*length) = (size_t)(this->offset[row+1] - this->offset[row]) - ((this->type==M2MCEPValueType_TEXT) ? 1 : 0);
+		return &(this->heap[this->offset[row]]);
+		}
+	//===== Argument error =====
+	else
+		{
+		if (length!=NULL)
+			{
+			(*length) = 0;
+			}
+		else
+			{
+			// do nothing
+			}
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the name of the column.<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Column name or NULL (in case of error)
+ */
+const M2MString *M2MCEPResultSet_getColumnName (const M2MCEPResultSet *self, const unsigned int column)
+	{
+	//===== Check argument =====
+	if (self!=NULL && column<self->numberOfColumn)
+		{
+		return self->column[column].name;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the type of the column.<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Type of the column (M2MCEPValueType_NULL in case of all NULL values or error)
+ */
+M2MCEPValueType M2MCEPResultSet_getColumnType (const M2MCEPResultSet *self, const unsigned int column)
+	{
+	//===== Check argument =====
+	if (self!=NULL && column<self->numberOfColumn)
+		{
+		return self->column[column].type;
+		}
+	//===== Argument error =====
+	else
+		{
+		return M2MCEPValueType_NULL;
+		}
+	}
+
+
+/**
+ * Returns the contiguous array of the integer column (without copying).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Array of number of rows integers or NULL (in case of other type or error)
+ */
+const int64_t *M2MCEPResultSet_getIntegerArray (const M2MCEPResultSet *self, const unsigned int column)
+	{
+	//===== Check argument =====
+	if (M2MCEPResultSet_getColumnType(self, column)==M2MCEPValueType_INTEGER)
+		{
+		return self->column[column].value.integer;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the number of columns of the result set.<br>
+ *
+ * @param[in] self	Result set object
+ * @return			Number of columns
+ */
+unsigned int M2MCEPResultSet_getNumberOfColumn (const M2MCEPResultSet *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->numberOfColumn;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the number of rows of the result set.<br>
+ *
+ * @param[in] self	Result set object
+ * @return			Number of rows
+ */
+size_t M2MCEPResultSet_getNumberOfRow (const M2MCEPResultSet *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->numberOfRow;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the contiguous array of the real column (without copying).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @return				Array of number of rows reals or NULL (in case of other type or error)
+ */
+const double *M2MCEPResultSet_getRealArray (const M2MCEPResultSet *self, const unsigned int column)
+	{
+	//===== Check argument =====
+	if (M2MCEPResultSet_getColumnType(self, column)==M2MCEPValueType_REAL)
+		{
+		return self->column[column].value.real;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Set the value of the row of the column into the typed value (text and <br>
+ * binary values point into the heap of the result set).<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @param[in] row		Index number of the row (>=0)
+ * @param[out] value	Typed value
+ * @return				Typed value or NULL (in case of error)
+ */
+M2MCEPValue *M2MCEPResultSet_getValue (const M2MCEPResultSet *self, const unsigned int column, const size_t row, M2MCEPValue *value)
+	{
+	//========== Variable ==========
+	size_t length = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && column<self->numberOfColumn && row<self->numberOfRow && value!=NULL)
+		{
+		memset(value, 0, sizeof(M2MCEPValue));
+		//===== In case of NULL value =====
+		if (M2MCEPResultSet_isNull(self, column, row)==true)
+			{
+			value->type = M2MCEPValueType_NULL;
+			}
+		else if ((value->type=self->column[column].type)==M2MCEPValueType_INTEGER)
+			{
+			value->value.integer = self->column[column].value.integer[row];
+			}
+		else if (value->type==M2MCEPValueType_REAL)
+			{
+			value->value.real = self->column[column].value.real[row];
+			}
+		else
+			{
+			value->value.blob = M2MCEPResultSet_getBytes(self, column, row, &length);
+			value->length = (int)length;
+			}
+		return value;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns whether the value of the row of the column is NULL or not.<br>
+ *
+ * @param[in] self		Result set object
+ * @param[in] column	Index number of the column (>=0)
+ * @param[in] row		Index number of the row (>=0)
+ * @return				true: NULL (or error), false: not NULL
+ */
+bool M2MCEPResultSet_isNull (const M2MCEPResultSet *self, const unsigned int column, const size_t row)
+	{
+	//===== Check argument =====
+	if (self!=NULL && column<self->numberOfColumn && row<self->numberOfRow)
+		{
+		return ((self->column[column].nullBitmap[row/8] >> (row%8)) & 1)!=0;
+		}
+	//===== Argument error =====
+	else
+		{
+		return true;
+		}
+	}
+
+
+/**
+ * Create a new empty result set object having the columns of the SQLite3 <br>
+ * prepared statement.<br>
+ *
+ * @param[in] statement		SQLite3 prepared statement object
+ * @return					Created result set object or NULL (in case of error)
+ */
+M2MCEPResultSet *M2MCEPResultSet_new (sqlite3_stmt *statement)
+	{
+	//========== Variable ==========
+	M2MCEPResultSet *self = NULL;
+	const M2MString *name = NULL;
+	int numberOfColumn = 0;
+	int i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPResultSet_new()";
+
+	//===== Check argument =====
+	if (statement!=NULL && (numberOfColumn=sqlite3_column_count(statement))>0)
+		{
+		//===== Create the result set with the column names =====
+		if ((self=this_create((unsigned int)numberOfColumn))!=NULL)
+			{
+			for (i=0; i<numberOfColumn; i++)
+				{
+				if ((name=(const M2MString *)sqlite3_column_name(statement, i))==NULL
+						|| M2MString_append(&(self->column[i].name), name)==NULL)
+					{
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to copy the column name of the result set");
+					M2MCEPResultSet_delete(&self);
+					return NULL;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the result set");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated statement is NULL or has no column");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Create a new result set object from the binary buffer created by <br>
+ * M2MCEPResultSet_serialize().<br>
+ *
+ * @param[in] buffer	Serialized result set
+ * @param[in] length	Size of the buffer[Byte]
+ * @return				Created result set object or NULL (in case of broken buffer or error)
+ */
+M2MCEPResultSet *M2MCEPResultSet_parse (const unsigned char *buffer, const size_t length)
+	{
+	//========== Variable ==========
+	M2MCEPResultSet *self = NULL;
+	M2MCEPResultColumn *column = NULL;
+	unsigned char magic[4];
+	size_t position = 0;
+	uint64_t number = 0;
+	uint64_t numberOfColumn = 0;
+	uint64_t numberOfRow = 0;
+	uint64_t nameLength = 0;
+	size_t heapLength = 0;
+	size_t row = 0;
+	unsigned int i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPResultSet_parse()";
+
+	//===== Check the header =====
+	if (buffer!=NULL
+			&& this_readBytes(buffer, length, &position, magic, sizeof(magic))==true
+			&& memcmp(magic, M2MCEPResultSet_MAGIC, sizeof(magic))==0
+			&& this_readUnsigned(buffer, length, &position, 4, &number)==true
+			&& number==M2MCEPResultSet_VERSION
+			&& this_readUnsigned(buffer, length, &position, 4, &numberOfColumn)==true
+			&& numberOfColumn>0 && numberOfColumn<=length
+			&& this_readUnsigned(buffer, length, &position, 8, &numberOfRow)==true
+			&& numberOfRow<=(uint64_t)length*8)
+		{
+		//===== Create the result set holding all rows =====
+		if ((self=this_create((unsigned int)numberOfColumn))==NULL
+				|| this_grow(self, (size_t)numberOfRow)==false)
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the result set");
+			M2MCEPResultSet_delete(&self);
+			return NULL;
+			}
+		else
+			{
+			self->numberOfRow = (size_t)numberOfRow;
+			}
+		//===== Read each column =====
+		for (i=0; i<self->numberOfColumn; i++)
+			{
+			column = &(self->column[i]);
+			//===== Type, name and NULL bitmap =====
+			if (this_readUnsigned(buffer, length, &position, 4, &number)==false
+					|| number>M2MCEPValueType_BLOB
+					|| this_allocateColumn(column, (M2MCEPValueType)number, self->rowCapacity)==false
+					|| this_readUnsigned(buffer, length, &position, 4, &nameLength)==false
+					|| nameLength>length
+					|| (column->name=(M2MString *)M2MHeap_malloc((size_t)nameLength+1))==NULL
+					|| this_readBytes(buffer, length, &position, column->name, (size_t)nameLength)==false
+					|| this_readBytes(buffer, length, &position, column->nullBitmap, (self->numberOfRow+7)/8)==false)
+				{
+				break;
+				}
+			//===== Numeric values =====
+			else if (column->type==M2MCEPValueType_INTEGER || column->type==M2MCEPValueType_REAL)
+				{
+				for (row=0; row<self->numberOfRow; row++)
+					{
+					if (this_readUnsigned(buffer, length, &position, 8, &number)==true)
+						{
+						memcpy(&(column->value.integer[row]), &number, sizeof(int64_t));
+						}
+					else
+						{
+						break;
+						}
+					}
+				if (row<self->numberOfRow)
+					{
+					break;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== Offsets and heap =====
+			else if (column->type==M2MCEPValueType_TEXT || column->type==M2MCEPValueType_BLOB)
+				{
+				for (row=0; row<=self->numberOfRow; row++)
+					{
+					//===== Offsets must start from 0 and never decrease =====
+					if (this_readUnsigned(buffer, length, &position, 4, &number)==true
+							&& ((row==0 && number==0) || (row>0 && number>=column->offset[row-1])))
+						{
+						column->offset[row] = (uint32_t)number;
+						}
+					else
+						{
+						break;
+						}
+					}
+				if (row<=self->numberOfRow
+						|| (heapLength=(size_t)column->offset[self->numberOfRow])>length
+						|| (column->heap=(unsigned char *)M2MHeap_malloc(heapLength+1))==NULL
+						|| this_readBytes(buffer, length, &position, column->heap, heapLength)==false)
+					{
+					break;
+					}
+				else
+					{
+					column->heapLength = heapLength;
+					column->heapCapacity = heapLength + 1;
+					}
+				//===== Text values must be terminated by '\0' =====
+				for (row=0; row<self->numberOfRow && column->type==M2MCEPValueType_TEXT; row++)
+					{
+					if (M2MCEPResultSet_isNull(self, i, row)==false
+							&& (column->offset[row+1]==column->offset[row] || column->heap[column->offset[row+1]-1]!='\0'))
+						{
+						break;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				if (column->type==M2MCEPValueType_TEXT && row<self->numberOfRow)
+					{
+					break;
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		//===== In case of the whole buffer was read =====
+		if (i==self->numberOfColumn && position==length)
+			{
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"The serialized result set is broken");
+			M2MCEPResultSet_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated buffer isn't a serialized result set");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Serialize the result set into a compact binary buffer (little endian).<br>
+ * Caller must release the buffer with M2MHeap_free().<br>
+ *
+ * @param[in] self		Result set object
+ * @param[out] buffer	Buffer to store the allocated binary data
+ * @return				Size of the binary data[Byte] or 0 (in case of error)
+ */
+size_t M2MCEPResultSet_serialize (const M2MCEPResultSet *self, unsigned char **buffer)
+	{
+	//========== Variable ==========
+	const M2MCEPResultColumn *column = NULL;
+	size_t length = 4 + 4 + 4 + 8;
+	size_t position = 0;
+	size_t nameLength = 0;
+	size_t bitmapLength = 0;
+	size_t row = 0;
+	uint64_t number = 0;
+	unsigned int i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPResultSet_serialize()";
+
+	//===== Check argument =====
+	if (self!=NULL && buffer!=NULL)
+		{
+		//===== Calculate the size of the binary data =====
+		bitmapLength = (self->numberOfRow+7)/8;
+		for (i=0; i<self->numberOfColumn; i++)
+			{
+			column = &(self->column[i]);
+			length += 4 + 4 + M2MString_length(column->name) + bitmapLength;
+			if (column->type==M2MCEPValueType_INTEGER || column->type==M2MCEPValueType_REAL)
+				{
+				length += self->numberOfRow * 8;
+				}
+			else if (column->type==M2MCEPValueType_TEXT || column->type==M2MCEPValueType_BLOB)
+				{
+				length += (self->numberOfRow+1) * 4 + (size_t)column->offset[self->numberOfRow];
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		//===== Allocate the buffer =====
+		if (((*buffer)=(unsigned char *)M2MHeap_malloc(length))!=NULL)
+			{
+			//===== Header =====
+			memcpy(&((*buffer)[position]), M2MCEPResultSet_MAGIC, 4);
+			position += 4;
+			this_writeUnsigned((*buffer), &position, 4, M2MCEPResultSet_VERSION);
+			this_writeUnsigned((*buffer), &position, 4, self->numberOfColumn);
+			this_writeUnsigned((*buffer), &position, 8, self->numberOfRow);
+			//===== Columns =====
+			for (i=0; i<self->numberOfColumn; i++)
+				{
+				column = &(self->column[i]);
+				this_writeUnsigned((*buffer), &position, 4, (uint64_t)column->type);
+				nameLength = M2MString_length(column->name);
+				this_writeUnsigned((*buffer), &position, 4, nameLength);
+				if (nameLength>0)
+					{
+					memcpy(&((*buffer)[position]), column->name, nameLength);
+					position += nameLength;
+					}
+				else
+					{
+					// do nothing
+					}
+				if (bitmapLength>0)
+					{
+					memcpy(&((*buffer)[position]), column->nullBitmap, bitmapLength);
+					position += bitmapLength;
+					}
+				else
+					{
+					// do nothing
+					}
+				//===== Numeric values (the bits of real values as they are) =====
+				if (column->type==M2MCEPValueType_INTEGER || column->type==M2MCEPValueType_REAL)
+					{
+					for (row=0; row<self->numberOfRow; row++)
+						{
+						memcpy(&number, &(column->value.integer[row]), sizeof(uint64_t));
+						this_writeUnsigned((*buffer), &position, 8, number);
+						}
+					}
+				//===== Offsets and heap =====
+				else if (column->type==M2MCEPValueType_TEXT || column->type==M2MCEPValueType_BLOB)
+					{
+					for (row=0; row<=self->numberOfRow; row++)
+						{
+						this_writeUnsigned((*buffer), &position, 4, column->offset[row]);
+						}
+					if (column->offset[self->numberOfRow]>0)
+						{
+						memcpy(&((*buffer)[position]), column->heap, (size_t)column->offset[self->numberOfRow]);
+						position += (size_t)column->offset[self->numberOfRow];
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			return position;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the serialized result set");
+			return 0;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPResultSet\" structure object or buffer pointer is NULL");
+		return 0;
+		}
+	}
+
+
+
+/* End Of File */
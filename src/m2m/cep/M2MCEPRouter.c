@@ -0,0 +1,1100 @@
+/*******************************************************************************
+ * M2MCEPRouter.c : Sharded CEP front-end routing tables and keys to shards
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPRouter.h"
+
+
+
+
+
+/*******************************************************************************
+ * Definition
+ ******************************************************************************/
+/**
+ * Callback and its state shared by the shards in M2MCEPRouter_selectEach().<br>
+ *
+ * @param callback		Callback of the caller
+ * @param userData		Pointer passed to the callback of the caller
+ * @param stopped		Flag indicating the callback of the caller returned false
+ */
+#ifndef M2MCEPRouterEach
+typedef struct
+	{
+	M2MCEPRowCallback callback;
+	void *userData;
+	bool stopped;
+	} M2MCEPRouterEach;
+#endif /* M2MCEPRouterEach */
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Hand the row of one shard to the callback of the caller and remember <br>
+ * whether it wants more rows.<br>
+ *
+ * @param[in] row				Typed values of the row
+ * @param[in] numberOfColumn	Number of columns
+ * @param[in,out] userData		M2MCEPRouterEach object
+ * @return						Return value of the callback of the caller
+ */
+static bool this_callEach (const M2MCEPValue *row, const unsigned int numberOfColumn, void *userData);
+
+
+/**
+ * Returns the number of record lines (except the header line) of the CSV <br>
+ * format string.<br>
+ *
+ * @param[in] csv	String in CSV format
+ * @return			Number of records[row]
+ */
+static int this_countRecord (const M2MString *csv);
+
+
+/**
+ * Returns the index number of the column in the header line of the CSV <br>
+ * format string (spaces around the column names are ignored).<br>
+ *
+ * @param[in] header		Header line (column names separated by comma)
+ * @param[in] headerLength	Length of the header line[Byte]
+ * @param[in] columnName	String indicating the column name
+ * @return					Index number of the column (>=0) or -1 (in case of not found)
+ */
+static int this_getColumnIndex (const M2MString *header, const size_t headerLength, const M2MString *columnName);
+
+
+/**
+ * Returns the shard key of the table.<br>
+ *
+ * @param[in] self		Router object
+ * @param[in] tableName	String indicating the table name
+ * @return				Shard key or NULL (in case of the table routed by name)
+ */
+static M2MCEPRouterKey *this_getKey (const M2MCEPRouter *self, const M2MString *tableName);
+
+
+/**
+ * Returns the index number of the shard for the string.<br>
+ *
+ * @param[in] self		Router object
+ * @param[in] string	String indicating the table name or the key value
+ * @param[in] length	Length of the string[Byte]
+ * @return				Index number of the shard
+ */
+static unsigned int this_getShardIndex (const M2MCEPRouter *self, const M2MString *string, const size_t length);
+
+
+/**
+ * Insert the CSV format string into the shard, or put it into the queue of <br>
+ * the shard in asynchronous mode.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] index		Index number of the shard
+ * @param[in] tableName	String indicating the table name
+ * @param[in] csv		String in CSV format
+ * @return				Number of records inserted or queued[row] or -1 (in case of error)
+ */
+static int this_handOff (M2MCEPRouter *self, const unsigned int index, const M2MString *tableName, const M2MString *csv);
+
+
+/**
+ * Split the records of the CSV format string by the hash of the key column <br>
+ * and hand them off to the shards (the header line is copied per shard).<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] csv		String in CSV format
+ * @param[in] key		Shard key of the table
+ * @return				Number of records inserted or queued[row] or -1 (in case of error)
+ */
+static int this_splitCSV (M2MCEPRouter *self, const M2MString *tableName, const M2MString *csv, const M2MCEPRouterKey *key);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Hand the row of one shard to the callback of the caller and remember <br>
+ * whether it wants more rows.<br>
+ *
+ * @param[in] row				Typed values of the row
+ * @param[in] numberOfColumn	Number of columns
+ * @param[in,out] userData		M2MCEPRouterEach object
+ * @return						Return value of the callback of the caller
+ */
+static bool this_callEach (const M2MCEPValue *row, const unsigned int numberOfColumn, void *userData)
+	{
+	//========== Variable ==========
+	M2MCEPRouterEach *each = (M2MCEPRouterEach *)userData;
+
+	//===== Call the callback of the caller =====
+	if (each->callback(row, numberOfColumn, each->userData)==true)
+		{
+		return true;
+		}
+	//===== The caller doesn't want more rows =====
+	else
+		{
+		each->stopped = true;
+		return false;
+		}
+	}
+
+
+/**
+ * Returns the number of record lines (except the header line) of the CSV <br>
+ * format string.<br>
+ *
+ * @param[in] csv	String in CSV format
+ * @return			Number of records[row]
+ */
+static int this_countRecord (const M2MString *csv)
+	{
+	//========== Variable ==========
+	int numberOfRecord = 0;
+	const M2MString *lineHead = NULL;
+	const M2MString *lineEnd = NULL;
+
+	//===== Skip the header line =====
+	if ((lineEnd=M2MString_indexOf(csv, M2MString_CRLF))!=NULL)
+		{
+		lineHead = lineEnd + 2;
+		//===== Count the lines which aren't vacant =====
+		while ((lineEnd=M2MString_indexOf(lineHead, M2MString_CRLF))!=NULL)
+			{
+			if (lineEnd>lineHead)
+				{
+				numberOfRecord++;
+				}
+			else
+				{
+				// do nothing
+				}
+			lineHead = lineEnd + 2;
+			}
+		//===== Last line without line feed =====
+		if ((*lineHead)!='\0')
+			{
+			numberOfRecord++;
+			}
+		else
+			{
+			// do nothing
+			}
+		return numberOfRecord;
+		}
+	//===== Only the header line =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the index number of the column in the header line of the CSV <br>
+ * format string (spaces around the column names are ignored).<br>
+ *
+ * @param[in] header		Header line (column names separated by comma)
+ * @param[in] headerLength	Length of the header line[Byte]
+ * @param[in] columnName	String indicating the column name
+ * @return					Index number of the column (>=0) or -1 (in case of not found)
+ */
+static int this_getColumnIndex (const M2MString *header, const size_t headerLength, const M2MString *columnName)
+	{
+	//========== Variable ==========
+	size_t columnNameLength = M2MString_length(columnName);
+	size_t head = 0;
+	size_t tail = 0;
+	size_t end = 0;
+	int index = 0;
+
+	//===== Repeat with the column names =====
+	while (head<=headerLength)
+		{
+		//===== Get the range of the column name =====
+		for (end=head; end<headerLength && header[end]!=(M2MString)','; end++)
+			{
+			}
+		for (tail=end; tail>head && header[tail-1]==(M2MString)' '; tail--)
+			{
+			}
+		while (head<tail && header[head]==(M2MString)' ')
+			{
+			head++;
+			}
+		//===== Compare the column name =====
+		if (tail-head==columnNameLength && M2MString_equals(&(header[head]), columnName, columnNameLength)==true)
+			{
+			return index;
+			}
+		else
+			{
+			head = end + 1;
+			index++;
+			}
+		}
+	return -1;
+	}
+
+
+/**
+ * Returns the shard key of the table.<br>
+ *
+ * @param[in] self		Router object
+ * @param[in] tableName	String indicating the table name
+ * @return				Shard key or NULL (in case of the table routed by name)
+ */
+static M2MCEPRouterKey *this_getKey (const M2MCEPRouter *self, const M2MString *tableName)
+	{
+	//========== Variable ==========
+	M2MCEPRouterKey *key = NULL;
+
+	//===== Search the shard key of the table =====
+	for (key=self->key; key!=NULL; key=key->next)
+		{
+		if (strcmp((const char *)key->tableName, (const char *)tableName)==0)
+			{
+			return key;
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	return NULL;
+	}
+
+
+/**
+ * Returns the index number of the shard for the string.<br>
+ *
+ * @param[in] self		Router object
+ * @param[in] string	String indicating the table name or the key value
+ * @param[in] length	Length of the string[Byte]
+ * @return				Index number of the shard
+ */
+static unsigned int this_getShardIndex (const M2MCEPRouter *self, const M2MString *string, const size_t length)
+	{
+	//===== In case of one shard or vacant string =====
+	if (self->numberOfShard<=1 || length==0)
+		{
+		return 0;
+		}
+	//===== Hash the string =====
+	else
+		{
+		return (unsigned int)(M2MCRC32_getValue(string, length) % self->numberOfShard);
+		}
+	}
+
+
+/**
+ * Insert the CSV format string into the shard, or put it into the queue of <br>
+ * the shard in asynchronous mode.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] index		Index number of the shard
+ * @param[in] tableName	String indicating the table name
+ * @param[in] csv		String in CSV format
+ * @return				Number of records inserted or queued[row] or -1 (in case of error)
+ */
+static int this_handOff (M2MCEPRouter *self, const unsigned int index, const M2MString *tableName, const M2MString *csv)
+	{
+	//========== Variable ==========
+	int result = 0;
+
+	//===== Asynchronous mode =====
+	if (self->async==true)
+		{
+		if ((result=M2MCEP_enqueueCSV(self->shard[index], tableName, csv))>0)
+			{
+			return this_countRecord(csv);
+			}
+		//===== Dropped because the queue is full =====
+		else if (result==0)
+			{
+			return 0;
+			}
+		//===== Error handling =====
+		else
+			{
+			return -1;
+			}
+		}
+	//===== Synchronous mode =====
+	else
+		{
+		return M2MCEP_insertCSV(self->shard[index], tableName, csv);
+		}
+	}
+
+
+/**
+ * Split the records of the CSV format string by the hash of the key column <br>
+ * and hand them off to the shards (the header line is copied per shard).<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] csv		String in CSV format
+ * @param[in] key		Shard key of the table
+ * @return				Number of records inserted or queued[row] or -1 (in case of error)
+ */
+static int this_splitCSV (M2MCEPRouter *self, const M2MString *tableName, const M2MString *csv, const M2MCEPRouterKey *key)
+	{
+	//========== Variable ==========
+	M2MStringBuilder builder[M2MCEPRouter_MAX_SHARD];
+	const M2MString *lineHead = NULL;
+	const M2MString *lineEnd = NULL;
+	const M2MString *field = NULL;
+	size_t headerLength = 0;
+	size_t lineLength = 0;
+	size_t fieldLength = 0;
+	int columnIndex = 0;
+	int column = 0;
+	unsigned int index = 0;
+	int result = 0;
+	int numberOfRecord = 0;
+	bool error = false;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MCEPRouter.this_splitCSV()";
+
+	//===== Get the position of the key column in the header line =====
+	if ((lineEnd=M2MString_indexOf(csv, M2MString_CRLF))!=NULL
+			&& (columnIndex=this_getColumnIndex(csv, (headerLength=(size_t)(lineEnd-csv)), key->columnName))>=0)
+		{
+		for (index=0; index<self->numberOfShard; index++)
+			{
+			M2MStringBuilder_init(&(builder[index]));
+			}
+		lineHead = lineEnd + 2;
+		//===== Repeat with the record lines =====
+		while ((*lineHead)!='\0')
+			{
+			if ((lineEnd=M2MString_indexOf(lineHead, M2MString_CRLF))==NULL)
+				{
+				lineEnd = lineHead + M2MString_length(lineHead);
+				}
+			else
+				{
+				// do nothing
+				}
+			//===== Get the key value of the record =====
+			if ((lineLength=(size_t)(lineEnd-lineHead))>0)
+				{
+				for (field=lineHead, column=0; column<columnIndex && field<lineEnd; field++)
+					{
+					if ((*field)==(M2MString)',')
+						{
+						column++;
+						}
+					else
+						{
+						// do nothing
+						}
+					}
+				for (fieldLength=0; field+fieldLength<lineEnd && field[fieldLength]!=(M2MString)','; fieldLength++)
+					{
+					}
+				while (fieldLength>0 && (*field)==(M2MString)' ')
+					{
+					field++;
+					fieldLength--;
+					}
+				while (fieldLength>0 && field[fieldLength-1]==(M2MString)' ')
+					{
+					fieldLength--;
+					}
+				//===== Copy the record into the CSV string of the shard =====
+				index = this_getShardIndex(self, field, fieldLength);
+				if ((M2MStringBuilder_getLength(&(builder[index]))>0
+							|| (M2MStringBuilder_appendLength(&(builder[index]), csv, headerLength)!=NULL
+								&& M2MStringBuilder_appendLength(&(builder[index]), M2MString_CRLF, 2)!=NULL))
+						&& M2MStringBuilder_appendLength(&(builder[index]), lineHead, lineLength)!=NULL
+						&& M2MStringBuilder_appendLength(&(builder[index]), M2MString_CRLF, 2)!=NULL)
+					{
+					// do nothing
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the CSV string of the shard");
+					error = true;
+					break;
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			lineHead = ((*lineEnd)=='\0') ? lineEnd : lineEnd + 2;
+			}
+		//===== Hand off the CSV strings to the shards =====
+		for (index=0; index<self->numberOfShard; index++)
+			{
+			if (error==false && M2MStringBuilder_getLength(&(builder[index]))>0)
+				{
+				if ((result=this_handOff(self, index, tableName, M2MStringBuilder_getString(&(builder[index]))))>=0)
+					{
+					numberOfRecord += result;
+					}
+				else
+					{
+					error = true;
+					}
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MStringBuilder_release(&(builder[index]));
+			}
+		return (error==false) ? numberOfRecord : -1;
+		}
+	//===== Error handling =====
+	else if (lineEnd==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Indicated CSV string has no record line");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"The shard key column isn't included in the header line of the CSV string");
+		return -1;
+		}
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Release the shards (the queued and pending records are inserted and <br>
+ * persisted first) and the heap memory of the router.<br>
+ *
+ * @param[in,out] self	Router object to be freed of memory area
+ */
+void M2MCEPRouter_delete (M2MCEPRouter **self)
+	{
+	//========== Variable ==========
+	M2MCEPRouterKey *key = NULL;
+	unsigned int index = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		//===== Release the shards =====
+		if ((*self)->shard!=NULL)
+			{
+			for (index=0; index<(*self)->numberOfShard; index++)
+				{
+				if ((*self)->shard[index]!=NULL)
+					{
+					M2MCEP_delete(&((*self)->shard[index]));
+					}
+				else
+					{
+					// do nothing
+					}
+				}
+			M2MHeap_free((*self)->shard);
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Release the shard keys =====
+		while ((*self)->key!=NULL)
+			{
+			key = (*self)->key;
+			(*self)->key = key->next;
+			M2MHeap_free(key->tableName);
+			M2MHeap_free(key->columnName);
+			M2MHeap_free(key);
+			}
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Returns the number of shards.<br>
+ *
+ * @param[in] self	Router object
+ * @return			Number of shards (0 in case of error)
+ */
+unsigned int M2MCEPRouter_getNumberOfShard (const M2MCEPRouter *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->numberOfShard;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPRouter_getNumberOfShard()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the CEP object of the shard (e.g. to configure it or to run a <br>
+ * query on the shard returned by M2MCEPRouter_route()).<br>
+ *
+ * @param[in] self	Router object
+ * @param[in] index	Index number of the shard (>=0)
+ * @return			CEP object of the shard or NULL (in case of error)
+ */
+M2MCEP *M2MCEPRouter_getShard (const M2MCEPRouter *self, const unsigned int index)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_getShard()";
+
+	//===== Check argument =====
+	if (self!=NULL && index<self->numberOfShard)
+		{
+		return self->shard[index];
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated index number of the shard is out of range");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Route the CSV format string to the shards.<br>
+ * When a shard key is set for the table, the records are split by the hash <br>
+ * of the key value (the header line is copied for each shard); otherwise the <br>
+ * whole string goes to the shard of the table.<br>
+ * In asynchronous mode the strings are put into the queues of the shards <br>
+ * (M2MCEP_enqueueCSV()), otherwise they are inserted (M2MCEP_insertCSV()).<br>
+ * Any number of threads can call this function at the same time; the <br>
+ * shards are locked independently.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] tableName	String indicating the table name to be inserted record
+ * @param[in] csv		String in CSV format as insert data (the first line specifies the column name as a header)
+ * @return				Number of records inserted or queued[row] or -1 (in case of error)
+ */
+int M2MCEPRouter_insertCSV (M2MCEPRouter *self, const M2MString *tableName, const M2MString *csv)
+	{
+	//========== Variable ==========
+	M2MCEPRouterKey *key = NULL;
+	size_t tableNameLength = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_insertCSV()";
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& tableName!=NULL && (tableNameLength=M2MString_length(tableName))>0
+			&& csv!=NULL && M2MString_length(csv)>0)
+		{
+		//===== Route each record by the key value =====
+		if ((key=this_getKey(self, tableName))!=NULL)
+			{
+			return this_splitCSV(self, tableName, csv, key);
+			}
+		//===== Route the table by name =====
+		else
+			{
+			return this_handOff(self, this_getShardIndex(self, tableName, tableNameLength), tableName, csv);
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return -1;
+		}
+	else if (tableName==NULL || tableNameLength<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated CSV string is NULL or vacant");
+		return -1;
+		}
+	}
+
+
+/**
+ * Constructor.<br>
+ * Create the shards named "<databaseName>_<index>" with the table managers <br>
+ * (one per shard, having the same tables).<br>
+ * The table managers are owned by the shards. In case of error, the table <br>
+ * managers which were not handed to a shard remain owned by the caller.<br>
+ *
+ * @param[in] databaseName		String indicating the base name of the databases of the shards
+ * @param[in] tableManager		Array of table managers (one per shard)
+ * @param[in] numberOfShard		Number of shards (1 to M2MCEPRouter_MAX_SHARD, e.g. number of cores)
+ * @return						Created router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_new (const M2MString *databaseName, M2MTableManager *tableManager[], const unsigned int numberOfShard)
+	{
+	//========== Variable ==========
+	M2MCEPRouter *self = NULL;
+	M2MStringBuilder shardName;
+	unsigned int index = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_new()";
+
+	//===== Check argument =====
+	if (databaseName!=NULL && M2MString_length(databaseName)>0
+			&& tableManager!=NULL
+			&& numberOfShard>0 && numberOfShard<=M2MCEPRouter_MAX_SHARD)
+		{
+		//===== Get heap memory of the router =====
+		if ((self=(M2MCEPRouter *)M2MHeap_malloc(sizeof(M2MCEPRouter)))!=NULL
+				&& (self->shard=(M2MCEP **)M2MHeap_malloc(sizeof(M2MCEP *)*numberOfShard))!=NULL)
+			{
+			self->numberOfShard = numberOfShard;
+			M2MStringBuilder_init(&shardName);
+			//===== Create the shards =====
+			for (index=0; index<numberOfShard; index++)
+				{
+				M2MStringBuilder_clear(&shardName);
+				if (tableManager[index]!=NULL
+						&& M2MStringBuilder_append(&shardName, databaseName)!=NULL
+						&& M2MStringBuilder_appendCharacter(&shardName, (M2MString)'_')!=NULL
+						&& M2MStringBuilder_appendUnsignedLong(&shardName, (uint64_t)index)!=NULL
+						&& (self->shard[index]=M2MCEP_new(M2MStringBuilder_getString(&shardName), tableManager[index]))!=NULL)
+					{
+					// do nothing
+					}
+				//===== Error handling =====
+				else
+					{
+					M2MStringBuilder_release(&shardName);
+					M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to create the CEP object of the shard");
+					M2MCEPRouter_delete(&self);
+					return NULL;
+					}
+				}
+			M2MStringBuilder_release(&shardName);
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the router");
+			M2MCEPRouter_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (databaseName==NULL || M2MString_length(databaseName)<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"databaseName\" string is NULL or vacant");
+		return NULL;
+		}
+	else if (tableManager==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated array of \"tableManager\" objects is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated number of shards is out of range");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the index number of the shard holding the table (key is NULL) or <br>
+ * the records of the key value.<br>
+ *
+ * @param[in] self		Router object
+ * @param[in] tableName	String indicating the table name
+ * @param[in] key		String indicating the value of the shard key column or NULL
+ * @return				Index number of the shard or -1 (in case of error)
+ */
+int M2MCEPRouter_route (const M2MCEPRouter *self, const M2MString *tableName, const M2MString *key)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_route()";
+
+	//===== Check argument =====
+	if (self!=NULL && tableName!=NULL && M2MString_length(tableName)>0)
+		{
+		//===== Route the table by name =====
+		if (key==NULL || this_getKey(self, tableName)==NULL)
+			{
+			return (int)this_getShardIndex(self, tableName, M2MString_length(tableName));
+			}
+		//===== Route the record by the key value =====
+		else
+			{
+			return (int)this_getShardIndex(self, key, M2MString_length(key));
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return -1;
+		}
+	}
+
+
+/**
+ * Executes the SQL statement on all shards and merges the CSV results (the <br>
+ * header line of the first result, then the records of all shards in the <br>
+ * order of the shards).<br>
+ * The records are concatenated: ORDER BY, LIMIT and aggregate functions are <br>
+ * applied per shard. Run such a query on one shard (M2MCEPRouter_route()) <br>
+ * or combine the per shard results.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[out] result	CSV character string of execution result or NULL (in case of error)
+ * @return				CSV character string of execution result or NULL (in case of no data or error)
+ */
+M2MString *M2MCEPRouter_select (M2MCEPRouter *self, const M2MString *sql, M2MString **result)
+	{
+	//========== Variable ==========
+	M2MStringBuilder builder;
+	M2MString *shardResult = NULL;
+	M2MString *records = NULL;
+	unsigned int index = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_select()";
+
+	//===== Check argument =====
+	if (self!=NULL && sql!=NULL && result!=NULL)
+		{
+		M2MStringBuilder_init(&builder);
+		//===== Fan out the query to the shards =====
+		for (index=0; index<self->numberOfShard; index++)
+			{
+			shardResult = NULL;
+			if (M2MCEP_select(self->shard[index], sql, &shardResult)!=NULL)
+				{
+				//===== The header line is taken from the first result =====
+				if (M2MStringBuilder_getLength(&builder)==0)
+					{
+					M2MStringBuilder_append(&builder, shardResult);
+					}
+				else if ((records=M2MString_indexOf(shardResult, M2MString_CRLF))!=NULL)
+					{
+					M2MStringBuilder_append(&builder, records+2);
+					}
+				else
+					{
+					// do nothing
+					}
+				M2MHeap_free(shardResult);
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		//===== Hand over the merged result =====
+		if (M2MStringBuilder_getLength(&builder)==0)
+			{
+			M2MStringBuilder_release(&builder);
+			return NULL;
+			}
+		else if ((*result)==NULL)
+			{
+			(*result) = M2MStringBuilder_detach(&builder);
+			return (*result);
+			}
+		else
+			{
+			M2MString_appendLength(result, M2MStringBuilder_getString(&builder), M2MStringBuilder_getLength(&builder));
+			M2MStringBuilder_release(&builder);
+			return (*result);
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return NULL;
+		}
+	else if (sql==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"result\" pointer is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Executes the SELECT statement on all shards and hands each row of the <br>
+ * results to the callback (see M2MCEP_selectEach()).<br>
+ * When the callback returns false, the remaining shards are skipped.<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] sql		String indicating SELECT statement
+ * @param[in] callback	Callback receiving the rows of the results
+ * @param[in] userData	Pointer passed to the callback as it is
+ * @return				Number of rows handed to the callback or -1 (in case of error)
+ */
+int M2MCEPRouter_selectEach (M2MCEPRouter *self, const M2MString *sql, const M2MCEPRowCallback callback, void *userData)
+	{
+	//========== Variable ==========
+	M2MCEPRouterEach each;
+	unsigned int index = 0;
+	int result = 0;
+	int numberOfRow = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_selectEach()";
+
+	//===== Check argument =====
+	if (self!=NULL && sql!=NULL && callback!=NULL)
+		{
+		each.callback = callback;
+		each.userData = userData;
+		each.stopped = false;
+		//===== Fan out the query to the shards =====
+		for (index=0; index<self->numberOfShard && each.stopped==false; index++)
+			{
+			if ((result=M2MCEP_selectEach(self->shard[index], sql, this_callEach, &each))>=0)
+				{
+				numberOfRow += result;
+				}
+			//===== Error handling =====
+			else
+				{
+				return -1;
+				}
+			}
+		return numberOfRow;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return -1;
+		}
+	else if (sql==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQL string is NULL");
+		return -1;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated callback function is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Set the column whose value decides the shard of each record of the table.<br>
+ * Set the shard keys before inserting records into the table.<br>
+ *
+ * @param[in,out] self		Router object
+ * @param[in] tableName		String indicating the table name
+ * @param[in] columnName	String indicating the column name of the key
+ * @return					Router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_setShardKey (M2MCEPRouter *self, const M2MString *tableName, const M2MString *columnName)
+	{
+	//========== Variable ==========
+	M2MCEPRouterKey *key = NULL;
+	M2MString *newColumnName = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_setShardKey()";
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& tableName!=NULL && M2MString_length(tableName)>0
+			&& columnName!=NULL && M2MString_length(columnName)>0)
+		{
+		//===== Replace the key column of the table =====
+		if ((key=this_getKey(self, tableName))!=NULL)
+			{
+			if (M2MString_append(&newColumnName, columnName)!=NULL)
+				{
+				M2MHeap_free(key->columnName);
+				key->columnName = newColumnName;
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the shard key");
+				return NULL;
+				}
+			}
+		//===== Create the shard key =====
+		else if ((key=(M2MCEPRouterKey *)M2MHeap_malloc(sizeof(M2MCEPRouterKey)))!=NULL
+				&& M2MString_append(&(key->tableName), tableName)!=NULL
+				&& M2MString_append(&(key->columnName), columnName)!=NULL)
+			{
+			key->next = self->key;
+			self->key = key;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			if (key!=NULL)
+				{
+				M2MHeap_free(key->tableName);
+				M2MHeap_free(key->columnName);
+				M2MHeap_free(key);
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to allocate new memory for the shard key");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return NULL;
+		}
+	else if (tableName==NULL || M2MString_length(tableName)<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated table name string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated column name string is NULL or vacant");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Start the asynchronous mode of all shards (one writer thread per shard, <br>
+ * see M2MCEP_startAsync()).<br>
+ *
+ * @param[in,out] self	Router object
+ * @param[in] capacity	Number of CSV strings the queue of each shard can hold
+ * @param[in] blocking	true: the caller waits when the queue is full, false: the CSV string is dropped
+ * @return				Router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_startAsync (M2MCEPRouter *self, const unsigned int capacity, const bool blocking)
+	{
+	//========== Variable ==========
+	unsigned int index = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPRouter_startAsync()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Start the writer threads =====
+		for (index=0; index<self->numberOfShard; index++)
+			{
+			if (M2MCEP_startAsync(self->shard[index], capacity, blocking)==NULL)
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to start the asynchronous mode of the shard");
+				M2MCEPRouter_stopAsync(self);
+				return NULL;
+				}
+			else
+				{
+				// do nothing
+				}
+			}
+		self->async = true;
+		return self;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Stop the asynchronous mode of all shards after inserting all queued CSV <br>
+ * strings.<br>
+ *
+ * @param[in,out] self	Router object
+ * @return				Router object or NULL (in case of error)
+ */
+M2MCEPRouter *M2MCEPRouter_stopAsync (M2MCEPRouter *self)
+	{
+	//========== Variable ==========
+	unsigned int index = 0;
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->async = false;
+		//===== Stop the writer threads =====
+		for (index=0; index<self->numberOfShard; index++)
+			{
+			M2MCEP_stopAsync(self->shard[index]);
+			}
+		return self;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MCEPRouter_stopAsync()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPRouter\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
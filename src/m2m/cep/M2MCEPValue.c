@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * M2MCEPValue.c : Typed value of a record field for CEP
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPValue.h"
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Bind the value into the parameter of SQLite3 prepared statement without <br>
+ * converting it to a string.<br>
+ * Strings and binary data are copied by SQLite (SQLITE_TRANSIENT).<br>
+ *
+ * @param[in] self			Typed value
+ * @param[in] index			Index number of the parameter (>=1)
+ * @param[in,out] statement	SQLite3 prepared statement object
+ * @return					true: Succeed to bind, false: Failed to bind
+ */
+bool M2MCEPValue_bind (const M2MCEPValue *self, const unsigned int index, sqlite3_stmt *statement)
+	{
+	//========== Variable ==========
+	int result = SQLITE_ERROR;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPValue_bind()";
+
+	//===== Check argument =====
+	if (self!=NULL && index>0 && statement!=NULL)
+		{
+		//===== In case of integer =====
+		if (self->type==M2MCEPValueType_INTEGER)
+			{
+			result = sqlite3_bind_int64(statement, index, (sqlite3_int64)self->value.integer);
+			}
+		//===== In case of double =====
+		else if (self->type==M2MCEPValueType_REAL)
+			{
+			result = sqlite3_bind_double(statement, index, self->value.real);
+			}
+		//===== In case of string =====
+		else if (self->type==M2MCEPValueType_TEXT && self->value.text!=NULL)
+			{
+			result = sqlite3_bind_text(statement, index, (const char *)self->value.text, self->length, SQLITE_TRANSIENT);
+			}
+		//===== In case of binary data =====
+		else if (self->type==M2MCEPValueType_BLOB && self->value.blob!=NULL && self->length>=0)
+			{
+			result = sqlite3_bind_blob(statement, index, self->value.blob, self->length, SQLITE_TRANSIENT);
+			}
+		//===== In case of NULL =====
+		else
+			{
+			result = sqlite3_bind_null(statement, index);
+			}
+		//===== Check result =====
+		if (result==SQLITE_OK)
+			{
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)sqlite3_errstr(result));
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPValue\" structure object is NULL");
+		return false;
+		}
+	else if (index<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated index number is 0");
+		return false;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQLite3 prepared statement object is NULL");
+		return false;
+		}
+	}
+
+
+/**
+ * Set the value of the column of the current row of SQLite3 prepared <br>
+ * statement without converting it to a string.<br>
+ * Strings and binary data point to the memory of SQLite, which is valid <br>
+ * until the statement is stepped, reset or finalized.<br>
+ *
+ * @param[out] self			Typed value
+ * @param[in] statement		SQLite3 prepared statement object (after SQLITE_ROW)
+ * @param[in] index			Index number of the column (>=0)
+ * @return					Typed value or NULL (in case of error)
+ */
+M2MCEPValue *M2MCEPValue_setColumn (M2MCEPValue *self, sqlite3_stmt *statement, const int index)
+	{
+	//========== Variable ==========
+	int columnType = SQLITE_NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MCEPValue_setColumn()";
+
+	//===== Check argument =====
+	if (self!=NULL && statement!=NULL && index>=0)
+		{
+		//===== In case of integer =====
+		if ((columnType=sqlite3_column_type(statement, index))==SQLITE_INTEGER)
+			{
+			self->type = M2MCEPValueType_INTEGER;
+			self->value.integer = (int64_t)sqlite3_column_int64(statement, index);
+			self->length = 0;
+			}
+		//===== In case of double =====
+		else if (columnType==SQLITE_FLOAT)
+			{
+			self->type = M2MCEPValueType_REAL;
+			self->value.real = sqlite3_column_double(statement, index);
+			self->length = 0;
+			}
+		//===== In case of string =====
+		else if (columnType==SQLITE_TEXT)
+			{
+			self->type = M2MCEPValueType_TEXT;
+			self->value.text = (const M2MString *)sqlite3_column_text(statement, index);
+			self->length = sqlite3_column_bytes(statement, index);
+			}
+		//===== In case of binary data =====
+		else if (columnType==SQLITE_BLOB)
+			{
+			self->type = M2MCEPValueType_BLOB;
+			self->value.blob = sqlite3_column_blob(statement, index);
+			self->length = sqlite3_column_bytes(statement, index);
+			}
+		//===== In case of NULL =====
+		else
+			{
+			self->type = M2MCEPValueType_NULL;
+			self->value.integer = 0;
+			self->length = 0;
+			}
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MCEPValue\" structure object is NULL");
+		return NULL;
+		}
+	else if (statement==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQLite3 prepared statement object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated index number is negative");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
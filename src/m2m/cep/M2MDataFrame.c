@@ -97,7 +97,7 @@ static void this_deleteOldRecordList (M2MDataFrame *self)
 	if (M2MDataFrame_getOldRecordList(self)!=NULL)
 		{
 		//===== Release heap memory area (it is a pointer in the structure so it can be released) =====
-		M2MList_delete(self->oldRecordList);
+		M2MRingBuffer_delete(&(self->oldRecordList));
 		}
 	//===== Error handling =====
 	else
@@ -236,7 +236,7 @@ static void this_init (M2MDataFrame *self)
 	{
 	//========== Variable ==========
 	M2MList *newRecordList = NULL;
-	M2MList *oldRecordList = NULL;
+	M2MRingBuffer *oldRecordList = NULL;
 	const M2MString *METHOD_NAME = (M2MString *)"M2MDataFrame.this_init()";
 
 	//===== Check argument =====
@@ -249,7 +249,7 @@ static void this_init (M2MDataFrame *self)
 		this_deleteOldRecordList(self);
 		//===== Create old and new record information objects =====
 		if ((newRecordList=M2MList_new())!=NULL
-				&& (oldRecordList=M2MList_new())!=NULL)
+				&& (oldRecordList=M2MRingBuffer_new(M2MDataFrame_OLD_RECORD_CAPACITY))!=NULL)
 			{
 			//===== Set an object to store newly inserted record information =====
 			self->newRecordList = newRecordList;
@@ -318,8 +318,8 @@ static unsigned int this_length (M2MDataFrame *self)
 				{
 				M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"\"columnName\" CSV string owned by argument is NULL or vacant");
 				}
-			//=====  =====
-			while (M2MDataFrame_next(self)!=NULL)
+			//===== Repeat until reaching the end node =====
+			while ((self=M2MDataFrame_next(self))!=NULL)
 				{
 				//===== Confirm existence of table name and column name in CSV format =====
 				if ((tableName=M2MDataFrame_getTableName(self))!=NULL
@@ -611,6 +611,40 @@ M2MDataFrame *M2MDataFrame_begin (M2MDataFrame *self)
 	}
 
 
+/**
+ * Release all records of the newly inserted record list held by the argument <br>
+ * and replace it with an empty list.<br>
+ *
+ * @param[in,out] self	Record management object
+ */
+void M2MDataFrame_clearNewRecordList (M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Release newly inserted records =====
+		this_deleteNewRecordList(self);
+		//===== Set empty list =====
+		if ((self->newRecordList=M2MList_new())!=NULL)
+			{
+			return;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Failed to create a list structure object to store newly inserted record information");
+			return;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return;
+		}
+	}
+
+
 /**
  * Free all memory area of record management object specified by argument.<br>
  * <br>
@@ -645,6 +679,7 @@ void M2MDataFrame_delete (M2MDataFrame **self)
 				this_deleteColumnName((*self));
 				this_deleteNewRecordList((*self));
 				this_deleteOldRecordList((*self));
+				M2MHeap_free((*self)->evictSQL);
 				M2MHeap_free((*self));
 				//===== Move to the next M2MList structure object =====
 				(*self) = next;
@@ -656,6 +691,7 @@ void M2MDataFrame_delete (M2MDataFrame **self)
 				this_deleteColumnName((*self));
 				this_deleteNewRecordList((*self));
 				this_deleteOldRecordList((*self));
+				M2MHeap_free((*self)->evictSQL);
 				M2MHeap_free((*self));
 				}
 			else
@@ -701,6 +737,90 @@ M2MString *M2MDataFrame_getColumnName (const M2MDataFrame *self)
 	}
 
 
+/**
+ * Returns the total number of records evicted from the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Number of evicted records
+ */
+unsigned long M2MDataFrame_getEvictedRecordCount (const M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->evictedRecord;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the DELETE statement ("DELETE FROM table WHERE rowid < ?") evicting <br>
+ * the records of the table below a rowid watermark.<br>
+ * The string is created on the first call and kept by the object.<br>
+ *
+ * @param[in,out] self	Record management object
+ * @return				String indicating the DELETE statement or NULL (in case of error)
+ */
+M2MString *M2MDataFrame_getEvictSQL (M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && self->tableName!=NULL)
+		{
+		//===== Create DELETE statement on the first call =====
+		if (self->evictSQL!=NULL
+				|| (M2MString_append(&(self->evictSQL), (M2MString *)"DELETE FROM ")!=NULL
+					&& M2MString_append(&(self->evictSQL), self->tableName)!=NULL
+					&& M2MString_append(&(self->evictSQL), (M2MString *)" WHERE rowid < ? ")!=NULL))
+			{
+			return self->evictSQL;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Failed to create DELETE statement for evicting records");
+			M2MHeap_free(self->evictSQL);
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object or its table name is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the rowid of the last record inserted into the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Rowid of the last inserted record (0 if none)
+ */
+int64_t M2MDataFrame_getLastRowid (const M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->lastRowid;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return 0;
+		}
+	}
+
+
 /**
  * Returns a newly inserted record list that the argument holds as a member variable.<br>
  *
@@ -729,7 +849,7 @@ M2MList *M2MDataFrame_getNewRecordList (const M2MDataFrame *self)
  * @param[in] self		Record management object
  * @return				Record list (inserted in the memory DB) inserted in the past that is held by the record management object specified by the argument
  */
-M2MList *M2MDataFrame_getOldRecordList (const M2MDataFrame *self)
+M2MRingBuffer *M2MDataFrame_getOldRecordList (const M2MDataFrame *self)
 	{
 	//===== Check argument =====
 	if (self!=NULL)
@@ -745,6 +865,78 @@ M2MList *M2MDataFrame_getOldRecordList (const M2MDataFrame *self)
 	}
 
 
+/**
+ * Returns the rowid up to which the records held in the SQLite 3 database in <br>
+ * memory are already in the SQLite 3 database on file. Such records are not <br>
+ * inserted into the SQLite 3 database on file again when they are evicted.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Rowid of the last persisted record (0 if none)
+ */
+int64_t M2MDataFrame_getPersistedRowid (const M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->persistedRowid;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the sequence number of the last record of the table persisted <br>
+ * into the SQLite 3 database on file. The records of the write-ahead log up <br>
+ * to this number aren't replayed after a crash.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Sequence number of the last persisted record (-1 until loaded)
+ */
+int64_t M2MDataFrame_getPersistedSequence (const M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->persistedSequence;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return -1;
+		}
+	}
+
+
+/**
+ * Returns the sequence number of the last record inserted into the table of <br>
+ * the SQLite 3 database in memory. Each record of the table is numbered in <br>
+ * the order of insertion for the write-ahead log.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Sequence number of the last inserted record (0 if none)
+ */
+int64_t M2MDataFrame_getSequence (const M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->sequence;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return 0;
+		}
+	}
+
+
 /**
  * Returns the table name string held by the argument as a member variable.<br>
  *
@@ -767,6 +959,29 @@ M2MString *M2MDataFrame_getTableName (const M2MDataFrame *self)
 	}
 
 
+/**
+ * Returns the number of records of the table held in the SQLite 3 database in <br>
+ * memory.<br>
+ *
+ * @param[in] self		Record management object
+ * @return				Number of records held in the SQLite 3 database in memory
+ */
+unsigned int M2MDataFrame_getWindowLength (const M2MDataFrame *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->windowLength;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return 0;
+		}
+	}
+
+
 /**
  * Copy the record information of the "newly inserted record information" structure <br>
  * object of the record management object designated by the argument to the "record <br>
@@ -780,10 +995,10 @@ void M2MDataFrame_moveFromNewRecordListToOldRecordList (M2MDataFrame *self)
 	{
 	//========== Variable ==========
 	M2MList *newRecordList = NULL;
-	M2MList *oldRecordList = NULL;
+	M2MList *node = NULL;
+	M2MRingBuffer *oldRecordList = NULL;
 	void *value = NULL;
 	size_t valueLength = 0;
-	unsigned int counter = 0;
 
 	//===== Check argument =====
 	if (self!=NULL)
@@ -793,19 +1008,18 @@ void M2MDataFrame_moveFromNewRecordListToOldRecordList (M2MDataFrame *self)
 				&& (oldRecordList=M2MDataFrame_getOldRecordList(self))!=NULL)
 			{
 			//===== Get the begin node of the new record information object =====
-			if ((newRecordList=M2MList_begin(newRecordList))!=NULL)
+			if ((node=M2MList_begin(newRecordList))!=NULL)
 				{
-				//===== Repeat until reaching the terminal node =====
-				while (newRecordList!=NULL && M2MList_next(newRecordList)!=NULL)
+				//===== Repeat until passing the terminal node =====
+				while (node!=NULL)
 					{
 					//===== Confirm existence of record of new record information object =====
-					if ((value=M2MList_getValue(newRecordList))!=NULL
-							&& (valueLength=M2MList_getValueLength(newRecordList))>0)
+					if ((value=M2MList_getValue(node))!=NULL
+							&& (valueLength=M2MList_getValueLength(node))>0)
 						{
-						//===== Copy record of new record information object to past record information object =====
-						if (M2MList_add(oldRecordList, value, valueLength)!=NULL)
+						//===== Copy record of new record information object to the end of past record information object =====
+						if (M2MRingBuffer_push(oldRecordList, value, valueLength)!=NULL)
 							{
-							counter++;
 							}
 						//===== Error handling =====
 						else
@@ -813,36 +1027,16 @@ void M2MDataFrame_moveFromNewRecordListToOldRecordList (M2MDataFrame *self)
 							M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"An error occurred during the process of copying the new record information object to the past record information object");
 							}
 						}
-					//===== Error handling =====
+					//===== In case of empty list =====
 					else
 						{
-						M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"The record value of the new record information object is NULL or the record size is 0 [byte] or less");
+						// do nothing
 						}
-					//===== Delete the moved record from the new record information object and move to the next node =====
-					newRecordList = M2MList_remove(newRecordList);
+					//===== Move to the next node =====
+					node = node->next;
 					}
-				//===== Confirm existence of record of new record information object =====
-				if ((value=M2MList_getValue(newRecordList))!=NULL
-						&& (valueLength=M2MList_getValueLength(newRecordList))>0)
-					{
-					//===== Copy the record of the terminal node to the past record information object =====
-					if (M2MList_add(oldRecordList, value, valueLength)!=NULL)
-						{
-						counter++;
-						}
-					//===== Error handling =====
-					else
-						{
-						M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"An error occurred during the process of copying the new record information object to the past record information object");
-						}
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"The record value of the new record information object is NULL or the record size is 0 [byte] or less");
-					}
-				//===== Delete moved record from new record information object =====
-				self->newRecordList = M2MList_remove(newRecordList);
+				//===== Release the moved records at once =====
+				M2MDataFrame_clearNewRecordList(self);
 				return;
 				}
 			//===== Error handling =====
@@ -890,11 +1084,12 @@ M2MDataFrame *M2MDataFrame_new ()
 		{
 		if ((self->newRecordList=M2MList_new())!=NULL)
 			{
-			if ((self->oldRecordList=M2MList_new())!=NULL)
+			if ((self->oldRecordList=M2MRingBuffer_new(M2MDataFrame_OLD_RECORD_CAPACITY))!=NULL)
 				{
 				//===== Initialization of member variables =====
 				M2MDataFrame_setPreviousRecord(self, self);
 				M2MDataFrame_setNextRecord(self, NULL);
+				M2MDataFrame_setPersistedSequence(self, -1);
 				return self;
 				}
 			//===== Error handling =====
@@ -998,6 +1193,7 @@ void M2MDataFrame_remove (M2MDataFrame *self, const M2MString *tableName)
 			this_deleteColumnName(record);
 			this_deleteNewRecordList(record);
 			this_deleteOldRecordList(record);
+			M2MHeap_free(record->evictSQL);
 			//===== Get forward / backward node of designated record management object =====
 			previous = M2MDataFrame_previous(record);
 			next = M2MDataFrame_next(record);
@@ -1232,6 +1428,52 @@ int M2MDataFrame_setCSV (M2MDataFrame *self, const M2MString *tableName, const M
 	}
 
 
+/**
+ * Set the total number of records evicted from the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in,out] self			Record management object
+ * @param[in] evictedRecord		Number of evicted records
+ */
+void M2MDataFrame_setEvictedRecordCount (M2MDataFrame *self, const unsigned long evictedRecord)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->evictedRecord = evictedRecord;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Set the rowid of the last record inserted into the table of the SQLite 3 <br>
+ * database in memory.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] lastRowid		Rowid of the last inserted record
+ */
+void M2MDataFrame_setLastRowid (M2MDataFrame *self, const int64_t lastRowid)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->lastRowid = lastRowid;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		}
+	return;
+	}
+
+
 /**
  * Set the record management object one record behind the argument.<br>
  *
@@ -1254,6 +1496,52 @@ void M2MDataFrame_setNextRecord (M2MDataFrame *self, M2MDataFrame *nextRecord)
 	}
 
 
+/**
+ * Set the rowid up to which the records held in the SQLite 3 database in <br>
+ * memory are already in the SQLite 3 database on file.<br>
+ *
+ * @param[in,out] self			Record management object
+ * @param[in] persistedRowid	Rowid of the last persisted record
+ */
+void M2MDataFrame_setPersistedRowid (M2MDataFrame *self, const int64_t persistedRowid)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->persistedRowid = persistedRowid;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Set the sequence number of the last record of the table persisted into <br>
+ * the SQLite 3 database on file.<br>
+ *
+ * @param[in,out] self				Record management object
+ * @param[in] persistedSequence		Sequence number of the last persisted record
+ */
+void M2MDataFrame_setPersistedSequence (M2MDataFrame *self, const int64_t persistedSequence)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->persistedSequence = persistedSequence;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		}
+	return;
+	}
+
+
 /**
  * Set the record management object one before the argument.<br>
  *
@@ -1276,6 +1564,148 @@ void M2MDataFrame_setPreviousRecord (M2MDataFrame *self, M2MDataFrame *previousR
 	}
 
 
+/**
+ * Set the sequence number of the last record inserted into the table of the <br>
+ * SQLite 3 database in memory.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] sequence		Sequence number of the last inserted record
+ */
+void M2MDataFrame_setSequence (M2MDataFrame *self, const int64_t sequence)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->sequence = sequence;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Returns the record management object having the table name specified by the <br>
+ * argument.<br>
+ * If no record management object has the table name, a record management object <br>
+ * is newly generated with the table name and the CSV format column name and <br>
+ * added to the record management object specified by the argument.<br>
+ * This is used to insert records without CSV format string.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] tableName		String indicating table name
+ * @param[in] columnName	CSV format string indicating the column names of records
+ * @return					Record management object of the table or NULL (in case of error)
+ */
+M2MDataFrame *M2MDataFrame_setTable (M2MDataFrame *self, const M2MString *tableName, const M2MString *columnName)
+	{
+	//========== Variable ==========
+	M2MDataFrame *record = NULL;
+	size_t columnNameLength = 0;
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& tableName!=NULL && M2MString_length(tableName)>0
+			&& columnName!=NULL && (columnNameLength=M2MString_length(columnName))>0)
+		{
+		//===== If the table name has already been set (if an existing node exists) =====
+		if ((record=this_detectM2MDataFrame(self, tableName))!=NULL)
+			{
+			return record;
+			}
+		//===== When there is no node having a value in the record management object =====
+		else if (this_length(self)==0)
+			{
+			//===== Set the first node of the record management object =====
+			if ((self=M2MDataFrame_begin(self))!=NULL
+					&& this_setTableName(self, tableName)!=NULL
+					&& this_setColumnName(self, (M2MString *)columnName, columnNameLength)!=NULL)
+				{
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Failed to set table name and column name into the first record management object");
+				this_init(self);
+				return NULL;
+				}
+			}
+		//===== When there is at least one node in the record management object =====
+		else
+			{
+			//===== Generate new record management object nodes =====
+			if ((self=this_end(self))!=NULL
+					&& (record=M2MDataFrame_new())!=NULL
+					&& this_setTableName(record, tableName)!=NULL
+					&& this_setColumnName(record, (M2MString *)columnName, columnNameLength)!=NULL)
+				{
+				//===== Concatenate with existing record management objects =====
+				M2MDataFrame_setNextRecord(self, record);
+				M2MDataFrame_setPreviousRecord(record, self);
+				return record;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Failed to create new record management object");
+				//===== Delete generated record management object =====
+				if (record!=NULL)
+					{
+					M2MDataFrame_delete(&record);
+					}
+				else
+					{
+					// do nothing
+					}
+				return NULL;
+				}
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		return NULL;
+		}
+	else if (tableName==NULL || M2MString_length(tableName)<=0)
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! The string indicating the table name is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! The string indicating the column name is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Set the number of records of the table held in the SQLite 3 database in memory.<br>
+ *
+ * @param[in,out] self		Record management object
+ * @param[in] windowLength	Number of records held in the SQLite 3 database in memory
+ */
+void M2MDataFrame_setWindowLength (M2MDataFrame *self, const unsigned int windowLength)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->windowLength = windowLength;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, __func__, __LINE__, (M2MString *)"Argument error! Indicated \"M2MDataFrame *\" object is NULL");
+		}
+	return;
+	}
+
+
 /**
  * Returns the number of elements of record management object specified by argument.<br>
  *
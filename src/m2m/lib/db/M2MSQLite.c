@@ -79,6 +79,45 @@ static sqlite3_stmt *this_getStatement (sqlite3 *database, const M2MString *sql)
 
 
 
+/**
+ * This function returns the integer value of the PRAGMA statement indicated <br>
+ * by argument (first column of first row).<br>
+ *
+ * @param[in] database	SQLite3 database manager object
+ * @param[in] sql		String indicating PRAGMA statement
+ * @return				Integer value or -1 (in case of error)
+ */
+static int64_t this_getPragmaValue (sqlite3 *database, const M2MString *sql)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	int64_t value = -1;
+
+	//===== Get SQLite3 statement object =====
+	if ((statement=this_getStatement(database, sql))!=NULL)
+		{
+		//===== Get the value =====
+		if (M2MSQLite_next(statement)==SQLITE_ROW)
+			{
+			value = (int64_t)sqlite3_column_int64(statement, 0);
+			}
+		//===== Error handling =====
+		else
+			{
+			// do nothing
+			}
+		M2MSQLite_closeStatement(statement);
+		return value;
+		}
+	//===== Error handling =====
+	else
+		{
+		return -1;
+		}
+	}
+
+
+
 /*******************************************************************************
  * Public function
  ******************************************************************************/
@@ -316,6 +355,32 @@ M2MString *M2MSQLite_getErrorMessage (sqlite3 *database)
 	}
 
 
+/**
+ * Returns the number of unused pages (freelist) of the SQLite3 database.<br>
+ *
+ * @param[in] database	SQLite3 database manager object
+ * @return				Number of free pages or -1 (in case of error)
+ */
+int64_t M2MSQLite_getFreelistCount (sqlite3 *database)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MSQLite_getFreelistCount()";
+	const M2MString *PRAGMA_FREELIST_COUNT_SQL = (M2MString *)"PRAGMA freelist_count ";
+
+	//===== Check argument =====
+	if (database!=NULL)
+		{
+		return this_getPragmaValue(database, PRAGMA_FREELIST_COUNT_SQL);
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sqlite3\" object is NULL");
+		return -1;
+		}
+	}
+
+
 /**
  * SQLite 3 Returns the maximum number of columns allowed in the table.<br>
  *
@@ -430,6 +495,64 @@ M2MString *M2MSQLite_getTableInfoSQL (const M2MString *tableName, M2MString **sq
 	}
 
 
+/**
+ * Remove up to the indicated number of pages from the freelist of the SQLite3 <br>
+ * database and truncate the database (auto_vacuum must be INCREMENTAL).<br>
+ *
+ * @param[in] database		SQLite3 database manager object
+ * @param[in] numberOfPage	Number of pages to be removed from the freelist
+ * @return					true: success, false: failure
+ */
+bool M2MSQLite_incrementalVacuum (sqlite3 *database, const uint32_t numberOfPage)
+	{
+	//========== Variable ==========
+	sqlite3_stmt *statement = NULL;
+	int result = 0;
+	M2MString sql[64];
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MSQLite_incrementalVacuum()";
+
+	//===== Check argument =====
+	if (database!=NULL && numberOfPage>0)
+		{
+		//===== Execute incremental vacuum (one row is returned per removed page) =====
+		memset(sql, 0, sizeof(sql));
+		snprintf(sql, sizeof(sql)-1, (M2MString *)"PRAGMA incremental_vacuum(%u) ", numberOfPage);
+		if ((statement=this_getStatement(database, sql))!=NULL)
+			{
+			while ((result=M2MSQLite_next(statement))==SQLITE_ROW)
+				{
+				}
+			M2MSQLite_closeStatement(statement);
+			}
+		else
+			{
+			result = SQLITE_ERROR;
+			}
+		if (result==SQLITE_DONE)
+			{
+			return true;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to execute incremental vacuum process");
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else if (database==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sqlite3\" object is NULL");
+		return false;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated number of pages is 0");
+		return false;
+		}
+	}
+
+
 /**
  * Check the existence of indicated table and return the result.<br>
  *
@@ -704,6 +827,62 @@ bool M2MSQLite_setCacheSize (sqlite3 *database, const uint32_t cacheSize)
 	}
 
 
+/**
+ * Set the auto-vacuum status of the SQLite3 database to INCREMENTAL.<br>
+ * Since an existing database can not change the auto-vacuum status without <br>
+ * rebuilding, VACUUM is executed once in that case.<br>
+ *
+ * @param[in] database	SQLite3 database object to set incremental vacuum
+ * @return				true: success, false: failure
+ */
+bool M2MSQLite_setIncrementalVacuum (sqlite3 *database)
+	{
+	//========== Variable ==========
+	const int64_t INCREMENTAL = 2;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MSQLite_setIncrementalVacuum()";
+	const M2MString *PRAGMA_AUTO_VACUUM_SQL = (M2MString *)"PRAGMA auto_vacuum ";
+	const M2MString *PRAGMA_INCREMENTAL_VACUUM_SQL = (M2MString *)"PRAGMA auto_vacuum = 2 ";
+
+	//===== Check argument =====
+	if (database!=NULL)
+		{
+		//===== Set incremental vacuum mode =====
+		if (M2MSQLite_executeUpdate(database, PRAGMA_INCREMENTAL_VACUUM_SQL)==true)
+			{
+			//===== In case of new database or already incremental =====
+			if (this_getPragmaValue(database, PRAGMA_AUTO_VACUUM_SQL)==INCREMENTAL)
+				{
+				return true;
+				}
+			//===== Rebuild existing database =====
+			else if (M2MSQLite_vacuum(database)==true
+					&& this_getPragmaValue(database, PRAGMA_AUTO_VACUUM_SQL)==INCREMENTAL)
+				{
+				return true;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to rebuild the database in incremental vacuum mode");
+				return false;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to set incremental vacuum mode");
+			return false;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sqlite3\" object is NULL");
+		return false;
+		}
+	}
+
+
 /**
  * Set the synchronous mode of the SQLite 3 database.<br>
  *
@@ -0,0 +1,536 @@
+/*******************************************************************************
+ * M2MStatementCache.c
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/lib/db/M2MStatementCache.h"
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Finalize the prepared statement of the entry and release its heap memory.<br>
+ *
+ * @param[in,out] self	Statement cache object
+ * @param[in,out] entry	Cache entry to be removed
+ */
+static void this_removeEntry (M2MStatementCache *self, M2MStatementCacheEntry *entry);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Unlink the entry from the bidirectional list of the cache.<br>
+ *
+ * @param[in,out] self	Statement cache object
+ * @param[in,out] entry	Cache entry to be unlinked
+ */
+static void this_detachEntry (M2MStatementCache *self, M2MStatementCacheEntry *entry)
+	{
+	//===== Check argument =====
+	if (self!=NULL && entry!=NULL)
+		{
+		//===== Unlink from previous entry =====
+		if (entry->previous!=NULL)
+			{
+			entry->previous->next = entry->next;
+			}
+		else
+			{
+			self->head = entry->next;
+			}
+		//===== Unlink from next entry =====
+		if (entry->next!=NULL)
+			{
+			entry->next->previous = entry->previous;
+			}
+		else
+			{
+			self->tail = entry->previous;
+			}
+		entry->previous = NULL;
+		entry->next = NULL;
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Link the entry to the head (= most recently used position) of the cache.<br>
+ *
+ * @param[in,out] self	Statement cache object
+ * @param[in,out] entry	Cache entry to be linked
+ */
+static void this_attachEntry (M2MStatementCache *self, M2MStatementCacheEntry *entry)
+	{
+	//===== Check argument =====
+	if (self!=NULL && entry!=NULL)
+		{
+		entry->previous = NULL;
+		entry->next = self->head;
+		//===== In the case of existing head entry =====
+		if (self->head!=NULL)
+			{
+			self->head->previous = entry;
+			}
+		//===== In the case of empty cache =====
+		else
+			{
+			self->tail = entry;
+			}
+		self->head = entry;
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Compare the signature strings (NULL is regarded as an independent value).<br>
+ *
+ * @param[in] one		Signature string or NULL
+ * @param[in] another	Signature string or NULL
+ * @return				true: same signature, false: different signature
+ */
+static bool this_equalsSignature (const M2MString *one, const M2MString *another)
+	{
+	//===== In the case of both signatures are NULL =====
+	if (one==NULL && another==NULL)
+		{
+		return true;
+		}
+	//===== In the case of both signatures exist =====
+	else if (one!=NULL && another!=NULL)
+		{
+		return (strcmp((const char *)one, (const char *)another)==0) ? true : false;
+		}
+	//===== In the case of either signature is NULL =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Finalize the prepared statement of the entry and release its heap memory.<br>
+ *
+ * @param[in,out] self	Statement cache object
+ * @param[in,out] entry	Cache entry to be removed
+ */
+static void this_removeEntry (M2MStatementCache *self, M2MStatementCacheEntry *entry)
+	{
+	//===== Check argument =====
+	if (self!=NULL && entry!=NULL)
+		{
+		this_detachEntry(self, entry);
+		//===== Finalize prepared statement =====
+		M2MSQLite_closeStatement(entry->statement);
+		M2MHeap_free(entry->key);
+		M2MHeap_free(entry->signature);
+		M2MHeap_free(entry);
+		self->length--;
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Finalize all cached prepared statements.<br>
+ * This function must be called when the database schema has been changed.<br>
+ *
+ * @param[in,out] self	Statement cache object
+ */
+void M2MStatementCache_clear (M2MStatementCache *self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStatementCache_clear()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Repeat until the cache becomes empty =====
+		while (self->head!=NULL)
+			{
+			this_removeEntry(self, self->head);
+			}
+		self->length = 0;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStatementCache\" structure object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Finalize all cached prepared statements and release the heap memory of <br>
+ * the statement cache object.<br>
+ * Call this function before closing the SQLite3 database connection.<br>
+ *
+ * @param[in,out] self	Statement cache object to be freed of memory area
+ */
+void M2MStatementCache_delete (M2MStatementCache **self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStatementCache_delete()";
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		//===== Finalize all statements =====
+		M2MStatementCache_clear((*self));
+		//===== Release heap memory of cache =====
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStatementCache\" structure object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Return the SQLite3 database connection bound to the statement cache.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			SQLite3 database object or NULL (in case of error)
+ */
+sqlite3 *M2MStatementCache_getDatabase (const M2MStatementCache *self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStatementCache_getDatabase()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->database;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStatementCache\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Return the number of lookups which reused a cached prepared statement.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			Number of cache hits
+ */
+uint64_t M2MStatementCache_getHitCount (const M2MStatementCache *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->hit;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Return the number of prepared statements held by the cache.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			Number of cached statements
+ */
+unsigned int M2MStatementCache_getLength (const M2MStatementCache *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->length;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Return the number of lookups which couldn't reuse a cached statement.<br>
+ *
+ * @param[in] self	Statement cache object
+ * @return			Number of cache misses
+ */
+uint64_t M2MStatementCache_getMissCount (const M2MStatementCache *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->miss;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Constructor.<br>
+ * Create new statement cache object bound to the SQLite3 database connection.<br>
+ *
+ * @param[in] database	SQLite3 database object
+ * @param[in] capacity	Maximum number of cached statements (unlimited in case of 0)
+ * @return				Created statement cache object or NULL (in case of error)
+ */
+M2MStatementCache *M2MStatementCache_new (sqlite3 *database, const unsigned int capacity)
+	{
+	//========== Variable ==========
+	M2MStatementCache *self = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStatementCache_new()";
+
+	//===== Check argument =====
+	if (database!=NULL)
+		{
+		//===== Get heap memory of statement cache =====
+		if ((self=(M2MStatementCache *)M2MHeap_malloc(sizeof(M2MStatementCache)))!=NULL)
+			{
+			self->database = database;
+			self->capacity = capacity;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for creating \"M2MStatementCache\" structure object");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated SQLite3 database object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Prepare the SQL statement and store it into the cache with the key and <br>
+ * signature.<br>
+ * The returned statement is owned by the cache, so caller must not finalize <br>
+ * it with "M2MSQLite_closeStatement()".<br>
+ *
+ * @param[in,out] self		Statement cache object
+ * @param[in] key			String identifying the statement
+ * @param[in] signature		String which must also match to reuse the statement or NULL
+ * @param[in] sql			SQL statement to be prepared
+ * @return					Prepared statement or NULL (in case of error)
+ */
+sqlite3_stmt *M2MStatementCache_put (M2MStatementCache *self, const M2MString *key, const M2MString *signature, const M2MString *sql)
+	{
+	//========== Variable ==========
+	M2MStatementCacheEntry *entry = NULL;
+	sqlite3_stmt *statement = NULL;
+	size_t keyLength = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStatementCache_put()";
+
+	//===== Check argument =====
+	if (self!=NULL
+			&& key!=NULL && (keyLength=M2MString_length(key))>0
+			&& sql!=NULL)
+		{
+		//===== Prepare statement and copy the key =====
+		if ((statement=M2MSQLite_getPreparedStatement(self->database, sql))!=NULL
+				&& (entry=(M2MStatementCacheEntry *)M2MHeap_malloc(sizeof(M2MStatementCacheEntry)))!=NULL
+				&& M2MString_append(&(entry->key), key)!=NULL
+				&& (signature==NULL || M2MString_append(&(entry->signature), signature)!=NULL))
+			{
+			entry->hash = M2MCRC32_getValue(key, keyLength);
+			entry->statement = statement;
+			this_attachEntry(self, entry);
+			self->length++;
+			//===== Evict the least recently used statement =====
+			while (self->capacity>0 && self->length>self->capacity && self->tail!=entry)
+				{
+				this_removeEntry(self, self->tail);
+				}
+			return statement;
+			}
+		//===== Error handling =====
+		else if (statement==NULL)
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, M2MSQLite_getErrorMessage(self->database));
+			return NULL;
+			}
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for creating new cache entry");
+			M2MSQLite_closeStatement(statement);
+			if (entry!=NULL)
+				{
+				M2MHeap_free(entry->key);
+				M2MHeap_free(entry->signature);
+				M2MHeap_free(entry);
+				}
+			else
+				{
+				// do nothing
+				}
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStatementCache\" structure object is NULL");
+		return NULL;
+		}
+	else if (key==NULL || keyLength<=0)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"key\" string is NULL or vacant");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"sql\" string is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Search the cached prepared statement matching the key and signature.<br>
+ * When found, the statement is reset, its bindings are cleared and it becomes <br>
+ * the most recently used one.<br>
+ * When an entry with the same key but a different signature exists, it is <br>
+ * regarded as stale and finalized.<br>
+ *
+ * @param[in,out] self		Statement cache object
+ * @param[in] key			String identifying the statement
+ * @param[in] signature		String which must also match to reuse the statement or NULL
+ * @return					Cached prepared statement or NULL (in case of cache miss)
+ */
+sqlite3_stmt *M2MStatementCache_search (M2MStatementCache *self, const M2MString *key, const M2MString *signature)
+	{
+	//========== Variable ==========
+	M2MStatementCacheEntry *entry = NULL;
+	M2MStatementCacheEntry *next = NULL;
+	uint32_t hash = 0;
+	size_t keyLength = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStatementCache_search()";
+
+	//===== Check argument =====
+	if (self!=NULL && key!=NULL && (keyLength=M2MString_length(key))>0)
+		{
+		hash = M2MCRC32_getValue(key, keyLength);
+		entry = self->head;
+		//===== Repeat until the end of cache =====
+		while (entry!=NULL)
+			{
+			next = entry->next;
+			//===== In the case of same key =====
+			if (entry->hash==hash && strcmp((const char *)entry->key, (const char *)key)==0)
+				{
+				//===== In the case of same signature =====
+				if (this_equalsSignature(entry->signature, signature)==true)
+					{
+					//===== Move to the most recently used position =====
+					if (entry!=self->head)
+						{
+						this_detachEntry(self, entry);
+						this_attachEntry(self, entry);
+						}
+					else
+						{
+						// do nothing
+						}
+					sqlite3_reset(entry->statement);
+					sqlite3_clear_bindings(entry->statement);
+					self->hit++;
+					return entry->statement;
+					}
+				//===== In the case of stale signature (header or schema has been changed) =====
+				else
+					{
+					this_removeEntry(self, entry);
+					}
+				}
+			//===== In the case of different key =====
+			else
+				{
+				// do nothing
+				}
+			entry = next;
+			}
+		self->miss++;
+		return NULL;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStatementCache\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"key\" string is NULL or vacant");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
@@ -1292,7 +1292,7 @@ size_t M2MFile_write (const M2MFile *self, const unsigned char *data, const size
 		for (result=0; result<dataLength; result=result+(size_t)writtenDataLength)
 			{
 			//===== Write data into file =====
-			if ((writtenDataLength=write(M2MFile_getFileDescriptor(self), data, dataLength-result))>0)
+			if ((writtenDataLength=write(M2MFile_getFileDescriptor(self), &(data[result]), dataLength-result))>0)
 				{
 				}
 			//===== In the case of not written data =====
@@ -160,53 +160,64 @@ static M2MJSONObject *this_setSameIndexPrevious (M2MJSONObject *object, M2MJSONO
 
 
 /**
- * This method translate from JSON Array to JSON form string.<br>
+ * This method appends JSON Array as JSON form string to the buffer.<br>
  *
- * @param[in] array		JSON Array object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] array			JSON Array object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toM2MStringFromArray (M2MJSONArray *array, M2MString **buffer);
+static M2MStringBuilder *this_toM2MStringFromArray (M2MJSONArray *array, M2MStringBuilder *builder);
 
 
 /**
- * This method translate from JSON Boolean to JSON form string.<br>
+ * This method appends JSON Boolean object as JSON form string to the buffer.<br>
  *
- * @param[in] self		JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toM2MStringFromBoolean (M2MJSON *self, M2MString **buffer);
+static M2MStringBuilder *this_toM2MStringFromBoolean (M2MJSON *self, M2MStringBuilder *builder);
 
 
 /**
- * This method translate from JSON Number to JSON form string.<br>
+ * This method appends JSON object of any type as JSON form string to the <br>
+ * buffer.<br>
  *
- * @param[in] self		JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toM2MStringFromNumber (M2MJSON *self, M2MString **buffer);
+static M2MStringBuilder *this_toM2MStringFromJSON (M2MJSON *self, M2MStringBuilder *builder);
 
 
 /**
- * This method translate from JSON Object to JSON form string.<br>
+ * This method appends JSON Number as JSON form string to the buffer.<br>
  *
- * @param[in] object	JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toM2MStringFromObject (M2MJSONObject *object, M2MString **buffer);
+static M2MStringBuilder *this_toM2MStringFromNumber (M2MJSON *self, M2MStringBuilder *builder);
 
 
 /**
- * This method translate from JSON Array to JSON form string.<br>
+ * This method appends JSON Object as JSON form string to the buffer.<br>
  *
- * @param[in] self		JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] object		JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toStringFromString (M2MJSON *self, M2MString **buffer);
+static M2MStringBuilder *this_toM2MStringFromObject (M2MJSONObject *object, M2MStringBuilder *builder);
+
+
+/**
+ * This method appends JSON M2MString as JSON form string to the buffer.<br>
+ *
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
+ */
+static M2MStringBuilder *this_toStringFromString (M2MJSON *self, M2MStringBuilder *builder);
 
 
 
@@ -1197,332 +1208,45 @@ static M2MJSONObject *this_setSameIndexPrevious (M2MJSONObject *object, M2MJSONO
 
 
 /**
- * This method translate from JSON Array to JSON form string.<br>
+ * This method appends JSON Array as JSON form string to the buffer.<br>
  *
- * @param[in] array		JSON Array object
- * @param[out] string	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] array			JSON Array object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static unsigned char *this_toM2MStringFromArray (M2MJSONArray *array, M2MString **buffer)
+static M2MStringBuilder *this_toM2MStringFromArray (M2MJSONArray *array, M2MStringBuilder *builder)
 	{
 	//========== Variable ==========
-	M2MJSON *json = NULL;
-	M2MJSONType type;
-	M2MString *jsonM2MString = NULL;
-	M2MString *copy = NULL;
-	size_t stringLength = 0;
-	size_t jsonM2MStringLength = 0;
-	const size_t LEFT_SQUARE_BRACKET_LENGTH = M2MString_length(M2MString_LEFT_SQUARE_BRACKET);
-	const size_t COMMA_LENGTH = M2MString_length(M2MString_COMMA);
+	bool first = true;
 	const M2MString *METHOD_NAME = (M2MString *)"M2MJSON.this_toM2MStringFromArray()";
 
 	//===== Check argument =====
-	if (array!=NULL && buffer!=NULL)
+	if (array!=NULL && builder!=NULL)
 		{
 		//===== Check argument =====
-		if ((array=M2MJSON_getRootArray(array))!=NULL)
+		if ((array=M2MJSON_getRootArray(array))!=NULL
+				&& M2MStringBuilder_appendCharacter(builder, (M2MString)'[')!=NULL)
 			{
-			//========== In the case of existing JSON Object is only one ==========
-			if (M2MJSON_getArraySize(array)==1)
+			//===== Loop while not achieving to last Array node =====
+			while (array!=NULL)
 				{
-				//===== Get JSON from Array node =====
-				if ((json=array->json)!=NULL)
+				//===== Append "," and JSON of Array node =====
+				if (array->json!=NULL
+						&& (first==true || M2MStringBuilder_appendCharacter(builder, (M2MString)',')!=NULL)
+						&& this_toM2MStringFromJSON(array->json, builder)!=NULL)
 					{
-					if ((type=M2MJSON_getType(json))==M2MJSONType_ARRAY)
-						{
-						this_toM2MStringFromArray(M2MJSON_getArray(json), &jsonM2MString);
-						}
-					else if (type==M2MJSONType_BOOLEAN)
-						{
-						this_toM2MStringFromBoolean(json, &jsonM2MString);
-						}
-					else if (type==M2MJSONType_NUMBER)
-						{
-						this_toM2MStringFromNumber(json, &jsonM2MString);
-						}
-					else if (type==M2MJSONType_OBJECT)
-						{
-						this_toM2MStringFromObject(M2MJSON_getObject(json), &jsonM2MString);
-						}
-					else if (type==M2MJSONType_STRING)
-						{
-						this_toStringFromString(json, &jsonM2MString);
-						}
-					else
-						{
-						return NULL;
-						}
-					//===== Check existence of JSON string =====
-					if (jsonM2MString!=NULL)
-						{
-						//===== Get length of JSON string =====
-						if ((jsonM2MStringLength=M2MString_length(jsonM2MString))>0)
-							{
-							//===== Allocate new memory for copying JSON string =====
-							if (((*buffer)=(M2MString *)M2MHeap_malloc(LEFT_SQUARE_BRACKET_LENGTH+jsonM2MStringLength+1))!=NULL)
-								{
-								//===== Connect strings =====
-								memcpy(&((*buffer)[0]), M2MString_LEFT_SQUARE_BRACKET, LEFT_SQUARE_BRACKET_LENGTH);
-								memcpy(&((*buffer)[LEFT_SQUARE_BRACKET_LENGTH]), jsonM2MString, jsonM2MStringLength);
-								//===== Release allocated memory =====
-								M2MHeap_free(jsonM2MString);
-								//===== Update string length =====
-								stringLength = M2MString_length((*buffer));
-								}
-							//===== Error handling =====
-							else
-								{
-								//===== Release allocated memory =====
-								M2MHeap_free(jsonM2MString);
-								return NULL;
-								}
-							}
-						//===== Error handling =====
-						else
-							{
-							//===== Release allocated memory =====
-							M2MHeap_free(jsonM2MString);
-							return NULL;
-							}
-						}
-					//===== Error handling =====
-					else
-						{
-						return NULL;
-						}
-					}
-				//===== Error handling =====
-				else
-					{
-					return NULL;
-					}
-				}
-			//========== In the case of existing JSON Object is many ==========
-			else
-				{
-				//===== Loop while not achieving to last node =====
-				while (M2MJSON_getNextArray(array)!=NULL)
-					{
-					//===== Get JSON from Array node =====
-					if ((json=array->json)!=NULL)
-						{
-						if ((type=M2MJSON_getType(json))==M2MJSONType_ARRAY)
-							{
-							this_toM2MStringFromArray(M2MJSON_getArray(json), &jsonM2MString);
-							}
-						else if (type==M2MJSONType_BOOLEAN)
-							{
-							this_toM2MStringFromBoolean(json, &jsonM2MString);
-							}
-						else if (type==M2MJSONType_NUMBER)
-							{
-							this_toM2MStringFromNumber(json, &jsonM2MString);
-							}
-						else if (type==M2MJSONType_OBJECT)
-							{
-							this_toM2MStringFromObject(M2MJSON_getObject(json), &jsonM2MString);
-							}
-						else if (type==M2MJSONType_STRING)
-							{
-							this_toStringFromString(json, &jsonM2MString);
-							}
-						//===== Error handling =====
-						else
-							{
-							if ((*buffer)!=NULL)
-								{
-								M2MHeap_free((*buffer));
-								}
-							else
-								{
-								}
-							return NULL;
-							}
-						//===== Check existence of string =====
-						if (jsonM2MString!=NULL)
-							{
-							if ((jsonM2MStringLength=M2MString_length(jsonM2MString))>0)
-								{
-								//===== In the case of first Array node(need to append "[") =====
-								if (stringLength==0)
-									{
-									(*buffer) = (M2MString *)M2MHeap_malloc(LEFT_SQUARE_BRACKET_LENGTH+jsonM2MStringLength+1);
-									//===== Connect strings =====
-									memcpy(&((*buffer)[0]), M2MString_LEFT_SQUARE_BRACKET, LEFT_SQUARE_BRACKET_LENGTH);
-									memcpy(&((*buffer)[LEFT_SQUARE_BRACKET_LENGTH]), jsonM2MString, jsonM2MStringLength);
-									//===== Release memory =====
-									M2MHeap_free(jsonM2MString);
-									}
-								//===== In the case of 2nd Array node later(need to append ",") =====
-								else
-									{
-									//=====  =====
-									copy = (M2MString *)M2MHeap_malloc(stringLength+1);
-									memcpy(copy, (*buffer), stringLength);
-									//=====  =====
-									M2MHeap_free((*buffer));
-									(*buffer) = (M2MString *)M2MHeap_malloc(stringLength+COMMA_LENGTH+jsonM2MStringLength+1);
-									//===== Connect strings =====
-									memcpy(&((*buffer)[0]), copy, stringLength);
-									memcpy(&((*buffer)[stringLength]), M2MString_COMMA, COMMA_LENGTH);
-									memcpy(&((*buffer)[stringLength+COMMA_LENGTH]), jsonM2MString, jsonM2MStringLength);
-									//===== Release memory =====
-									M2MHeap_free(copy);
-									M2MHeap_free(jsonM2MString);
-									}
-								//===== Update string length =====
-								stringLength = M2MString_length((*buffer));
-								}
-							//===== Error handling =====
-							else
-								{
-								//===== Release memory =====
-								M2MHeap_free(jsonM2MString);
-								if ((*buffer)!=NULL)
-									{
-									M2MHeap_free((*buffer));
-									}
-								else
-									{
-									}
-								return NULL;
-								}
-							}
-						//===== Error handling =====
-						else
-							{
-							if ((*buffer)!=NULL)
-								{
-								M2MHeap_free((*buffer));
-								}
-							else
-								{
-								}
-							return NULL;
-							}
-						}
-					//===== Error handling =====
-					else
-						{
-						if ((*buffer)!=NULL)
-							{
-							M2MHeap_free((*buffer));
-							}
-						else
-							{
-							}
-						return NULL;
-						}
 					//===== Go to next Array node =====
+					first = false;
 					array = M2MJSON_getNextArray(array);
 					}
-				//===== Check last Array node =====
-				if ((json=array->json)!=NULL)
-					{
-					if ((type=M2MJSON_getType(json))==M2MJSONType_ARRAY)
-						{
-						this_toM2MStringFromArray(M2MJSON_getArray(json), &jsonM2MString);
-						}
-					else if (type==M2MJSONType_BOOLEAN)
-						{
-						this_toM2MStringFromBoolean(json, &jsonM2MString);
-						}
-					else if (type==M2MJSONType_NUMBER)
-						{
-						this_toM2MStringFromNumber(json, &jsonM2MString);
-						}
-					else if (type==M2MJSONType_OBJECT)
-						{
-						this_toM2MStringFromObject(M2MJSON_getObject(json), &jsonM2MString);
-						}
-					else if (type==M2MJSONType_STRING)
-						{
-						this_toStringFromString(json, &jsonM2MString);
-						}
-					//===== Error handling =====
-					else
-						{
-						if ((*buffer)!=NULL)
-							{
-							M2MHeap_free((*buffer));
-							}
-						else
-							{
-							}
-						return NULL;
-						}
-					//===== Check existence of JSON string =====
-					if (jsonM2MString!=NULL)
-						{
-						//===== Get length of JSON string =====
-						if ((jsonM2MStringLength=M2MString_length(jsonM2MString))>0)
-							{
-							//===== Copy string into temporary buffer =====
-							copy = (M2MString *)M2MHeap_malloc(stringLength+1);
-							memcpy(copy, (*buffer), stringLength);
-							//===== Allocate new memory for connecting string =====
-							M2MHeap_free((*buffer));
-							(*buffer) = (M2MString *)M2MHeap_malloc(stringLength+COMMA_LENGTH+jsonM2MStringLength+1);
-							//===== Connect strings =====
-							memcpy(&((*buffer)[0]), copy, stringLength);
-							memcpy(&((*buffer)[stringLength]), M2MString_COMMA, COMMA_LENGTH);
-							memcpy(&((*buffer)[stringLength+COMMA_LENGTH]), jsonM2MString, jsonM2MStringLength);
-							//===== Release memory =====
-							M2MHeap_free(copy);
-							M2MHeap_free(jsonM2MString);
-							//===== Update string length =====
-							stringLength = M2MString_length((*buffer));
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MHeap_free(jsonM2MString);
-							if ((*buffer)!=NULL)
-								{
-								M2MHeap_free((*buffer));
-								}
-							else
-								{
-								}
-							return NULL;
-							}
-						}
-					//===== Error handling =====
-					else
-						{
-						if ((*buffer)!=NULL)
-							{
-							M2MHeap_free((*buffer));
-							}
-						else
-							{
-							}
-						return NULL;
-						}
-					}
 				//===== Error handling =====
 				else
 					{
-					if ((*buffer)!=NULL)
-						{
-						M2MHeap_free((*buffer));
-						}
-					else
-						{
-						}
 					return NULL;
 					}
 				}
 			//===== Append "]" to close JSON Array syntax =====
-			if (M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL)
-				{
-				return (*buffer);
-				}
-			else
-				{
-				M2MHeap_free((*buffer));
-				return NULL;
-				}
+			return M2MStringBuilder_appendCharacter(builder, (M2MString)']');
 			}
 		else
 			{
@@ -1537,33 +1261,33 @@ static unsigned char *this_toM2MStringFromArray (M2MJSONArray *array, M2MString
 		}
 	else
 		{
-		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"");
+		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"builder\" is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * This method translate from JSON Boolean object to JSON form string.<br>
+ * This method appends JSON Boolean object as JSON form string to the buffer.<br>
  *
- * @param[in] self		JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toM2MStringFromBoolean (M2MJSON *self, M2MString **buffer)
+static M2MStringBuilder *this_toM2MStringFromBoolean (M2MJSON *self, M2MStringBuilder *builder)
 	{
 	//========== Variable ==========
 	M2MString boolean[8];
 	const M2MString *METHOD_NAME = (M2MString *)"M2MJSON.this_toM2MStringFromBoolean()";
 
 	//===== Check argument =====
-	if (self!=NULL && buffer!=NULL)
+	if (self!=NULL && builder!=NULL)
 		{
 		//===== Check JSON type =====
 		if (M2MJSON_getType(self)==M2MJSONType_BOOLEAN
 				&& M2MString_convertFromBooleanToString(M2MJSON_getBoolean(self), boolean, sizeof(boolean))!=NULL)
 			{
-			return M2MString_append(buffer, boolean);
+			return M2MStringBuilder_append(builder, boolean);
 			}
 		//===== Error handling =====
 		else
@@ -1580,32 +1304,75 @@ static M2MString *this_toM2MStringFromBoolean (M2MJSON *self, M2MString **buffer
 		}
 	else
 		{
-		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"string\" is NULL");
+		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"builder\" is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * This method translate from JSON Number to JSON form string.<br>
+ * This method appends JSON object of any type as JSON form string to the <br>
+ * buffer.<br>
  *
- * @param[in] self		JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static M2MString *this_toM2MStringFromNumber (M2MJSON *self, M2MString **buffer)
+static M2MStringBuilder *this_toM2MStringFromJSON (M2MJSON *self, M2MStringBuilder *builder)
+	{
+	//========== Variable ==========
+	M2MJSONType type;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MJSON.this_toM2MStringFromJSON()";
+
+	//===== Get JSON type =====
+	if ((type=M2MJSON_getType(self))==M2MJSONType_ARRAY)
+		{
+		return this_toM2MStringFromArray(M2MJSON_getArray(self), builder);
+		}
+	else if (type==M2MJSONType_BOOLEAN)
+		{
+		return this_toM2MStringFromBoolean(self, builder);
+		}
+	else if (type==M2MJSONType_NUMBER)
+		{
+		return this_toM2MStringFromNumber(self, builder);
+		}
+	else if (type==M2MJSONType_OBJECT)
+		{
+		return this_toM2MStringFromObject(M2MJSON_getObject(self), builder);
+		}
+	else if (type==M2MJSONType_STRING)
+		{
+		return this_toStringFromString(self, builder);
+		}
+	//===== Error handling =====
+	else
+		{
+		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Type of Argument \"JSON\" is invalid");
+		return NULL;
+		}
+	}
+
+
+/**
+ * This method appends JSON Number as JSON form string to the buffer.<br>
+ *
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
+ */
+static M2MStringBuilder *this_toM2MStringFromNumber (M2MJSON *self, M2MStringBuilder *builder)
 	{
 	//========== Variable ==========
 	const M2MString *METHOD_NAME = (M2MString *)"M2MJSON.this_toM2MStringFromNumber()";
 
 	//===== Check argument =====
-	if (self!=NULL && buffer!=NULL)
+	if (self!=NULL && builder!=NULL)
 		{
 		//===== Check JSON type =====
-		if (M2MJSON_getType(self)==M2MJSONType_NUMBER
-				&& M2MString_convertFromDoubleToString(M2MJSON_getNumber(self), buffer)!=NULL)
+		if (M2MJSON_getType(self)==M2MJSONType_NUMBER)
 			{
-			return *buffer;
+			return M2MStringBuilder_appendDouble(builder, M2MJSON_getNumber(self));
 			}
 		//===== Error handling =====
 		else
@@ -1622,344 +1389,52 @@ static M2MString *this_toM2MStringFromNumber (M2MJSON *self, M2MString **buffer)
 		}
 	else
 		{
-		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"string\" is NULL");
+		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"builder\" is NULL");
 		return NULL;
 		}
 	}
 
 
 /**
- * This method translate from JSON Object to JSON form string.<br>
+ * This method appends JSON Object as JSON form string to the buffer.<br>
  *
- * @param[in] object	JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] object		JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static unsigned char *this_toM2MStringFromObject (M2MJSONObject *object, M2MString **buffer)
+static M2MStringBuilder *this_toM2MStringFromObject (M2MJSONObject *object, M2MStringBuilder *builder)
 	{
 	//========== Variable ==========
-	M2MJSON *this = NULL;
-	M2MJSONType type;
-	M2MString *jsonM2MString = NULL;
-	M2MString *copy = NULL;
 	M2MString *key = NULL;
-	size_t stringLength = 0;
-	size_t jsonM2MStringLength = 0;
-	const size_t COMMA_LENGTH = M2MString_length(M2MString_COMMA);
-	const size_t LEFT_CURLY_BRACKET_LENGTH = M2MString_length(M2MString_LEFT_CURLY_BRACKET);
-	const size_t COLON_LENGTH = M2MString_length(M2MString_COLON);
-	const size_t DOUBLE_QUOTATION_LENGTH = M2MString_length(M2MString_DOUBLE_QUOTATION);
+	bool first = true;
 
 	//===== Check argument =====
-	if ((object=M2MJSON_getRootObject(object))!=NULL)
-		{
-		//========== In the case of existing JSON Object is only one ==========
-		if (M2MJSON_getObjectSize(object)==1)
-			{
-			//===== Get JSON from Object node =====
-			if ((key=M2MJSON_getKey(object))!=NULL && (this=object->json)!=NULL)
+	if ((object=M2MJSON_getRootObject(object))!=NULL && builder!=NULL
+			&& M2MStringBuilder_appendCharacter(builder, (M2MString)'{')!=NULL)
+		{
+		//===== Loop while not achieving to last Object node =====
+		while (object!=NULL)
+			{
+			//===== Append ",", "key": and JSON of Object node =====
+			if ((key=M2MJSON_getKey(object))!=NULL && object->json!=NULL
+					&& (first==true || M2MStringBuilder_appendCharacter(builder, (M2MString)',')!=NULL)
+					&& M2MStringBuilder_appendCharacter(builder, (M2MString)'"')!=NULL
+					&& M2MStringBuilder_append(builder, key)!=NULL
+					&& M2MStringBuilder_append(builder, (M2MString *)"\":")!=NULL
+					&& this_toM2MStringFromJSON(object->json, builder)!=NULL)
 				{
-				if ((type=M2MJSON_getType(this))==M2MJSONType_ARRAY)
-					{
-					this_toM2MStringFromArray(M2MJSON_getArray(this), &jsonM2MString);
-					}
-				else if (type==M2MJSONType_BOOLEAN)
-					{
-					this_toM2MStringFromBoolean(this, &jsonM2MString);
-					}
-				else if (type==M2MJSONType_NUMBER)
-					{
-					this_toM2MStringFromNumber(this, &jsonM2MString);
-					}
-				else if (type==M2MJSONType_OBJECT)
-					{
-					this_toM2MStringFromObject(M2MJSON_getObject(this), &jsonM2MString);
-					}
-				else if (type==M2MJSONType_STRING)
-					{
-					this_toStringFromString(this, &jsonM2MString);
-					}
-				else
-					{
-					return NULL;
-					}
-				//===== Check existence of string =====
-				if (jsonM2MString!=NULL)
-					{
-					if (jsonM2MString!=NULL && (jsonM2MStringLength=M2MString_length(jsonM2MString))>0)
-						{
-						//===== Allocate new memory for connecting string =====
-						(*buffer) = (M2MString *)M2MHeap_malloc(LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH+jsonM2MStringLength+1);
-						//===== Connect strings =====
-						memcpy(&((*buffer)[0]), M2MString_LEFT_CURLY_BRACKET, LEFT_CURLY_BRACKET_LENGTH);
-						memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-						memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH]), key, M2MString_length(key));
-						memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-						memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH]), M2MString_COLON, COLON_LENGTH);
-						memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH]), jsonM2MString, jsonM2MStringLength);
-						//===== Release memory =====
-						M2MHeap_free(jsonM2MString);
-						//===== Update string length =====
-						stringLength = M2MString_length((*buffer));
-						}
-					//===== Error handling =====
-					else
-						{
-						//===== Release memory =====
-						M2MHeap_free(jsonM2MString);
-						return NULL;
-						}
-					}
-				//===== Error handling =====
-				else
-					{
-					return NULL;
-					}
-				}
-			//===== Error handling =====
-			else
-				{
-				return NULL;
-				}
-			}
-		//========== In the case of existing JSON Object is many ==========
-		else
-			{
-			//========== Loop while not achieving to last Object node ==========
-			while (M2MJSON_getNextObject(object)!=NULL)
-				{
-				//===== Get JSON from Object node =====
-				if ((key=M2MJSON_getKey(object))!=NULL && (this=object->json)!=NULL)
-					{
-					if ((type=M2MJSON_getType(this))==M2MJSONType_ARRAY)
-						{
-						this_toM2MStringFromArray(M2MJSON_getArray(this), &jsonM2MString);
-						}
-					else if (type==M2MJSONType_BOOLEAN)
-						{
-						this_toM2MStringFromBoolean(this, &jsonM2MString);
-						}
-					else if (type==M2MJSONType_NUMBER)
-						{
-						this_toM2MStringFromNumber(this, &jsonM2MString);
-						}
-					else if (type==M2MJSONType_OBJECT)
-						{
-						this_toM2MStringFromObject(M2MJSON_getObject(this), &jsonM2MString);
-						}
-					else if (type==M2MJSONType_STRING)
-						{
-						this_toStringFromString(this, &jsonM2MString);
-						}
-					//===== Error handling =====
-					else
-						{
-						if ((*buffer)!=NULL)
-							{
-							M2MHeap_free((*buffer));
-							}
-						else
-							{
-							}
-						return NULL;
-						}
-					//===== Check existence of string =====
-					if (jsonM2MString!=NULL)
-						{
-						if (jsonM2MString!=NULL && (jsonM2MStringLength=M2MString_length(jsonM2MString))>0)
-							{
-							//===== In the case of first Array node(need to append "[") =====
-							if (stringLength==0)
-								{
-								//===== Allocate new memory for connecting string =====
-								M2MHeap_free((*buffer));
-								(*buffer) = (M2MString *)M2MHeap_malloc(LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH+jsonM2MStringLength+1);
-								//===== Connect strings =====
-								memcpy(&((*buffer)[0]), M2MString_LEFT_CURLY_BRACKET, LEFT_CURLY_BRACKET_LENGTH);
-								memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-								memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH]), key, M2MString_length(key));
-								memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-								memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH]), M2MString_COLON, COLON_LENGTH);
-								memcpy(&((*buffer)[LEFT_CURLY_BRACKET_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH]), jsonM2MString, jsonM2MStringLength);
-								//===== Release memory =====
-								M2MHeap_free(jsonM2MString);
-								}
-							//===== In the case of 2nd Array node later(need to append ",") =====
-							else
-								{
-								//=====  =====
-								copy = (M2MString *)M2MHeap_malloc(stringLength+1);
-								memcpy(copy, (*buffer), stringLength);
-								//===== Allocate new memory for connecting string =====
-								M2MHeap_free((*buffer));
-								(*buffer) = (M2MString *)M2MHeap_malloc(stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH+jsonM2MStringLength+1);
-								//===== Connect strings =====
-								memcpy(&((*buffer)[0]), copy, stringLength);
-								memcpy(&((*buffer)[stringLength]), M2MString_COMMA, COMMA_LENGTH);
-								memcpy(&((*buffer)[stringLength+COMMA_LENGTH]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-								memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH]), key, M2MString_length(key));
-								memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-								memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH]), M2MString_COLON, COLON_LENGTH);
-								memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH]), jsonM2MString, jsonM2MStringLength);
-								//===== Release memory =====
-								M2MHeap_free(copy);
-								M2MHeap_free(jsonM2MString);
-								}
-							//===== Update string length =====
-							stringLength = M2MString_length((*buffer));
-							}
-						//===== Error handling =====
-						else
-							{
-							M2MHeap_free(jsonM2MString);
-							if ((*buffer)!=NULL)
-								{
-								M2MHeap_free((*buffer));
-								}
-							else
-								{
-								}
-							return NULL;
-							}
-						}
-					//===== Error handling =====
-					else
-						{
-						if ((*buffer)!=NULL)
-							{
-							M2MHeap_free((*buffer));
-							}
-						else
-							{
-							}
-						return NULL;
-						}
-					}
-				//===== Error handling =====
-				else
-					{
-					if ((*buffer)!=NULL)
-						{
-						M2MHeap_free((*buffer));
-						}
-					else
-						{
-						}
-					return NULL;
-					}
-				//===== Go to next Array node =====
+				//===== Go to next Object node =====
+				first = false;
 				object = M2MJSON_getNextObject(object);
 				}
-			//========== Check last Array node ==========
-			if ((key=M2MJSON_getKey(object))!=NULL && (this=object->json)!=NULL)
-				{
-				if ((type=M2MJSON_getType(this))==M2MJSONType_ARRAY)
-					{
-					this_toM2MStringFromArray(M2MJSON_getArray(this), &jsonM2MString);
-					}
-				else if (type==M2MJSONType_BOOLEAN)
-					{
-					this_toM2MStringFromBoolean(this, &jsonM2MString);
-					}
-				else if (type==M2MJSONType_NUMBER)
-					{
-					this_toM2MStringFromNumber(this, &jsonM2MString);
-					}
-				else if (type==M2MJSONType_OBJECT)
-					{
-					this_toM2MStringFromObject(M2MJSON_getObject(this), &jsonM2MString);
-					}
-				else if (type==M2MJSONType_STRING)
-					{
-					this_toStringFromString(this, &jsonM2MString);
-					}
-				//===== Error handling =====
-				else
-					{
-					if ((*buffer)!=NULL)
-						{
-						M2MHeap_free((*buffer));
-						}
-					else
-						{
-						}
-					return NULL;
-					}
-				//===== Check existence of string =====
-				if (jsonM2MString!=NULL)
-					{
-					if (jsonM2MString!=NULL && (jsonM2MStringLength=M2MString_length(jsonM2MString))>0)
-						{
-						//===== Copy string into temporary buffer =====
-						copy = (M2MString *)M2MHeap_malloc(stringLength+1);
-						memcpy(copy, (*buffer), stringLength);
-						//===== Allocate new memory for connecting string =====
-						M2MHeap_free((*buffer));
-						(*buffer) = (M2MString *)M2MHeap_malloc(stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH+jsonM2MStringLength+1);
-						//===== Connect strings =====
-						memcpy(&((*buffer)[0]), copy, stringLength);
-						memcpy(&((*buffer)[stringLength]), M2MString_COMMA, COMMA_LENGTH);
-						memcpy(&((*buffer)[stringLength+COMMA_LENGTH]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-						memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH]), key, M2MString_length(key));
-						memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-						memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH]), M2MString_COLON, COLON_LENGTH);
-						memcpy(&((*buffer)[stringLength+COMMA_LENGTH+DOUBLE_QUOTATION_LENGTH+M2MString_length(key)+DOUBLE_QUOTATION_LENGTH+COLON_LENGTH]), jsonM2MString, jsonM2MStringLength);
-						//===== Release memory =====
-						M2MHeap_free(copy);
-						M2MHeap_free(jsonM2MString);
-						//===== Update string length =====
-						stringLength = M2MString_length((*buffer));
-						}
-					//===== Error handling =====
-					else
-						{
-						M2MHeap_free(jsonM2MString);
-						if ((*buffer)!=NULL)
-							{
-							M2MHeap_free((*buffer));
-							}
-						else
-							{
-							}
-						return NULL;
-						}
-					}
-				//===== Error handling =====
-				else
-					{
-					if ((*buffer)!=NULL)
-						{
-						M2MHeap_free((*buffer));
-						}
-					else
-						{
-						}
-					return NULL;
-					}
-				}
 			//===== Error handling =====
 			else
 				{
-				if ((*buffer)!=NULL)
-					{
-					M2MHeap_free((*buffer));
-					}
-				else
-					{
-					}
 				return NULL;
 				}
 			}
 		//===== Append "}" to close syntax =====
-		if (M2MString_append(buffer, M2MString_RIGHT_CURLY_BRACKET)!=NULL)
-			{
-			return (*buffer);
-			}
-		else
-			{
-			M2MHeap_free((*buffer));
-			return NULL;
-			}
+		return M2MStringBuilder_appendCharacter(builder, (M2MString)'}');
 		}
 	//===== Argument error =====
 	else
@@ -1970,38 +1445,33 @@ static unsigned char *this_toM2MStringFromObject (M2MJSONObject *object, M2MStri
 
 
 /**
- * This method translate from JSON M2MString to JSON form string.<br>
+ * This method appends JSON M2MString as JSON form string to the buffer.<br>
  *
- * @param[in] self		JSON object
- * @param[out] buffer	buffer for copying translated JSON form string
- * @return				translated JSON form string or NULL(means error)
+ * @param[in] self			JSON object
+ * @param[in,out] builder	buffer for appending translated JSON form string
+ * @return					buffer or NULL(means error)
  */
-static unsigned char *this_toStringFromString (M2MJSON *self, M2MString **string)
+static M2MStringBuilder *this_toStringFromString (M2MJSON *self, M2MStringBuilder *builder)
 	{
 	//========== Variable ==========
 	M2MString *value = NULL;
-	size_t valueLength = 0;
-	const unsigned int DOUBLE_QUOTATION_LENGTH = M2MString_length(M2MString_DOUBLE_QUOTATION);
 	const M2MString *METHOD_NAME = (M2MString *)"M2MJSON.this_toStringFromString()";
 
 	//===== Check argument =====
-	if (self!=NULL && string!=NULL)
+	if (self!=NULL && builder!=NULL)
 		{
 		//===== Check JSON type =====
 		if (M2MJSON_getType(self)==M2MJSONType_STRING)
 			{
-			//===== Get string value and length =====
-			if ((value=M2MJSON_getString(self))!=NULL
-					&& (valueLength=M2MString_length(value))>0)
+			//===== Get string value =====
+			if ((value=M2MJSON_getString(self))!=NULL)
 				{
-				//===== Allocate new memory for JSON M2MString =====
-				if (((*string)=(unsigned char *)M2MHeap_malloc(DOUBLE_QUOTATION_LENGTH+valueLength+DOUBLE_QUOTATION_LENGTH+1))!=NULL)
+				//===== Append string value enclosed with double quotations =====
+				if (M2MStringBuilder_appendCharacter(builder, (M2MString)'"')!=NULL
+						&& M2MStringBuilder_append(builder, value)!=NULL
+						&& M2MStringBuilder_appendCharacter(builder, (M2MString)'"')!=NULL)
 					{
-					//===== Copy string value into buffer =====
-					memcpy(&((*string)[0]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-					memcpy(&((*string)[DOUBLE_QUOTATION_LENGTH]), value, valueLength);
-					memcpy(&((*string)[DOUBLE_QUOTATION_LENGTH+valueLength]), M2MString_DOUBLE_QUOTATION, DOUBLE_QUOTATION_LENGTH);
-					return (*string);
+					return builder;
 					}
 				//===== Error handling =====
 				else
@@ -2011,14 +1481,9 @@ static unsigned char *this_toStringFromString (M2MJSON *self, M2MString **string
 					}
 				}
 			//===== Error handling =====
-			else if (value==NULL)
-				{
-				this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Failed to get string value from JSON");
-				return NULL;
-				}
 			else
 				{
-				this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Failed to get length of string value from JSON");
+				this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Failed to get string value from JSON");
 				return NULL;
 				}
 			}
@@ -2037,7 +1502,7 @@ static unsigned char *this_toStringFromString (M2MJSON *self, M2MString **string
 		}
 	else
 		{
-		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"string\" is NULL");
+		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"builder\" is NULL");
 		return NULL;
 		}
 	}
@@ -3795,51 +3260,55 @@ M2MJSON *M2MJSON_setType (M2MJSON *self, const M2MJSONType type)
 M2MString *M2MJSON_toString (M2MJSON *self, M2MString **buffer)
 	{
 	//========== Variable ==========
-	M2MJSONType type;
+	M2MStringBuilder builder;
 	const M2MString *METHOD_NAME = (M2MString *)"M2MJSON_toString()";
 
 	//===== Check argument =====
-	if (self!=NULL)
+	if (self!=NULL && buffer!=NULL)
 		{
-		//===== Get JSON type =====
-		if ((type=M2MJSON_getType(self))==M2MJSONType_ARRAY)
-			{
-			return this_toM2MStringFromArray(M2MJSON_getArray(self), buffer);
-			}
-		else if (type==M2MJSONType_BOOLEAN)
-			{
-			return this_toM2MStringFromBoolean(self, buffer);
-			}
-		else if (type==M2MJSONType_NULL)
+		//===== Check JSON type =====
+		if (M2MJSON_getType(self)==M2MJSONType_NULL)
 			{
 			this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Type of Argument \"JSON\" is \"M2MJSONType_NULL\"");
 			return NULL;
 			}
-		else if (type==M2MJSONType_NUMBER)
-			{
-			return this_toM2MStringFromNumber(self, buffer);
-			}
-		else if (type==M2MJSONType_OBJECT)
-			{
-			return this_toM2MStringFromObject(M2MJSON_getObject(self), buffer);
-			}
-		else if (type==M2MJSONType_STRING)
+		//===== Translate into one buffer (amortized O(1) per byte) =====
+		else if (this_toM2MStringFromJSON(self, M2MStringBuilder_init(&builder))!=NULL)
 			{
-			return this_toStringFromString(self, buffer);
+			//===== Hand over the buffer to the caller =====
+			if ((*buffer)==NULL)
+				{
+				(*buffer) = M2MStringBuilder_detach(&builder);
+				}
+			else if (M2MString_appendLength(buffer, M2MStringBuilder_getString(&builder), M2MStringBuilder_getLength(&builder))==NULL)
+				{
+				M2MHeap_free((*buffer));
+				}
+			else
+				{
+				// do nothing
+				}
+			M2MStringBuilder_release(&builder);
+			return (*buffer);
 			}
 		//===== Error handling =====
 		else
 			{
-			this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Type of Argument \"JSON\" is invalid");
+			M2MStringBuilder_release(&builder);
 			return NULL;
 			}
 		}
 	//===== Argument error =====
-	else
+	else if (self==NULL)
 		{
 		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"JSON\" is NULL");
 		return NULL;
 		}
+	else
+		{
+		this_printErrorMessage(METHOD_NAME, __LINE__, (M2MString *)"Argument \"buffer\" is NULL");
+		return NULL;
+		}
 	}
 
 
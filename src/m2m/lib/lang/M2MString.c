@@ -406,37 +406,21 @@ M2MString *M2MString_append (M2MString **self, const M2MString *string)
 		//===== In the case of concatenation string existing =====
 		if ((*self)!=NULL)
 			{
-			//===== Preparation for temporarily copying the original string =====
-			if( (selfLength=M2MString_length((*self)))>0
-				&& (tmp=(M2MString *)M2MHeap_malloc(selfLength+1))!=NULL)
+			//===== Enlarge heap memory of the original string (without temporary copy) =====
+			selfLength = M2MString_length((*self));
+			if ((tmp=(M2MString *)M2MHeap_realloc((*self), selfLength+stringLength+1))!=NULL)
 				{
-				//===== Temporarily copy the source string =====
-				memcpy(tmp, (*self), selfLength);
-				//===== Release heap memory of consolidation string =====
-				M2MHeap_free((*self));
-				//===== Acquire heap memory of concatenated string =====
-				if (((*self)=(M2MString *)M2MHeap_malloc(selfLength+stringLength+1))!=NULL)
-					{
-					//===== Concatenate strings =====
-					memcpy(&((*self)[0]), tmp, selfLength);
-					memcpy(&((*self)[selfLength]), string, stringLength);
-					//===== Release temporary heap memory =====
-					M2MHeap_free(tmp);
-					//===== Return pointer of concatenated string =====
-					return (*self);
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MHeap_free(tmp);
-					this_printErrorMessage(__func__, __LINE__, (M2MString *)"Failed to get heap memory for copying string into pointer");
-					return NULL;
-					}
+				//===== Concatenate strings =====
+				(*self) = tmp;
+				memcpy(&((*self)[selfLength]), string, stringLength);
+				(*self)[selfLength+stringLength] = '\0';
+				//===== Return pointer of concatenated string =====
+				return (*self);
 				}
 			//===== Error handling =====
 			else
 				{
-				this_printErrorMessage(__func__, __LINE__, (M2MString *)"Failed to get heap memory for copying string temporary");
+				this_printErrorMessage(__func__, __LINE__, (M2MString *)"Failed to get heap memory for copying string into pointer");
 				return NULL;
 				}
 			}
@@ -494,37 +478,21 @@ M2MString *M2MString_appendLength (M2MString **self, const M2MString *string, co
 		//===== When the string of the concatenation source exists =====
 		if ((*self)!=NULL)
 			{
-			//===== Preparation for temporarily copying the original string =====
-			if( (thisLength=M2MString_length((*self)))>0
-				&& (tmp=(M2MString *)M2MHeap_malloc(thisLength+1))!=NULL)
+			//===== Enlarge heap memory of the original string (without temporary copy) =====
+			thisLength = M2MString_length((*self));
+			if ((tmp=(M2MString *)M2MHeap_realloc((*self), thisLength+stringLength+1))!=NULL)
 				{
-				//===== Temporarily copy the source string =====
-				memcpy(tmp, (*self), thisLength);
-				//===== Rlease heap memory of consolidation source =====
-				M2MHeap_free((*self));
-				//===== Get heap memory of concatenated string =====
-				if (((*self)=(M2MString *)M2MHeap_malloc(thisLength+stringLength+1))!=NULL)
-					{
-					//===== Concatenate strings =====
-					memcpy(&((*self)[0]), tmp, thisLength);
-					memcpy(&((*self)[thisLength]), string, stringLength);
-					//===== Release temporary buffer heap memory =====
-					M2MHeap_free(tmp);
-					//===== Return pointer of concatenated string =====
-					return (*self);
-					}
-				//===== Error handling =====
-				else
-					{
-					M2MHeap_free(tmp);
-					this_printErrorMessage(__func__, __LINE__, (M2MString *)"Failed to get heap memory for copying string into pointer");
-					return NULL;
-					}
+				//===== Concatenate strings =====
+				(*self) = tmp;
+				memcpy(&((*self)[thisLength]), string, stringLength);
+				(*self)[thisLength+stringLength] = '\0';
+				//===== Return pointer of concatenated string =====
+				return (*self);
 				}
 			//===== Error handling =====
 			else
 				{
-				this_printErrorMessage(__func__, __LINE__, (M2MString *)"Failed to get heap memory for copying string temporary");
+				this_printErrorMessage(__func__, __LINE__, (M2MString *)"Failed to get heap memory for copying string into pointer");
 				return NULL;
 				}
 			}
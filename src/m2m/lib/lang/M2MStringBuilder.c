@@ -0,0 +1,599 @@
+/*******************************************************************************
+ * M2MStringBuilder.c : Growable string buffer for amortized O(1) concatenation
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/lib/lang/M2MStringBuilder.h"
+
+
+
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Print out the error message to the standard error.<br>
+ * (The logger itself is built on this object, so it isn't used here.)<br>
+ *
+ * @param[in] functionName	String indicating function name
+ * @param[in] lineNumber	Line number in source file
+ * @param[in] message		Message string
+ */
+static void this_printErrorMessage (const M2MString *functionName, const uint32_t lineNumber, const M2MString *message);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Print out the error message to the standard error.<br>
+ * (The logger itself is built on this object, so it isn't used here.)<br>
+ *
+ * @param[in] functionName	String indicating function name
+ * @param[in] lineNumber	Line number in source file
+ * @param[in] message		Message string
+ */
+static void this_printErrorMessage (const M2MString *functionName, const uint32_t lineNumber, const M2MString *message)
+	{
+	//========== Variable ==========
+	M2MString logMessage[512];
+
+	//===== Create new log message =====
+	memset(logMessage, 0, sizeof(logMessage));
+	if (snprintf(logMessage, sizeof(logMessage), (M2MString *)"[ERROR][%s:%ul][%s]", functionName, lineNumber, message)>0)
+		{
+		//===== Print out log =====
+		M2MSystem_errPrintln(logMessage);
+		}
+	//===== Error handling =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Append the string at the end of the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] string	String to be appended
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_append (M2MStringBuilder *self, const M2MString *string)
+	{
+	//===== Check argument =====
+	if (string!=NULL)
+		{
+		return M2MStringBuilder_appendLength(self, string, M2MString_length(string));
+		}
+	//===== Argument error =====
+	else
+		{
+		this_printErrorMessage((M2MString *)"M2MStringBuilder_append()", __LINE__, (M2MString *)"Argument error! Indicated \"string\" is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Append one character at the end of the buffer.<br>
+ *
+ * @param[in,out] self		String builder object
+ * @param[in] character		Character to be appended
+ * @return					String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendCharacter (M2MStringBuilder *self, const M2MString character)
+	{
+	//===== Make room for the character =====
+	if (self!=NULL && M2MStringBuilder_reserve(self, self->length+1)!=NULL)
+		{
+		self->buffer[self->length] = character;
+		self->length++;
+		self->buffer[self->length] = '\0';
+		return self;
+		}
+	//===== Error handling =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Append the double number converted into string (same format as <br>
+ * "M2MString_convertFromDoubleToString()") at the end of the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] number	Double number
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendDouble (M2MStringBuilder *self, const double number)
+	{
+	return M2MStringBuilder_appendFormat(self, (M2MString *)"%f", number);
+	}
+
+
+/**
+ * Append the string formatted like "printf()" at the end of the buffer.<br>
+ * The string is formatted directly into the buffer (no temporary copy).<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] format	Format string
+ * @param[in] ...		Arguments of the format
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendFormat (M2MStringBuilder *self, const M2MString *format, ...)
+	{
+	//========== Variable ==========
+	va_list argument;
+	int formattedLength = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStringBuilder_appendFormat()";
+
+	//===== Check argument =====
+	if (self!=NULL && format!=NULL)
+		{
+		//===== Make sure the buffer exists =====
+		if (M2MStringBuilder_reserve(self, self->length)==NULL)
+			{
+			return NULL;
+			}
+		else
+			{
+			// do nothing
+			}
+		//===== Format into the free space of the buffer =====
+		va_start(argument, format);
+		formattedLength = vsnprintf(&(self->buffer[self->length]), self->capacity-self->length, format, argument);
+		va_end(argument);
+		if (formattedLength<0)
+			{
+			self->buffer[self->length] = '\0';
+			this_printErrorMessage(FUNCTION_NAME, __LINE__, (M2MString *)"Failed to format the string");
+			return NULL;
+			}
+		//===== In the case of lack of space, enlarge the buffer and format again =====
+		else if ((size_t)formattedLength>=self->capacity-self->length)
+			{
+			if (M2MStringBuilder_reserve(self, self->length+(size_t)formattedLength)!=NULL)
+				{
+				va_start(argument, format);
+				vsnprintf(&(self->buffer[self->length]), self->capacity-self->length, format, argument);
+				va_end(argument);
+				}
+			//===== Error handling =====
+			else
+				{
+				self->buffer[self->length] = '\0';
+				return NULL;
+				}
+			}
+		else
+			{
+			// do nothing
+			}
+		self->length += (size_t)formattedLength;
+		return self;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		this_printErrorMessage(FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStringBuilder\" object is NULL");
+		return NULL;
+		}
+	else
+		{
+		this_printErrorMessage(FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"format\" is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Append the string of indicated length at the end of the buffer.<br>
+ * The string needn't be terminated by '\0'.<br>
+ *
+ * @param[in,out] self		String builder object
+ * @param[in] string		String to be appended
+ * @param[in] stringLength	Length of the string to be appended[Byte]
+ * @return					String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendLength (M2MStringBuilder *self, const M2MString *string, const size_t stringLength)
+	{
+	//===== Check argument =====
+	if (self!=NULL && (string!=NULL || stringLength==0))
+		{
+		//===== Make room for the string =====
+		if (M2MStringBuilder_reserve(self, self->length+stringLength)!=NULL)
+			{
+			if (stringLength>0)
+				{
+				memcpy(&(self->buffer[self->length]), string, stringLength);
+				self->length += stringLength;
+				self->buffer[self->length] = '\0';
+				}
+			else
+				{
+				// do nothing
+				}
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		this_printErrorMessage((M2MString *)"M2MStringBuilder_appendLength()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MStringBuilder\" object is NULL");
+		return NULL;
+		}
+	else
+		{
+		this_printErrorMessage((M2MString *)"M2MStringBuilder_appendLength()", __LINE__, (M2MString *)"Argument error! Indicated \"string\" is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Append the signed integer converted into decimal string at the end of <br>
+ * the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] number	Signed integer
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendSignedLong (M2MStringBuilder *self, const int64_t number)
+	{
+	//===== In the case of negative number =====
+	if (number<0)
+		{
+		if (M2MStringBuilder_appendCharacter(self, (M2MString)'-')!=NULL)
+			{
+			//===== Negate without overflow (INT64_MIN) =====
+			return M2MStringBuilder_appendUnsignedLong(self, (uint64_t)0-(uint64_t)number);
+			}
+		//===== Error handling =====
+		else
+			{
+			return NULL;
+			}
+		}
+	//===== In the case of positive number =====
+	else
+		{
+		return M2MStringBuilder_appendUnsignedLong(self, (uint64_t)number);
+		}
+	}
+
+
+/**
+ * Append the unsigned integer converted into decimal string at the end of <br>
+ * the buffer.<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] number	Unsigned integer
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_appendUnsignedLong (M2MStringBuilder *self, const uint64_t number)
+	{
+	//========== Variable ==========
+	M2MString digit[24];
+	size_t index = sizeof(digit);
+	uint64_t rest = number;
+
+	//===== Convert into digits from the lowest one =====
+	do
+		{
+		index--;
+		digit[index] = (M2MString)('0'+(rest%10));
+		rest /= 10;
+		} while (rest>0);
+	return M2MStringBuilder_appendLength(self, &(digit[index]), sizeof(digit)-index);
+	}
+
+
+/**
+ * Empty the string for reuse of the builder.<br>
+ * The allocated buffer is kept.<br>
+ *
+ * @param[in,out] self	String builder object
+ */
+void M2MStringBuilder_clear (M2MStringBuilder *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->length = 0;
+		if (self->buffer!=NULL)
+			{
+			self->buffer[0] = '\0';
+			}
+		else
+			{
+			// do nothing
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Release the heap memory of the string builder allocated by <br>
+ * "M2MStringBuilder_new()".<br>
+ *
+ * @param[in,out] self	String builder object
+ */
+void M2MStringBuilder_delete (M2MStringBuilder **self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		M2MStringBuilder_release((*self));
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Hand over the string of the builder to the caller. <br>
+ * The builder becomes empty (without buffer) and can be reused.<br>
+ * Caller must release the returned string with "M2MHeap_free()".<br>
+ *
+ * @param[in,out] self	String builder object
+ * @return				String (caller owns it) or NULL (in case of empty builder)
+ */
+M2MString *M2MStringBuilder_detach (M2MStringBuilder *self)
+	{
+	//========== Variable ==========
+	M2MString *string = NULL;
+
+	//===== Check argument =====
+	if (self!=NULL && self->length>0)
+		{
+		string = self->buffer;
+		self->buffer = NULL;
+		self->length = 0;
+		self->capacity = 0;
+		return string;
+		}
+	//===== In the case of empty builder =====
+	else
+		{
+		M2MStringBuilder_clear(self);
+		return NULL;
+		}
+	}
+
+
+/**
+ * Return the length of the string held in the builder.<br>
+ *
+ * @param[in] self	String builder object
+ * @return			Length of the string[Byte]
+ */
+size_t M2MStringBuilder_getLength (const M2MStringBuilder *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->length;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Return the string held in the builder (owned by the builder).<br>
+ *
+ * @param[in] self	String builder object
+ * @return			String or NULL (in case of empty builder)
+ */
+M2MString *M2MStringBuilder_getString (const M2MStringBuilder *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && self->length>0)
+		{
+		return self->buffer;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Initialize the string builder placed on the stack or in other structure.<br>
+ * The buffer is allocated at the first append.<br>
+ *
+ * @param[out] self	String builder object
+ * @return			String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_init (M2MStringBuilder *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		self->buffer = NULL;
+		self->length = 0;
+		self->capacity = 0;
+		return self;
+		}
+	//===== Argument error =====
+	else
+		{
+		this_printErrorMessage((M2MString *)"M2MStringBuilder_init()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MStringBuilder\" object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Allocate new string builder object on heap memory.<br>
+ *
+ * @param[in] capacity	Initial capacity of the buffer (0 means allocation at the first append)[Byte]
+ * @return				Created string builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_new (const size_t capacity)
+	{
+	//========== Variable ==========
+	M2MStringBuilder *self = NULL;
+
+	//===== Get heap memory =====
+	if ((self=(M2MStringBuilder *)M2MHeap_malloc(sizeof(M2MStringBuilder)))!=NULL)
+		{
+		M2MStringBuilder_init(self);
+		//===== Allocate the buffer in advance =====
+		if (capacity==0 || M2MStringBuilder_reserve(self, capacity-1)!=NULL)
+			{
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MStringBuilder_delete(&self);
+			return NULL;
+			}
+		}
+	//===== Error handling =====
+	else
+		{
+		this_printErrorMessage((M2MString *)"M2MStringBuilder_new()", __LINE__, (M2MString *)"Failed to get heap memory for the string builder");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the buffer of the string builder initialized by <br>
+ * "M2MStringBuilder_init()". The builder becomes empty.<br>
+ *
+ * @param[in,out] self	String builder object
+ */
+void M2MStringBuilder_release (M2MStringBuilder *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		M2MHeap_free(self->buffer);
+		self->length = 0;
+		self->capacity = 0;
+		}
+	//===== Argument error =====
+	else
+		{
+		// do nothing
+		}
+	return;
+	}
+
+
+/**
+ * Make sure the buffer can hold the string of indicated length without <br>
+ * reallocation (the capacity is doubled until it fits).<br>
+ *
+ * @param[in,out] self	String builder object
+ * @param[in] length	Length of the string to be held[Byte]
+ * @return				String builder object or NULL (in case of error)
+ */
+M2MStringBuilder *M2MStringBuilder_reserve (M2MStringBuilder *self, const size_t length)
+	{
+	//========== Variable ==========
+	M2MString *buffer = NULL;
+	size_t capacity = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MStringBuilder_reserve()";
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== In the case of enough capacity =====
+		if (length<self->capacity)
+			{
+			return self;
+			}
+		//===== Double the capacity until the string (and '\0') fits =====
+		else
+			{
+			capacity = (self->capacity>0) ? self->capacity : M2MStringBuilder_DEFAULT_CAPACITY;
+			while (capacity<=length)
+				{
+				capacity *= 2;
+				}
+			if ((buffer=(M2MString *)M2MHeap_realloc(self->buffer, capacity))!=NULL)
+				{
+				buffer[self->length] = '\0';
+				self->buffer = buffer;
+				self->capacity = capacity;
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				this_printErrorMessage(FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for the buffer");
+				return NULL;
+				}
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		this_printErrorMessage(FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MStringBuilder\" object is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
@@ -144,9 +144,8 @@ M2MString *M2MLogger_createNewLogMessage (
 	//========== Variable ==========
 	M2MString *logLevelString = NULL;
 	M2MString time[64];
-	M2MString lineNumberString[16];
-	M2MString errnoMessage[256];
 	M2MString threadID[128];
+	M2MStringBuilder builder;
 	size_t functionNameLength = 0;
 	size_t messageLength = 0;
 
@@ -156,117 +155,57 @@ M2MString *M2MLogger_createNewLogMessage (
 			&& message!=NULL && (messageLength=M2MString_length(message))>0
 			&& buffer!=NULL)
 		{
-		//===== Get line number string =====
-		memset(lineNumberString, 0, sizeof(lineNumberString));
-		snprintf(lineNumberString, sizeof(lineNumberString)-1, (M2MString *)"%d", lineNumber);
 		//===== Initialize array =====
 		memset(time, 0, sizeof(time));
 		//===== Get current time string from local calendar ======
 		if (M2MDate_getLocalTimeString(time, sizeof(time))>0
 				&& M2MSystem_getThreadIDString(threadID, sizeof(threadID))!=NULL)
 			{
-			//===== In the case of existing error number =====
-			if (errno!=0 && strerror_r(errno, errnoMessage, sizeof(errnoMessage))==0)
+			//===== Create new log message string (one buffer, amortized O(1) per byte) =====
+			M2MStringBuilder_init(&builder);
+			if (M2MStringBuilder_reserve(&builder, functionNameLength+messageLength+M2MString_length(time)+M2MString_length(threadID)+32)!=NULL
+					&& M2MStringBuilder_appendCharacter(&builder, (M2MString)'[')!=NULL
+					&& M2MStringBuilder_append(&builder, time)!=NULL
+					&& M2MStringBuilder_append(&builder, (M2MString *)"][")!=NULL
+					&& M2MStringBuilder_append(&builder, logLevelString)!=NULL
+					&& M2MStringBuilder_append(&builder, (M2MString *)"][tid=")!=NULL
+					&& M2MStringBuilder_append(&builder, threadID)!=NULL
+					&& M2MStringBuilder_append(&builder, (M2MString *)"][")!=NULL
+					&& M2MStringBuilder_appendLength(&builder, functionName, functionNameLength)!=NULL
+					&& M2MStringBuilder_appendCharacter(&builder, (M2MString)':')!=NULL
+					&& M2MStringBuilder_appendUnsignedLong(&builder, (uint64_t)lineNumber)!=NULL
+					&& M2MStringBuilder_append(&builder, (M2MString *)"l][")!=NULL
+					&& M2MStringBuilder_appendLength(&builder, message, messageLength)!=NULL
+					&& M2MStringBuilder_appendCharacter(&builder, (M2MString)']')!=NULL)
 				{
-				//===== Create new log message string =====
-				if (M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, time)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, logLevelString)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, (M2MString *)"tid=")!=NULL
-						&& M2MString_append(buffer, threadID)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, functionName)!=NULL
-						&& M2MString_append(buffer, M2MString_COLON)!=NULL
-						&& M2MString_append(buffer, lineNumberString)!=NULL
-						&& M2MString_append(buffer, (M2MString *)"l")!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-//						&& M2MString_append(buffer, errnoMessage)!=NULL
-//						&& M2MString_append(buffer, M2MString_COLON)!=NULL
-//						&& M2MString_append(buffer, M2MString_SPACE)!=NULL
-						&& M2MString_append(buffer, message)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-						)
+				//===== Hand over the buffer to the caller =====
+				if ((*buffer)==NULL)
 					{
-					//===== Initialize error number =====
-					this_initErrorNumber();
-					//===== Return created log message string =====
-					return (*buffer);
+					(*buffer) = M2MStringBuilder_detach(&builder);
 					}
-				//===== Error handling =====
-				else if ((*buffer)!=NULL)
+				//===== Append to the string the caller already has =====
+				else if (M2MString_appendLength(buffer, M2MStringBuilder_getString(&builder), M2MStringBuilder_getLength(&builder))==NULL)
 					{
-					//===== Release allocated memory =====
 					M2MHeap_free((*buffer));
-					//===== Initialize error number =====
-					this_initErrorNumber();
-					return NULL;
 					}
 				else
 					{
-					//===== Initialize error number =====
-					this_initErrorNumber();
-					return NULL;
+					// do nothing
 					}
+				M2MStringBuilder_release(&builder);
+				//===== Initialize error number =====
+				this_initErrorNumber();
+				//===== Return created log message string =====
+				return (*buffer);
 				}
-			//===== In the case of not existing error number =====
+			//===== Error handling =====
 			else
 				{
-				//===== Create new log message string =====
-				if (M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, time)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, logLevelString)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, (M2MString *)"tid=")!=NULL
-						&& M2MString_append(buffer, threadID)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, functionName)!=NULL
-						&& M2MString_append(buffer, M2MString_COLON)!=NULL
-						&& M2MString_append(buffer, lineNumberString)!=NULL
-						&& M2MString_append(buffer, (M2MString *)"l")!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-
-						&& M2MString_append(buffer, M2MString_LEFT_SQUARE_BRACKET)!=NULL
-						&& M2MString_append(buffer, message)!=NULL
-						&& M2MString_append(buffer, M2MString_RIGHT_SQUARE_BRACKET)!=NULL
-						)
-					{
-					//===== Initialize error number =====
-					this_initErrorNumber();
-					//===== Return created log message string =====
-					return (*buffer);
-					}
-				//===== Error handling =====
-				else if ((*buffer)!=NULL)
-					{
-					//===== Release allocated memory =====
-					M2MHeap_free((*buffer));
-					//===== Initialize error number =====
-					this_initErrorNumber();
-					return NULL;
-					}
-				else
-					{
-					//===== Initialize error number =====
-					this_initErrorNumber();
-					return NULL;
-					}
+				//===== Release allocated memory =====
+				M2MStringBuilder_release(&builder);
+				//===== Initialize error number =====
+				this_initErrorNumber();
+				return NULL;
 				}
 			}
 		//===== Error handling =====
@@ -0,0 +1,334 @@
+/*******************************************************************************
+ * M2MConcurrentQueue.c : Bounded lock-free multi-producer queue of pointers
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/lib/util/list/M2MConcurrentQueue.h"
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Release the heap memory of the queue.<br>
+ * Pointers remaining in the queue are released with M2MHeap_free().<br>
+ * Must not be called while other threads still access the queue.<br>
+ *
+ * @param[in,out] self	Concurrent queue structure object to be released
+ */
+void M2MConcurrentQueue_delete (M2MConcurrentQueue **self)
+	{
+	//========== Variable ==========
+	void *value = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MConcurrentQueue_delete()";
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		//===== Release remaining pointers =====
+		while ((value=M2MConcurrentQueue_poll((*self)))!=NULL)
+			{
+			M2MHeap_free(value);
+			}
+		//===== Release slot array and queue =====
+		M2MHeap_free((*self)->element);
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MConcurrentQueue\" structure object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Returns the number of slots of the queue.<br>
+ *
+ * @param[in] self	Concurrent queue structure object
+ * @return			Number of slots or 0 (in case of error)
+ */
+size_t M2MConcurrentQueue_getCapacity (const M2MConcurrentQueue *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->mask + 1;
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Check whether the queue has no pointer.<br>
+ *
+ * @param[in] self	Concurrent queue structure object
+ * @return			true: empty (or error), false: at least one pointer is stored
+ */
+bool M2MConcurrentQueue_isEmpty (M2MConcurrentQueue *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && M2MConcurrentQueue_length(self)>0)
+		{
+		return false;
+		}
+	//===== In case of empty =====
+	else
+		{
+		return true;
+		}
+	}
+
+
+/**
+ * Returns the number of stored pointers.<br>
+ * While other threads offer or poll, the value is a snapshot.<br>
+ *
+ * @param[in] self	Concurrent queue structure object
+ * @return			Number of stored pointers
+ */
+size_t M2MConcurrentQueue_length (M2MConcurrentQueue *self)
+	{
+	//========== Variable ==========
+	size_t dequeueIndex = 0;
+	size_t enqueueIndex = 0;
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Difference of the positions (a pending poll may overtake an offer) =====
+		dequeueIndex = atomic_load(&(self->dequeueIndex));
+		enqueueIndex = atomic_load(&(self->enqueueIndex));
+		if (enqueueIndex>dequeueIndex)
+			{
+			return enqueueIndex - dequeueIndex;
+			}
+		//===== In case of empty =====
+		else
+			{
+			return 0;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		return 0;
+		}
+	}
+
+
+/**
+ * Constructor.<br>
+ * Create new concurrent queue with the indicated number of slots.<br>
+ *
+ * @param[in] capacity	Number of slots (rounded up to a power of 2)
+ * @return				Created concurrent queue structure object or NULL (in case of error)
+ */
+M2MConcurrentQueue *M2MConcurrentQueue_new (const size_t capacity)
+	{
+	//========== Variable ==========
+	M2MConcurrentQueue *self = NULL;
+	size_t length = 2;
+	size_t i = 0;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MConcurrentQueue_new()";
+
+	//===== Check argument =====
+	if (capacity>0)
+		{
+		//===== Round up the number of slots to a power of 2 =====
+		while (length<capacity)
+			{
+			length <<= 1;
+			}
+		//===== Get heap memory of queue and slot array =====
+		if ((self=(M2MConcurrentQueue *)M2MHeap_malloc(sizeof(M2MConcurrentQueue)))!=NULL
+				&& (self->element=(M2MConcurrentQueueElement *)M2MHeap_calloc(length, sizeof(M2MConcurrentQueueElement)))!=NULL)
+			{
+			//===== Each slot is writable at the position of its index =====
+			for (i=0; i<length; i++)
+				{
+				atomic_init(&(self->element[i].sequence), i);
+				}
+			self->mask = length - 1;
+			atomic_init(&(self->enqueueIndex), 0);
+			atomic_init(&(self->dequeueIndex), 0);
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for creating \"M2MConcurrentQueue\" structure object");
+			if (self!=NULL)
+				{
+				M2MHeap_free(self);
+				}
+			else
+				{
+				// do nothing
+				}
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated capacity is 0");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Add the pointer to the end of the queue (without copy).<br>
+ * The ownership of the pointed memory moves to the queue on success.<br>
+ *
+ * @param[in,out] self	Concurrent queue structure object
+ * @param[in] value		Pointer to be added (not NULL)
+ * @return				true: added, false: the queue is full (or error)
+ */
+bool M2MConcurrentQueue_offer (M2MConcurrentQueue *self, void *value)
+	{
+	//========== Variable ==========
+	M2MConcurrentQueueElement *element = NULL;
+	size_t index = 0;
+	size_t sequence = 0;
+
+	//===== Check argument =====
+	if (self!=NULL && value!=NULL)
+		{
+		index = atomic_load_explicit(&(self->enqueueIndex), memory_order_relaxed);
+		//===== Repeat until a slot is claimed =====
+		while (true)
+			{
+			element = &(self->element[index & self->mask]);
+			sequence = atomic_load_explicit(&(element->sequence), memory_order_acquire);
+			//===== The slot is writable, so claim the position =====
+			if (sequence==index)
+				{
+				if (atomic_compare_exchange_weak_explicit(&(self->enqueueIndex), &index, index+1, memory_order_relaxed, memory_order_relaxed)==true)
+					{
+					break;
+					}
+				//===== Another producer claimed it ("index" is reloaded) =====
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== The slot still holds the value of the previous lap =====
+			else if ((ptrdiff_t)(sequence-index)<0)
+				{
+				return false;
+				}
+			//===== Another producer has advanced the position =====
+			else
+				{
+				index = atomic_load_explicit(&(self->enqueueIndex), memory_order_relaxed);
+				}
+			}
+		//===== Store the pointer and publish the slot to the consumer =====
+		element->value = value;
+		atomic_store_explicit(&(element->sequence), index+1, memory_order_release);
+		return true;
+		}
+	//===== Argument error =====
+	else
+		{
+		return false;
+		}
+	}
+
+
+/**
+ * Remove the oldest pointer from the queue and return it.<br>
+ *
+ * @param[in,out] self	Concurrent queue structure object
+ * @return				Oldest pointer or NULL (in case of empty or error)
+ */
+void *M2MConcurrentQueue_poll (M2MConcurrentQueue *self)
+	{
+	//========== Variable ==========
+	M2MConcurrentQueueElement *element = NULL;
+	void *value = NULL;
+	size_t index = 0;
+	size_t sequence = 0;
+
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		index = atomic_load_explicit(&(self->dequeueIndex), memory_order_relaxed);
+		//===== Repeat until a slot is claimed =====
+		while (true)
+			{
+			element = &(self->element[index & self->mask]);
+			sequence = atomic_load_explicit(&(element->sequence), memory_order_acquire);
+			//===== The slot is readable, so claim the position =====
+			if (sequence==index+1)
+				{
+				if (atomic_compare_exchange_weak_explicit(&(self->dequeueIndex), &index, index+1, memory_order_relaxed, memory_order_relaxed)==true)
+					{
+					break;
+					}
+				//===== Another consumer claimed it ("index" is reloaded) =====
+				else
+					{
+					// do nothing
+					}
+				}
+			//===== The slot has not been published yet =====
+			else if ((ptrdiff_t)(sequence-(index+1))<0)
+				{
+				return NULL;
+				}
+			//===== Another consumer has advanced the position =====
+			else
+				{
+				index = atomic_load_explicit(&(self->dequeueIndex), memory_order_relaxed);
+				}
+			}
+		//===== Take the pointer and make the slot writable for the next lap =====
+		value = element->value;
+		element->value = NULL;
+		atomic_store_explicit(&(element->sequence), index+self->mask+1, memory_order_release);
+		return value;
+		}
+	//===== Argument error =====
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
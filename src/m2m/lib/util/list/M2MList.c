@@ -499,7 +499,7 @@ void M2MList_delete (M2MList *self)
 	if ((self=M2MList_begin(self))!=NULL)
 		{
 		//===== Repeat until reaching the end node =====
-		while ((next=M2MList_next(self))!=self)
+		while ((next=self->next)!=NULL)
 			{
 			//===== Delete a node of list structure object =====
 			this_deleteValue(self);
@@ -0,0 +1,493 @@
+/*******************************************************************************
+ * M2MRingBuffer.c : Fixed-capacity circular buffer of values
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "m2m/lib/util/list/M2MRingBuffer.h"
+
+
+/*******************************************************************************
+ * Declaration of private function
+ ******************************************************************************/
+/**
+ * Returns the slot index of the element located at the index counted from the <br>
+ * oldest element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @param[in] index	Index from the oldest element
+ * @return			Slot index of the element array
+ */
+static size_t this_getSlotIndex (const M2MRingBuffer *self, const size_t index);
+
+
+/**
+ * Reallocate the slot array with the indicated number of slots and rearrange <br>
+ * the stored elements from the head of the new array.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ * @param[in] capacity	Number of slots of the new array (larger than the number of stored elements)
+ * @return				Ring buffer structure object or NULL (in case of error)
+ */
+static M2MRingBuffer *this_resize (M2MRingBuffer *self, const size_t capacity);
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Returns the slot index of the element located at the index counted from the <br>
+ * oldest element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @param[in] index	Index from the oldest element
+ * @return			Slot index of the element array
+ */
+static size_t this_getSlotIndex (const M2MRingBuffer *self, const size_t index)
+	{
+	//========== Variable ==========
+	size_t slotIndex = self->head + index;
+
+	//===== Wrap around the end of the array =====
+	if (slotIndex>=self->capacity)
+		{
+		slotIndex -= self->capacity;
+		}
+	//===== In case of the slot index within the array =====
+	else
+		{
+		// do nothing
+		}
+	return slotIndex;
+	}
+
+
+/**
+ * Reallocate the slot array with the indicated number of slots and rearrange <br>
+ * the stored elements from the head of the new array.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ * @param[in] capacity	Number of slots of the new array (larger than the number of stored elements)
+ * @return				Ring buffer structure object or NULL (in case of error)
+ */
+static M2MRingBuffer *this_resize (M2MRingBuffer *self, const size_t capacity)
+	{
+	//========== Variable ==========
+	M2MRingBufferElement *element = NULL;
+	size_t i = 0;
+	const M2MString *METHOD_NAME = (M2MString *)"M2MRingBuffer.this_resize()";
+
+	//===== Check argument =====
+	if (self!=NULL && self->length<capacity)
+		{
+		//===== Get heap memory of new slot array =====
+		if ((element=(M2MRingBufferElement *)M2MHeap_calloc(capacity, sizeof(M2MRingBufferElement)))!=NULL)
+			{
+			//===== Move stored elements in order from the oldest =====
+			for (i=0; i<self->length; i++)
+				{
+				element[i] = self->element[this_getSlotIndex(self, i)];
+				}
+			//===== Replace slot array =====
+			M2MHeap_free(self->element);
+			self->element = element;
+			self->capacity = capacity;
+			self->head = 0;
+			return self;
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Failed to get heap memory for slot array of \"M2MRingBuffer\" structure object");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, METHOD_NAME, __LINE__, (M2MString *)"Argument error! Indicated capacity is smaller than the number of stored elements");
+		return NULL;
+		}
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Release the values of all elements (the slot array is kept).<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ */
+void M2MRingBuffer_clear (M2MRingBuffer *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Release all values =====
+		while (M2MRingBuffer_pop(self)!=NULL)
+			{
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MRingBuffer_clear()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Release the heap memory of the ring buffer and all values.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object to be released
+ */
+void M2MRingBuffer_delete (M2MRingBuffer **self)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MRingBuffer_delete()";
+
+	//===== Check argument =====
+	if (self!=NULL && (*self)!=NULL)
+		{
+		//===== Release all values =====
+		M2MRingBuffer_clear((*self));
+		//===== Release slot array and ring buffer =====
+		M2MHeap_free((*self)->element);
+		M2MHeap_free((*self));
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		}
+	return;
+	}
+
+
+/**
+ * Returns the number of slots currently allocated.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @return			Number of slots or 0 (in case of error)
+ */
+size_t M2MRingBuffer_getCapacity (const M2MRingBuffer *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->capacity;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MRingBuffer_getCapacity()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns the value located at the index counted from the oldest element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @param[in] index	Index from the oldest element (0 is the oldest)
+ * @return			Value or NULL (in case of error)
+ */
+void *M2MRingBuffer_getValue (const M2MRingBuffer *self, const size_t index)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MRingBuffer_getValue()";
+
+	//===== Check argument =====
+	if (self!=NULL && index<self->length)
+		{
+		return self->element[this_getSlotIndex(self, index)].value;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated index is out of range");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the size of the value located at the index counted from the oldest <br>
+ * element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @param[in] index	Index from the oldest element (0 is the oldest)
+ * @return			Size of value[Byte] or 0 (in case of error)
+ */
+size_t M2MRingBuffer_getValueLength (const M2MRingBuffer *self, const size_t index)
+	{
+	//========== Variable ==========
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MRingBuffer_getValueLength()";
+
+	//===== Check argument =====
+	if (self!=NULL && index<self->length)
+		{
+		return self->element[this_getSlotIndex(self, index)].valueLength;
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return 0;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated index is out of range");
+		return 0;
+		}
+	}
+
+
+/**
+ * Returns true if the ring buffer holds no element.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @return			true: empty, false: holds element(s)
+ */
+bool M2MRingBuffer_isEmpty (const M2MRingBuffer *self)
+	{
+	return (M2MRingBuffer_length(self)==0);
+	}
+
+
+/**
+ * Returns the number of stored elements.<br>
+ *
+ * @param[in] self	Ring buffer structure object
+ * @return			Number of stored elements
+ */
+size_t M2MRingBuffer_length (const M2MRingBuffer *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		return self->length;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MRingBuffer_length()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return 0;
+		}
+	}
+
+
+/**
+ * Create a new ring buffer with preallocated slots.<br>
+ *
+ * @param[in] capacity	Number of slots to preallocate (1 or more)
+ * @return				Created ring buffer structure object or NULL (in case of error)
+ */
+M2MRingBuffer *M2MRingBuffer_new (const size_t capacity)
+	{
+	//========== Variable ==========
+	M2MRingBuffer *self = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MRingBuffer_new()";
+
+	//===== Check argument =====
+	if (capacity>0)
+		{
+		//===== Get heap memory of ring buffer =====
+		if ((self=(M2MRingBuffer *)M2MHeap_malloc(sizeof(M2MRingBuffer)))!=NULL)
+			{
+			//===== Preallocate slot array =====
+			if (this_resize(self, capacity)!=NULL)
+				{
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MHeap_free(self);
+				return NULL;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for creating \"M2MRingBuffer\" structure object");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated capacity is 0");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Release the value of the oldest element and remove it from the ring buffer.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ * @return				Ring buffer structure object or NULL (in case of empty or error)
+ */
+M2MRingBuffer *M2MRingBuffer_pop (M2MRingBuffer *self)
+	{
+	//===== Check argument =====
+	if (self!=NULL && self->length>0)
+		{
+		//===== Release the oldest value =====
+		M2MHeap_free(self->element[self->head].value);
+		self->element[self->head].valueLength = 0;
+		//===== Move the head to the next slot =====
+		self->head = this_getSlotIndex(self, 1);
+		self->length--;
+		return self;
+		}
+	//===== In case of empty =====
+	else if (self!=NULL)
+		{
+		return NULL;
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MRingBuffer_pop()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Copy the value into the newest slot of the ring buffer.<br>
+ *
+ * @param[in,out] self		Ring buffer structure object
+ * @param[in] value			Value to be copied
+ * @param[in] valueLength	Size of value[Byte]
+ * @return					Ring buffer structure object or NULL (in case of error)
+ */
+M2MRingBuffer *M2MRingBuffer_push (M2MRingBuffer *self, const void *value, const size_t valueLength)
+	{
+	//========== Variable ==========
+	M2MRingBufferElement *element = NULL;
+	const M2MString *FUNCTION_NAME = (M2MString *)"M2MRingBuffer_push()";
+
+	//===== Check argument =====
+	if (self!=NULL && value!=NULL && valueLength>0)
+		{
+		//===== Double the slot array when it is full =====
+		if (self->length<self->capacity || this_resize(self, self->capacity*2)!=NULL)
+			{
+			element = &(self->element[this_getSlotIndex(self, self->length)]);
+			//===== Copy value (terminated with null character) =====
+			if ((element->value=M2MHeap_malloc(valueLength+1))!=NULL)
+				{
+				memcpy(element->value, value, valueLength);
+				element->valueLength = valueLength;
+				self->length++;
+				return self;
+				}
+			//===== Error handling =====
+			else
+				{
+				M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to get heap memory for copying a value");
+				return NULL;
+				}
+			}
+		//===== Error handling =====
+		else
+			{
+			M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Failed to extend slot array of \"M2MRingBuffer\" structure object");
+			return NULL;
+			}
+		}
+	//===== Argument error =====
+	else if (self==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return NULL;
+		}
+	else if (value==NULL)
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"value\" object is NULL");
+		return NULL;
+		}
+	else
+		{
+		M2MLogger_error(NULL, FUNCTION_NAME, __LINE__, (M2MString *)"Argument error! Indicated \"valueLength\" number is invalid");
+		return NULL;
+		}
+	}
+
+
+/**
+ * Make the slot array hold at least the indicated number of elements.<br>
+ * Stored elements are kept. The array is never shrunk.<br>
+ *
+ * @param[in,out] self	Ring buffer structure object
+ * @param[in] capacity	Number of slots required
+ * @return				Ring buffer structure object or NULL (in case of error)
+ */
+M2MRingBuffer *M2MRingBuffer_reserve (M2MRingBuffer *self, const size_t capacity)
+	{
+	//===== Check argument =====
+	if (self!=NULL)
+		{
+		//===== Extend slot array =====
+		if (self->capacity<capacity)
+			{
+			return this_resize(self, capacity);
+			}
+		//===== In case of enough slots =====
+		else
+			{
+			return self;
+			}
+		}
+	//===== Argument error =====
+	else
+		{
+		M2MLogger_error(NULL, (M2MString *)"M2MRingBuffer_reserve()", __LINE__, (M2MString *)"Argument error! Indicated \"M2MRingBuffer\" structure object is NULL");
+		return NULL;
+		}
+	}
+
+
+
+/* End Of File */
@@ -0,0 +1,284 @@
+/*******************************************************************************
+ * M2MCEPColumnStoreBenchmark.c
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEP.h"
+#include "m2m/lib/db/M2MTableManager.h"
+#include "m2m/lib/db/M2MColumnList.h"
+#include "m2m/lib/lang/M2MString.h"
+#include "m2m/lib/io/M2MHeap.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+
+
+/**
+ * Compares the history of a numeric time-series persisted into the SQLite3 <br>
+ * database on file with the same history persisted into the column store <br>
+ * (M2MCEP_setColumnStore()): size of the files and time to scan one hour <br>
+ * and the whole range of (time, value).<br>
+ * <br>
+ * usage: M2MCEPColumnStoreBenchmark [number of records (default 200000)]<br>
+ */
+
+
+/**
+ * Number of records inserted with one M2MCEP_insertRecords().<br>
+ */
+#define BATCH_RECORD (unsigned int)1000
+
+
+/**
+ * Sum of the scanned values (keeps the scan from being optimized out).<br>
+ */
+typedef struct
+	{
+	unsigned long count;
+	double sum;
+	} Total;
+
+
+
+/**
+ * Add the scanned record to the total.<br>
+ *
+ * @param row				(time, value)
+ * @param numberOfColumn	Number of the values
+ * @param userData			Total
+ * @return					true (continue)
+ */
+static bool this_add (const M2MCEPValue *row, const unsigned int numberOfColumn, void *userData)
+	{
+	Total *total = (Total *)userData;
+
+	total->count++;
+	total->sum += (numberOfColumn>1) ? row[1].value.real : 0.0;
+	return true;
+	}
+
+
+/**
+ * Create the CEP object of the sensor table.<br>
+ *
+ * @param databaseName		Name of the database
+ * @param columnStore		true: the column store, false: the SQLite3 database on file
+ * @return					CEP object or NULL
+ */
+static M2MCEP *this_createCEP (const M2MString *databaseName, const bool columnStore)
+	{
+	M2MCEP *cep = NULL;
+	M2MTableManager *tableManager = NULL;
+	M2MColumnList *columnList = NULL;
+
+	if ((columnList=M2MColumnList_new())!=NULL
+			&& M2MColumnList_add(columnList, (M2MString *)"time", M2MSQLiteDataType_INTEGER, false, false, false, false)!=NULL
+			&& M2MColumnList_add(columnList, (M2MString *)"name", M2MSQLiteDataType_TEXT, false, false, false, false)!=NULL
+			&& M2MColumnList_add(columnList, (M2MString *)"value", M2MSQLiteDataType_DOUBLE, false, false, false, false)!=NULL
+			&& (tableManager=M2MTableManager_new())!=NULL
+			&& M2MTableManager_setConfig(tableManager, (M2MString *)"sensor", columnList)!=NULL
+			&& (cep=M2MCEP_new(databaseName, tableManager))!=NULL)
+		{
+		M2MCEP_setMaxRecord(cep, BATCH_RECORD);
+		M2MCEP_setPersistence(cep, true);
+		if (columnStore==true)
+			{
+			M2MCEP_setColumnStore(cep, (M2MString *)"sensor", (M2MString *)"time", 1024);
+			}
+		else
+			{
+			// do nothing
+			}
+		return cep;
+		}
+	else
+		{
+		return NULL;
+		}
+	}
+
+
+/**
+ * Returns the size of the file.<br>
+ *
+ * @param filePath	Pathname of the file
+ * @return			Size of the file[Byte]
+ */
+static long long this_getFileLength (const char *filePath)
+	{
+	struct stat fileStatus;
+
+	return (stat(filePath, &fileStatus)==0) ? (long long)fileStatus.st_size : 0;
+	}
+
+
+/**
+ * Returns the monotonic time.<br>
+ *
+ * @return	Time[sec]
+ */
+static double this_getTime ()
+	{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1000000000.0;
+	}
+
+
+/**
+ * Insert the sensor records (one record per second of 8 devices in turn, <br>
+ * temperature with 0.1 degree resolution).<br>
+ *
+ * @param cep				CEP object
+ * @param numberOfRecord	Number of records
+ */
+static void this_insert (M2MCEP *cep, const unsigned int numberOfRecord)
+	{
+	M2MCEPValue values[BATCH_RECORD*3];
+	const char *NAME[] = {"dev0", "dev1", "dev2", "dev3", "dev4", "dev5", "dev6", "dev7"};
+	unsigned int i = 0;
+	unsigned int j = 0;
+
+	for (i=0; i<numberOfRecord; i+=BATCH_RECORD)
+		{
+		for (j=0; j<BATCH_RECORD; j++)
+			{
+			values[j*3].type = M2MCEPValueType_INTEGER;
+			values[j*3].value.integer = 1546300800000LL + (int64_t)(i+j) * 1000;
+			values[j*3+1].type = M2MCEPValueType_TEXT;
+			values[j*3+1].value.text = (M2MString *)NAME[(i+j)%8];
+			values[j*3+1].length = -1;
+			values[j*3+2].type = M2MCEPValueType_REAL;
+			values[j*3+2].value.real = round((20.0 + 5.0 * sin((double)(i+j) / 3600.0)) * 10.0) / 10.0;
+			}
+		M2MCEP_insertRecords(cep, (M2MString *)"sensor", values, BATCH_RECORD, 3);
+		}
+	return;
+	}
+
+
+/**
+ * Scan the SQLite3 database on file with the index of the time column.<br>
+ *
+ * @param filePath	Pathname of the SQLite3 database file
+ * @param from		Start of the time range
+ * @param to		End of the time range
+ * @param total		Total of the scanned values
+ */
+static void this_scanSQLite (const char *filePath, const int64_t from, const int64_t to, Total *total)
+	{
+	sqlite3 *database = NULL;
+	sqlite3_stmt *statement = NULL;
+
+	if (sqlite3_open_v2(filePath, &database, SQLITE_OPEN_READONLY, NULL)==SQLITE_OK
+			&& sqlite3_prepare_v2(database, "SELECT time, value FROM sensor WHERE time BETWEEN ? AND ? ", -1, &statement, NULL)==SQLITE_OK)
+		{
+		sqlite3_bind_int64(statement, 1, from);
+		sqlite3_bind_int64(statement, 2, to);
+		while (sqlite3_step(statement)==SQLITE_ROW)
+			{
+			total->count++;
+			total->sum += sqlite3_column_double(statement, 1);
+			}
+		}
+	else
+		{
+		fprintf(stderr, "%s\n", sqlite3_errmsg(database));
+		}
+	sqlite3_finalize(statement);
+	sqlite3_close(database);
+	return;
+	}
+
+
+/**
+ * Entry point.<br>
+ *
+ * @param argc	Number of arguments
+ * @param argv	[number of records]
+ * @return		0: success, 1: error
+ */
+int main (int argc, char **argv)
+	{
+	M2MCEP *cep = NULL;
+	Total total;
+	char sqlitePath[512];
+	char columnPath[512];
+	char indexSQL[128];
+	sqlite3 *database = NULL;
+	double start = 0.0;
+	double scanTime = 0.0;
+	int i = 0;
+	const unsigned int NUMBER_OF_RECORD = (argc>1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 200000;
+	const int64_t FROM[] = {1546300800000LL + 3600000LL * 10, INT64_MIN};
+	const int64_t TO[] = {1546300800000LL + 3600000LL * 11 - 1, INT64_MAX};
+	const char *RANGE[] = {"1 hour", "all"};
+	const char *HOME = getenv("HOME");
+
+	snprintf(sqlitePath, sizeof(sqlitePath), "%s/.m2m/cep/benchsqlite.sqlite", (HOME!=NULL) ? HOME : ".");
+	snprintf(columnPath, sizeof(columnPath), "%s/.m2m/cep/benchcolumn.sqlite.column/sensor.column", (HOME!=NULL) ? HOME : ".");
+	remove(sqlitePath);
+	remove(columnPath);
+	//===== SQLite3 database on file =====
+	if ((cep=this_createCEP((M2MString *)"benchsqlite", false))==NULL)
+		{
+		return 1;
+		}
+	start = this_getTime();
+	this_insert(cep, NUMBER_OF_RECORD);
+	M2MCEP_delete(&cep);
+	printf("insert   sqlite %10.3f sec\n", this_getTime()-start);
+	//===== Column store =====
+	if ((cep=this_createCEP((M2MString *)"benchcolumn", true))==NULL)
+		{
+		return 1;
+		}
+	start = this_getTime();
+	this_insert(cep, NUMBER_OF_RECORD);
+	M2MCEP_delete(&cep);
+	printf("insert   column %10.3f sec\n", this_getTime()-start);
+	//===== Size (the SQLite3 database without and with the index of the time column) =====
+	printf("size     sqlite %10lld byte\n", this_getFileLength(sqlitePath));
+	if (sqlite3_open(sqlitePath, &database)==SQLITE_OK)
+		{
+		snprintf(indexSQL, sizeof(indexSQL), "CREATE INDEX IF NOT EXISTS sensor_time ON sensor(time) ");
+		sqlite3_exec(database, indexSQL, NULL, NULL, NULL);
+		}
+	else
+		{
+		// do nothing
+		}
+	sqlite3_close(database);
+	printf("size     sqlite %10lld byte (with index of time)\n", this_getFileLength(sqlitePath));
+	printf("size     column %10lld byte\n", this_getFileLength(columnPath));
+	//===== Scan (time, value) =====
+	if ((cep=this_createCEP((M2MString *)"benchcolumn", true))==NULL)
+		{
+		return 1;
+		}
+	for (i=0; i<2; i++)
+		{
+		memset(&total, 0, sizeof(total));
+		start = this_getTime();
+		this_scanSQLite(sqlitePath, FROM[i], TO[i], &total);
+		scanTime = this_getTime() - start;
+		printf("scan %-6s sqlite %10.6f sec (%lu records, sum %.1f)\n", RANGE[i], scanTime, total.count, total.sum);
+		memset(&total, 0, sizeof(total));
+		start = this_getTime();
+		M2MCEP_scanColumnStore(cep, (M2MString *)"sensor", FROM[i], TO[i], (M2MString *)"time,value", this_add, &total);
+		scanTime = this_getTime() - start;
+		printf("scan %-6s column %10.6f sec (%lu records, sum %.1f)\n", RANGE[i], scanTime, total.count, total.sum);
+		}
+	M2MCEP_delete(&cep);
+	return 0;
+	}
+
+
+
+/* End Of File */
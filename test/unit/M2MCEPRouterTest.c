@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * M2MCEPRouterTest.c
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ ******************************************************************************/
+
+#include "m2m/cep/M2MCEPRouter.h"
+#include <inttypes.h>
+#include <CUnit/CUnit.h>
+#include <CUnit/Console.h>
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Test function for "M2MCEPRouter_delete()"
+ */
+static void this_testDelete ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_getNumberOfShard()"
+ */
+static void this_testGetNumberOfShard ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_getShard()"
+ */
+static void this_testGetShard ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_insertCSV()"
+ */
+static void this_testInsertCSV ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_new()"
+ */
+static void this_testNew ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_route()"
+ */
+static void this_testRoute ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_select()"
+ */
+static void this_testSelect ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_selectEach()"
+ */
+static void this_testSelectEach ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_setShardKey()"
+ */
+static void this_testSetShardKey ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_startAsync()"
+ */
+static void this_testStartAsync ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEPRouter_stopAsync()"
+ */
+static void this_testStopAsync ()
+	{
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Entry point for CUnit test program.<br>
+ *
+ * @param argc
+ * @param argv
+ * @return
+ *
+int main (int argc, char **argv)
+	{
+	//========== Variable ==========
+	CU_pSuite M2MCEPRouterTest;
+
+	//=====  =====
+	CU_initialize_registry();
+	//=====  =====
+	M2MCEPRouterTest = CU_add_suite("M2MCEPRouterTest", NULL, NULL);
+	//=====  =====
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_new()", this_testNew);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_delete()", this_testDelete);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_getNumberOfShard()", this_testGetNumberOfShard);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_getShard()", this_testGetShard);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_insertCSV()", this_testInsertCSV);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_route()", this_testRoute);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_select()", this_testSelect);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_selectEach()", this_testSelectEach);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_setShardKey()", this_testSetShardKey);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_startAsync()", this_testStartAsync);
+	CU_add_test(M2MCEPRouterTest, "M2MCEPRouter_stopAsync()", this_testStopAsync);
+	//=====  =====
+	CU_console_run_tests();
+	//=====  =====
+	CU_cleanup_registry();
+
+	return 0;
+	}
+*/
+
+
+
+/* End Of File */
@@ -15,6 +15,30 @@
 /*******************************************************************************
  * Private function
  ******************************************************************************/
+/**
+ * Test function for "M2MCEP_checkpoint()"
+ */
+static void this_testCheckpoint ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_closeReader()"
+ */
+static void this_testCloseReader ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_commit()"
+ */
+static void this_testCommit ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_delete()"
  */
@@ -23,6 +47,46 @@ static void this_testDelete ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_enqueueCSV()"
+ */
+static void this_testEnqueueCSV ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_flushPersistence()"
+ */
+static void this_testFlushPersistence ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getAggregate()"
+ */
+static void this_testGetAggregate ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getCheckpointTime()"
+ */
+static void this_testGetCheckpointTime ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getCommittedRecordCount()"
+ */
+static void this_testGetCommittedRecordCount ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_getDatabaseName()"
  */
@@ -31,6 +95,22 @@ static void this_testGetDatabaseName ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_getDroppedCSVCount()"
+ */
+static void this_testGetDroppedCSVCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getEvictedRecordCount()"
+ */
+static void this_testGetEvictedRecordCount ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_getFileDatabase()"
  */
@@ -39,6 +119,38 @@ static void this_testGetFileDatabase ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_getInFlightRecordCount()"
+ */
+static void this_testGetInFlightRecordCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getInsertCacheHitCount()"
+ */
+static void this_testGetInsertCacheHitCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getInsertCacheMissCount()"
+ */
+static void this_testGetInsertCacheMissCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getMaxQueueLength()"
+ */
+static void this_testGetMaxQueueLength ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_getMemoryDatabase()"
  */
@@ -47,6 +159,46 @@ static void this_testGetMemoryDatabase ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_getQueueLength()"
+ */
+static void this_testGetQueueLength ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getSelectCacheHitCount()"
+ */
+static void this_testGetSelectCacheHitCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getSelectCacheMissCount()"
+ */
+static void this_testGetSelectCacheMissCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getVacuumPageCount()"
+ */
+static void this_testGetVacuumPageCount ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_getVacuumTime()"
+ */
+static void this_testGetVacuumTime ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_getVersion()"
  */
@@ -63,6 +215,14 @@ static void this_testInsertCSV ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_insertRecords()"
+ */
+static void this_testInsertRecords ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_new()"
  */
@@ -71,6 +231,46 @@ static void this_testNew ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_openReader()"
+ */
+static void this_testOpenReader ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_refreshReader()"
+ */
+static void this_testRefreshReader ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_registerPattern()"
+ */
+static void this_testRegisterPattern ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_registerQuery()"
+ */
+static void this_testRegisterQuery ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_scanColumnStore()"
+ */
+static void this_testScanColumnStore ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_select()"
  */
@@ -79,6 +279,94 @@ static void this_testSelect ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_selectEach()"
+ */
+static void this_testSelectEach ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_selectHistory()"
+ */
+static void this_testSelectHistory ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_selectReader()"
+ */
+static void this_testSelectReader ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_selectResultSet()"
+ */
+static void this_testSelectResultSet ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_selectUnified()"
+ */
+static void this_testSelectUnified ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_selectWithParams()"
+ */
+static void this_testSelectWithParams ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_setAggregate()"
+ */
+static void this_testSetAggregate ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_setColumnStore()"
+ */
+static void this_testSetColumnStore ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_setCommitHandler()"
+ */
+static void this_testSetCommitHandler ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_setGroupCommit()"
+ */
+static void this_testSetGroupCommit ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_setIncrementalVacuum()"
+ */
+static void this_testSetIncrementalVacuum ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_setMaxRecord()"
  */
@@ -87,6 +375,14 @@ static void this_testSetMaxRecord ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_setPartition()"
+ */
+static void this_testSetPartition ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_setPersistence()"
  */
@@ -95,6 +391,14 @@ static void this_testSetPersistence ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_setShadowRecord()"
+ */
+static void this_testSetShadowRecord ()
+	{
+	}
+
+
 /**
  * Test function for "M2MCEP_setSignalHandler()"
  */
@@ -111,6 +415,86 @@ static void this_testSetVacuumRecord ()
 	}
 
 
+/**
+ * Test function for "M2MCEP_setWindow()"
+ */
+static void this_testSetWindow ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_setWriteAheadLog()"
+ */
+static void this_testSetWriteAheadLog ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_startAsync()"
+ */
+static void this_testStartAsync ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_startCheckpoint()"
+ */
+static void this_testStartCheckpoint ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_startPersistence()"
+ */
+static void this_testStartPersistence ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_stopAsync()"
+ */
+static void this_testStopAsync ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_stopCheckpoint()"
+ */
+static void this_testStopCheckpoint ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_stopPersistence()"
+ */
+static void this_testStopPersistence ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_unregisterPattern()"
+ */
+static void this_testUnregisterPattern ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MCEP_unregisterQuery()"
+ */
+static void this_testUnregisterQuery ()
+	{
+	}
+
+
 /*******************************************************************************
  * Public function
  ******************************************************************************/
@@ -142,6 +526,54 @@ int main (int argc, char **argv)
 	CU_add_test(M2MCEPTest, "M2MCEP_setPersistence()", this_testSetPersistence);
 	CU_add_test(M2MCEPTest, "M2MCEP_setSignalHandler()", this_testSetSignalHandler);
 	CU_add_test(M2MCEPTest, "M2MCEP_setVacuumRecord()", this_testSetVacuumRecord);
+	CU_add_test(M2MCEPTest, "M2MCEP_getInsertCacheHitCount()", this_testGetInsertCacheHitCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_getInsertCacheMissCount()", this_testGetInsertCacheMissCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_setShadowRecord()", this_testSetShadowRecord);
+	CU_add_test(M2MCEPTest, "M2MCEP_insertRecords()", this_testInsertRecords);
+	CU_add_test(M2MCEPTest, "M2MCEP_enqueueCSV()", this_testEnqueueCSV);
+	CU_add_test(M2MCEPTest, "M2MCEP_getDroppedCSVCount()", this_testGetDroppedCSVCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_getMaxQueueLength()", this_testGetMaxQueueLength);
+	CU_add_test(M2MCEPTest, "M2MCEP_getQueueLength()", this_testGetQueueLength);
+	CU_add_test(M2MCEPTest, "M2MCEP_startAsync()", this_testStartAsync);
+	CU_add_test(M2MCEPTest, "M2MCEP_stopAsync()", this_testStopAsync);
+	CU_add_test(M2MCEPTest, "M2MCEP_commit()", this_testCommit);
+	CU_add_test(M2MCEPTest, "M2MCEP_getCommittedRecordCount()", this_testGetCommittedRecordCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_setCommitHandler()", this_testSetCommitHandler);
+	CU_add_test(M2MCEPTest, "M2MCEP_setGroupCommit()", this_testSetGroupCommit);
+	CU_add_test(M2MCEPTest, "M2MCEP_flushPersistence()", this_testFlushPersistence);
+	CU_add_test(M2MCEPTest, "M2MCEP_getInFlightRecordCount()", this_testGetInFlightRecordCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_startPersistence()", this_testStartPersistence);
+	CU_add_test(M2MCEPTest, "M2MCEP_stopPersistence()", this_testStopPersistence);
+	CU_add_test(M2MCEPTest, "M2MCEP_getVacuumPageCount()", this_testGetVacuumPageCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_getVacuumTime()", this_testGetVacuumTime);
+	CU_add_test(M2MCEPTest, "M2MCEP_setIncrementalVacuum()", this_testSetIncrementalVacuum);
+	CU_add_test(M2MCEPTest, "M2MCEP_getEvictedRecordCount()", this_testGetEvictedRecordCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_setWindow()", this_testSetWindow);
+	CU_add_test(M2MCEPTest, "M2MCEP_registerQuery()", this_testRegisterQuery);
+	CU_add_test(M2MCEPTest, "M2MCEP_unregisterQuery()", this_testUnregisterQuery);
+	CU_add_test(M2MCEPTest, "M2MCEP_getAggregate()", this_testGetAggregate);
+	CU_add_test(M2MCEPTest, "M2MCEP_setAggregate()", this_testSetAggregate);
+	CU_add_test(M2MCEPTest, "M2MCEP_registerPattern()", this_testRegisterPattern);
+	CU_add_test(M2MCEPTest, "M2MCEP_unregisterPattern()", this_testUnregisterPattern);
+	CU_add_test(M2MCEPTest, "M2MCEP_selectEach()", this_testSelectEach);
+	CU_add_test(M2MCEPTest, "M2MCEP_selectResultSet()", this_testSelectResultSet);
+	CU_add_test(M2MCEPTest, "M2MCEP_getSelectCacheHitCount()", this_testGetSelectCacheHitCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_getSelectCacheMissCount()", this_testGetSelectCacheMissCount);
+	CU_add_test(M2MCEPTest, "M2MCEP_selectWithParams()", this_testSelectWithParams);
+	CU_add_test(M2MCEPTest, "M2MCEP_closeReader()", this_testCloseReader);
+	CU_add_test(M2MCEPTest, "M2MCEP_openReader()", this_testOpenReader);
+	CU_add_test(M2MCEPTest, "M2MCEP_refreshReader()", this_testRefreshReader);
+	CU_add_test(M2MCEPTest, "M2MCEP_selectReader()", this_testSelectReader);
+	CU_add_test(M2MCEPTest, "M2MCEP_checkpoint()", this_testCheckpoint);
+	CU_add_test(M2MCEPTest, "M2MCEP_getCheckpointTime()", this_testGetCheckpointTime);
+	CU_add_test(M2MCEPTest, "M2MCEP_startCheckpoint()", this_testStartCheckpoint);
+	CU_add_test(M2MCEPTest, "M2MCEP_stopCheckpoint()", this_testStopCheckpoint);
+	CU_add_test(M2MCEPTest, "M2MCEP_setWriteAheadLog()", this_testSetWriteAheadLog);
+	CU_add_test(M2MCEPTest, "M2MCEP_selectHistory()", this_testSelectHistory);
+	CU_add_test(M2MCEPTest, "M2MCEP_setPartition()", this_testSetPartition);
+	CU_add_test(M2MCEPTest, "M2MCEP_scanColumnStore()", this_testScanColumnStore);
+	CU_add_test(M2MCEPTest, "M2MCEP_setColumnStore()", this_testSetColumnStore);
+	CU_add_test(M2MCEPTest, "M2MCEP_selectUnified()", this_testSelectUnified);
 	CU_add_test(M2MCEPTest, "M2MCEP_delete()", this_testDelete);
 	//=====  =====
 	CU_console_run_tests();
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * M2MStringBuilderTest.c
+ *
+ * Copyright (c) 2019, Akihisa Yasuda
+ * All rights reserved.
+ ******************************************************************************/
+
+#include "m2m/lib/lang/M2MStringBuilder.h"
+#include <inttypes.h>
+#include <CUnit/CUnit.h>
+#include <CUnit/Console.h>
+
+
+
+/*******************************************************************************
+ * Private function
+ ******************************************************************************/
+/**
+ * Test function for "M2MStringBuilder_append()"
+ */
+static void this_testAppend ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_appendCharacter()"
+ */
+static void this_testAppendCharacter ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_appendDouble()"
+ */
+static void this_testAppendDouble ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_appendFormat()"
+ */
+static void this_testAppendFormat ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_appendLength()"
+ */
+static void this_testAppendLength ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_appendSignedLong()"
+ */
+static void this_testAppendSignedLong ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_appendUnsignedLong()"
+ */
+static void this_testAppendUnsignedLong ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_clear()"
+ */
+static void this_testClear ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_delete()"
+ */
+static void this_testDelete ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_detach()"
+ */
+static void this_testDetach ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_getLength()"
+ */
+static void this_testGetLength ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_getString()"
+ */
+static void this_testGetString ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_init()"
+ */
+static void this_testInit ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_new()"
+ */
+static void this_testNew ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_release()"
+ */
+static void this_testRelease ()
+	{
+	}
+
+
+/**
+ * Test function for "M2MStringBuilder_reserve()"
+ */
+static void this_testReserve ()
+	{
+	}
+
+
+
+/*******************************************************************************
+ * Public function
+ ******************************************************************************/
+/**
+ * Entry point for CUnit test program.<br>
+ *
+ * @param argc
+ * @param argv
+ * @return
+ *
+int main (int argc, char **argv)
+	{
+	//========== Variable ==========
+	CU_pSuite M2MStringBuilderTest;
+
+	//=====  =====
+	CU_initialize_registry();
+	//=====  =====
+	M2MStringBuilderTest = CU_add_suite("M2MStringBuilderTest", NULL, NULL);
+	//=====  =====
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_new()", this_testNew);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_delete()", this_testDelete);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_append()", this_testAppend);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_appendCharacter()", this_testAppendCharacter);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_appendDouble()", this_testAppendDouble);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_appendFormat()", this_testAppendFormat);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_appendLength()", this_testAppendLength);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_appendSignedLong()", this_testAppendSignedLong);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_appendUnsignedLong()", this_testAppendUnsignedLong);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_clear()", this_testClear);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_detach()", this_testDetach);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_getLength()", this_testGetLength);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_getString()", this_testGetString);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_init()", this_testInit);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_release()", this_testRelease);
+	CU_add_test(M2MStringBuilderTest, "M2MStringBuilder_reserve()", this_testReserve);
+	//=====  =====
+	CU_console_run_tests();
+	//=====  =====
+	CU_cleanup_registry();
+
+	return 0;
+	}
+*/
+
+
+
+/* End Of File */